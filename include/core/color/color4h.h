@@ -0,0 +1,81 @@
+#ifndef CAT_CORE_COLOR_COLOR4H_H
+#define CAT_CORE_COLOR_COLOR4H_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file color4h.h
+ * @brief An RGBA colour stored as half floats, for compact arrays.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/color/color4f.h"
+#include "core/math/convertkernels.h"
+
+namespace Cat {
+
+	/**
+	 * @class Color4h color4h.h "core/color/color4h.h"
+	 * @brief An RGBA colour stored as half floats, for compact arrays.
+	 *
+	 * A Color4h keeps the range (and linear precision) that a Color4b
+	 * loses, at half the size of a Color4f.  It is only storage; arrays
+	 * of them are converted to Color4f with unpack(), and back with
+	 * pack(), which use the ConvertKernels.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Color4h {
+	  public:
+		Half r, g, b, a;
+
+		/**
+		 * @brief Create a default color (transparent black).
+		 */
+		inline Color4h()
+			: r(0), g(0), b(0), a(0) {}
+
+		/**
+		 * @brief Create a color from the nearest half floats to a Color4f.
+		 * @param c The color to convert.
+		 */
+		inline explicit Color4h(const Color4f& c)
+			: r(HalfFloat::fromReal(c.r)), g(HalfFloat::fromReal(c.g)),
+			  b(HalfFloat::fromReal(c.b)), a(HalfFloat::fromReal(c.a)) {}
+
+		/**
+		 * @brief Convert the color to a Color4f.
+		 * @return The color as a Color4f.
+		 */
+		inline Color4f toColor4f() const {
+			return Color4f(HalfFloat::toReal(r), HalfFloat::toReal(g),
+								HalfFloat::toReal(b), HalfFloat::toReal(a));
+		}
+
+		/**
+		 * @brief Convert an array of Color4h to Color4f.
+		 * @param src The colors to convert.
+		 * @param dst The array to store the Color4f in.
+		 * @param count The number of colors.
+		 */
+		static inline void unpack(const Color4h* src, Color4f* dst, Size count) {
+			ConvertKernels::toReal(&src->r, &dst->r, count*4);
+		}
+
+		/**
+		 * @brief Convert an array of Color4f to Color4h.
+		 * @param src The colors to convert.
+		 * @param dst The array to store the Color4h in.
+		 * @param count The number of colors.
+		 */
+		static inline void pack(const Color4f* src, Color4h* dst, Size count) {
+			ConvertKernels::fromReal(&src->r, &dst->r, count*4);
+		}
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_COLOR_COLOR4H_H
@@ -0,0 +1,261 @@
+#ifndef CAT_CORE_COLOR_COLORKERNELS_H
+#define CAT_CORE_COLOR_COLORKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file colorkernels.h
+ * @brief The vectorised (SSE2 / AVX2) kernels to convert and blend spans of colors.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/color/color4b.h"
+#include "core/color/color4f.h"
+#include "core/color/packedcolor.h"
+
+namespace Cat {
+
+	/**
+	 * @class ColorKernels colorkernels.h "core/color/colorkernels.h"
+	 * @brief The vectorised (SSE2 / AVX2) kernels to convert and blend spans of colors.
+	 *
+	 * The kernels convert whole buffers of colors between 8 bit (Color4b,
+	 * or PackedColorVal, which has the same layout on little endian
+	 * machines) and float (Color4f), between sRGB and linear, to and from
+	 * premultiplied alpha, and blend them with the Porter-Duff operators.
+	 * As with the MathKernels, the best table for the running CPU is
+	 * selected once, on first use, and every table gives exactly the same
+	 * results as the scalar one, bit for bit.
+	 *
+	 * Converting to 8 bits clamps to [0 - 1] and rounds to the nearest
+	 * value.  The sRGB curve is applied through lookup tables: 8 bit
+	 * sRGB to linear is exact, and linear to 8 bit sRGB goes through a
+	 * 16384 entry table, which is within a tenth of a step of the exact
+	 * curve, so every 8 bit value survives a round trip.  The alpha
+	 * channel is always linear.  The source and destination spans may be
+	 * the same span, but must not otherwise overlap.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class ColorKernels {
+	  public:
+		/**
+		 * @brief The Porter-Duff operators, for premultiplied colors.
+		 * Each gives dst = src*Fa + dst*Fb, for every channel.
+		 */
+		enum BlendMode {
+			kClear = 0,	/**< Fa = 0, Fb = 0 */
+			kSrc,			/**< Fa = 1, Fb = 0 */
+			kDst,			/**< Fa = 0, Fb = 1 */
+			kSrcOver,	/**< Fa = 1, Fb = 1 - As */
+			kDstOver,	/**< Fa = 1 - Ad, Fb = 1 */
+			kSrcIn,		/**< Fa = Ad, Fb = 0 */
+			kDstIn,		/**< Fa = 0, Fb = As */
+			kSrcOut,		/**< Fa = 1 - Ad, Fb = 0 */
+			kDstOut,		/**< Fa = 0, Fb = 1 - As */
+			kSrcAtop,	/**< Fa = Ad, Fb = 1 - As */
+			kDstAtop,	/**< Fa = 1 - Ad, Fb = As */
+			kXor,			/**< Fa = 1 - Ad, Fb = 1 - As */
+			kPlus,		/**< Fa = 1, Fb = 1 */
+			kNumBlendModes
+		};
+
+		struct Table {
+			/**
+			 * @brief Convert 8 bit colors to float, c / 255.
+			 */
+			void (*unpack)(const Color4b* src, Color4f* dst, Size count);
+
+			/**
+			 * @brief Convert float colors to 8 bit, clamped and rounded.
+			 */
+			void (*pack)(const Color4f* src, Color4b* dst, Size count);
+
+			/**
+			 * @brief Convert 8 bit sRGB colors to linear float colors.
+			 */
+			void (*srgbToLinear)(const Color4b* src, Color4f* dst, Size count);
+
+			/**
+			 * @brief Convert linear float colors to 8 bit sRGB colors.
+			 */
+			void (*linearToSrgb)(const Color4f* src, Color4b* dst, Size count);
+
+			/**
+			 * @brief Multiply the colors by their alpha.
+			 */
+			void (*premultiply)(const Color4f* src, Color4f* dst, Size count);
+
+			/**
+			 * @brief Divide the colors by their alpha, zero alpha gives black.
+			 */
+			void (*unpremultiply)(const Color4f* src, Color4f* dst, Size count);
+
+			/**
+			 * @brief Multiply 8 bit colors by their alpha, rounded.
+			 */
+			void (*premultiplyBytes)(const Color4b* src, Color4b* dst, Size count);
+
+			/**
+			 * @brief Blend premultiplied float colors with a Porter-Duff operator.
+			 */
+			void (*blend)(const Color4f* src, Color4f* dst, Size count, BlendMode mode);
+
+			/**
+			 * @brief Blend premultiplied 8 bit colors, source over destination.
+			 */
+			void (*blendOverBytes)(const Color4b* src, Color4b* dst, Size count);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+		/**
+		 * @brief Convert an array of 8 bit colors to float colors.
+		 * @param src The colors to convert.
+		 * @param dst The array to store the float colors in.
+		 * @param count The number of colors.
+		 */
+		static inline void unpack(const Color4b* src, Color4f* dst, Size count) {
+			table().unpack(src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of packed colors to float colors.
+		 * @param src The packed colors to convert.
+		 * @param dst The array to store the float colors in.
+		 * @param count The number of colors.
+		 */
+		static inline void unpack(const PackedColorVal* src, Color4f* dst, Size count) {
+			table().unpack((const Color4b*)src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of float colors to 8 bit colors.
+		 * @param src The colors to convert.
+		 * @param dst The array to store the 8 bit colors in.
+		 * @param count The number of colors.
+		 */
+		static inline void pack(const Color4f* src, Color4b* dst, Size count) {
+			table().pack(src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of float colors to packed colors.
+		 * @param src The colors to convert.
+		 * @param dst The array to store the packed colors in.
+		 * @param count The number of colors.
+		 */
+		static inline void pack(const Color4f* src, PackedColorVal* dst, Size count) {
+			table().pack(src, (Color4b*)dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of 8 bit sRGB colors to linear float colors.
+		 * @param src The sRGB colors to convert.
+		 * @param dst The array to store the linear colors in.
+		 * @param count The number of colors.
+		 */
+		static inline void srgbToLinear(const Color4b* src, Color4f* dst, Size count) {
+			table().srgbToLinear(src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of linear float colors to 8 bit sRGB colors.
+		 * @param src The linear colors to convert.
+		 * @param dst The array to store the sRGB colors in.
+		 * @param count The number of colors.
+		 */
+		static inline void linearToSrgb(const Color4f* src, Color4b* dst, Size count) {
+			table().linearToSrgb(src, dst, count);
+		}
+
+		/**
+		 * @brief Multiply an array of float colors by their alpha.
+		 * @param src The colors to premultiply.
+		 * @param dst The array to store the premultiplied colors in (may be src).
+		 * @param count The number of colors.
+		 */
+		static inline void premultiply(const Color4f* src, Color4f* dst, Size count) {
+			table().premultiply(src, dst, count);
+		}
+
+		/**
+		 * @brief Multiply an array of 8 bit colors by their alpha.
+		 * @param src The colors to premultiply.
+		 * @param dst The array to store the premultiplied colors in (may be src).
+		 * @param count The number of colors.
+		 */
+		static inline void premultiply(const Color4b* src, Color4b* dst, Size count) {
+			table().premultiplyBytes(src, dst, count);
+		}
+
+		/**
+		 * @brief Divide an array of premultiplied float colors by their alpha.
+		 * @param src The colors to unpremultiply.
+		 * @param dst The array to store the colors in (may be src).
+		 * @param count The number of colors.
+		 */
+		static inline void unpremultiply(const Color4f* src, Color4f* dst, Size count) {
+			table().unpremultiply(src, dst, count);
+		}
+
+		/**
+		 * @brief Blend an array of premultiplied float colors into another.
+		 * @param src The colors to blend.
+		 * @param dst The colors to blend into, and store the results in.
+		 * @param count The number of colors.
+		 * @param mode The Porter-Duff operator to blend with.
+		 */
+		static inline void blend(const Color4f* src, Color4f* dst, Size count,
+										 BlendMode mode = kSrcOver) {
+			table().blend(src, dst, count, mode);
+		}
+
+		/**
+		 * @brief Blend an array of premultiplied 8 bit colors over another.
+		 * @param src The colors to blend.
+		 * @param dst The colors to blend over, and store the results in.
+		 * @param count The number of colors.
+		 */
+		static inline void blendOver(const Color4b* src, Color4b* dst, Size count) {
+			table().blendOverBytes(src, dst, count);
+		}
+
+	  private:
+		static const Table* selectTable();
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_COLOR_COLORKERNELS_H
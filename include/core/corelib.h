@@ -193,6 +193,24 @@ namespace Cat {
 	 */
 	OID crc32(const Char* str);
 
+	/**
+	 * @brief Calculates the CRC32 hash of the first length characters of a string.
+	 * @param str The string to hash.
+	 * @param length The number of characters to hash.
+	 * @return The same hash as crc32(str) would give for the substring.
+	 */
+	OID crc32(const Char* str, Size length);
+
+	/**
+	 * @brief Continue a CRC32 hash with more characters.
+	 * crc32(crc32(a), b, length(b)) is the same as crc32() of a followed by b.
+	 * @param crc The hash of the characters before str.
+	 * @param str The characters to add to the hash.
+	 * @param length The number of characters to add.
+	 * @return The hash of all the characters.
+	 */
+	OID crc32(OID crc, const Char* str, Size length);
+
 	/**
 	 * @brief Copies the value of a string and returns a pointer to the newly allocated copy.
 	 * @param str The string to make a copy of.
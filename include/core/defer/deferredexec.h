@@ -12,6 +12,7 @@
 
 #include "core/util/simplequeue.h"
 #include "core/threading/spinlock.h"
+#include "core/defer/handlergroups.h"
 
 namespace Cat {
 
@@ -20,10 +21,11 @@ namespace Cat {
 	 * @brief A DeferredExecCall allowing for deferred handling of function exections.
 	 *
 	 * The DeferredExecCall stores a static function, an object to give the function and
-	 * an IntegralType to send as data.
+	 * an IntegralType to send as data, and the handler group the call runs in
+	 * (which is not part of equality).
 	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 3
 	 * @since Oct 3, 2014
 	 */
 	class DeferredExecCall {
@@ -38,9 +40,10 @@ namespace Cat {
 		 * @param p_func The function point to call.
 		 * @param p_obj The object to give to the function.
 		 * @param p_data The data to give to the function.
+		 * @param p_group The handler group of the call, less than HandlerGroups::kMaxGroups (otherwise 0).
 		 */
 		DeferredExecCall(void (*p_func)(void*, IntegralType),
-							  void* p_obj, IntegralType p_data);
+							  void* p_obj, IntegralType p_data, U32 p_group = 0);
 
 		/**
 		 * @brief Overloaded equality operator.
@@ -71,18 +74,25 @@ namespace Cat {
 			m_pFunc(m_pObj, m_data);
 		}
 
+		/**
+		 * @brief Get the handler group the call runs in.
+		 * @return The group, 0 by default.
+		 */
+		inline U32 group() const { return m_group; }
+
 		/**
 		 * @brief Static helper method to create a deffered call with void* data.
 		 * @param p_func The function to call.
 		 * @param p_obj The object to pass to the function.
 		 * @param p_data The void* data.
+		 * @param p_group The handler group of the call (optional, default = 0).
 		 * @return A DeferredExecCall object.
 		 */
 		static inline DeferredExecCall create(void (*p_func)(void*, IntegralType),
-									void* p_obj, void* p_data) {
+									void* p_obj, void* p_data, U32 p_group = 0) {
 			IntegralType data;
 			data.vPtr = p_data;
-			return DeferredExecCall(p_func, p_obj, data);
+			return DeferredExecCall(p_func, p_obj, data, p_group);
 		}
 		
 
@@ -90,6 +100,7 @@ namespace Cat {
 		void (*m_pFunc)(void*, IntegralType);
 	   void* m_pObj;
 		IntegralType m_data;
+		U32 m_group;
 	};
 	
 
@@ -101,8 +112,13 @@ namespace Cat {
 	 * correspond to function calls.  It just uses static function points and
 	 * void pointers for data for speed and simplicity.
 	 *
+	 * With a runner set by setParallelDispatch(), the calls are fanned out
+	 * across the lanes of the HandlerGroups by the group of each call, in
+	 * the order they were posted within each lane, and executeCalls()
+	 * returns once every lane has finished.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 2
 	 * @since Oct 3, 2014
 	 */
 	class DeferredExec {		
@@ -148,6 +164,18 @@ namespace Cat {
 		 * @brief Executes any deferredExecCalls on the queue.
 		 */
 		void executeCalls();
+
+		/**
+		 * @brief Fan the calls out across an AsyncTaskRunner when executing.
+		 * @param p_runner The AsyncTaskRunner, not one running executeCalls() itself, or NIL to run serially.
+		 */
+		inline void setParallelDispatch(AsyncTaskRunner* p_runner) { m_pRunner = p_runner; }
+
+		/**
+		 * @brief Get the handler groups, to declare which groups can run in parallel.
+		 * @return The HandlerGroups of the queue.
+		 */
+		inline HandlerGroups& handlerGroups() { return m_groups; }
 		
 		/**
 		 * @brief Static method to initialise the global messaging queue.
@@ -161,6 +189,7 @@ namespace Cat {
 		static void destroyGlobalDeferredExecQueue();
 		
 	  private:
+		static void executeLane(VPtr p_obj, U32 p_groupMask);
 		
 		Spinlock m_lock;		
 		SimpleQueue<DeferredExecCall> m_callsOne;
@@ -168,6 +197,11 @@ namespace Cat {
 		SimpleQueue<DeferredExecCall>* m_pCalls;
 		SimpleQueue<DeferredExecCall>* m_pProcessing;
 
+		AsyncTaskRunner* m_pRunner;
+		HandlerGroups m_groups;
+		DeferredExecCall* m_pDrained; /**< The calls of a run, for the lanes of a parallel dispatch. */
+		Size m_numDrained;
+
 		static DeferredExec* s_pGlobal; /**< A global message queue. */
 
 	};
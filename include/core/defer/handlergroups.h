@@ -0,0 +1,130 @@
+#ifndef CAT_CORE_DEFER_HANDLERGROUPS_H
+#define CAT_CORE_DEFER_HANDLERGROUPS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file handlergroups.h
+ * @brief Groups of handlers that can be run in parallel, and a fan-out to run them.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	class AsyncTaskRunner;
+	class HandlerGroupsLaneTask;
+
+	/**
+	 * @class HandlerGroups handlergroups.h "core/defer/handlergroups.h"
+	 * @brief Groups of handlers that can be run in parallel, and a fan-out to run them.
+	 *
+	 * Every handler belongs to one of kMaxGroups groups (group 0 if it is
+	 * not given one).  A group declares the resources it reads and writes
+	 * as two 64 bit sets, and a group that reads and writes nothing is
+	 * independent of every other group.  Declaring a group promises that
+	 * its handlers touch nothing the undeclared groups touch; the
+	 * undeclared groups all share a lane with group 0.  Groups whose sets
+	 * conflict (one writes what the other reads or writes) are put in the
+	 * same lane, and the lanes are run at the same time, each walking the
+	 * whole drained batch in order but only calling the handlers in its
+	 * own groups, so the order within a group is kept.
+	 *
+	 * The lane with group 0 is run on the calling thread, and the others
+	 * on an AsyncTaskRunner; run() sleeps until every lane has finished.
+	 * The runner is finished with the lanes by then, so the HandlerGroups
+	 * may be destroyed as soon as run() returns.  run() must not be called
+	 * from a task on the same runner, since its lanes could be queued
+	 * behind the task that is waiting for them.  If the runner has been
+	 * stopped, the lanes it will not take are run on the calling thread.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 3
+	 * @since Oct 17, 2026
+	 */
+	class HandlerGroups {
+	  public:
+		static const U32 kMaxGroups = 32;
+		static const U32 kAllGroups = 0xFFFFFFFF;
+
+		/**
+		 * @brief The function run for each lane.
+		 * @param obj The object given to run().
+		 * @param groupMask A bit for each group in the lane.
+		 */
+		typedef void (*LaneFunc)(VPtr obj, U32 groupMask);
+
+		/**
+		 * @brief Create a set of undeclared groups, which all share one lane.
+		 */
+		HandlerGroups();
+
+		/**
+		 * @brief Destroys the lane tasks.
+		 */
+		~HandlerGroups();
+
+		/**
+		 * @brief Declare the resources a group reads and writes.
+		 * @param group The group, less than kMaxGroups.
+		 * @param readSet A bit for each resource the group's handlers read.
+		 * @param writeSet A bit for each resource the group's handlers write.
+		 */
+		void declareGroup(U32 group, U64 readSet, U64 writeSet);
+
+		/**
+		 * @brief Declare a group that shares nothing with any other group.
+		 * @param group The group, less than kMaxGroups.
+		 */
+		inline void declareIndependentGroup(U32 group) { declareGroup(group, 0, 0); }
+
+		/**
+		 * @brief Forget all the declarations, so every group shares one lane again.
+		 */
+		void reset();
+
+		/**
+		 * @brief Get the number of lanes the groups are split into.
+		 * @return The number of lanes, at least one.
+		 */
+		U32 numLanes();
+
+		/**
+		 * @brief Get the groups in a lane.
+		 * @param lane The lane, less than numLanes().  Lane 0 always has group 0.
+		 * @return A bit for each group in the lane.
+		 */
+		U32 laneMask(U32 lane);
+
+		/**
+		 * @brief Run a function once for each lane, and wait for them all.
+		 * Without a runner, or with only one lane, the function is called
+		 * once on the calling thread with kAllGroups.
+		 * @param runner The AsyncTaskRunner to run the other lanes on, or NIL.
+		 * Must not be the runner of the calling thread.
+		 * @param func The function to run for each lane.
+		 * @param obj The object to pass to the function.
+		 */
+		void run(AsyncTaskRunner* runner, LaneFunc func, VPtr obj);
+
+	  private:
+		HandlerGroups(const HandlerGroups& src);
+		HandlerGroups& operator=(const HandlerGroups& src);
+
+		void computeLanes();
+		Boolean conflicts(U32 a, U32 b) const;
+
+		U32 m_declared;
+		U64 m_readSets[kMaxGroups];
+		U64 m_writeSets[kMaxGroups];
+		U32 m_laneMasks[kMaxGroups];
+		U32 m_numLanes;
+		Boolean m_dirty;
+		HandlerGroupsLaneTask* m_pTasks[kMaxGroups];
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_DEFER_HANDLERGROUPS_H
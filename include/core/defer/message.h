@@ -25,8 +25,12 @@ namespace Cat {
 	 * The Message class allows for posting of messages / events and 
 	 * the assignment of listeners to listen for these messages.
 	 *
+	 * Small data is copied into the message itself.  Larger data can be
+	 * kept in a payload owned by someone else (e.g., the MessageArena of
+	 * a MessageQueue), which the message only points to.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 2
 	 * @since Mar 16, 2014
 	 */
 	class Message {		
@@ -36,7 +40,7 @@ namespace Cat {
 		 */
 		inline Message()
 			: m_type(MessageType::kMTNoMessage),
-			  m_time(0), m_pSender(NIL) {}		
+			  m_time(0), m_pSender(NIL), m_pPayload(NIL), m_payloadSize(0) {}		
 
 		/**
 		 * @brief Create a new Message with the specified message type.
@@ -53,6 +57,15 @@ namespace Cat {
 		 */
 		Message(I32 p_type, void* p_sender, Byte* p_data = NIL);
 
+		/**
+		 * @brief Create a new Message pointing to a payload, instead of copying data.
+		 * @param p_type The type of message.
+		 * @param p_sender The object that send the message.
+		 * @param p_payload The payload, which must outlive the message.
+		 * @param p_payloadSize The size of the payload in bytes.
+		 */
+		Message(I32 p_type, void* p_sender, Byte* p_payload, U32 p_payloadSize);
+
 		/**
 		 * @brief Overloaded equality operator.  Just checks type.
 		 * @return True if the messages are of the same type.
@@ -73,7 +86,7 @@ namespace Cat {
 		 * @brief Get the Data pointer for the Message.
 		 * @return The Data pointer for the message.
 		 */
-		inline Byte* data() { return m_pData; }
+		inline Byte* data() { return m_pPayload ? m_pPayload : m_pData; }
 
 		/** 
 		 * @brief Check to see if the message is from a specified sender.
@@ -88,7 +101,19 @@ namespace Cat {
 		 * @brief Get the Data pointer for the Message.
 		 * @return The Data pointer for the message.
 		 */
-		inline Byte* readData() { return m_pData; }
+		inline Byte* readData() { return m_pPayload ? m_pPayload : m_pData; }
+
+		/**
+		 * @brief Check to see if the message points to a payload.
+		 * @return True if the data of the message is kept outside of it.
+		 */
+		inline Boolean hasPayload() const { return m_pPayload != NIL; }
+
+		/**
+		 * @brief Get the size of the data of the message.
+		 * @return The size of the payload, or MESSAGE_DATA_SIZE.
+		 */
+		inline U32 dataSize() const { return m_pPayload ? m_payloadSize : MESSAGE_DATA_SIZE; }
 
 		/**
 		 * @brief Get the sender object of the message, if any.
@@ -97,7 +122,7 @@ namespace Cat {
 		inline VPtr sender() { return m_pSender; }		
 
 		/**
-		 * @brief Set the data stored in the message.
+		 * @brief Set the data stored in the message, dropping any payload.
 		 * @param p_data A void pointer to kMessageDataSize bytes of memory.
 		 */
 		void setData(Byte* p_data);
@@ -119,6 +144,8 @@ namespace Cat {
 		U64 m_time;
 		VPtr m_pSender;		
 		Byte m_pData[MESSAGE_DATA_SIZE];
+		Byte* m_pPayload;
+		U32 m_payloadSize;
 		
 		
 	};
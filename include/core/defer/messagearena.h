@@ -0,0 +1,101 @@
+#ifndef CAT_CORE_DEFER_MESSAGEARENA_H
+#define CAT_CORE_DEFER_MESSAGEARENA_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file messagearena.h
+ * @brief A bump allocator for the payloads of the messages in a MessageQueue.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @class MessageArena messagearena.h "core/defer/messagearena.h"
+	 * @brief A bump allocator for the payloads of the messages in a MessageQueue.
+	 *
+	 * Allocating moves a single offset forward with a compare and swap,
+	 * so any number of threads can allocate at once without locking.  A
+	 * block that does not fit leaves the offset where it was.  The
+	 * memory is never freed piece by piece; the whole arena is reset once
+	 * every message using it has been handled.  Every allocation is
+	 * rounded up to kAlignment bytes, which is also the largest alignment
+	 * the arena can give.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class MessageArena {
+	  public:
+		static const Size kAlignment = 16;
+
+		/**
+		 * @brief Create an arena with no memory, which fails every allocation.
+		 */
+		MessageArena();
+
+		/**
+		 * @brief Frees the memory of the arena.
+		 */
+		~MessageArena();
+
+		/**
+		 * @brief Allocate the memory for the arena.  Not thread safe.
+		 * @param capacity The number of bytes in the arena.
+		 */
+		void initWithCapacity(Size capacity);
+
+		/**
+		 * @brief Allocate a block from the arena.
+		 * @param size The size of the block in bytes.
+		 * @return A pointer to the block, aligned to kAlignment, or NIL if the arena is full.
+		 */
+		inline Byte* alloc(Size size) {
+			Size step = (size + kAlignment - 1) & ~(kAlignment - 1);
+			Size offset = __atomic_load_n(&m_offset, __ATOMIC_RELAXED);
+			do {
+				/* Only move the offset if the block fits, so a smaller block may still fit after */
+				if (step > m_capacity - offset) {
+					return NIL;
+				}
+			} while (!__atomic_compare_exchange_n(&m_offset, &offset, offset + step, true,
+															  __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+			return m_pMemory + offset;
+		}
+
+		/**
+		 * @brief Make all the memory in the arena free again.  Must not be
+		 * called while any thread is allocating from the arena.
+		 */
+		inline void reset() { __atomic_store_n(&m_offset, 0, __ATOMIC_RELAXED); }
+
+		/**
+		 * @brief Get the capacity of the arena.
+		 * @return The number of bytes in the arena.
+		 */
+		inline Size capacity() const { return m_capacity; }
+
+		/**
+		 * @brief Get the number of bytes allocated since the last reset.
+		 * @return The number of bytes used.
+		 */
+		inline Size used() const { return __atomic_load_n(&m_offset, __ATOMIC_RELAXED); }
+
+	  private:
+		MessageArena(const MessageArena& src);
+		MessageArena& operator=(const MessageArena& src);
+
+		Byte* m_pMemory;
+		Byte* m_pUnaligned;
+		Size m_capacity;
+		Size m_offset;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_DEFER_MESSAGEARENA_H
@@ -12,6 +12,7 @@
 
 #include "core/corelib.h"
 #include "core/defer/message.h"
+#include "core/defer/handlergroups.h"
 
 namespace Cat {
 
@@ -20,9 +21,15 @@ namespace Cat {
 	 * @brief A MessageHandler allowing for deferred handling of actions.
 	 *
 	 * The MessageHandler encapuslates a static callback method and an object.
+	 * A batch handler takes all the messages of its type from one run of
+	 * the MessageQueue at once, as a contiguous array, instead of one
+	 * message's data at a time; a message passed to triggerMessage() comes
+	 * to it alone, as a batch of one.  A handler can be put in one of the
+	 * HandlerGroups of its queue, so it can be run in parallel with the
+	 * handlers of independent groups; the group is not part of equality.
 	 *
 	 * @author Catlin Zilinski
-	 * @version 2
+	 * @version 5
 	 * @since Mar 16, 2014
 	 */
 	class MessageHandler {		
@@ -32,7 +39,7 @@ namespace Cat {
 		 */
 		MessageHandler()
 			: m_pObject(NIL), m_pRequiredSender(NIL), m_pFunc(NIL),
-			  m_active(false) {}		
+			  m_pBatchFunc(NIL), m_group(0), m_active(false) {}		
 
 		/**
 		 * @brief Create a new MessageHandler with the specified message type.
@@ -41,7 +48,16 @@ namespace Cat {
 		 */
 		MessageHandler(VPtr object, void (*func)(VPtr, Byte*))
 			: m_pObject(object), m_pRequiredSender(NIL), m_pFunc(func),
-			  m_active(true) {}
+			  m_pBatchFunc(NIL), m_group(0), m_active(true) {}
+
+		/**
+		 * @brief Create a new batch MessageHandler.
+		 * @param object The object to pass to the function.
+		 * @param batchFunc The function to handle an array of messages, and the number of them.
+		 */
+		MessageHandler(VPtr object, void (*batchFunc)(VPtr, Message*, Size))
+			: m_pObject(object), m_pRequiredSender(NIL), m_pFunc(NIL),
+			  m_pBatchFunc(batchFunc), m_group(0), m_active(true) {}
 
 		/**
 		 * @brief Create a new MessageHandler with the specified message type.
@@ -52,7 +68,7 @@ namespace Cat {
 		MessageHandler(VPtr object, VPtr requiredSender,
 							void (*func)(VPtr, Byte*))
 			: m_pObject(object), m_pRequiredSender(requiredSender),
-			  m_pFunc(func), m_active(true) {}
+			  m_pFunc(func), m_pBatchFunc(NIL), m_group(0), m_active(true) {}
 
 		/**
 		 * @brief Overloaded equality operator.
@@ -61,6 +77,7 @@ namespace Cat {
 		inline Boolean operator==(const MessageHandler& rval) const {
 			return ((m_pObject == rval.m_pObject) &&
 					  (m_pFunc == rval.m_pFunc) &&
+					  (m_pBatchFunc == rval.m_pBatchFunc) &&
 					  (m_pRequiredSender == rval.m_pRequiredSender));
 		}
 
@@ -71,6 +88,7 @@ namespace Cat {
 		inline Boolean operator!=(const MessageHandler& rval) const {
 			return ((m_pObject != rval.m_pObject) ||
 					  (m_pFunc != rval.m_pFunc) ||
+					  (m_pBatchFunc != rval.m_pBatchFunc) ||
 					  (m_pRequiredSender != rval.m_pRequiredSender));
 		}	
 
@@ -82,6 +100,43 @@ namespace Cat {
 			m_pFunc(m_pObject, message.readData());
 		}
 
+		/**
+		 * @brief Handle an array of messages at once.  Only for batch handlers.
+		 * @param messages The messages to process.
+		 * @param count The number of messages.
+		 */
+		inline void handleMessages(Message* messages, Size count) {
+			m_pBatchFunc(m_pObject, messages, count);
+		}
+
+		/**
+		 * @brief Check to see if the handler takes batches of messages.
+		 * @return True if the handler was created with a batch function.
+		 */
+		inline Boolean isBatch() const { return m_pBatchFunc != NIL; }
+
+		/**
+		 * @brief Get the only sender the handler responds to.
+		 * @return The required sender, or NIL if it responds to any sender.
+		 */
+		inline VPtr requiredSender() const { return m_pRequiredSender; }
+
+		/**
+		 * @brief Get the handler group the handler belongs to.
+		 * @return The group, 0 by default.
+		 */
+		inline U32 group() const { return m_group; }
+
+		/**
+		 * @brief Put the handler in a handler group.
+		 * @param group The group, less than HandlerGroups::kMaxGroups (otherwise group 0 is used).
+		 */
+		inline void setGroup(U32 group) {
+			D_CONDERR(group >= HandlerGroups::kMaxGroups,
+						 "Handler group " << group << " is not less than " << HandlerGroups::kMaxGroups << ", using group 0!");
+			m_group = (group < HandlerGroups::kMaxGroups) ? group : 0;
+		}
+
 		/**
 		 * @brief Check to see if the handler is active or not.
 		 * @return True if the handler is active and should be called.
@@ -107,6 +162,8 @@ namespace Cat {
 	   VPtr m_pObject;
 		VPtr m_pRequiredSender;
 		void (*m_pFunc)(VPtr, Byte*);		
+		void (*m_pBatchFunc)(VPtr, Message*, Size);
+		U32 m_group;
 		Boolean m_active;
 		
 	};
@@ -0,0 +1,228 @@
+#ifndef CAT_CORE_DEFER_MESSAGEHANDLERTABLE_H
+#define CAT_CORE_DEFER_MESSAGEHANDLERTABLE_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file messagehandlertable.h
+ * @brief The handlers for one type of message, kept in contiguous arrays.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/defer/messagehandler.h"
+
+namespace Cat {
+
+	/**
+	 * @class MessageHandlerTable messagehandlertable.h "core/defer/messagehandlertable.h"
+	 * @brief The handlers for one type of message, kept in contiguous arrays.
+	 *
+	 * The handlers are split when they are added: handlers for any sender,
+	 * handlers that require a sender, and batch handlers each have their
+	 * own array, so dispatching a message walks the first array without
+	 * checking senders, and only compares senders in the second.  Messages
+	 * for the batch handlers are collected into a contiguous array and
+	 * handed over all at once by flush().
+	 *
+	 * Every handler for any sender is called before every handler that
+	 * requires a sender, each array in the order its handlers were added.
+	 * Unlike the single list the table replaced, a handler for any sender
+	 * added after one that requires a sender is still called first.
+	 *
+	 * Dispatch indexes the arrays afresh for each handler, so a handler
+	 * may add another handler while it is being called.  Dispatching with
+	 * a group mask only calls the handlers in those groups, and does not
+	 * change the table, so lanes of different groups can dispatch from
+	 * the same table at once.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 3
+	 * @since Oct 17, 2026
+	 */
+	class MessageHandlerTable {
+	  public:
+		/**
+		 * @brief Create an empty table.
+		 */
+		MessageHandlerTable();
+
+		/**
+		 * @brief Destroys the handlers and any collected messages.
+		 */
+		~MessageHandlerTable();
+
+		/**
+		 * @brief Add a handler to the end of the array it belongs in.
+		 * @param handler The handler to add.
+		 */
+		void append(const MessageHandler& handler);
+
+		/**
+		 * @brief Remove a handler, keeping the order of the others.
+		 * @param handler The handler to remove.
+		 * @return True if the handler was found and removed.
+		 */
+		Boolean remove(const MessageHandler& handler);
+
+		/**
+		 * @brief Set whether a handler is active, without removing it.
+		 * @param handler The handler to find.
+		 * @param active Whether or not the handler should be called.
+		 * @return True if the handler was found.
+		 */
+		Boolean setActive(const MessageHandler& handler, Boolean active);
+
+		/**
+		 * @brief Remove all the handlers, and forget any collected messages.
+		 */
+		void clear();
+
+		/**
+		 * @brief Get the number of handlers in the table.
+		 * @return The number of handlers of every kind.
+		 */
+		inline Size size() const { return m_any.count + m_bySender.count + m_batch.count; }
+
+		/**
+		 * @brief Check to see if the table has any batch handlers.
+		 * @return True if messages should be collected for the batch handlers.
+		 */
+		inline Boolean hasBatchHandlers() const { return m_batch.count > 0; }
+
+		/**
+		 * @brief Call each active non-batch handler that should handle the message.
+		 * The handlers for any sender are called first, then those for the message's sender.
+		 * @param message The message to handle.
+		 */
+		inline void dispatch(Message& message) {
+			for (Size i = 0; i < m_any.count; ++i) {
+				if (m_any.pHandlers[i].isActive()) {
+					m_any.pHandlers[i].handleMessage(message);
+				}
+			}
+			if (m_bySender.count > 0) {
+				VPtr sender = message.sender();
+				for (Size i = 0; i < m_bySender.count; ++i) {
+					if (m_bySender.pHandlers[i].requiredSender() == sender &&
+						 m_bySender.pHandlers[i].isActive()) {
+						m_bySender.pHandlers[i].handleMessage(message);
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Call each active non-batch handler in a set of groups that should handle the message.
+		 * @param message The message to handle.
+		 * @param groupMask A bit for each handler group to call.
+		 */
+		inline void dispatch(Message& message, U32 groupMask) {
+			for (Size i = 0; i < m_any.count; ++i) {
+				if (((1U << m_any.pHandlers[i].group()) & groupMask) &&
+					 m_any.pHandlers[i].isActive()) {
+					m_any.pHandlers[i].handleMessage(message);
+				}
+			}
+			if (m_bySender.count > 0) {
+				VPtr sender = message.sender();
+				for (Size i = 0; i < m_bySender.count; ++i) {
+					if (m_bySender.pHandlers[i].requiredSender() == sender &&
+						 ((1U << m_bySender.pHandlers[i].group()) & groupMask) &&
+						 m_bySender.pHandlers[i].isActive()) {
+						m_bySender.pHandlers[i].handleMessage(message);
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Call each active batch handler on an array of messages.
+		 * @param messages The messages to handle.
+		 * @param count The number of messages.
+		 */
+		inline void dispatchBatch(Message* messages, Size count) {
+			for (Size i = 0; i < m_batch.count; ++i) {
+				if (m_batch.pHandlers[i].isActive()) {
+					m_batch.pHandlers[i].handleMessages(messages, count);
+				}
+			}
+		}
+
+		/**
+		 * @brief Call each active batch handler in a set of groups on an array of messages.
+		 * @param messages The messages to handle.
+		 * @param count The number of messages.
+		 * @param groupMask A bit for each handler group to call.
+		 */
+		inline void dispatchBatch(Message* messages, Size count, U32 groupMask) {
+			for (Size i = 0; i < m_batch.count; ++i) {
+				if (((1U << m_batch.pHandlers[i].group()) & groupMask) &&
+					 m_batch.pHandlers[i].isActive()) {
+					m_batch.pHandlers[i].handleMessages(messages, count);
+				}
+			}
+		}
+
+		/**
+		 * @brief Keep a copy of a message for the batch handlers.
+		 * @param message The message to collect.
+		 * @return True if it is the first message collected since the last flush().
+		 */
+		Boolean collect(const Message& message);
+
+		/**
+		 * @brief Hand the collected messages to the batch handlers, and forget them.
+		 */
+		void flush();
+
+		/**
+		 * @brief Get the number of messages collected since the last flush().
+		 * @return The number of collected messages.
+		 */
+		inline Size numCollected() const { return m_numCollected; }
+
+		/**
+		 * @brief Get the messages collected since the last flush().
+		 * @return The collected messages, in the order they were collected.
+		 */
+		inline Message* collected() { return m_pCollected; }
+
+		/**
+		 * @brief Forget the collected messages, without handing them over.
+		 */
+		inline void clearCollected() { m_numCollected = 0; }
+
+	  private:
+		struct HandlerArray {
+			MessageHandler* pHandlers;
+			Size count;
+			Size capacity;
+		};
+
+		MessageHandlerTable(const MessageHandlerTable& src);
+		MessageHandlerTable& operator=(const MessageHandlerTable& src);
+
+		inline HandlerArray& arrayFor(const MessageHandler& handler) {
+			if (handler.isBatch()) {
+				return m_batch;
+			}
+			return (handler.requiredSender() != NIL) ? m_bySender : m_any;
+		}
+
+		static void appendTo(HandlerArray& array, const MessageHandler& handler);
+		static I32 find(const HandlerArray& array, const MessageHandler& handler);
+		static void destroy(HandlerArray& array);
+
+		HandlerArray m_any;
+		HandlerArray m_bySender;
+		HandlerArray m_batch;
+
+		Message* m_pCollected;
+		Size m_numCollected;
+		Size m_collectedCapacity;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_DEFER_MESSAGEHANDLERTABLE_H
@@ -10,9 +10,12 @@
  * @date Mar 16, 2014
  */
 
-#include "core/defer/messagehandler.h"
+#include <new>
+#include "core/defer/messagehandlertable.h"
+#include "core/defer/messagearena.h"
+#include "core/defer/handlergroups.h"
 #include "core/util/simplequeue.h"
-#include "core/util/list.h"
+#include "core/util/spscring.h"
 #include "core/threading/spinlock.h"
 #include "core/util/internalmessage.h"
 
@@ -26,8 +29,42 @@ namespace Cat {
 	 * The MessageQueue class allows for posting of messages / events and 
 	 * the assignment of listeners to listen for these messages.
 	 *
+	 * By default, messages are posted under a lock into one of two queues,
+	 * which are swapped when they are processed.  With kMQFPerThreadRings,
+	 * each thread that posts claims its own single producer ring instead,
+	 * so posting never waits on another thread, and processMessages()
+	 * drains every ring in one pass, without a swap.  Messages from the
+	 * same thread are always handled in the order they were posted; with
+	 * kMQFOrderByTime as well, the rings are merged by Message::time().
+	 * A thread that stops posting can hand its ring back with
+	 * releaseProducer(), otherwise the ring stays claimed until the queue
+	 * is destroyed.
+	 *
+	 * Data larger than a Message can hold is posted with post<T>(), which
+	 * constructs a T in place in one of two MessageArenas.  The arenas
+	 * take turns; the one the processed messages were posted to is reset
+	 * at the end of processMessages(), so payloads cost neither a heap
+	 * allocation nor a copy.  The destructor of T is never called, and a
+	 * payload is only valid while its message is being handled.
+	 *
+	 * The handlers of each type are kept in a MessageHandlerTable, which
+	 * calls the handlers for any sender before the handlers that require
+	 * the message's sender, whatever order they were registered in.  Batch
+	 * handlers are called once per processMessages(), after the other
+	 * handlers, with every message of their type from that run in one
+	 * contiguous array (in the order the messages were handled).  Only
+	 * processMessages() batches: triggerMessage() handles its message
+	 * right away, so a batch handler gets it alone, as a batch of one.
+	 *
+	 * With a runner set by setParallelDispatch(), the messages of a run
+	 * are drained into one array and the handlers are fanned out across
+	 * the lanes of the queue's HandlerGroups, by the group of each
+	 * handler; processMessages() returns once every lane has finished.
+	 * Handlers must not be registered from a handler while dispatch is
+	 * parallel.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 6
 	 * @since Mar 16, 2014
 	 */
 	class MessageQueue {		
@@ -36,6 +73,12 @@ namespace Cat {
 			kMQIMTNoMessage = 0x0,
 			kMQIMTRemoveMessageHandler = 0x1,
 		};		
+
+		enum MQFlags {
+			kMQFNone = 0x0,
+			kMQFPerThreadRings = 0x1, /**< Each posting thread gets its own lock-free ring. */
+			kMQFOrderByTime = 0x2,    /**< Merge the rings by message time when processing. */
+		};
 			
 		/**
 		 * @brief Create an empty MessageQueue.
@@ -44,9 +87,14 @@ namespace Cat {
 
 		/**
 		 * @brief Create a new MessageQueue with the specified capacity.
-		 * @param capacity The number of events this queue can handle.
+		 * @param capacity The number of events this queue can handle (per thread, with kMQFPerThreadRings).
+		 * @param maxMessageTypeID The largest message type the queue will handle.
+		 * @param flags The MQFlags for the queue.
+		 * @param maxProducers The number of threads that can post at once, with kMQFPerThreadRings.
+		 * @param arenaSize The size of each of the two payload arenas, 0 for none.
 		 */
-		MessageQueue(U32 capacity, I32 maxMessageTypeID = 64);
+		MessageQueue(U32 capacity, I32 maxMessageTypeID = 64,
+						 U32 flags = kMQFNone, U32 maxProducers = 16, Size arenaSize = 0);
 
 		/**
 		 * @brief Destroys all unprocessed messages and all handlers.
@@ -75,6 +123,9 @@ namespace Cat {
 		 * @return True if the message was added to the queue.
 		 */
 		inline Boolean postMessage(const Message& message) {
+			if (m_pRings) {
+				return postToRing(message);
+			}
 			Boolean success = false;			
 			m_lock.lock();			
 			success = m_pMessages->push(message);
@@ -82,13 +133,102 @@ namespace Cat {
 			return success;			
 		}
 
+		/**
+		 * @brief Post a message with a payload of type T, default constructed in place.
+		 * @param type The type of message.
+		 * @param sender The object that sent the message, or NIL.
+		 * @return True if there was room for the payload and the message.
+		 */
+		template<typename T>
+		inline Boolean post(I32 type, VPtr sender = NIL) {
+			U32 arena;
+			Byte* payload = reservePayload(sizeof(T), arena);
+			if (!payload) {
+				return false;
+			}
+			new (payload) T();
+			return commitPayload(Message(type, sender, payload, sizeof(T)), arena);
+		}
+
+		/**
+		 * @brief Post a message with a payload of type T, constructed in place from one argument.
+		 * @see post(I32, VPtr)
+		 */
+		template<typename T, typename A1>
+		inline Boolean post(I32 type, VPtr sender, const A1& a1) {
+			U32 arena;
+			Byte* payload = reservePayload(sizeof(T), arena);
+			if (!payload) {
+				return false;
+			}
+			new (payload) T(a1);
+			return commitPayload(Message(type, sender, payload, sizeof(T)), arena);
+		}
+
+		/**
+		 * @brief Post a message with a payload of type T, constructed in place from two arguments.
+		 * @see post(I32, VPtr)
+		 */
+		template<typename T, typename A1, typename A2>
+		inline Boolean post(I32 type, VPtr sender, const A1& a1, const A2& a2) {
+			U32 arena;
+			Byte* payload = reservePayload(sizeof(T), arena);
+			if (!payload) {
+				return false;
+			}
+			new (payload) T(a1, a2);
+			return commitPayload(Message(type, sender, payload, sizeof(T)), arena);
+		}
+
+		/**
+		 * @brief Post a message with a payload of type T, constructed in place from three arguments.
+		 * @see post(I32, VPtr)
+		 */
+		template<typename T, typename A1, typename A2, typename A3>
+		inline Boolean post(I32 type, VPtr sender, const A1& a1, const A2& a2, const A3& a3) {
+			U32 arena;
+			Byte* payload = reservePayload(sizeof(T), arena);
+			if (!payload) {
+				return false;
+			}
+			new (payload) T(a1, a2, a3);
+			return commitPayload(Message(type, sender, payload, sizeof(T)), arena);
+		}
+
+		/**
+		 * @brief Hand the calling thread's ring back, for another thread to claim.
+		 * Messages already in the ring are still processed.  Does nothing
+		 * without kMQFPerThreadRings.
+		 */
+		void releaseProducer();
+
 		/**
 		 * @brief Process any messages on the queue.
 		 */
 		void processMessages();
 
+		/**
+		 * @brief Fan the handlers out across an AsyncTaskRunner when processing.
+		 * @param runner The AsyncTaskRunner, not one running processMessages() itself, or NIL to run serially.
+		 */
+		inline void setParallelDispatch(AsyncTaskRunner* runner) { m_pRunner = runner; }
+
+		/**
+		 * @brief Get the handler groups, to declare which groups can run in parallel.
+		 * @return The HandlerGroups of the queue.
+		 */
+		inline HandlerGroups& handlerGroups() { return m_groups; }
+
+		/**
+		 * @brief Get the flags the queue was created with.
+		 * @return The MQFlags of the queue.
+		 */
+		inline U32 flags() const { return m_flags; }
+
 		/**
 		 * @brief Attach a message handler to handle the specified type of messages.
+		 * A batch handler gets all the messages of the type at the end of each
+		 * processMessages(), or a single message from triggerMessage().
 		 * @param messageTypeID The type of messages to handle.
 		 * @param handler The MessageHandler.
 		 */
@@ -104,6 +244,8 @@ namespace Cat {
 
 		/**
 		 * @brief Call any listening handlers on the message immediatly.
+		 * The message is not collected with the ones waiting for the next
+		 * processMessages(), so batch handlers get it as a batch of one.
 		 * @param message The Message to handle.
 		 */
 		void triggerMessage(Message& message);
@@ -118,7 +260,11 @@ namespace Cat {
 		SimpleQueue<Message>* messagesTwo() { return &m_messagesTwo; }
 		SimpleQueue<Message>* messages() { return m_pMessages; }
 		SimpleQueue<Message>* processing() { return m_pProcessing; }
-		List<MessageHandler>* handlers() { return m_pHandlers; }
+		MessageHandlerTable* handlers() { return m_pHandlers; }
+		U32 numRings() const { return __atomic_load_n(&m_numRings, __ATOMIC_ACQUIRE); }
+		SpscRing<Message>* ring(U32 idx) { return &m_pRings[idx].messages; }
+		MessageArena* arena(U32 idx) { return &m_arenas[idx]; }
+		U32 currentArena() const { return __atomic_load_n(&m_currentArena, __ATOMIC_ACQUIRE); }
 #endif // DEBUG
 
 		/**
@@ -139,8 +285,37 @@ namespace Cat {
 		static void destroyGlobalMessageQueue();
 		
 	  private:
+		enum ProducerRingState {
+			kPRSFree = 0x0,
+			kPRSClaiming = 0x1,
+			kPRSOwned = 0x2,
+		};
+
+		/**
+		 * @brief The ring of messages posted by one thread.
+		 */
+		struct ProducerRing {
+			SpscRing<Message> messages;
+			ThreadHandle owner;
+			U32 state;
+
+			ProducerRing() : state(kPRSFree) {}
+		};
+
 		void initHandlerList();
 		void clearAllHandlers();
+		Boolean postToRing(const Message& message);
+		ProducerRing* findProducerRing();
+		ProducerRing* claimProducerRing();
+		void processRings();
+		void dispatchMessage(Message& message);
+		void flushBatches();
+		void consumeMessage(Message& message);
+		void finishBatch();
+		static void dispatchLane(VPtr obj, U32 groupMask);
+		Byte* reservePayload(Size size, U32& arena);
+		Boolean commitPayload(const Message& message, U32 arena);
+		U32 swapArenas();
 				
 		
 		Spinlock m_lock;		
@@ -149,10 +324,28 @@ namespace Cat {
 		SimpleQueue<Message>* m_pMessages;
 		SimpleQueue<Message>* m_pProcessing;
 		I32 m_maxMessageTypeID;		
-		List<MessageHandler>* m_pHandlers;
+		MessageHandlerTable* m_pHandlers;
+		I32* m_pBatchTypes; /**< The types with messages collected for batch handlers. */
+		I32 m_numBatchTypes;
 
 		SimpleQueue< InternalMessage2Args<I32, MessageHandler> > m_internalMessageQueue;
 
+		U32 m_flags;
+		ProducerRing* m_pRings;
+		Size* m_pRingCounts;
+		U32 m_maxProducers;
+		U32 m_numRings;
+
+		MessageArena m_arenas[2];
+		U32 m_currentArena;
+		U32 m_numPosting[2]; /**< The threads posting to each arena, with kMQFPerThreadRings. */
+
+		AsyncTaskRunner* m_pRunner;
+		HandlerGroups m_groups;
+		Message* m_pDrained; /**< The messages of a run, for the lanes of a parallel dispatch. */
+		Size m_numDrained;
+		Size m_drainedCapacity;
+
 		static MessageQueue* s_pGlobal; /**< A global message queue. */
 
 	};
@@ -15,6 +15,7 @@
 #include "core/corelib.h"
 #include "core/util/invasivestrongptr.h"
 #include "core/threading/atomic.h"
+#include "core/string/internedstring.h"
 #include "core/time/time.h"
 
 namespace Cat {
@@ -24,7 +25,7 @@ namespace Cat {
 	 * @brief The interface for a TimedAction, to be executed by a Timer.
 	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 2
 	 * @since Mar 18, 2014
 	 */
 	class TimedAction {		
@@ -42,35 +43,31 @@ namespace Cat {
 		 * @brief All implementing classes should call this.
 		 */
 		TimedAction()
-			: m_actionID(0), m_oid(0), m_pName(NIL), m_state(kTASWaiting) {}
+			: m_actionID(0), m_oid(0), m_state(kTASWaiting), m_inFlight(0) {}
 
 		TimedAction(OID oid)
-			: m_actionID(0), m_oid(oid), m_pName(NIL), m_state(kTASWaiting) {}
+			: m_actionID(0), m_oid(oid), m_state(kTASWaiting), m_inFlight(0) {}
 		TimedAction(OID oid, const TimeVal& timeToWait)
-			: m_actionID(0), m_oid(oid), m_pName(NIL), m_state(kTASWaiting),
+			: m_actionID(0), m_oid(oid), m_state(kTASWaiting), m_inFlight(0),
 			  m_timeToWait(timeToWait) {}
 
 		TimedAction(const Char* name)
-			: m_actionID(0), m_oid(0), m_pName(NIL), m_state(kTASWaiting) {
-			m_pName = copy(name);
-			m_oid = crc32(name);
+			: m_actionID(0), m_oid(0), m_name(name), m_state(kTASWaiting), m_inFlight(0) {
+			m_oid = m_name.oID();
 		}
 		TimedAction(const Char* name, const TimeVal& timeToWait)
-			: m_actionID(0), m_oid(0), m_pName(NIL), m_state(kTASWaiting),
+			: m_actionID(0), m_oid(0), m_name(name), m_state(kTASWaiting), m_inFlight(0),
 			  m_timeToWait(timeToWait) {
-			m_pName = copy(name);
-			m_oid = crc32(name);
+			m_oid = m_name.oID();
 		}
+		TimedAction(const InternedString& name, const TimeVal& timeToWait)
+			: m_actionID(0), m_oid(name.oID()), m_name(name), m_state(kTASWaiting), m_inFlight(0),
+			  m_timeToWait(timeToWait) {}
 		
 		/**
 		 * @brief Virtual destructor.
 		 */
-		virtual ~TimedAction() {
-			if (m_pName) {
-				free(m_pName);
-				m_pName = NIL;
-			}			
-		}
+		virtual ~TimedAction() {}
 
 		/**
 		 * @brief Get the actionID for the TimedAction.
@@ -103,7 +100,13 @@ namespace Cat {
 		 * @brief Get the name of the TimedAction, if it has one.
 		 * @return The name or NIL.
 		 */
-		inline const Char* name() const { return m_pName; }
+		inline const Char* name() const { return m_name.cStr(); }
+
+		/**
+		 * @brief Get the interned name of the TimedAction.
+		 * @return The handle to the name, which is null if it has no name.
+		 */
+		inline const InternedString& internedName() const { return m_name; }
 
 		/**
 		 * @brief Get the next firing time in platform dependant time units.
@@ -111,6 +114,21 @@ namespace Cat {
 		 */
 		inline RawTimeVal nextFireTime() const { return m_nextFireTime; }		
 
+		/**
+		 * @brief Mark the TimedAction as handed to a runner to fire, unless it already is.
+		 * @return True if it was not already waiting on or running in a runner.
+		 */
+		inline Boolean beginDispatch() {
+			return __atomic_exchange_n(&m_inFlight, (U32)1, __ATOMIC_ACQ_REL) == 0;
+		}
+
+		/**
+		 * @brief Mark the dispatched run of the TimedAction as finished.
+		 */
+		inline void endDispatch() {
+			__atomic_store_n(&m_inFlight, (U32)0, __ATOMIC_RELEASE);
+		}
+
 		/**
 		 * @brief Method to override to handle initialization.
 		 */
@@ -141,17 +159,13 @@ namespace Cat {
 		 * @return True if there are no more references to the TimedAction.
 		 */
 		inline Boolean release() {
-		   m_retainCount.decrement();	
-			if (m_retainCount.val() <= 0) {
-				return true;
-			}
-			return false;
+			return (m_retainCount.decrement() <= 0);
 		}
 
 		/**
 		 * @brief Mark the TimedAction as having been removed.
 		 */
-		inline void remove() { m_state = kTASRemoved; }		
+		inline void remove() { __atomic_store_n(&m_state, kTASRemoved, __ATOMIC_RELEASE); }		
 		
 		/**
 		 * @brief Method to indicate the TimedAction has resumed.
@@ -219,7 +233,7 @@ namespace Cat {
 		 * @return True if the TimedAction was removed from the list.
 		 */
 		inline Boolean wasRemoved() const {
-			return (m_state == kTASRemoved);
+			return (__atomic_load_n(&m_state, __ATOMIC_ACQUIRE) == kTASRemoved);
 		}
 		
 	  private:
@@ -229,9 +243,10 @@ namespace Cat {
 	
 		U64                        m_actionID;		
 		OID                        m_oid;
-		Char*                      m_pName;		
+		InternedString             m_name;		
 		AtomicI32		 			   m_retainCount;
 		TimedActionState	  		   m_state;
+		U32                        m_inFlight;
 		TimeVal                    m_timeToWait;
 		RawTimeVal                 m_nextFireTime;		
 	};
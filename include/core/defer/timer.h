@@ -15,6 +15,8 @@
 #include "core/defer/timedaction.h"
 #include "core/util/internalmessage.h"
 #include "core/util/ptrnodestore.h"
+#include "core/util/vector.h"
+#include "core/defer/timingwheel.h"
 
 namespace Cat {
 
@@ -26,8 +28,14 @@ namespace Cat {
 	 * enabling things to happen after a certain amount of time, or repeat
 	 * every period of time.
 	 *
+	 * The actions are indexed by a TimingWheel of ticks of the resolution,
+	 * and by their actionID, so registering and unregistering an action
+	 * are O(1), and each tick() reads the clock once and only touches the
+	 * actions that have expired.  An action never fires early, and fires
+	 * at most one resolution late (plus the time between ticks).
+	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 3
 	 * @since Mar 18, 2014
 	 */
 	class Timer {		
@@ -37,12 +45,22 @@ namespace Cat {
 			kTMRemoveSingularAction,
 			kTMRemoveRepeatedAction,
 		};
+
+		/**
+		 * @brief A function to hand due actions to, instead of firing them on the ticking thread.
+		 * The function is given the object it was set with, the action, and
+		 * whether the action is repeated.
+		 */
+		typedef void (*DispatchFunc)(VPtr obj, const TimedActionPtr& action, Boolean repeated);
 		
 		/**
 		 * @brief Create a new Timer with the specified attributes.
 		 * @param queueSize The number of events that can enter be created at once.
+		 * @param averageNumActions The number of actions to allocate storage for at once.
+		 * @param resolution The length of a tick of the TimingWheel.
 		 */
-		Timer(Size queueSize, Size averageNumActions = 32);
+		Timer(Size queueSize, Size averageNumActions = 32,
+				const TimeVal& resolution = TimeVal(Time::secondsToRaw(0.001)));
 
 		/**
 		 * @brief The destructor, makes sure to delete all actions.
@@ -104,6 +122,35 @@ namespace Cat {
 			return retVal;
 		}
 
+		/**
+		 * @brief Get the earliest time at which an action may be due.
+		 * Actions still in the input queues are not included.
+		 * @param time Set to the time of the next tick with an action due,
+		 * or to a lower bound of it, if there are any actions.
+		 * @return True if there are any running actions.
+		 */
+		Boolean nextFireTime(RawTimeVal& time) const;
+
+		/**
+		 * @brief Hand due actions to a function instead of firing them.
+		 *
+		 * With a dispatcher, a singular action is removed as soon as it is
+		 * dispatched, and a repeated one is scheduled for its next period,
+		 * whatever fire() returns when it runs; the dispatcher should
+		 * remove() the action if fire() returns false, and tick() then
+		 * drops it when it is next due.  A repeated action
+		 * is only dispatched if beginDispatch() succeeds, so a period that
+		 * comes due while the last one is still running is skipped; the
+		 * dispatcher must call endDispatch() on it once fire() returns.
+		 *
+		 * @param func The function to hand due actions to, or NIL to fire them in tick().
+		 * @param obj The object to pass to the function.
+		 */
+		inline void setDispatcher(DispatchFunc func, VPtr obj) {
+			m_pDispatchFunc = func;
+			m_pDispatchObj = obj;
+		}
+
 		/**
 		 * @brief Check to see if any timers have fired, and if so, deal with them.
 		 */
@@ -160,11 +207,37 @@ namespace Cat {
 		inline PtrNodeStore<TimedActionPtr>* nodeStore() { return &m_nodeStore; }
 		inline PtrNode<TimedActionPtr>* singular() { return &m_singular; }
 		inline PtrNode<TimedActionPtr>* repeated() { return &m_repeated; }
+		inline TimingWheel* wheel() { return &m_wheel; }
 #endif /* DEBUG */
 	  private:
+		/* The entry for a running action in the wheel and the actionID index */
+		struct ActionEntry : public TimingWheel::Entry {
+			PtrNode<TimedActionPtr>* node;
+			U64 actionID;
+			Boolean repeated;
+		};
+
+		Timer(const Timer& src);
+		Timer& operator=(const Timer& src);
+
+		void addAction(PtrNode<TimedActionPtr>* node, Boolean repeated);
+		void freeAction(ActionEntry* entry);
 		void findAndRemoveSingularAction(U64 actionID);
 		void findAndRemoveRepeatedAction(U64 actionID);		
 
+		ActionEntry* allocEntry();
+		ActionEntry* findEntry(U64 actionID) const;
+		void indexEntry(ActionEntry* entry);
+		void unindexEntry(ActionEntry* entry);
+		void growIndex();
+
+		inline U64 toTick(RawTimeVal time) const {
+			if (Time::compareRaw(time, m_epoch) <= 0) {
+				return 0;
+			}
+			return (U64)(time - m_epoch) / m_resolution;
+		}
+
 		U64 m_nextActionID;		
 		
 		SimpleQueue<TimedActionPtr> m_singularInputQueue;
@@ -175,13 +248,25 @@ namespace Cat {
 		PtrNodeStore<TimedActionPtr> m_nodeStore;
 		PtrNode<TimedActionPtr> m_singular;
 		PtrNode<TimedActionPtr> m_repeated;
+
+		TimingWheel m_wheel;
+		RawTimeVal m_epoch;
+		U64 m_resolution;
+
+		DispatchFunc m_pDispatchFunc;
+		VPtr m_pDispatchObj;
+
+		Vector<ActionEntry*> m_entryBlocks;
+		ActionEntry* m_pFreeEntries;
+		Size m_entryBlockSize;
+
+		ActionEntry** m_pIndex;
+		Size m_indexMask;
+		Size m_indexCount;
 		
 		Spinlock m_lock;		
-		
-		
-
 	};
 
 } // namepsace cc
 
-#endif // CAT_CORE_DEFER_MESSAGEQUEUE_H
+#endif // CAT_CORE_DEFER_TIMER_H
@@ -0,0 +1,182 @@
+#ifndef CAT_CORE_DEFER_TIMERTHREAD_H
+#define CAT_CORE_DEFER_TIMERTHREAD_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file timerthread.h
+ * @brief A Timer that runs on its own thread, sleeping until the next action is due.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/defer/timer.h"
+#include "core/threading/runnable.h"
+
+namespace Cat {
+
+	class TaskRunner;
+	class AsyncTaskRunner;
+
+	/**
+	 * @class TimerThread timerthread.h "core/defer/timerthread.h"
+	 * @brief A Timer that runs on its own thread, sleeping until the next action is due.
+	 *
+	 * The TimerThread ticks its Timer, then sleeps on a timerfd (or in
+	 * poll() where there is no timerfd) until the next tick with an action
+	 * due, so it uses no CPU while it waits.  Registering or unregistering
+	 * an action wakes it, in case the new action is due sooner.  Wake-ups
+	 * are rounded up to a multiple of the slack, so actions due within the
+	 * same slack window fire together.  An action due part way through a
+	 * tick of the Timer waits for the next tick, so it fires at most one
+	 * resolution of the Timer plus one slack late.
+	 *
+	 * Fired actions are run on a TaskRunner or AsyncTaskRunner, if one is
+	 * set, or else on the timer thread itself.  When they are run on a
+	 * runner, a repeated action is scheduled again as soon as it is
+	 * dispatched, and removed when its fire() returns false.  The tasks
+	 * only hold the action, so they may still be running after the
+	 * TimerThread is destroyed.  An
+	 * action never runs more than once at a time: a period that comes due
+	 * while the last run is still waiting or running is skipped.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 3
+	 * @since Oct 17, 2026
+	 */
+	class TimerThread : public Runnable {
+	  public:
+		/**
+		 * @brief Create a new TimerThread, which is not yet running.
+		 * @param queueSize The number of actions that can be registered between ticks.
+		 * @param slack The window within which expirations share a wake-up.
+		 * @param averageNumActions The number of actions to allocate storage for at once.
+		 */
+		TimerThread(Size queueSize,
+						const TimeVal& slack = TimeVal(Time::secondsToRaw(0.001)),
+						Size averageNumActions = 32);
+
+		/**
+		 * @brief Stops the thread, if it is running.
+		 */
+		~TimerThread();
+
+		/**
+		 * @brief Run the fired actions as tasks on a TaskRunner.
+		 * Must be called before the thread is started.
+		 * @param runner The TaskRunner, which must outlive the TimerThread.
+		 */
+		void dispatchTo(TaskRunner* runner);
+
+		/**
+		 * @brief Run the fired actions as tasks on an AsyncTaskRunner.
+		 * Must be called before the thread is started.
+		 * @param runner The AsyncTaskRunner, which must outlive the TimerThread.
+		 */
+		void dispatchTo(AsyncTaskRunner* runner);
+
+		/**
+		 * @brief Register a single-shot timer action.
+		 * @param action The TimedAction to register as a single-shot action.
+		 * @return Non-zero actionID if success, 0 on failure.
+		 */
+		inline U64 registerSingular(TimedActionPtr& action) {
+			U64 actionID = m_timer.registerSingular(action);
+			wake();
+			return actionID;
+		}
+
+		/**
+		 * @brief Register a repeated timer action.
+		 * @param action The TimedAction to register as a repeated action.
+		 * @return Non-zero actionID if success, 0 on failure.
+		 */
+		inline U64 registerRepeated(TimedActionPtr& action) {
+			U64 actionID = m_timer.registerRepeated(action);
+			wake();
+			return actionID;
+		}
+
+		/**
+		 * @brief Remove a singular action by its actionID.
+		 * @param actionID The actionID of the action to remove.
+		 * @return True if the message was posted to remove the action.
+		 */
+		inline Boolean unregisterSingular(U64 actionID) {
+			Boolean success = m_timer.unregisterSingular(actionID);
+			wake();
+			return success;
+		}
+
+		/**
+		 * @brief Remove a repeated action by its actionID.
+		 * @param actionID The actionID of the action to remove.
+		 * @return True if the message was posted to remove the action.
+		 */
+		inline Boolean unregisterRepeated(U64 actionID) {
+			Boolean success = m_timer.unregisterRepeated(actionID);
+			wake();
+			return success;
+		}
+
+		/**
+		 * @brief Start the timer thread.
+		 * @return True if the thread was started.
+		 */
+		Boolean start();
+
+		/**
+		 * @brief Stop the timer thread and wait for it to finish.
+		 * Actions that are still registered stay registered, and fire if
+		 * the thread is started again.
+		 */
+		void stop();
+
+		/**
+		 * @brief The timer thread loop.  DONT EVER CALL THIS.
+		 * @return 0 when the thread has been stopped.
+		 */
+		I32 run();
+
+		/**
+		 * @brief Check to see if the timer thread is running.
+		 * @return True if the thread has been started and not stopped.
+		 */
+		inline Boolean isRunning() const { return m_running; }
+
+		/**
+		 * @brief Get the number of times the thread has woken up.
+		 * @return The number of wake-ups since the TimerThread was created.
+		 */
+		inline U64 numWakeups() const { return __atomic_load_n(&m_numWakeups, __ATOMIC_RELAXED); }
+
+#if defined (DEBUG)
+		inline Timer* timer() { return &m_timer; }
+#endif /* DEBUG */
+
+	  private:
+		TimerThread(const TimerThread& src);
+		TimerThread& operator=(const TimerThread& src);
+
+		static void dispatch(VPtr obj, const TimedActionPtr& action, Boolean repeated);
+
+		void wake();
+		void sleepUntilNextFireTime();
+
+		Timer m_timer;
+		RawTimeVal m_slack;
+		F64 m_nanoPerRaw;
+
+		TaskRunner* m_pTaskRunner;
+		AsyncTaskRunner* m_pAsyncRunner;
+
+		I32 m_timerFd;
+		I32 m_wakeFds[2];
+		volatile Boolean m_stopRequested;
+		Boolean m_running;
+		U64 m_numWakeups;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_DEFER_TIMERTHREAD_H
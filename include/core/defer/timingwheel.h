@@ -0,0 +1,151 @@
+#ifndef CAT_CORE_DEFER_TIMINGWHEEL_H
+#define CAT_CORE_DEFER_TIMINGWHEEL_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file timingwheel.h
+ * @brief A hierarchical timing wheel, to find expired deadlines without scanning.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @class TimingWheel timingwheel.h "core/defer/timingwheel.h"
+	 * @brief A hierarchical timing wheel, to find expired deadlines without scanning.
+	 *
+	 * The wheel keeps intrusive Entry objects in four levels of 64 slots.
+	 * Deadlines are in whole ticks; an entry due within 64 ticks is kept
+	 * in the first level, within 64^2 ticks in the second, and so on, and
+	 * entries are cascaded down a level each time the level below wraps.
+	 * Inserting and removing an entry are O(1), and advancing the wheel
+	 * costs one step per expired or cascaded entry, plus one step per 64
+	 * ticks, since empty slots are skipped with a bitmap of each level.
+	 * Deadlines more than 2^24 ticks away are parked in the last slot in
+	 * range and reinserted when it is cascaded.
+	 *
+	 * The wheel does not own its entries, and does not read the clock;
+	 * the owner converts times to ticks (e.g., the Timer).
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class TimingWheel {
+	  public:
+		static const U32 kSlotBits = 6;
+		static const U32 kNumSlots = 1 << kSlotBits;
+		static const U32 kSlotMask = kNumSlots - 1;
+		static const U32 kNumLevels = 4;
+		static const U64 kMaxTicksAhead = 1ULL << (kSlotBits*kNumLevels);
+
+		/**
+		 * @class Entry timingwheel.h "core/defer/timingwheel.h"
+		 * @brief The intrusive links of an object kept in the TimingWheel.
+		 */
+		struct Entry {
+			Entry* prev;
+			Entry* next;
+			U64 deadline;
+			U32 slot;
+
+			inline Entry() : prev(NIL), next(NIL), deadline(0), slot(0) {}
+
+			inline void initAsRoot() { prev = next = this; }
+			inline Boolean isEmptyRoot() const { return next == this; }
+			inline Boolean isLinked() const { return next != NIL; }
+
+			inline void attach(Entry* root) {
+				root->prev->next = this;
+				prev = root->prev;
+				next = root;
+				root->prev = this;
+			}
+
+			inline void detach() {
+				next->prev = prev;
+				prev->next = next;
+				prev = next = NIL;
+			}
+		};
+
+		/**
+		 * @brief Create an empty wheel, at tick 0.
+		 */
+		TimingWheel();
+
+		/**
+		 * @brief Insert an entry, which must not already be in the wheel.
+		 * @param entry The entry to insert.
+		 * @param deadline The tick at which the entry expires.  Deadlines
+		 * that have already passed are moved to the next tick.
+		 */
+		void insert(Entry* entry, U64 deadline);
+
+		/**
+		 * @brief Remove an entry from the wheel.
+		 * @param entry The entry to remove, which must be in the wheel.
+		 */
+		void remove(Entry* entry);
+
+		/**
+		 * @brief Move the wheel forward to a tick, collecting the expired entries.
+		 * @param tick The tick to advance to, which should not be in the past.
+		 * @param expired The root to attach the expired entries to, in deadline order.
+		 * @return The number of expired entries.
+		 */
+		Size advance(U64 tick, Entry* expired);
+
+		/**
+		 * @brief Get a lower bound on the deadline of the next entry to expire.
+		 * @return The deadline of the next entry in the first level, or the
+		 * tick at which the next entry is cascaded down to it, if that is
+		 * sooner, or U64 max if the wheel is empty.
+		 */
+		U64 nextDeadline() const;
+
+		/**
+		 * @brief Forget all the entries (without unlinking them) and move the wheel to a tick.
+		 * @param tick The current tick.
+		 */
+		void reset(U64 tick = 0);
+
+		/**
+		 * @brief Get the last tick the wheel was advanced to.
+		 * @return The current tick.
+		 */
+		inline U64 currentTick() const { return m_currentTick; }
+
+		/**
+		 * @brief Check to see if the wheel is empty.
+		 * @return True if there are no entries in the wheel.
+		 */
+		inline Boolean isEmpty() const { return m_size == 0; }
+
+		/**
+		 * @brief Get the number of entries in the wheel.
+		 * @return The number of entries.
+		 */
+		inline Size size() const { return m_size; }
+
+	  private:
+		TimingWheel(const TimingWheel& src);
+		TimingWheel& operator=(const TimingWheel& src);
+
+		void place(Entry* entry);
+		void cascade(U32 slot);
+		Size collect(U32 slot, Entry* expired);
+
+		Entry m_slots[kNumLevels*kNumSlots];
+		U64 m_occupied[kNumLevels];
+		U64 m_currentTick;
+		Size m_size;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_DEFER_TIMINGWHEEL_H
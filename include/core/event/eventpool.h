@@ -0,0 +1,125 @@
+#ifndef CAT_CORE_EVENT_EVENTPOOL_H
+#define CAT_CORE_EVENT_EVENTPOOL_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file eventpool.h
+ * @brief A ring of fixed size slots to construct events in place.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/event/event.h"
+
+namespace Cat {
+
+	/**
+	 * @class EventPool eventpool.h "core/event/eventpool.h"
+	 * @brief A ring of fixed size slots to construct events in place.
+	 *
+	 * Slots are handed out in order from the head of the ring and taken
+	 * back in the same order from the tail, which is all an EventQueue
+	 * needs: the events are dispatched in the order they were posted, so
+	 * once a run has been processed every slot up to the head at the
+	 * start of the run can be recycled at once.  The most recent slot can
+	 * also be handed straight back, for an event that was combined into
+	 * the one before it.  Not thread safe; the EventQueue holds its lock.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class EventPool {
+	  public:
+		static const Size kAlignment = 16;
+
+		/**
+		 * @brief Create a pool with no slots, which fails every allocation.
+		 */
+		EventPool();
+
+		/**
+		 * @brief Frees the slots.  The events in them must already be destroyed.
+		 */
+		~EventPool();
+
+		/**
+		 * @brief Allocate the slots of the pool.
+		 * @param slotSize The size of the largest event to put in the pool.
+		 * @param numSlots The number of slots in the ring.
+		 */
+		void initWithSlots(Size slotSize, Size numSlots);
+
+		/**
+		 * @brief Take the slot at the head of the ring.
+		 * @param size The size of the event to put in the slot.
+		 * @return The slot, aligned to kAlignment, or NIL if the ring is full or the event too big.
+		 */
+		inline Byte* alloc(Size size) {
+			if (size > m_slotSize || m_head - m_tail >= m_numSlots) {
+				return NIL;
+			}
+			Byte* slot = m_pSlots + (Size)(m_head % m_numSlots) * m_slotSize;
+			++m_head;
+			return slot;
+		}
+
+		/**
+		 * @brief Hand back the slot taken by the last alloc().
+		 */
+		inline void unalloc() { --m_head; }
+
+		/**
+		 * @brief Get the position of the head, to recycle up to later.
+		 * @return The number of slots ever taken from the ring.
+		 */
+		inline U64 head() const { return m_head; }
+
+		/**
+		 * @brief Recycle every slot taken before the head was at the mark.
+		 * The events in them must already be destroyed.
+		 * @param mark A position returned by head().
+		 */
+		inline void recycleTo(U64 mark) { m_tail = mark; }
+
+		/**
+		 * @brief Check to see if an event was constructed in the pool.
+		 * @param event The event to check.
+		 * @return True if the event is in one of the slots.
+		 */
+		inline Boolean owns(const Event* event) const {
+			const Byte* addr = reinterpret_cast<const Byte*>(event);
+			return addr >= m_pSlots && addr < m_pSlots + m_numSlots * m_slotSize;
+		}
+
+		/**
+		 * @return The size of each slot in bytes.
+		 */
+		inline Size slotSize() const { return m_slotSize; }
+
+		/**
+		 * @return The number of slots in the ring.
+		 */
+		inline Size numSlots() const { return m_numSlots; }
+
+		/**
+		 * @return The number of slots in use.
+		 */
+		inline Size numUsed() const { return (Size)(m_head - m_tail); }
+
+	  private:
+		EventPool(const EventPool& src);
+		EventPool& operator=(const EventPool& src);
+
+		Byte* m_pSlots;
+		Byte* m_pUnaligned;
+		Size m_slotSize;
+		Size m_numSlots;
+		U64 m_head;
+		U64 m_tail;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_EVENT_EVENTPOOL_H
@@ -10,9 +10,12 @@
  * @date June 6, 2014
  */
 
+#include <new>
 #include "core/event/event.h"
+#include "core/event/eventpool.h"
 #include "core/util/simplequeue.h"
 #include "core/threading/spinlock.h"
+#include "core/defer/handlergroups.h"
 
 
 namespace Cat {
@@ -23,18 +26,45 @@ namespace Cat {
 	 *
 	 * The EventQueue class allows for posting of events.
 	 *
+	 * Each kind of event has its own handler group (keyboard, mouse and UI
+	 * events).  With a runner set by setParallelDispatch(), the events of
+	 * a run are fanned out across the lanes of the HandlerGroups, in the
+	 * order they were posted within each lane, and processEvents() returns
+	 * once every lane has finished.  The groups share one lane until they
+	 * are declared, e.g. declareIndependentGroup(kEQGMouse).
+	 *
+	 * Events can also be constructed in place with post<T>(), in an
+	 * EventPool kept for each group, rather than allocated by the poster
+	 * and deleted after dispatch.  The slots of a run are recycled once
+	 * the run is processed, and an event combined into the one before it
+	 * hands its slot straight back.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 3
 	 * @since June 6, 2014
 	 */
 	class EventQueue {		
 	  public:
+		/**
+		 * @brief The handler group of each kind of event.
+		 */
+		enum EventQueueGroup {
+			kEQGOther = 0x0,
+			kEQGKeyboard = 0x1,
+			kEQGMouse = 0x2,
+			kEQGUI = 0x3,
+			kEQGNumGroups = 0x4,
+		};
 			
 		/**
 		 * @brief Create an empty EventQueue.
 		 */
 		EventQueue()
-			: m_pCurrentEventQueue(NIL), m_pProcessing(NIL) {
+			: m_pCurrentEventQueue(NIL), m_pProcessing(NIL), m_pRunner(NIL),
+			  m_pDrained(NIL), m_numDrained(0) {
+			for (U32 i = 0; i < kEQGNumGroups; ++i) {
+				m_processMarks[i] = 0;
+			}
 		}
 
 		/**
@@ -70,6 +100,72 @@ namespace Cat {
 			return success;			
 		}
 
+		/**
+		 * @brief Set up the pool to construct the events of a group in.  Not thread safe.
+		 * @param group The EventQueueGroup of the events to pool.
+		 * @param slotSize The size of the largest event class that will be posted in the group.
+		 * @param numSlots The number of events of the group that can be waiting at once.
+		 */
+		void initEventPool(U32 group, Size slotSize, Size numSlots);
+
+		/**
+		 * @brief Post an event of class T, constructed in place in the pool of its group.
+		 * T is constructed from the type, like Event itself.
+		 * @param type The type of the event, which picks the pool.
+		 * @return True if there was room for the event in the pool and the queue, or it was combined.
+		 */
+		template<typename T>
+		inline Boolean post(Event::Type type) {
+			U32 group;
+			Byte* slot = reserveEvent(type, sizeof(T), group);
+			if (!slot) {
+				return false;
+			}
+			return commitEvent(new (slot) T(type), group);
+		}
+
+		/**
+		 * @brief Post an event of class T, constructed in place from the type and one argument.
+		 * @see post(Event::Type)
+		 */
+		template<typename T, typename A1>
+		inline Boolean post(Event::Type type, const A1& a1) {
+			U32 group;
+			Byte* slot = reserveEvent(type, sizeof(T), group);
+			if (!slot) {
+				return false;
+			}
+			return commitEvent(new (slot) T(type, a1), group);
+		}
+
+		/**
+		 * @brief Post an event of class T, constructed in place from the type and two arguments.
+		 * @see post(Event::Type)
+		 */
+		template<typename T, typename A1, typename A2>
+		inline Boolean post(Event::Type type, const A1& a1, const A2& a2) {
+			U32 group;
+			Byte* slot = reserveEvent(type, sizeof(T), group);
+			if (!slot) {
+				return false;
+			}
+			return commitEvent(new (slot) T(type, a1, a2), group);
+		}
+
+		/**
+		 * @brief Post an event of class T, constructed in place from the type and three arguments.
+		 * @see post(Event::Type)
+		 */
+		template<typename T, typename A1, typename A2, typename A3>
+		inline Boolean post(Event::Type type, const A1& a1, const A2& a2, const A3& a3) {
+			U32 group;
+			Byte* slot = reserveEvent(type, sizeof(T), group);
+			if (!slot) {
+				return false;
+			}
+			return commitEvent(new (slot) T(type, a1, a2, a3), group);
+		}
+
 		/**
 		 * @brief Process any events on the queue.
 		 */
@@ -81,6 +177,45 @@ namespace Cat {
 		 * @return true if the event is handled (should always be true I thinks).
 		 */
 		Boolean handleEvent(Event* event);		
+
+		/**
+		 * @brief Fan the events out across an AsyncTaskRunner when processing.
+		 * @param runner The AsyncTaskRunner, not one running processEvents() itself, or NIL to run serially.
+		 */
+		inline void setParallelDispatch(AsyncTaskRunner* runner) { m_pRunner = runner; }
+
+		/**
+		 * @brief Get the handler groups, to declare which groups can run in parallel.
+		 * @return The HandlerGroups of the queue, indexed by EventQueueGroup.
+		 */
+		inline HandlerGroups& handlerGroups() { return m_groups; }
+
+		/**
+		 * @brief Get the handler group of an event.
+		 * @param event The event.
+		 * @return The EventQueueGroup of the handler of the event.
+		 */
+		static inline U32 groupOf(const Event* event) {
+			return groupOfType(event->type());
+		}
+
+		/**
+		 * @brief Get the handler group of a type of event.
+		 * @param type The type of event.
+		 * @return The EventQueueGroup of the handler of the events of the type.
+		 */
+		static inline U32 groupOfType(Event::Type type) {
+			if ((type & Event::kEKeyboardEventMask) != 0) {
+				return kEQGKeyboard;
+			}
+			else if ((type & Event::kEMouseEventMask) != 0) {
+				return kEQGMouse;
+			}
+			else if ((type & Event::kEUIEventMask) != 0) {
+				return kEQGUI;
+			}
+			return kEQGOther;
+		}
 			
 
 #if defined (DEBUG)
@@ -88,6 +223,7 @@ namespace Cat {
 		SimpleQueue<Event*>* eventsTwo() { return &m_eventQueueTwo; }
 		SimpleQueue<Event*>* events() { return m_pCurrentEventQueue; }
 		SimpleQueue<Event*>* processing() { return m_pProcessing; }
+		EventPool* eventPool(U32 group) { return &m_pools[group]; }
 #endif // DEBUG
 
 		/**
@@ -111,6 +247,14 @@ namespace Cat {
 		
 
 	  private:
+		EventQueue(const EventQueue& src);
+		EventQueue& operator=(const EventQueue& src);
+
+		Byte* reserveEvent(Event::Type type, Size size, U32& group);
+		Boolean commitEvent(Event* event, U32 group);
+		void destroyEvent(Event* event);
+		static void processLane(VPtr obj, U32 groupMask);
+
 		SimpleQueue<Event*>* m_pCurrentEventQueue;
 		SimpleQueue<Event*>* m_pProcessing;
 		
@@ -118,6 +262,14 @@ namespace Cat {
 		SimpleQueue<Event*> m_eventQueueOne;
 		SimpleQueue<Event*> m_eventQueueTwo;
 
+		AsyncTaskRunner* m_pRunner;
+		HandlerGroups m_groups;
+		Event** m_pDrained; /**< The events of a run, for the lanes of a parallel dispatch. */
+		Size m_numDrained;
+
+		EventPool m_pools[kEQGNumGroups];
+		U64 m_processMarks[kEQGNumGroups]; /**< The head of each pool when the run being processed was swapped out. */
+
 		static EventQueue* s_pGlobalEventQueue;		
 
 	};
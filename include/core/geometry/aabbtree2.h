@@ -0,0 +1,659 @@
+#ifndef CAT_CORE_GEOMETRY_AABBTREE2_H
+#define CAT_CORE_GEOMETRY_AABBTREE2_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file aabbtree2.h
+ * @brief A dynamic bounding box tree to find overlapping rectangles.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include <cstring>
+#include "core/geometry/rect.h"
+#include "core/util/vector.h"
+
+namespace Cat {
+
+	/**
+	 * @class AabbTree2 aabbtree2.h "core/geometry/aabbtree2.h"
+	 * @brief A dynamic bounding box tree to find overlapping rectangles.
+	 *
+	 * Each rectangle added to the tree is a leaf, and each inner node
+	 * holds the bounds of its two children, so a query only walks down
+	 * the branches that overlap it, which is O(log n + k) for k results.
+	 * The tree is kept balanced with rotations as leaves come and go.
+	 *
+	 * The leaves are stored with bounds fattened by a margin, so a
+	 * rectangle that moves a little can be updated without changing the
+	 * tree at all.  The exact rectangle is kept too, and the queries only
+	 * return rectangles that really overlap (or touch) the query, so the
+	 * results are the same as testing every rectangle one at a time.
+	 *
+	 * Rectangles are identified by the proxy returned from insert(),
+	 * which stays the same until the rectangle is removed.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	template<typename T>
+	class AabbTree2 {
+	  public:
+		static const I32 kNull = -1;
+
+		/**
+		 * @brief A pair of overlapping proxies, first < second.
+		 */
+		struct Pair {
+			I32 first;
+			I32 second;
+		};
+
+		/**
+		 * @brief Create an empty tree.
+		 * @param margin The amount to fatten the bounds of each rectangle by.
+		 */
+		explicit AabbTree2(T margin = 0);
+
+		/**
+		 * @brief Free the nodes of the tree.
+		 */
+		~AabbTree2();
+
+		/**
+		 * @brief Add a rectangle to the tree.
+		 * @param rect The rectangle to add.
+		 * @param data Optional user data to keep with the rectangle.
+		 * @return The proxy of the rectangle in the tree.
+		 */
+		I32 insert(const Rect<T>& rect, VPtr data = NIL);
+
+		/**
+		 * @brief Remove a rectangle from the tree.
+		 * @param proxy The proxy returned by insert().
+		 */
+		void remove(I32 proxy);
+
+		/**
+		 * @brief Move or resize a rectangle in the tree.
+		 * @param proxy The proxy returned by insert().
+		 * @param rect The new rectangle.
+		 * @return True if the tree had to be changed, false if the new
+		 * rectangle was still inside the fattened bounds.
+		 */
+		Boolean update(I32 proxy, const Rect<T>& rect);
+
+		/**
+		 * @brief Remove all the rectangles from the tree.
+		 */
+		void clear();
+
+		/**
+		 * @brief Get the number of rectangles in the tree.
+		 * @return The number of rectangles in the tree.
+		 */
+		inline Size size() const { return m_numProxies; }
+
+		/**
+		 * @brief Get the height of the tree, 0 if empty, 1 for a single leaf.
+		 * @return The height of the tree.
+		 */
+		inline I32 height() const {
+			return m_root == kNull ? 0 : m_pNodes[m_root].height + 1;
+		}
+
+		/**
+		 * @brief Get the user data of a rectangle.
+		 * @param proxy The proxy returned by insert().
+		 * @return The user data passed to insert().
+		 */
+		inline VPtr getData(I32 proxy) const { return m_pNodes[proxy].data; }
+
+		/**
+		 * @brief Get a rectangle in the tree.
+		 * @param proxy The proxy returned by insert().
+		 * @return The rectangle, as passed to insert() or update().
+		 */
+		inline Rect<T> getRect(I32 proxy) const { return toRect(m_pNodes[proxy].tight); }
+
+		/**
+		 * @brief Get the fattened bounds of a rectangle in the tree.
+		 * @param proxy The proxy returned by insert().
+		 * @return The fattened bounds used to place the rectangle in the tree.
+		 */
+		inline Rect<T> getFatRect(I32 proxy) const { return toRect(m_pNodes[proxy].fat); }
+
+		/**
+		 * @brief Find the rectangles that overlap or touch a region.
+		 * @param region The region to look in.
+		 * @param results The vector to append the proxies found to.
+		 * @return The number of proxies found.
+		 */
+		Size query(const Rect<T>& region, Vector<I32>& results) const;
+
+		/**
+		 * @brief Find the rectangles that contain a point, or have it on an edge.
+		 * @param point The point to look for.
+		 * @param results The vector to append the proxies found to.
+		 * @return The number of proxies found.
+		 */
+		inline Size query(const Point2<T>& point, Vector<I32>& results) const {
+			return query(Rect<T>(point.x, point.y, 0, 0), results);
+		}
+
+		/**
+		 * @brief Find every pair of rectangles that overlap or touch.
+		 * @param pairs The vector to append the pairs found to.
+		 * @return The number of pairs found.
+		 */
+		Size queryPairs(Vector<Pair>& pairs) const;
+
+		/**
+		 * @brief Check that the tree is well formed (for testing).
+		 * @return True if every node bounds its children and the heights are right.
+		 */
+		Boolean validate() const;
+
+	  private:
+		struct Bounds {
+			T minX, minY, maxX, maxY;
+		};
+
+		struct Node {
+			Bounds fat;
+			Bounds tight;
+			VPtr	 data;
+			I32	 parent;	/* The next free node, when on the free list */
+			I32	 child1;
+			I32	 child2;
+			I32	 height;	/* 0 for a leaf, -1 when free */
+
+			inline Boolean isLeaf() const { return child1 == kNull; }
+		};
+
+		/**
+		 * @brief A stack of nodes to visit, on the stack unless the tree is very deep.
+		 */
+		class NodeStack {
+		  public:
+			inline NodeStack() : m_pNodes(m_local), m_size(0), m_capacity(kLocal) {}
+			inline ~NodeStack() {
+				if (m_pNodes != m_local) {
+					delete[] m_pNodes;
+				}
+			}
+			inline void push(I32 node) {
+				if (m_size == m_capacity) {
+					I32* nodes = new I32[m_capacity*2];
+					memcpy(nodes, m_pNodes, sizeof(I32)*m_size);
+					if (m_pNodes != m_local) {
+						delete[] m_pNodes;
+					}
+					m_pNodes = nodes;
+					m_capacity *= 2;
+				}
+				m_pNodes[m_size++] = node;
+			}
+			inline I32 pop() { return m_pNodes[--m_size]; }
+			inline Boolean isEmpty() const { return m_size == 0; }
+
+		  private:
+			static const Size kLocal = 64;
+			I32	m_local[kLocal];
+			I32*	m_pNodes;
+			Size	m_size;
+			Size	m_capacity;
+		};
+
+		Node*	m_pNodes;
+		I32	m_root;
+		I32	m_freeList;
+		I32	m_capacity;
+		Size	m_numProxies;
+		T		m_margin;
+
+		I32 allocateNode();
+		void freeNode(I32 node);
+		void insertLeaf(I32 leaf);
+		void removeLeaf(I32 leaf);
+		I32 balance(I32 node);
+		void refit(I32 node);
+		I32 validate(I32 node, Boolean& ok) const;
+
+		static inline Bounds toBounds(const Rect<T>& rect) {
+			Bounds b;
+			b.minX = rect.left() < rect.right() ? rect.left() : rect.right();
+			b.maxX = rect.left() < rect.right() ? rect.right() : rect.left();
+			b.minY = rect.bottom() < rect.top() ? rect.bottom() : rect.top();
+			b.maxY = rect.bottom() < rect.top() ? rect.top() : rect.bottom();
+			return b;
+		}
+
+		static inline Rect<T> toRect(const Bounds& b) {
+			return Rect<T>(b.minX, b.maxY, b.maxX - b.minX, b.maxY - b.minY);
+		}
+
+		static inline Bounds combine(const Bounds& a, const Bounds& b) {
+			Bounds c;
+			c.minX = a.minX < b.minX ? a.minX : b.minX;
+			c.minY = a.minY < b.minY ? a.minY : b.minY;
+			c.maxX = a.maxX > b.maxX ? a.maxX : b.maxX;
+			c.maxY = a.maxY > b.maxY ? a.maxY : b.maxY;
+			return c;
+		}
+
+		/* The perimeter is the cost of a node, as a bigger node is visited more */
+		static inline F64 perimeter(const Bounds& b) {
+			return 2.0*(((F64)b.maxX - (F64)b.minX) + ((F64)b.maxY - (F64)b.minY));
+		}
+
+		static inline Boolean overlaps(const Bounds& a, const Bounds& b) {
+			return a.minX <= b.maxX && b.minX <= a.maxX &&
+				a.minY <= b.maxY && b.minY <= a.maxY;
+		}
+
+		static inline Boolean contains(const Bounds& outer, const Bounds& inner) {
+			return outer.minX <= inner.minX && outer.minY <= inner.minY &&
+				inner.maxX <= outer.maxX && inner.maxY <= outer.maxY;
+		}
+
+		AabbTree2(const AabbTree2<T>&);
+		AabbTree2<T>& operator=(const AabbTree2<T>&);
+	};
+
+	template<typename T>
+	AabbTree2<T>::AabbTree2(T margin)
+		: m_pNodes(NIL), m_root(kNull), m_freeList(kNull), m_capacity(0),
+		  m_numProxies(0), m_margin(margin) {}
+
+	template<typename T>
+	AabbTree2<T>::~AabbTree2() {
+		delete[] m_pNodes;
+	}
+
+	template<typename T>
+	I32 AabbTree2<T>::allocateNode() {
+		if (m_freeList == kNull) {
+			/* Grow the pool, and put the new nodes on the free list */
+			I32 capacity = m_capacity ? m_capacity*2 : 16;
+			Node* nodes = new Node[capacity];
+			if (m_pNodes) {
+				memcpy(nodes, m_pNodes, sizeof(Node)*m_capacity);
+				delete[] m_pNodes;
+			}
+			m_pNodes = nodes;
+			for (I32 i = m_capacity; i < capacity; ++i) {
+				m_pNodes[i].parent = (i + 1 < capacity) ? i + 1 : kNull;
+				m_pNodes[i].height = -1;
+			}
+			m_freeList = m_capacity;
+			m_capacity = capacity;
+		}
+		I32 node = m_freeList;
+		Node& n = m_pNodes[node];
+		m_freeList = n.parent;
+		n.parent = kNull;
+		n.child1 = kNull;
+		n.child2 = kNull;
+		n.height = 0;
+		n.data = NIL;
+		return node;
+	}
+
+	template<typename T>
+	void AabbTree2<T>::freeNode(I32 node) {
+		m_pNodes[node].parent = m_freeList;
+		m_pNodes[node].height = -1;
+		m_freeList = node;
+	}
+
+	template<typename T>
+	I32 AabbTree2<T>::insert(const Rect<T>& rect, VPtr data) {
+		I32 proxy = allocateNode();
+		Node& n = m_pNodes[proxy];
+		n.tight = toBounds(rect);
+		n.fat.minX = n.tight.minX - m_margin;
+		n.fat.minY = n.tight.minY - m_margin;
+		n.fat.maxX = n.tight.maxX + m_margin;
+		n.fat.maxY = n.tight.maxY + m_margin;
+		n.data = data;
+		insertLeaf(proxy);
+		++m_numProxies;
+		return proxy;
+	}
+
+	template<typename T>
+	void AabbTree2<T>::remove(I32 proxy) {
+		if (proxy < 0 || proxy >= m_capacity || !m_pNodes[proxy].isLeaf() ||
+			 m_pNodes[proxy].height != 0) {
+			DWARN("Trying to remove an invalid proxy from an AabbTree2: " << proxy << "!");
+			return;
+		}
+		removeLeaf(proxy);
+		freeNode(proxy);
+		--m_numProxies;
+	}
+
+	template<typename T>
+	Boolean AabbTree2<T>::update(I32 proxy, const Rect<T>& rect) {
+		Node& n = m_pNodes[proxy];
+		n.tight = toBounds(rect);
+		if (contains(n.fat, n.tight)) {
+			return false;
+		}
+		removeLeaf(proxy);
+		n.fat.minX = n.tight.minX - m_margin;
+		n.fat.minY = n.tight.minY - m_margin;
+		n.fat.maxX = n.tight.maxX + m_margin;
+		n.fat.maxY = n.tight.maxY + m_margin;
+		insertLeaf(proxy);
+		return true;
+	}
+
+	template<typename T>
+	void AabbTree2<T>::clear() {
+		for (I32 i = 0; i < m_capacity; ++i) {
+			m_pNodes[i].parent = (i + 1 < m_capacity) ? i + 1 : kNull;
+			m_pNodes[i].height = -1;
+		}
+		m_freeList = m_capacity ? 0 : kNull;
+		m_root = kNull;
+		m_numProxies = 0;
+	}
+
+	template<typename T>
+	void AabbTree2<T>::insertLeaf(I32 leaf) {
+		if (m_root == kNull) {
+			m_root = leaf;
+			m_pNodes[leaf].parent = kNull;
+			return;
+		}
+
+		/* Find the best sibling, going down the cheaper side while that
+		 * is cheaper than making a new parent here */
+		Bounds leafBounds = m_pNodes[leaf].fat;
+		I32 index = m_root;
+		while (!m_pNodes[index].isLeaf()) {
+			const Node& n = m_pNodes[index];
+			F64 area = perimeter(n.fat);
+			F64 combined = perimeter(combine(n.fat, leafBounds));
+			F64 cost = 2.0*combined;
+			F64 inheritance = 2.0*(combined - area);
+
+			const Node& c1 = m_pNodes[n.child1];
+			F64 cost1 = perimeter(combine(leafBounds, c1.fat)) + inheritance;
+			if (!c1.isLeaf()) {
+				cost1 -= perimeter(c1.fat);
+			}
+			const Node& c2 = m_pNodes[n.child2];
+			F64 cost2 = perimeter(combine(leafBounds, c2.fat)) + inheritance;
+			if (!c2.isLeaf()) {
+				cost2 -= perimeter(c2.fat);
+			}
+
+			if (cost < cost1 && cost < cost2) {
+				break;
+			}
+			index = cost1 < cost2 ? n.child1 : n.child2;
+		}
+
+		/* Put a new parent in place of the sibling */
+		I32 sibling = index;
+		I32 oldParent = m_pNodes[sibling].parent;
+		I32 newParent = allocateNode();
+		Node& p = m_pNodes[newParent];
+		p.parent = oldParent;
+		p.fat = combine(leafBounds, m_pNodes[sibling].fat);
+		p.height = m_pNodes[sibling].height + 1;
+		p.child1 = sibling;
+		p.child2 = leaf;
+		m_pNodes[sibling].parent = newParent;
+		m_pNodes[leaf].parent = newParent;
+		if (oldParent == kNull) {
+			m_root = newParent;
+		} else if (m_pNodes[oldParent].child1 == sibling) {
+			m_pNodes[oldParent].child1 = newParent;
+		} else {
+			m_pNodes[oldParent].child2 = newParent;
+		}
+
+		refit(newParent);
+	}
+
+	template<typename T>
+	void AabbTree2<T>::removeLeaf(I32 leaf) {
+		if (leaf == m_root) {
+			m_root = kNull;
+			return;
+		}
+
+		I32 parent = m_pNodes[leaf].parent;
+		I32 grandParent = m_pNodes[parent].parent;
+		I32 sibling = m_pNodes[parent].child1 == leaf ?
+			m_pNodes[parent].child2 : m_pNodes[parent].child1;
+
+		if (grandParent == kNull) {
+			m_root = sibling;
+			m_pNodes[sibling].parent = kNull;
+			freeNode(parent);
+			return;
+		}
+		/* The sibling takes the place of the parent */
+		if (m_pNodes[grandParent].child1 == parent) {
+			m_pNodes[grandParent].child1 = sibling;
+		} else {
+			m_pNodes[grandParent].child2 = sibling;
+		}
+		m_pNodes[sibling].parent = grandParent;
+		freeNode(parent);
+		refit(grandParent);
+	}
+
+	template<typename T>
+	void AabbTree2<T>::refit(I32 node) {
+		/* Walk back up, rebalancing and fixing the bounds and heights */
+		while (node != kNull) {
+			node = balance(node);
+			Node& n = m_pNodes[node];
+			const Node& c1 = m_pNodes[n.child1];
+			const Node& c2 = m_pNodes[n.child2];
+			n.height = 1 + (c1.height > c2.height ? c1.height : c2.height);
+			n.fat = combine(c1.fat, c2.fat);
+			node = n.parent;
+		}
+	}
+
+	template<typename T>
+	I32 AabbTree2<T>::balance(I32 iA) {
+		Node& a = m_pNodes[iA];
+		if (a.isLeaf() || a.height < 2) {
+			return iA;
+		}
+		I32 iB = a.child1;
+		I32 iC = a.child2;
+		Node& b = m_pNodes[iB];
+		Node& c = m_pNodes[iC];
+		I32 diff = c.height - b.height;
+
+		if (diff > 1) {
+			/* Rotate C up */
+			I32 iF = c.child1;
+			I32 iG = c.child2;
+			Node& f = m_pNodes[iF];
+			Node& g = m_pNodes[iG];
+
+			c.child1 = iA;
+			c.parent = a.parent;
+			a.parent = iC;
+			if (c.parent == kNull) {
+				m_root = iC;
+			} else if (m_pNodes[c.parent].child1 == iA) {
+				m_pNodes[c.parent].child1 = iC;
+			} else {
+				m_pNodes[c.parent].child2 = iC;
+			}
+
+			if (f.height > g.height) {
+				c.child2 = iF;
+				a.child2 = iG;
+				g.parent = iA;
+				a.fat = combine(b.fat, g.fat);
+				c.fat = combine(a.fat, f.fat);
+				a.height = 1 + (b.height > g.height ? b.height : g.height);
+				c.height = 1 + (a.height > f.height ? a.height : f.height);
+			} else {
+				c.child2 = iG;
+				a.child2 = iF;
+				f.parent = iA;
+				a.fat = combine(b.fat, f.fat);
+				c.fat = combine(a.fat, g.fat);
+				a.height = 1 + (b.height > f.height ? b.height : f.height);
+				c.height = 1 + (a.height > g.height ? a.height : g.height);
+			}
+			return iC;
+		}
+
+		if (diff < -1) {
+			/* Rotate B up */
+			I32 iD = b.child1;
+			I32 iE = b.child2;
+			Node& d = m_pNodes[iD];
+			Node& e = m_pNodes[iE];
+
+			b.child1 = iA;
+			b.parent = a.parent;
+			a.parent = iB;
+			if (b.parent == kNull) {
+				m_root = iB;
+			} else if (m_pNodes[b.parent].child1 == iA) {
+				m_pNodes[b.parent].child1 = iB;
+			} else {
+				m_pNodes[b.parent].child2 = iB;
+			}
+
+			if (d.height > e.height) {
+				b.child2 = iD;
+				a.child1 = iE;
+				e.parent = iA;
+				a.fat = combine(c.fat, e.fat);
+				b.fat = combine(a.fat, d.fat);
+				a.height = 1 + (c.height > e.height ? c.height : e.height);
+				b.height = 1 + (a.height > d.height ? a.height : d.height);
+			} else {
+				b.child2 = iE;
+				a.child1 = iD;
+				d.parent = iA;
+				a.fat = combine(c.fat, d.fat);
+				b.fat = combine(a.fat, e.fat);
+				a.height = 1 + (c.height > d.height ? c.height : d.height);
+				b.height = 1 + (a.height > e.height ? a.height : e.height);
+			}
+			return iB;
+		}
+
+		return iA;
+	}
+
+	template<typename T>
+	Size AabbTree2<T>::query(const Rect<T>& region, Vector<I32>& results) const {
+		if (m_root == kNull) {
+			return 0;
+		}
+		if (results.capacity() == 0) {
+			results.reserve(16);
+		}
+		Bounds b = toBounds(region);
+		Size found = 0;
+		NodeStack stack;
+		stack.push(m_root);
+		while (!stack.isEmpty()) {
+			const Node& n = m_pNodes[stack.pop()];
+			if (!overlaps(n.fat, b)) {
+				continue;
+			}
+			if (n.isLeaf()) {
+				if (overlaps(n.tight, b)) {
+					results.append((I32)(&n - m_pNodes));
+					++found;
+				}
+			} else {
+				stack.push(n.child1);
+				stack.push(n.child2);
+			}
+		}
+		return found;
+	}
+
+	template<typename T>
+	Size AabbTree2<T>::queryPairs(Vector<Pair>& pairs) const {
+		if (pairs.capacity() == 0) {
+			pairs.reserve(16);
+		}
+		Size found = 0;
+		NodeStack stack;
+		for (I32 leaf = 0; leaf < m_capacity; ++leaf) {
+			const Node& l = m_pNodes[leaf];
+			if (l.height != 0) {
+				continue;
+			}
+			/* Each pair is found from both ends, only keep it from the lower proxy */
+			stack.push(m_root);
+			while (!stack.isEmpty()) {
+				I32 index = stack.pop();
+				const Node& n = m_pNodes[index];
+				if (!overlaps(n.fat, l.tight)) {
+					continue;
+				}
+				if (n.isLeaf()) {
+					if (index > leaf && overlaps(n.tight, l.tight)) {
+						Pair p;
+						p.first = leaf;
+						p.second = index;
+						pairs.append(p);
+						++found;
+					}
+				} else {
+					stack.push(n.child1);
+					stack.push(n.child2);
+				}
+			}
+		}
+		return found;
+	}
+
+	template<typename T>
+	Boolean AabbTree2<T>::validate() const {
+		Boolean ok = true;
+		if (m_root != kNull) {
+			if (m_pNodes[m_root].parent != kNull) {
+				ok = false;
+			}
+			validate(m_root, ok);
+		}
+		return ok;
+	}
+
+	template<typename T>
+	I32 AabbTree2<T>::validate(I32 node, Boolean& ok) const {
+		const Node& n = m_pNodes[node];
+		if (n.isLeaf()) {
+			if (n.height != 0 || !contains(n.fat, n.tight)) {
+				ok = false;
+			}
+			return 1;
+		}
+		const Node& c1 = m_pNodes[n.child1];
+		const Node& c2 = m_pNodes[n.child2];
+		if (c1.parent != node || c2.parent != node ||
+			 !contains(n.fat, c1.fat) || !contains(n.fat, c2.fat) ||
+			 n.height != 1 + (c1.height > c2.height ? c1.height : c2.height)) {
+			ok = false;
+		}
+		return validate(n.child1, ok) + validate(n.child2, ok);
+	}
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_AABBTREE2_H
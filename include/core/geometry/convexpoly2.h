@@ -10,6 +10,7 @@
  * @date Sept 3, 2014
  */
 
+#include "core/geometry/convexpolykernels.h"
 #include "core/geometry/rect.h"
 #include "core/util/vector.h"
 
@@ -22,8 +23,13 @@ namespace Cat {
 	 * A 2D Convex Polygon class template with methods for 
 	 * creating and working with the convex polygon.
 	 *
+	 * The point tests go through the ConvexPolyKernels, which test
+	 * floating point polygons with SIMD, and there are batch versions to
+	 * test many points against one polygon, or one point against many
+	 * polygons, for hit testing.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 2
+	 * @version 3
 	 * @since July 26, 2014
 	 */
 	template<typename T>
@@ -122,6 +128,31 @@ namespace Cat {
 			return contains(Point2<T>((T)x, (T)y));
 		}
 
+		/**
+		 * @brief Test to see which of an array of points are in the polygon.
+		 * @param points The points to test.
+		 * @param count The number of points to test.
+		 * @param results The array to store whether each point is in the polygon.
+		 * @return The number of points in the polygon.
+		 */
+		inline Size contains(const Point2<T>* points, Size count, Boolean* results) const {
+			return ConvexPolyKernels::containsPoints(m_points.dataPtr(), m_points.size(),
+																  points, count, results);
+		}
+
+		/**
+		 * @brief Test to see which of an array of polygons contain a point.
+		 * Polygons whose bounds do not contain the point are skipped before
+		 * testing any of their edges.
+		 * @param polys The polygons to test.
+		 * @param count The number of polygons to test.
+		 * @param point The point to test.
+		 * @param results The array to store whether each polygon contains the point.
+		 * @return The number of polygons containing the point.
+		 */
+		static Size findContaining(const ConvexPoly2<T>* const* polys, Size count,
+											const Point2<T>& point, Boolean* results);
+
 		/**
 		 * @brief Test to see if a polygon is contained in this polygon.
 		 * This method returns true only if the entire polygon is contained 
@@ -147,6 +178,15 @@ namespace Cat {
 			return m_bounds.height();
 		}
 
+		/**
+		 * @brief Check to see if another polygon overlaps or touches this one.
+		 * Uses the separating axis theorem, stopping at the first edge of
+		 * either polygon that has the other polygon entirely outside it.
+		 * @param poly The polygon to check for overlap.
+		 * @return True if the polygons overlap or touch.
+		 */
+		Boolean overlaps(const ConvexPoly2<T>& poly) const;
+
 		/**
 		 * @brief Check to see if another polygon intersects this one.
 		 * @param The polygon to check for intersection.
@@ -563,6 +603,13 @@ namespace Cat {
 	  protected:
 		Vector< Point2<T> > m_points;
 		Rect<T> m_bounds;
+
+		/**
+		 * @brief Check to see if the polygon is entirely outside one of our edges.
+		 * @param poly The polygon to check.
+		 * @return True if one of our edges separates the polygons.
+		 */
+		Boolean hasSeparatingEdge(const ConvexPoly2<T>& poly) const;
 	};
 
 	template<typename T>
@@ -640,17 +687,61 @@ namespace Cat {
 
 	template<typename T>
 	Boolean ConvexPoly2<T>::contains(const Point2<T>& point) const {
-		for (Size i = 1; i < m_points.size(); ++i) {
-			if (Point2<T>::isLeftTurn(m_points.get(i-1), m_points.get(i), point)) {
-				return false;
+		return ConvexPolyKernels::containsPoint(m_points.dataPtr(), m_points.size(), point);
+	}	
+
+	template<typename T>
+	Size ConvexPoly2<T>::findContaining(const ConvexPoly2<T>* const* polys, Size count,
+													const Point2<T>& point, Boolean* results) {
+		Size found = 0;
+		for (Size i = 0; i < count; ++i) {
+			const Rect<T>& b = polys[i]->m_bounds;
+			/* The edges are on the bounds, so only skip points strictly outside */
+			if (point.x < b.left() || point.x > b.right() ||
+				 point.y < b.bottom() || point.y > b.top()) {
+				results[i] = false;
+				continue;
 			}
+			results[i] = polys[i]->contains(point);
+			found += results[i] ? 1 : 0;
 		}
-		/* Check final line */
-		if (Point2<T>::isLeftTurn(m_points.last(), m_points.get(0), point)) {
+		return found;
+	}
+
+	template<typename T>
+	Boolean ConvexPoly2<T>::overlaps(const ConvexPoly2<T>& poly) const {
+		if (m_points.size() == 0 || poly.m_points.size() == 0) {
 			return false;
-		}		
-		return true;		
-	}	
+		}
+		/* The bounding rectangles are the cheapest separating axes */
+		if (m_bounds.left() > poly.m_bounds.right() || poly.m_bounds.left() > m_bounds.right() ||
+			 m_bounds.bottom() > poly.m_bounds.top() || poly.m_bounds.bottom() > m_bounds.top()) {
+			return false;
+		}
+		return !hasSeparatingEdge(poly) && !poly.hasSeparatingEdge(*this);
+	}
+
+	template<typename T>
+	Boolean ConvexPoly2<T>::hasSeparatingEdge(const ConvexPoly2<T>& poly) const {
+		/* This polygon is entirely on or inside each of its edges, so an edge
+		 * separates the polygons if every point of the other one is outside it */
+		Size n = m_points.size();
+		for (Size i = 0; i < n; ++i) {
+			const Point2<T>& p1 = m_points.get(i);
+			const Point2<T>& p2 = m_points.get(i + 1 < n ? i + 1 : 0);
+			Boolean separates = true;
+			for (Size j = 0; j < poly.m_points.size(); ++j) {
+				if (!ConvexPolyKernels::isOutside(p1, p2, poly.m_points.get(j))) {
+					separates = false;
+					break;
+				}
+			}
+			if (separates) {
+				return true;
+			}
+		}
+		return false;
+	}
 
 	template<typename T>
 	Boolean ConvexPoly2<T>::contains(const ConvexPoly2<T>& poly) const {
@@ -0,0 +1,148 @@
+#ifndef CAT_CORE_GEOMETRY_CONVEXPOLY2INDEX_H
+#define CAT_CORE_GEOMETRY_CONVEXPOLY2INDEX_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file convexpoly2index.h
+ * @brief An index of convex polygons to pick them by point or region.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/geometry/aabbtree2.h"
+#include "core/geometry/convexpoly2.h"
+
+namespace Cat {
+
+	/**
+	 * @class ConvexPoly2Index convexpoly2index.h "core/geometry/convexpoly2index.h"
+	 * @brief An index of convex polygons to pick them by point or region.
+	 *
+	 * The bounding rectangles of the polygons are kept in an AabbTree2,
+	 * which quickly finds the few polygons whose bounds are near a point
+	 * (the broad phase), and only those are then tested with
+	 * ConvexPoly2::contains() (the narrow phase).  The index only keeps
+	 * pointers to the polygons, so a polygon must be updated in the index
+	 * after it is moved, and removed before it is destroyed.  pick() and
+	 * query() keep no state of their own, so several threads can use them
+	 * at once while nothing modifies the index.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	template<typename T>
+	class ConvexPoly2Index {
+	  public:
+		static const I32 kNull = -1;
+
+		/**
+		 * @brief Create an empty index.
+		 * @param margin The amount to fatten the bounds of each polygon by,
+		 * see AabbTree2.
+		 */
+		explicit ConvexPoly2Index(T margin = 0) : m_tree(margin) {}
+
+		/**
+		 * @brief Add a polygon to the index.
+		 * @param poly The polygon to add, which must outlive its place in the index.
+		 * @return The id of the polygon in the index.
+		 */
+		inline I32 add(const ConvexPoly2<T>* poly) {
+			return m_tree.insert(poly->rect(), (VPtr)poly);
+		}
+
+		/**
+		 * @brief Remove a polygon from the index.
+		 * @param id The id returned by add().
+		 */
+		inline void remove(I32 id) {
+			m_tree.remove(id);
+		}
+
+		/**
+		 * @brief Update the index after a polygon has moved or changed shape.
+		 * @param id The id returned by add().
+		 * @return True if the tree had to be changed.
+		 */
+		inline Boolean update(I32 id) {
+			return m_tree.update(id, get(id)->rect());
+		}
+
+		/**
+		 * @brief Remove all the polygons from the index.
+		 */
+		inline void clear() {
+			m_tree.clear();
+		}
+
+		/**
+		 * @brief Get a polygon in the index.
+		 * @param id The id returned by add().
+		 * @return The polygon.
+		 */
+		inline const ConvexPoly2<T>* get(I32 id) const {
+			return (const ConvexPoly2<T>*)m_tree.getData(id);
+		}
+
+		/**
+		 * @brief Get the number of polygons in the index.
+		 * @return The number of polygons.
+		 */
+		inline Size size() const { return m_tree.size(); }
+
+		/**
+		 * @brief Get the tree of the bounding rectangles, e.g. to find
+		 * pairs of polygons whose bounds overlap.
+		 * @return The tree of the bounding rectangles.
+		 */
+		inline const AabbTree2<T>& tree() const { return m_tree; }
+
+		/**
+		 * @brief Find the polygons whose bounds overlap or touch a region.
+		 * @param region The region to look in.
+		 * @param results The vector to append the ids found to.
+		 * @return The number of ids found.
+		 */
+		inline Size query(const Rect<T>& region, Vector<I32>& results) const {
+			return m_tree.query(region, results);
+		}
+
+		/**
+		 * @brief Find the polygons that contain a point.
+		 * @param point The point to look for.
+		 * @param results The vector to append the ids found to.
+		 * @return The number of ids found.
+		 */
+		Size pick(const Point2<T>& point, Vector<I32>& results) const;
+
+	  private:
+		AabbTree2<T> m_tree;
+
+		ConvexPoly2Index(const ConvexPoly2Index<T>&);
+		ConvexPoly2Index<T>& operator=(const ConvexPoly2Index<T>&);
+	};
+
+	template<typename T>
+	Size ConvexPoly2Index<T>::pick(const Point2<T>& point, Vector<I32>& results) const {
+		/* The candidates go straight into results and are filtered in place, so no scratch is shared */
+		Size start = results.size();
+		Size end = start + m_tree.query(point, results);
+		Size found = 0;
+		for (Size i = start; i < end; ++i) {
+			I32 id = results.get(i);
+			if (get(id)->contains(point)) {
+				results.set(start + found, id);
+				++found;
+			}
+		}
+		while (results.size() > start + found) {
+			results.removeLast();
+		}
+		return found;
+	}
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_CONVEXPOLY2INDEX_H
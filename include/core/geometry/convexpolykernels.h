@@ -0,0 +1,174 @@
+#ifndef CAT_CORE_GEOMETRY_CONVEXPOLYKERNELS_H
+#define CAT_CORE_GEOMETRY_CONVEXPOLYKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file convexpolykernels.h
+ * @brief The vectorised (SSE2 / AVX2) point in convex polygon kernels.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/geometry/point2.h"
+
+namespace Cat {
+
+	/**
+	 * @class ConvexPolyKernels convexpolykernels.h "core/geometry/convexpolykernels.h"
+	 * @brief The vectorised (SSE2 / AVX2) point in convex polygon kernels.
+	 *
+	 * A point is in a clockwise convex polygon if it is not to the left
+	 * of any of the edges, i.e., the edge function
+	 * (p2.x - p1.x)*(p.y - p1.y) - (p2.y - p1.y)*(p.x - p1.x)
+	 * is not positive for any edge p1 -> p2 (the same test as
+	 * Point2::isLeftTurn()).  Points on an edge are in the polygon.
+	 *
+	 * For floating point polygons, the kernels evaluate the edge function
+	 * for 4 (SSE2) or 8 (AVX2) points at a time, or for 4 edges at a time
+	 * when testing a single point, and stop as soon as every lane is
+	 * outside.  The function is computed with the same operations in the
+	 * same order as the scalar test, so the results are exactly the same.
+	 * The best table for the running CPU is selected once, on first use,
+	 * like the MathKernels.  Other coordinate types use the scalar loops.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class ConvexPolyKernels {
+	  public:
+		struct Table {
+			/**
+			 * @brief Test many points against one polygon.
+			 */
+			Size (*containsPoints)(const Point2<F32>* poly, Size numPoly,
+										  const Point2<F32>* points, Size count, Boolean* results);
+
+			/**
+			 * @brief Test one point against one polygon.
+			 */
+			Boolean (*containsPoint)(const Point2<F32>* poly, Size numPoly,
+											 const Point2<F32>& point);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+		/**
+		 * @brief Test to see if a point is to the left of an edge.
+		 * @param p1 The start of the edge.
+		 * @param p2 The end of the edge.
+		 * @param point The point to test.
+		 * @return True if the point is outside a clockwise polygon with the edge.
+		 */
+		template<typename T>
+		static inline Boolean isOutside(const Point2<T>& p1, const Point2<T>& p2,
+												  const Point2<T>& point) {
+			return Point2<T>::isLeftTurn(p1, p2, point);
+		}
+
+		/**
+		 * @brief Test to see if a point is in a convex polygon.
+		 * @param poly The points of the polygon, in clockwise order.
+		 * @param numPoly The number of points in the polygon.
+		 * @param point The point to test.
+		 * @return True if the point is in the polygon or on an edge.
+		 */
+		template<typename T>
+		static Boolean containsPoint(const Point2<T>* poly, Size numPoly, const Point2<T>& point);
+
+		/**
+		 * @brief Test to see if a point is in a convex polygon, 4 edges at a time.
+		 * @see containsPoint(const Point2<T>*, Size, const Point2<T>&)
+		 */
+		static inline Boolean containsPoint(const Point2<F32>* poly, Size numPoly,
+														const Point2<F32>& point) {
+			return table().containsPoint(poly, numPoly, point);
+		}
+
+		/**
+		 * @brief Test to see which of an array of points are in a convex polygon.
+		 * @param poly The points of the polygon, in clockwise order.
+		 * @param numPoly The number of points in the polygon.
+		 * @param points The points to test.
+		 * @param count The number of points to test.
+		 * @param results The array to store whether each point is in the polygon.
+		 * @return The number of points in the polygon.
+		 */
+		template<typename T>
+		static Size containsPoints(const Point2<T>* poly, Size numPoly, const Point2<T>* points,
+											Size count, Boolean* results);
+
+		/**
+		 * @brief Test to see which of an array of points are in a convex
+		 * polygon, 4 or 8 points at a time.
+		 * @see containsPoints(const Point2<T>*, Size, const Point2<T>*, Size, Boolean*)
+		 */
+		static inline Size containsPoints(const Point2<F32>* poly, Size numPoly,
+													 const Point2<F32>* points, Size count,
+													 Boolean* results) {
+			return table().containsPoints(poly, numPoly, points, count, results);
+		}
+
+	  private:
+		static const Table* selectTable();
+	};
+
+	template<typename T>
+	Boolean ConvexPolyKernels::containsPoint(const Point2<T>* poly, Size numPoly,
+														  const Point2<T>& point) {
+		if (numPoly == 0) {
+			return false;
+		}
+		for (Size i = 1; i < numPoly; ++i) {
+			if (isOutside(poly[i-1], poly[i], point)) {
+				return false;
+			}
+		}
+		/* Check final line */
+		return !isOutside(poly[numPoly-1], poly[0], point);
+	}
+
+	template<typename T>
+	Size ConvexPolyKernels::containsPoints(const Point2<T>* poly, Size numPoly,
+														const Point2<T>* points, Size count,
+														Boolean* results) {
+		Size found = 0;
+		for (Size i = 0; i < count; ++i) {
+			results[i] = containsPoint<T>(poly, numPoly, points[i]);
+			found += results[i] ? 1 : 0;
+		}
+		return found;
+	}
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_CONVEXPOLYKERNELS_H
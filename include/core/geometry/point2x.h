@@ -0,0 +1,97 @@
+#ifndef CAT_CORE_GEOMETRY_POINT2X_H
+#define CAT_CORE_GEOMETRY_POINT2X_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file point2x.h
+ * @brief A 2D point stored as 16.16 fixed point values.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/geometry/point2f.h"
+#include "core/math/convertkernels.h"
+
+namespace Cat {
+
+	/**
+	 * @class Point2x point2x.h "core/geometry/point2x.h"
+	 * @brief A 2D point stored as 16.16 fixed point values.
+	 *
+	 * A Point2x has an exact, uniform precision of 1/65536 over the range
+	 * +-32768, which suits large, tiled worlds better than a float does.
+	 * Arrays of them are converted to Point2f for computing with unpack(),
+	 * and back with pack(), which use the ConvertKernels.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Point2x {
+	  public:
+		Fixed x, y;
+
+		/**
+		 * @brief Create a point at (0,0).
+		 */
+		inline Point2x()
+			: x(0), y(0) {}
+
+		/**
+		 * @brief Create a point from the nearest fixed point values to a Point2f.
+		 * @param p The point to convert.
+		 */
+		inline explicit Point2x(const Point2f& p)
+			: x(FixedPoint::fromReal(p.x)), y(FixedPoint::fromReal(p.y)) {}
+
+		/**
+		 * @brief Overloaded equality operator
+		 * @param rhs The point to compare to.
+		 * @return True if the points are equal.
+		 */
+		inline Boolean operator==(const Point2x& rhs) const {
+			return (x == rhs.x && y == rhs.y);
+		}
+
+		/**
+		 * @brief Overloaded inequality operator.
+		 * @param rhs The point to compare to.
+		 * @return True if the points are NOT equal.
+		 */
+		inline Boolean operator!=(const Point2x& rhs) const {
+			return (x != rhs.x || y != rhs.y);
+		}
+
+		/**
+		 * @brief Convert the point to a Point2f.
+		 * @return The point as a Point2f.
+		 */
+		inline Point2f toPoint2f() const {
+			return Point2f(FixedPoint::toReal(x), FixedPoint::toReal(y));
+		}
+
+		/**
+		 * @brief Convert an array of Point2x to Point2f.
+		 * @param src The points to convert.
+		 * @param dst The array to store the Point2f in.
+		 * @param count The number of points.
+		 */
+		static inline void unpack(const Point2x* src, Point2f* dst, Size count) {
+			ConvertKernels::toReal(&src->x, &dst->x, count*2);
+		}
+
+		/**
+		 * @brief Convert an array of Point2f to Point2x.
+		 * @param src The points to convert.
+		 * @param dst The array to store the Point2x in.
+		 * @param count The number of points.
+		 */
+		static inline void pack(const Point2f* src, Point2x* dst, Size count) {
+			ConvertKernels::fromReal(&src->x, &dst->x, count*2);
+		}
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_POINT2X_H
@@ -0,0 +1,203 @@
+#ifndef CAT_CORE_GEOMETRY_RECTARRAY_H
+#define CAT_CORE_GEOMETRY_RECTARRAY_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file rectarray.h
+ * @brief An array of rectangles stored as columns, for bulk tests.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include <cstring>
+#include "core/geometry/rectkernels.h"
+
+namespace Cat {
+
+	/**
+	 * @class RectArray rectarray.h "core/geometry/rectarray.h"
+	 * @brief An array of rectangles stored as columns, for bulk tests.
+	 *
+	 * The x, y, width and height of the rectangles are each stored in
+	 * their own array (a structure of arrays), so testing or changing
+	 * every rectangle is a few passes of the RectKernels over the columns,
+	 * instead of a branchy loop over Rect objects.  The tests give the
+	 * same answers as the Rect methods they are named after, and write a
+	 * bitmask of RectKernels::maskWords(size()) words, one bit per rectangle.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	template<typename T>
+	class RectArray {
+	  public:
+		/**
+		 * @brief Create an empty array.
+		 */
+		inline RectArray()
+			: m_pData(NIL), m_size(0), m_capacity(0) {}
+
+		/**
+		 * @brief Create an empty array with room for a number of rectangles.
+		 * @param capacity The initial capacity of the array.
+		 */
+		explicit inline RectArray(Size capacity)
+			: m_pData(NIL), m_size(0), m_capacity(0) {
+			reserve(capacity);
+		}
+
+		/**
+		 * @brief Free the columns of the array.
+		 */
+		inline ~RectArray() {
+			delete[] m_pData;
+		}
+
+		/**
+		 * @brief Append a rectangle onto the end of the array.
+		 * @param rect The rectangle to append.
+		 */
+		inline void append(const Rect<T>& rect) {
+			if (m_size == m_capacity) {
+				reserve(m_capacity ? m_capacity*2 : 16);
+			}
+			set(m_size++, rect);
+		}
+
+		/**
+		 * @brief Gets the capacity of the array.
+		 * @return The capacity of the array.
+		 */
+		inline Size capacity() const { return m_capacity; }
+
+		/**
+		 * @brief Remove all the rectangles from the array.
+		 */
+		inline void clear() { m_size = 0; }
+
+		/**
+		 * @brief Get the columns of the array, to read or write them directly.
+		 * @return The columns of the array.
+		 */
+		inline const RectSoA<T>& columns() const { return m_columns; }
+
+		/**
+		 * @brief Get a rectangle in the array.
+		 * @param idx The index of the rectangle.
+		 * @return A copy of the rectangle.
+		 */
+		inline Rect<T> get(Size idx) const {
+			D_CONDERR(idx >= m_size, "Accessing RectArray element "
+						 << idx << " outside range [0.." << m_size << "]!");
+			return Rect<T>(m_columns.x[idx], m_columns.y[idx], m_columns.w[idx], m_columns.h[idx]);
+		}
+
+		/**
+		 * @brief Set a rectangle in the array.
+		 * @param idx The index of the rectangle, less than the capacity.
+		 * @param rect The rectangle to set.
+		 */
+		inline void set(Size idx, const Rect<T>& rect) {
+			m_columns.x[idx] = rect.x();
+			m_columns.y[idx] = rect.y();
+			m_columns.w[idx] = rect.width();
+			m_columns.h[idx] = rect.height();
+		}
+
+		/**
+		 * @brief Reserve room for a number of rectangles.
+		 * @param capacity The number of rectangles to make room for.
+		 */
+		void reserve(Size capacity);
+
+		/**
+		 * @brief Get the number of rectangles in the array.
+		 * @return The number of rectangles.
+		 */
+		inline Size size() const { return m_size; }
+
+		/**
+		 * @brief Test which rectangles intersect a rectangle, see Rect::intersects().
+		 * @param rect The rectangle to test against.
+		 * @param mask The bitmask to write, of RectKernels::maskWords(size()) words.
+		 * @return The number of rectangles intersecting the rectangle.
+		 */
+		inline Size intersects(const Rect<T>& rect, U32* mask) const {
+			return RectKernels::intersects(m_columns, m_size, rect, mask);
+		}
+
+		/**
+		 * @brief Test which rectangles contain a point, see Rect::contains().
+		 * @param point The point to test.
+		 * @param mask The bitmask to write, of RectKernels::maskWords(size()) words.
+		 * @return The number of rectangles containing the point.
+		 */
+		inline Size contains(const Point2<T>& point, U32* mask) const {
+			return RectKernels::contains(m_columns, m_size, point.x, point.y, mask);
+		}
+
+		/**
+		 * @brief Get the union (bounding rectangle) of all the rectangles.
+		 * @return The union of the rectangles, or an empty rectangle if there are none.
+		 */
+		inline Rect<T> unionAll() const {
+			if (m_size == 0) {
+				return Rect<T>();
+			}
+			T ltrb[4];
+			RectKernels::unionAll(m_columns, m_size, ltrb);
+			return Rect<T>(ltrb[0], ltrb[1], ltrb[2] - ltrb[0], ltrb[1] - ltrb[3]);
+		}
+
+		/**
+		 * @brief Clip every rectangle to a rectangle, see Rect::intersect().
+		 * The rectangles that do not intersect it become empty.
+		 * @param rect The rectangle to clip to.
+		 */
+		inline void clip(const Rect<T>& rect) {
+			RectKernels::clip(m_columns, m_size, rect);
+		}
+
+		/**
+		 * @brief Move every rectangle by the same amount.
+		 * @param dx The amount to move in the x direction.
+		 * @param dy The amount to move in the y direction.
+		 */
+		inline void translate(T dx, T dy) {
+			RectKernels::translate(m_columns, m_size, dx, dy);
+		}
+
+	  private:
+		T*				m_pData;
+		RectSoA<T>	m_columns;
+		Size			m_size;
+		Size			m_capacity;
+
+		RectArray(const RectArray<T>&);
+		RectArray<T>& operator=(const RectArray<T>&);
+	};
+
+	template<typename T>
+	void RectArray<T>::reserve(Size capacity) {
+		if (capacity <= m_capacity) {
+			return;
+		}
+		/* The four columns share one block */
+		T* data = new T[capacity*4];
+		if (m_size) {
+			memcpy(data, m_columns.x, sizeof(T)*m_size);
+			memcpy(data + capacity, m_columns.y, sizeof(T)*m_size);
+			memcpy(data + capacity*2, m_columns.w, sizeof(T)*m_size);
+			memcpy(data + capacity*3, m_columns.h, sizeof(T)*m_size);
+		}
+		delete[] m_pData;
+		m_pData = data;
+		m_columns = RectSoA<T>(data, data + capacity, data + capacity*2, data + capacity*3);
+		m_capacity = capacity;
+	}
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_RECTARRAY_H
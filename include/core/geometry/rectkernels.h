@@ -0,0 +1,302 @@
+#ifndef CAT_CORE_GEOMETRY_RECTKERNELS_H
+#define CAT_CORE_GEOMETRY_RECTKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file rectkernels.h
+ * @brief The vectorised (SSE2 / AVX2) kernels for columns of rectangles.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/geometry/rect.h"
+
+namespace Cat {
+
+	/**
+	 * @brief A structure of arrays view of a list of rectangles.
+	 * The x and y columns are the top left corners, as in Rect.
+	 */
+	template<typename T>
+	struct RectSoA {
+		T* x;
+		T* y;
+		T* w;
+		T* h;
+
+		RectSoA() : x(NIL), y(NIL), w(NIL), h(NIL) {}
+		RectSoA(T* px, T* py, T* pw, T* ph) : x(px), y(py), w(pw), h(ph) {}
+	};
+
+	/**
+	 * @class RectKernels rectkernels.h "core/geometry/rectkernels.h"
+	 * @brief The vectorised (SSE2 / AVX2) kernels for columns of rectangles.
+	 *
+	 * The kernels work on the x, y, width and height columns of a
+	 * RectArray, and give the same results as calling the Rect methods on
+	 * each rectangle, without any branches.  The tests write a bitmask
+	 * with one bit per rectangle (bit i % 32 of word i / 32).
+	 *
+	 * For floating point rectangles, the kernels work on 4 (SSE2) or 8
+	 * (AVX2) rectangles at a time, with the best table for the running
+	 * CPU selected once, on first use, like the MathKernels.  Other
+	 * coordinate types use the scalar loops, which the compiler is free
+	 * to vectorise.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class RectKernels {
+	  public:
+		struct Table {
+			/**
+			 * @brief Test which rectangles intersect a rectangle, like Rect::intersects().
+			 */
+			Size (*intersects)(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect,
+									 U32* mask);
+
+			/**
+			 * @brief Test which rectangles contain a point, like Rect::contains().
+			 */
+			Size (*contains)(const RectSoA<F32>& rects, Size count, F32 x, F32 y, U32* mask);
+
+			/**
+			 * @brief Get the left, top, right and bottom of the union of the rectangles.
+			 */
+			void (*unionAll)(const RectSoA<F32>& rects, Size count, F32* ltrb);
+
+			/**
+			 * @brief Clip each rectangle to a rectangle, like Rect::intersect().
+			 */
+			void (*clip)(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect);
+
+			/**
+			 * @brief Move each rectangle by the same amount.
+			 */
+			void (*translate)(const RectSoA<F32>& rects, Size count, F32 dx, F32 dy);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+		/**
+		 * @brief Get the number of words in a bitmask for a number of rectangles.
+		 * @param count The number of rectangles.
+		 * @return The number of U32 words needed.
+		 */
+		static inline Size maskWords(Size count) {
+			return (count + 31) >> 5;
+		}
+
+		/**
+		 * @brief Test to see if the bit for a rectangle is set in a bitmask.
+		 * @param mask The bitmask.
+		 * @param idx The index of the rectangle.
+		 * @return True if the bit is set.
+		 */
+		static inline Boolean isSet(const U32* mask, Size idx) {
+			return ((mask[idx >> 5] >> (idx & 31)) & 1) != 0;
+		}
+
+		/**
+		 * @brief Test which rectangles intersect a rectangle.
+		 * @param rects The columns of the rectangles.
+		 * @param count The number of rectangles.
+		 * @param rect The rectangle to test against.
+		 * @param mask The bitmask to write, of maskWords(count) words.
+		 * @return The number of rectangles intersecting the rectangle.
+		 */
+		template<typename T>
+		static Size intersects(const RectSoA<T>& rects, Size count, const Rect<T>& rect,
+									  U32* mask);
+
+		static inline Size intersects(const RectSoA<F32>& rects, Size count,
+												const Rect<F32>& rect, U32* mask) {
+			return table().intersects(rects, count, rect, mask);
+		}
+
+		/**
+		 * @brief Test which rectangles contain a point.
+		 * @param rects The columns of the rectangles.
+		 * @param count The number of rectangles.
+		 * @param x The x-coordinate of the point.
+		 * @param y The y-coordinate of the point.
+		 * @param mask The bitmask to write, of maskWords(count) words.
+		 * @return The number of rectangles containing the point.
+		 */
+		template<typename T>
+		static Size contains(const RectSoA<T>& rects, Size count, T x, T y, U32* mask);
+
+		static inline Size contains(const RectSoA<F32>& rects, Size count, F32 x, F32 y,
+											 U32* mask) {
+			return table().contains(rects, count, x, y, mask);
+		}
+
+		/**
+		 * @brief Get the union (bounding rectangle) of the rectangles.
+		 * @param rects The columns of the rectangles.
+		 * @param count The number of rectangles, at least one.
+		 * @param ltrb The array to store the left, top, right and bottom in.
+		 */
+		template<typename T>
+		static void unionAll(const RectSoA<T>& rects, Size count, T* ltrb);
+
+		static inline void unionAll(const RectSoA<F32>& rects, Size count, F32* ltrb) {
+			table().unionAll(rects, count, ltrb);
+		}
+
+		/**
+		 * @brief Clip each rectangle to a rectangle, the rectangles that do
+		 * not intersect it become empty rectangles at (0, 0).
+		 * @param rects The columns of the rectangles.
+		 * @param count The number of rectangles.
+		 * @param rect The rectangle to clip to.
+		 */
+		template<typename T>
+		static void clip(const RectSoA<T>& rects, Size count, const Rect<T>& rect);
+
+		static inline void clip(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect) {
+			table().clip(rects, count, rect);
+		}
+
+		/**
+		 * @brief Move each rectangle by the same amount.
+		 * @param rects The columns of the rectangles.
+		 * @param count The number of rectangles.
+		 * @param dx The amount to move in the x direction.
+		 * @param dy The amount to move in the y direction.
+		 */
+		template<typename T>
+		static void translate(const RectSoA<T>& rects, Size count, T dx, T dy);
+
+		static inline void translate(const RectSoA<F32>& rects, Size count, F32 dx, F32 dy) {
+			table().translate(rects, count, dx, dy);
+		}
+
+	  private:
+		static const Table* selectTable();
+	};
+
+	template<typename T>
+	Size RectKernels::intersects(const RectSoA<T>& rects, Size count, const Rect<T>& rect,
+										  U32* mask) {
+		T left = rect.left();
+		T top = rect.top();
+		T right = rect.right();
+		T bottom = rect.bottom();
+		Size found = 0;
+		for (Size w = 0; w < maskWords(count); ++w) {
+			mask[w] = 0;
+		}
+		for (Size i = 0; i < count; ++i) {
+			/* The same tests, in the same order, as Rect::intersects() */
+			U32 hit = (left < (T)(rects.x[i] + rects.w[i])) &
+				(top > (T)(rects.y[i] - rects.h[i])) &
+				(right > rects.x[i]) &
+				(bottom < rects.y[i]);
+			mask[i >> 5] |= hit << (i & 31);
+			found += hit;
+		}
+		return found;
+	}
+
+	template<typename T>
+	Size RectKernels::contains(const RectSoA<T>& rects, Size count, T x, T y, U32* mask) {
+		Size found = 0;
+		for (Size w = 0; w < maskWords(count); ++w) {
+			mask[w] = 0;
+		}
+		for (Size i = 0; i < count; ++i) {
+			U32 hit = (x > rects.x[i]) &
+				(x < (T)(rects.x[i] + rects.w[i])) &
+				(y < rects.y[i]) &
+				(y > (T)(rects.y[i] - rects.h[i]));
+			mask[i >> 5] |= hit << (i & 31);
+			found += hit;
+		}
+		return found;
+	}
+
+	template<typename T>
+	void RectKernels::unionAll(const RectSoA<T>& rects, Size count, T* ltrb) {
+		T left = rects.x[0];
+		T top = rects.y[0];
+		T right = (T)(rects.x[0] + rects.w[0]);
+		T bottom = (T)(rects.y[0] - rects.h[0]);
+		for (Size i = 1; i < count; ++i) {
+			T r = (T)(rects.x[i] + rects.w[i]);
+			T b = (T)(rects.y[i] - rects.h[i]);
+			left = rects.x[i] < left ? rects.x[i] : left;
+			top = rects.y[i] > top ? rects.y[i] : top;
+			right = r > right ? r : right;
+			bottom = b < bottom ? b : bottom;
+		}
+		ltrb[0] = left;
+		ltrb[1] = top;
+		ltrb[2] = right;
+		ltrb[3] = bottom;
+	}
+
+	template<typename T>
+	void RectKernels::clip(const RectSoA<T>& rects, Size count, const Rect<T>& rect) {
+		T left = rect.left();
+		T top = rect.top();
+		T right = rect.right();
+		T bottom = rect.bottom();
+		for (Size i = 0; i < count; ++i) {
+			T x = rects.x[i];
+			T y = rects.y[i];
+			T r = (T)(x + rects.w[i]);
+			T b = (T)(y - rects.h[i]);
+			Boolean hit = left < r && top > b && right > x && bottom < y;
+			T cl = left > x ? left : x;
+			T ct = top < y ? top : y;
+			T cr = right < r ? right : r;
+			T cb = bottom > b ? bottom : b;
+			rects.x[i] = hit ? cl : 0;
+			rects.y[i] = hit ? ct : 0;
+			rects.w[i] = hit ? (T)(cr - cl) : 0;
+			rects.h[i] = hit ? (T)(ct - cb) : 0;
+		}
+	}
+
+	template<typename T>
+	void RectKernels::translate(const RectSoA<T>& rects, Size count, T dx, T dy) {
+		for (Size i = 0; i < count; ++i) {
+			rects.x[i] += dx;
+			rects.y[i] += dy;
+		}
+	}
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_RECTKERNELS_H
@@ -0,0 +1,100 @@
+#ifndef CAT_CORE_GEOMETRY_RECTX_H
+#define CAT_CORE_GEOMETRY_RECTX_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file rectx.h
+ * @brief A rectangle stored as 16.16 fixed point values.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/geometry/rectf.h"
+#include "core/geometry/point2x.h"
+
+namespace Cat {
+
+	/**
+	 * @class Rectx rectx.h "core/geometry/rectx.h"
+	 * @brief A rectangle stored as 16.16 fixed point values.
+	 *
+	 * The components are stored in the same order as a Rectf (the x and
+	 * y of the top left corner, then the width and the height), so arrays
+	 * of them are converted to Rectf with unpack(), and back with pack(),
+	 * as one run of values through the ConvertKernels.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Rectx {
+	  public:
+		Fixed x, y, width, height;
+
+		/**
+		 * @brief Create an empty rectangle.
+		 */
+		inline Rectx()
+			: x(0), y(0), width(0), height(0) {}
+
+		/**
+		 * @brief Create a rectangle from the nearest fixed point values to a Rectf.
+		 * @param rect The rectangle to convert.
+		 */
+		inline explicit Rectx(const Rectf& rect)
+			: x(FixedPoint::fromReal(rect.x())), y(FixedPoint::fromReal(rect.y())),
+			  width(FixedPoint::fromReal(rect.width())),
+			  height(FixedPoint::fromReal(rect.height())) {}
+
+		/**
+		 * @brief Overloaded equality operator
+		 * @param rhs The rectangle to compare to.
+		 * @return True if the rectangles are equal in size and position.
+		 */
+		inline Boolean operator==(const Rectx& rhs) const {
+			return (x == rhs.x && y == rhs.y && width == rhs.width && height == rhs.height);
+		}
+
+		/**
+		 * @brief Overloaded inequality operator.
+		 * @param rhs The rectangle to compare to.
+		 * @return True if the rectangles are NOT equal.
+		 */
+		inline Boolean operator!=(const Rectx& rhs) const {
+			return !(*this == rhs);
+		}
+
+		/**
+		 * @brief Convert the rectangle to a Rectf.
+		 * @return The rectangle as a Rectf.
+		 */
+		inline Rectf toRectf() const {
+			return Rectf(FixedPoint::toReal(x), FixedPoint::toReal(y),
+							 FixedPoint::toReal(width), FixedPoint::toReal(height));
+		}
+
+		/**
+		 * @brief Convert an array of Rectx to Rectf.
+		 * @param src The rectangles to convert.
+		 * @param dst The array to store the Rectf in.
+		 * @param count The number of rectangles.
+		 */
+		static inline void unpack(const Rectx* src, Rectf* dst, Size count) {
+			ConvertKernels::toReal(&src->x, (Real*)dst, count*4);
+		}
+
+		/**
+		 * @brief Convert an array of Rectf to Rectx.
+		 * @param src The rectangles to convert.
+		 * @param dst The array to store the Rectx in.
+		 * @param count The number of rectangles.
+		 */
+		static inline void pack(const Rectf* src, Rectx* dst, Size count) {
+			ConvertKernels::fromReal((const Real*)src, &dst->x, count*4);
+		}
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_RECTX_H
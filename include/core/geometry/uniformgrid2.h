@@ -0,0 +1,405 @@
+#ifndef CAT_CORE_GEOMETRY_UNIFORMGRID2_H
+#define CAT_CORE_GEOMETRY_UNIFORMGRID2_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file uniformgrid2.h
+ * @brief A uniform grid of cells to find overlapping rectangles.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include <cmath>
+#include "core/geometry/aabbtree2.h"
+#include "core/geometry/rect.h"
+#include "core/util/vector.h"
+
+namespace Cat {
+
+	/**
+	 * @class UniformGrid2 uniformgrid2.h "core/geometry/uniformgrid2.h"
+	 * @brief A uniform grid of cells to find overlapping rectangles.
+	 *
+	 * The alternative to the AabbTree2 when the rectangles are spread
+	 * over a known area and are mostly about the same size: each
+	 * rectangle is listed in every cell it touches, so inserting, moving
+	 * and querying only look at the cells under the rectangle.  Anything
+	 * outside the area of the grid is kept in the cells along the edge.
+	 *
+	 * The queries take the same arguments, and give the same results, as
+	 * those of the AabbTree2, so the two can be swapped.  The queries do
+	 * not change the grid, so any number of threads can query it at once
+	 * as long as nothing is inserting, moving or removing.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	template<typename T>
+	class UniformGrid2 {
+	  public:
+		static const I32 kNull = -1;
+
+		typedef typename AabbTree2<T>::Pair Pair;
+
+		/**
+		 * @brief Create an empty grid.
+		 * @param area The area covered by the grid.
+		 * @param cellSize The width and height of each cell.
+		 */
+		UniformGrid2(const Rect<T>& area, T cellSize);
+
+		/**
+		 * @brief Free the cells of the grid.
+		 */
+		~UniformGrid2();
+
+		/**
+		 * @brief Add a rectangle to the grid.
+		 * @param rect The rectangle to add.
+		 * @param data Optional user data to keep with the rectangle.
+		 * @return The proxy of the rectangle in the grid.
+		 */
+		I32 insert(const Rect<T>& rect, VPtr data = NIL);
+
+		/**
+		 * @brief Remove a rectangle from the grid.
+		 * @param proxy The proxy returned by insert().
+		 */
+		void remove(I32 proxy);
+
+		/**
+		 * @brief Move or resize a rectangle in the grid.
+		 * @param proxy The proxy returned by insert().
+		 * @param rect The new rectangle.
+		 * @return True if the rectangle moved to different cells.
+		 */
+		Boolean update(I32 proxy, const Rect<T>& rect);
+
+		/**
+		 * @brief Get the number of rectangles in the grid.
+		 * @return The number of rectangles in the grid.
+		 */
+		inline Size size() const { return m_numProxies; }
+
+		/**
+		 * @brief Get the number of columns of cells.
+		 * @return The number of columns.
+		 */
+		inline I32 columns() const { return m_columns; }
+
+		/**
+		 * @brief Get the number of rows of cells.
+		 * @return The number of rows.
+		 */
+		inline I32 rows() const { return m_rows; }
+
+		/**
+		 * @brief Get the user data of a rectangle.
+		 * @param proxy The proxy returned by insert().
+		 * @return The user data passed to insert().
+		 */
+		inline VPtr getData(I32 proxy) const { return m_pItems[proxy].data; }
+
+		/**
+		 * @brief Get a rectangle in the grid.
+		 * @param proxy The proxy returned by insert().
+		 * @return The rectangle, as passed to insert() or update().
+		 */
+		inline Rect<T> getRect(I32 proxy) const {
+			const Item& item = m_pItems[proxy];
+			return Rect<T>(item.minX, item.maxY, item.maxX - item.minX, item.maxY - item.minY);
+		}
+
+		/**
+		 * @brief Find the rectangles that overlap or touch a region.
+		 * @param region The region to look in.
+		 * @param results The vector to append the proxies found to.
+		 * @return The number of proxies found.
+		 */
+		Size query(const Rect<T>& region, Vector<I32>& results) const;
+
+		/**
+		 * @brief Find the rectangles that contain a point, or have it on an edge.
+		 * @param point The point to look for.
+		 * @param results The vector to append the proxies found to.
+		 * @return The number of proxies found.
+		 */
+		inline Size query(const Point2<T>& point, Vector<I32>& results) const {
+			return query(Rect<T>(point.x, point.y, 0, 0), results);
+		}
+
+		/**
+		 * @brief Find every pair of rectangles that overlap or touch.
+		 * @param pairs The vector to append the pairs found to.
+		 * @return The number of pairs found.
+		 */
+		Size queryPairs(Vector<Pair>& pairs) const;
+
+	  private:
+		struct Item {
+			T		minX, minY, maxX, maxY;
+			VPtr	data;
+			I32	cellX0, cellY0, cellX1, cellY1;	/* The range of cells, -1 when free */
+			I32	nextFree;
+		};
+
+		struct Entry {
+			I32 item;
+			I32 next;
+		};
+
+		Item*		m_pItems;
+		Entry*	m_pEntries;
+		I32*		m_pCells;
+		I32		m_itemCapacity;
+		I32		m_entryCapacity;
+		I32		m_freeItems;
+		I32		m_freeEntries;
+		Size		m_numProxies;
+		I32		m_columns;
+		I32		m_rows;
+		T			m_originX;
+		T			m_originY;
+		T			m_cellSize;
+
+		inline I32 cellX(T x) const {
+			I32 c = (I32)::floor(((F64)x - (F64)m_originX) / (F64)m_cellSize);
+			return c < 0 ? 0 : (c >= m_columns ? m_columns - 1 : c);
+		}
+
+		inline I32 cellY(T y) const {
+			I32 c = (I32)::floor(((F64)y - (F64)m_originY) / (F64)m_cellSize);
+			return c < 0 ? 0 : (c >= m_rows ? m_rows - 1 : c);
+		}
+
+		static inline Boolean overlaps(const Item& item, T minX, T minY, T maxX, T maxY) {
+			return item.minX <= maxX && minX <= item.maxX &&
+				item.minY <= maxY && minY <= item.maxY;
+		}
+
+		void setBounds(Item& item, const Rect<T>& rect);
+		void link(I32 proxy);
+		void unlink(I32 proxy);
+
+		UniformGrid2(const UniformGrid2<T>&);
+		UniformGrid2<T>& operator=(const UniformGrid2<T>&);
+	};
+
+	template<typename T>
+	UniformGrid2<T>::UniformGrid2(const Rect<T>& area, T cellSize)
+		: m_pItems(NIL), m_pEntries(NIL), m_pCells(NIL), m_itemCapacity(0),
+		  m_entryCapacity(0), m_freeItems(kNull), m_freeEntries(kNull), m_numProxies(0),
+		  m_originX(area.left()), m_originY(area.bottom()), m_cellSize(cellSize) {
+		if (cellSize <= 0) {
+			DWARN("UniformGrid2 cell size must be positive: " << cellSize << "!");
+			m_cellSize = cellSize = 1;
+		}
+		m_columns = (I32)::ceil((F64)area.width() / (F64)cellSize);
+		m_rows = (I32)::ceil((F64)area.height() / (F64)cellSize);
+		m_columns = m_columns < 1 ? 1 : m_columns;
+		m_rows = m_rows < 1 ? 1 : m_rows;
+		m_pCells = new I32[m_columns*m_rows];
+		for (I32 i = 0; i < m_columns*m_rows; ++i) {
+			m_pCells[i] = kNull;
+		}
+	}
+
+	template<typename T>
+	UniformGrid2<T>::~UniformGrid2() {
+		delete[] m_pItems;
+		delete[] m_pEntries;
+		delete[] m_pCells;
+	}
+
+	template<typename T>
+	void UniformGrid2<T>::setBounds(Item& item, const Rect<T>& rect) {
+		item.minX = rect.left() < rect.right() ? rect.left() : rect.right();
+		item.maxX = rect.left() < rect.right() ? rect.right() : rect.left();
+		item.minY = rect.bottom() < rect.top() ? rect.bottom() : rect.top();
+		item.maxY = rect.bottom() < rect.top() ? rect.top() : rect.bottom();
+	}
+
+	template<typename T>
+	I32 UniformGrid2<T>::insert(const Rect<T>& rect, VPtr data) {
+		if (m_freeItems == kNull) {
+			I32 capacity = m_itemCapacity ? m_itemCapacity*2 : 16;
+			Item* items = new Item[capacity];
+			if (m_pItems) {
+				memcpy(items, m_pItems, sizeof(Item)*m_itemCapacity);
+				delete[] m_pItems;
+			}
+			m_pItems = items;
+			for (I32 i = m_itemCapacity; i < capacity; ++i) {
+				m_pItems[i].nextFree = (i + 1 < capacity) ? i + 1 : kNull;
+				m_pItems[i].cellX0 = kNull;
+			}
+			m_freeItems = m_itemCapacity;
+			m_itemCapacity = capacity;
+		}
+		I32 proxy = m_freeItems;
+		Item& item = m_pItems[proxy];
+		m_freeItems = item.nextFree;
+		setBounds(item, rect);
+		item.data = data;
+		item.cellX0 = cellX(item.minX);
+		item.cellY0 = cellY(item.minY);
+		item.cellX1 = cellX(item.maxX);
+		item.cellY1 = cellY(item.maxY);
+		link(proxy);
+		++m_numProxies;
+		return proxy;
+	}
+
+	template<typename T>
+	void UniformGrid2<T>::remove(I32 proxy) {
+		if (proxy < 0 || proxy >= m_itemCapacity || m_pItems[proxy].cellX0 == kNull) {
+			DWARN("Trying to remove an invalid proxy from a UniformGrid2: " << proxy << "!");
+			return;
+		}
+		unlink(proxy);
+		m_pItems[proxy].cellX0 = kNull;
+		m_pItems[proxy].nextFree = m_freeItems;
+		m_freeItems = proxy;
+		--m_numProxies;
+	}
+
+	template<typename T>
+	Boolean UniformGrid2<T>::update(I32 proxy, const Rect<T>& rect) {
+		Item& item = m_pItems[proxy];
+		setBounds(item, rect);
+		I32 x0 = cellX(item.minX), y0 = cellY(item.minY);
+		I32 x1 = cellX(item.maxX), y1 = cellY(item.maxY);
+		if (x0 == item.cellX0 && y0 == item.cellY0 && x1 == item.cellX1 && y1 == item.cellY1) {
+			return false;
+		}
+		unlink(proxy);
+		item.cellX0 = x0;
+		item.cellY0 = y0;
+		item.cellX1 = x1;
+		item.cellY1 = y1;
+		link(proxy);
+		return true;
+	}
+
+	template<typename T>
+	void UniformGrid2<T>::link(I32 proxy) {
+		const Item& item = m_pItems[proxy];
+		for (I32 y = item.cellY0; y <= item.cellY1; ++y) {
+			for (I32 x = item.cellX0; x <= item.cellX1; ++x) {
+				if (m_freeEntries == kNull) {
+					I32 capacity = m_entryCapacity ? m_entryCapacity*2 : 64;
+					Entry* entries = new Entry[capacity];
+					if (m_pEntries) {
+						memcpy(entries, m_pEntries, sizeof(Entry)*m_entryCapacity);
+						delete[] m_pEntries;
+					}
+					m_pEntries = entries;
+					for (I32 i = m_entryCapacity; i < capacity; ++i) {
+						m_pEntries[i].next = (i + 1 < capacity) ? i + 1 : kNull;
+					}
+					m_freeEntries = m_entryCapacity;
+					m_entryCapacity = capacity;
+				}
+				I32 entry = m_freeEntries;
+				m_freeEntries = m_pEntries[entry].next;
+				I32& head = m_pCells[y*m_columns + x];
+				m_pEntries[entry].item = proxy;
+				m_pEntries[entry].next = head;
+				head = entry;
+			}
+		}
+	}
+
+	template<typename T>
+	void UniformGrid2<T>::unlink(I32 proxy) {
+		const Item& item = m_pItems[proxy];
+		for (I32 y = item.cellY0; y <= item.cellY1; ++y) {
+			for (I32 x = item.cellX0; x <= item.cellX1; ++x) {
+				I32* link = &m_pCells[y*m_columns + x];
+				while (*link != kNull && m_pEntries[*link].item != proxy) {
+					link = &m_pEntries[*link].next;
+				}
+				if (*link != kNull) {
+					I32 entry = *link;
+					*link = m_pEntries[entry].next;
+					m_pEntries[entry].next = m_freeEntries;
+					m_freeEntries = entry;
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	Size UniformGrid2<T>::query(const Rect<T>& region, Vector<I32>& results) const {
+		if (!m_numProxies) {
+			return 0;
+		}
+		if (results.capacity() == 0) {
+			results.reserve(16);
+		}
+		T minX = region.left() < region.right() ? region.left() : region.right();
+		T maxX = region.left() < region.right() ? region.right() : region.left();
+		T minY = region.bottom() < region.top() ? region.bottom() : region.top();
+		T maxY = region.bottom() < region.top() ? region.top() : region.bottom();
+		I32 x0 = cellX(minX), y0 = cellY(minY), x1 = cellX(maxX), y1 = cellY(maxY);
+
+		Size found = 0;
+		for (I32 y = y0; y <= y1; ++y) {
+			for (I32 x = x0; x <= x1; ++x) {
+				for (I32 e = m_pCells[y*m_columns + x]; e != kNull; e = m_pEntries[e].next) {
+					const Item& item = m_pItems[m_pEntries[e].item];
+					/* A rectangle over several cells is listed in each of
+					 * them, it is only reported from the first one the
+					 * query looks at */
+					I32 firstX = item.cellX0 > x0 ? item.cellX0 : x0;
+					I32 firstY = item.cellY0 > y0 ? item.cellY0 : y0;
+					if (firstX == x && firstY == y &&
+						 overlaps(item, minX, minY, maxX, maxY)) {
+						results.append(m_pEntries[e].item);
+						++found;
+					}
+				}
+			}
+		}
+		return found;
+	}
+
+	template<typename T>
+	Size UniformGrid2<T>::queryPairs(Vector<Pair>& pairs) const {
+		if (pairs.capacity() == 0) {
+			pairs.reserve(16);
+		}
+		Size found = 0;
+		for (I32 y = 0; y < m_rows; ++y) {
+			for (I32 x = 0; x < m_columns; ++x) {
+				for (I32 e = m_pCells[y*m_columns + x]; e != kNull; e = m_pEntries[e].next) {
+					const Item& a = m_pItems[m_pEntries[e].item];
+					for (I32 f = m_pEntries[e].next; f != kNull; f = m_pEntries[f].next) {
+						const Item& b = m_pItems[m_pEntries[f].item];
+						/* Two rectangles can share many cells, the pair is
+						 * only reported from the first cell they share */
+						I32 firstX = a.cellX0 > b.cellX0 ? a.cellX0 : b.cellX0;
+						I32 firstY = a.cellY0 > b.cellY0 ? a.cellY0 : b.cellY0;
+						if (firstX != x || firstY != y ||
+							 !overlaps(a, b.minX, b.minY, b.maxX, b.maxY)) {
+							continue;
+						}
+						Pair p;
+						p.first = m_pEntries[e].item < m_pEntries[f].item ?
+							m_pEntries[e].item : m_pEntries[f].item;
+						p.second = m_pEntries[e].item < m_pEntries[f].item ?
+							m_pEntries[f].item : m_pEntries[e].item;
+						pairs.append(p);
+						++found;
+					}
+				}
+			}
+		}
+		return found;
+	}
+
+} // namespace Cat
+
+#endif // CAT_CORE_GEOMETRY_UNIFORMGRID2_H
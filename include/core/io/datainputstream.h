@@ -14,6 +14,8 @@
  */
 
 #include "core/io/inputstream.h"
+#include "core/string/unistring.h"
+#include "core/string/utf8.h"
 
 namespace Cat {
 
@@ -59,6 +61,25 @@ namespace Cat {
 		 * @return The number of bytes read.
 		 */
 		virtual Size readCStr(CStr string);		
+
+		/** 
+		 * @brief Read a length-prefixed UTF-8 string (as written by 
+		 * DataOutputStream::writeUTF8()) into a UniString.
+		 * @param string The UniString to decode the string into.
+		 * @return The number of bytes read.
+		 */
+		virtual Size readUTF8(UniString& string);
+
+		/** 
+		 * @brief Read and decode up to byteCount bytes of raw UTF-8 text.
+		 * The text is decoded through the decoder, so a sequence split across
+		 * two calls is still decoded correctly.
+		 * @param buffer The buffer to decode into, must hold byteCount + 1 U16s.
+		 * @param byteCount The max number of bytes to read from the stream.
+		 * @param decoder The decoder holding the state of the text being read.
+		 * @return The number of U16s decoded, or CAT_UTF_INVALID.
+		 */
+		Size readUTF8Text(U16* buffer, Size byteCount, Utf8Decoder& decoder);
 		
 		/** 
 		 * @brief Read 32 bit floating point values from the stream.
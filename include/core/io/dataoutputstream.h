@@ -14,6 +14,7 @@
  */
 
 #include "core/io/outputstream.h"
+#include "core/string/unistring.h"
 
 namespace Cat {
 
@@ -59,6 +60,13 @@ namespace Cat {
 		 * @return The number of bytes written.
 		 */
 		virtual Size writeCStr(const Char* string);		
+
+		/** 
+		 * @brief Write a UniString as a length-prefixed UTF-8 string.
+		 * @param string The UniString to encode and write.
+		 * @return The number of bytes written.
+		 */
+		virtual Size writeUTF8(const UniString& string);
 		
 		/** 
 		 * @brief Write one or more 32 bit floating point values to the stream.
@@ -18,6 +18,9 @@
 
 #include "core/string/stringutils.h"
 
+/* The size of the buffer used to hold the current working directory */
+#define CAT_MAX_CWD_LENGTH 256
+
 namespace Cat {
 
 	/**
@@ -71,6 +74,19 @@ namespace Cat {
 			setNameIndex();
 		}
 
+		/**
+		 * @brief Create a FilePath from views of a parent path and relative path.
+		 * @see FilePath(const Char*, const Char*)
+		 * @param parentPath The absolute or relative parent path (may be empty).
+		 * @param relativePath The path relative to the parent path.
+		 */
+		FilePath(const StringView& parentPath, const StringView& relativePath) {
+			m_pAbsolutePath = FilePath::createAbsolutePath(relativePath, parentPath);
+			m_pPath = relativePath.copy();
+			m_pParentPath = m_pCanonicalPath = NIL;
+			setNameIndex();
+		}
+
 		/**
 		 * @brief Copy constructor just copies all the string data.
 		 * @param src The FilePath to copy from.
@@ -128,6 +144,23 @@ namespace Cat {
 			else { return NIL; }
 		}
 
+		/**
+		 * @brief Get a view of the name portion of the file path.
+		 * @return The view of the name, which is empty if there is no path.
+		 */
+		inline StringView nameView() const { return StringView(name()); }
+
+		/**
+		 * @brief Get a view of the parent portion of the path, without copying it.
+		 * @return The view of the parent path, which is empty if there is no path.
+		 */
+		inline StringView parentPathView() const {
+			if (m_nameIdx >= 0) {
+				return StringView(m_pAbsolutePath, (Size)m_nameIdx);
+			}
+			else { return StringView(); }
+		}
+
 		/**
 		 * @brief Get the path that was specified to create this FilePath.
 		 * @return The path used to create this FilePath.
@@ -151,7 +184,17 @@ namespace Cat {
 		 * @param parentPath The absolute or relative parent path.
 		 * @param relativePath The path relative to the parent path.
 		 */
-		void set(const Char* parentPath, const Char* relativePath);
+		inline void set(const Char* parentPath, const Char* relativePath) {
+			set(StringView(parentPath), StringView(relativePath));
+		}
+
+		/**
+		 * @brief Set a FilePath from views of a parent path and relative path.
+		 * @see set(const Char*, const Char*)
+		 * @param parentPath The absolute or relative parent path (may be empty).
+		 * @param relativePath The path relative to the parent path.
+		 */
+		void set(const StringView& parentPath, const StringView& relativePath);
 
 		/**
 		 * @brief Set the FilePath from the passed in path.
@@ -170,26 +213,48 @@ namespace Cat {
 		 * @param parentPath The (optional) absolute or relative parent path.
 		 * @return An absolute path string.
 		 */
-		static Char* createAbsolutePath(const Char* path, const Char* parentPath);
+		static inline Char* createAbsolutePath(const Char* path, const Char* parentPath) {
+			return createAbsolutePath(StringView(path), StringView(parentPath));
+		}
+
+		/**
+		 * @brief Get an absolute path string from views of a possibly relative path.
+		 * Only the returned string is allocated.
+		 * @param path The absolute or relative end of the path.
+		 * @param parentPath The absolute or relative parent path (may be empty).
+		 * @return An absolute path string.
+		 */
+		static Char* createAbsolutePath(const StringView& path, const StringView& parentPath);
 
 		/**
 		 * @brief Get the current working directory.
 		 * @return The current working directory path.
 		 */
 		static inline Char* getCwd() {
-			Char* cwd = StringUtils::create(255);
-			IF_UNIX_OR_APPLE(getcwd(cwd, 256));
+			Char* cwd = StringUtils::create(CAT_MAX_CWD_LENGTH - 1);
+			getCwd(cwd);
 			return cwd;
 		}		
 
+		/**
+		 * @brief Get the current working directory into a buffer.
+		 * @param buffer The buffer, which must hold CAT_MAX_CWD_LENGTH characters.
+		 * @return The view of the path in the buffer.
+		 */
+		static inline StringView getCwd(Char* buffer) {
+			buffer[0] = '\0';
+			IF_UNIX_OR_APPLE(getcwd(buffer, CAT_MAX_CWD_LENGTH));
+			return StringView(buffer);
+		}		
+
 		/**
 		 * @brief Test to see if a path is absolute or relative.
 		 * @param path The path string to test for absoluteness.
 		 * @return True if the path is absolute.
 		 */
-		inline static Boolean isAbsolutePath(const Char* path) {
-			return ((path != NIL) &&
-					  StringUtils::find(path, FilePath::rootDirName()) == path);	
+		inline static Boolean isAbsolutePath(const StringView& path) {
+			return path.startsWith(StringView(FilePath::rootDirName(),
+														 FilePath::rootDirNameLength()));
 		}
 
 		/**
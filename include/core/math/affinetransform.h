@@ -0,0 +1,206 @@
+#ifndef CAT_CORE_MATH_AFFINETRANSFORM_H
+#define CAT_CORE_MATH_AFFINETRANSFORM_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file affinetransform.h
+ * @brief A 3x4 affine transformation, a linear 3x3 part and a translation.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/mat3.h"
+#include "core/math/mat4.h"
+#include "core/math/quaternion.h"
+
+namespace Cat {
+
+	/**
+	 * @class AffineTransform affinetransform.h "core/math/affinetransform.h"
+	 * @brief A 3x4 affine transformation, a linear 3x3 part and a translation.
+	 *
+	 * The transformation is the same as a Mat4 with a bottom row of
+	 * (0, 0, 0, 1), which is what every rotation, scale and translation
+	 * matrix is, but without storing or computing that row.  Composing
+	 * two transforms is 36 multiplies instead of 64, a point is 9
+	 * multiplies, and the inverse only needs the 3x3 inverse (or just its
+	 * transpose with inverseRigid(), for a rotation and translation).
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class AffineTransform {
+	  public:
+		static const AffineTransform kIdentity;
+
+		/**
+		 * @brief Create a new uninitialised transform.
+		 */
+		inline AffineTransform() {}
+
+		/**
+		 * @brief Create a transform from a linear part and a translation.
+		 * @param linear The rotation and scale part of the transform.
+		 * @param translation The translation of the transform.
+		 */
+		inline AffineTransform(const Mat3& linear, const Vec3& translation)
+			: m_linear(linear), m_translation(translation) {}
+
+		/**
+		 * @brief Create a transform from a rotation and a translation.
+		 * @param rotation The (unit length) rotation.
+		 * @param translation The translation of the transform.
+		 */
+		inline AffineTransform(const Quaternion& rotation, const Vec3& translation)
+			: m_translation(translation) {
+			rotation.toMatrix(m_linear);
+		}
+
+		/**
+		 * @brief Create a transform that scales, then rotates, then translates.
+		 * @param translation The translation of the transform.
+		 * @param rotation The (unit length) rotation.
+		 * @param scale The scale along each axis.
+		 */
+		AffineTransform(const Vec3& translation, const Quaternion& rotation,
+							 const Vec3& scale);
+
+		/**
+		 * @brief Create a transform from the top three rows of a matrix.
+		 * @param mat The matrix, assumed to be affine (see Mat4::isAffine()).
+		 */
+		explicit AffineTransform(const Mat4& mat);
+
+		/**
+		 * @brief Check for equality.
+		 * @param rhs The transform to compare with.
+		 * @return True if the transforms are equal.
+		 */
+		inline Boolean operator==(const AffineTransform& rhs) const {
+			return m_linear == rhs.m_linear && m_translation == rhs.m_translation;
+		}
+
+		/**
+		 * @brief Check for inequality.
+		 * @param rhs The transform to compare with.
+		 * @return True if the transforms are not equal.
+		 */
+		inline Boolean operator!=(const AffineTransform& rhs) const {
+			return !operator==(rhs);
+		}
+
+		/**
+		 * @brief Check for approximate equality.
+		 * @param rhs The transform to compare with.
+		 * @return True if the transforms are approximately equal.
+		 */
+		inline Boolean approx(const AffineTransform& rhs) const {
+			return m_linear.approx(rhs.m_linear) && Math::approx(m_translation, rhs.m_translation);
+		}
+
+		/**
+		 * @brief Compose two transforms, the rhs is applied first.
+		 * @param rhs The transform to apply before this one.
+		 * @return The composed transform.
+		 */
+		inline AffineTransform operator*(const AffineTransform& rhs) const {
+			return AffineTransform(m_linear * rhs.m_linear,
+										  (m_linear * rhs.m_translation) + m_translation);
+		}
+
+		/**
+		 * @brief Compose this transform with another, the rhs is applied first.
+		 * @param rhs The transform to apply before this one.
+		 * @return A reference to this transform.
+		 */
+		inline AffineTransform& operator*=(const AffineTransform& rhs) {
+			m_translation = (m_linear * rhs.m_translation) + m_translation;
+			m_linear = m_linear * rhs.m_linear;
+			return *this;
+		}
+
+		/**
+		 * @brief Transform a point.
+		 * @param rhs The point to transform.
+		 * @return The transformed point.
+		 */
+		inline Vec3 operator*(const Vec3& rhs) const {
+			return (m_linear * rhs) + m_translation;
+		}
+
+		/**
+		 * @brief Transform a direction, without the translation.
+		 * @param v The direction to transform.
+		 * @return The transformed direction.
+		 */
+		inline Vec3 rotate(const Vec3& v) const {
+			return m_linear * v;
+		}
+
+		/**
+		 * @brief Get the determinant of the transform (of the linear part).
+		 * @return The determinant.
+		 */
+		inline Real determinant() const { return m_linear.determinant(); }
+
+		/**
+		 * @brief Get the inverse of the transform.
+		 * @return The inverse, or a copy if the transform is not invertible.
+		 */
+		AffineTransform inverse() const;
+
+		/**
+		 * @brief Get the inverse of a rotation and translation, by
+		 * transposing the rotation and rotating back the translation.
+		 * Only valid if the linear part is orthonormal (no scale).
+		 * @return The inverse of the transform.
+		 */
+		inline AffineTransform inverseRigid() const {
+			Mat3 rotation = m_linear.transposed();
+			return AffineTransform(rotation, -(rotation * m_translation));
+		}
+
+		/**
+		 * @brief Get the linear (rotation and scale) part of the transform.
+		 * @return The linear part of the transform.
+		 */
+		inline const Mat3& linear() const { return m_linear; }
+
+		/**
+		 * @brief Set the linear (rotation and scale) part of the transform.
+		 * @param linear The new linear part.
+		 */
+		inline void setLinear(const Mat3& linear) { m_linear = linear; }
+
+		/**
+		 * @brief Get the translation of the transform.
+		 * @return The translation of the transform.
+		 */
+		inline const Vec3& translation() const { return m_translation; }
+
+		/**
+		 * @brief Set the translation of the transform.
+		 * @param translation The new translation.
+		 */
+		inline void setTranslation(const Vec3& translation) { m_translation = translation; }
+
+		/**
+		 * @brief Get the transform as a 4x4 matrix.
+		 * @return The matrix, with a bottom row of (0, 0, 0, 1).
+		 */
+		Mat4 toMat4() const;
+
+	  private:
+		Mat3 m_linear;
+		Vec3 m_translation;
+	};
+
+#ifdef DEBUG
+	std::ostream& operator<<(std::ostream& out, const AffineTransform& t);
+#endif //DEBUG
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_AFFINETRANSFORM_H
@@ -0,0 +1,135 @@
+#ifndef CAT_CORE_MATH_CONVERTKERNELS_H
+#define CAT_CORE_MATH_CONVERTKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file convertkernels.h
+ * @brief The vectorised (SSE2 / F16C) kernels to convert half floats and fixed point values.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/half.h"
+#include "core/math/fixed.h"
+
+namespace Cat {
+
+	/**
+	 * @class ConvertKernels convertkernels.h "core/math/convertkernels.h"
+	 * @brief The vectorised (SSE2 / F16C) kernels to convert half floats and fixed point values.
+	 *
+	 * The compact types (Vec3h, Color4h, Point2x, Rectx) store their
+	 * components as half floats or 16.16 fixed point values, at half the
+	 * memory of the Real types, and are converted in bulk by these kernels
+	 * when they are needed for computing.  As with the MathKernels, the
+	 * best table for the running CPU is selected once, on first use, and
+	 * every table rounds exactly like the scalar HalfFloat and FixedPoint
+	 * functions, so gives the same results bit for bit.  The source and
+	 * destination arrays must not overlap.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class ConvertKernels {
+	  public:
+		struct Table {
+			/**
+			 * @brief Convert half floats to Reals, see HalfFloat::toReal().
+			 */
+			void (*halfToReal)(const Half* src, Real* dst, Size count);
+
+			/**
+			 * @brief Convert Reals to half floats, see HalfFloat::fromReal().
+			 */
+			void (*realToHalf)(const Real* src, Half* dst, Size count);
+
+			/**
+			 * @brief Convert fixed point values to Reals, see FixedPoint::toReal().
+			 */
+			void (*fixedToReal)(const Fixed* src, Real* dst, Size count);
+
+			/**
+			 * @brief Convert Reals to fixed point values, see FixedPoint::fromReal().
+			 */
+			void (*realToFixed)(const Real* src, Fixed* dst, Size count);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+		/**
+		 * @brief Convert an array of half floats to Reals.
+		 * @param src The half floats to convert.
+		 * @param dst The array to store the Reals in.
+		 * @param count The number of values.
+		 */
+		static inline void toReal(const Half* src, Real* dst, Size count) {
+			table().halfToReal(src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of fixed point values to Reals.
+		 * @param src The fixed point values to convert.
+		 * @param dst The array to store the Reals in.
+		 * @param count The number of values.
+		 */
+		static inline void toReal(const Fixed* src, Real* dst, Size count) {
+			table().fixedToReal(src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of Reals to half floats.
+		 * @param src The Reals to convert.
+		 * @param dst The array to store the half floats in.
+		 * @param count The number of values.
+		 */
+		static inline void fromReal(const Real* src, Half* dst, Size count) {
+			table().realToHalf(src, dst, count);
+		}
+
+		/**
+		 * @brief Convert an array of Reals to fixed point values.
+		 * @param src The Reals to convert.
+		 * @param dst The array to store the fixed point values in.
+		 * @param count The number of values.
+		 */
+		static inline void fromReal(const Real* src, Fixed* dst, Size count) {
+			table().realToFixed(src, dst, count);
+		}
+
+	  private:
+		static const Table* selectTable();
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_CONVERTKERNELS_H
@@ -0,0 +1,98 @@
+#ifndef CAT_CORE_MATH_FIXED_H
+#define CAT_CORE_MATH_FIXED_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file fixed.h
+ * @brief A set of functions to manipulate 16.16 fixed point values stored in an I32.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include <cmath>
+#include "core/corelib.h"
+
+namespace Cat {
+
+	typedef I32 Fixed;
+
+	namespace FixedPoint {
+
+		/**
+		 * @brief The number of fractional bits.
+		 */
+		static const I32 kShift = 16;
+
+		/**
+		 * @brief The fixed point value one.
+		 */
+		static const Fixed kOne = 1 << kShift;
+
+		/**
+		 * @brief Create a fixed point value from an integer.
+		 * @param i The integer, between -32768 and 32767.
+		 * @return The fixed point value.
+		 */
+		inline Fixed fromInt(I32 i) {
+			return (Fixed)((U32)i << kShift);
+		}
+
+		/**
+		 * @brief Get the integer part of a fixed point value, rounded down.
+		 * @param f The fixed point value.
+		 * @return The largest integer not greater than the value.
+		 */
+		inline I32 toInt(Fixed f) {
+			return f >> kShift;
+		}
+
+		/**
+		 * @brief Convert a fixed point value to a Real.
+		 * @param f The fixed point value.
+		 * @return The value as a Real (rounded to the 24 bits of a float).
+		 */
+		inline Real toReal(Fixed f) {
+			return (F32)f * (REAL(1.0) / (F32)kOne);
+		}
+
+		/**
+		 * @brief Convert a Real to the nearest fixed point value, ties to even.
+		 * Values out of range saturate, and NaN gives the smallest value.
+		 * @param value The value to convert.
+		 * @return The nearest fixed point value.
+		 */
+		inline Fixed fromReal(Real value) {
+			/* Clamped the same way as the SIMD max and min, which give the
+			 * second argument for NaN, and to the largest float below 2^31 */
+			F32 v = value * (F32)kOne;
+			v = v > REAL(-2147483648.0) ? v : REAL(-2147483648.0);
+			v = v < REAL(2147483520.0) ? v : REAL(2147483520.0);
+			return (Fixed)lrintf(v);
+		}
+
+		/**
+		 * @brief Multiply two fixed point values, rounded down.
+		 * @param a The first value.
+		 * @param b The second value.
+		 * @return The product of the values.
+		 */
+		inline Fixed mul(Fixed a, Fixed b) {
+			return (Fixed)(((I64)a * (I64)b) >> kShift);
+		}
+
+		/**
+		 * @brief Divide two fixed point values, rounded towards zero.
+		 * @param a The dividend.
+		 * @param b The divisor, which must not be zero.
+		 * @return The quotient of the values.
+		 */
+		inline Fixed div(Fixed a, Fixed b) {
+			return (Fixed)(((I64)a * (I64)kOne) / (I64)b);
+		}
+
+	} // namespace FixedPoint
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_FIXED_H
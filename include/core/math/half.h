@@ -0,0 +1,103 @@
+#ifndef CAT_CORE_MATH_HALF_H
+#define CAT_CORE_MATH_HALF_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file half.h
+ * @brief A set of functions to convert IEEE half precision floats stored in a U16.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include <cstring>
+#include "core/corelib.h"
+
+namespace Cat {
+
+	typedef U16 Half;
+
+	namespace HalfFloat {
+
+		/**
+		 * @brief The largest finite half float value (65504).
+		 */
+		static const Half kMax = 0x7BFF;
+
+		/**
+		 * @brief The half float value one.
+		 */
+		static const Half kOne = 0x3C00;
+
+		/**
+		 * @brief Convert a half float to a Real, which is always exact.
+		 * NaNs keep their payload, and are made quiet, like the F16C instructions.
+		 * @param h The half float to convert.
+		 * @return The value of the half float.
+		 */
+		inline Real toReal(Half h) {
+			static const U32 kShiftedExp = 0x7C00 << 13;
+			U32 bits = (U32)(h & 0x7FFF) << 13;
+			U32 exp = bits & kShiftedExp;
+			bits += (127 - 15) << 23;
+			if (exp == kShiftedExp) {
+				/* Inf or NaN */
+				bits += (128 - 16) << 23;
+				if (bits & 0x007FFFFF) {
+					bits |= 0x00400000;
+				}
+			} else if (exp == 0) {
+				/* Zero or denormal, renormalised by the float subtraction */
+				F32 f, magic;
+				U32 magicBits = 113 << 23;
+				bits += 1 << 23;
+				memcpy(&f, &bits, sizeof(F32));
+				memcpy(&magic, &magicBits, sizeof(F32));
+				f -= magic;
+				memcpy(&bits, &f, sizeof(F32));
+			}
+			bits |= (U32)(h & 0x8000) << 16;
+			F32 result;
+			memcpy(&result, &bits, sizeof(F32));
+			return result;
+		}
+
+		/**
+		 * @brief Convert a Real to the nearest half float, ties to even.
+		 * Values too large for a half become infinity, NaNs keep the top of
+		 * their payload and are made quiet, like the F16C instructions.
+		 * @param value The value to convert.
+		 * @return The half float nearest the value.
+		 */
+		inline Half fromReal(Real value) {
+			U32 bits;
+			memcpy(&bits, &value, sizeof(F32));
+			U32 sign = bits & 0x80000000;
+			bits ^= sign;
+			U32 result;
+			if (bits >= (U32)(127 + 16) << 23) {
+				/* Out of range, Inf or NaN */
+				result = bits > 0x7F800000 ? 0x7E00 | ((bits >> 13) & 0x3FF) : 0x7C00;
+			} else if (bits < (U32)113 << 23) {
+				/* Zero or denormal, rounded by the float addition */
+				F32 f, magic;
+				U32 magicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+				memcpy(&f, &bits, sizeof(F32));
+				memcpy(&magic, &magicBits, sizeof(F32));
+				f += magic;
+				memcpy(&result, &f, sizeof(F32));
+				result -= magicBits;
+			} else {
+				U32 mantOdd = (bits >> 13) & 1;
+				bits += ((U32)(15 - 127) << 23) + 0xFFF;
+				bits += mantOdd;
+				result = bits >> 13;
+			}
+			return (Half)(result | (sign >> 16));
+		}
+
+	} // namespace HalfFloat
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_HALF_H
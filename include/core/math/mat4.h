@@ -20,11 +20,23 @@ namespace Cat {
 	 * @class Mat4 mat4.h "core/math/mat4.h"
 	 * @brief A class representing a 4x4 Matrix.
 	 *
+	 * When built with CAT_SIMD_MATH the matrix is 16-byte aligned and each
+	 * column is also stored as an __m128.  The products with matrices and
+	 * vectors then use SSE, with the same order of operations as the
+	 * scalar code (so give the same results), and transpose() and inverse()
+	 * use shuffles and 2x2 block cofactors.
+	 *
+	 * Most matrices are affine (rotation, scale and translation, with a
+	 * bottom row of 0, 0, 0, 1), so determinant() and inverse() check for
+	 * this and only work on the 3x3 part and translation when they can,
+	 * and composeAffine() multiplies two affine matrices without the
+	 * bottom row.  Projections still take the general path.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 2
+	 * @version 4
 	 * @since June 4, 2013
 	 */
-	class Mat4 {
+	class CAT_MATH_ALIGN Mat4 {
 	  public:
 		union MatrixData {
 			struct {
@@ -34,6 +46,9 @@ namespace Cat {
 					m41, m42, m43, m44;
 			};
 			Real m[16];
+#if defined (CAT_MATH_SSE)
+			__m128 col[4];
+#endif
 		};
 
 		enum TransformationType {
@@ -258,12 +273,20 @@ namespace Cat {
 		 * @return A new matrix that is the result of this + rhs.
 		 */
 		inline Mat4 operator+(const Mat4& rhs) const {
+#if defined (CAT_MATH_SSE)
+			Mat4 r;
+			for (U32 i = 0; i < 4; ++i) {
+				r.m_d.col[i] = _mm_add_ps(m_d.col[i], rhs.m_d.col[i]);
+			}
+			return r;
+#else
 			return Mat4( 
 				m_d.m[0] + rhs.m_d.m[0], m_d.m[1] + rhs.m_d.m[1], m_d.m[2] + rhs.m_d.m[2], m_d.m[3] + rhs.m_d.m[3],
 				m_d.m[4] + rhs.m_d.m[4], m_d.m[5] + rhs.m_d.m[5], m_d.m[6] + rhs.m_d.m[6], m_d.m[7] + rhs.m_d.m[7],
 				m_d.m[8] + rhs.m_d.m[8], m_d.m[9] + rhs.m_d.m[9], m_d.m[10] + rhs.m_d.m[10], m_d.m[11] + rhs.m_d.m[11],
 				m_d.m[12] + rhs.m_d.m[12], m_d.m[13] + rhs.m_d.m[13], m_d.m[14] + rhs.m_d.m[14], m_d.m[15] + rhs.m_d.m[15]
 				);
+#endif
 		}
 		
 		/**
@@ -272,12 +295,20 @@ namespace Cat {
 		 * @return A new matrix that is the result of this - rhs.
 		 */
 		inline Mat4 operator-(const Mat4& rhs) const {
+#if defined (CAT_MATH_SSE)
+			Mat4 r;
+			for (U32 i = 0; i < 4; ++i) {
+				r.m_d.col[i] = _mm_sub_ps(m_d.col[i], rhs.m_d.col[i]);
+			}
+			return r;
+#else
 			return Mat4( 
 				m_d.m[0] - rhs.m_d.m[0], m_d.m[1] - rhs.m_d.m[1], m_d.m[2] - rhs.m_d.m[2], m_d.m[3] - rhs.m_d.m[3],
 				m_d.m[4] - rhs.m_d.m[4], m_d.m[5] - rhs.m_d.m[5], m_d.m[6] - rhs.m_d.m[6], m_d.m[7] - rhs.m_d.m[7],
 				m_d.m[8] - rhs.m_d.m[8], m_d.m[9] - rhs.m_d.m[9], m_d.m[10] - rhs.m_d.m[10], m_d.m[11] - rhs.m_d.m[11],
 				m_d.m[12] - rhs.m_d.m[12], m_d.m[13] - rhs.m_d.m[13], m_d.m[14] - rhs.m_d.m[14], m_d.m[15] - rhs.m_d.m[15]
 				);
+#endif
 		}
 
 		/**
@@ -286,11 +317,18 @@ namespace Cat {
 		 * @return A reference to this matrix.
 		 */
 		inline Mat4 operator+=(const Mat4& rhs) {
+#if defined (CAT_MATH_SSE)
+			for (U32 i = 0; i < 4; ++i) {
+				m_d.col[i] = _mm_add_ps(m_d.col[i], rhs.m_d.col[i]);
+			}
+			return *this;
+#else
 			m_d.m[0] += rhs.m_d.m[0]; m_d.m[1] += rhs.m_d.m[1]; m_d.m[2] += rhs.m_d.m[2]; m_d.m[3] += rhs.m_d.m[3];
 			m_d.m[4] += rhs.m_d.m[4]; m_d.m[5] += rhs.m_d.m[5]; m_d.m[6] += rhs.m_d.m[6]; m_d.m[7] += rhs.m_d.m[7];
 			m_d.m[8] += rhs.m_d.m[8]; m_d.m[9] += rhs.m_d.m[9]; m_d.m[10] += rhs.m_d.m[10]; m_d.m[11] += rhs.m_d.m[11];
 			m_d.m[12] += rhs.m_d.m[12]; m_d.m[13] += rhs.m_d.m[13]; m_d.m[14] += rhs.m_d.m[14]; m_d.m[15] += rhs.m_d.m[15];
 			return *this;
+#endif
 		}
 		
 		/**
@@ -299,11 +337,18 @@ namespace Cat {
 		 * @return A reference to this matrix.
 		 */
 		inline Mat4 operator-=(const Mat4& rhs) {
+#if defined (CAT_MATH_SSE)
+			for (U32 i = 0; i < 4; ++i) {
+				m_d.col[i] = _mm_sub_ps(m_d.col[i], rhs.m_d.col[i]);
+			}
+			return *this;
+#else
 			m_d.m[0] -= rhs.m_d.m[0]; m_d.m[1] -= rhs.m_d.m[1]; m_d.m[2] -= rhs.m_d.m[2]; m_d.m[3] -= rhs.m_d.m[3];
 			m_d.m[4] -= rhs.m_d.m[4]; m_d.m[5] -= rhs.m_d.m[5]; m_d.m[6] -= rhs.m_d.m[6]; m_d.m[7] -= rhs.m_d.m[7];
 			m_d.m[8] -= rhs.m_d.m[8]; m_d.m[9] -= rhs.m_d.m[9]; m_d.m[10] -= rhs.m_d.m[10]; m_d.m[11] -= rhs.m_d.m[11];
 			m_d.m[12] -= rhs.m_d.m[12]; m_d.m[13] -= rhs.m_d.m[13]; m_d.m[14] -= rhs.m_d.m[14]; m_d.m[15] -= rhs.m_d.m[15];
 			return *this;
+#endif
 		}
 		
 		/**
@@ -312,6 +357,11 @@ namespace Cat {
 		 * @return A new matrix that is the result of this * rhs.
 		 */
 		inline Mat4 operator*(const Mat4& rhs) const {
+#if defined (CAT_MATH_SSE)
+			Mat4 r;
+			multiply(m_d, rhs.m_d, r.m_d);
+			return r;
+#else
 			Mat4 r;			
 			r.m_d.m11 = (m_d.m11*rhs.m_d.m11) + (m_d.m21 * rhs.m_d.m12) + (m_d.m31 * rhs.m_d.m13) + (m_d.m41 * rhs.m_d.m14);
 			r.m_d.m21 = (m_d.m11*rhs.m_d.m21) + (m_d.m21 * rhs.m_d.m22) + (m_d.m31 * rhs.m_d.m23) + (m_d.m41 * rhs.m_d.m24);
@@ -334,6 +384,7 @@ namespace Cat {
 			r.m_d.m44 = (m_d.m14*rhs.m_d.m41) + (m_d.m24 * rhs.m_d.m42) + (m_d.m34 * rhs.m_d.m43) + (m_d.m44 * rhs.m_d.m44);
 		
 			return r;
+#endif
 		}
 
 		/**
@@ -342,10 +393,19 @@ namespace Cat {
 		 * @return A new matrix multiplied by the scalar.
 		 */
 		inline Mat4 operator*(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			Mat4 r;
+			__m128 s = _mm_set1_ps(scalar);
+			for (U32 i = 0; i < 4; ++i) {
+				r.m_d.col[i] = _mm_mul_ps(m_d.col[i], s);
+			}
+			return r;
+#else
 			return Mat4( m_d.m[0] * scalar, m_d.m[1] * scalar, m_d.m[2] * scalar, m_d.m[3] * scalar,
 							 m_d.m[4] * scalar, m_d.m[5] * scalar, m_d.m[6] * scalar, m_d.m[7] * scalar,
 							 m_d.m[8] * scalar, m_d.m[9] * scalar, m_d.m[10] * scalar, m_d.m[11] * scalar,
 							 m_d.m[12] * scalar, m_d.m[13] * scalar, m_d.m[14] * scalar, m_d.m[15] * scalar );
+#endif
 		}
 		inline friend Mat4 operator*(const Real scalar, const Mat4& rhs) {
 			return rhs * scalar;
@@ -357,11 +417,19 @@ namespace Cat {
 		 * @return A reference to this matrix.
 		 */
 		inline Mat4& operator*=(const Real scalar) {			
+#if defined (CAT_MATH_SSE)
+			__m128 s = _mm_set1_ps(scalar);
+			for (U32 i = 0; i < 4; ++i) {
+				m_d.col[i] = _mm_mul_ps(m_d.col[i], s);
+			}
+			return *this;
+#else
 			m_d.m[0] *= scalar; m_d.m[1] *= scalar; m_d.m[2] *= scalar; m_d.m[3] *= scalar;
 			m_d.m[4] *= scalar; m_d.m[5] *= scalar; m_d.m[6] *= scalar;	m_d.m[7] *= scalar;
 		   m_d.m[8] *= scalar; m_d.m[9] *= scalar; m_d.m[10] *= scalar; m_d.m[11] *= scalar;
 		   m_d.m[12] *= scalar; m_d.m[13] *= scalar; m_d.m[14] *= scalar; m_d.m[15] *= scalar; 
 			return *this;
+#endif
 		}
 
 		/**
@@ -370,10 +438,19 @@ namespace Cat {
 		 * @return A new matrix divided by the scalar.
 		 */
 		inline Mat4 operator/(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			Mat4 r;
+			__m128 s = _mm_set1_ps(scalar);
+			for (U32 i = 0; i < 4; ++i) {
+				r.m_d.col[i] = _mm_div_ps(m_d.col[i], s);
+			}
+			return r;
+#else
 			return Mat4( m_d.m[0] / scalar, m_d.m[1] / scalar, m_d.m[2] / scalar, m_d.m[3] / scalar,
 							 m_d.m[4] / scalar, m_d.m[5] / scalar, m_d.m[6] / scalar, m_d.m[7] / scalar,
 							 m_d.m[8] / scalar, m_d.m[9] / scalar, m_d.m[10] / scalar, m_d.m[11] / scalar,
 							 m_d.m[12] / scalar, m_d.m[13] / scalar, m_d.m[14] / scalar, m_d.m[15] / scalar );
+#endif
 		}
 		inline friend Mat4 operator/(const Real scalar, const Mat4& rhs) {
 			return Mat4(
@@ -390,11 +467,19 @@ namespace Cat {
 		 * @return A reference to this matrix.
 		 */
 		inline Mat4& operator/=(const Real scalar) {			
+#if defined (CAT_MATH_SSE)
+			__m128 s = _mm_set1_ps(scalar);
+			for (U32 i = 0; i < 4; ++i) {
+				m_d.col[i] = _mm_div_ps(m_d.col[i], s);
+			}
+			return *this;
+#else
 			m_d.m[0] /= scalar; m_d.m[1] /= scalar; m_d.m[2] /= scalar; m_d.m[3] /= scalar;
 			m_d.m[4] /= scalar; m_d.m[5] /= scalar; m_d.m[6] /= scalar;	m_d.m[7] /= scalar;
 		   m_d.m[8] /= scalar; m_d.m[9] /= scalar; m_d.m[10] /= scalar; m_d.m[11] /= scalar;
 		   m_d.m[12] /= scalar; m_d.m[13] /= scalar; m_d.m[14] /= scalar; m_d.m[15] /= scalar; 
 			return *this;
+#endif
 		}
 		
 		/**
@@ -403,6 +488,12 @@ namespace Cat {
 		 * @return A reference to this matrix.
 		 */
 		Mat4& operator*=(const Mat4& rhs) {
+#if defined (CAT_MATH_SSE)
+			MatrixData m;
+			multiply(m_d, rhs.m_d, m);
+			m_d = m;
+			return *this;
+#else
 			Mat4::MatrixData m;
 
 			m.m11 = (m_d.m11*rhs.m_d.m11) + (m_d.m21 * rhs.m_d.m12) + (m_d.m31 * rhs.m_d.m13) + (m_d.m41 * rhs.m_d.m14);
@@ -427,6 +518,7 @@ namespace Cat {
 		
 			m_d = m;		
 			return *this;	
+#endif
 		}
 		
 
@@ -449,12 +541,16 @@ namespace Cat {
 		 * @return A new vector result.
 		 */
 		inline Vec4 operator*(const Vec4& rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(transform(m_d, rhs.v));
+#else
 			return Vec4(
 				(m_d.m11*rhs.x) + (m_d.m21 * rhs.y) + (m_d.m31 * rhs.z) + (m_d.m41 * rhs.w),
 				(m_d.m12*rhs.x) + (m_d.m22 * rhs.y) + (m_d.m32 * rhs.z) + (m_d.m42 * rhs.w),
 				(m_d.m13*rhs.x) + (m_d.m23 * rhs.y) + (m_d.m33 * rhs.z) + (m_d.m43 * rhs.w),
 				(m_d.m14*rhs.x) + (m_d.m24 * rhs.y) + (m_d.m34 * rhs.z) + (m_d.m44 * rhs.w)
 				);			
+#endif
 		}
 		
 		/**
@@ -462,12 +558,18 @@ namespace Cat {
 		 * @return A matrix that is the transpose of this matrix.
 		 */
 		inline Mat4 transposed() const {
+#if defined (CAT_MATH_SSE)
+			Mat4 r(*this);
+			_MM_TRANSPOSE4_PS(r.m_d.col[0], r.m_d.col[1], r.m_d.col[2], r.m_d.col[3]);
+			return r;
+#else
 			return Mat4(
 				m_d.m11, m_d.m21, m_d.m31, m_d.m41,
 				m_d.m12, m_d.m22, m_d.m32, m_d.m42,
 				m_d.m13, m_d.m23, m_d.m33, m_d.m43,
 				m_d.m14, m_d.m24, m_d.m34, m_d.m44
 				);
+#endif
 		}
 
 		/**
@@ -475,6 +577,10 @@ namespace Cat {
 		 * @return A reference to this matrix after it's been transposed.
 		 */
 		inline Mat4& transpose() {
+#if defined (CAT_MATH_SSE)
+			_MM_TRANSPOSE4_PS(m_d.col[0], m_d.col[1], m_d.col[2], m_d.col[3]);
+			return *this;
+#else
 			Real tmp = m_d.m12;
 			m_d.m12 = m_d.m21; m_d.m21 = tmp;
 			tmp = m_d.m13; m_d.m13 = m_d.m31; m_d.m31 = tmp;
@@ -483,8 +589,35 @@ namespace Cat {
 			tmp = m_d.m24; m_d.m24 = m_d.m42; m_d.m42 = tmp;
 			tmp = m_d.m34; m_d.m34 = m_d.m43; m_d.m43 = tmp;
 			return *this;
+#endif
+		}
+
+		/**
+		 * @brief Check whether the matrix is affine, its bottom row is
+		 * exactly (0, 0, 0, 1).
+		 * @return True if the matrix is affine.
+		 */
+		inline Boolean isAffine() const {
+			return m_d.m14 == REAL(0.0) && m_d.m24 == REAL(0.0) &&
+				m_d.m34 == REAL(0.0) && m_d.m44 == REAL(1.0);
 		}
 
+		/**
+		 * @brief Multiply two affine matrices, skipping the bottom row.
+		 * Both matrices must be affine (see isAffine()).
+		 * @param rhs The affine matrix to multiply by.
+		 * @return The affine product of the matrices, this*rhs.
+		 */
+		Mat4 composeAffine(const Mat4& rhs) const;
+
+		/**
+		 * @brief Get the inverse of an affine matrix, by inverting the 3x3
+		 * part and transforming back the translation.
+		 * The matrix must be affine (see isAffine()).
+		 * @return The inverse of the matrix, or a copy if not invertable.
+		 */
+		Mat4 inverseAffine() const;
+
 		/**
 		 * @brief Get the determinent of the matrix.
 		 * @return The determinant of the matrix.
@@ -586,6 +719,32 @@ namespace Cat {
 		void setToPerspectiveProjection(Real p_fov, Real p_aspect, Real p_n, Real p_f);
  
 	  private:
+#if defined (CAT_MATH_SSE)
+		/**
+		 * @brief Multiply a vector by the matrix, like the scalar operator,
+		 * ((m11*x + m21*y) + m31*z) + m41*w for each row.
+		 */
+		static inline __m128 transform(const MatrixData& m, __m128 v) {
+			return _mm_add_ps(
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(m.col[0], _mm_shuffle_ps(v, v, 0x00)),
+											 _mm_mul_ps(m.col[1], _mm_shuffle_ps(v, v, 0x55))),
+							  _mm_mul_ps(m.col[2], _mm_shuffle_ps(v, v, 0xAA))),
+				_mm_mul_ps(m.col[3], _mm_shuffle_ps(v, v, 0xFF)));
+		}
+
+		/**
+		 * @brief Multiply two matrices, each column of the result is the
+		 * lhs times the column of the rhs.  Result may not alias lhs.
+		 */
+		static inline void multiply(const MatrixData& lhs, const MatrixData& rhs,
+											 MatrixData& result) {
+			result.col[0] = transform(lhs, rhs.col[0]);
+			result.col[1] = transform(lhs, rhs.col[1]);
+			result.col[2] = transform(lhs, rhs.col[2]);
+			result.col[3] = transform(lhs, rhs.col[3]);
+		}
+#endif
+
 		MatrixData m_d;
 		
 	};
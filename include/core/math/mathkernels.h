@@ -0,0 +1,227 @@
+#ifndef CAT_CORE_MATH_MATHKERNELS_H
+#define CAT_CORE_MATH_MATHKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file mathkernels.h
+ * @brief The vectorised (SSE2 / AVX2) kernels to transform arrays of vectors.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/vec3.h"
+#include "core/math/vec4.h"
+#include "core/math/mat4.h"
+
+namespace Cat {
+
+	/**
+	 * @brief A structure of arrays view of a list of 3D vectors.
+	 * Each of the arrays must hold at least as many Reals as the count
+	 * passed to the kernel, and they must not overlap (except in place).
+	 */
+	struct Vec3SoA {
+		Real* x;
+		Real* y;
+		Real* z;
+
+		Vec3SoA() : x(NIL), y(NIL), z(NIL) {}
+		Vec3SoA(Real* px, Real* py, Real* pz) : x(px), y(py), z(pz) {}
+	};
+
+	/**
+	 * @class MathKernels mathkernels.h "core/math/mathkernels.h"
+	 * @brief The vectorised (SSE2 / AVX2) kernels to transform arrays of vectors.
+	 *
+	 * The kernels are grouped into tables of function pointers, one per
+	 * instruction set, and the best table for the running CPU is selected
+	 * once, on first use, just like the StringKernels.  Every kernel works
+	 * on both arrays of Vec3 / Vec4 (AoS), and on separate x, y, z arrays
+	 * (SoA), which is the faster layout when it can be chosen.
+	 *
+	 * The vector kernels do the same multiplies and adds, in the same order,
+	 * as the scalar Mat4 and Math functions (no fused multiply-add), so every
+	 * table gives exactly the same results as the scalar one, as long as the
+	 * library itself is not built with FMA contraction (-mfma).  The source
+	 * and destination arrays may be the same array, but must not otherwise
+	 * overlap.  No alignment is required.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class MathKernels {
+	  public:
+		struct Table {
+			/**
+			 * @brief Transform points by a matrix (w = 1), like Mat4 * Vec3.
+			 */
+			void (*transformVec3)(const Mat4& m, const Vec3* src, Vec3* dst, Size count);
+
+			/**
+			 * @brief Transform points stored as separate x, y, z arrays (w = 1).
+			 */
+			void (*transformSoA)(const Mat4& m, const Vec3SoA& src, const Vec3SoA& dst,
+										Size count);
+
+			/**
+			 * @brief Transform 4D vectors by a matrix, like Mat4 * Vec4.
+			 */
+			void (*transformVec4)(const Mat4& m, const Vec4* src, Vec4* dst, Size count);
+
+			/**
+			 * @brief Multiply pairs of matrices, dst[i] = lhs[i] * rhs[i].
+			 */
+			void (*multiplyMat4)(const Mat4* lhs, const Mat4* rhs, Mat4* dst, Size count);
+
+			/**
+			 * @brief Normalise 3D vectors, zero vectors are left as zero.
+			 */
+			void (*normaliseVec3)(const Vec3* src, Vec3* dst, Size count);
+
+			/**
+			 * @brief Normalise 3D vectors stored as separate x, y, z arrays.
+			 */
+			void (*normaliseSoA)(const Vec3SoA& src, const Vec3SoA& dst, Size count);
+
+			/**
+			 * @brief Compute the cross products, dst[i] = lhs[i] X rhs[i].
+			 */
+			void (*crossVec3)(const Vec3* lhs, const Vec3* rhs, Vec3* dst, Size count);
+
+			/**
+			 * @brief Compute the cross products of vectors stored as x, y, z arrays.
+			 */
+			void (*crossSoA)(const Vec3SoA& lhs, const Vec3SoA& rhs, const Vec3SoA& dst,
+								  Size count);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+		/**
+		 * @brief Transform an array of points by a matrix.
+		 * @param m The matrix to transform the points by.
+		 * @param src The points to transform.
+		 * @param dst The array to store the transformed points in (may be src).
+		 * @param count The number of points.
+		 */
+		static inline void transform(const Mat4& m, const Vec3* src, Vec3* dst, Size count) {
+			table().transformVec3(m, src, dst, count);
+		}
+
+		/**
+		 * @brief Transform a structure of arrays of points by a matrix.
+		 * @param m The matrix to transform the points by.
+		 * @param src The points to transform.
+		 * @param dst The arrays to store the transformed points in (may be src).
+		 * @param count The number of points.
+		 */
+		static inline void transform(const Mat4& m, const Vec3SoA& src, const Vec3SoA& dst,
+											  Size count) {
+			table().transformSoA(m, src, dst, count);
+		}
+
+		/**
+		 * @brief Transform an array of 4D vectors by a matrix.
+		 * @param m The matrix to transform the vectors by.
+		 * @param src The vectors to transform.
+		 * @param dst The array to store the transformed vectors in (may be src).
+		 * @param count The number of vectors.
+		 */
+		static inline void transform(const Mat4& m, const Vec4* src, Vec4* dst, Size count) {
+			table().transformVec4(m, src, dst, count);
+		}
+
+		/**
+		 * @brief Multiply arrays of matrices, dst[i] = lhs[i] * rhs[i].
+		 * @param lhs The matrices on the left hand side.
+		 * @param rhs The matrices on the right hand side.
+		 * @param dst The array to store the products in (may be lhs or rhs).
+		 * @param count The number of matrices.
+		 */
+		static inline void multiply(const Mat4* lhs, const Mat4* rhs, Mat4* dst, Size count) {
+			table().multiplyMat4(lhs, rhs, dst, count);
+		}
+
+		/**
+		 * @brief Normalise an array of vectors.
+		 * @param src The vectors to normalise.
+		 * @param dst The array to store the normalised vectors in (may be src).
+		 * @param count The number of vectors.
+		 */
+		static inline void normalise(const Vec3* src, Vec3* dst, Size count) {
+			table().normaliseVec3(src, dst, count);
+		}
+
+		/**
+		 * @brief Normalise a structure of arrays of vectors.
+		 * @param src The vectors to normalise.
+		 * @param dst The arrays to store the normalised vectors in (may be src).
+		 * @param count The number of vectors.
+		 */
+		static inline void normalise(const Vec3SoA& src, const Vec3SoA& dst, Size count) {
+			table().normaliseSoA(src, dst, count);
+		}
+
+		/**
+		 * @brief Compute the cross products of two arrays of vectors.
+		 * @param lhs The vectors on the left hand side.
+		 * @param rhs The vectors on the right hand side.
+		 * @param dst The array to store the cross products in (may be lhs or rhs).
+		 * @param count The number of vectors.
+		 */
+		static inline void cross(const Vec3* lhs, const Vec3* rhs, Vec3* dst, Size count) {
+			table().crossVec3(lhs, rhs, dst, count);
+		}
+
+		/**
+		 * @brief Compute the cross products of two structures of arrays of vectors.
+		 * @param lhs The vectors on the left hand side.
+		 * @param rhs The vectors on the right hand side.
+		 * @param dst The arrays to store the cross products in (may be lhs or rhs).
+		 * @param count The number of vectors.
+		 */
+		static inline void cross(const Vec3SoA& lhs, const Vec3SoA& rhs, const Vec3SoA& dst,
+										 Size count) {
+			table().crossSoA(lhs, rhs, dst, count);
+		}
+
+	  private:
+		/**
+		 * @brief Choose the best table for the running CPU.
+		 */
+		static const Table* selectTable();
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_MATHKERNELS_H
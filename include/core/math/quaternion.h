@@ -22,17 +22,30 @@ namespace Cat {
 	 * @class Quaternion quaternion.h "core/math/quaternion.h"
 	 * @brief A class representing a Quaternion.
 	 * 
+	 * When built with CAT_SIMD_MATH the Quaternion is 16-byte aligned and
+	 * also stored as an __m128, and the component-wise operators, the
+	 * Quaternion product, and slerp use SSE.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 3
+	 * @version 4
 	 * @since June 13, 2013
 	 */
-	class Quaternion {
+	class CAT_MATH_ALIGN Quaternion {
 	  public:
 		static const Real kEpsilon;
 		static const Quaternion kZero;
 		static const Quaternion kIdentity;
 		
+#if defined (CAT_MATH_SSE)
+		union {
+			struct {
+				Real x, y, z, w;
+			};
+			__m128 v;
+		};
+#else
 		Real x, y, z, w;
+#endif
 		
 		/**
 		 * @brief Creates an identity quaternion.
@@ -57,6 +70,14 @@ namespace Cat {
 		inline explicit Quaternion(const Real* const arr)
 			: x(arr[0]), y(arr[1]), z(arr[2]), w(arr[3]) {}
 
+#if defined (CAT_MATH_SSE)
+		/**
+		 * @brief Creates a Quaternion from an SSE vector.
+		 * @param vec The SSE vector holding x, y, z, w.
+		 */
+		inline explicit Quaternion(__m128 vec) : v(vec) {}
+#endif
+
 		/**
 		 * @brief Create a Quaternion from a vector with w = 0.
 		 * @param p_vec The vector to create the quaternion from.
@@ -117,7 +138,11 @@ namespace Cat {
 		 * @param src The Quaternion to copy.
 		 */
 		inline Quaternion(const Quaternion& src) {
+#if defined (CAT_MATH_SSE)
+			v = src.v;
+#else
 			x = src.x; y = src.y; z = src.z; w = src.w;
+#endif
 		}
 		
 		/**
@@ -126,8 +151,13 @@ namespace Cat {
 		 * @return A reference to this quaternion.
 		 */
 		inline Quaternion& operator=(const Quaternion& src) {
+#if defined (CAT_MATH_SSE)
+			v = src.v;
+			return *this;
+#else
 			x = src.x; y = src.y; z = src.z; w = src.w;
 			return *this;
+#endif
 		}
 
 		/**
@@ -268,7 +298,11 @@ namespace Cat {
 		 * @return The conjugate of a quaternion.
 		 */
 		inline Quaternion operator-() const {
+#if defined (CAT_MATH_SSE)
+			return Quaternion(_mm_xor_ps(v, _mm_set1_ps(REAL(-0.0))));
+#else
 			return Quaternion(-x, -y, -z, -w);
+#endif
 		}
 		
 
@@ -278,7 +312,11 @@ namespace Cat {
 		 * @return A new Quaternion that is the sum this+rhs.
 		 */
 		inline Quaternion operator+(const Quaternion& rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Quaternion(_mm_add_ps(v, rhs.v));
+#else
 			return Quaternion(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+#endif
 		}
 
 		/**
@@ -287,8 +325,13 @@ namespace Cat {
 		 * @return A reference to this quaternion.
 		 */
 		inline Quaternion& operator+=(const Quaternion& rhs) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_add_ps(v, rhs.v);
+			return *this;
+#else
 			x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w;
 			return *this;			
+#endif
 		}
 		
 		/**
@@ -297,7 +340,11 @@ namespace Cat {
 		 * @return A new Quaternion that is the difference this - rhs.
 		 */
 		inline Quaternion operator-(const Quaternion& rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Quaternion(_mm_sub_ps(v, rhs.v));
+#else
 			return Quaternion(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+#endif
 		}
 
 		/** 
@@ -306,8 +353,13 @@ namespace Cat {
 		 * @return A reference to this Quaternion.
 		 */
 		inline Quaternion& operator-=(const Quaternion& rhs) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_sub_ps(v, rhs.v);
+			return *this;
+#else
 			x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w;
 			return *this;
+#endif
 		}
 
 		/**
@@ -316,10 +368,18 @@ namespace Cat {
 		 * @return A copy of the Quaternion scaled by the scalar.
 		 */
 		inline Quaternion operator*(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			return Quaternion(_mm_mul_ps(v, _mm_set1_ps(scalar)));
+#else
 			return Quaternion(x*scalar, y*scalar, z*scalar, w*scalar);
+#endif
 		}
 		inline friend Quaternion operator*(const Real scalar, const Quaternion& rhs) {
+#if defined (CAT_MATH_SSE)
+			return Quaternion(_mm_mul_ps(_mm_set1_ps(scalar), rhs.v));
+#else
 			return Quaternion(scalar*rhs.x, scalar*rhs.y, scalar*rhs.z, scalar*rhs.w);
+#endif
 		}
 		
 
@@ -329,8 +389,13 @@ namespace Cat {
 		 * @return A reference to this Quaternion.
 		 */
 		inline Quaternion& operator*=(const Real scalar) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_mul_ps(v, _mm_set1_ps(scalar));
+			return *this;
+#else
 			x *= scalar; y *= scalar; z *= scalar; w *= scalar;
 			return *this;
+#endif
 		}
 		
 		/**
@@ -360,7 +425,11 @@ namespace Cat {
 		 * @return A copy of the Quaternion divided by the scalar.
 		 */
 		inline Quaternion operator/(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			return Quaternion(_mm_div_ps(v, _mm_set1_ps(scalar)));
+#else
 			return Quaternion(x/scalar, y/scalar, z/scalar, w/scalar);
+#endif
 		}
 		inline friend Quaternion operator/(const Real scalar, const Quaternion& rhs) {
 			return Quaternion(scalar/rhs.x, scalar/rhs.y, scalar/rhs.z, scalar/rhs.w);
@@ -372,8 +441,13 @@ namespace Cat {
 		 * @return A reference to this Quaternion.
 		 */
 		inline Quaternion& operator/=(const Real scalar) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_div_ps(v, _mm_set1_ps(scalar));
+			return *this;
+#else
 			x /= scalar; y /= scalar; z /= scalar; w /= scalar;
 			return *this;
+#endif
 		}
 
 		/**
@@ -507,11 +581,17 @@ namespace Cat {
 		 * @return A linearly interpolated quaternion.
 		 */
 		static inline Quaternion lerp(const Quaternion& p_q1, const Quaternion& p_q2, Real p_t) {
+#if defined (CAT_MATH_SSE)
+			Real one_minus = REAL(1.0) - p_t;
+			return Quaternion(_mm_add_ps(_mm_mul_ps(p_q1.v, _mm_set1_ps(one_minus)),
+												  _mm_mul_ps(p_q2.v, _mm_set1_ps(p_t))));
+#else
 			Real one_minus = REAL(1.0) - p_t;
 			return Quaternion(p_q1.x * one_minus + p_q2.x * p_t,
 									p_q1.y * one_minus + p_q2.y * p_t,
 									p_q1.z * one_minus + p_q2.z * p_t,
 									p_q1.w * one_minus + p_q2.w * p_t);
+#endif
 		}
 		
 		/**
@@ -0,0 +1,188 @@
+#ifndef CAT_CORE_MATH_RANDOM_H
+#define CAT_CORE_MATH_RANDOM_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file random.h
+ * @brief A small, fast, seedable pseudo-random number generator (xoshiro128**).
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/vec2.h"
+#include "core/math/vec3.h"
+#include "core/math/quaternion.h"
+
+namespace Cat {
+
+	/**
+	 * @class Random random.h "core/math/random.h"
+	 * @brief A small, fast, seedable pseudo-random number generator (xoshiro128**).
+	 *
+	 * The generator is the xoshiro128** of Blackman and Vigna, with 128
+	 * bits of state seeded by SplitMix64, so the same seed gives the same
+	 * sequence on every platform.  It is not thread safe; each thread (or
+	 * task) should use its own generator, and forStream() gives each of
+	 * them a generator 2^96 values apart from the others, so that their
+	 * sequences never overlap.  jump() moves a generator 2^64 values
+	 * ahead, which the RandomStream uses to split itself into lanes.
+	 *
+	 * For filling large arrays use a RandomStream, which generates several
+	 * values at once with SIMD.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class Random {
+	  public:
+		/**
+		 * @brief Create a generator from a seed.
+		 * @param seed The seed of the sequence.
+		 */
+		explicit inline Random(U64 seed = 0) {
+			setSeed(seed);
+		}
+
+		/**
+		 * @brief Create the generator for one of a set of independent streams.
+		 * @param seed The seed shared by all the streams.
+		 * @param stream The index of the stream (e.g., the thread index).
+		 * @return A generator 2^96 * stream values into the sequence of the seed.
+		 */
+		static Random forStream(U64 seed, U32 stream);
+
+		/**
+		 * @brief Restart the sequence from a new seed.
+		 * @param seed The seed of the sequence.
+		 */
+		void setSeed(U64 seed);
+
+		/**
+		 * @brief Move the generator 2^64 values ahead in its sequence.
+		 */
+		void jump();
+
+		/**
+		 * @brief Move the generator 2^96 values ahead in its sequence.
+		 */
+		void longJump();
+
+		/**
+		 * @brief Get the next 32 random bits.
+		 * @return A uniformly distributed U32.
+		 */
+		inline U32 nextU32() {
+			U32 result = rotl(m_state[1] * 5, 7) * 9;
+			U32 t = m_state[1] << 9;
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = rotl(m_state[3], 11);
+			return result;
+		}
+
+		/**
+		 * @brief Get a random integer less than a bound, without bias.
+		 * @param bound The exclusive upper bound, which must not be zero.
+		 * @return A uniformly distributed integer in [0, bound).
+		 */
+		U32 nextU32(U32 bound);
+
+		/**
+		 * @brief Get a random integer in a range, without bias.
+		 * @param min The inclusive lower bound.
+		 * @param max The inclusive upper bound, not less than min.
+		 * @return A uniformly distributed integer in [min, max].
+		 */
+		inline I32 nextI32(I32 min, I32 max) {
+			U32 range = (U32)max - (U32)min + 1;
+			return (I32)((U32)min + (range ? nextU32(range) : nextU32()));
+		}
+
+		/**
+		 * @brief Get a random Real in [0, 1), a multiple of 2^-24.
+		 * @return A uniformly distributed Real in [0, 1).
+		 */
+		inline Real nextReal() {
+			return toUniform(nextU32());
+		}
+
+		/**
+		 * @brief Get a random Real in a range.
+		 * @param min The inclusive lower bound.
+		 * @param max The exclusive upper bound.
+		 * @return A uniformly distributed Real in [min, max).
+		 */
+		inline Real nextReal(Real min, Real max) {
+			return min + (max - min)*nextReal();
+		}
+
+		/**
+		 * @brief Get a normally distributed random Real.
+		 * @param mean The mean of the distribution.
+		 * @param stddev The standard deviation of the distribution.
+		 * @return A normally distributed Real.
+		 */
+		Real nextNormal(Real mean = REAL(0.0), Real stddev = REAL(1.0));
+
+		/**
+		 * @brief Get a random direction in 2D.
+		 * @return A uniformly distributed unit Vec2.
+		 */
+		Vec2 nextUnitVec2();
+
+		/**
+		 * @brief Get a random direction in 3D.
+		 * @return A uniformly distributed unit Vec3.
+		 */
+		Vec3 nextUnitVec3();
+
+		/**
+		 * @brief Get a random rotation.
+		 * @return A uniformly distributed unit Quaternion.
+		 */
+		Quaternion nextQuaternion();
+
+		/**
+		 * @brief Get the state of the generator, e.g., to save and restore it.
+		 * @return The four words of the state.
+		 */
+		inline const U32* state() const { return m_state; }
+
+		/**
+		 * @brief Restore a state saved from state().
+		 * @param state The four words of the state, not all zero.
+		 */
+		inline void setState(const U32* state) {
+			m_state[0] = state[0];
+			m_state[1] = state[1];
+			m_state[2] = state[2];
+			m_state[3] = state[3];
+		}
+
+		/**
+		 * @brief Convert 32 random bits to a Real in [0, 1), using the top 24.
+		 * @param bits The random bits.
+		 * @return The uniformly distributed Real.
+		 */
+		static inline Real toUniform(U32 bits) {
+			return (Real)(bits >> 8) * (REAL(1.0) / REAL(16777216.0));
+		}
+
+	  private:
+		U32 m_state[4];
+
+		static inline U32 rotl(U32 x, I32 k) {
+			return (x << k) | (x >> (32 - k));
+		}
+
+		void jump(const U32* polynomial);
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_RANDOM_H
@@ -0,0 +1,93 @@
+#ifndef CAT_CORE_MATH_RANDOMKERNELS_H
+#define CAT_CORE_MATH_RANDOMKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file randomkernels.h
+ * @brief The vectorised (SSE2 / AVX2) kernels to generate random numbers in bulk.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @brief The state of eight xoshiro128** generators, stored by word,
+	 * so that word k of lane j is s[k][j].
+	 */
+	struct RandomLanes {
+		static const Size kNumLanes = 8;
+		U32 s[4][kNumLanes];
+	};
+
+	/**
+	 * @class RandomKernels randomkernels.h "core/math/randomkernels.h"
+	 * @brief The vectorised (SSE2 / AVX2) kernels to generate random numbers in bulk.
+	 *
+	 * The kernels step eight independent xoshiro128** generators at once,
+	 * which is four or eight lanes per instruction, since the multiplies by
+	 * 5 and 9 are only shifts and adds.  Everything is integer arithmetic
+	 * (or exact conversions), so every table gives exactly the same values
+	 * as the scalar one.  As with the MathKernels, the best table for the
+	 * running CPU is selected once, on first use.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class RandomKernels {
+	  public:
+		struct Table {
+			/**
+			 * @brief Step every lane a number of times, storing the outputs
+			 * in lane order, so dst[8*i + j] is the i'th output of lane j.
+			 */
+			void (*bits)(RandomLanes& lanes, U32* dst, Size blocks);
+
+			/**
+			 * @brief Convert random bits to Reals in [0, 1), see Random::toUniform().
+			 * The source and destination may be the same memory.
+			 */
+			void (*uniform)(const U32* src, Real* dst, Size count);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+	  private:
+		static const Table* selectTable();
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_RANDOMKERNELS_H
@@ -0,0 +1,120 @@
+#ifndef CAT_CORE_MATH_RANDOMSTREAM_H
+#define CAT_CORE_MATH_RANDOMSTREAM_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file randomstream.h
+ * @brief A random number generator to fill arrays in bulk, with SIMD.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/random.h"
+#include "core/math/randomkernels.h"
+
+namespace Cat {
+
+	/**
+	 * @class RandomStream randomstream.h "core/math/randomstream.h"
+	 * @brief A random number generator to fill arrays in bulk, with SIMD.
+	 *
+	 * The stream is eight xoshiro128** generators, each 2^64 values apart,
+	 * which are stepped together by the RandomKernels and interleaved into
+	 * one sequence.  The values depend only on the seed and on the order
+	 * of the calls, never on how many values each call asks for, or on
+	 * which instruction set is used: the normals, directions and rotations
+	 * use the precise vectorised Math::log(), sin() and cos(), which give
+	 * the same results with and without SIMD.  Each sample uses the next
+	 * one, two or three uniform values, in order.
+	 *
+	 * As with Random, a stream is not thread safe; use Random::forStream()
+	 * to create an independent stream for each thread.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class RandomStream {
+	  public:
+		/**
+		 * @brief Create a stream from a seed.
+		 * @param seed The seed of the stream.
+		 */
+		explicit RandomStream(U64 seed = 0);
+
+		/**
+		 * @brief Create a stream starting from the state of a generator.
+		 * @param random The generator to start from, which is not changed.
+		 */
+		explicit RandomStream(const Random& random);
+
+		/**
+		 * @brief Fill an array with random bits.
+		 * @param dst The array to fill.
+		 * @param count The number of values.
+		 */
+		void bits(U32* dst, Size count);
+
+		/**
+		 * @brief Fill an array with Reals in [0, 1), see Random::nextReal().
+		 * @param dst The array to fill.
+		 * @param count The number of values.
+		 */
+		void uniform(Real* dst, Size count);
+
+		/**
+		 * @brief Fill an array with Reals in [min, max).
+		 * @param dst The array to fill.
+		 * @param count The number of values.
+		 * @param min The inclusive lower bound.
+		 * @param max The exclusive upper bound.
+		 */
+		void uniform(Real* dst, Size count, Real min, Real max);
+
+		/**
+		 * @brief Fill an array with normally distributed Reals.
+		 * @param dst The array to fill.
+		 * @param count The number of values.
+		 * @param mean The mean of the distribution.
+		 * @param stddev The standard deviation of the distribution.
+		 */
+		void normal(Real* dst, Size count, Real mean = REAL(0.0), Real stddev = REAL(1.0));
+
+		/**
+		 * @brief Fill an array with random directions in 2D.
+		 * @param dst The array to fill.
+		 * @param count The number of directions.
+		 */
+		void unitVec2(Vec2* dst, Size count);
+
+		/**
+		 * @brief Fill an array with random directions in 3D.
+		 * @param dst The array to fill.
+		 * @param count The number of directions.
+		 */
+		void unitVec3(Vec3* dst, Size count);
+
+		/**
+		 * @brief Fill an array with random rotations.
+		 * @param dst The array to fill.
+		 * @param count The number of rotations.
+		 */
+		void quaternions(Quaternion* dst, Size count);
+
+	  private:
+		/* The number of samples done at a time, on the stack */
+		static const Size kChunkSize = 128;
+
+		RandomLanes	m_lanes;
+		U32			m_buffer[RandomLanes::kNumLanes];
+		Size			m_numBuffered;
+		Real			m_spareNormal;
+		Boolean		m_hasSpareNormal;
+
+		void init(const Random& random);
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_RANDOMSTREAM_H
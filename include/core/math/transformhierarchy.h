@@ -0,0 +1,282 @@
+#ifndef CAT_CORE_MATH_TRANSFORMHIERARCHY_H
+#define CAT_CORE_MATH_TRANSFORMHIERARCHY_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file transformhierarchy.h
+ * @brief A hierarchy of transforms (a skeleton or scene graph) updated in batches.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/mat4.h"
+#include "core/math/mathkernels.h"
+#include "core/math/quaternion.h"
+
+namespace Cat {
+
+	class AsyncTaskRunner;
+
+	/**
+	 * @brief A structure of arrays view of a list of quaternions.
+	 * Each of the arrays must hold at least as many Reals as the count
+	 * passed to the function, and they must not overlap (except in place).
+	 */
+	struct QuaternionSoA {
+		Real* x;
+		Real* y;
+		Real* z;
+		Real* w;
+
+		QuaternionSoA() : x(NIL), y(NIL), z(NIL), w(NIL) {}
+		QuaternionSoA(Real* px, Real* py, Real* pz, Real* pw) : x(px), y(py), z(pz), w(pw) {}
+	};
+
+	/**
+	 * @class TransformHierarchy transformhierarchy.h "core/math/transformhierarchy.h"
+	 * @brief A hierarchy of transforms (a skeleton or scene graph) updated in batches.
+	 *
+	 * The local translation, rotation and scale of each node are kept in
+	 * separate arrays (a structure of arrays), and the nodes are stored
+	 * with every parent before its children, which addNode() enforces.
+	 * This means the world matrices can all be computed in one pass from
+	 * the start of the arrays to the end: the local matrices are built four
+	 * nodes at a time with SSE, and each one is composed with the already
+	 * finished world matrix of its parent.
+	 *
+	 * Whenever a root node starts a run of nodes that nothing after it
+	 * reaches back past (e.g. the nodes were added depth first), that run
+	 * is an independent subtree, and updateWorld() can be given an
+	 * AsyncTaskRunner to update the subtrees in parallel.
+	 *
+	 * The poses can be blended with interpolate(), which uses the batched
+	 * nlerp() or slerp() on the rotation arrays.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class TransformHierarchy {
+	  public:
+		static const U32 kNoParent = 0xFFFFFFFF;
+
+		enum Interpolation { kNlerp = 0, kSlerp };
+
+		/**
+		 * @brief Create an empty hierarchy with room for a fixed number of nodes.
+		 * @param capacity The maximum number of nodes in the hierarchy.
+		 */
+		explicit TransformHierarchy(Size capacity);
+
+		/**
+		 * @brief Free the arrays of the hierarchy.
+		 */
+		~TransformHierarchy();
+
+		/**
+		 * @brief Add a new node to the end of the hierarchy.
+		 * @param parent The index of the parent, which must already be in
+		 * the hierarchy, or kNoParent for a root node.
+		 * @param translation The local translation of the node.
+		 * @param rotation The local (unit length) rotation of the node.
+		 * @param scale The local scale of the node.
+		 * @return The index of the new node, or kNoParent if it could not be added.
+		 */
+		U32 addNode(U32 parent, const Vec3& translation, const Quaternion& rotation,
+						const Vec3& scale);
+
+		/**
+		 * @brief Add a new node with no local transform to the end of the hierarchy.
+		 * @param parent The index of the parent, or kNoParent for a root node.
+		 * @return The index of the new node, or kNoParent if it could not be added.
+		 */
+		inline U32 addNode(U32 parent) {
+			return addNode(parent, Vec3(REAL(0.0), REAL(0.0), REAL(0.0)), Quaternion::kIdentity,
+								Vec3(REAL(1.0), REAL(1.0), REAL(1.0)));
+		}
+
+		/**
+		 * @brief Remove all the nodes from the hierarchy.
+		 */
+		inline void clear() {
+			m_size = 0;
+			m_numSubtrees = 0;
+		}
+
+		/**
+		 * @brief Get the number of nodes in the hierarchy.
+		 * @return The number of nodes.
+		 */
+		inline Size size() const { return m_size; }
+
+		/**
+		 * @brief Get the maximum number of nodes in the hierarchy.
+		 * @return The capacity of the hierarchy.
+		 */
+		inline Size capacity() const { return m_capacity; }
+
+		/**
+		 * @brief Get the index of the parent of a node.
+		 * @param node The index of the node.
+		 * @return The index of the parent, or kNoParent for a root node.
+		 */
+		inline U32 getParent(U32 node) const { return m_pParents[node]; }
+
+		/**
+		 * @brief Set the local transform of a node.
+		 * @param node The index of the node.
+		 * @param translation The local translation of the node.
+		 * @param rotation The local (unit length) rotation of the node.
+		 * @param scale The local scale of the node.
+		 */
+		void setLocal(U32 node, const Vec3& translation, const Quaternion& rotation,
+						  const Vec3& scale);
+
+		/**
+		 * @brief Get the local translation of a node.
+		 * @param node The index of the node.
+		 * @return The local translation.
+		 */
+		inline Vec3 getTranslation(U32 node) const {
+			return Vec3(m_translations.x[node], m_translations.y[node], m_translations.z[node]);
+		}
+
+		/**
+		 * @brief Get the local rotation of a node.
+		 * @param node The index of the node.
+		 * @return The local rotation.
+		 */
+		inline Quaternion getRotation(U32 node) const {
+			return Quaternion(m_rotations.x[node], m_rotations.y[node],
+									m_rotations.z[node], m_rotations.w[node]);
+		}
+
+		/**
+		 * @brief Get the local scale of a node.
+		 * @param node The index of the node.
+		 * @return The local scale.
+		 */
+		inline Vec3 getScale(U32 node) const {
+			return Vec3(m_scales.x[node], m_scales.y[node], m_scales.z[node]);
+		}
+
+		/**
+		 * @brief Get the arrays of local translations, to write them in a batch.
+		 * @return The arrays of local translations.
+		 */
+		inline const Vec3SoA& translations() const { return m_translations; }
+
+		/**
+		 * @brief Get the arrays of local rotations, to write them in a batch.
+		 * @return The arrays of local rotations.
+		 */
+		inline const QuaternionSoA& rotations() const { return m_rotations; }
+
+		/**
+		 * @brief Get the arrays of local scales, to write them in a batch.
+		 * @return The arrays of local scales.
+		 */
+		inline const Vec3SoA& scales() const { return m_scales; }
+
+		/**
+		 * @brief Get the world matrix of a node, as of the last updateWorld().
+		 * @param node The index of the node.
+		 * @return The world matrix of the node.
+		 */
+		inline const Mat4& getWorld(U32 node) const { return m_pWorld[node]; }
+
+		/**
+		 * @brief Get the array of world matrices, as of the last updateWorld().
+		 * @return The world matrices, in the order of the nodes.
+		 */
+		inline const Mat4* getWorldMatrices() const { return m_pWorld; }
+
+		/**
+		 * @brief Set the local transforms to a blend of two poses of the same
+		 * hierarchy.  The translations and scales are interpolated linearly.
+		 * @param from The pose at t = 0, with the same number of nodes.
+		 * @param to The pose at t = 1, with the same number of nodes.
+		 * @param t The amount of interpolation [0 - 1].
+		 * @param mode Whether to nlerp or slerp the rotations.
+		 */
+		void interpolate(const TransformHierarchy& from, const TransformHierarchy& to,
+							  Real t, Interpolation mode = kNlerp);
+
+		/**
+		 * @brief Compute the world matrices of every node, in one pass.
+		 */
+		void updateWorld();
+
+		/**
+		 * @brief Compute the world matrices of every node, updating the
+		 * independent subtrees in parallel on the runner.  The calling
+		 * thread updates one of the subtrees and waits for the rest, and
+		 * also updates any the runner refuses because it has been stopped.
+		 * @param runner The runner to update the subtrees on, or NIL.
+		 */
+		void updateWorld(AsyncTaskRunner* runner);
+
+		/**
+		 * @brief Get the number of independent subtrees, see updateWorld().
+		 * @return The number of runs of nodes that can be updated in parallel.
+		 */
+		Size getNumSubtrees();
+
+		/**
+		 * @brief Normalised linear interpolation of arrays of quaternions,
+		 * taking the shorter path.
+		 * @param from The quaternions at t = 0.
+		 * @param to The quaternions at t = 1.
+		 * @param t The amount of interpolation [0 - 1].
+		 * @param dst The arrays to store the results in (may be from or to).
+		 * @param count The number of quaternions.
+		 */
+		static void nlerp(const QuaternionSoA& from, const QuaternionSoA& to, Real t,
+								const QuaternionSoA& dst, Size count);
+
+		/**
+		 * @brief Spherical linear interpolation of arrays of quaternions,
+		 * taking the shorter path.  Like Quaternion::slerp(), quaternions
+		 * closer than acos(0.99) fall back to (normalised) linear interpolation.
+		 * @param from The quaternions at t = 0.
+		 * @param to The quaternions at t = 1.
+		 * @param t The amount of interpolation [0 - 1].
+		 * @param dst The arrays to store the results in (may be from or to).
+		 * @param count The number of quaternions.
+		 */
+		static void slerp(const QuaternionSoA& from, const QuaternionSoA& to, Real t,
+								const QuaternionSoA& dst, Size count);
+
+		/**
+		 * @brief Update the world matrices of a run of nodes whose parents
+		 * are all either in the run or already up to date.
+		 * @param begin The index of the first node.
+		 * @param end The index one past the last node.
+		 */
+		void updateRange(Size begin, Size end);
+
+	  private:
+		Real*				m_pData;
+		Vec3SoA			m_translations;
+		QuaternionSoA	m_rotations;
+		Vec3SoA			m_scales;
+		U32*				m_pParents;
+		Mat4*				m_pWorld;
+		Size*				m_pSubtrees;
+		Size				m_numSubtrees;
+		Size				m_size;
+		Size				m_capacity;
+
+		/**
+		 * @brief Find the start of each independent subtree, if not done yet.
+		 */
+		void findSubtrees();
+
+		TransformHierarchy(const TransformHierarchy&);
+		TransformHierarchy& operator=(const TransformHierarchy&);
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_TRANSFORMHIERARCHY_H
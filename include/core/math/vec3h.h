@@ -0,0 +1,80 @@
+#ifndef CAT_CORE_MATH_VEC3H_H
+#define CAT_CORE_MATH_VEC3H_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file vec3h.h
+ * @brief A 3D vector stored as half floats, for compact arrays.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/math/vec3.h"
+#include "core/math/convertkernels.h"
+
+namespace Cat {
+
+	/**
+	 * @class Vec3h vec3h.h "core/math/vec3h.h"
+	 * @brief A 3D vector stored as half floats, for compact arrays.
+	 *
+	 * A Vec3h is only storage, at half the size of a Vec3 (with about
+	 * three significant digits, and a range of +-65504); arrays of them
+	 * are converted to Vec3 for computing with unpack(), and back with
+	 * pack(), which use the ConvertKernels.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Vec3h {
+	  public:
+		Half x, y, z;
+
+		/**
+		 * @brief Create a zero vector.
+		 */
+		inline Vec3h()
+			: x(0), y(0), z(0) {}
+
+		/**
+		 * @brief Create a vector from the nearest half floats to a Vec3.
+		 * @param v The vector to convert.
+		 */
+		inline explicit Vec3h(const Vec3& v)
+			: x(HalfFloat::fromReal(v.x)), y(HalfFloat::fromReal(v.y)),
+			  z(HalfFloat::fromReal(v.z)) {}
+
+		/**
+		 * @brief Convert the vector to a Vec3.
+		 * @return The vector as a Vec3.
+		 */
+		inline Vec3 toVec3() const {
+			return Vec3(HalfFloat::toReal(x), HalfFloat::toReal(y), HalfFloat::toReal(z));
+		}
+
+		/**
+		 * @brief Convert an array of Vec3h to Vec3.
+		 * @param src The vectors to convert.
+		 * @param dst The array to store the Vec3 in.
+		 * @param count The number of vectors.
+		 */
+		static inline void unpack(const Vec3h* src, Vec3* dst, Size count) {
+			ConvertKernels::toReal(&src->x, &dst->x, count*3);
+		}
+
+		/**
+		 * @brief Convert an array of Vec3 to Vec3h.
+		 * @param src The vectors to convert.
+		 * @param dst The array to store the Vec3h in.
+		 * @param count The number of vectors.
+		 */
+		static inline void pack(const Vec3* src, Vec3h* dst, Size count) {
+			ConvertKernels::fromReal(&src->x, &dst->x, count*3);
+		}
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_MATH_VEC3H_H
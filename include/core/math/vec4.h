@@ -13,6 +13,7 @@
  */
 
 #include "core/corelib.h"
+#include "core/sys/cpu.h"
 
 namespace Cat {
 
@@ -20,13 +21,26 @@ namespace Cat {
 	 * @class Vec4 vec4.h "core/math/vec4.h"
 	 * @brief A class representing a 4D Vector with Real components.
 	 *
+	 * When built with CAT_SIMD_MATH the vector is 16-byte aligned and also
+	 * stored as an __m128, and the arithmetic operators use SSE.  Each
+	 * component is computed exactly as the scalar operator would.
+	 *
 	 * @author Catlin Zilinski
-	 * @version 2
+	 * @version 3
 	 * @since Dec 4, 2013
 	 */
-	class Vec4 {
+	class CAT_MATH_ALIGN Vec4 {
 	  public:
+#if defined (CAT_MATH_SSE)
+		union {
+			struct {
+				Real x, y, z, w;
+			};
+			__m128 v;
+		};
+#else
 		Real x, y, z, w;
+#endif
 		
 		/**
 		 * @brief Default constructor sets to zero vector.
@@ -58,6 +72,25 @@ namespace Cat {
 		inline explicit Vec4(Real *const vec)
 			: x(vec[0]), y(vec[1]), z(vec[2]), w(vec[3]) {}
 
+#if defined (CAT_MATH_SSE)
+		/**
+		 * @brief Sets the vector from an SSE vector.
+		 * @param vec The SSE vector holding x, y, z, w.
+		 */
+		inline explicit Vec4(__m128 vec) : v(vec) {}
+#endif
+
+		/**
+		 * @brief Copy constructor.
+		 * @param src The source vector to copy from.
+		 */
+#if defined (CAT_MATH_SSE)
+		inline Vec4(const Vec4& src) : v(src.v) {}
+#else
+		inline Vec4(const Vec4& src)
+			: x(src.x), y(src.y), z(src.z), w(src.w) {}
+#endif
+
 		/**
 		 * @brief Overloaded assignment operator for vector assignment.
 		 * @param src The source vector to copy from.
@@ -101,7 +134,11 @@ namespace Cat {
 		 * @return A negated copy of this vector.
 		 */
 		inline Vec4 operator-() const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_xor_ps(v, _mm_set1_ps(REAL(-0.0))));
+#else
 			return Vec4(-x, -y, -z, -w);
+#endif
 		}		
 		
 		/**
@@ -110,7 +147,11 @@ namespace Cat {
 		 * @return A new vector which is the sum of this + rhs.		 
 		 */
 		inline Vec4 operator+(const Vec4& rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_add_ps(v, rhs.v));
+#else
 			return Vec4(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+#endif
 		}
 
 		/**
@@ -119,10 +160,18 @@ namespace Cat {
 		 * @return A new vector with the scalar added.
 		 */
 		inline Vec4 operator+(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_add_ps(v, _mm_set1_ps(scalar)));
+#else
 			return Vec4(x + scalar, y + scalar, z + scalar, w + scalar);
+#endif
 		}
 		inline friend Vec4 operator+(const Real scalar, const Vec4& v) { 
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_add_ps(_mm_set1_ps(scalar), v.v));
+#else
 			return Vec4(scalar + v.x, scalar + v.y, scalar + v.z, scalar + v.w); 
+#endif
 		}
 		
 		/**
@@ -131,8 +180,13 @@ namespace Cat {
 		 * @return A reference to this vector.
 		 */
 		inline Vec4& operator+=(const Vec4& rhs) { 
+#if defined (CAT_MATH_SSE)
+			v = _mm_add_ps(v, rhs.v);
+			return *this;
+#else
 			x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w;			
 			return *this;			
+#endif
 		}
 
 		/**
@@ -151,7 +205,11 @@ namespace Cat {
 		 * @return A new vector which is the difference of this - rhs.		 
 		 */
 		inline Vec4 operator-(const Vec4& rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_sub_ps(v, rhs.v));
+#else
 			return Vec4(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+#endif
 		}
 
 		/**
@@ -160,10 +218,18 @@ namespace Cat {
 		 * @return A new vector with the scalar subtracted.
 		 */
 		inline Vec4 operator-(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_sub_ps(v, _mm_set1_ps(scalar)));
+#else
 			return Vec4(x - scalar, y - scalar, z - scalar, w - scalar);
+#endif
 		}
 		inline friend Vec4 operator-(const Real scalar, const Vec4& v) {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_sub_ps(_mm_set1_ps(scalar), v.v));
+#else
 			return Vec4(scalar - v.x, scalar - v.y, scalar - v.z, scalar - v.w);
+#endif
 		}
 		
 		/**
@@ -172,8 +238,13 @@ namespace Cat {
 		 * @return A reference to this vector.
 		 */
 		inline Vec4& operator-=(const Vec4& rhs) { 
+#if defined (CAT_MATH_SSE)
+			v = _mm_sub_ps(v, rhs.v);
+			return *this;
+#else
 			x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w;
 			return *this;			
+#endif
 		}
 
 		/**
@@ -192,10 +263,18 @@ namespace Cat {
 		 * @return A copy of the vector multiplied by the scalar.
 		 */
 		inline Vec4 operator*(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_mul_ps(v, _mm_set1_ps(scalar)));
+#else
 			return Vec4(x*scalar, y*scalar, z*scalar, w*scalar);
+#endif
 		}
 		inline friend Vec4 operator*(const Real scalar, const Vec4& v) {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_mul_ps(_mm_set1_ps(scalar), v.v));
+#else
 			return Vec4(scalar*v.x, scalar*v.y, scalar*v.z, scalar*v.w);
+#endif
 		}
 
 		/**
@@ -204,7 +283,11 @@ namespace Cat {
 		 * @return A copy of the vector multiplied by the other vector.
 		 */
 		inline Vec4 operator*(const Vec4& p_rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_mul_ps(v, p_rhs.v));
+#else
 			return Vec4(x*p_rhs.x, y*p_rhs.y, z*p_rhs.z, w*p_rhs.w);
+#endif
 		}
 		
 		/**
@@ -213,8 +296,13 @@ namespace Cat {
 		 * @return A reference to this vector.
 		 */
 		inline Vec4& operator*=(const Real scalar) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_mul_ps(v, _mm_set1_ps(scalar));
+			return *this;
+#else
 			x *= scalar; y *= scalar; z *= scalar; w *= scalar;
 			return *this;			
+#endif
 		}
 
 		/**
@@ -223,8 +311,13 @@ namespace Cat {
 		 * @return A reference to this vector.
 		 */
 		inline Vec4& operator*=(const Vec4& p_rhs) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_mul_ps(v, p_rhs.v);
+			return *this;
+#else
 			x *= p_rhs.x; y *= p_rhs.y; z *= p_rhs.z; w *= p_rhs.w;
 			return *this;			
+#endif
 		}
 		
 		/**
@@ -233,10 +326,18 @@ namespace Cat {
 		 * @return A copy of this vector scaled by the scalar value.
 		 */
 		inline Vec4 operator/(const Real scalar) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_div_ps(v, _mm_set1_ps(scalar)));
+#else
 			return Vec4(x/scalar, y/scalar, z/scalar, w/scalar);
+#endif
 		}
 		inline friend Vec4 operator/(const Real scalar, const Vec4& v) {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_div_ps(_mm_set1_ps(scalar), v.v));
+#else
 			return Vec4(scalar/v.x, scalar/v.y, scalar/v.z, scalar/v.w);
+#endif
 		}
 
 		/**
@@ -245,7 +346,11 @@ namespace Cat {
 		 * @return A copy of this vector multiplied by the other vector.
 		 */
 		inline Vec4 operator/(const Vec4& p_rhs) const {
+#if defined (CAT_MATH_SSE)
+			return Vec4(_mm_div_ps(v, p_rhs.v));
+#else
 			return Vec4(x/p_rhs.x, y/p_rhs.y, z/p_rhs.z, w/p_rhs.w);
+#endif
 		}
 		
 		/**
@@ -254,8 +359,13 @@ namespace Cat {
 		 * @return A reference to this vector.
 		 */
 		inline Vec4& operator/=(const Real scalar) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_div_ps(v, _mm_set1_ps(scalar));
+			return *this;
+#else
 			x /= scalar; y /= scalar; z /= scalar; w /= scalar;
 			return *this;
+#endif
 		}
 
 		/**
@@ -264,8 +374,13 @@ namespace Cat {
 		 * @return A reference to this vector.
 		 */
 		inline Vec4& operator/=(const Vec4& p_rhs) {
+#if defined (CAT_MATH_SSE)
+			v = _mm_div_ps(v, p_rhs.v);
+			return *this;
+#else
 			x /= p_rhs.x; y /= p_rhs.y; z /= p_rhs.z; w /= p_rhs.w;
 			return *this;
+#endif
 		}
 
 		// ###########
@@ -13,6 +13,7 @@
 #include "core/util/map.h"
 #include "core/util/vector.h"
 #include "core/signal/signalhandler.h"
+#include "core/string/internedstring.h"
 
 namespace Cat {
 
@@ -87,6 +88,17 @@ namespace Cat {
 			return connect(crc32(name), SignalHandler(func, obj));
 		}	
 
+		/**
+		 * @brief Connect a signal of this object to the specified handler.
+		 * @param name The interned name of the signal, so it is not rehashed.
+		 * @param handler The SignalHandler to attach to the Signal.
+		 * @return True if the SignalHandler was successfully attached.
+		 */
+		inline Boolean connect(const InternedString& name,
+									  const SignalHandler& handler) {
+			return connect(name.oID(), handler);
+		}
+
 		/**
 		 * @brief disconnect a signal of this object from the specified handler.
 		 * @param name The hashed name of the signal to detach the handler from.
@@ -150,6 +162,17 @@ namespace Cat {
 			return disconnect(crc32(signal));
 		}		
 
+		/**
+		 * @brief disconnect a signal of this object from the specified handler.
+		 * @param name The interned name of the signal, so it is not rehashed.
+		 * @param handler The SignalHandler to detach from the Signal.
+		 * @return True if the SignalHandler was successfully detached.
+		 */
+		inline Boolean disconnect(const InternedString& name,
+										  const SignalHandler& handler) {
+			return disconnect(name.oID(), handler);
+		}
+
 	
 	  protected:
 		/**
@@ -178,6 +201,14 @@ namespace Cat {
 			SignalData data(dataPtr, sender);
 			emit(crc32(name), data);
 		}
+
+		inline void emit(const InternedString& name, SignalData& data) {
+			emit(name.oID(), data);
+		}
+		inline void emit(const InternedString& name, void* sender) {
+			SignalData data(sender);
+			emit(name.oID(), data);
+		}
 		
 
 		Map< Vector<SignalHandler>* > m_signalMap;
@@ -0,0 +1,208 @@
+#ifndef CAT_CORE_STRING_HUNGRYBUFFER_H
+#define CAT_CORE_STRING_HUNGRYBUFFER_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file hungrybuffer.h
+ * @brief A reusable output buffer that is fed the parameters of a HungryTemplate.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/string/hungrytemplate.h"
+#include "core/string/string.h"
+#include "core/string/stringutils.h"
+
+namespace Cat {
+
+	/**
+	 * @class HungryBuffer hungrybuffer.h "core/string/hungrybuffer.h"
+	 * @brief A reusable output buffer that is fed the parameters of a HungryTemplate.
+	 *
+	 * The HungryBuffer is the fast counterpart to the HungryString.  Rather 
+	 * than copying and rescanning the format string, it walks the segment 
+	 * table of a shared HungryTemplate, and numbers are formatted straight 
+	 * into the output buffer.  Once full, the buffer can be reset() and fed 
+	 * again without any allocation.  For example:
+	 *
+	 *    HungryTemplate tmpl("/users/%/frame_%.png");
+	 *    HungryBuffer path(&tmpl, 256);
+	 *    path.feed("Meow").feed(42);   // "/users/Meow/frame_42.png"
+	 *
+	 * The HungryTemplate is NOT copied, and must outlive the HungryBuffer.
+	 * Parameters that would overflow maxLength() are truncated.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class HungryBuffer {
+	  public:
+		/**
+		 * @brief Create an empty HungryBuffer.
+		 */
+		HungryBuffer()
+			: m_pTemplate(NIL), m_pBuiltString(NIL), m_maxLength(0),
+			  m_remainingFeeds(0), m_currentSegment(0),
+			  m_currentBuildIdx(0), m_finished(false) {}
+
+		/**
+		 * @brief Initialize the HungryBuffer to feed a template.
+		 * @param pTemplate The (shared) template to build strings from.
+		 * @param maxLength The max length of the completed string (including null).
+		 */
+		HungryBuffer(const HungryTemplate* pTemplate, Size maxLength);
+
+		/**
+		 * @brief Copy constructor, shares the template and copies the buffer.
+		 * @param src The HungryBuffer to copy from.
+		 */
+		HungryBuffer(const HungryBuffer& src);
+
+		/**
+		 * @brief Destroys the output buffer (but not the template).
+		 */
+		~HungryBuffer();
+
+		/**
+		 * @brief Overloaded assignment operator.
+		 * @param src The HungryBuffer to copy from.
+		 */
+		HungryBuffer& operator=(const HungryBuffer& src);
+
+		/**
+		 * @brief Feed the next parameter a null-terminated c-string.
+		 * @param str The string to feed into the next available parameter.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		inline HungryBuffer& feed(const Char* str) {
+			return feed(str, StringUtils::length(str));
+		}
+
+		/**
+		 * @brief Feed the next parameter a string of known length.
+		 * @param str The (not necessarily null-terminated) string to feed.
+		 * @param length The number of characters in str.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		HungryBuffer& feed(const Char* str, Size length);
+
+		/**
+		 * @brief Feed the next parameter a String.
+		 * @param str The String to feed into the next available parameter.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		inline HungryBuffer& feed(const String& str) {
+			return feed(str.cStr(), str.length());
+		}
+
+		/**
+		 * @brief Feed the next parameter a signed integer.
+		 * @param value The value to format into the next parameter.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		HungryBuffer& feed(I32 value);
+
+		/**
+		 * @brief Feed the next parameter an unsigned integer.
+		 * @param value The value to format into the next parameter.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		HungryBuffer& feed(U32 value);
+
+		/**
+		 * @brief Feed the next parameter a signed 64 bit integer.
+		 * @param value The value to format into the next parameter.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		HungryBuffer& feed(I64 value);
+
+		/**
+		 * @brief Feed the next parameter an unsigned 64 bit integer.
+		 * @param value The value to format into the next parameter.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		HungryBuffer& feed(U64 value);
+
+		/**
+		 * @brief Feed the next parameter a floating point value.
+		 * @param value The value to format into the next parameter.
+		 * @param precision The max number of fractional digits to output.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 * @see StringUtils::formatF64()
+		 */
+		HungryBuffer& feed(F64 value, U32 precision = 6);
+
+		/**
+		 * @brief Get the template the buffer is built from.
+		 * @return The template the buffer is built from.
+		 */
+		inline const HungryTemplate* getTemplate() const { return m_pTemplate; }
+
+		/**
+		 * @brief Check to see if the buffer is full.
+		 * @return False if the buffer can accept any more parameters.
+		 */
+		inline Boolean isFull() const { return m_finished; }
+
+		/**
+		 * @brief Get the current length of the built string.
+		 * @return The number of characters written so far.
+		 */
+		inline Size length() const { return m_currentBuildIdx; }
+
+		/**
+		 * @brief Get the maximum length the finished string can be.
+		 * @return The max length of the finished string.
+		 */
+		inline Size maxLength() const { return m_maxLength; }
+
+		/**
+		 * @brief Get the number of feedings remaining.
+		 * @return The number of remaining Feedings.
+		 */
+		inline Size remainingFeeds() const { return m_remainingFeeds; }
+
+		/**
+		 * @brief Forget all the fed parameters so the buffer can be refilled.
+		 * @return A reference to the HungryBuffer so we can chain feedings.
+		 */
+		HungryBuffer& reset();
+
+		/**
+		 * @brief Get the built string, or NIL if not finished yet.
+		 * @return The finished string or NIL if not finished yet.
+		 */
+		inline const Char* cStr() const {
+			if (isFull()) {
+				return m_pBuiltString;
+			}
+			else {
+				return NIL;
+			}
+		}
+
+	  private:
+		/**
+		 * @brief Copy as much of the string as fits into the buffer.
+		 */
+		void append(const Char* str, Size length);
+
+		/**
+		 * @brief Write a parameter and the literal segment following it.
+		 */
+		void writeParam(const Char* str, Size length);
+
+		const HungryTemplate* m_pTemplate;
+		Char* m_pBuiltString;
+		Size m_maxLength;
+		Size m_remainingFeeds;
+		Size m_currentSegment;
+		Size m_currentBuildIdx;
+		Boolean m_finished;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_HUNGRYBUFFER_H
@@ -0,0 +1,143 @@
+#ifndef CAT_CORE_STRING_HUNGRYTEMPLATE_H
+#define CAT_CORE_STRING_HUNGRYTEMPLATE_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file hungrytemplate.h
+ * @brief A precompiled HungryString format string.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @class HungryTemplate hungrytemplate.h "core/string/hungrytemplate.h"
+	 * @brief A precompiled HungryString format string.
+	 *
+	 * The HungryTemplate parses a HungryString style format string (where 
+	 * "%" marks a parameter and "%%" is a literal "%") exactly once, into a 
+	 * table of literal segments.  The template is never modified after it is
+	 * created, so a single HungryTemplate can be shared by any number of 
+	 * HungryBuffers on any number of threads without locking.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class HungryTemplate {
+	  public:
+		/**
+		 * @brief A literal run of text between two parameters.
+		 */
+		struct Segment {
+			Size offset;
+			Size length;
+		};
+
+		/**
+		 * @brief Create an empty HungryTemplate.
+		 */
+		HungryTemplate()
+			: m_pString(NIL), m_pText(NIL), m_pSegments(NIL),
+			  m_numParams(0), m_literalLength(0) {}
+
+		/**
+		 * @brief Parse the format string into a new HungryTemplate.
+		 * @param string The base string with the parameters to replace.
+		 */
+		explicit HungryTemplate(const Char* string);
+
+		/**
+		 * @brief Copy constructor.
+		 * @param src The HungryTemplate to copy from.
+		 */
+		HungryTemplate(const HungryTemplate& src);
+
+		/**
+		 * @brief Destroys the HungryTemplate and the memory associated with it.
+		 */
+		~HungryTemplate();
+
+		/**
+		 * @brief Overloaded assignment operator.
+		 * @param src The HungryTemplate to copy from.
+		 */
+		HungryTemplate& operator=(const HungryTemplate& src);
+
+		/**
+		 * @brief Get the unparsed format string.
+		 * @return The base string, or NIL if the template is empty.
+		 */
+		inline const Char* baseString() const { return m_pString; }
+
+		/**
+		 * @brief Check to see if the template holds a format string.
+		 * @return True if there is no format string.
+		 */
+		inline Boolean isEmpty() const { return m_pString == NIL; }
+
+		/**
+		 * @brief Get the total length of all the literal segments.
+		 * @return The length of the string with every parameter empty.
+		 */
+		inline Size literalLength() const { return m_literalLength; }
+
+		/**
+		 * @brief Get the number of parameters in the template.
+		 * @return The number of parameters to be fed.
+		 */
+		inline Size numParams() const { return m_numParams; }
+
+		/**
+		 * @brief Get the number of literal segments (always numParams() + 1).
+		 * @return The number of literal segments, or 0 if empty.
+		 */
+		inline Size numSegments() const {
+			return m_pSegments ? (m_numParams + 1) : 0;
+		}
+
+		/**
+		 * @brief Get the length of a literal segment.
+		 * @param idx The index of the segment.
+		 * @return The length of the segment (may be 0).
+		 */
+		inline Size segmentLength(Size idx) const {
+			D_CONDERR((idx > m_numParams), "Segment " << idx << " out of range!");
+			return m_pSegments[idx].length;
+		}
+
+		/**
+		 * @brief Get the (not null-terminated) text of a literal segment.
+		 * @param idx The index of the segment.
+		 * @return A pointer to the first character in the segment.
+		 */
+		inline const Char* segmentText(Size idx) const {
+			D_CONDERR((idx > m_numParams), "Segment " << idx << " out of range!");
+			return &(m_pText[m_pSegments[idx].offset]);
+		}
+
+	  private:
+		/**
+		 * @brief Parse m_pString into the segment table.
+		 */
+		void compile();
+
+		/**
+		 * @brief Free all the memory held by the template.
+		 */
+		void clear();
+
+		Char* m_pString;
+		Char* m_pText;
+		Segment* m_pSegments;
+		Size m_numParams;
+		Size m_literalLength;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_HUNGRYTEMPLATE_H
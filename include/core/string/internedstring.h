@@ -0,0 +1,193 @@
+#ifndef CAT_CORE_STRING_INTERNEDSTRING_H
+#define CAT_CORE_STRING_INTERNEDSTRING_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file internedstring.h
+ * @brief A handle to a string stored once in the global string table.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @brief A single string stored in the StringInterner arena.
+	 * The text is null terminated and follows the header directly.
+	 */
+	struct InternEntry {
+		OID  oid;
+		Size length;
+		Char text[1];
+	};
+
+	/**
+	 * @class InternedString internedstring.h "core/string/internedstring.h"
+	 * @brief A handle to a string stored once in the global string table.
+	 *
+	 * Every distinct string is stored exactly once process-wide, so two 
+	 * InternedStrings are equal if, and only if, they point to the same 
+	 * entry.  The OID of the string (the crc32 hash of the string) is computed
+	 * once when the string is first interned, so it is compatible with all 
+	 * the containers keyed with crc32(name).  Interned strings are never freed.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class InternedString {
+	  public:
+		/**
+		 * @brief Create a null InternedString.
+		 */
+		InternedString() : m_pEntry(NIL) {}
+
+		/**
+		 * @brief Intern the string and create a handle to it.
+		 * @param str The null terminated string to intern.
+		 */
+		explicit InternedString(const Char* str);
+
+		/**
+		 * @brief Intern the first length characters of the string.
+		 * @param str The string to intern.
+		 * @param length The number of characters to intern.
+		 */
+		InternedString(const Char* str, Size length);
+
+		/**
+		 * @brief Create a handle to an existing entry.
+		 * @param entry The entry in the string table.
+		 */
+		explicit InternedString(const InternEntry* entry) : m_pEntry(entry) {}
+
+		/**
+		 * @brief Get the interned text.
+		 * @return The null terminated string, or NIL if the handle is null.
+		 */
+		inline const Char* cStr() const {
+			return m_pEntry ? m_pEntry->text : NIL;
+		}
+
+		/**
+		 * @brief Get the entry in the string table.
+		 * @return The entry, or NIL if the handle is null.
+		 */
+		inline const InternEntry* entry() const { return m_pEntry; }		
+
+		/**
+		 * @brief Check to see if the handle refers to any string.
+		 * @return True if the handle is null.
+		 */
+		inline Boolean isNull() const { return m_pEntry == NIL; }		
+
+		/**
+		 * @brief Get the length of the interned string.
+		 * @return The length of the string, or 0 if the handle is null.
+		 */
+		inline Size length() const {
+			return m_pEntry ? m_pEntry->length : 0;
+		}
+
+		/**
+		 * @brief Get the OID (crc32 hash) of the interned string.
+		 * @return The OID of the string, or 0 if the handle is null.
+		 */
+		inline OID oID() const {
+			return m_pEntry ? m_pEntry->oid : 0;
+		}
+
+		/**
+		 * @brief Overloaded equality operator, a single pointer compare.
+		 * @param other The InternedString to compare to.
+		 * @return True if both handles refer to the same string.
+		 */
+		inline Boolean operator==(const InternedString& other) const {
+			return m_pEntry == other.m_pEntry;
+		}
+
+		/**
+		 * @brief Overloaded inequality operator, a single pointer compare.
+		 * @param other The InternedString to compare to.
+		 * @return True if the handles refer to different strings.
+		 */
+		inline Boolean operator!=(const InternedString& other) const {
+			return m_pEntry != other.m_pEntry;
+		}		
+
+	  private:
+		const InternEntry* m_pEntry;
+	};
+
+	/**
+	 * @class StringInterner internedstring.h "core/string/internedstring.h"
+	 * @brief The global, thread-safe string interning table.
+	 *
+	 * Strings are copied into large arena chunks which are never freed, and
+	 * indexed by an open addressing hash table keyed on the crc32 hash.  
+	 * Lookups of strings which have already been interned never take a 
+	 * lock; only the insertion of a new string does.  When the table grows, 
+	 * the new table is published atomically and the old one is retired 
+	 * (but kept alive) so concurrent readers remain valid.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class StringInterner {
+	  public:
+		/**
+		 * @brief Intern a string, adding it to the table if needed.
+		 * @param str The null terminated string to intern.
+		 * @return The handle to the interned string.
+		 */
+		static InternedString intern(const Char* str);
+
+		/**
+		 * @brief Intern the first length characters of a string.
+		 * @param str The string to intern.
+		 * @param length The number of characters to intern.
+		 * @return The handle to the interned string.
+		 */
+		static InternedString intern(const Char* str, Size length);
+
+		/**
+		 * @brief Look for a string without adding it to the table.
+		 * @param str The null terminated string to look for.
+		 * @return The handle to the string, or a null handle if not interned.
+		 */
+		static InternedString find(const Char* str);
+
+		/**
+		 * @brief Look for a string without adding it to the table.
+		 * @param str The string to look for.
+		 * @param length The number of characters in the string.
+		 * @return The handle to the string, or a null handle if not interned.
+		 */
+		static InternedString find(const Char* str, Size length);
+
+		/**
+		 * @brief Get the number of distinct strings interned.
+		 * @return The number of strings in the table.
+		 */
+		static Size numStrings();
+
+		/**
+		 * @brief Get the number of bytes allocated for arena chunks.
+		 * @return The total size of the arena.
+		 */
+		static Size arenaSize();		
+	};
+
+	inline InternedString::InternedString(const Char* str)
+		: m_pEntry(StringInterner::intern(str).m_pEntry) {}
+
+	inline InternedString::InternedString(const Char* str, Size length)
+		: m_pEntry(StringInterner::intern(str, length).m_pEntry) {}
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_INTERNEDSTRING_H
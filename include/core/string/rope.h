@@ -0,0 +1,276 @@
+#ifndef CAT_CORE_STRING_ROPE_H
+#define CAT_CORE_STRING_ROPE_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file rope.h
+ * @brief A string stored as a tree of shared pieces, for cheap edits of large text.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+#include "core/threading/atomic.h"
+#include "core/util/invasivestrongptr.h"
+#include "core/string/stringview.h"
+
+/* The maximum number of characters stored in a single leaf */
+#define CAT_ROPE_LEAF_SIZE 512
+/* A rope deeper than this is rebalanced */
+#define CAT_ROPE_MAX_DEPTH 48
+
+namespace Cat {
+
+	class OutputStream;
+
+	/**
+	 * @class RopeNode rope.h "core/string/rope.h"
+	 * @brief A node in a Rope, either a leaf of text or the join of two nodes.
+	 *
+	 * RopeNodes are never modified once created, so they can be shared
+	 * between any number of Ropes.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class RopeNode {
+	  public:
+		/**
+		 * @brief Create a leaf holding a copy of the text.
+		 * @param text The text to copy into the leaf.
+		 * @param length The number of characters in the text.
+		 */
+		RopeNode(const Char* text, Size length);
+
+		/**
+		 * @brief Create a leaf holding the text of two views.
+		 * @param first The first part of the text.
+		 * @param second The second part of the text.
+		 */
+		RopeNode(const StringView& first, const StringView& second);
+
+		/**
+		 * @brief Create a node joining two nodes.
+		 * @param left The node holding the first part of the text.
+		 * @param right The node holding the second part of the text.
+		 */
+		RopeNode(const InvasiveStrongPtr<RopeNode>& left,
+					const InvasiveStrongPtr<RopeNode>& right);
+
+		/**
+		 * @brief Deletes the text of a leaf.
+		 */
+		~RopeNode();
+
+		/**
+		 * @brief Get the depth of the node (a leaf has depth 0).
+		 * @return The depth of the tree below the node.
+		 */
+		inline U32 depth() const { return m_depth; }
+
+		/**
+		 * @brief Check to see if the node is a leaf of text.
+		 * @return True if the node is a leaf.
+		 */
+		inline Boolean isLeaf() const { return m_pText != NIL; }
+
+		/**
+		 * @brief Get the left node of a join.
+		 * @return The left node, null for a leaf.
+		 */
+		inline const InvasiveStrongPtr<RopeNode>& left() const { return m_pLeft; }
+
+		/**
+		 * @brief Get the number of characters below this node.
+		 * @return The length of the text.
+		 */
+		inline Size length() const { return m_length; }
+
+		/**
+		 * @brief Get the right node of a join.
+		 * @return The right node, null for a leaf.
+		 */
+		inline const InvasiveStrongPtr<RopeNode>& right() const { return m_pRight; }
+
+		/**
+		 * @brief Get a view of the text of a leaf.
+		 * @return The view of the text, empty if not a leaf.
+		 */
+		inline StringView text() const { return StringView(m_pText, m_pText ? m_length : 0); }
+
+		/**
+		 * @brief Increase the retain count by one.
+		 */
+		inline void retain() { m_retainCount.increment(); }
+
+		/**
+		 * @brief Decrement the retainCount by one.
+		 * @return True if there are no more references to the node.
+		 */
+		inline Boolean release() { return m_retainCount.decrement() <= 0; }
+
+		/**
+		 * @brief Get the retain count for the node.
+		 * @return The retain count for the node.
+		 */
+		inline I32 retainCount() const { return m_retainCount.val(); }
+
+	  private:
+		/* Not copyable */
+		RopeNode(const RopeNode& src);
+		RopeNode& operator=(const RopeNode& src);
+
+		Char*                       m_pText;
+		Size                        m_length;
+		U32                         m_depth;
+		InvasiveStrongPtr<RopeNode> m_pLeft;
+		InvasiveStrongPtr<RopeNode> m_pRight;
+		AtomicI32                   m_retainCount;
+	};
+
+	typedef InvasiveStrongPtr<RopeNode> RopeNodePtr;
+
+	/**
+	 * @class Rope rope.h "core/string/rope.h"
+	 * @brief A string stored as a tree of shared pieces, for cheap edits of large text.
+	 *
+	 * Inserting, erasing, or taking a sub rope of a large document only
+	 * creates O(log n) new nodes, and shares all the unchanged text with the
+	 * original.  Copying a Rope is O(1).  Text is stored in leaves of at
+	 * most CAT_ROPE_LEAF_SIZE characters, small appends are merged into the
+	 * last leaf, and the tree is rebalanced whenever it gets deeper than
+	 * CAT_ROPE_MAX_DEPTH.  The text can be written straight to an
+	 * OutputStream, leaf by leaf, without ever creating a single string.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Rope {
+	  public:
+		/**
+		 * @brief Create an empty Rope.
+		 */
+		Rope() {}
+
+		/**
+		 * @brief Create a Rope holding a copy of the text.
+		 * @param text The text to copy into the Rope.
+		 */
+		explicit Rope(const StringView& text);
+
+		/**
+		 * @brief Append a copy of the text to the end of the Rope.
+		 * @param text The text to append.
+		 * @return A reference to this Rope.
+		 */
+		Rope& append(const StringView& text);
+
+		/**
+		 * @brief Append another Rope, sharing its text.
+		 * @param rope The Rope to append.
+		 * @return A reference to this Rope.
+		 */
+		Rope& append(const Rope& rope);
+
+		/**
+		 * @brief Get the character at the specified index.
+		 * @param idx The index of the character, which must be < length().
+		 * @return The character at idx.
+		 */
+		Char charAt(Size idx) const;
+
+		/**
+		 * @brief Copy the text into a buffer and null terminate it.
+		 * @param dest The buffer, which must hold at least length() + 1 characters.
+		 */
+		void copyTo(Char* dest) const;
+
+		/**
+		 * @brief Get the depth of the tree.
+		 * @return The depth of the tree (0 for a single leaf).
+		 */
+		inline U32 depth() const { return m_pRoot.isNull() ? 0 : m_pRoot->depth(); }
+
+		/**
+		 * @brief Remove a range of characters.
+		 * @param pos The index of the first character to remove.
+		 * @param length The number of characters to remove (clamped to the end).
+		 * @return A reference to this Rope.
+		 */
+		Rope& erase(Size pos, Size length);
+
+		/**
+		 * @brief Insert a copy of the text at the specified index.
+		 * @param pos The index to insert at (clamped to the end).
+		 * @param text The text to insert.
+		 * @return A reference to this Rope.
+		 */
+		inline Rope& insert(Size pos, const StringView& text) {
+			return insert(pos, Rope(text));
+		}
+
+		/**
+		 * @brief Insert another Rope at the specified index, sharing its text.
+		 * @param pos The index to insert at (clamped to the end).
+		 * @param rope The Rope to insert.
+		 * @return A reference to this Rope.
+		 */
+		Rope& insert(Size pos, const Rope& rope);
+
+		/**
+		 * @brief Check to see if the Rope has no text.
+		 * @return True if the Rope is empty.
+		 */
+		inline Boolean isEmpty() const { return m_pRoot.isNull(); }
+
+		/**
+		 * @brief Get the number of characters in the Rope.
+		 * @return The length of the text.
+		 */
+		inline Size length() const { return m_pRoot.isNull() ? 0 : m_pRoot->length(); }
+
+		/**
+		 * @brief Rebuild the tree so that it is perfectly balanced.
+		 */
+		void rebalance();
+
+		/**
+		 * @brief Get the root node of the tree.
+		 * @return The root node, null if the Rope is empty.
+		 */
+		inline const RopeNodePtr& root() const { return m_pRoot; }
+
+		/**
+		 * @brief Get a Rope of part of this Rope, sharing its text.
+		 * @param pos The index of the first character.
+		 * @param length The number of characters (clamped to the end).
+		 * @return The sub Rope.
+		 */
+		Rope sub(Size pos, Size length) const;
+
+		/**
+		 * @brief Copy the text into a new null terminated string.
+		 * The string must be freed with StringUtils::free().
+		 * @return The new string.
+		 */
+		Char* toCString() const;
+
+		/**
+		 * @brief Write the text to a stream, leaf by leaf.
+		 * @param out The stream to write the text to.
+		 * @return The number of characters written.
+		 */
+		Size writeTo(OutputStream& out) const;
+
+	  private:
+		explicit Rope(const RopeNodePtr& root) : m_pRoot(root) {}
+
+		RopeNodePtr m_pRoot;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_ROPE_H
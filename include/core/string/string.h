@@ -13,6 +13,7 @@
 #include <cstring>
 #include "core/threading/atomic.h"
 #include "core/util/invasivestrongptr.h"
+#include "core/string/stringview.h"
 
 namespace Cat {
 	
@@ -42,6 +43,16 @@ namespace Cat {
 			memcpy(m_pString, str, sizeof(Char)*(m_length + 1));
 		}
 
+		/**
+		 * @brief Create a new String from a copy of the characters in a view.
+		 * @param str The view of the characters to copy.
+		 */
+		explicit String(const StringView& str) : m_pString(NIL), m_length(0) {
+			m_length = str.length();
+			m_pString = new Char[m_length + 1];
+			str.copyTo(m_pString);
+		}
+
 		/**
 		 * @brief Create a new String from a single Character.
 		 * @param chr The Character to create the string from.
@@ -112,6 +123,15 @@ namespace Cat {
 						 strcmp(m_pString, other) == 0) );
 		}
 
+		/**
+		 * @brief String equality operator.
+		 * @param other The view to compare this String to.
+		 * @return True if the String holds the same characters as the view.
+		 */
+		inline Boolean operator==(const StringView& other) const {
+			return view().equals(other);
+		}
+
 		/**
 		 * @brief String character equality operator.
 		 * @param other The character to compare this String to.
@@ -250,6 +270,12 @@ namespace Cat {
 		 */
 		inline Boolean isEmpty() const { return m_length == 0; }		
 
+		/**
+		 * @brief Get the OID (crc32 hash) of the String.
+		 * @return The OID of the String.
+		 */
+		inline OID oID() const { return view().oID(); }		
+
 		/**
 		 * @brief Get the length of the String.
 		 * @return The length of the String.
@@ -286,6 +312,13 @@ namespace Cat {
 		 */
 		void store(Char* str, I32 length = -1);			
 
+		/**
+		 * @brief Get a view of the String's characters.
+		 * The view is only valid as long as the String is not changed.
+		 * @return The StringView of the String.
+		 */
+		inline StringView view() const { return StringView(m_pString, m_length); }
+
 		/**
 		 * @brief Static method to create a StringPtr from an empty String.
 		 * @return The StringPtr containing the null string.
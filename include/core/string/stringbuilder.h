@@ -0,0 +1,261 @@
+#ifndef CAT_CORE_STRING_STRINGBUILDER_H
+#define CAT_CORE_STRING_STRINGBUILDER_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file stringbuilder.h
+ * @brief Builds up a large string in chunks, without copying what is there.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+#include "core/string/string.h"
+#include "core/string/stringview.h"
+
+/* The capacity of the first chunk if none is given */
+#define CAT_STRING_BUILDER_DEFAULT_CAPACITY 256
+/* Chunks double in size up to this capacity */
+#define CAT_STRING_BUILDER_MAX_CHUNK_CAPACITY 65536
+
+namespace Cat {
+
+	class OutputStream;
+
+	/**
+	 * @class StringBuilder stringbuilder.h "core/string/stringbuilder.h"
+	 * @brief Builds up a large string in chunks, without copying what is there.
+	 *
+	 * Appending to a String or using StringUtils::concat() copies both sides
+	 * into a new buffer every time, so building a string piece by piece is
+	 * quadratic.  The StringBuilder instead appends into a chain of chunks
+	 * which double in size (up to CAT_STRING_BUILDER_MAX_CHUNK_CAPACITY), so
+	 * text is never moved once written.  Numbers are formatted directly into
+	 * the chunk.  The result is produced with exactly one allocation by
+	 * toCString() / toString(), or written straight to an OutputStream.
+	 *
+	 * clear() keeps all the chunks, so a builder can be reused without
+	 * allocating again.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class StringBuilder {
+	  public:
+		/**
+		 * @brief Create an empty StringBuilder.
+		 * @param initialCapacity The capacity of the first chunk.
+		 */
+		explicit StringBuilder(Size initialCapacity = CAT_STRING_BUILDER_DEFAULT_CAPACITY);
+
+		/**
+		 * @brief Frees all the chunks.
+		 */
+		~StringBuilder();
+
+		/**
+		 * @brief Append a null terminated string.
+		 * @param str The string to append (NIL appends nothing).
+		 * @return A reference to this StringBuilder.
+		 */
+		inline StringBuilder& append(const Char* str) {
+			return append(StringView(str));
+		}
+
+		/**
+		 * @brief Append the first length characters of a string.
+		 * @param str The string to append.
+		 * @param length The number of characters to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		inline StringBuilder& append(const Char* str, Size length) {
+			return append(StringView(str, length));
+		}
+
+		/**
+		 * @brief Append the characters in a view.
+		 * @param str The view of the characters to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		StringBuilder& append(const StringView& str);
+
+		/**
+		 * @brief Append a String.
+		 * @param str The String to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		inline StringBuilder& append(const String& str) {
+			return append(str.view());
+		}
+
+		/**
+		 * @brief Append a single character.
+		 * @param chr The character to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		inline StringBuilder& append(Char chr) {
+			*reserve(1) = chr;
+			++m_pLast->used;
+			++m_length;
+			return *this;
+		}
+
+		/**
+		 * @brief Append a character a number of times.
+		 * @param chr The character to append.
+		 * @param count The number of times to append it.
+		 * @return A reference to this StringBuilder.
+		 */
+		StringBuilder& append(Char chr, Size count);
+
+		/**
+		 * @brief Append the decimal representation of an integer.
+		 * @param value The value to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		inline StringBuilder& append(I32 value) { return append((I64)value); }
+
+		/**
+		 * @brief Append the decimal representation of an integer.
+		 * @param value The value to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		inline StringBuilder& append(U32 value) { return append((U64)value); }
+
+		/**
+		 * @brief Append the decimal representation of an integer.
+		 * @param value The value to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		StringBuilder& append(I64 value);
+
+		/**
+		 * @brief Append the decimal representation of an integer.
+		 * @param value The value to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		StringBuilder& append(U64 value);
+
+		/**
+		 * @brief Append a fixed precision representation of a floating point value.
+		 * @see StringUtils::formatF64()
+		 * @param value The value to append.
+		 * @param precision The maximum number of digits after the decimal point.
+		 * @return A reference to this StringBuilder.
+		 */
+		StringBuilder& append(F64 value, U32 precision = 6);
+
+		/**
+		 * @brief Remove all the text, but keep the chunks to reuse.
+		 */
+		void clear();
+
+		/**
+		 * @brief Copy the text into a buffer and null terminate it.
+		 * @param dest The buffer, which must hold at least length() + 1 characters.
+		 */
+		void copyTo(Char* dest) const;
+
+		/**
+		 * @brief Check to see if any text has been appended.
+		 * @return True if the StringBuilder is empty.
+		 */
+		inline Boolean isEmpty() const { return m_length == 0; }
+
+		/**
+		 * @brief Get the number of characters appended.
+		 * @return The length of the text.
+		 */
+		inline Size length() const { return m_length; }
+
+		/**
+		 * @brief Get the number of chunks the text is stored in.
+		 * @return The number of chunks allocated.
+		 */
+		inline Size numChunks() const { return m_numChunks; }
+
+		/**
+		 * @brief Copy the text into a single new null terminated string.
+		 * The string must be freed with StringUtils::free().
+		 * @return The new string.
+		 */
+		Char* toCString() const;
+
+		/**
+		 * @brief Store a copy of the text into a String, with a single allocation.
+		 * @param dest The String to store the text in.
+		 */
+		void toString(String& dest) const;
+
+		/**
+		 * @brief Create a new StringPtr holding a copy of the text.
+		 * @return The new StringPtr.
+		 */
+		inline StringPtr toString() const {
+			StringPtr str = String::create();
+			toString(*str);
+			return str;
+		}
+
+		/**
+		 * @brief Write the text to a stream, chunk by chunk.
+		 * @param out The stream to write the text to.
+		 * @return The number of characters written.
+		 */
+		Size writeTo(OutputStream& out) const;
+
+		/**
+		 * @brief Chaining append operator.
+		 * @param value The value to append.
+		 * @return A reference to this StringBuilder.
+		 */
+		template<typename T>
+		inline StringBuilder& operator<<(const T& value) {
+			return append(value);
+		}
+
+	  private:
+		struct Chunk {
+			Chunk* pNext;
+			Size   used;
+			Size   capacity;
+
+			inline Char* text() { return (Char*)(this + 1); }
+			inline const Char* text() const { return (const Char*)(this + 1); }
+		};
+
+		/* Not copyable */
+		StringBuilder(const StringBuilder& src);
+		StringBuilder& operator=(const StringBuilder& src);
+
+		/**
+		 * @brief Get space for count characters in the last chunk.
+		 * @param count The number of characters needed (must fit in one chunk).
+		 * @return A pointer to the free space.
+		 */
+		inline Char* reserve(Size count) {
+			if (!m_pLast || m_pLast->capacity - m_pLast->used < count) {
+				nextChunk(count);
+			}
+			return m_pLast->text() + m_pLast->used;
+		}
+
+		/**
+		 * @brief Move to the next chunk with space for at least count characters.
+		 * Reuses chunks kept by clear(), or allocates a new one.
+		 * @param count The number of characters needed.
+		 */
+		void nextChunk(Size count);
+
+		Chunk* m_pFirst;
+		Chunk* m_pLast;
+		Size   m_length;
+		Size   m_numChunks;
+		Size   m_nextCapacity;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_STRINGBUILDER_H
@@ -0,0 +1,114 @@
+#ifndef CAT_CORE_STRING_STRINGKERNELS_H
+#define CAT_CORE_STRING_STRINGKERNELS_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file stringkernels.h
+ * @brief The vectorised (SSE2 / AVX2) string kernels used by StringUtils.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @class StringKernels stringkernels.h "core/string/stringkernels.h"
+	 * @brief The vectorised (SSE2 / AVX2) string kernels used by StringUtils.
+	 *
+	 * The kernels are grouped into tables of function pointers, one per 
+	 * instruction set.  The best table for the running CPU is selected once, 
+	 * on first use.  The scalar table is always available, and is what the 
+	 * vector kernels are tested against.  None of the kernels check for NIL 
+	 * strings, that is left to StringUtils.
+	 *
+	 * The null-terminated kernels (length16, find16) only ever read whole, 
+	 * aligned vectors, so they never cross into a page the string does not 
+	 * touch, and require the string to be 2-byte aligned (as any U16 array is).
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class StringKernels {
+	  public:
+		struct Table {
+			/**
+			 * @brief Get the length of a null-terminated unicode string.
+			 */
+			Size (*length16)(const U16* str);
+
+			/**
+			 * @brief Find the first ch or null in a null-terminated unicode string.
+			 * @return A pointer to the first ch, or NIL if the null came first.
+			 */
+			const U16* (*find16)(const U16* str, U16 ch);
+
+			/**
+			 * @brief Find the last ch in the first length characters of str.
+			 * @return A pointer to the last ch, or NIL if not found.
+			 */
+			const U16* (*findLast16)(const U16* str, Size length, U16 ch);
+
+			/**
+			 * @brief Find the first substring needle in the haystack.
+			 * @return A pointer to the first occurance, or NIL if not found.
+			 */
+			const U16* (*findSub16)(const U16* haystack, Size haystackLength,
+											const U16* needle, Size needleLength);
+
+			/**
+			 * @brief Find the index of the first differing character.
+			 * @return The index of the first difference, or length if none.
+			 */
+			Size (*mismatch16)(const U16* str1, const U16* str2, Size length);
+
+			/**
+			 * @brief Compare length characters of two strings, ignoring ascii case.
+			 * @return True if the strings are equal, ignoring ascii case.
+			 */
+			Boolean (*equalsIgnoreCase)(const Char* str1, const Char* str2, Size length);
+
+			/**
+			 * @brief The name of the instruction set the table is for.
+			 */
+			const Char* name;
+		};
+
+		/**
+		 * @brief Get the fastest table of kernels for the running CPU.
+		 * @return The selected table of kernels.
+		 */
+		static const Table& table();
+
+		/**
+		 * @brief Get the scalar, reference implementation of the kernels.
+		 * @return The scalar table of kernels.
+		 */
+		static const Table& scalarTable();
+
+		/**
+		 * @brief The most tables of kernels there can be, one per instruction set.
+		 */
+		static const Size kMaxTables = 3;
+
+		/**
+		 * @brief Get every table of kernels the running CPU supports, fastest
+		 * first, so the first is table() and the last is scalarTable().
+		 * @param tables The array of kMaxTables to store the tables in.
+		 * @return The number of tables stored.
+		 */
+		static Size supportedTables(const Table** tables);
+
+	  private:
+		/**
+		 * @brief Choose the best table for the running CPU.
+		 */
+		static const Table* selectTable();
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_STRINGKERNELS_H
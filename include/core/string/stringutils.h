@@ -11,8 +11,14 @@
  */
 
 #include "core/corelib.h"
+#include "core/string/stringkernels.h"
+#include "core/string/stringview.h"
 #include <cstring>
 
+#define CAT_MAX_U64_STRING_LENGTH 20
+#define CAT_MAX_I64_STRING_LENGTH 21
+#define CAT_MAX_F64_STRING_LENGTH 32
+
 namespace Cat {
 	
 	/**
@@ -56,6 +62,15 @@ namespace Cat {
 		 */
 		static U16* copy(const U16* str);		
 
+		/**
+		 * @brief Copy a StringView into a new null-terminated string.
+		 * @param str The view of the characters to copy.
+		 * @return The newly allocated copy.
+		 */
+		static inline Char* copy(const StringView& str) {
+			return str.copy();
+		}
+
 		/**
 		 * @brief Create a new c-string with space for a null-terminating char.
 		 * @param length The length of the string to create (w/o null-terminating char).
@@ -92,7 +107,57 @@ namespace Cat {
 		 * @return True if the two strings are equal, false if not equal, 
 		 * or one or boht of the strings are null.
 		 */
-		static Boolean equals(const U16* str1, const U16* str2);		
+		static Boolean equals(const U16* str1, const U16* str2);
+
+		/**
+		 * @brief Tests to see if two StringViews hold the same characters.
+		 * @param str1 The first view to compare.
+		 * @param str2 The second view to compare.
+		 * @return True if the two views are equal.
+		 */
+		static inline Boolean equals(const StringView& str1, const StringView& str2) {
+			return str1.equals(str2);
+		}
+
+		/**
+		 * @brief Tests to see if two unicode strings of known length are equal.
+		 * @param str1 The first unicode string to compare.
+		 * @param str2 The second unicode string to compare.
+		 * @param length The number of characters to compare.
+		 * @return True if the first length characters of the strings are equal.
+		 */
+		static inline Boolean equals(const U16* str1, const U16* str2, Size length) {
+			return StringKernels::table().mismatch16(str1, str2, length) == length;
+		}
+
+		/**
+		 * @brief Lexicographically compare two unicode strings.
+		 * @param str1 The first null-terminated unicode string to compare.
+		 * @param str2 The second null-terminated unicode string to compare.
+		 * @return < 0 if str1 comes first, 0 if equal, > 0 if str2 comes first.
+		 * NIL strings are ordered before all others.
+		 */
+		static I32 compare(const U16* str1, const U16* str2);
+
+		/**
+		 * @brief Tests to see if two strings are equal, ignoring ascii case.
+		 * @param str1 The first null-terminated cstring to compare.
+		 * @param str2 The second null-terminated cstring to compare.
+		 * @return True if the two strings are equal (ignoring case), false 
+		 * if not equal, or one or both of the strings are null.
+		 */
+		static Boolean equalsIgnoreCase(const Char* str1, const Char* str2);
+
+		/**
+		 * @brief Tests to see if two strings of known length are equal, ignoring ascii case.
+		 * @param str1 The first cstring to compare.
+		 * @param str2 The second cstring to compare.
+		 * @param length The number of characters to compare.
+		 * @return True if the first length characters are equal (ignoring case).
+		 */
+		static inline Boolean equalsIgnoreCase(const Char* str1, const Char* str2, Size length) {
+			return StringKernels::table().equalsIgnoreCase(str1, str2, length);
+		}
 
 		/**
 		 * @brief Find a substring in another string and return a pointer to its location.
@@ -120,6 +185,24 @@ namespace Cat {
 			return strchr(haystack, needle);
 		}
 
+		/**
+		 * @brief Find the first occurance of a unicode character in a unicode string.
+		 * @param haystack The null-terminated unicode string to search inside.
+		 * @param needle The unicode character to search for.
+		 * @return A pointer to the first occurance of needle in haystack or NIL if none.
+		 */
+		static inline const U16* find(const U16* haystack, U16 needle) {
+			return haystack ? StringKernels::table().find16(haystack, needle) : NIL;
+		}
+
+		/**
+		 * @brief Find a unicode substring in another unicode string.
+		 * @param haystack The null-terminated unicode string to search inside.
+		 * @param needle The null-terminated unicode substring to search for.
+		 * @return A pointer to the first occurance of the substring or NIL if not found.
+		 */
+		static const U16* find(const U16* haystack, const U16* needle);
+
 		/**
 		 * @brief Find the last occurance of a character in another string.
 		 * @param haystack The string to search inside.
@@ -133,6 +216,16 @@ namespace Cat {
 			return strrchr(haystack, needle);
 		}
 
+		/**
+		 * @brief Find the last occurance of a unicode character in a unicode string.
+		 * @param haystack The null-terminated unicode string to search inside.
+		 * @param needle The unicode character to search for.
+		 * @return A pointer to the last occurance of needle in haystack or NIL if none.
+		 */
+		static inline const U16* findLast(const U16* haystack, U16 needle) {
+			return haystack ? StringKernels::table().findLast16(haystack, length(haystack), needle) : NIL;
+		}
+
 		/**
 		 * @brief Null-safe deletion of a c-string.
 		 * @param str The string to delete.
@@ -189,6 +282,42 @@ namespace Cat {
 			else { return -1; }
 		}	
 
+		/**
+		 * @brief Get the index of the first occurance of a unicode substring.
+		 * @param haystack The unicode string to search in.
+		 * @param needle The unicode substring to search for.
+		 * @return The index of the first occurance of the substring or -1 if not found.
+		 */
+		static inline I32 indexOf(const U16* haystack, const U16* needle) {
+			const U16* occurance = StringUtils::find(haystack, needle);
+			if (occurance) { return (I32)(occurance - haystack); }
+			else { return -1; }
+		}
+
+		/**
+		 * @brief Get the index of the first occurance of a unicode character.
+		 * @param haystack The unicode string to search in.
+		 * @param needle The unicode character to search for.
+		 * @return The index of the first occurance of the character or -1 if not found.
+		 */
+		static inline I32 indexOf(const U16* haystack, U16 needle) {
+			const U16* occurance = StringUtils::find(haystack, needle);
+			if (occurance) { return (I32)(occurance - haystack); }
+			else { return -1; }
+		}
+
+		/**
+		 * @brief Get the index of the last occurance of a unicode character.
+		 * @param haystack The unicode string to search in.
+		 * @param needle The unicode character to search for.
+		 * @return The index of the last occurance of the character or -1 if not found.
+		 */
+		static inline I32 lastIndexOf(const U16* haystack, U16 needle) {
+			const U16* occurance = StringUtils::findLast(haystack, needle);
+			if (occurance) { return (I32)(occurance - haystack); }
+			else { return -1; }
+		}
+
 		/**
 		 * @brief Get the length of a null-terminated c-string.
 		 * @param str The null-terminated c-string to get the length of.
@@ -204,7 +333,34 @@ namespace Cat {
 		 * @param str The null-terminated unicode c-string to get the length.
 		 * @return The length of the null-terminated unicode string.
 		 */
-		static Size length(const U16* str);		
+		static inline Size length(const U16* str) {
+			if (str) { return StringKernels::table().length16(str); }
+			else { return 0; }
+		}
+
+		/**
+		 * @brief Test to see if a string starts with a prefix.
+		 * @param str The null-terminated c-string to test.
+		 * @param prefix The null-terminated prefix to look for.
+		 * @return True if str begins with prefix.
+		 */
+		static inline Boolean startsWith(const Char* str, const Char* prefix) {
+			if (!str || !prefix) { return false; }
+			while (*prefix != '\0') {
+				if (*str++ != *prefix++) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Test to see if a StringView starts with a prefix.
+		 * @param str The view to test.
+		 * @param prefix The prefix to look for.
+		 * @return True if str begins with prefix.
+		 */
+		static inline Boolean startsWith(const StringView& str, const StringView& prefix) {
+			return str.startsWith(prefix);
+		}
 
 		/**
 		 * @brief Copy all of another string into the start of a string.
@@ -238,6 +394,69 @@ namespace Cat {
 			memcpy(&(dest[destStart]), src, sizeof(Char)*srcLength);
 		}
 
+		/**
+		 * @brief Copy a StringView into a string (NOT null-terminated).
+		 * @param dest The destination string.
+		 * @param src The view of the characters to copy.
+		 * @param destStart The index to copy the characters into.
+		 */
+		static inline void sub(Char* dest, const StringView& src, Size destStart) {
+			memcpy(&(dest[destStart]), src.data(), sizeof(Char)*src.length());
+		}
+
+		/**
+		 * @brief Get a view of part of a string, without copying it.
+		 * @param str The null-terminated string.
+		 * @param start The index of the first character.
+		 * @param length The maximum number of characters in the view.
+		 * @return The view of the substring.
+		 */
+		static inline StringView view(const Char* str, Size start, Size length = (Size)-1) {
+			return StringView(str).sub(start, length);
+		}
+
+		/**
+		 * @brief Write the decimal representation of an unsigned integer.
+		 * The output is NOT null-terminated, dest must have space for at
+		 * least CAT_MAX_U64_STRING_LENGTH characters.
+		 * @param dest The buffer to write the digits into.
+		 * @param value The value to format.
+		 * @return The number of characters written.
+		 */
+		static Size formatU64(Char* dest, U64 value);
+
+		/**
+		 * @brief Write the decimal representation of a signed integer.
+		 * The output is NOT null-terminated, dest must have space for at
+		 * least CAT_MAX_I64_STRING_LENGTH characters.
+		 * @param dest The buffer to write the digits into.
+		 * @param value The value to format.
+		 * @return The number of characters written.
+		 */
+		static Size formatI64(Char* dest, I64 value);
+
+		/**
+		 * @brief Write the decimal representation of a signed 32 bit integer.
+		 * @see formatI64()
+		 */
+		static inline Size formatI32(Char* dest, I32 value) {
+			return formatI64(dest, (I64)value);
+		}
+
+		/**
+		 * @brief Write the fixed-point decimal representation of a double.
+		 * Values that fit in 64 bits once scaled are formatted entirely with 
+		 * integer arithmetic, and trailing zeros in the fraction are stripped.
+		 * Huge, NaN and infinite values fall back to snprintf().  The output is
+		 * NOT null-terminated, dest must have space for at least 
+		 * CAT_MAX_F64_STRING_LENGTH characters.
+		 * @param dest The buffer to write the characters into.
+		 * @param value The value to format.
+		 * @param precision The max number of fractional digits (clamped to 9).
+		 * @return The number of characters written.
+		 */
+		static Size formatF64(Char* dest, F64 value, U32 precision = 6);
+
 		/**
 		 * @brief Convert an ascii c-style string to a unicode string.
 		 * @param str The ascii string to convert to a unicode string.
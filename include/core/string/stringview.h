@@ -0,0 +1,311 @@
+#ifndef CAT_CORE_STRING_STRINGVIEW_H
+#define CAT_CORE_STRING_STRINGVIEW_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file stringview.h
+ * @brief A non-owning view of a range of characters.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include <cstring>
+#include "core/corelib.h"
+#include "core/string/stringkernels.h"
+#include "core/string/internedstring.h"
+
+namespace Cat {
+
+	/**
+	 * @class StringView stringview.h "core/string/stringview.h"
+	 * @brief A non-owning view of a range of characters.
+	 *
+	 * A StringView is just a pointer and a length, it never allocates or
+	 * frees anything, and the characters it views do NOT have to be null
+	 * terminated.  Taking a sub view, trimming, or splitting a view only
+	 * moves the pointer and length, so strings can be parsed and compared
+	 * without copying them.  The viewed string must outlive the view.
+	 *
+	 * The oID() of a view is the same as the crc32() of the equivalent
+	 * null terminated string, so views can be used to look up keys in any
+	 * of the crc32 keyed containers.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class StringView {
+	  public:
+		/**
+		 * @brief Create an empty StringView.
+		 */
+		StringView() : m_pData(NIL), m_length(0) {}
+
+		/**
+		 * @brief Create a view of a null terminated string.
+		 * @param str The null terminated string to view (may be NIL).
+		 */
+		StringView(const Char* str)
+			: m_pData(str), m_length(str ? strlen(str) : 0) {}
+
+		/**
+		 * @brief Create a view of the first length characters of a string.
+		 * @param str The string to view.
+		 * @param length The number of characters in the view.
+		 */
+		StringView(const Char* str, Size length)
+			: m_pData(str), m_length(length) {}
+
+		/**
+		 * @brief Create a view of an interned string.
+		 * @param str The interned string to view.
+		 */
+		StringView(const InternedString& str)
+			: m_pData(str.cStr()), m_length(str.length()) {}
+
+		/**
+		 * @brief Overloaded equality operator, compares the characters.
+		 * @param other The view to compare to.
+		 * @return True if both views hold the same characters.
+		 */
+		inline Boolean operator==(const StringView& other) const {
+			return equals(other);
+		}
+
+		/**
+		 * @brief Overloaded inequality operator, compares the characters.
+		 * @param other The view to compare to.
+		 * @return True if the views hold different characters.
+		 */
+		inline Boolean operator!=(const StringView& other) const {
+			return !equals(other);
+		}
+
+		/**
+		 * @brief Array access operator.
+		 * @param idx The index of the character to get.
+		 * @return The character at the specified index.
+		 */
+		inline Char operator[](Size idx) const {
+			D_CONDERR((idx >= m_length), "Index " << idx << " out of range!");
+			return m_pData[idx];
+		}
+
+		/**
+		 * @brief Get the character at the specified index.
+		 * @param idx The index of the character to get.
+		 * @return The character at idx.
+		 */
+		inline Char at(Size idx) const { return (*this)[idx]; }
+
+		/**
+		 * @brief Get the last character in the view.
+		 * @return The last character, the view must not be empty.
+		 */
+		inline Char back() const { return (*this)[m_length - 1]; }
+
+		/**
+		 * @brief Compare the view to another, like strcmp.
+		 * @param other The view to compare to.
+		 * @return < 0 if this view sorts first, 0 if equal, > 0 otherwise.
+		 */
+		I32 compare(const StringView& other) const;
+
+		/**
+		 * @brief Check to see if a character is in the view.
+		 * @param chr The character to look for.
+		 * @return True if the character is in the view.
+		 */
+		inline Boolean contains(Char chr) const { return indexOf(chr) >= 0; }
+
+		/**
+		 * @brief Copy the view into a newly allocated null terminated string.
+		 * The string must be freed with StringUtils::free().
+		 * @return The new string.
+		 */
+		Char* copy() const;
+
+		/**
+		 * @brief Copy the view into a buffer and null terminate it.
+		 * @param dest The buffer, which must hold at least length() + 1 characters.
+		 */
+		inline void copyTo(Char* dest) const {
+			if (m_length) { memcpy(dest, m_pData, sizeof(Char)*m_length); }
+			dest[m_length] = '\0';
+		}
+
+		/**
+		 * @brief Get a pointer to the start of the view.
+		 * @return The pointer to the viewed characters (NOT null terminated).
+		 */
+		inline const Char* data() const { return m_pData; }
+
+		/**
+		 * @brief Check to see if the view ends with a suffix.
+		 * @param suffix The suffix to look for.
+		 * @return True if the view ends with the suffix.
+		 */
+		inline Boolean endsWith(const StringView& suffix) const {
+			return (suffix.m_length <= m_length &&
+					  (suffix.m_length == 0 ||
+						memcmp(m_pData + m_length - suffix.m_length, suffix.m_pData,
+								 suffix.m_length) == 0));
+		}
+
+		/**
+		 * @brief Compare the characters of two views.
+		 * @param other The view to compare to.
+		 * @return True if both views hold the same characters.
+		 */
+		inline Boolean equals(const StringView& other) const {
+			return (m_length == other.m_length &&
+					  (m_pData == other.m_pData || m_length == 0 ||
+						memcmp(m_pData, other.m_pData, m_length) == 0));
+		}
+
+		/**
+		 * @brief Compare the characters of two views, ignoring ascii case.
+		 * @param other The view to compare to.
+		 * @return True if both views hold the same characters, ignoring case.
+		 */
+		inline Boolean equalsIgnoreCase(const StringView& other) const {
+			return (m_length == other.m_length &&
+					  (m_pData == other.m_pData || m_length == 0 ||
+						StringKernels::table().equalsIgnoreCase(m_pData, other.m_pData, m_length)));
+		}
+
+		/**
+		 * @brief Find the first occurance of a character.
+		 * @param chr The character to look for.
+		 * @param start The index to start looking from.
+		 * @return The index of the character, or -1 if not found.
+		 */
+		inline I32 indexOf(Char chr, Size start = 0) const {
+			if (start >= m_length) { return -1; }
+			const Char* found = (const Char*)memchr(m_pData + start, chr, m_length - start);
+			return found ? (I32)(found - m_pData) : -1;
+		}
+
+		/**
+		 * @brief Find the first occurance of a substring.
+		 * @param needle The substring to look for.
+		 * @param start The index to start looking from.
+		 * @return The index of the substring, or -1 if not found.
+		 */
+		I32 indexOf(const StringView& needle, Size start = 0) const;
+
+		/**
+		 * @brief Intern the viewed characters.
+		 * @return The handle to the interned string.
+		 */
+		inline InternedString intern() const {
+			return StringInterner::intern(m_pData, m_length);
+		}
+
+		/**
+		 * @brief Check to see if the view has no characters.
+		 * @return True if the view is empty.
+		 */
+		inline Boolean isEmpty() const { return m_length == 0; }
+
+		/**
+		 * @brief Find the last occurance of a character.
+		 * @param chr The character to look for.
+		 * @return The index of the character, or -1 if not found.
+		 */
+		I32 lastIndexOf(Char chr) const;
+
+		/**
+		 * @brief Get the number of characters in the view.
+		 * @return The length of the view.
+		 */
+		inline Size length() const { return m_length; }
+
+		/**
+		 * @brief Split the next token off the front of the view.
+		 *
+		 * The token is everything up to the first separator, and the view
+		 * is moved past the separator.  Every separator produces a token, so
+		 * "a,,b" gives "a", "" and "b".  Once the last token has been taken
+		 * the view becomes null and nextToken() returns false.
+		 *
+		 * @param separator The character separating tokens.
+		 * @param token The view to store the token in.
+		 * @return True if a token was taken, false if the view is exhausted.
+		 */
+		Boolean nextToken(Char separator, StringView& token);
+
+		/**
+		 * @brief Get the OID (crc32 hash) of the view.
+		 * @return The same hash crc32() gives for the null terminated string.
+		 */
+		inline OID oID() const { return crc32(m_pData, m_length); }
+
+		/**
+		 * @brief Split the view at the first occurance of a separator.
+		 * @param separator The character to split on.
+		 * @param head The view to store the characters before the separator in.
+		 * @param tail The view to store the characters after the separator in.
+		 * @return True if the separator was found, otherwise head is the
+		 * whole view, and tail is empty.
+		 */
+		Boolean split(Char separator, StringView& head, StringView& tail) const;
+
+		/**
+		 * @brief Check to see if the view starts with a prefix.
+		 * @param prefix The prefix to look for.
+		 * @return True if the view starts with the prefix.
+		 */
+		inline Boolean startsWith(const StringView& prefix) const {
+			return (prefix.m_length <= m_length &&
+					  (prefix.m_length == 0 ||
+						memcmp(m_pData, prefix.m_pData, prefix.m_length) == 0));
+		}
+
+		/**
+		 * @brief Get a view of part of this view.
+		 * The start and length are clamped to the end of this view.
+		 * @param start The index of the first character.
+		 * @param length The maximum number of characters.
+		 * @return The sub view.
+		 */
+		inline StringView sub(Size start, Size length = (Size)-1) const {
+			if (start > m_length) { start = m_length; }
+			if (length > m_length - start) { length = m_length - start; }
+			return StringView(m_pData + start, length);
+		}
+
+		/**
+		 * @brief Get a view with leading and trailing whitespace removed.
+		 * @return The trimmed view.
+		 */
+		inline StringView trim() const { return trimLeft().trimRight(); }
+
+		/**
+		 * @brief Get a view with the leading whitespace removed.
+		 * @return The trimmed view.
+		 */
+		StringView trimLeft() const;
+
+		/**
+		 * @brief Get a view with the trailing whitespace removed.
+		 * @return The trimmed view.
+		 */
+		StringView trimRight() const;
+
+	  private:
+		const Char* m_pData;
+		Size        m_length;
+	};
+
+#if defined (DEBUG)
+	inline std::ostream& operator<<(std::ostream& out, const StringView& str) {
+		if (str.isEmpty()) { return out; }
+		return out.write(str.data(), str.length());
+	}
+#endif /* DEBUG */
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_STRINGVIEW_H
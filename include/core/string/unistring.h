@@ -16,6 +16,7 @@
 #include <cstring>
 #include "core/threading/atomic.h"
 #include "core/util/invasivestrongptr.h"
+#include "core/string/stringutils.h"
 
 namespace Cat {
 	
@@ -39,11 +40,20 @@ namespace Cat {
 			m_pString(NIL), m_length(0) {}
 
 		/**
-		 * @brief Create a new Unicode String from a copy of a null-terminated c-string.
+		 * @brief Create a new Unicode String from a null-terminated UTF-8 c-string.
+		 * If the string is not valid UTF-8, each byte is widened as Latin-1.
 		 * @param str The null-terminated c-string to initialize the UniString from.
 		 */
 		explicit UniString(const Char* str);
 
+		/**
+		 * @brief Create a new Unicode String from a UTF-8 string of known length.
+		 * If the string is not valid UTF-8, each byte is widened as Latin-1.
+		 * @param str The UTF-8 string to initialize the UniString from.
+		 * @param length The number of bytes in str.
+		 */
+		UniString(const Char* str, Size length);
+
 		/**
 		 * @brief Create a new String from a single Character.
 		 * @param chr The Character to create the string from.
@@ -110,7 +120,7 @@ namespace Cat {
 		UniString& operator=(const U16* str);
 
 		/**
-		 * @brief Overloaded assignment operator to copy a c-string.
+		 * @brief Overloaded assignment operator to decode a UTF-8 c-string.
 		 * @param src The c-string to copy from.
 		 * @return A reference to this string.
 		 */
@@ -242,6 +252,35 @@ namespace Cat {
 			return operator==(other);
 		}
 
+		/**
+		 * @brief Get the index of the first occurance of a unicode character.
+		 * @param chr The unicode character to search for.
+		 * @return The index of the first occurance, or -1 if not found.
+		 */
+		inline I32 indexOf(U16 chr) const {
+			return StringUtils::indexOf(m_pString, chr);
+		}
+
+		/**
+		 * @brief Get the index of the first occurance of a unicode substring.
+		 * @param str The null-terminated unicode substring to search for.
+		 * @return The index of the first occurance, or -1 if not found.
+		 */
+		inline I32 indexOf(const U16* str) const {
+			return StringUtils::indexOf(m_pString, str);
+		}
+
+		/**
+		 * @brief Get the index of the last occurance of a unicode character.
+		 * @param chr The unicode character to search for.
+		 * @return The index of the last occurance, or -1 if not found.
+		 */
+		inline I32 lastIndexOf(U16 chr) const {
+			if (m_length == 0) { return -1; }
+			const U16* found = StringKernels::table().findLast16(m_pString, m_length, chr);
+			return found ? (I32)(found - m_pString) : -1;
+		}
+
 		/**
 		 * @brief Test to see if the UniString is empty or not.
 		 * @return True if the UniString is empty.
@@ -254,6 +293,28 @@ namespace Cat {
 		 */
 		inline Size length() const { return m_length; }		
 
+		/**
+		 * @brief Replace the contents with a decoded UTF-8 string.
+		 * If the string is not valid UTF-8, each byte is widened as Latin-1.
+		 * @param str The UTF-8 string to decode.
+		 * @param length The number of bytes in str.
+		 * @return A reference to this string.
+		 */
+		UniString& assignUTF8(const Char* str, Size length);
+
+		/**
+		 * @brief Encode the UniString as a new null-terminated UTF-8 c-string.
+		 * @return The dynamically allocated UTF-8 string (free with 
+		 * StringUtils::free()), or NIL if the UniString holds unpaired surrogates.
+		 */
+		Char* toUTF8() const;
+
+		/**
+		 * @brief Get the number of bytes needed to encode the UniString as UTF-8.
+		 * @return The length of the UTF-8 encoding (w/o null-terminator).
+		 */
+		Size utf8Length() const;
+
 		/**
 		 * @brief Increase the retain count by one.
 		 */
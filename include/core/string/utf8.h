@@ -0,0 +1,162 @@
+#ifndef CAT_CORE_STRING_UTF8_H
+#define CAT_CORE_STRING_UTF8_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file utf8.h
+ * @brief Validation and transcoding between UTF-8 and UTF-16.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+/**
+ * Returned by the transcoding methods when the input is not well-formed.
+ */
+#define CAT_UTF_INVALID ((Size)-1)
+
+namespace Cat {
+
+	/**
+	 * @class Utf8 utf8.h "core/string/utf8.h"
+	 * @brief Validation and transcoding between UTF-8 and UTF-16.
+	 *
+	 * All the methods fully validate their input (overlong encodings, 
+	 * surrogates encoded in UTF-8, code points above U+10FFFF and unpaired 
+	 * UTF-16 surrogates are all rejected).  Runs of ASCII are validated and 
+	 * widened / narrowed 16 characters at a time with SSE2, which is where 
+	 * almost all of the time goes for source files, paths and config text.
+	 * None of the methods null-terminate their output.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Utf8 {
+	  public:
+		/**
+		 * @brief Check to see if a string is well-formed UTF-8.
+		 * @param str The UTF-8 string to validate.
+		 * @param length The number of bytes in str.
+		 * @return True if the string is valid UTF-8.
+		 */
+		static Boolean validate(const Char* str, Size length);
+
+		/**
+		 * @brief Count the UTF-16 code units needed to hold a VALID UTF-8 string.
+		 * @param str The (already validated) UTF-8 string.
+		 * @param length The number of bytes in str.
+		 * @return The number of U16 code units the string will decode to.
+		 */
+		static Size utf16Length(const Char* str, Size length);
+
+		/**
+		 * @brief Count the UTF-8 bytes needed to encode a UTF-16 string.
+		 * @param str The UTF-16 string.
+		 * @param length The number of U16 code units in str.
+		 * @return The number of bytes the string will encode to.
+		 */
+		static Size utf8Length(const U16* str, Size length);
+
+		/**
+		 * @brief Decode a UTF-8 string into UTF-16.
+		 * @param src The UTF-8 string to decode.
+		 * @param length The number of bytes in src.
+		 * @param dest The buffer to decode into, must hold at least length U16s.
+		 * @return The number of U16s written or CAT_UTF_INVALID.
+		 */
+		static Size toUtf16(const Char* src, Size length, U16* dest);
+
+		/**
+		 * @brief Encode a UTF-16 string as UTF-8.
+		 * @param src The UTF-16 string to encode.
+		 * @param length The number of U16 code units in src.
+		 * @param dest The buffer to encode into, must hold at least 3*length bytes.
+		 * @return The number of bytes written or CAT_UTF_INVALID.
+		 */
+		static Size fromUtf16(const U16* src, Size length, Char* dest);
+
+		/**
+		 * @brief Get the length of the UTF-8 sequence started by a lead byte.
+		 * @param lead The first byte of the sequence.
+		 * @return The number of bytes in the sequence, or 0 if not a lead byte.
+		 */
+		static inline U32 sequenceLength(U8 lead) {
+			if (lead < 0x80) { return 1; }
+			else if (lead < 0xC2) { return 0; }
+			else if (lead < 0xE0) { return 2; }
+			else if (lead < 0xF0) { return 3; }
+			else if (lead < 0xF5) { return 4; }
+			return 0;
+		}
+
+		/**
+		 * @brief Decode as many complete UTF-8 sequences as possible.
+		 * Stops, without error, at an incomplete sequence at the end of src.
+		 * @param src The UTF-8 bytes to decode.
+		 * @param length The number of bytes in src.
+		 * @param dest The buffer to decode into, must hold at least length U16s.
+		 * @param pConsumed Set to the number of bytes of src decoded.
+		 * @return The number of U16s written or CAT_UTF_INVALID.
+		 */
+		static Size decode(const Char* src, Size length, U16* dest, Size* pConsumed);
+	};
+
+	/**
+	 * @class Utf8Decoder utf8.h "core/string/utf8.h"
+	 * @brief A streaming UTF-8 to UTF-16 decoder.
+	 *
+	 * The Utf8Decoder is fed UTF-8 text in arbitrary chunks (as read from a 
+	 * stream) and remembers any sequence split across the end of a chunk.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class Utf8Decoder {
+	  public:
+		/**
+		 * @brief Create a new, empty decoder.
+		 */
+		Utf8Decoder() : m_numPending(0), m_failed(false) {}
+
+		/**
+		 * @brief Decode the next chunk of UTF-8 text.
+		 * @param src The next chunk of UTF-8 bytes.
+		 * @param length The number of bytes in src.
+		 * @param dest The buffer to decode into, must hold at least length + 1 U16s.
+		 * @return The number of U16s written or CAT_UTF_INVALID.
+		 */
+		Size decode(const Char* src, Size length, U16* dest);
+
+		/**
+		 * @brief Check to see if an invalid sequence has been seen.
+		 * @return True if the input was not valid UTF-8.
+		 */
+		inline Boolean hasFailed() const { return m_failed; }
+
+		/**
+		 * @brief Check to see if the input ended on a sequence boundary.
+		 * @return True if no partial sequence is waiting for more bytes.
+		 */
+		inline Boolean isComplete() const { return m_numPending == 0; }
+
+		/**
+		 * @brief Reset the decoder to decode a new stream.
+		 */
+		inline void reset() {
+			m_numPending = 0;
+			m_failed = false;
+		}
+
+	  private:
+		Char m_pending[4];
+		U32 m_numPending;
+		Boolean m_failed;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_STRING_UTF8_H
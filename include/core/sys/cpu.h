@@ -0,0 +1,136 @@
+#ifndef CAT_CORE_SYS_CPU_H
+#define CAT_CORE_SYS_CPU_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file cpu.h
+ * @brief A static class to query the vector instruction sets of the CPU.
+ *
+ * Defines CAT_SIMD_SSE2 or CAT_SIMD_NEON when the baseline target guarantees
+ * that instruction set, and CAT_TARGET_AVX2 / CAT_TARGET_SSE41 to mark single 
+ * functions compiled for a higher instruction set, which must only be called
+ * after checking the matching Cpu::has*() method.  Define CAT_NO_SIMD to 
+ * force every kernel to its scalar fallback.
+ *
+ * Define CAT_SIMD_MATH to build Vec4, Quaternion and Mat4 on top of 16-byte
+ * aligned __m128 storage, which defines CAT_MATH_SSE when SSE2 is available.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+#if !defined (CAT_NO_SIMD)
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CAT_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined (__ARM_NEON) || defined (__ARM_NEON__)
+#define CAT_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif /* CAT_NO_SIMD */
+
+#if defined (CAT_SIMD_SSE2) && defined (__GNUC__)
+#define CAT_SIMD_AVX2 1
+#define CAT_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define CAT_TARGET_AVX2 __attribute__((target("avx2,fma")))
+/* AVX2 without FMA, for kernels which must round exactly like the scalar
+ * code, so must not have their multiplies and adds fused by the compiler. */
+#define CAT_TARGET_AVX2_NO_FMA __attribute__((target("avx2")))
+/* The half float conversions, which the CPUs with AVX2 all have. */
+#define CAT_TARGET_F16C __attribute__((target("avx,f16c")))
+#include <immintrin.h>
+#else
+#define CAT_TARGET_SSE41
+#define CAT_TARGET_AVX2
+#define CAT_TARGET_AVX2_NO_FMA
+#define CAT_TARGET_F16C
+#endif
+
+#if defined (CAT_SIMD_MATH) && defined (CAT_SIMD_SSE2)
+#define CAT_MATH_SSE 1
+#endif
+
+#if defined (__GNUC__)
+#define CAT_ALIGN(n) __attribute__((aligned(n)))
+#elif defined (_MSC_VER)
+#define CAT_ALIGN(n) __declspec(align(n))
+#else
+#define CAT_ALIGN(n)
+#endif
+
+/* The alignment of the math types, which only need it for their __m128 storage. */
+#if defined (CAT_MATH_SSE)
+#define CAT_MATH_ALIGN CAT_ALIGN(16)
+#else
+#define CAT_MATH_ALIGN
+#endif
+
+/* For kernels that deliberately read whole aligned vectors past the end of a
+ * null-terminated string (which can never fault, but trips the sanitizer). */
+#if defined (__GNUC__)
+#define CAT_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define CAT_NO_SANITIZE_ADDRESS
+#endif
+
+namespace Cat {
+
+	/**
+	 * @class Cpu cpu.h "core/sys/cpu.h"
+	 * @brief A static class to query the vector instruction sets of the CPU.
+	 *
+	 * The features are detected once, on first use, and cached.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 2
+	 * @since Oct 17, 2026
+	 */
+	class Cpu {
+	  public:
+		/**
+		 * @brief Flags for each of the instruction sets we dispatch on.
+		 */
+		enum Feature {
+			kSSE2 = 0x1,
+			kSSE41 = 0x2,
+			kAVX2 = 0x4,
+			kFMA = 0x8,
+			kNEON = 0x10,
+			kF16C = 0x20,
+		};
+
+		/**
+		 * @brief Get the set of supported features.
+		 * @return A BitField of Cpu::Feature flags.
+		 */
+		static BitField32 features();
+
+		/**
+		 * @brief Check to see if the CPU supports an instruction set.
+		 * @param feature The Cpu::Feature to check for.
+		 * @return True if the feature is supported (and SIMD is enabled).
+		 */
+		static inline Boolean has(Feature feature) {
+			return (features() & feature) != 0;
+		}
+
+		static inline Boolean hasSSE2() { return has(kSSE2); }
+		static inline Boolean hasSSE41() { return has(kSSE41); }
+		static inline Boolean hasAVX2() { return has(kAVX2); }
+		static inline Boolean hasFMA() { return has(kFMA); }
+		static inline Boolean hasNEON() { return has(kNEON); }
+		static inline Boolean hasF16C() { return has(kF16C); }
+
+	  private:
+		/**
+		 * @brief Actually query the cpu for the feature flags.
+		 */
+		static BitField32 detectFeatures();
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_SYS_CPU_H
@@ -58,6 +58,14 @@ namespace Cat {
 		 */
 		AsyncResult* run(AsyncTask* task);
 
+		/**
+		 * Add an AsyncTask to the queue to run, if the runner is started.
+		 * @param task The AsyncTask* to add to the queue.
+		 * @return True if the task was queued, false if the runner is stopping
+		 * or stopped, in which case the task is not run and still belongs to the caller.
+		 */
+		Boolean queue(AsyncTask* task);
+
 		/**
 		 * Get the number of threads in the AsyncTaskRunner.
 		 * @return The number of threads in the AsyncTaskRunner.
@@ -15,6 +15,7 @@
 #include "core/corelib.h"
 #include "core/util/invasivestrongptr.h"
 #include "core/threading/atomic.h"
+#include "core/string/internedstring.h"
 
 namespace Cat {
 
@@ -43,29 +44,27 @@ namespace Cat {
 		 * @brief All implementing classes should call this.
 		 */
 		Process()
-			: m_pid(0), m_pName(NIL), m_priority(1),
+			: m_pid(0), m_priority(1),
 			  m_priorityModifier(1), m_state(kPSNotStarted) {}
 
 		Process(OID pid)
-			: m_pid(pid), m_pName(NIL), m_priority(1),
+			: m_pid(pid), m_priority(1),
 			  m_priorityModifier(1), m_state(kPSNotStarted) {}
 		
 		Process(const Char* name)
-			: m_priority(1),
+			: m_name(name), m_priority(1),
 			  m_priorityModifier(1), m_state(kPSNotStarted) {
-			m_pName = copy(name);
-			m_pid = crc32(name);
+			m_pid = m_name.oID();
 		}
+
+		Process(const InternedString& name)
+			: m_pid(name.oID()), m_name(name), m_priority(1),
+			  m_priorityModifier(1), m_state(kPSNotStarted) {}
 		
 		/**
 		 * @brief Virtual destructor.
 		 */
-		virtual ~Process() {
-			if (m_pName) {
-				free(m_pName);
-				m_pName = NIL;
-			}			
-		}
+		virtual ~Process() {}
 
 		/**
 		 * @brief Add a child process to this process.
@@ -178,7 +177,13 @@ namespace Cat {
 		 * @brief Get the name of the process, if it has one.
 		 * @return The name or NIL.
 		 */
-		inline const Char* name() const { return m_pName; }		
+		inline const Char* name() const { return m_name.cStr(); }		
+
+		/**
+		 * @brief Get the interned name of the process.
+		 * @return The handle to the name, which is null if it has no name.
+		 */
+		inline const InternedString& internedName() const { return m_name; }
 
 		/**
 		 * @brief Get the value of the priorityModifier for the process.
@@ -363,7 +368,7 @@ namespace Cat {
 
 	  private:
 		OID                        m_pid;
-		Char*                      m_pName;		
+		InternedString             m_name;		
 		AtomicI32		 			   m_retainCount;
 		I32							   m_priority;
 		I32                        m_priorityModifier;		
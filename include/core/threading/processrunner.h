@@ -16,6 +16,7 @@
 #include "core/threading/spinlock.h"
 #include "core/threading/processqueue.h"
 #include "core/util/simplequeue.h"
+#include "core/string/internedstring.h"
 
 namespace Cat {
 
@@ -72,7 +73,7 @@ namespace Cat {
 		 * @brief Initializes an empty ProcessRunner with no processes.
 		 */
 		ProcessRunner() :
-			m_state(kPMSNotStarted), m_oid(0), m_pName(NIL), m_numFree(0), m_numUsed(0), m_pNodeStorage(NIL) {}
+			m_state(kPMSNotStarted), m_oid(0), m_numFree(0), m_numUsed(0), m_pNodeStorage(NIL) {}
 
 		/**
 		 * @brief Create a new Process Runner with the specified name.
@@ -151,7 +152,13 @@ namespace Cat {
 		 * @brief Get the name of the process manager.
 		 * @return The name of the process manager.
 		 */
-		inline const Char* name() const { return m_pName; }
+		inline const Char* name() const { return m_name.cStr(); }
+
+		/**
+		 * @brief Get the interned name of the process manager.
+		 * @return The handle to the name of the process manager.
+		 */
+		inline const InternedString& internedName() const { return m_name; }
 
 		/**
 		 * @brief Get the number of free nodes in the runner.
@@ -407,7 +414,7 @@ namespace Cat {
 
 		ProcessRunnerState m_state;
 		OID					  m_oid;		
-		Char*					  m_pName;		
+		InternedString		  m_name;		
 		ConditionVariable	  m_syncLock;		
 		ThreadHandle		  m_thread;
 
@@ -15,7 +15,7 @@
 #include "core/corelib.h"
 #include "core/util/invasivestrongptr.h"
 #include "core/threading/atomic.h"
-#include "core/string/stringutils.h"
+#include "core/string/internedstring.h"
 
 namespace Cat {
 
@@ -45,26 +45,27 @@ namespace Cat {
 		 * @brief All implementing Task classes should call this.
 		 */
 		Task()
-			: m_oid(0), m_pName(NIL), m_priority(1),
+			: m_oid(0), m_priority(1),
 			  m_state(kTSNotStarted) {}
 
 		Task(OID oid)
-			: m_oid(oid), m_pName(NIL), m_priority(1),
+			: m_oid(oid), m_priority(1),
 			  m_state(kTSNotStarted) {}
 		
 		Task(const Char* name)
-			: m_priority(1),
+			: m_name(name), m_priority(1),
 			  m_state(kTSNotStarted) {
-			m_pName = StringUtils::copy(name);
-			m_oid = crc32(name);
+			m_oid = m_name.oID();
 		}
+
+		Task(const InternedString& name)
+			: m_oid(name.oID()), m_name(name), m_priority(1),
+			  m_state(kTSNotStarted) {}
 		
 		/**
 		 * @brief Virtual destructor.
 		 */
-		virtual ~Task() {
-			m_pName = StringUtils::free(m_pName);	
-		}
+		virtual ~Task() {}
 
 		/**
 		 * @brief Add a child task to this task.
@@ -149,7 +150,13 @@ namespace Cat {
 		 * @brief Get the name of the task, if it has one.
 		 * @return The name or NIL.
 		 */
-		inline const Char* name() const { return m_pName; }		
+		inline const Char* name() const { return m_name.cStr(); }		
+
+		/**
+		 * @brief Get the interned name of the task.
+		 * @return The handle to the name, which is null if it has no name.
+		 */
+		inline const InternedString& internedName() const { return m_name; }
 
 		/**
 		 * @brief Method to call when the task has failed.
@@ -290,7 +297,7 @@ namespace Cat {
 		}
 
 		OID                        m_oid;
-		Char*                      m_pName;		
+		InternedString             m_name;		
 		AtomicI32					   m_retainCount;
 		I32							   m_priority;
 		InvasiveStrongPtr<Task> m_pParent;
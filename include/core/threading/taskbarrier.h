@@ -0,0 +1,56 @@
+#ifndef CAT_CORE_THREADING_TASKBARRIER_H
+#define CAT_CORE_THREADING_TASKBARRIER_H
+/**
+ * Copyright Catlin Zilinksi, 2013.  All rights reserved.
+ *
+ * taskbarrier.h: Contains the definition of the TaskBarrier class, which
+ * lets a thread wait for a number of tasks it has handed out.
+ *
+ * Author: Catlin Zilinski
+ * Date: Oct 17, 2026
+ */
+
+#include "core/threading/mutex.h"
+#include "core/threading/conditionvariable.h"
+
+namespace Cat {
+
+	/**
+	 * The TaskBarrier class holds the count of tasks still running and a
+	 * condition for the thread that handed them out to sleep on until they
+	 * are all done.  The barrier belongs to the waiting thread, usually on
+	 * its stack, so a task must not touch it after calling arrive().
+	 */
+	class TaskBarrier {
+		public:
+			TaskBarrier(Size count) : m_remaining(count) {}
+
+			/* Count one task done, waking the waiting thread on the last one */
+			inline void arrive() {
+				m_lock.lock();
+				if (--m_remaining == 0) {
+					m_done.broadcast();
+				}
+				m_lock.unlock();
+			}
+
+			/* Sleep until every task has arrived */
+			inline void wait() {
+				m_lock.lock();
+				while (m_remaining > 0) {
+					m_done.wait(m_lock);
+				}
+				m_lock.unlock();
+			}
+
+		private:
+			TaskBarrier(const TaskBarrier& src);
+			TaskBarrier& operator=(const TaskBarrier& src);
+
+			Mutex						m_lock;
+			ConditionVariable		m_done;
+			Size						m_remaining;
+	};
+}
+
+#endif // CAT_CORE_THREADING_TASKBARRIER_H
@@ -16,6 +16,7 @@
 #include "core/threading/spinlock.h"
 #include "core/threading/taskqueuenode.h"
 #include "core/util/simplequeue.h"
+#include "core/string/internedstring.h"
 
 namespace Cat {
 
@@ -67,7 +68,7 @@ namespace Cat {
 		 * @brief Initializes an empty TaskRunner with no taskes.
 		 */
 		TaskRunner() :
-			m_state(kTRSNotStarted), m_oid(0), m_pName(NIL),
+			m_state(kTRSNotStarted), m_oid(0),
 			m_numFree(0), m_numUsed(0),  m_pNodeStorage(NIL) {}
 
 		/**
@@ -144,7 +145,13 @@ namespace Cat {
 		 * @brief Get the name of the task manager.
 		 * @return The name of the task manager.
 		 */
-		inline const Char* name() const { return m_pName; }
+		inline const Char* name() const { return m_name.cStr(); }
+
+		/**
+		 * @brief Get the interned name of the task manager.
+		 * @return The handle to the name of the task manager.
+		 */
+		inline const InternedString& internedName() const { return m_name; }
 
 		/**
 		 * @brief Get the OID of the task manager.
@@ -284,7 +291,7 @@ namespace Cat {
 
 		TaskRunnerState     m_state;
 		OID					  m_oid;		
-		Char*					  m_pName;		
+		InternedString		  m_name;		
 		ConditionVariable	  m_syncLock;		
 		ThreadHandle		  m_thread;
 
@@ -1,33 +1,140 @@
-#ifndef CAT_CORE_THREADING_ATOMIC_H
-#define CAT_CORE_THREADING_ATOMIC_H
+#ifndef CAT_CORE_THREADING_UNIX_ATOMIC_H
+#define CAT_CORE_THREADING_UNIX_ATOMIC_H
 
 /**
- * @copyright Copyright Catlin Zilinski, 2013.  All rights reserved.
+ * @copyright Copyright Catlin Zilinski, 2014.  All rights reserved.
  *
- * @file invasivestrongptr.h
- * @brief Contains a reference counting pointer wrapper.
- *
- * The InvasiveStrongPtr class is a strong reference counting safe pointer which assumes 
- * certain methods on the pointer it is storing to increment and decrement the 
- * reference count, which is stored on the actual object.
+ * @file atomic.h
+ * @brief Contains various atomic types.
  *
  * @author Catlin Zilinski
- * @date: Mar 4, 2014
+ * @date Mar 15, 2014
  */
 
-#include <cstdlib>
 #include "core/corelib.h"
 
 namespace Cat {
 
 	/**
-	 * @class InvasiveStrongPtr invasivestrongptr.h "core/util/invasivestrongptr.h"
-	 * @brief A strong reference counting safe pointer.
+	 * @class AtomicI32 atomic.h "core/threading/atomic.h"
+	 * @brief An Atomic Integer type.
+	 * 
+	 * @author Catlin Zilinski
+	 * @version 3
+	 * @since Mar 15, 2014
+	 */
+	class AtomicI32 {
+	  public:
+		AtomicI32() : m_val(0) {}
+		AtomicI32(I32 val) : m_val(val) {}
+
+		/**
+		 * @return The value incrememented by 1.
+		 */
+		inline I32 increment() {
+			return __sync_add_and_fetch(&m_val, 1);
+		}
+
+		/**
+		 * @brief The value decremented by 1.
+		 */
+		inline I32 decrement() {
+			return __sync_sub_and_fetch(&m_val, 1);
+		}
+
+		/**
+		 * @return The stored value, with acquire semantics.
+		 */
+		inline I32 val() const { return __atomic_load_n(&m_val, __ATOMIC_ACQUIRE); }		
+
+	  private:
+		volatile I32 m_val;		
+	};
+
+	/**
+	 * @class AtomicU64 atomic.h "core/threading/atomic.h"
+	 * @brief An Atomic 64 bit unsigned counter.
+	 * 
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class AtomicU64 {
+	  public:
+		AtomicU64() : m_val(0) {}
+		AtomicU64(U64 val) : m_val(val) {}
+
+		/**
+		 * @brief Add to the value, with a single atomic instruction.
+		 * @param amount The amount to add.
+		 * @return The value before the amount was added.
+		 */
+		inline U64 fetchAdd(U64 amount) {
+			return __sync_fetch_and_add(&m_val, amount);
+		}
+
+		/**
+		 * @return The value incrememented by 1.
+		 */
+		inline U64 increment() {
+			return fetchAdd(1) + 1;
+		}
+
+		/**
+		 * @return The stored value.
+		 */
+		inline U64 val() const { return __atomic_load_n(&m_val, __ATOMIC_RELAXED); }		
+
+	  private:
+		U64 m_val;
+	};
+
+	/**
+	 * @class AtomicPtr atomic.h "core/threading/atomic.h"
+	 * @brief An Atomic pointer with acquire / release semantics.
+	 *
+	 * A pointer set() by one thread is safe to get() and dereference on any
+	 * other thread, as long as the pointed to data was written before set().
 	 * 
 	 * @author Catlin Zilinski
 	 * @version 1
-	 * @since Mar 4, 2014
+	 * @since Oct 17, 2026
 	 */
 	template<typename T>
-	class InvasiveStrongPtr {
-	  public:		
+	class AtomicPtr {
+	  public:
+		AtomicPtr() : m_ptr(NIL) {}
+		AtomicPtr(T* ptr) : m_ptr(ptr) {}
+
+		/**
+		 * @return The stored pointer (load-acquire).
+		 */
+		inline T* get() const {
+			return __atomic_load_n(&m_ptr, __ATOMIC_ACQUIRE);
+		}
+
+		/**
+		 * @brief Store a new pointer (store-release).
+		 * @param ptr The pointer to store.
+		 */
+		inline void set(T* ptr) {
+			__atomic_store_n(&m_ptr, ptr, __ATOMIC_RELEASE);
+		}
+
+		/**
+		 * @brief Replace the pointer, only if it is still the expected value.
+		 * @param expected The pointer that should currently be stored.
+		 * @param ptr The pointer to store.
+		 * @return True if the pointer was replaced.
+		 */
+		inline Boolean compareAndSwap(T* expected, T* ptr) {
+			return __sync_bool_compare_and_swap(&m_ptr, expected, ptr);
+		}
+
+	  private:
+		T* m_ptr;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_THREADING_UNIX_ATOMIC_H
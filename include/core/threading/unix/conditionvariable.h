@@ -16,19 +16,33 @@ namespace Cat {
 
 	/**
 	 * The ConditionVariable class contains the methods to lock/unlock the ConditionVariable for testing, 
-	 * and the method to wait/signal the ConditionVariable.
+	 * and the method to wait/signal the ConditionVariable.  It owns a Mutex to
+	 * wait with, taken by lock() and unlock(), or it can wait with another Mutex.
 	 */
 	class ConditionVariable {
 		public:
 			ConditionVariable();
 			~ConditionVariable();
 
+			inline void lock() {
+				m_lock.lock();
+			}
+
+			inline void unlock() {
+				m_lock.unlock();
+			}
+
+			/* Must hold the lock of the ConditionVariable */
+			inline void wait() {
+				pthread_cond_wait(&m_cv, &(m_lock.m_mutex));
+			}
+
 			inline void wait(Mutex& p_lock) {
 				pthread_cond_wait(&m_cv, &(p_lock.m_mutex));
 			}
 			  
 			inline void signal() {
-				p_thread_cond_signal(&m_cv);
+				pthread_cond_signal(&m_cv);
 			}
 			
 			inline void broadcast() {
@@ -36,7 +50,11 @@ namespace Cat {
 			}
 
 		private:
+			ConditionVariable(const ConditionVariable& src);
+			ConditionVariable& operator=(const ConditionVariable& src);
+
 			pthread_cond_t		m_cv;
+			Mutex					m_lock;
 	};
 }
 
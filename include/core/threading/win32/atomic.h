@@ -50,6 +50,94 @@ namespace Cat {
 		I32 m_val;		
 	};
 
+	/**
+	 * @class AtomicU64 atomic.h "core/threading/atomic.h"
+	 * @brief An Atomic 64 bit unsigned counter.
+	 * 
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class AtomicU64 {
+	  public:
+		AtomicU64() : m_val(0) {}
+		AtomicU64(U64 val) : m_val(val) {}
+
+		/**
+		 * @brief Add to the value, with a single atomic instruction.
+		 * @param amount The amount to add.
+		 * @return The value before the amount was added.
+		 */
+		inline U64 fetchAdd(U64 amount) {
+			return (U64)InterlockedExchangeAdd64((volatile LONGLONG*)&m_val, (LONGLONG)amount);
+		}
+
+		/**
+		 * @return The value incrememented by 1.
+		 */
+		inline U64 increment() {
+			return fetchAdd(1) + 1;
+		}
+
+		/**
+		 * @return The stored value.
+		 */
+		inline U64 val() const { return m_val; }		
+
+	  private:
+		volatile U64 m_val;
+	};
+
+	/**
+	 * @class AtomicPtr atomic.h "core/threading/atomic.h"
+	 * @brief An Atomic pointer with acquire / release semantics.
+	 *
+	 * A pointer set() by one thread is safe to get() and dereference on any
+	 * other thread, as long as the pointed to data was written before set().
+	 * 
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	template<typename T>
+	class AtomicPtr {
+	  public:
+		AtomicPtr() : m_ptr(NIL) {}
+		AtomicPtr(T* ptr) : m_ptr(ptr) {}
+
+		/**
+		 * @return The stored pointer (load-acquire).
+		 */
+		inline T* get() const {
+			T* ptr = m_ptr;
+			MemoryBarrier();
+			return ptr;
+		}
+
+		/**
+		 * @brief Store a new pointer (store-release).
+		 * @param ptr The pointer to store.
+		 */
+		inline void set(T* ptr) {
+			MemoryBarrier();
+			m_ptr = ptr;
+		}
+
+		/**
+		 * @brief Replace the pointer, only if it is still the expected value.
+		 * @param expected The pointer that should currently be stored.
+		 * @param ptr The pointer to store.
+		 * @return True if the pointer was replaced.
+		 */
+		inline Boolean compareAndSwap(T* expected, T* ptr) {
+			return InterlockedCompareExchangePointer((PVOID volatile*)&m_ptr,
+																  ptr, expected) == expected;
+		}
+
+	  private:
+		T* volatile m_ptr;
+	};
+
 	namespace Math {
 	} // namespace Math
 
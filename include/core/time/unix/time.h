@@ -20,12 +20,19 @@
 
 namespace Cat {
 
+	/**
+	 * A raw time value in nanoseconds on the monotonic clock, only
+	 * comparable with other raw values.  Cheap to read and compare, for
+	 * the timers.
+	 */
+	typedef U64 RawTimeVal;
+
 	/**
 	 * @class Time time.h "core/time/time.h"
 	 * @brief A simple Time value class.
 	 *
 	 * @author Catlin Zilinski
-	 * @version 2
+	 * @version 3
 	 * @since Mar 7, 2015
 	 */
 	class Time {
@@ -50,7 +57,7 @@ namespace Cat {
 		inline Time(const AbsTime& in_time) {
 			U64 n = in_time.nano();
 			m_time.tv_sec = (n / NANO_PER_SEC);
-			m_time.tv_nsec = (n - (t.tv_sec * NANO_PER_SEC));
+			m_time.tv_nsec = (n - (m_time.tv_sec * NANO_PER_SEC));
 		}
 #endif // OS_APPLE
 		
@@ -321,7 +328,7 @@ namespace Cat {
 		 */
 		inline void setNano(U64 in_nano) {
 			m_time.tv_sec = in_nano / NANO_PER_SEC;
-			m_time.tv_nsec = (in_nano - (m_time.tv_sec * NANO_PER_SEC))
+			m_time.tv_nsec = (in_nano - (m_time.tv_sec * NANO_PER_SEC));
 		}
 
 		/**
@@ -354,10 +361,99 @@ namespace Cat {
 #endif
 		}
 
+		/* ###################################################
+		 * The methods for the raw monotonic time values.
+		 * ################################################### */
+
+		/**
+		 * @return The current raw monotonic time.
+		 */
+		inline static RawTimeVal currentTimeRaw() {
+#if defined (OS_APPLE)
+			return AbsTime::currentTimeNano();
+#else // UNIX
+			timespec t;	clock_gettime(CLOCK_MONOTONIC, &t); return rawToNano(t);
+#endif
+		}
+
+		/**
+		 * @brief Compare two raw time values.
+		 * @return Less than, equal to or greater than 0 as lhs is before, at or after rhs.
+		 */
+		inline static I32 compareRaw(RawTimeVal lhs, RawTimeVal rhs) {
+			return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+		}
+
+		/**
+		 * @param in_seconds The span of time in seconds.
+		 * @return The span as a raw time value.
+		 */
+		inline static RawTimeVal secondsToRaw(F64 in_seconds) {
+			return (RawTimeVal)(in_seconds * (F64)NANO_PER_SEC);
+		}
+
+		/**
+		 * @param in_seconds The span of time in seconds.
+		 * @return The span in nanoseconds.
+		 */
+		inline static U64 secondsToNano(F64 in_seconds) {
+			return (U64)(in_seconds * (F64)NANO_PER_SEC);
+		}
+
 	  private:
 		timespec m_time;
 	};
 
+	/**
+	 * @class TimeVal time.h "core/time/time.h"
+	 * @brief A raw time value, either a point on the monotonic clock or a span.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	class TimeVal {
+	  public:
+		/**
+		 * @brief Create a zero TimeVal.
+		 */
+		inline TimeVal() : m_raw(0) {}
+
+		/**
+		 * @brief Create a TimeVal from a raw time value.
+		 * @param raw The raw time value.
+		 */
+		inline explicit TimeVal(RawTimeVal raw) : m_raw(raw) {}
+
+		/**
+		 * @brief Create a TimeVal from the nanoseconds in a Time.
+		 * @param time The Time to convert.
+		 */
+		inline TimeVal(const Time& time) : m_raw(time.nano()) {}
+
+		inline Boolean operator==(const TimeVal& rhs) const { return m_raw == rhs.m_raw; }
+		inline Boolean operator!=(const TimeVal& rhs) const { return m_raw != rhs.m_raw; }
+
+		/**
+		 * @return The raw time value.
+		 */
+		inline RawTimeVal raw() const { return m_raw; }
+
+		/**
+		 * @brief Set the TimeVal to the current raw monotonic time.
+		 */
+		inline void setToCurrentTime() { m_raw = Time::currentTimeRaw(); }
+
+#if defined (DEBUG)
+		friend std::ostream& operator<<(std::ostream& out, const TimeVal& t) {
+			return out << t.m_raw << "ns";
+		}
+#endif // DEBUG
+
+	  private:
+		RawTimeVal m_raw;
+	};
+
 #if !defined (OS_APPLE) && defined(OS_UNIX)
 	typedef Time AbsTime;
 #endif // OS_UNIX
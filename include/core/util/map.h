@@ -12,6 +12,7 @@
 
 #include <cmath>
 #include "core/util/datanodepool.h"
+#include "core/string/stringview.h"
 
 namespace Cat {	
 	/**
@@ -137,6 +138,13 @@ namespace Cat {
 		 */
 		inline T& at(const Char* key) { return at(crc32(key)); }
 
+		/**
+		 * @brief Access an element of the map via a view of its String key.
+		 * @param key The name of the element (string view).
+		 * @return A reference to the element or nullValue if not found.
+		 */
+		inline T& at(const StringView& key) { return at(key.oID()); }
+
 			/**
 		 * @brief Access an element of the map via its crc32 object id.
 		 * @param key The name of the element (string).
@@ -155,6 +163,13 @@ namespace Cat {
 		 */
 		inline const T& get(const Char* key) const { return get(crc32(key)); }	
 
+		/**
+		 * @brief Access an element of the map via a view of its String key.
+		 * @param key The name of the element (string view).
+		 * @return A reference to the element or nullValue if not found.
+		 */
+		inline const T& get(const StringView& key) const { return get(key.oID()); }
+
 		/**
 		 * @brief inserts the object in the map.
 		 * @param key The hashed key to insert the value into.
@@ -173,6 +188,15 @@ namespace Cat {
 			return insert(crc32(key), value);
 		}		
 
+		/**
+		 * @brief inserts the object in the map.
+		 * @param key The view of the String key to insert the value into.
+		 * @param value The value to insert into the map.
+		 */
+		inline void insert(const StringView& key, const T& value) {
+			insert(key.oID(), value);
+		}
+
 		/**
 		 * @brief Removes and returns the object from the map.
 		 * @param key The OID of the object to take from the map.
@@ -196,6 +220,13 @@ namespace Cat {
 		 * @return The object taken from the map or NIL if it wasn't in the map.
 		 */
 		inline T take(const Char* name) { return take(crc32(name)); }
+
+		/**
+		 * @brief Removes and returns the object from the map.
+		 * @param key The view of the name of the object to take from the map.
+		 * @return The object taken from the map or NIL if it wasn't in the map.
+		 */
+		inline T take(const StringView& key) { return take(key.oID()); }
 		
 		/**
 		 * @brief Removes and returns the object from the map.
@@ -224,6 +255,12 @@ namespace Cat {
 		 */
 		inline void remove(const Char* key) { remove(crc32(key)); }		
 
+		/**
+		 * @brief Removes the object from the map.
+		 * @param key The view of the name of the object to remove from the map.
+		 */
+		inline void remove(const StringView& key) { remove(key.oID()); }
+
 		/**
 		 * @brief Removes the object from the map.
 		 * Only removes the first occurance of the value found in the map.
@@ -279,6 +316,15 @@ namespace Cat {
 			return contains(crc32(key));
 		}		
 
+		/**
+		 * @brief Tests to see if an object is the map.
+		 * @param key The view of the string key value of the object.
+		 * @return true if the object is in the map.
+		 */
+		inline Boolean contains(const StringView& key) const {
+			return contains(key.oID());
+		}
+
 		/**
 		 * @brief Tests to see if the given object is in the map.
 		 * @param value The value to look for.
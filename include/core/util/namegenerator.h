@@ -10,7 +10,8 @@
  * @date Mar 25, 2014
  */
 
-#include "core/threading/spinlock.h"
+#include "core/threading/atomic.h"
+#include "core/string/internedstring.h"
 
 #define CAT_MAX_GENERATED_NAME_NUMBER_LENGTH 11
 
@@ -21,10 +22,17 @@ namespace Cat {
 	 * @brief A class that is able to generate a set of names base on a prefix.
 	 *
 	 * The NameGenerator class takes a prefix string and then is able to 
-	 * generate names of the form "prefix_<num>".
+	 * generate names of the form "prefix=<num>", where num is the count
+	 * encoded in base 64.
+	 *
+	 * Generating a name is lock free, the count is bumped with a single
+	 * atomic add, so any number of threads can share one generator.  The
+	 * name can be written into a caller's buffer, or interned, so nothing
+	 * is allocated, and the crc32 hash of the prefix is cached so the OID 
+	 * of a name only hashes the encoded count.
 	 *
 	 * @author Catlin Zilinski
-	 * @version 1
+	 * @version 2
 	 * @since Mar 25, 2014
 	 */
 	class NameGenerator {		
@@ -35,7 +43,8 @@ namespace Cat {
 		/**
 		 * @brief Create an empty, uninitialized NameGenerator.
 		 */
-		NameGenerator() : m_pPrefix(NIL), m_prefixLength(0), m_maxLength(0), m_count(0) {}
+		NameGenerator()
+			: m_pPrefix(NIL), m_prefixLength(0), m_maxLength(0), m_prefixOID(0) {}
 
 		/**
 		 * @brief Create a NameGenerator with the specified prefix.
@@ -66,13 +75,57 @@ namespace Cat {
 		 * @brief Get the current count that we are at.
 		 * @return The current value of the count.
 		 */
-		inline U64 count() const { return m_count; }		
+		inline U64 count() const { return m_count.val(); }		
 
 		/**
 		 * @brief Generate and return a new name.
+		 * The name must be deleted with delete[].
 		 * @return The generated name.
 		 */
 		Char* generate();		
+
+		/**
+		 * @brief Generate a new name into a buffer, without allocating.
+		 * @param buffer The buffer, which must hold maxLength() characters.
+		 * @return The length of the name (not including the null terminator).
+		 */
+		inline Size generate(Char* buffer) {
+			return encode(buffer, m_count.increment());
+		}
+
+		/**
+		 * @brief Generate a new name into a buffer, along with its OID.
+		 * The OID is the same as crc32(buffer), but only the encoded count
+		 * is hashed, since the hash of the prefix is cached.
+		 * @param buffer The buffer, which must hold maxLength() characters.
+		 * @param oid The OID of the name.
+		 * @return The length of the name (not including the null terminator).
+		 */
+		inline Size generate(Char* buffer, OID& oid) {
+			Size length = generate(buffer);
+			oid = crc32(m_prefixOID, buffer + m_prefixLength + 1, length - m_prefixLength - 1);
+			return length;
+		}
+
+		/**
+		 * @brief Generate a new name and intern it.
+		 * @return The handle to the interned name.
+		 */
+		InternedString generateInterned();
+
+		/**
+		 * @brief Generate a new unique OID straight from the count.
+		 *
+		 * No name is created, and the OID is NOT the hash of any name.  The
+		 * OIDs from one generator are unique for the first 2^32 generated.
+		 * Useful for objects which only need an ID, like Task(OID).
+		 *
+		 * @return The new OID.
+		 */
+		inline OID generateOID() {
+			/* Multiplying by an odd number is a bijection on 32 bits */
+			return (OID)(((U32)m_count.increment() ^ m_prefixOID) * 0x9E3779B1U);
+		}
 					
 		/**
 		 * @brief Initialize an uninitialized name generator.
@@ -99,14 +152,19 @@ namespace Cat {
 		inline U32 prefixLength() const { return m_prefixLength; }		
 		
 	  private:
-	   Char* m_pPrefix;
-		U32   m_prefixLength;
-		U32   m_maxLength;				
-		U64   m_count;
-		Spinlock m_lock;		
-		
-		
+		/**
+		 * @brief Write the name for a count into a buffer.
+		 * @param buffer The buffer, which must hold maxLength() characters.
+		 * @param val The count to encode.
+		 * @return The length of the name.
+		 */
+		Size encode(Char* buffer, U64 val) const;
 
+	   Char*     m_pPrefix;
+		U32       m_prefixLength;
+		U32       m_maxLength;				
+		OID       m_prefixOID;
+		AtomicU64 m_count;
 	};
 
 } // namespace Cat
@@ -14,6 +14,7 @@
 
 #include "core/util/objlist.h"
 #include "core/util/callable.h"
+#include "core/string/stringview.h"
 
 namespace Cat {
 	/**
@@ -126,6 +127,13 @@ namespace Cat {
 		 */
 		inline T* at(const Char* key) { return at(crc32(key)); }		
 
+		/**
+		 * @brief Access an element of the map via a view of its String key.
+		 * @param key The name of the element (string view).
+		 * @return A pointer to the element or NIL if it doesn't exist.
+		 */
+		inline T* at(const StringView& key) { return at(key.oID()); }
+
 		/**
 		 * @brief inserts the object in the map.
 		 * @param obj The object to insert into the map.
@@ -150,6 +158,13 @@ namespace Cat {
 		 * @return The object taken from the map or NIL if it wasn't in the map.
 		 */
 		inline T* take(const Char* name) { return take(crc32(name)); }
+
+		/**
+		 * @brief Removes and returns the object from the map.
+		 * @param key The view of the name of the object to take from the map.
+		 * @return The object taken from the map or NIL if it wasn't in the map.
+		 */
+		inline T* take(const StringView& key) { return take(key.oID()); }
 		
 		/**
 		 * @brief Removes and returns the object from the map.
@@ -176,7 +191,13 @@ namespace Cat {
 		 * @brief Removes the object from the map.
 		 * @param key The name of the object to remove from the map.
 		 */
-		inline void remove(const Char* name) { remove(crc32(key)); }		
+		inline void remove(const Char* name) { remove(crc32(name)); }		
+
+		/**
+		 * @brief Removes the object from the map.
+		 * @param key The view of the name of the object to remove from the map.
+		 */
+		inline void remove(const StringView& key) { remove(key.oID()); }
 
 		/**
 		 * @brief Removes the object from the map.
@@ -230,6 +251,15 @@ namespace Cat {
 			return contains(crc32(name));
 		}		
 
+		/**
+		 * @brief Tests to see if an object is the map.
+		 * @param key The view of the string key value of the object.
+		 * @return true if the object is in the map.
+		 */
+		inline Boolean contains(const StringView& key) const {
+			return contains(key.oID());
+		}
+
 		/**
 		 * @brief Tests to see if the given object is in the map.
 		 * @param obj The object to look for.
@@ -0,0 +1,154 @@
+#ifndef CAT_CORE_UTIL_SPSCRING_H
+#define CAT_CORE_UTIL_SPSCRING_H
+/**
+ * @copyright Copyright Catlin Zilinksi, 2014.  All rights reserved.
+ *
+ * @file spscring.h
+ * @brief A fixed size, wait-free, single producer single consumer ring buffer.
+ *
+ * @author Catlin Zilinski
+ * @date Oct 17, 2026
+ */
+
+#include "core/corelib.h"
+
+namespace Cat {
+
+	/**
+	 * @class SpscRing spscring.h "core/util/spscring.h"
+	 * @brief A fixed size, wait-free, single producer single consumer ring buffer.
+	 *
+	 * One thread may push() while another thread reads from the front and
+	 * pop()s, without any locks.  The head is only written by the producer
+	 * and the tail only by the consumer, each with release semantics, and
+	 * each side keeps a cached copy of the other side's index so it only
+	 * reads the shared one when the ring looks full (or empty).  The
+	 * capacity is rounded up to a power of two.
+	 *
+	 * @author Catlin Zilinski
+	 * @version 1
+	 * @since Oct 17, 2026
+	 */
+	template<typename T>
+	class SpscRing {
+	  public:
+		/**
+		 * @brief Create an empty ring with no storage.
+		 */
+		SpscRing()
+			: m_pItems(NIL), m_mask(0), m_head(0), m_cachedTail(0),
+			  m_tail(0), m_cachedHead(0) {}
+
+		/**
+		 * @brief Create a ring with the specified capacity.
+		 * @param capacity The minimum capacity of the ring.
+		 */
+		explicit SpscRing(Size capacity)
+			: m_pItems(NIL), m_mask(0), m_head(0), m_cachedTail(0),
+			  m_tail(0), m_cachedHead(0) {
+			initWithCapacity(capacity);
+		}
+
+		/**
+		 * @brief Destroys the storage and any items left in it.
+		 */
+		~SpscRing() {
+			if (m_pItems) {
+				delete[] m_pItems;
+				m_pItems = NIL;
+			}
+		}
+
+		/**
+		 * @brief Allocate the storage for the ring.  Not thread safe.
+		 * @param capacity The minimum capacity of the ring.
+		 */
+		void initWithCapacity(Size capacity) {
+			Size actual = 1;
+			while (actual < capacity) {
+				actual <<= 1;
+			}
+			if (m_pItems) {
+				delete[] m_pItems;
+			}
+			m_pItems = new T[actual];
+			m_mask = actual - 1;
+			m_head = m_cachedTail = m_tail = m_cachedHead = 0;
+		}
+
+		/**
+		 * @brief Get the capacity of the ring.
+		 * @return The number of items the ring can hold.
+		 */
+		inline Size capacity() const { return m_pItems ? m_mask + 1 : 0; }
+
+		/**
+		 * @brief Add an item to the ring.  Only call from the producer thread.
+		 * @param item The item to copy into the ring.
+		 * @return True if there was room for the item.
+		 */
+		inline Boolean push(const T& item) {
+			Size head = m_head;
+			if (head - m_cachedTail > m_mask) {
+				m_cachedTail = __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE);
+				if (head - m_cachedTail > m_mask) {
+					return false;
+				}
+			}
+			m_pItems[head & m_mask] = item;
+			__atomic_store_n(&m_head, head + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+
+		/**
+		 * @brief Get the number of items the consumer can read.  Only call from the consumer thread.
+		 * @return The number of items in the ring.
+		 */
+		inline Size available() {
+			m_cachedHead = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+			return m_cachedHead - m_tail;
+		}
+
+		/**
+		 * @brief Check to see if the ring is empty.  Only call from the consumer thread.
+		 * @return True if there is nothing for the consumer to read.
+		 */
+		inline Boolean isEmpty() {
+			return m_cachedHead == m_tail && available() == 0;
+		}
+
+		/**
+		 * @brief Get the item at the front of the ring.  Only call from
+		 * the consumer thread, once it knows the ring is not empty.
+		 * @return A reference to the front item, valid until it is popped.
+		 */
+		inline T& front() { return m_pItems[m_tail & m_mask]; }
+
+		/**
+		 * @brief Remove the item at the front of the ring, handing its
+		 * slot back to the producer.  Only call from the consumer thread.
+		 */
+		inline void pop() {
+			__atomic_store_n(&m_tail, m_tail + 1, __ATOMIC_RELEASE);
+		}
+
+	  private:
+		SpscRing(const SpscRing& src);
+		SpscRing& operator=(const SpscRing& src);
+
+		T* m_pItems;
+		Size m_mask;
+
+		/* Producer side, kept on a separate cache line from the consumer side */
+		Size m_head;
+		Size m_cachedTail;
+		Byte m_padding[64 - 2*sizeof(Size)];
+
+		/* Consumer side */
+		Size m_tail;
+		Size m_cachedHead;
+	};
+
+} // namespace Cat
+
+#endif // CAT_CORE_UTIL_SPSCRING_H
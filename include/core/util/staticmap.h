@@ -16,6 +16,7 @@
 #include <cmath>
 #include <cstring>
 #include "core/corelib.h"
+#include "core/string/stringview.h"
 
 namespace Cat {
 
@@ -108,6 +109,15 @@ namespace Cat {
 			return at(crc32(key));
 		}		
 
+		/**
+		 * @brief Access an element of the map via a view of its String key.
+		 * @param key The name of the element (string view).
+		 * @return The element or the null element.
+		 */
+		inline T at(const StringView& key) const {
+			return at(key.oID());
+		}
+
 		/**
 		 * @brief Access an element of the map via its crc32 object id.
 		 * @param key The name of the element (string).
@@ -138,6 +148,15 @@ namespace Cat {
 			return contains(crc32(key));
 		}		
 
+		/**
+		 * @brief Tests to see if an object is the map.
+		 * @param key The view of the string key value of the object.
+		 * @return true if the object is in the map.
+		 */
+		inline Boolean contains(const StringView& key) const {
+			return contains(key.oID());
+		}
+
 		/**
 		 * @brief Tests to see if an object is in the map.
 		 * @param key The OID key value of the object.
@@ -174,6 +193,9 @@ namespace Cat {
 		inline void insert(const Char* key, T value) {
 			insert(crc32(key), value);
 		}
+		inline void insert(const StringView& key, T value) {
+			insert(key.oID(), value);
+		}
 		
 		/**
 		 * @brief Test if the map is empty or not
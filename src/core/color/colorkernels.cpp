@@ -0,0 +1,461 @@
+#include "core/color/colorkernels.h"
+#include "core/sys/cpu.h"
+#include <cmath>
+
+namespace Cat {
+
+	/*************************************************************
+	 * Lookup tables
+	 *************************************************************/
+
+	static const I32 kSrgbTableSize = 16384;
+	static const F32 kSrgbTableScale = REAL(16383.0);
+
+	/**
+	 * The [0 - 255] entries of toLinear decode sRGB, the [256 - 511]
+	 * entries are c / 255 for the (linear) alpha channel, so that one
+	 * lookup (or gather) with an offset for alpha converts a whole color.
+	 */
+	struct ColorTables {
+		F32 toLinear[512];
+		U8 toSrgb[kSrgbTableSize];
+
+		ColorTables() {
+			for (I32 i = 0; i < 256; ++i) {
+				F64 c = (F64)i / 255.0;
+				F64 linear = c <= 0.04045 ? c / 12.92 : ::pow((c + 0.055) / 1.055, 2.4);
+				toLinear[i] = (F32)linear;
+				toLinear[256 + i] = (F32)i / REAL(255.0);
+			}
+			for (I32 i = 0; i < kSrgbTableSize; ++i) {
+				F64 x = (F64)i / (F64)(kSrgbTableSize - 1);
+				F64 srgb = x <= 0.0031308 ? x * 12.92 : 1.055 * ::pow(x, 1.0 / 2.4) - 0.055;
+				I32 v = (I32)(srgb * 255.0 + 0.5);
+				toSrgb[i] = (U8)(v < 0 ? 0 : (v > 255 ? 255 : v));
+			}
+		}
+	};
+
+	static const ColorTables& colorTables() {
+		static const ColorTables s_tables;
+		return s_tables;
+	}
+
+	/**
+	 * The Porter-Duff factors, Fa = k0 + k1*Ad and Fb = m0 + m1*As.
+	 */
+	static const F32 s_blendFactors[ColorKernels::kNumBlendModes][4] = {
+		{ 0,  0, 0,  0 },	/* kClear */
+		{ 1,  0, 0,  0 },	/* kSrc */
+		{ 0,  0, 1,  0 },	/* kDst */
+		{ 1,  0, 1, -1 },	/* kSrcOver */
+		{ 1, -1, 1,  0 },	/* kDstOver */
+		{ 0,  1, 0,  0 },	/* kSrcIn */
+		{ 0,  0, 0,  1 },	/* kDstIn */
+		{ 1, -1, 0,  0 },	/* kSrcOut */
+		{ 0,  0, 1, -1 },	/* kDstOut */
+		{ 0,  1, 1, -1 },	/* kSrcAtop */
+		{ 1, -1, 0,  1 },	/* kDstAtop */
+		{ 1, -1, 1, -1 },	/* kXor */
+		{ 1,  0, 1,  0 }	/* kPlus */
+	};
+
+	static inline const F32* blendFactors(ColorKernels::BlendMode mode) {
+		if ((U32)mode >= (U32)ColorKernels::kNumBlendModes) {
+			DWARN("Invalid color blend mode: " << (I32)mode << "!");
+			return NIL;
+		}
+		return s_blendFactors[mode];
+	}
+
+	/*************************************************************
+	 * Scalar kernels
+	 *
+	 * The min and max are written the same way as the SSE minps and
+	 * maxps (which also send NaN to the second argument), and the
+	 * rounding is a truncation of c*scale + 0.5, as cvttps does.
+	 *************************************************************/
+
+	static inline F32 maxf(F32 a, F32 b) { return a > b ? a : b; }
+	static inline F32 minf(F32 a, F32 b) { return a < b ? a : b; }
+
+	static inline F32 clamp01(F32 c) {
+		return minf(maxf(c, REAL(0.0)), REAL(1.0));
+	}
+
+	static inline UByte toByte(F32 c) {
+		return (UByte)(I32)(clamp01(c) * REAL(255.0) + REAL(0.5));
+	}
+
+	static inline UByte toSrgbByte(const ColorTables& tables, F32 c) {
+		return tables.toSrgb[(I32)(clamp01(c) * kSrgbTableScale + REAL(0.5))];
+	}
+
+	/* Exactly round(x / 255) for x in [0 - 255*255] */
+	static inline U32 div255(U32 x) {
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	static void scalarUnpack(const Color4b* src, Color4f* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Color4b c = src[i];
+			dst[i].set((F32)c.r / REAL(255.0), (F32)c.g / REAL(255.0),
+						  (F32)c.b / REAL(255.0), (F32)c.a / REAL(255.0));
+		}
+	}
+
+	static void scalarPack(const Color4f* src, Color4b* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Color4f c = src[i];
+			dst[i].set(toByte(c.r), toByte(c.g), toByte(c.b), toByte(c.a));
+		}
+	}
+
+	static void scalarSrgbToLinear(const Color4b* src, Color4f* dst, Size count) {
+		const F32* toLinear = colorTables().toLinear;
+		for (Size i = 0; i < count; ++i) {
+			Color4b c = src[i];
+			dst[i].set(toLinear[c.r], toLinear[c.g], toLinear[c.b], toLinear[256 + c.a]);
+		}
+	}
+
+	static void scalarLinearToSrgb(const Color4f* src, Color4b* dst, Size count) {
+		const ColorTables& tables = colorTables();
+		for (Size i = 0; i < count; ++i) {
+			Color4f c = src[i];
+			dst[i].set(toSrgbByte(tables, c.r), toSrgbByte(tables, c.g),
+						  toSrgbByte(tables, c.b), toByte(c.a));
+		}
+	}
+
+	static void scalarPremultiply(const Color4f* src, Color4f* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Color4f c = src[i];
+			dst[i].set(c.r * c.a, c.g * c.a, c.b * c.a, c.a);
+		}
+	}
+
+	static void scalarUnpremultiply(const Color4f* src, Color4f* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Color4f c = src[i];
+			if (c.a > REAL(0.0)) {
+				dst[i].set(c.r / c.a, c.g / c.a, c.b / c.a, c.a);
+			} else {
+				dst[i].set(REAL(0.0), REAL(0.0), REAL(0.0), c.a);
+			}
+		}
+	}
+
+	static void scalarPremultiplyBytes(const Color4b* src, Color4b* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Color4b c = src[i];
+			dst[i].set((UByte)div255(c.r * c.a), (UByte)div255(c.g * c.a),
+						  (UByte)div255(c.b * c.a), c.a);
+		}
+	}
+
+	static void scalarBlend(const Color4f* src, Color4f* dst, Size count,
+									ColorKernels::BlendMode mode) {
+		const F32* f = blendFactors(mode);
+		if (!f) {
+			return;
+		}
+		for (Size i = 0; i < count; ++i) {
+			Color4f s = src[i];
+			Color4f d = dst[i];
+			F32 fa = f[0] + f[1]*d.a;
+			F32 fb = f[2] + f[3]*s.a;
+			dst[i].set(s.r*fa + d.r*fb, s.g*fa + d.g*fb, s.b*fa + d.b*fb, s.a*fa + d.a*fb);
+		}
+	}
+
+	static inline UByte blendOverByte(UByte s, UByte d, U32 ia) {
+		U32 v = s + div255(d * ia);
+		return (UByte)(v > 255 ? 255 : v);
+	}
+
+	static void scalarBlendOverBytes(const Color4b* src, Color4b* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Color4b s = src[i];
+			Color4b d = dst[i];
+			U32 ia = 255 - s.a;
+			dst[i].set(blendOverByte(s.r, d.r, ia), blendOverByte(s.g, d.g, ia),
+						  blendOverByte(s.b, d.b, ia), blendOverByte(s.a, d.a, ia));
+		}
+	}
+
+	static const ColorKernels::Table s_scalarTable = {
+		scalarUnpack,
+		scalarPack,
+		scalarSrgbToLinear,
+		scalarLinearToSrgb,
+		scalarPremultiply,
+		scalarUnpremultiply,
+		scalarPremultiplyBytes,
+		scalarBlend,
+		scalarBlendOverBytes,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/*************************************************************
+	 * SSE2 kernels
+	 *
+	 * A Color4f is exactly one vector, and four Color4b are one
+	 * vector, so the float kernels work on one color per vector and
+	 * the byte kernels on four.  SSE2 has no gather, so decoding
+	 * sRGB uses the scalar table lookups.
+	 *************************************************************/
+
+	static inline __m128 sse2Clamp01(__m128 c) {
+		return _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set1_ps(REAL(1.0)));
+	}
+
+	static inline __m128i sse2ToBytes(__m128 c) {
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(sse2Clamp01(c), _mm_set1_ps(REAL(255.0))),
+													  _mm_set1_ps(REAL(0.5))));
+	}
+
+	static inline __m128 sse2RgbMask() {
+		return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	}
+
+	static inline __m128 sse2AlphaMask() {
+		return _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	}
+
+	/* round(x / 255) of each 16 bit lane */
+	static inline __m128i sse2Div255(__m128i x) {
+		x = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	/* Broadcast the alpha of each of the two colors in 16 bit lanes */
+	static inline __m128i sse2Alpha16(__m128i c) {
+		return _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)),
+											_MM_SHUFFLE(3, 3, 3, 3));
+	}
+
+	static void sse2Unpack(const Color4b* src, Color4f* dst, Size count) {
+		__m128i zero = _mm_setzero_si128();
+		__m128 scale = _mm_set1_ps(REAL(255.0));
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i px = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i lo = _mm_unpacklo_epi8(px, zero);
+			__m128i hi = _mm_unpackhi_epi8(px, zero);
+			_mm_storeu_ps(&dst[i].r, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+			_mm_storeu_ps(&dst[i+1].r, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+			_mm_storeu_ps(&dst[i+2].r, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+			_mm_storeu_ps(&dst[i+3].r, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+		}
+		scalarUnpack(src + i, dst + i, count - i);
+	}
+
+	static void sse2Pack(const Color4f* src, Color4b* dst, Size count) {
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i c0 = sse2ToBytes(_mm_loadu_ps(&src[i].r));
+			__m128i c1 = sse2ToBytes(_mm_loadu_ps(&src[i+1].r));
+			__m128i c2 = sse2ToBytes(_mm_loadu_ps(&src[i+2].r));
+			__m128i c3 = sse2ToBytes(_mm_loadu_ps(&src[i+3].r));
+			__m128i px = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+			_mm_storeu_si128((__m128i*)(dst + i), px);
+		}
+		scalarPack(src + i, dst + i, count - i);
+	}
+
+	static void sse2LinearToSrgb(const Color4f* src, Color4b* dst, Size count) {
+		const ColorTables& tables = colorTables();
+		/* The colors use the sRGB table index, the alpha the 8 bit value */
+		__m128 scale = _mm_set_ps(REAL(255.0), kSrgbTableScale, kSrgbTableScale, kSrgbTableScale);
+		__m128 half = _mm_set1_ps(REAL(0.5));
+		I32 CAT_ALIGN(16) idx[4];
+		for (Size i = 0; i < count; ++i) {
+			__m128 c = sse2Clamp01(_mm_loadu_ps(&src[i].r));
+			_mm_store_si128((__m128i*)idx, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, scale), half)));
+			dst[i].set(tables.toSrgb[idx[0]], tables.toSrgb[idx[1]], tables.toSrgb[idx[2]],
+						  (UByte)idx[3]);
+		}
+	}
+
+	static void sse2Premultiply(const Color4f* src, Color4f* dst, Size count) {
+		__m128 rgbMask = sse2RgbMask();
+		__m128 alphaMask = sse2AlphaMask();
+		for (Size i = 0; i < count; ++i) {
+			__m128 c = _mm_loadu_ps(&src[i].r);
+			__m128 m = _mm_mul_ps(c, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)));
+			_mm_storeu_ps(&dst[i].r, _mm_or_ps(_mm_and_ps(rgbMask, m), _mm_and_ps(alphaMask, c)));
+		}
+	}
+
+	static void sse2Unpremultiply(const Color4f* src, Color4f* dst, Size count) {
+		__m128 rgbMask = sse2RgbMask();
+		__m128 alphaMask = sse2AlphaMask();
+		__m128 zero = _mm_setzero_ps();
+		for (Size i = 0; i < count; ++i) {
+			__m128 c = _mm_loadu_ps(&src[i].r);
+			__m128 a = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 q = _mm_and_ps(_mm_cmpgt_ps(a, zero), _mm_div_ps(c, a));
+			_mm_storeu_ps(&dst[i].r, _mm_or_ps(_mm_and_ps(rgbMask, q), _mm_and_ps(alphaMask, c)));
+		}
+	}
+
+	static void sse2PremultiplyBytes(const Color4b* src, Color4b* dst, Size count) {
+		__m128i zero = _mm_setzero_si128();
+		__m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i px = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i lo = _mm_unpacklo_epi8(px, zero);
+			__m128i hi = _mm_unpackhi_epi8(px, zero);
+			__m128i mlo = sse2Div255(_mm_mullo_epi16(lo, sse2Alpha16(lo)));
+			__m128i mhi = sse2Div255(_mm_mullo_epi16(hi, sse2Alpha16(hi)));
+			mlo = _mm_or_si128(_mm_andnot_si128(alphaMask, mlo), _mm_and_si128(alphaMask, lo));
+			mhi = _mm_or_si128(_mm_andnot_si128(alphaMask, mhi), _mm_and_si128(alphaMask, hi));
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(mlo, mhi));
+		}
+		scalarPremultiplyBytes(src + i, dst + i, count - i);
+	}
+
+	static void sse2Blend(const Color4f* src, Color4f* dst, Size count,
+								 ColorKernels::BlendMode mode) {
+		const F32* f = blendFactors(mode);
+		if (!f) {
+			return;
+		}
+		__m128 k0 = _mm_set1_ps(f[0]);
+		__m128 k1 = _mm_set1_ps(f[1]);
+		__m128 m0 = _mm_set1_ps(f[2]);
+		__m128 m1 = _mm_set1_ps(f[3]);
+		for (Size i = 0; i < count; ++i) {
+			__m128 s = _mm_loadu_ps(&src[i].r);
+			__m128 d = _mm_loadu_ps(&dst[i].r);
+			__m128 fa = _mm_add_ps(k0, _mm_mul_ps(k1, _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3))));
+			__m128 fb = _mm_add_ps(m0, _mm_mul_ps(m1, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3))));
+			_mm_storeu_ps(&dst[i].r, _mm_add_ps(_mm_mul_ps(s, fa), _mm_mul_ps(d, fb)));
+		}
+	}
+
+	static void sse2BlendOverBytes(const Color4b* src, Color4b* dst, Size count) {
+		__m128i zero = _mm_setzero_si128();
+		__m128i k255 = _mm_set1_epi16(255);
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+			__m128i slo = _mm_unpacklo_epi8(s, zero);
+			__m128i shi = _mm_unpackhi_epi8(s, zero);
+			__m128i dlo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(k255, sse2Alpha16(slo)));
+			__m128i dhi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(k255, sse2Alpha16(shi)));
+			/* The pack saturates to 255, like the scalar clamp */
+			_mm_storeu_si128((__m128i*)(dst + i),
+								  _mm_packus_epi16(_mm_add_epi16(slo, sse2Div255(dlo)),
+														 _mm_add_epi16(shi, sse2Div255(dhi))));
+		}
+		scalarBlendOverBytes(src + i, dst + i, count - i);
+	}
+
+	static const ColorKernels::Table s_sse2Table = {
+		sse2Unpack,
+		sse2Pack,
+		scalarSrgbToLinear,
+		sse2LinearToSrgb,
+		sse2Premultiply,
+		sse2Unpremultiply,
+		sse2PremultiplyBytes,
+		sse2Blend,
+		sse2BlendOverBytes,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * AVX2 kernels
+	 *
+	 * Two float colors per vector.  Decoding sRGB gathers whole
+	 * colors from the lookup table, with the alpha offset into the
+	 * linear half of the table.
+	 *************************************************************/
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2SrgbToLinear(const Color4b* src, Color4f* dst,
+																		 Size count) {
+		const F32* toLinear = colorTables().toLinear;
+		__m256i alphaOffset = _mm256_set_epi32(256, 0, 0, 0, 256, 0, 0, 0);
+		Size i = 0;
+		for (; i + 2 <= count; i += 2) {
+			__m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+			_mm256_storeu_ps(&dst[i].r, _mm256_i32gather_ps(toLinear, _mm256_add_epi32(idx, alphaOffset), 4));
+		}
+		scalarSrgbToLinear(src + i, dst + i, count - i);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2Blend(const Color4f* src, Color4f* dst, Size count,
+																ColorKernels::BlendMode mode) {
+		const F32* f = blendFactors(mode);
+		if (!f) {
+			return;
+		}
+		__m256 k0 = _mm256_set1_ps(f[0]);
+		__m256 k1 = _mm256_set1_ps(f[1]);
+		__m256 m0 = _mm256_set1_ps(f[2]);
+		__m256 m1 = _mm256_set1_ps(f[3]);
+		Size i = 0;
+		for (; i + 2 <= count; i += 2) {
+			__m256 s = _mm256_loadu_ps(&src[i].r);
+			__m256 d = _mm256_loadu_ps(&dst[i].r);
+			__m256 fa = _mm256_add_ps(k0, _mm256_mul_ps(k1, _mm256_permute_ps(d, 0xFF)));
+			__m256 fb = _mm256_add_ps(m0, _mm256_mul_ps(m1, _mm256_permute_ps(s, 0xFF)));
+			_mm256_storeu_ps(&dst[i].r, _mm256_add_ps(_mm256_mul_ps(s, fa), _mm256_mul_ps(d, fb)));
+		}
+		sse2Blend(src + i, dst + i, count - i, mode);
+	}
+
+	static const ColorKernels::Table s_avx2Table = {
+		sse2Unpack,
+		sse2Pack,
+		avx2SrgbToLinear,
+		sse2LinearToSrgb,
+		sse2Premultiply,
+		sse2Unpremultiply,
+		sse2PremultiplyBytes,
+		avx2Blend,
+		sse2BlendOverBytes,
+		"avx2"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const ColorKernels::Table& ColorKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const ColorKernels::Table& ColorKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size ColorKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasAVX2()) {
+			tables[count++] = &s_avx2Table;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const ColorKernels::Table* ColorKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
@@ -91,12 +91,18 @@ namespace Cat {
 
 
 	OID crc32(const Char* str) {
-		const U8 *p = (U8*)str;
-		U32 crc = (U32)~0U;
+		return crc32(str, strlen(str));
+	}
 
-		Size size = strlen(str);
+	OID crc32(const Char* str, Size length) {
+		return crc32(0, str, length);
+	}
+
+	OID crc32(OID crc, const Char* str, Size length) {
+		const U8 *p = (U8*)str;
+		crc = crc ^ ~0U;
 
-		while (size--) {
+		while (length--) {
 			crc = crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
 		}
 
@@ -5,22 +5,27 @@ namespace Cat {
 	DeferredExec* DeferredExec::s_pGlobal = NIL;
 
 	DeferredExecCall::DeferredExecCall()
-		: m_pFunc(NIL), m_pObj(NIL) {
+		: m_pFunc(NIL), m_pObj(NIL), m_group(0) {
 		m_data.vPtr = NIL;
 	}
 
 	DeferredExecCall::DeferredExecCall(void (*p_func)(void*, IntegralType),
-												  void* p_obj, IntegralType p_data)
-		: m_pFunc(p_func), m_pObj(p_obj), m_data(p_data) {
-
+												  void* p_obj, IntegralType p_data, U32 p_group)
+		: m_pFunc(p_func), m_pObj(p_obj), m_data(p_data),
+		  m_group((p_group < HandlerGroups::kMaxGroups) ? p_group : 0) {
+		D_CONDERR(p_group >= HandlerGroups::kMaxGroups,
+					 "Handler group " << p_group << " is not less than " << HandlerGroups::kMaxGroups << ", using group 0!");
 	}
 
 
 	DeferredExec::DeferredExec()
-		: m_pCalls(NIL), m_pProcessing(NIL) {
+		: m_pCalls(NIL), m_pProcessing(NIL), m_pRunner(NIL), m_pDrained(NIL),
+		  m_numDrained(0) {
 	}
 
-	DeferredExec::DeferredExec(Size p_capacity) {
+	DeferredExec::DeferredExec(Size p_capacity)
+		: m_pRunner(NIL), m_numDrained(0) {
+		m_pDrained = new DeferredExecCall[p_capacity];
 		m_callsOne.initQueueWithCapacityAndNull(p_capacity, DeferredExecCall());
 		m_callsTwo.initQueueWithCapacityAndNull(p_capacity, DeferredExecCall());
 		m_pCalls = &m_callsOne;
@@ -37,6 +42,10 @@ namespace Cat {
 		}	  
 		m_pCalls = NIL;
 		m_pProcessing = NIL;		
+		if (m_pDrained) {
+			delete[] m_pDrained;
+			m_pDrained = NIL;
+		}
 		m_lock.unlock();		
 	}
 
@@ -48,11 +57,32 @@ namespace Cat {
 		m_pCalls = tmpForSwap;	
 		m_lock.unlock();
 
+		if (m_pRunner) {
+			/* The queue holds no more than its capacity, so neither does the drained array */
+			while (!m_pProcessing->isEmpty()) {
+				m_pDrained[m_numDrained++] = m_pProcessing->pop();
+			}
+			if (m_numDrained > 0) {
+				m_groups.run(m_pRunner, executeLane, this);
+			}
+			m_numDrained = 0;
+			return;
+		}
+
 		while (!m_pProcessing->isEmpty()) {
 		   m_pProcessing->pop().execute();
 		}
 	}
 
+	void DeferredExec::executeLane(VPtr p_obj, U32 p_groupMask) {
+		DeferredExec* exec = (DeferredExec*)p_obj;
+		for (Size i = 0; i < exec->m_numDrained; ++i) {
+			if ((1U << exec->m_pDrained[i].group()) & p_groupMask) {
+				exec->m_pDrained[i].execute();
+			}
+		}
+	}
+
 	void DeferredExec::initialiseGlobalDeferredExecQueue(Size p_capacity) {
 		if (s_pGlobal) {
 			DWARN("Cannot initialise global DeferredExec queue more than once!");
@@ -0,0 +1,174 @@
+#include "core/defer/handlergroups.h"
+#include "core/threading/asynctaskrunner.h"
+#include "core/threading/asynctask.h"
+#include "core/threading/taskbarrier.h"
+
+namespace Cat {
+
+	/**
+	 * @brief An AsyncTask to run one lane of a HandlerGroups fan-out.
+	 * Not destroyable: the HandlerGroups keeps and reuses its tasks, so a
+	 * dispatch does not allocate one per lane.
+	 */
+	class HandlerGroupsLaneTask : public AsyncTask {
+	  public:
+		HandlerGroupsLaneTask()
+			: m_pFunc(NIL), m_pObj(NIL), m_groupMask(0), m_pBarrier(NIL) {}
+
+		inline void setLane(HandlerGroups::LaneFunc func, VPtr obj, U32 groupMask,
+								  TaskBarrier* barrier) {
+			m_pFunc = func;
+			m_pObj = obj;
+			m_groupMask = groupMask;
+			m_pBarrier = barrier;
+		}
+
+		I32 run() {
+			m_pFunc(m_pObj, m_groupMask);
+			return 0;
+		}
+
+		/* The runner touches the task for the last time before calling this */
+		void onCompletion() {
+			m_pBarrier->arrive();
+		}
+
+	  private:
+		HandlerGroups::LaneFunc m_pFunc;
+		VPtr m_pObj;
+		U32 m_groupMask;
+		TaskBarrier* m_pBarrier;
+	};
+
+	HandlerGroups::HandlerGroups() {
+		for (U32 i = 0; i < kMaxGroups; ++i) {
+			m_pTasks[i] = NIL;
+		}
+		reset();
+	}
+
+	HandlerGroups::~HandlerGroups() {
+		for (U32 i = 0; i < kMaxGroups; ++i) {
+			if (m_pTasks[i]) {
+				delete m_pTasks[i];
+				m_pTasks[i] = NIL;
+			}
+		}
+	}
+
+	void HandlerGroups::declareGroup(U32 group, U64 readSet, U64 writeSet) {
+		D_CONDERR(group >= kMaxGroups, "Handler group " << group << " is not less than " << kMaxGroups << "!");
+		if (group < kMaxGroups) {
+			m_declared |= (1U << group);
+			m_readSets[group] = readSet;
+			m_writeSets[group] = writeSet;
+			m_dirty = true;
+		}
+	}
+
+	void HandlerGroups::reset() {
+		m_declared = 0;
+		for (U32 i = 0; i < kMaxGroups; ++i) {
+			m_readSets[i] = 0;
+			m_writeSets[i] = 0;
+			m_laneMasks[i] = 0;
+		}
+		m_laneMasks[0] = kAllGroups;
+		m_numLanes = 1;
+		m_dirty = false;
+	}
+
+	U32 HandlerGroups::numLanes() {
+		if (m_dirty) {
+			computeLanes();
+		}
+		return m_numLanes;
+	}
+
+	U32 HandlerGroups::laneMask(U32 lane) {
+		if (m_dirty) {
+			computeLanes();
+		}
+		return (lane < m_numLanes) ? m_laneMasks[lane] : 0;
+	}
+
+	void HandlerGroups::run(AsyncTaskRunner* runner, LaneFunc func, VPtr obj) {
+		if (m_dirty) {
+			computeLanes();
+		}
+		if (!runner || m_numLanes == 1) {
+			func(obj, kAllGroups);
+			return;
+		}
+
+		TaskBarrier barrier(m_numLanes - 1);
+		for (U32 lane = 1; lane < m_numLanes; ++lane) {
+			if (!m_pTasks[lane]) {
+				m_pTasks[lane] = new HandlerGroupsLaneTask();
+			}
+			m_pTasks[lane]->setLane(func, obj, m_laneMasks[lane], &barrier);
+			/* A stopped runner does not take the lane, so run it here */
+			if (!runner->queue(m_pTasks[lane])) {
+				func(obj, m_laneMasks[lane]);
+				barrier.arrive();
+			}
+		}
+		func(obj, m_laneMasks[0]);
+		barrier.wait();
+	}
+
+	Boolean HandlerGroups::conflicts(U32 a, U32 b) const {
+		Boolean declaredA = (m_declared & (1U << a)) != 0;
+		Boolean declaredB = (m_declared & (1U << b)) != 0;
+		if (!declaredA || !declaredB) {
+			/* The undeclared groups run with group 0 */
+			return (!declaredA || a == 0) && (!declaredB || b == 0);
+		}
+		return ((m_writeSets[a] & (m_readSets[b] | m_writeSets[b])) != 0 ||
+				  (m_writeSets[b] & m_readSets[a]) != 0);
+	}
+
+	void HandlerGroups::computeLanes() {
+		/* Union the conflicting groups, each root being the lowest group in its lane */
+		U32 root[kMaxGroups];
+		for (U32 i = 0; i < kMaxGroups; ++i) {
+			root[i] = i;
+			for (U32 j = 0; j < i; ++j) {
+				if (conflicts(i, j)) {
+					U32 ri = root[i];
+					U32 rj = root[j];
+					while (root[ri] != ri) { ri = root[ri]; }
+					while (root[rj] != rj) { rj = root[rj]; }
+					if (ri < rj) {
+						root[rj] = ri;
+					} else {
+						root[ri] = rj;
+					}
+				}
+			}
+		}
+
+		m_numLanes = 0;
+		for (U32 i = 0; i < kMaxGroups; ++i) {
+			U32 r = i;
+			while (root[r] != r) { r = root[r]; }
+			if (r == i) {
+				m_laneMasks[m_numLanes++] = 0;
+			}
+		}
+		/* Lanes are numbered in the order of their roots, so group 0 is in lane 0 */
+		for (U32 i = 0; i < kMaxGroups; ++i) {
+			U32 r = i;
+			while (root[r] != r) { r = root[r]; }
+			U32 lane = 0;
+			for (U32 k = 0; k < r; ++k) {
+				if (root[k] == k) {
+					++lane;
+				}
+			}
+			m_laneMasks[lane] |= (1U << i);
+		}
+		m_dirty = false;
+	}
+
+} // namespace Cat
@@ -3,7 +3,7 @@
 
 namespace Cat {
 	Message::Message(I32 p_type, Byte* p_data)
-		: m_type(p_type), m_pSender(NIL) {
+		: m_type(p_type), m_pSender(NIL), m_pPayload(NIL), m_payloadSize(0) {
 		m_time = Time::currentTimeNano();
 		if (p_data) {
 			memcpy(m_pData, p_data, MESSAGE_DATA_SIZE);
@@ -14,7 +14,7 @@ namespace Cat {
 	}
 
 	Message::Message(I32 p_type, void* p_sender, Byte* p_data)
-		: m_type(p_type), m_pSender(p_sender) {
+		: m_type(p_type), m_pSender(p_sender), m_pPayload(NIL), m_payloadSize(0) {
 		m_time = Time::currentTimeNano();
 		if (p_data) {
 			memcpy(m_pData, p_data, MESSAGE_DATA_SIZE);
@@ -24,7 +24,15 @@ namespace Cat {
 		}			
 	}
 
+	Message::Message(I32 p_type, void* p_sender, Byte* p_payload, U32 p_payloadSize)
+		: m_type(p_type), m_pSender(p_sender), m_pPayload(p_payload),
+		  m_payloadSize(p_payloadSize) {
+		m_time = Time::currentTimeNano();
+	}
+
 	void Message::setData(Byte* p_data) {
+		m_pPayload = NIL;
+		m_payloadSize = 0;
 		if (p_data) {
 			memcpy(m_pData, p_data, MESSAGE_DATA_SIZE);
 		}
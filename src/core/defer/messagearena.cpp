@@ -0,0 +1,28 @@
+#include "core/defer/messagearena.h"
+
+namespace Cat {
+
+	MessageArena::MessageArena()
+		: m_pMemory(NIL), m_pUnaligned(NIL), m_capacity(0), m_offset(0) {
+	}
+
+	MessageArena::~MessageArena() {
+		if (m_pUnaligned) {
+			delete[] m_pUnaligned;
+			m_pUnaligned = NIL;
+			m_pMemory = NIL;
+		}
+	}
+
+	void MessageArena::initWithCapacity(Size capacity) {
+		if (m_pUnaligned) {
+			delete[] m_pUnaligned;
+		}
+		m_capacity = (capacity + kAlignment - 1) & ~(kAlignment - 1);
+		m_pUnaligned = new Byte[m_capacity + kAlignment];
+		Size addr = (Size)m_pUnaligned;
+		m_pMemory = m_pUnaligned + ((kAlignment - (addr & (kAlignment - 1))) & (kAlignment - 1));
+		m_offset = 0;
+	}
+
+} // namespace Cat
@@ -0,0 +1,111 @@
+#include <cstring>
+#include "core/defer/messagehandlertable.h"
+
+namespace Cat {
+
+	MessageHandlerTable::MessageHandlerTable()
+		: m_pCollected(NIL), m_numCollected(0), m_collectedCapacity(0) {
+		m_any.pHandlers = m_bySender.pHandlers = m_batch.pHandlers = NIL;
+		m_any.count = m_bySender.count = m_batch.count = 0;
+		m_any.capacity = m_bySender.capacity = m_batch.capacity = 0;
+	}
+
+	MessageHandlerTable::~MessageHandlerTable() {
+		destroy(m_any);
+		destroy(m_bySender);
+		destroy(m_batch);
+		if (m_pCollected) {
+			delete[] m_pCollected;
+			m_pCollected = NIL;
+		}
+	}
+
+	void MessageHandlerTable::append(const MessageHandler& handler) {
+		appendTo(arrayFor(handler), handler);
+	}
+
+	Boolean MessageHandlerTable::remove(const MessageHandler& handler) {
+		HandlerArray& array = arrayFor(handler);
+		I32 idx = find(array, handler);
+		if (idx < 0) {
+			return false;
+		}
+		--array.count;
+		memmove(&(array.pHandlers[idx]), &(array.pHandlers[idx + 1]),
+				  sizeof(MessageHandler)*(array.count - (Size)idx));
+		return true;
+	}
+
+	Boolean MessageHandlerTable::setActive(const MessageHandler& handler, Boolean active) {
+		HandlerArray& array = arrayFor(handler);
+		I32 idx = find(array, handler);
+		if (idx < 0) {
+			return false;
+		}
+		array.pHandlers[idx].setActive(active);
+		return true;
+	}
+
+	void MessageHandlerTable::clear() {
+		m_any.count = m_bySender.count = m_batch.count = 0;
+		m_numCollected = 0;
+	}
+
+	Boolean MessageHandlerTable::collect(const Message& message) {
+		if (m_numCollected == m_collectedCapacity) {
+			Size capacity = (m_collectedCapacity > 0) ? m_collectedCapacity*2 : 16;
+			Message* collected = new Message[capacity];
+			for (Size i = 0; i < m_numCollected; ++i) {
+				collected[i] = m_pCollected[i];
+			}
+			if (m_pCollected) {
+				delete[] m_pCollected;
+			}
+			m_pCollected = collected;
+			m_collectedCapacity = capacity;
+		}
+		m_pCollected[m_numCollected++] = message;
+		return m_numCollected == 1;
+	}
+
+	void MessageHandlerTable::flush() {
+		if (m_numCollected > 0) {
+			dispatchBatch(m_pCollected, m_numCollected);
+			m_numCollected = 0;
+		}
+	}
+
+	void MessageHandlerTable::appendTo(HandlerArray& array, const MessageHandler& handler) {
+		if (array.count == array.capacity) {
+			Size capacity = (array.capacity > 0) ? array.capacity*2 : 4;
+			MessageHandler* handlers = new MessageHandler[capacity];
+			if (array.count > 0) {
+				memcpy(handlers, array.pHandlers, sizeof(MessageHandler)*array.count);
+			}
+			if (array.pHandlers) {
+				delete[] array.pHandlers;
+			}
+			array.pHandlers = handlers;
+			array.capacity = capacity;
+		}
+		array.pHandlers[array.count++] = handler;
+	}
+
+	I32 MessageHandlerTable::find(const HandlerArray& array, const MessageHandler& handler) {
+		for (Size i = 0; i < array.count; ++i) {
+			if (array.pHandlers[i] == handler) {
+				return (I32)i;
+			}
+		}
+		return -1;
+	}
+
+	void MessageHandlerTable::destroy(HandlerArray& array) {
+		if (array.pHandlers) {
+			delete[] array.pHandlers;
+			array.pHandlers = NIL;
+		}
+		array.count = array.capacity = 0;
+	}
+
+} // namespace Cat
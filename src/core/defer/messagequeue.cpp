@@ -1,4 +1,5 @@
 #include "core/defer/messagequeue.h"
+#include "core/threading/thread.h"
 
 namespace Cat {
 
@@ -6,14 +7,39 @@ namespace Cat {
 
 	MessageQueue::MessageQueue()
 		: m_pMessages(NIL), m_pProcessing(NIL), m_maxMessageTypeID(0),
-		  m_pHandlers(NIL) {
+		  m_pHandlers(NIL), m_pBatchTypes(NIL), m_numBatchTypes(0),
+		  m_flags(kMQFNone), m_pRings(NIL), m_pRingCounts(NIL),
+		  m_maxProducers(0), m_numRings(0), m_currentArena(0), m_pRunner(NIL),
+		  m_pDrained(NIL), m_numDrained(0), m_drainedCapacity(0) {
+		m_numPosting[0] = m_numPosting[1] = 0;
 	}
 
-	MessageQueue::MessageQueue(U32 capacity, I32 maxMessageTypeID) {
-		m_messagesOne.initQueueWithCapacityAndNull(capacity, Message());
-		m_messagesTwo.initQueueWithCapacityAndNull(capacity, Message());
-		m_pMessages = &m_messagesOne;
-		m_pProcessing = &m_messagesTwo;
+	MessageQueue::MessageQueue(U32 capacity, I32 maxMessageTypeID, U32 flags,
+										U32 maxProducers, Size arenaSize)
+		: m_pMessages(NIL), m_pProcessing(NIL), m_pBatchTypes(NIL),
+		  m_numBatchTypes(0), m_flags(flags), m_pRings(NIL),
+		  m_pRingCounts(NIL), m_maxProducers(0), m_numRings(0), m_currentArena(0),
+		  m_pRunner(NIL), m_pDrained(NIL), m_numDrained(0), m_drainedCapacity(0) {
+		m_numPosting[0] = m_numPosting[1] = 0;
+		if (arenaSize > 0) {
+			m_arenas[0].initWithCapacity(arenaSize);
+			m_arenas[1].initWithCapacity(arenaSize);
+		}
+		if (flags & kMQFPerThreadRings) {
+			/* The rings replace the two swapped queues */
+			m_maxProducers = (maxProducers > 0) ? maxProducers : 1;
+			m_pRings = new ProducerRing[m_maxProducers];
+			m_pRingCounts = new Size[m_maxProducers];
+			for (U32 i = 0; i < m_maxProducers; ++i) {
+				m_pRings[i].messages.initWithCapacity(capacity);
+				m_pRingCounts[i] = 0;
+			}
+		} else {
+			m_messagesOne.initQueueWithCapacityAndNull(capacity, Message());
+			m_messagesTwo.initQueueWithCapacityAndNull(capacity, Message());
+			m_pMessages = &m_messagesOne;
+			m_pProcessing = &m_messagesTwo;
+		}
 		m_maxMessageTypeID = maxMessageTypeID;
 		initHandlerList();
 		m_internalMessageQueue.initQueueWithCapacityAndNull(
@@ -32,52 +58,286 @@ namespace Cat {
 		}	  
 		m_pMessages = NIL;
 		m_pProcessing = NIL;		
+		if (m_pRings) {
+			delete[] m_pRings;
+			delete[] m_pRingCounts;
+			m_pRings = NIL;
+			m_pRingCounts = NIL;
+		}
+		m_numRings = 0;
+		if (m_pDrained) {
+			delete[] m_pDrained;
+			m_pDrained = NIL;
+		}
 		if (m_pHandlers) {			
 			delete[] m_pHandlers;
+			delete[] m_pBatchTypes;
 			m_pHandlers = NIL;			
+			m_pBatchTypes = NIL;
 		}
 		m_maxMessageTypeID = 0;
 		m_lock.unlock();		
 	}
 
 	void MessageQueue::processMessages() {
+		if (m_pRings) {
+			processInternalMessages();
+			processRings();
+			return;
+		}
+
 		/* Swap the queues to prevent infinite queuing */
 		SimpleQueue<Message>* tmpForSwap = m_pProcessing;		
 		m_lock.lock();
 		m_pProcessing = m_pMessages;
 		m_pMessages = tmpForSwap;	
+		U32 arena = swapArenas();
 		m_lock.unlock();
 		/* Process any internal messages. */
 		processInternalMessages();		
 
+		Message message;
 		while (!m_pProcessing->isEmpty()) {
-			triggerMessage(m_pProcessing->pop());
+			message = m_pProcessing->pop();
+			consumeMessage(message);
 		}
+		finishBatch();
+		/* Every payload in the arena belonged to a message just handled */
+		m_arenas[arena].reset();
 	}
 
-	void MessageQueue::triggerMessage(Message& message) {
-		if (m_pHandlers[message.type()].size() > 0) {
-			List<MessageHandler>::Iterator itr = m_pHandlers[message.type()].begin();
-			while (itr.isValid()) {
-				if (itr.val().shouldHandleMessage(message.sender())) {
-					itr.val().handleMessage(message);
+	void MessageQueue::releaseProducer() {
+		if (!m_pRings) {
+			return;
+		}
+		ProducerRing* ring = findProducerRing();
+		if (ring) {
+			/* The consumer keeps draining it, and the next owner carries on from its head */
+			__atomic_store_n(&ring->state, (U32)kPRSFree, __ATOMIC_RELEASE);
+		}
+	}
+
+	Boolean MessageQueue::postToRing(const Message& message) {
+		ProducerRing* ring = findProducerRing();
+		if (!ring) {
+			ring = claimProducerRing();
+			if (!ring) {
+				return false;
+			}
+		}
+		return ring->messages.push(message);
+	}
+
+	MessageQueue::ProducerRing* MessageQueue::findProducerRing() {
+		ThreadHandle self = Thread::self();
+		U32 numRings = __atomic_load_n(&m_numRings, __ATOMIC_ACQUIRE);
+		for (U32 i = 0; i < numRings; ++i) {
+			/* The ring can be released and claimed by another thread between the two loads */
+			if (__atomic_load_n(&m_pRings[i].state, __ATOMIC_ACQUIRE) == kPRSOwned &&
+				 equals(__atomic_load_n(&m_pRings[i].owner, __ATOMIC_ACQUIRE), self)) {
+				return &m_pRings[i];
+			}
+		}
+		return NIL;
+	}
+
+	MessageQueue::ProducerRing* MessageQueue::claimProducerRing() {
+		for (U32 i = 0; i < m_maxProducers; ++i) {
+			U32 expected = kPRSFree;
+			if (__atomic_compare_exchange_n(&m_pRings[i].state, &expected, (U32)kPRSClaiming,
+													  false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+				__atomic_store_n(&m_pRings[i].owner, Thread::self(), __ATOMIC_RELEASE);
+				__atomic_store_n(&m_pRings[i].state, (U32)kPRSOwned, __ATOMIC_RELEASE);
+
+				/* Raise the number of rings the consumer drains, if this one is past it */
+				U32 numRings = __atomic_load_n(&m_numRings, __ATOMIC_ACQUIRE);
+				while (numRings < i + 1 &&
+						 !__atomic_compare_exchange_n(&m_numRings, &numRings, i + 1,
+																false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {}
+				return &m_pRings[i];
+			}
+		}
+		DWARN("All " << m_maxProducers << " producer rings of the MessageQueue are claimed!");
+		return NIL;
+	}
+
+	void MessageQueue::processRings() {
+		/* Once the arenas are swapped, every message with a payload in the old one is in a ring */
+		U32 arena = swapArenas();
+
+		/* Only process what is already posted, so handlers that post wait for the next run */
+		U32 numRings = __atomic_load_n(&m_numRings, __ATOMIC_ACQUIRE);
+		Size remaining = 0;
+		for (U32 i = 0; i < numRings; ++i) {
+			m_pRingCounts[i] = m_pRings[i].messages.available();
+			remaining += m_pRingCounts[i];
+		}
+
+		if (!(m_flags & kMQFOrderByTime)) {
+			for (U32 i = 0; i < numRings; ++i) {
+				SpscRing<Message>& ring = m_pRings[i].messages;
+				for (Size n = m_pRingCounts[i]; n > 0; --n) {
+					consumeMessage(ring.front());
+					ring.pop();
+				}
+			}
+		} else {
+			/* Each ring is already in time order, so merge them by their fronts */
+			while (remaining > 0) {
+				U32 earliest = numRings;
+				for (U32 i = 0; i < numRings; ++i) {
+					if (m_pRingCounts[i] > 0 &&
+						 (earliest == numRings ||
+						  m_pRings[i].messages.front().time() < m_pRings[earliest].messages.front().time())) {
+						earliest = i;
+					}
 				}
-				itr.next();
+				SpscRing<Message>& ring = m_pRings[earliest].messages;
+				consumeMessage(ring.front());
+				ring.pop();
+				--m_pRingCounts[earliest];
+				--remaining;
 			}
-		}		
+		}
+		finishBatch();
+		m_arenas[arena].reset();
 	}
 
-	void MessageQueue::initHandlerList() {
-		m_pHandlers = new List<MessageHandler>[m_maxMessageTypeID+1];		
-		for (I32 i = 0; i <= m_maxMessageTypeID; i++) {
-			m_pHandlers[i].setNullValue(MessageHandler());
+	U32 MessageQueue::swapArenas() {
+		U32 arena = __atomic_load_n(&m_currentArena, __ATOMIC_SEQ_CST);
+		__atomic_store_n(&m_currentArena, 1 - arena, __ATOMIC_SEQ_CST);
+		/* Wait out the posts already under way, which never block */
+		while (__atomic_load_n(&m_numPosting[arena], __ATOMIC_SEQ_CST) != 0) {}
+		return arena;
+	}
+
+	Byte* MessageQueue::reservePayload(Size size, U32& arena) {
+		Byte* payload = NIL;
+		if (m_pRings) {
+			/* Count this thread in on the current arena, unless it was swapped in the meantime */
+			for (;;) {
+				arena = __atomic_load_n(&m_currentArena, __ATOMIC_SEQ_CST);
+				__atomic_add_fetch(&m_numPosting[arena], 1, __ATOMIC_SEQ_CST);
+				if (__atomic_load_n(&m_currentArena, __ATOMIC_SEQ_CST) == arena) {
+					break;
+				}
+				__atomic_sub_fetch(&m_numPosting[arena], 1, __ATOMIC_SEQ_CST);
+			}
+			payload = m_arenas[arena].alloc(size);
+			if (!payload) {
+				__atomic_sub_fetch(&m_numPosting[arena], 1, __ATOMIC_SEQ_CST);
+			}
+		} else {
+			/* The lock is held until the message is committed */
+			m_lock.lock();
+			arena = m_currentArena;
+			payload = m_arenas[arena].alloc(size);
+			if (!payload) {
+				m_lock.unlock();
+			}
+		}
+		D_CONDERR(!payload, "No room for a payload of " << size << " bytes in the MessageQueue arena!");
+		return payload;
+	}
+
+	Boolean MessageQueue::commitPayload(const Message& message, U32 arena) {
+		Boolean success = false;
+		if (m_pRings) {
+			success = postToRing(message);
+			__atomic_sub_fetch(&m_numPosting[arena], 1, __ATOMIC_SEQ_CST);
+		} else {
+			success = m_pMessages->push(message);
+			m_lock.unlock();
+		}
+		return success;
+	}
+
+	void MessageQueue::triggerMessage(Message& message) {
+		MessageHandlerTable& table = m_pHandlers[message.type()];
+		table.dispatch(message);
+		if (table.hasBatchHandlers()) {
+			table.dispatchBatch(&message, 1);
+		}
+	}
+
+	void MessageQueue::dispatchMessage(Message& message) {
+		MessageHandlerTable& table = m_pHandlers[message.type()];
+		table.dispatch(message);
+		if (table.hasBatchHandlers() && table.collect(message)) {
+			m_pBatchTypes[m_numBatchTypes++] = message.type();
+		}
+	}
+
+	void MessageQueue::consumeMessage(Message& message) {
+		if (!m_pRunner) {
+			dispatchMessage(message);
+			return;
+		}
+		/* Keep the message for the lanes, which walk all of them */
+		if (m_numDrained == m_drainedCapacity) {
+			Size capacity = (m_drainedCapacity > 0) ? m_drainedCapacity*2 : 64;
+			Message* drained = new Message[capacity];
+			for (Size i = 0; i < m_numDrained; ++i) {
+				drained[i] = m_pDrained[i];
+			}
+			if (m_pDrained) {
+				delete[] m_pDrained;
+			}
+			m_pDrained = drained;
+			m_drainedCapacity = capacity;
+		}
+		m_pDrained[m_numDrained++] = message;
+		MessageHandlerTable& table = m_pHandlers[message.type()];
+		if (table.hasBatchHandlers() && table.collect(message)) {
+			m_pBatchTypes[m_numBatchTypes++] = message.type();
+		}
+	}
+
+	void MessageQueue::finishBatch() {
+		if (!m_pRunner) {
+			flushBatches();
+			return;
+		}
+		if (m_numDrained > 0) {
+			m_groups.run(m_pRunner, dispatchLane, this);
+		}
+		for (I32 i = 0; i < m_numBatchTypes; ++i) {
+			m_pHandlers[m_pBatchTypes[i]].clearCollected();
+		}
+		m_numBatchTypes = 0;
+		m_numDrained = 0;
+	}
+
+	void MessageQueue::dispatchLane(VPtr obj, U32 groupMask) {
+		MessageQueue* queue = (MessageQueue*)obj;
+		for (Size i = 0; i < queue->m_numDrained; ++i) {
+			Message& message = queue->m_pDrained[i];
+			queue->m_pHandlers[message.type()].dispatch(message, groupMask);
+		}
+		for (I32 i = 0; i < queue->m_numBatchTypes; ++i) {
+			MessageHandlerTable& table = queue->m_pHandlers[queue->m_pBatchTypes[i]];
+			table.dispatchBatch(table.collected(), table.numCollected(), groupMask);
 		}
 	}
 
+	void MessageQueue::flushBatches() {
+		for (I32 i = 0; i < m_numBatchTypes; ++i) {
+			m_pHandlers[m_pBatchTypes[i]].flush();
+		}
+		m_numBatchTypes = 0;
+	}
+
+	void MessageQueue::initHandlerList() {
+		m_pHandlers = new MessageHandlerTable[m_maxMessageTypeID+1];		
+		m_pBatchTypes = new I32[m_maxMessageTypeID+1];
+		m_numBatchTypes = 0;
+	}
+
 	void MessageQueue::clearAllHandlers() {
 		for (I32 i = 0; i <= m_maxMessageTypeID; i++) {
 			m_pHandlers[i].clear();
 		}
+		m_numBatchTypes = 0;
 	}
 
 	void MessageQueue::processInternalMessages() {
@@ -114,7 +374,7 @@ namespace Cat {
 			InternalMessage2Args<I32, MessageHandler>(kMQIMTRemoveMessageHandler,
 																	messageTypeID, handler));
 		if (success) {
-			m_pHandlers[messageTypeID].get(handler).setActive(false);
+			m_pHandlers[messageTypeID].setActive(handler, false);
 		}			
 		m_lock.unlock();
 		return success;			
@@ -1,8 +1,9 @@
+#include <cstring>
 #include "core/defer/timer.h"
 
 namespace Cat {
 
-	Timer::Timer(Size queueSize, Size averageNumActions) {
+	Timer::Timer(Size queueSize, Size averageNumActions, const TimeVal& resolution) {
 		m_nextActionID = 0;		
 		m_singularInputQueue.initWithCapacity(queueSize, TimedActionPtr::nullPtr());
 		m_repeatedInputQueue.initWithCapacity(queueSize, TimedActionPtr::nullPtr());
@@ -11,6 +12,29 @@ namespace Cat {
 		m_nodeStore.initWithBlockSize(averageNumActions);		
 		m_singular.initAsRoot();
 		m_repeated.initAsRoot();		
+
+		m_epoch = Time::currentTimeRaw();
+		m_resolution = (U64)resolution.raw();
+		if (m_resolution == 0) {
+			DWARN("Timer resolution cannot be zero, using one raw time unit.");
+			m_resolution = 1;
+		}
+		m_wheel.reset(0);
+		m_pDispatchFunc = NIL;
+		m_pDispatchObj = NIL;
+
+		m_entryBlockSize = (averageNumActions > 0) ? averageNumActions : 32;
+		m_entryBlocks.reserve(8);
+		m_pFreeEntries = NIL;
+
+		/* The index is a power of two, at most half full */
+		m_indexMask = 15;
+		while (m_indexMask + 1 < m_entryBlockSize*2) {
+			m_indexMask = (m_indexMask << 1) | 1;
+		}
+		m_pIndex = new ActionEntry*[m_indexMask + 1];
+		memset(m_pIndex, 0, sizeof(ActionEntry*)*(m_indexMask + 1));
+		m_indexCount = 0;
 	}
 
 	Timer::~Timer() {
@@ -19,126 +43,241 @@ namespace Cat {
 			
 		m_singular.initAsRoot();
 		m_repeated.initAsRoot();		
+
+		m_wheel.reset(0);
+		for (Size i = 0; i < m_entryBlocks.length(); ++i) {
+			delete[] m_entryBlocks.at(i);
+		}
+		delete[] m_pIndex;
 	}
 
 	void Timer::consumeInputQueues() {
 		PtrNode<TimedActionPtr>* node;		
+		TimedActionPtr action;
+		/* The queues are pushed to under the lock from other threads */
+		m_lock.lock();
 		/* Put any queued singular actions on the the running queue. */
 		while (!m_singularInputQueue.isEmpty()) {
-			node = m_nodeStore.alloc(&m_singular, m_singularInputQueue.pop());
+			action = m_singularInputQueue.pop();
+			m_lock.unlock();
+			node = m_nodeStore.alloc(&m_singular, action);
 			node->ptr->initialize();
 			node->ptr->onInitialize();
+			addAction(node, false);
+			m_lock.lock();
 		}
 
 		/* Put any queued repeated actions on the the running queue. */
 		while (!m_repeatedInputQueue.isEmpty()) {
-			node = m_nodeStore.alloc(&m_repeated, m_repeatedInputQueue.pop());
+			action = m_repeatedInputQueue.pop();
+			m_lock.unlock();
+			node = m_nodeStore.alloc(&m_repeated, action);
 			node->ptr->initialize();
 			node->ptr->onInitialize();
+			addAction(node, true);
+			m_lock.lock();
 		}
-
+		m_lock.unlock();
+		action.setNull();
 	}	
 	  
 	
 	void Timer::processMessages() {
-
+		m_lock.lock();
 		while (!m_messageQueue.isEmpty()) {
 			InternalMessage1Arg<Number64> message = m_messageQueue.pop();
 			switch(message.typeID) {
 			case kTMRemoveSingularAction:
-				m_lock.lock();
 				findAndRemoveSingularAction(message.arg1.u64);				
-				m_lock.unlock();				
 				break;
 			case kTMRemoveRepeatedAction:
-				m_lock.lock();
 				findAndRemoveRepeatedAction(message.arg1.u64);
-				m_lock.unlock();				
 				break;
 			default:
 				DWARN("Unrecognized message typeID: " << message.typeID << "!");				
 				break;
 			}			
 		}
+		m_lock.unlock();
 	}
 	
 
 	void Timer::tick() {
+		consumeInputQueues();
 
-		PtrNode<TimedActionPtr>* node;
+		/* Process any waiting messages */
+		processMessages();
 
-		/* Put any queued singular actions on the the running queue. */
-		while (!m_singularInputQueue.isEmpty()) {
-			node = m_nodeStore.alloc(&m_singular, m_singularInputQueue.pop());
-			node->ptr->initialize();
-			node->ptr->onInitialize();
+		/* Read the clock once, and only visit the actions that expired */
+		RawTimeVal now = Time::currentTimeRaw();
+		U64 currentTick = toTick(now);
+		TimingWheel::Entry expired;
+		expired.initAsRoot();
+		m_wheel.advance(currentTick, &expired);
+
+		while (!expired.isEmptyRoot()) {
+			ActionEntry* entry = static_cast<ActionEntry*>(expired.next);
+			entry->detach();
+			TimedActionPtr& action = entry->node->ptr;
+
+			/* The last tick is only partly over, so check the actions in it exactly */
+			if (Time::compareRaw(now, action->nextFireTime()) <= 0) {
+				m_wheel.insert(entry, currentTick + 1);
+				continue;
+			}
+
+			/* A dispatched run that returned false removed its action */
+			if (action->wasRemoved()) {
+				freeAction(entry);
+				continue;
+			}
+
+			if (m_pDispatchFunc != NIL) {
+				/* A repeated action still running from an earlier period skips this one */
+				if (!entry->repeated || action->beginDispatch()) {
+					m_pDispatchFunc(m_pDispatchObj, action, entry->repeated);
+				}
+				if (entry->repeated) {
+					action->setNextFireTime();
+					m_wheel.insert(entry, toTick(action->nextFireTime()));
+				} else {
+					freeAction(entry);
+				}
+			} else if (!entry->repeated) {
+				action->fire();
+				freeAction(entry);
+			} else if (action->fire()) {
+				action->setNextFireTime();
+				m_wheel.insert(entry, toTick(action->nextFireTime()));
+			} else { /* Should remove if returns false */
+				freeAction(entry);
+			}
 		}
+	}
 
-		/* Put any queued repeated actions on the the running queue. */
-		while (!m_repeatedInputQueue.isEmpty()) {
-			node = m_nodeStore.alloc(&m_repeated, m_repeatedInputQueue.pop());
-			node->ptr->initialize();
-			node->ptr->onInitialize();
+	Boolean Timer::nextFireTime(RawTimeVal& time) const {
+		if (m_wheel.isEmpty()) {
+			return false;
 		}
+		time = m_epoch + (RawTimeVal)(m_wheel.nextDeadline()*m_resolution);
+		return true;
+	}
 
-		/* Process any waiting messages */
-		processMessages();
+	void Timer::addAction(PtrNode<TimedActionPtr>* node, Boolean repeated) {
+		ActionEntry* entry = allocEntry();
+		entry->node = node;
+		entry->actionID = node->ptr->actionID();
+		entry->repeated = repeated;
+		m_wheel.insert(entry, toTick(node->ptr->nextFireTime()));
+		indexEntry(entry);
+	}
+
+	void Timer::freeAction(ActionEntry* entry) {
+		unindexEntry(entry);
+		m_nodeStore.free(entry->node);
+		entry->node = NIL;
+		entry->next = m_pFreeEntries;
+		m_pFreeEntries = entry;
+	}
+
+	void Timer::findAndRemoveSingularAction(U64 actionID) {
+		ActionEntry* entry = findEntry(actionID);
+		if (entry != NIL && !entry->repeated) {
+			entry->node->ptr->remove();
+			m_wheel.remove(entry);
+			freeAction(entry);
+		}
+	}
+
+	void Timer::findAndRemoveRepeatedAction(U64 actionID) {
+		ActionEntry* entry = findEntry(actionID);
+		if (entry != NIL && entry->repeated) {
+			entry->node->ptr->remove();
+			m_wheel.remove(entry);
+			freeAction(entry);
+		}
+	}
 
-		/* Check the singular timers first */
-	   node = m_singular.next;
-		PtrNode<TimedActionPtr>* next = NIL;		
-		while (node != &m_singular) {
-			next = node->next;			
-			if (node->ptr->shouldFire()) {				
-				node->ptr->fire();
-				m_nodeStore.free(node);				
+	Timer::ActionEntry* Timer::allocEntry() {
+		if (m_pFreeEntries == NIL) {
+			ActionEntry* block = new ActionEntry[m_entryBlockSize];
+			m_entryBlocks.append(block);
+			for (Size i = 0; i < m_entryBlockSize; ++i) {
+				block[i].next = m_pFreeEntries;
+				m_pFreeEntries = &block[i];
 			}
-			node = next;
-		}
-
-		/* Now check the repeated timers. */
-		node = m_repeated.next;
-		while (node != &m_repeated) {
-			next = node->next;
-			if (node->ptr->shouldFire()) {				
-				if (node->ptr->fire()) { 
-					node->ptr->setNextFireTime();					
-				} else { /* Should remove if returns false */
-					m_nodeStore.free(node);
-				}			  
+		}
+		ActionEntry* entry = m_pFreeEntries;
+		m_pFreeEntries = static_cast<ActionEntry*>(entry->next);
+		entry->next = NIL;
+		return entry;
+	}
+
+	/* The actionIDs are sequential, so they spread evenly over the index */
+	Timer::ActionEntry* Timer::findEntry(U64 actionID) const {
+		Size idx = (Size)actionID & m_indexMask;
+		while (m_pIndex[idx] != NIL) {
+			if (m_pIndex[idx]->actionID == actionID) {
+				return m_pIndex[idx];
 			}
-			node = next;			
+			idx = (idx + 1) & m_indexMask;
 		}
+		return NIL;
 	}
 
-	void Timer::findAndRemoveSingularAction(U64 actionID) {
-		PtrNode<TimedActionPtr>* node = m_singular.next;
-		PtrNode<TimedActionPtr>* next = NIL;
-		while (node != &m_singular) {
-			next = node->next;
-			if (node->ptr->actionID() == actionID) {
-				node->ptr->remove();				
-				m_nodeStore.free(node);
-				return;				
+	void Timer::indexEntry(ActionEntry* entry) {
+		if ((m_indexCount + 1)*2 > m_indexMask + 1) {
+			growIndex();
+		}
+		Size idx = (Size)entry->actionID & m_indexMask;
+		while (m_pIndex[idx] != NIL) {
+			idx = (idx + 1) & m_indexMask;
+		}
+		m_pIndex[idx] = entry;
+		++m_indexCount;
+	}
+
+	void Timer::unindexEntry(ActionEntry* entry) {
+		Size idx = (Size)entry->actionID & m_indexMask;
+		while (m_pIndex[idx] != entry) {
+			if (m_pIndex[idx] == NIL) {
+				DERR("Action " << entry->actionID << " is not in the index!");
+				return;
+			}
+			idx = (idx + 1) & m_indexMask;
+		}
+
+		/* Shift back any later entries that probed past the hole */
+		m_pIndex[idx] = NIL;
+		Size next = (idx + 1) & m_indexMask;
+		while (m_pIndex[next] != NIL) {
+			Size home = (Size)m_pIndex[next]->actionID & m_indexMask;
+			if (((next - home) & m_indexMask) >= ((next - idx) & m_indexMask)) {
+				m_pIndex[idx] = m_pIndex[next];
+				m_pIndex[next] = NIL;
+				idx = next;
 			}
-			node = next;
+			next = (next + 1) & m_indexMask;
 		}
+		--m_indexCount;
 	}
 
-	void Timer::findAndRemoveRepeatedAction(U64 actionID) {
-		PtrNode<TimedActionPtr>* node = m_repeated.next;
-		PtrNode<TimedActionPtr>* next = NIL;		
-		while (node != &m_repeated) {
-			next = node->next;			
-			if (node->ptr->actionID() == actionID) {
-				node->ptr->remove();
-				m_nodeStore.free(node);
-				return;				
+	void Timer::growIndex() {
+		ActionEntry** pOld = m_pIndex;
+		Size oldSize = m_indexMask + 1;
+		m_indexMask = (m_indexMask << 1) | 1;
+		m_pIndex = new ActionEntry*[m_indexMask + 1];
+		memset(m_pIndex, 0, sizeof(ActionEntry*)*(m_indexMask + 1));
+		for (Size i = 0; i < oldSize; ++i) {
+			if (pOld[i] != NIL) {
+				Size idx = (Size)pOld[i]->actionID & m_indexMask;
+				while (m_pIndex[idx] != NIL) {
+					idx = (idx + 1) & m_indexMask;
+				}
+				m_pIndex[idx] = pOld[i];
 			}
-			node = next;			
 		}
+		delete[] pOld;
 	}
-	
-		
 
 } // namespace Cat
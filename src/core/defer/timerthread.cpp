@@ -0,0 +1,221 @@
+#include "core/defer/timerthread.h"
+#include "core/threading/thread.h"
+#include "core/threading/taskrunner.h"
+#include "core/threading/asynctaskrunner.h"
+#include "core/threading/asynctask.h"
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#if defined (OS_UNIX)
+#include <sys/timerfd.h>
+#endif
+
+namespace Cat {
+
+	/**
+	 * @brief A Task to fire a TimedAction on a TaskRunner.
+	 */
+	class TimedActionTask : public Task {
+	  public:
+		TimedActionTask(const TimedActionPtr& action, Boolean repeated)
+			: Task(action->oID()), m_action(action), m_repeated(repeated) {}
+
+		void run() {
+			/* The Timer drops a removed action, the TimerThread may already be gone */
+			if (!m_action->wasRemoved() && !m_action->fire() && m_repeated) {
+				m_action->remove();
+			}
+			if (m_repeated) {
+				m_action->endDispatch();
+			}
+			succeeded();
+		}
+
+	  private:
+		TimedActionPtr m_action;
+		Boolean m_repeated;
+	};
+
+	/**
+	 * @brief An AsyncTask to fire a TimedAction on an AsyncTaskRunner.
+	 */
+	class TimedActionAsyncTask : public AsyncTask {
+	  public:
+		TimedActionAsyncTask(const TimedActionPtr& action, Boolean repeated)
+			: m_action(action), m_repeated(repeated) {
+			setDestroyable(true);
+		}
+
+		I32 run() {
+			/* The Timer drops a removed action, the TimerThread may already be gone */
+			if (!m_action->wasRemoved() && !m_action->fire() && m_repeated) {
+				m_action->remove();
+			}
+			if (m_repeated) {
+				m_action->endDispatch();
+			}
+			return 0;
+		}
+
+	  private:
+		TimedActionPtr m_action;
+		Boolean m_repeated;
+	};
+
+	TimerThread::TimerThread(Size queueSize, const TimeVal& slack, Size averageNumActions)
+		: m_timer(queueSize, averageNumActions), m_pTaskRunner(NIL), m_pAsyncRunner(NIL),
+		  m_timerFd(-1), m_stopRequested(false), m_running(false), m_numWakeups(0) {
+		m_slack = slack.raw();
+		if (m_slack == 0) {
+			m_slack = 1;
+		}
+		m_nanoPerRaw = 1.0e9 / (F64)Time::secondsToRaw(1.0);
+
+		/* Anything written to the pipe wakes the thread */
+		m_wakeFds[0] = m_wakeFds[1] = -1;
+		if (pipe(m_wakeFds) != 0) {
+			DERR("Failed to create the TimerThread wake-up pipe!");
+		} else {
+			fcntl(m_wakeFds[0], F_SETFL, O_NONBLOCK);
+			fcntl(m_wakeFds[1], F_SETFL, O_NONBLOCK);
+		}
+#if defined (OS_UNIX)
+		m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+		if (m_timerFd < 0) {
+			DERR("Failed to create the TimerThread timerfd!");
+		}
+#endif /* OS_UNIX */
+	}
+
+	TimerThread::~TimerThread() {
+		stop();
+		if (m_timerFd >= 0) {
+			close(m_timerFd);
+		}
+		if (m_wakeFds[0] >= 0) {
+			close(m_wakeFds[0]);
+			close(m_wakeFds[1]);
+		}
+	}
+
+	void TimerThread::dispatchTo(TaskRunner* runner) {
+		D_CONDERR(m_running, "Cannot change the TimerThread dispatcher while it is running!");
+		m_pTaskRunner = runner;
+		m_pAsyncRunner = NIL;
+		m_timer.setDispatcher(runner ? dispatch : NIL, this);
+	}
+
+	void TimerThread::dispatchTo(AsyncTaskRunner* runner) {
+		D_CONDERR(m_running, "Cannot change the TimerThread dispatcher while it is running!");
+		m_pTaskRunner = NIL;
+		m_pAsyncRunner = runner;
+		m_timer.setDispatcher(runner ? dispatch : NIL, this);
+	}
+
+	Boolean TimerThread::start() {
+		if (m_running) {
+			return true;
+		}
+		m_stopRequested = false;
+		m_running = (Thread::run(this) != NIL);
+		return m_running;
+	}
+
+	void TimerThread::stop() {
+		if (!m_running) {
+			return;
+		}
+		__atomic_store_n(&m_stopRequested, true, __ATOMIC_RELEASE);
+		wake();
+		Thread::join(getThread());
+		m_running = false;
+	}
+
+	I32 TimerThread::run() {
+		while (!__atomic_load_n(&m_stopRequested, __ATOMIC_ACQUIRE)) {
+			m_timer.tick();
+			sleepUntilNextFireTime();
+			__atomic_add_fetch(&m_numWakeups, 1, __ATOMIC_RELAXED);
+		}
+		return 0;
+	}
+
+	void TimerThread::dispatch(VPtr obj, const TimedActionPtr& action, Boolean repeated) {
+		TimerThread* self = (TimerThread*)obj;
+		if (self->m_pTaskRunner != NIL) {
+			/* A task the runner refused never runs to end the dispatch */
+			if (self->m_pTaskRunner->queueTask(TaskPtr(new TimedActionTask(action, repeated))).isNull() && repeated) {
+				TimedActionPtr refused(action);
+				refused->endDispatch();
+			}
+		} else if (self->m_pAsyncRunner != NIL) {
+			TimedActionAsyncTask* task = new TimedActionAsyncTask(action, repeated);
+			if (!self->m_pAsyncRunner->queue(task)) {
+				delete task;
+				if (repeated) {
+					TimedActionPtr refused(action);
+					refused->endDispatch();
+				}
+			}
+		}
+	}
+
+	void TimerThread::wake() {
+		if (m_wakeFds[1] >= 0) {
+			/* A full pipe already has a wake-up in it */
+			Char byte = 1;
+			ssize_t written = write(m_wakeFds[1], &byte, 1);
+			(void)written;
+		}
+	}
+
+	void TimerThread::sleepUntilNextFireTime() {
+		/* Round the wake-up up to the slack, so nearby expirations share it */
+		I32 timeout = -1;
+		U64 nano = 0;
+		RawTimeVal next;
+		if (m_timer.nextFireTime(next)) {
+			next = ((next + m_slack - 1) / m_slack) * m_slack;
+			RawTimeVal now = Time::currentTimeRaw();
+			nano = (Time::compareRaw(next, now) > 0) ? (U64)((F64)(next - now)*m_nanoPerRaw) : 0;
+			/* A zero timerfd is disarmed, and a zero timeout does not sleep */
+			nano = (nano > 0) ? nano : 1;
+			timeout = (I32)((nano + 999999) / 1000000);
+		}
+
+		struct pollfd fds[2];
+		nfds_t numFds = 0;
+		fds[numFds].fd = m_wakeFds[0];
+		fds[numFds].events = POLLIN;
+		fds[numFds].revents = 0;
+		numFds++;
+#if defined (OS_UNIX)
+		if (m_timerFd >= 0) {
+			struct itimerspec spec;
+			memset(&spec, 0, sizeof(spec));
+			spec.it_value.tv_sec = (time_t)(nano / 1000000000ULL);
+			spec.it_value.tv_nsec = (long)(nano % 1000000000ULL);
+			timerfd_settime(m_timerFd, 0, &spec, NIL);
+			fds[numFds].fd = m_timerFd;
+			fds[numFds].events = POLLIN;
+			fds[numFds].revents = 0;
+			numFds++;
+			timeout = -1;
+		}
+#endif /* OS_UNIX */
+
+		if (poll(fds, numFds, timeout) > 0) {
+			Char buffer[64];
+			if (fds[0].revents & POLLIN) {
+				while (read(m_wakeFds[0], buffer, sizeof(buffer)) > 0) {}
+			}
+			if (numFds > 1 && (fds[1].revents & POLLIN)) {
+				U64 expirations;
+				ssize_t count = read(m_timerFd, &expirations, sizeof(expirations));
+				(void)count;
+			}
+		}
+	}
+
+} // namespace Cat
@@ -0,0 +1,139 @@
+#include "core/defer/timingwheel.h"
+
+namespace Cat {
+
+	TimingWheel::TimingWheel() {
+		reset(0);
+	}
+
+	void TimingWheel::insert(Entry* entry, U64 deadline) {
+		entry->deadline = (deadline > m_currentTick) ? deadline : m_currentTick + 1;
+		place(entry);
+		++m_size;
+	}
+
+	void TimingWheel::remove(Entry* entry) {
+		Entry* root = &m_slots[entry->slot];
+		entry->detach();
+		if (root->isEmptyRoot()) {
+			m_occupied[entry->slot >> kSlotBits] &= ~(1ULL << (entry->slot & kSlotMask));
+		}
+		--m_size;
+	}
+
+	Size TimingWheel::advance(U64 tick, Entry* expired) {
+		Size numExpired = 0;
+		while (m_currentTick < tick && m_size > 0) {
+			/* Skip straight to the next occupied slot, or the wrap of the first level */
+			U32 idx = (U32)(m_currentTick & kSlotMask);
+			U64 base = m_currentTick - idx;
+			U64 ahead = (idx == kSlotMask) ? 0 : (m_occupied[0] & (~0ULL << (idx + 1)));
+			U64 next = ahead ? base + (U64)__builtin_ctzll(ahead) : base + kNumSlots;
+			if (next > tick) {
+				break;
+			}
+			m_currentTick = next;
+
+			/* On a wrap, bring the next slot of each level that wrapped down */
+			if ((next & kSlotMask) == 0) {
+				for (U32 level = 1; level < kNumLevels; ++level) {
+					U32 levelIdx = (U32)((next >> (kSlotBits*level)) & kSlotMask);
+					cascade(level*kNumSlots + levelIdx);
+					if (levelIdx != 0) {
+						break;
+					}
+				}
+			}
+			numExpired += collect((U32)(next & kSlotMask), expired);
+		}
+		if (m_currentTick < tick) {
+			m_currentTick = tick;
+		}
+		return numExpired;
+	}
+
+	U64 TimingWheel::nextDeadline() const {
+		/* The first occupied slot of each level, in this rotation of the level or the next */
+		U64 next = ~0ULL;
+		for (U32 level = 0; level < kNumLevels; ++level) {
+			U64 occupied = m_occupied[level];
+			if (occupied == 0) {
+				continue;
+			}
+			U32 shift = kSlotBits*level;
+			U32 idx = (U32)((m_currentTick >> shift) & kSlotMask);
+			U64 base = (m_currentTick >> (shift + kSlotBits)) << (shift + kSlotBits);
+			U64 ahead = (idx == kSlotMask) ? 0 : (occupied & (~0ULL << (idx + 1)));
+			U64 tick = ahead ? base + ((U64)__builtin_ctzll(ahead) << shift)
+				: base + (1ULL << (shift + kSlotBits)) + ((U64)__builtin_ctzll(occupied) << shift);
+			if (tick < next) {
+				next = tick;
+			}
+		}
+		return next;
+	}
+
+	void TimingWheel::reset(U64 tick) {
+		for (U32 i = 0; i < kNumLevels*kNumSlots; ++i) {
+			m_slots[i].initAsRoot();
+		}
+		for (U32 i = 0; i < kNumLevels; ++i) {
+			m_occupied[i] = 0;
+		}
+		m_currentTick = tick;
+		m_size = 0;
+	}
+
+	void TimingWheel::place(Entry* entry) {
+		/* Deadlines out of range wait in the last slot in range, and are placed again from there */
+		U64 delta = entry->deadline - m_currentTick;
+		U64 target = (delta < kMaxTicksAhead) ? entry->deadline : m_currentTick + kMaxTicksAhead - 1;
+		delta = target - m_currentTick;
+
+		U32 level = 0;
+		while (level < kNumLevels - 1 && delta >= (1ULL << (kSlotBits*(level + 1)))) {
+			++level;
+		}
+		U32 idx = (U32)((target >> (kSlotBits*level)) & kSlotMask);
+		entry->slot = level*kNumSlots + idx;
+		entry->attach(&m_slots[entry->slot]);
+		m_occupied[level] |= (1ULL << idx);
+	}
+
+	void TimingWheel::cascade(U32 slot) {
+		Entry* root = &m_slots[slot];
+		if (root->isEmptyRoot()) {
+			return;
+		}
+		/* Unhook the whole list first, since entries may land back in the same slot */
+		Entry list;
+		list.initAsRoot();
+		list.next = root->next;
+		list.prev = root->prev;
+		list.next->prev = &list;
+		list.prev->next = &list;
+		root->initAsRoot();
+		m_occupied[slot >> kSlotBits] &= ~(1ULL << (slot & kSlotMask));
+
+		while (!list.isEmptyRoot()) {
+			Entry* entry = list.next;
+			entry->detach();
+			place(entry);
+		}
+	}
+
+	Size TimingWheel::collect(U32 slot, Entry* expired) {
+		Entry* root = &m_slots[slot];
+		Size count = 0;
+		while (!root->isEmptyRoot()) {
+			Entry* entry = root->next;
+			entry->detach();
+			entry->attach(expired);
+			++count;
+		}
+		m_occupied[0] &= ~(1ULL << slot);
+		m_size -= count;
+		return count;
+	}
+
+} // namespace Cat
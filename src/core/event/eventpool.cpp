@@ -0,0 +1,32 @@
+#include "core/event/eventpool.h"
+
+namespace Cat {
+
+	EventPool::EventPool()
+		: m_pSlots(NIL), m_pUnaligned(NIL), m_slotSize(0), m_numSlots(0),
+		  m_head(0), m_tail(0) {
+	}
+
+	EventPool::~EventPool() {
+		D_CONDERR(m_head != m_tail, m_head - m_tail << " events still in the EventPool!");
+		if (m_pUnaligned) {
+			delete[] m_pUnaligned;
+			m_pUnaligned = NIL;
+			m_pSlots = NIL;
+		}
+	}
+
+	void EventPool::initWithSlots(Size slotSize, Size numSlots) {
+		D_CONDERR(m_head != m_tail, "Resizing an EventPool with " << m_head - m_tail << " events in it!");
+		if (m_pUnaligned) {
+			delete[] m_pUnaligned;
+		}
+		m_slotSize = (slotSize + kAlignment - 1) & ~(kAlignment - 1);
+		m_numSlots = numSlots;
+		m_pUnaligned = new Byte[m_slotSize * m_numSlots + kAlignment];
+		Size addr = (Size)m_pUnaligned;
+		m_pSlots = m_pUnaligned + ((kAlignment - (addr & (kAlignment - 1))) & (kAlignment - 1));
+		m_head = m_tail = 0;
+	}
+
+} // namespace Cat
@@ -9,7 +9,12 @@ namespace Cat {
 
 	EventQueue* EventQueue::s_pGlobalEventQueue = NIL;	
 	
-	EventQueue::EventQueue(Size capacity) {
+	EventQueue::EventQueue(Size capacity)
+		: m_pRunner(NIL), m_numDrained(0) {
+		m_pDrained = new Event*[capacity];
+		for (U32 i = 0; i < kEQGNumGroups; ++i) {
+			m_processMarks[i] = 0;
+		}
 		m_eventQueueOne.initQueueWithCapacityAndNull(capacity, NIL);
 		m_eventQueueTwo.initQueueWithCapacityAndNull(capacity, NIL);
 		m_pCurrentEventQueue = &m_eventQueueOne;
@@ -18,9 +23,21 @@ namespace Cat {
 
 	EventQueue::~EventQueue() {
 		m_lock.lock();
-		m_eventQueueOne.eraseAll();
-		m_eventQueueTwo.eraseAll();		
+		/* The pooled events are only destroyed, the others deleted */
+		while (!m_eventQueueOne.isEmpty()) {
+			destroyEvent(m_eventQueueOne.pop());
+		}
+		while (!m_eventQueueTwo.isEmpty()) {
+			destroyEvent(m_eventQueueTwo.pop());
+		}
+		for (U32 i = 0; i < kEQGNumGroups; ++i) {
+			m_pools[i].recycleTo(m_pools[i].head());
+		}
 		m_pCurrentEventQueue = m_pProcessing = NIL;
+		if (m_pDrained) {
+			delete[] m_pDrained;
+			m_pDrained = NIL;
+		}
 		m_lock.unlock();		
 	}
 
@@ -30,25 +47,97 @@ namespace Cat {
 		m_lock.lock();
 		m_pProcessing = m_pCurrentEventQueue;
 		m_pCurrentEventQueue = tmpForSwap;	
+		for (U32 i = 0; i < kEQGNumGroups; ++i) {
+			m_processMarks[i] = m_pools[i].head();
+		}
 		m_lock.unlock();
-		
-		Event* event = NIL;		
-		while (!m_pProcessing->isEmpty()) {
-			event = m_pProcessing->pop();		
-			if (event->isKeyboardEvent()) {
-				DeviceManager::instance()->keyboard()->handleEvent(event);
+
+		if (m_pRunner) {
+			/* The queue holds no more than its capacity, so neither does the drained array */
+			while (!m_pProcessing->isEmpty()) {
+				m_pDrained[m_numDrained++] = m_pProcessing->pop();
 			}
-			else if (event->isMouseEvent()) {
-				DeviceManager::instance()->mouse()->handleEvent(event);
+			if (m_numDrained > 0) {
+				m_groups.run(m_pRunner, processLane, this);
 			}
-			else if (event->isUIEvent()) {
-				CatzToy::instance()->ui()->handleEvent(event);
+			for (Size i = 0; i < m_numDrained; ++i) {
+				destroyEvent(m_pDrained[i]);
 			}
-			else {			
-				DERR("Unknown event in queue " << *event << "!");			
+			m_numDrained = 0;
+		}
+		else {
+			Event* event = NIL;		
+			while (!m_pProcessing->isEmpty()) {
+				event = m_pProcessing->pop();		
+				if (event->isKeyboardEvent()) {
+					DeviceManager::instance()->keyboard()->handleEvent(event);
+				}
+				else if (event->isMouseEvent()) {
+					DeviceManager::instance()->mouse()->handleEvent(event);
+				}
+				else if (event->isUIEvent()) {
+					CatzToy::instance()->ui()->handleEvent(event);
+				}
+				else {			
+					DERR("Unknown event in queue " << *event << "!");			
+				}
+				destroyEvent(event);
+			}
+		}
+
+		/* Every pooled event of the run is gone, so hand its slots back */
+		m_lock.lock();
+		for (U32 i = 0; i < kEQGNumGroups; ++i) {
+			m_pools[i].recycleTo(m_processMarks[i]);
+		}
+		m_lock.unlock();
+	}
+
+	void EventQueue::initEventPool(U32 group, Size slotSize, Size numSlots) {
+		D_CONDERR(group >= kEQGNumGroups, "Event group " << group << " does not exist!");
+		if (group < kEQGNumGroups) {
+			m_pools[group].initWithSlots(slotSize, numSlots);
+		}
+	}
+
+	Byte* EventQueue::reserveEvent(Event::Type type, Size size, U32& group) {
+		group = groupOfType(type);
+		/* The lock is held until the event is committed */
+		m_lock.lock();
+		Byte* slot = m_pools[group].alloc(size);
+		if (!slot) {
+			m_lock.unlock();
+		}
+		D_CONDERR(!slot, "No room for an event of " << size << " bytes in EventPool " << group << "!");
+		return slot;
+	}
+
+	Boolean EventQueue::commitEvent(Event* event, U32 group) {
+		Boolean success = true;
+		if (event->canCombineMultipleEvents() &&
+			 !m_pCurrentEventQueue->isEmpty() && 
+			 m_pCurrentEventQueue->peekLast()->type() == event->type()) {
+			m_pCurrentEventQueue->peekLast()->combine(event);
+			event->~Event();
+			m_pools[group].unalloc();
+		}
+		else if (!m_pCurrentEventQueue->push(event)) {
+			event->~Event();
+			m_pools[group].unalloc();
+			success = false;
+		}
+		m_lock.unlock();
+		return success;
+	}
+
+	void EventQueue::destroyEvent(Event* event) {
+		for (U32 i = 0; i < kEQGNumGroups; ++i) {
+			if (m_pools[i].owns(event)) {
+				event->~Event();
+				return;
 			}
-			delete event;
-		}		
+		}
+		delete event;
 	}
 
 	Boolean EventQueue::handleEvent(Event* event) {
@@ -67,6 +156,16 @@ namespace Cat {
 		}
 	}
 
+	void EventQueue::processLane(VPtr obj, U32 groupMask) {
+		EventQueue* queue = (EventQueue*)obj;
+		for (Size i = 0; i < queue->m_numDrained; ++i) {
+			Event* event = queue->m_pDrained[i];
+			if ((1U << groupOf(event)) & groupMask) {
+				queue->handleEvent(event);
+			}
+		}
+	}
+
 	void EventQueue::destroyGlobalEventQueue() {
 		if (s_pGlobalEventQueue) {
 			delete s_pGlobalEventQueue;
@@ -0,0 +1,214 @@
+#include "core/geometry/convexpolykernels.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	/*************************************************************
+	 * Scalar kernels
+	 *************************************************************/
+
+	static Size scalarContainsPoints(const Point2<F32>* poly, Size numPoly,
+												const Point2<F32>* points, Size count, Boolean* results) {
+		return ConvexPolyKernels::containsPoints<F32>(poly, numPoly, points, count, results);
+	}
+
+	static Boolean scalarContainsPoint(const Point2<F32>* poly, Size numPoly,
+												  const Point2<F32>& point) {
+		return ConvexPolyKernels::containsPoint<F32>(poly, numPoly, point);
+	}
+
+	static const ConvexPolyKernels::Table s_scalarTable = {
+		scalarContainsPoints,
+		scalarContainsPoint,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/*************************************************************
+	 * SSE2 kernels
+	 *
+	 * A Point2<F32> is two packed floats, so two points are loaded at
+	 * a time and split into x and y lanes with a shuffle.
+	 *************************************************************/
+
+	static inline void sse2LoadPoint2x4(const Point2<F32>* src, __m128& x, __m128& y) {
+		__m128 a = _mm_loadu_ps(&src[0].x);
+		__m128 b = _mm_loadu_ps(&src[2].x);
+		x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+		y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+
+	/**
+	 * Evaluate the edge function (x2 - x1)*(py - y1) - (y2 - y1)*(px - x1),
+	 * in the same order as Point2::isLeftTurn(), and check for > 0.
+	 */
+	static inline __m128 sse2Outside(__m128 x1, __m128 y1, __m128 x2, __m128 y2,
+												__m128 px, __m128 py) {
+		__m128 f = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(x2, x1), _mm_sub_ps(py, y1)),
+									 _mm_mul_ps(_mm_sub_ps(y2, y1), _mm_sub_ps(px, x1)));
+		return _mm_cmpgt_ps(f, _mm_setzero_ps());
+	}
+
+	static Size sse2ContainsPoints(const Point2<F32>* poly, Size numPoly,
+											 const Point2<F32>* points, Size count, Boolean* results) {
+		if (numPoly == 0) {
+			for (Size i = 0; i < count; ++i) {
+				results[i] = false;
+			}
+			return 0;
+		}
+		Size found = 0;
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 px, py;
+			sse2LoadPoint2x4(points + i, px, py);
+			__m128 outside = _mm_setzero_ps();
+			for (Size e = 0; e < numPoly; ++e) {
+				const Point2<F32>& p1 = poly[e];
+				const Point2<F32>& p2 = poly[e + 1 < numPoly ? e + 1 : 0];
+				outside = _mm_or_ps(outside, sse2Outside(_mm_set1_ps(p1.x), _mm_set1_ps(p1.y),
+																	  _mm_set1_ps(p2.x), _mm_set1_ps(p2.y),
+																	  px, py));
+				if (_mm_movemask_ps(outside) == 0xF) {
+					break;
+				}
+			}
+			I32 mask = _mm_movemask_ps(outside);
+			for (Size k = 0; k < 4; ++k) {
+				results[i + k] = ((mask >> k) & 1) == 0;
+				found += results[i + k] ? 1 : 0;
+			}
+		}
+		for (; i < count; ++i) {
+			results[i] = ConvexPolyKernels::containsPoint<F32>(poly, numPoly, points[i]);
+			found += results[i] ? 1 : 0;
+		}
+		return found;
+	}
+
+	static Boolean sse2ContainsPoint(const Point2<F32>* poly, Size numPoly,
+												const Point2<F32>& point) {
+		if (numPoly == 0) {
+			return false;
+		}
+		__m128 px = _mm_set1_ps(point.x);
+		__m128 py = _mm_set1_ps(point.y);
+
+		/* The edges poly[e..e+3] -> poly[e+1..e+4], while all in range */
+		Size e = 0;
+		for (; e + 5 <= numPoly; e += 4) {
+			__m128 x1, y1, x2, y2;
+			sse2LoadPoint2x4(poly + e, x1, y1);
+			sse2LoadPoint2x4(poly + e + 1, x2, y2);
+			if (_mm_movemask_ps(sse2Outside(x1, y1, x2, y2, px, py))) {
+				return false;
+			}
+		}
+		for (; e < numPoly; ++e) {
+			if (ConvexPolyKernels::isOutside(poly[e], poly[e + 1 < numPoly ? e + 1 : 0], point)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static const ConvexPolyKernels::Table s_sse2Table = {
+		sse2ContainsPoints,
+		sse2ContainsPoint,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * AVX2 kernels
+	 *
+	 * Testing a single point uses the SSE2 version, since few
+	 * polygons have enough edges to fill 8 lanes.
+	 *************************************************************/
+
+	CAT_TARGET_AVX2_NO_FMA static inline void avx2LoadPoint2x8(const Point2<F32>* src,
+																				  __m256& x, __m256& y) {
+		__m256 a = _mm256_loadu_ps(&src[0].x);
+		__m256 b = _mm256_loadu_ps(&src[4].x);
+		/* The shuffle works within each 128 bit half, giving 0 1 4 5 2 3 6 7 */
+		__m256 sx = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 sy = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+		x = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sx), _MM_SHUFFLE(3, 1, 2, 0)));
+		y = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sy), _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static Size avx2ContainsPoints(const Point2<F32>* poly, Size numPoly,
+																			const Point2<F32>* points, Size count,
+																			Boolean* results) {
+		if (numPoly == 0) {
+			return sse2ContainsPoints(poly, numPoly, points, count, results);
+		}
+		Size found = 0;
+		Size i = 0;
+		__m256 zero = _mm256_setzero_ps();
+		for (; i + 8 <= count; i += 8) {
+			__m256 px, py;
+			avx2LoadPoint2x8(points + i, px, py);
+			__m256 outside = zero;
+			for (Size e = 0; e < numPoly; ++e) {
+				const Point2<F32>& p1 = poly[e];
+				const Point2<F32>& p2 = poly[e + 1 < numPoly ? e + 1 : 0];
+				__m256 x1 = _mm256_set1_ps(p1.x);
+				__m256 y1 = _mm256_set1_ps(p1.y);
+				__m256 f = _mm256_sub_ps(
+					_mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(p2.x), x1), _mm256_sub_ps(py, y1)),
+					_mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(p2.y), y1), _mm256_sub_ps(px, x1)));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(f, zero, _CMP_GT_OQ));
+				if (_mm256_movemask_ps(outside) == 0xFF) {
+					break;
+				}
+			}
+			I32 mask = _mm256_movemask_ps(outside);
+			for (Size k = 0; k < 8; ++k) {
+				results[i + k] = ((mask >> k) & 1) == 0;
+				found += results[i + k] ? 1 : 0;
+			}
+		}
+		return found + sse2ContainsPoints(poly, numPoly, points + i, count - i, results + i);
+	}
+
+	static const ConvexPolyKernels::Table s_avx2Table = {
+		avx2ContainsPoints,
+		sse2ContainsPoint,
+		"avx2"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const ConvexPolyKernels::Table& ConvexPolyKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const ConvexPolyKernels::Table& ConvexPolyKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size ConvexPolyKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasAVX2()) {
+			tables[count++] = &s_avx2Table;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const ConvexPolyKernels::Table* ConvexPolyKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
@@ -0,0 +1,331 @@
+#include "core/geometry/rectkernels.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	/*************************************************************
+	 * Scalar kernels
+	 *************************************************************/
+
+	static Size scalarIntersects(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect,
+										  U32* mask) {
+		return RectKernels::intersects<F32>(rects, count, rect, mask);
+	}
+
+	static Size scalarContains(const RectSoA<F32>& rects, Size count, F32 x, F32 y, U32* mask) {
+		return RectKernels::contains<F32>(rects, count, x, y, mask);
+	}
+
+	static void scalarUnionAll(const RectSoA<F32>& rects, Size count, F32* ltrb) {
+		RectKernels::unionAll<F32>(rects, count, ltrb);
+	}
+
+	static void scalarClip(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect) {
+		RectKernels::clip<F32>(rects, count, rect);
+	}
+
+	static void scalarTranslate(const RectSoA<F32>& rects, Size count, F32 dx, F32 dy) {
+		RectKernels::translate<F32>(rects, count, dx, dy);
+	}
+
+	static const RectKernels::Table s_scalarTable = {
+		scalarIntersects,
+		scalarContains,
+		scalarUnionAll,
+		scalarClip,
+		scalarTranslate,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/*************************************************************
+	 * SSE2 kernels
+	 *************************************************************/
+
+	static const U8 s_bitCounts[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+	/**
+	 * Store the 4 bits for the rectangles i..i+3 (i is a multiple of 4,
+	 * so the bits never cross a word) and count them.
+	 */
+	static inline Size sse2StoreBits(U32* mask, Size i, I32 bits) {
+		mask[i >> 5] |= (U32)bits << (i & 31);
+		return s_bitCounts[bits];
+	}
+
+	/**
+	 * Test the rectangles from begin (a multiple of 4) to count, adding to
+	 * a mask that has already been cleared.
+	 */
+	static Size sse2IntersectsFrom(const RectSoA<F32>& rects, Size begin, Size count,
+											 const Rect<F32>& rect, U32* mask) {
+		__m128 left = _mm_set1_ps(rect.left());
+		__m128 top = _mm_set1_ps(rect.top());
+		__m128 right = _mm_set1_ps(rect.right());
+		__m128 bottom = _mm_set1_ps(rect.bottom());
+		Size found = 0;
+		Size i = begin;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(rects.x + i);
+			__m128 y = _mm_loadu_ps(rects.y + i);
+			__m128 hit = _mm_and_ps(
+				_mm_and_ps(_mm_cmplt_ps(left, _mm_add_ps(x, _mm_loadu_ps(rects.w + i))),
+							  _mm_cmpgt_ps(top, _mm_sub_ps(y, _mm_loadu_ps(rects.h + i)))),
+				_mm_and_ps(_mm_cmpgt_ps(right, x), _mm_cmplt_ps(bottom, y)));
+			found += sse2StoreBits(mask, i, _mm_movemask_ps(hit));
+		}
+		for (; i < count; ++i) {
+			U32 hit = (rect.left() < rects.x[i] + rects.w[i]) &
+				(rect.top() > rects.y[i] - rects.h[i]) &
+				(rect.right() > rects.x[i]) &
+				(rect.bottom() < rects.y[i]);
+			mask[i >> 5] |= hit << (i & 31);
+			found += hit;
+		}
+		return found;
+	}
+
+	static Size sse2Intersects(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect,
+										U32* mask) {
+		for (Size w = 0; w < RectKernels::maskWords(count); ++w) {
+			mask[w] = 0;
+		}
+		return sse2IntersectsFrom(rects, 0, count, rect, mask);
+	}
+
+	static Size sse2Contains(const RectSoA<F32>& rects, Size count, F32 px, F32 py, U32* mask) {
+		for (Size w = 0; w < RectKernels::maskWords(count); ++w) {
+			mask[w] = 0;
+		}
+		__m128 vx = _mm_set1_ps(px);
+		__m128 vy = _mm_set1_ps(py);
+		Size found = 0;
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(rects.x + i);
+			__m128 y = _mm_loadu_ps(rects.y + i);
+			__m128 hit = _mm_and_ps(
+				_mm_and_ps(_mm_cmpgt_ps(vx, x),
+							  _mm_cmplt_ps(vx, _mm_add_ps(x, _mm_loadu_ps(rects.w + i)))),
+				_mm_and_ps(_mm_cmplt_ps(vy, y),
+							  _mm_cmpgt_ps(vy, _mm_sub_ps(y, _mm_loadu_ps(rects.h + i)))));
+			found += sse2StoreBits(mask, i, _mm_movemask_ps(hit));
+		}
+		for (; i < count; ++i) {
+			U32 hit = (px > rects.x[i]) & (px < rects.x[i] + rects.w[i]) &
+				(py < rects.y[i]) & (py > rects.y[i] - rects.h[i]);
+			mask[i >> 5] |= hit << (i & 31);
+			found += hit;
+		}
+		return found;
+	}
+
+	static void sse2UnionAll(const RectSoA<F32>& rects, Size count, F32* ltrb) {
+		if (count < 4) {
+			RectKernels::unionAll<F32>(rects, count, ltrb);
+			return;
+		}
+		__m128 left = _mm_loadu_ps(rects.x);
+		__m128 top = _mm_loadu_ps(rects.y);
+		__m128 right = _mm_add_ps(left, _mm_loadu_ps(rects.w));
+		__m128 bottom = _mm_sub_ps(top, _mm_loadu_ps(rects.h));
+		Size i = 4;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(rects.x + i);
+			__m128 y = _mm_loadu_ps(rects.y + i);
+			left = _mm_min_ps(left, x);
+			top = _mm_max_ps(top, y);
+			right = _mm_max_ps(right, _mm_add_ps(x, _mm_loadu_ps(rects.w + i)));
+			bottom = _mm_min_ps(bottom, _mm_sub_ps(y, _mm_loadu_ps(rects.h + i)));
+		}
+		F32 CAT_ALIGN(16) l[4], t[4], r[4], b[4];
+		_mm_store_ps(l, left);
+		_mm_store_ps(t, top);
+		_mm_store_ps(r, right);
+		_mm_store_ps(b, bottom);
+		for (Size k = 1; k < 4; ++k) {
+			l[0] = l[k] < l[0] ? l[k] : l[0];
+			t[0] = t[k] > t[0] ? t[k] : t[0];
+			r[0] = r[k] > r[0] ? r[k] : r[0];
+			b[0] = b[k] < b[0] ? b[k] : b[0];
+		}
+		for (; i < count; ++i) {
+			F32 rr = rects.x[i] + rects.w[i];
+			F32 bb = rects.y[i] - rects.h[i];
+			l[0] = rects.x[i] < l[0] ? rects.x[i] : l[0];
+			t[0] = rects.y[i] > t[0] ? rects.y[i] : t[0];
+			r[0] = rr > r[0] ? rr : r[0];
+			b[0] = bb < b[0] ? bb : b[0];
+		}
+		ltrb[0] = l[0];
+		ltrb[1] = t[0];
+		ltrb[2] = r[0];
+		ltrb[3] = b[0];
+	}
+
+	static void sse2Clip(const RectSoA<F32>& rects, Size count, const Rect<F32>& rect) {
+		__m128 left = _mm_set1_ps(rect.left());
+		__m128 top = _mm_set1_ps(rect.top());
+		__m128 right = _mm_set1_ps(rect.right());
+		__m128 bottom = _mm_set1_ps(rect.bottom());
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(rects.x + i);
+			__m128 y = _mm_loadu_ps(rects.y + i);
+			__m128 r = _mm_add_ps(x, _mm_loadu_ps(rects.w + i));
+			__m128 b = _mm_sub_ps(y, _mm_loadu_ps(rects.h + i));
+			__m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(left, r), _mm_cmpgt_ps(top, b)),
+											_mm_and_ps(_mm_cmpgt_ps(right, x), _mm_cmplt_ps(bottom, y)));
+			__m128 cl = _mm_max_ps(left, x);
+			__m128 ct = _mm_min_ps(top, y);
+			__m128 cr = _mm_min_ps(right, r);
+			__m128 cb = _mm_max_ps(bottom, b);
+			_mm_storeu_ps(rects.x + i, _mm_and_ps(hit, cl));
+			_mm_storeu_ps(rects.y + i, _mm_and_ps(hit, ct));
+			_mm_storeu_ps(rects.w + i, _mm_and_ps(hit, _mm_sub_ps(cr, cl)));
+			_mm_storeu_ps(rects.h + i, _mm_and_ps(hit, _mm_sub_ps(ct, cb)));
+		}
+		RectSoA<F32> tail(rects.x + i, rects.y + i, rects.w + i, rects.h + i);
+		RectKernels::clip<F32>(tail, count - i, rect);
+	}
+
+	static void sse2Translate(const RectSoA<F32>& rects, Size count, F32 dx, F32 dy) {
+		__m128 vx = _mm_set1_ps(dx);
+		__m128 vy = _mm_set1_ps(dy);
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(rects.x + i, _mm_add_ps(_mm_loadu_ps(rects.x + i), vx));
+			_mm_storeu_ps(rects.y + i, _mm_add_ps(_mm_loadu_ps(rects.y + i), vy));
+		}
+		for (; i < count; ++i) {
+			rects.x[i] += dx;
+			rects.y[i] += dy;
+		}
+	}
+
+	static const RectKernels::Table s_sse2Table = {
+		sse2Intersects,
+		sse2Contains,
+		sse2UnionAll,
+		sse2Clip,
+		sse2Translate,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * AVX2 kernels
+	 *
+	 * The tails of less than 8 rectangles are left to the SSE2
+	 * versions.  Testing a point and the union are memory bound, so
+	 * they use the SSE2 versions too.
+	 *************************************************************/
+
+	CAT_TARGET_AVX2_NO_FMA static Size avx2Intersects(const RectSoA<F32>& rects, Size count,
+																	  const Rect<F32>& rect, U32* mask) {
+		for (Size w = 0; w < RectKernels::maskWords(count); ++w) {
+			mask[w] = 0;
+		}
+		Size found = 0;
+		Size i = 0;
+		__m256 left = _mm256_set1_ps(rect.left());
+		__m256 top = _mm256_set1_ps(rect.top());
+		__m256 right = _mm256_set1_ps(rect.right());
+		__m256 bottom = _mm256_set1_ps(rect.bottom());
+		for (; i + 8 <= count; i += 8) {
+			__m256 x = _mm256_loadu_ps(rects.x + i);
+			__m256 y = _mm256_loadu_ps(rects.y + i);
+			__m256 hit = _mm256_and_ps(
+				_mm256_and_ps(_mm256_cmp_ps(left, _mm256_add_ps(x, _mm256_loadu_ps(rects.w + i)), _CMP_LT_OQ),
+								  _mm256_cmp_ps(top, _mm256_sub_ps(y, _mm256_loadu_ps(rects.h + i)), _CMP_GT_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(right, x, _CMP_GT_OQ), _mm256_cmp_ps(bottom, y, _CMP_LT_OQ)));
+			I32 bits = _mm256_movemask_ps(hit);
+			mask[i >> 5] |= (U32)bits << (i & 31);
+			found += s_bitCounts[bits & 0xF] + s_bitCounts[bits >> 4];
+		}
+		return found + sse2IntersectsFrom(rects, i, count, rect, mask);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2Clip(const RectSoA<F32>& rects, Size count,
+															  const Rect<F32>& rect) {
+		__m256 left = _mm256_set1_ps(rect.left());
+		__m256 top = _mm256_set1_ps(rect.top());
+		__m256 right = _mm256_set1_ps(rect.right());
+		__m256 bottom = _mm256_set1_ps(rect.bottom());
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 x = _mm256_loadu_ps(rects.x + i);
+			__m256 y = _mm256_loadu_ps(rects.y + i);
+			__m256 r = _mm256_add_ps(x, _mm256_loadu_ps(rects.w + i));
+			__m256 b = _mm256_sub_ps(y, _mm256_loadu_ps(rects.h + i));
+			__m256 hit = _mm256_and_ps(
+				_mm256_and_ps(_mm256_cmp_ps(left, r, _CMP_LT_OQ), _mm256_cmp_ps(top, b, _CMP_GT_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(right, x, _CMP_GT_OQ), _mm256_cmp_ps(bottom, y, _CMP_LT_OQ)));
+			__m256 cl = _mm256_max_ps(left, x);
+			__m256 ct = _mm256_min_ps(top, y);
+			__m256 cr = _mm256_min_ps(right, r);
+			__m256 cb = _mm256_max_ps(bottom, b);
+			_mm256_storeu_ps(rects.x + i, _mm256_and_ps(hit, cl));
+			_mm256_storeu_ps(rects.y + i, _mm256_and_ps(hit, ct));
+			_mm256_storeu_ps(rects.w + i, _mm256_and_ps(hit, _mm256_sub_ps(cr, cl)));
+			_mm256_storeu_ps(rects.h + i, _mm256_and_ps(hit, _mm256_sub_ps(ct, cb)));
+		}
+		sse2Clip(RectSoA<F32>(rects.x + i, rects.y + i, rects.w + i, rects.h + i), count - i, rect);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2Translate(const RectSoA<F32>& rects, Size count,
+																	 F32 dx, F32 dy) {
+		__m256 vx = _mm256_set1_ps(dx);
+		__m256 vy = _mm256_set1_ps(dy);
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			_mm256_storeu_ps(rects.x + i, _mm256_add_ps(_mm256_loadu_ps(rects.x + i), vx));
+			_mm256_storeu_ps(rects.y + i, _mm256_add_ps(_mm256_loadu_ps(rects.y + i), vy));
+		}
+		sse2Translate(RectSoA<F32>(rects.x + i, rects.y + i, rects.w + i, rects.h + i),
+						  count - i, dx, dy);
+	}
+
+	static const RectKernels::Table s_avx2Table = {
+		avx2Intersects,
+		sse2Contains,
+		sse2UnionAll,
+		avx2Clip,
+		avx2Translate,
+		"avx2"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const RectKernels::Table& RectKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const RectKernels::Table& RectKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size RectKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasAVX2()) {
+			tables[count++] = &s_avx2Table;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const RectKernels::Table* RectKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
@@ -1,6 +1,8 @@
 #include "core/io/datainputstream.h"
 #include "core/string/stringutils.h"
 
+#define CAT_UTF8_READ_CHUNK_SIZE 4096
+
 namespace Cat {
 
 	Size DataInputStream::readCStr(CStr string) {
@@ -16,6 +18,41 @@ namespace Cat {
 		}
 		return bytesRead;
 	}
+
+	Size DataInputStream::readUTF8(UniString& string) {
+		U32 len = 0;
+		Size bytesRead = read(&len, sizeof(U32));
+		if (bytesRead > 0) {
+			Char* bytes = StringUtils::create(len);
+			Size strRead = read(bytes, sizeof(Char)*len);
+			D_CONDERR((strRead < len), "Failed to read all of string!");
+			string.assignUTF8(bytes, strRead);
+			StringUtils::free(bytes);
+			bytesRead += strRead;
+		}
+		return bytesRead;
+	}
+
+	Size DataInputStream::readUTF8Text(U16* buffer, Size byteCount,
+												  Utf8Decoder& decoder) {
+		Char chunk[CAT_UTF8_READ_CHUNK_SIZE];
+		Size written = 0;
+		while (byteCount > 0) {
+			Size toRead = (byteCount < CAT_UTF8_READ_CHUNK_SIZE) ?
+				byteCount : CAT_UTF8_READ_CHUNK_SIZE;
+			Size bytesRead = read(chunk, toRead);
+			if (bytesRead == 0) {
+				break;
+			}
+			Size decoded = decoder.decode(chunk, bytesRead, &(buffer[written]));
+			if (decoded == CAT_UTF_INVALID) {
+				return CAT_UTF_INVALID;
+			}
+			written += decoded;
+			byteCount -= bytesRead;
+		}
+		return written;
+	}
 	
 
 } // namespace Cat
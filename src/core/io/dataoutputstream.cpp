@@ -15,6 +15,20 @@ namespace Cat {
 		}
 		return bytesWritten;
 	}
+
+	Size DataOutputStream::writeUTF8(const UniString& string) {
+		Size bytesWritten = 0;
+		Char* utf8 = string.toUTF8();
+		if (utf8) {
+			U32 len = StringUtils::length(utf8);
+			bytesWritten += write(&len, sizeof(U32));
+			bytesWritten += write(utf8, sizeof(Char)*len);
+			D_CONDERR((bytesWritten != (len + sizeof(U32))),
+						 "Failed to write all of the string!");
+			StringUtils::free(utf8);
+		}
+		return bytesWritten;
+	}
 	
 
 } // namespace Cat
@@ -84,7 +84,7 @@ namespace Cat {
 	}
 	
 
-	void FilePath::set(const Char* parentPath, const Char* relativePath) {
+	void FilePath::set(const StringView& parentPath, const StringView& relativePath) {
 		if (m_pAbsolutePath) {
 			m_pAbsolutePath = StringUtils::free(m_pAbsolutePath);
 			m_pPath = StringUtils::free(m_pPath);
@@ -93,51 +93,63 @@ namespace Cat {
 			m_nameIdx = -1;			
 		}		
 		m_pAbsolutePath = FilePath::createAbsolutePath(relativePath, parentPath);			
-		m_pPath = StringUtils::copy(relativePath);
+		m_pPath = relativePath.copy();
 		m_pParentPath = m_pCanonicalPath = NIL;			
 		setNameIndex();
 	}
 
-	Char* FilePath::createAbsolutePath(const Char* path, const Char* parentPath) {
-		if (!parentPath && FilePath::isAbsolutePath(path)) {
-			return StringUtils::copy(path);
+	Char* FilePath::createAbsolutePath(const StringView& path, const StringView& parentPath) {
+		if (parentPath.isEmpty() && FilePath::isAbsolutePath(path)) {
+			return path.copy();
 		}
-		else {			
-			Boolean deleteParentPathAfter = false;			
-			/* Strip out leading /'s from the path */		
-			while (path[0] == FilePath::separatorChar()) {
-				++path;
-			}
-			/* Make the parent path absolute if not already */
-			if (parentPath && !FilePath::isAbsolutePath(parentPath)) {				
-				deleteParentPathAfter = true;				
-				/* Strip out leading /'s from the parent path. */
-				while (parentPath[0] == FilePath::separatorChar()) {
-					++parentPath;
+
+		/* The absolute path is built from up to three parts: 
+		 * [cwd] [relative parent] path, joined by a single separator. */
+		const Char sep = FilePath::separatorChar();
+		Char cwd[CAT_MAX_CWD_LENGTH];
+		StringView parts[3];
+		Size numParts = 0;
+		
+		if (parentPath.isEmpty()) {
+			parts[numParts++] = FilePath::getCwd(cwd);
+		}
+		else if (!FilePath::isAbsolutePath(parentPath)) {
+			parts[numParts++] = FilePath::getCwd(cwd);
+			parts[numParts++] = parentPath;
+		}
+		else {
+			parts[numParts++] = parentPath;
+		}
+		parts[numParts++] = path;		
+
+		/* Strip leading /'s from all but the first, trailing /'s from all but the last */
+		Size totalLen = 0;		
+		for (Size i = 0; i < numParts; ++i) {
+			if (i > 0) {
+				while (!parts[i].isEmpty() && parts[i][0] == sep) {
+					parts[i] = parts[i].sub(1);
 				}
-				parentPath = FilePath::createAbsolutePath(parentPath, NIL);				
 			}
-			else if (!parentPath) { /* No parent path */
-				parentPath = FilePath::getCwd();
+			if (i < numParts - 1) {
+				while (!parts[i].isEmpty() && parts[i].back() == sep) {
+					parts[i] = parts[i].sub(0, parts[i].length() - 1);
+				}
 			}
+			totalLen += parts[i].length();
+		}
 
-			Size parentLen = StringUtils::length(parentPath);
-			/* Strip out trailing /'s from the parent path. */
-			while (parentPath[parentLen-1] == FilePath::separatorChar()) {
-				--parentLen;				
-			}
-			Size pathLen = StringUtils::length(path);			
-			/* Now we can allocate space and start copying */
-			Char* absPath = StringUtils::create(pathLen + parentLen + 1);
-			StringUtils::sub(absPath, parentPath, 0, parentLen);
-			absPath[parentLen] = FilePath::separatorChar();
-			StringUtils::sub(absPath, path, parentLen+1, pathLen+1);
-
-			if (deleteParentPathAfter) {
-				StringUtils::free(const_cast<Char*>(parentPath));
+		/* Now we can allocate space once and start copying */
+		Char* absPath = StringUtils::create(totalLen + numParts - 1);
+		Size idx = 0;
+		for (Size i = 0; i < numParts; ++i) {
+			if (i > 0) {
+				absPath[idx++] = sep;
 			}
-			return absPath;			
+			StringUtils::sub(absPath, parts[i], idx);
+			idx += parts[i].length();
 		}
+		absPath[idx] = '\0';
+		return absPath;
 	}	
 
 	void FilePath::setNameIndex() {
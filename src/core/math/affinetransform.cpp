@@ -0,0 +1,52 @@
+#include "core/math/affinetransform.h"
+
+namespace Cat {
+
+	/* Built from literals, not Mat3::kIdentity, which may not be initialised yet */
+	const AffineTransform AffineTransform::kIdentity =
+		AffineTransform(Mat3(REAL(1.0), REAL(0.0), REAL(0.0),
+									REAL(0.0), REAL(1.0), REAL(0.0),
+									REAL(0.0), REAL(0.0), REAL(1.0)),
+							 Vec3(REAL(0.0), REAL(0.0), REAL(0.0)));
+
+	AffineTransform::AffineTransform(const Vec3& translation, const Quaternion& rotation,
+												const Vec3& scale)
+		: m_translation(translation) {
+		rotation.toMatrix(m_linear);
+		/* Scaling first is the same as scaling each column of the rotation */
+		Mat3::MatrixData& d = m_linear.getMatrixData();
+		d.m11 *= scale.x; d.m12 *= scale.x; d.m13 *= scale.x;
+		d.m21 *= scale.y; d.m22 *= scale.y; d.m23 *= scale.y;
+		d.m31 *= scale.z; d.m32 *= scale.z; d.m33 *= scale.z;
+	}
+
+	AffineTransform::AffineTransform(const Mat4& mat)
+		: m_linear(mat.get3x3Matrix()) {
+		const Mat4::MatrixData& d = mat.getMatrixDataConst();
+		m_translation = Vec3(d.m41, d.m42, d.m43);
+	}
+
+	AffineTransform AffineTransform::inverse() const {
+		if (m_linear.determinant() == 0) {
+			DWARN("Trying to get Inverse of non-invertable affine transform!");
+			return AffineTransform(*this);
+		}
+		Mat3 linear = m_linear.inverse();
+		return AffineTransform(linear, -(linear * m_translation));
+	}
+
+	Mat4 AffineTransform::toMat4() const {
+		const Mat3::MatrixData& d = m_linear.getMatrixDataConst();
+		return Mat4(d.m11, d.m12, d.m13, REAL(0.0),
+						d.m21, d.m22, d.m23, REAL(0.0),
+						d.m31, d.m32, d.m33, REAL(0.0),
+						m_translation.x, m_translation.y, m_translation.z, REAL(1.0));
+	}
+
+#ifdef DEBUG
+	std::ostream& operator<<(std::ostream& out, const AffineTransform& t) {
+		return out << t.linear() << "\n" << t.translation();
+	}
+#endif //DEBUG
+
+} // namespace Cat
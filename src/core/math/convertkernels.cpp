@@ -0,0 +1,249 @@
+#include "core/math/convertkernels.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	/*************************************************************
+	 * Scalar kernels
+	 *************************************************************/
+
+	static void scalarHalfToReal(const Half* src, Real* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = HalfFloat::toReal(src[i]);
+		}
+	}
+
+	static void scalarRealToHalf(const Real* src, Half* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = HalfFloat::fromReal(src[i]);
+		}
+	}
+
+	static void scalarFixedToReal(const Fixed* src, Real* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = FixedPoint::toReal(src[i]);
+		}
+	}
+
+	static void scalarRealToFixed(const Real* src, Fixed* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = FixedPoint::fromReal(src[i]);
+		}
+	}
+
+	static const ConvertKernels::Table s_scalarTable = {
+		scalarHalfToReal,
+		scalarRealToHalf,
+		scalarFixedToReal,
+		scalarRealToFixed,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/*************************************************************
+	 * SSE2 kernels
+	 *
+	 * The half float conversions are the same integer tricks as the
+	 * scalar HalfFloat functions, with each branch computed for every
+	 * lane and the right one selected with a mask.
+	 *************************************************************/
+
+	static inline __m128i sse2Select(__m128i mask, __m128i a, __m128i b) {
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+
+	/* Four halves, zero extended into 32 bit lanes, to floats */
+	static inline __m128 sse2HalfToReal(__m128i h) {
+		const __m128i shiftedExp = _mm_set1_epi32(0x7C00 << 13);
+		__m128i bits = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+		__m128i exp = _mm_and_si128(bits, shiftedExp);
+		bits = _mm_add_epi32(bits, _mm_set1_epi32((127 - 15) << 23));
+
+		/* Inf and NaN, with NaNs made quiet */
+		__m128i infNan = _mm_cmpeq_epi32(exp, shiftedExp);
+		__m128i special = _mm_add_epi32(bits, _mm_set1_epi32((128 - 16) << 23));
+		__m128i zeroMant = _mm_cmpeq_epi32(_mm_and_si128(special, _mm_set1_epi32(0x007FFFFF)),
+													  _mm_setzero_si128());
+		special = _mm_or_si128(special, _mm_andnot_si128(zeroMant, _mm_set1_epi32(0x00400000)));
+
+		/* Zero and denormals */
+		__m128i denorm = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))),
+																	_mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+
+		bits = sse2Select(infNan, special, bits);
+		bits = sse2Select(_mm_cmpeq_epi32(exp, _mm_setzero_si128()), denorm, bits);
+		bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16));
+		return _mm_castsi128_ps(bits);
+	}
+
+	/* Four floats to halves, in the low 16 bits of each 32 bit lane */
+	static inline __m128i sse2RealToHalf(__m128 v) {
+		const __m128i magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		__m128i bits = _mm_castps_si128(v);
+		__m128i sign = _mm_and_si128(bits, _mm_set1_epi32((I32)0x80000000));
+		bits = _mm_xor_si128(bits, sign);
+
+		/* The sign is gone, so the signed compares are safe */
+		__m128i mantOdd = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+		__m128i normal = _mm_add_epi32(bits, _mm_set1_epi32((I32)(((U32)(15 - 127) << 23) + 0xFFF)));
+		normal = _mm_srli_epi32(_mm_add_epi32(normal, mantOdd), 13);
+
+		__m128i denorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits),
+																					 _mm_castsi128_ps(magic))), magic);
+
+		__m128i isNan = _mm_cmpgt_epi32(bits, _mm_set1_epi32(0x7F800000));
+		__m128i nan = _mm_or_si128(_mm_set1_epi32(0x7E00),
+											_mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(0x3FF)));
+		__m128i special = sse2Select(isNan, nan, _mm_set1_epi32(0x7C00));
+
+		__m128i result = sse2Select(_mm_cmplt_epi32(bits, _mm_set1_epi32(113 << 23)), denorm, normal);
+		result = sse2Select(_mm_cmpgt_epi32(bits, _mm_set1_epi32(((127 + 16) << 23) - 1)), special, result);
+		return _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+	}
+
+	/* Pack the low 16 bits of each 32 bit lane, without saturating */
+	static inline __m128i sse2Pack16(__m128i lo, __m128i hi) {
+		return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+									  _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+	}
+
+	static void sse2HalfToReal(const Half* src, Real* dst, Size count) {
+		__m128i zero = _mm_setzero_si128();
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m128i h = _mm_loadu_si128((const __m128i*)(src + i));
+			_mm_storeu_ps(dst + i, sse2HalfToReal(_mm_unpacklo_epi16(h, zero)));
+			_mm_storeu_ps(dst + i + 4, sse2HalfToReal(_mm_unpackhi_epi16(h, zero)));
+		}
+		scalarHalfToReal(src + i, dst + i, count - i);
+	}
+
+	static void sse2RealToHalf(const Real* src, Half* dst, Size count) {
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m128i lo = sse2RealToHalf(_mm_loadu_ps(src + i));
+			__m128i hi = sse2RealToHalf(_mm_loadu_ps(src + i + 4));
+			_mm_storeu_si128((__m128i*)(dst + i), sse2Pack16(lo, hi));
+		}
+		scalarRealToHalf(src + i, dst + i, count - i);
+	}
+
+	static void sse2FixedToReal(const Fixed* src, Real* dst, Size count) {
+		__m128 scale = _mm_set1_ps(REAL(1.0) / (F32)FixedPoint::kOne);
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i f = _mm_loadu_si128((const __m128i*)(src + i));
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(f), scale));
+		}
+		scalarFixedToReal(src + i, dst + i, count - i);
+	}
+
+	static void sse2RealToFixed(const Real* src, Fixed* dst, Size count) {
+		__m128 scale = _mm_set1_ps((F32)FixedPoint::kOne);
+		__m128 lo = _mm_set1_ps(REAL(-2147483648.0));
+		__m128 hi = _mm_set1_ps(REAL(2147483520.0));
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_cvtps_epi32(v));
+		}
+		scalarRealToFixed(src + i, dst + i, count - i);
+	}
+
+	static const ConvertKernels::Table s_sse2Table = {
+		sse2HalfToReal,
+		sse2RealToHalf,
+		sse2FixedToReal,
+		sse2RealToFixed,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * F16C kernels
+	 *
+	 * The half float conversions are single instructions, and the
+	 * fixed point conversions use the 8 wide AVX registers.
+	 *************************************************************/
+
+	CAT_TARGET_F16C static void f16cHalfToReal(const Half* src, Real* dst, Size count) {
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + i))));
+		}
+		scalarHalfToReal(src + i, dst + i, count - i);
+	}
+
+	CAT_TARGET_F16C static void f16cRealToHalf(const Real* src, Half* dst, Size count) {
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			_mm_storeu_si128((__m128i*)(dst + i),
+								  _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+		}
+		scalarRealToHalf(src + i, dst + i, count - i);
+	}
+
+	CAT_TARGET_F16C static void f16cFixedToReal(const Fixed* src, Real* dst, Size count) {
+		__m256 scale = _mm256_set1_ps(REAL(1.0) / (F32)FixedPoint::kOne);
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256i f = _mm256_loadu_si256((const __m256i*)(src + i));
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(f), scale));
+		}
+		sse2FixedToReal(src + i, dst + i, count - i);
+	}
+
+	CAT_TARGET_F16C static void f16cRealToFixed(const Real* src, Fixed* dst, Size count) {
+		__m256 scale = _mm256_set1_ps((F32)FixedPoint::kOne);
+		__m256 lo = _mm256_set1_ps(REAL(-2147483648.0));
+		__m256 hi = _mm256_set1_ps(REAL(2147483520.0));
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), lo), hi);
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtps_epi32(v));
+		}
+		sse2RealToFixed(src + i, dst + i, count - i);
+	}
+
+	static const ConvertKernels::Table s_f16cTable = {
+		f16cHalfToReal,
+		f16cRealToHalf,
+		f16cFixedToReal,
+		f16cRealToFixed,
+		"f16c"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const ConvertKernels::Table& ConvertKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const ConvertKernels::Table& ConvertKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size ConvertKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasF16C()) {
+			tables[count++] = &s_f16cTable;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const ConvertKernels::Table* ConvertKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
@@ -2,6 +2,43 @@
 
 namespace Cat {
 
+#if defined (CAT_MATH_SSE)
+	namespace {
+
+/* Shuffle the lanes (x, y, z, w) of a and b into a new vector (a.x, a.y, b.z, b.w) */
+#define CAT_MAT4_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define CAT_MAT4_SWIZZLE(a, x, y, z, w) CAT_MAT4_SHUFFLE(a, a, x, y, z, w)
+
+		/**
+		 * @brief Multiply two 2x2 matrices, stored (m11, m12, m21, m22), A*B.
+		 */
+		inline __m128 mat2Mul(__m128 a, __m128 b) {
+			return _mm_add_ps(_mm_mul_ps(a, CAT_MAT4_SWIZZLE(b, 0, 3, 0, 3)),
+									_mm_mul_ps(CAT_MAT4_SWIZZLE(a, 1, 0, 3, 2),
+												  CAT_MAT4_SWIZZLE(b, 2, 1, 2, 1)));
+		}
+
+		/**
+		 * @brief Multiply the adjugate of a 2x2 matrix by another, adj(A)*B.
+		 */
+		inline __m128 mat2AdjMul(__m128 a, __m128 b) {
+			return _mm_sub_ps(_mm_mul_ps(CAT_MAT4_SWIZZLE(a, 3, 3, 0, 0), b),
+									_mm_mul_ps(CAT_MAT4_SWIZZLE(a, 1, 1, 2, 2),
+												  CAT_MAT4_SWIZZLE(b, 2, 3, 0, 1)));
+		}
+
+		/**
+		 * @brief Multiply a 2x2 matrix by the adjugate of another, A*adj(B).
+		 */
+		inline __m128 mat2MulAdj(__m128 a, __m128 b) {
+			return _mm_sub_ps(_mm_mul_ps(a, CAT_MAT4_SWIZZLE(b, 3, 0, 3, 0)),
+									_mm_mul_ps(CAT_MAT4_SWIZZLE(a, 1, 0, 3, 2),
+												  CAT_MAT4_SWIZZLE(b, 2, 1, 2, 1)));
+		}
+
+	} // namespace
+#endif
+
 	const Real Mat4::kEpsilon = REAL(0.00001);	
 	const Mat4 Mat4::kIdentity = Mat4(REAL(1.0), REAL(0.0), REAL(0.0), REAL(0.0),
 												 REAL(0.0), REAL(1.0), REAL(0.0), REAL(0.0),
@@ -9,6 +46,12 @@ namespace Cat {
 												 REAL(0.0), REAL(0.0), REAL(0.0), REAL(1.0));	
 
 	Real Mat4::determinant() const {
+		if (isAffine()) {
+			return
+				m_d.m11*(m_d.m22*m_d.m33 - m_d.m32*m_d.m23) -
+				m_d.m21*(m_d.m12*m_d.m33 - m_d.m32*m_d.m13) +
+				m_d.m31*(m_d.m12*m_d.m23 - m_d.m22*m_d.m13);
+		}
 		return
 		 	  (m_d.m11*m_d.m22*m_d.m33*m_d.m44) + (m_d.m11*m_d.m23*m_d.m34*m_d.m42) + (m_d.m11*m_d.m24*m_d.m32*m_d.m43)
 			+ (m_d.m12*m_d.m21*m_d.m34*m_d.m43) + (m_d.m12*m_d.m23*m_d.m31*m_d.m44) + (m_d.m12*m_d.m24*m_d.m33*m_d.m41)
@@ -20,7 +63,115 @@ namespace Cat {
 			- (m_d.m14*m_d.m21*m_d.m32*m_d.m43) - (m_d.m14*m_d.m22*m_d.m33*m_d.m41) - (m_d.m14*m_d.m23*m_d.m31*m_d.m42);
 	}
 	
+	Mat4 Mat4::composeAffine(const Mat4& rhs) const {
+		const MatrixData& b = rhs.m_d;
+		return Mat4(
+			(m_d.m11*b.m11) + (m_d.m21*b.m12) + (m_d.m31*b.m13),
+			(m_d.m12*b.m11) + (m_d.m22*b.m12) + (m_d.m32*b.m13),
+			(m_d.m13*b.m11) + (m_d.m23*b.m12) + (m_d.m33*b.m13),
+			REAL(0.0),
+			(m_d.m11*b.m21) + (m_d.m21*b.m22) + (m_d.m31*b.m23),
+			(m_d.m12*b.m21) + (m_d.m22*b.m22) + (m_d.m32*b.m23),
+			(m_d.m13*b.m21) + (m_d.m23*b.m22) + (m_d.m33*b.m23),
+			REAL(0.0),
+			(m_d.m11*b.m31) + (m_d.m21*b.m32) + (m_d.m31*b.m33),
+			(m_d.m12*b.m31) + (m_d.m22*b.m32) + (m_d.m32*b.m33),
+			(m_d.m13*b.m31) + (m_d.m23*b.m32) + (m_d.m33*b.m33),
+			REAL(0.0),
+			(m_d.m11*b.m41) + (m_d.m21*b.m42) + (m_d.m31*b.m43) + m_d.m41,
+			(m_d.m12*b.m41) + (m_d.m22*b.m42) + (m_d.m32*b.m43) + m_d.m42,
+			(m_d.m13*b.m41) + (m_d.m23*b.m42) + (m_d.m33*b.m43) + m_d.m43,
+			REAL(1.0));
+	}
+
+	Mat4 Mat4::inverseAffine() const {
+		/* The cofactors of the 3x3 part, transposed */
+		Real c11 = m_d.m22*m_d.m33 - m_d.m32*m_d.m23;
+		Real c12 = m_d.m32*m_d.m13 - m_d.m12*m_d.m33;
+		Real c13 = m_d.m12*m_d.m23 - m_d.m22*m_d.m13;
+		Real detM = m_d.m11*c11 + m_d.m21*c12 + m_d.m31*c13;
+		if (detM == 0) {
+			DWARN("Trying to get Inverse of non-invertable matrix!");
+			return Mat4(*this);
+		}
+		Real rDet = REAL(1.0) / detM;
+
+		Mat4 r;
+		r.m_d.m11 = c11*rDet;
+		r.m_d.m12 = c12*rDet;
+		r.m_d.m13 = c13*rDet;
+		r.m_d.m21 = (m_d.m31*m_d.m23 - m_d.m21*m_d.m33)*rDet;
+		r.m_d.m22 = (m_d.m11*m_d.m33 - m_d.m31*m_d.m13)*rDet;
+		r.m_d.m23 = (m_d.m21*m_d.m13 - m_d.m11*m_d.m23)*rDet;
+		r.m_d.m31 = (m_d.m21*m_d.m32 - m_d.m31*m_d.m22)*rDet;
+		r.m_d.m32 = (m_d.m31*m_d.m12 - m_d.m11*m_d.m32)*rDet;
+		r.m_d.m33 = (m_d.m11*m_d.m22 - m_d.m21*m_d.m12)*rDet;
+
+		/* The translation is moved back by the inverse 3x3 part */
+		r.m_d.m41 = -((r.m_d.m11*m_d.m41) + (r.m_d.m21*m_d.m42) + (r.m_d.m31*m_d.m43));
+		r.m_d.m42 = -((r.m_d.m12*m_d.m41) + (r.m_d.m22*m_d.m42) + (r.m_d.m32*m_d.m43));
+		r.m_d.m43 = -((r.m_d.m13*m_d.m41) + (r.m_d.m23*m_d.m42) + (r.m_d.m33*m_d.m43));
+		r.m_d.m14 = r.m_d.m24 = r.m_d.m34 = REAL(0.0);
+		r.m_d.m44 = REAL(1.0);
+		return r;
+	}
+
 	Mat4 Mat4::inverse() const {
+		if (isAffine()) {
+			return inverseAffine();
+		}
+#if defined (CAT_MATH_SSE)
+		/* Invert by 2x2 blocks, [A B; C D], using the adjugates of the
+		 * blocks.  The columns are treated as rows, which is fine as the
+		 * inverse of the transpose is the transpose of the inverse. */
+		const __m128* c = m_d.col;
+		__m128 a = _mm_movelh_ps(c[0], c[1]);
+		__m128 b = _mm_movehl_ps(c[1], c[0]);
+		__m128 cc = _mm_movelh_ps(c[2], c[3]);
+		__m128 d = _mm_movehl_ps(c[3], c[2]);
+
+		/* The determinants of A, B, C, D */
+		__m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(CAT_MAT4_SHUFFLE(c[0], c[2], 0, 2, 0, 2),
+						  CAT_MAT4_SHUFFLE(c[1], c[3], 1, 3, 1, 3)),
+			_mm_mul_ps(CAT_MAT4_SHUFFLE(c[0], c[2], 1, 3, 1, 3),
+						  CAT_MAT4_SHUFFLE(c[1], c[3], 0, 2, 0, 2)));
+		__m128 detA = CAT_MAT4_SWIZZLE(detSub, 0, 0, 0, 0);
+		__m128 detB = CAT_MAT4_SWIZZLE(detSub, 1, 1, 1, 1);
+		__m128 detC = CAT_MAT4_SWIZZLE(detSub, 2, 2, 2, 2);
+		__m128 detD = CAT_MAT4_SWIZZLE(detSub, 3, 3, 3, 3);
+
+		__m128 dc = mat2AdjMul(d, cc);
+		__m128 ab = mat2AdjMul(a, b);
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(cc, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, cc), mat2MulAdj(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+		/* detM = detA*detD + detB*detC - trace(adj(A)B * adj(D)C) */
+		__m128 tr = _mm_mul_ps(ab, CAT_MAT4_SWIZZLE(dc, 0, 2, 1, 3));
+		tr = _mm_add_ps(tr, CAT_MAT4_SWIZZLE(tr, 1, 0, 3, 2));
+		tr = _mm_add_ps(tr, CAT_MAT4_SWIZZLE(tr, 2, 3, 0, 1));
+		__m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD),
+														_mm_mul_ps(detB, detC)), tr);
+		if (_mm_cvtss_f32(detM) == 0) {
+			DWARN("Trying to get Inverse of non-invertable matrix!");
+			return Mat4(*this);
+		}
+
+		__m128 rDetM = _mm_div_ps(_mm_setr_ps(REAL(1.0), REAL(-1.0), REAL(-1.0), REAL(1.0)), detM);
+		x = _mm_mul_ps(x, rDetM);
+		y = _mm_mul_ps(y, rDetM);
+		z = _mm_mul_ps(z, rDetM);
+		w = _mm_mul_ps(w, rDetM);
+
+		Mat4 r;
+		r.m_d.col[0] = CAT_MAT4_SHUFFLE(x, y, 3, 1, 3, 1);
+		r.m_d.col[1] = CAT_MAT4_SHUFFLE(x, y, 2, 0, 2, 0);
+		r.m_d.col[2] = CAT_MAT4_SHUFFLE(z, w, 3, 1, 3, 1);
+		r.m_d.col[3] = CAT_MAT4_SHUFFLE(z, w, 2, 0, 2, 0);
+		return r;
+#else
 		Real detM = determinant();
 		if (detM == 0) {
 			DWARN("Trying to get Inverse of non-invertable matrix!");
@@ -95,7 +246,7 @@ namespace Cat {
 		
 		r /= detM;
 		return r;		
-
+#endif
 	}
 
 	Vec3 Mat4::rotateInverse(const Vec3& v) const {
@@ -153,7 +304,7 @@ namespace Cat {
 
 	void Mat4::setToPerspectiveProjection(Real p_fov, Real p_aspect, Real p_n,
 													  Real p_f) {
-	   Real top = tan(CC_DEGTORAD*p_fov*0.5f) * p_n;
+	   Real top = tan(CAT_DEGTORAD*p_fov*0.5f) * p_n;
 		Real right = p_aspect * top;
 		setToPerspectiveProjection(right, -right, top, -top, p_n, p_f);
 	}
@@ -3,6 +3,449 @@
 namespace Cat {
 
 	namespace Math {
-		
+
+		namespace {
+
+			/* Lanes with |x| above this are reduced by libm, the three part
+			 * reduction by pi/2 below stays exact up to here */
+			const F32 kSinCosMaxArg = 8192.0f;
+			/* exp() overflows above, and underflows to zero below */
+			const F32 kExpMaxArg = 88.7228394f;
+			const F32 kExpMinArg = -103.972084f;
+			/* Adding and subtracting this rounds to the nearest integer */
+			const F32 kRoundMagic = 12582912.0f;
+
+			union RealBits {
+				F32 f;
+				I32 i;
+			};
+
+			/**
+			 * @brief The operations used by the kernels, on one Real at a time.
+			 * Masks are Reals with all bits set (true) or clear (false).
+			 */
+			struct ScalarOps {
+				typedef F32 V;
+				typedef I32 I;
+				enum { kWidth = 1 };
+
+				static inline V load(const F32* p) { return *p; }
+				static inline void store(F32* p, V v) { *p = v; }
+				static inline V set(F32 f) { return f; }
+				static inline I seti(I32 i) { return i; }
+
+				static inline V add(V a, V b) { return a + b; }
+				static inline V sub(V a, V b) { return a - b; }
+				static inline V mul(V a, V b) { return a * b; }
+				static inline V div(V a, V b) { return a / b; }
+				static inline V sqrt(V a) { return ::sqrtf(a); }
+				/* No estimate instruction, so the fast estimate is exact */
+				static inline V rsqrtEstimate(V a) { return 1.0f / ::sqrtf(a); }
+
+				static inline I asInt(V a) { RealBits b; b.f = a; return b.i; }
+				static inline V asReal(I a) { RealBits b; b.i = a; return b.f; }
+				static inline V mask(Boolean b) { return asReal(b ? -1 : 0); }
+
+				static inline V andv(V a, V b) { return asReal(asInt(a) & asInt(b)); }
+				static inline V andnot(V a, V b) { return asReal(~asInt(a) & asInt(b)); }
+				static inline V orv(V a, V b) { return asReal(asInt(a) | asInt(b)); }
+				static inline V xorv(V a, V b) { return asReal(asInt(a) ^ asInt(b)); }
+				static inline V select(V m, V a, V b) { return asInt(m) ? a : b; }
+				static inline Boolean any(V m) { return asInt(m) != 0; }
+
+				static inline V cmplt(V a, V b) { return mask(a < b); }
+				static inline V cmpgt(V a, V b) { return mask(a > b); }
+				static inline V cmpeq(V a, V b) { return mask(a == b); }
+				static inline V cmpneq(V a, V b) { return mask(!(a == b)); }
+
+				static inline I toInt(V a) { return (I32)a; }
+				static inline V toReal(I a) { return (F32)a; }
+				static inline I addi(I a, I b) { return a + b; }
+				static inline I subi(I a, I b) { return a - b; }
+				static inline I andi(I a, I b) { return a & b; }
+				static inline I ori(I a, I b) { return a | b; }
+				static inline V cmpeqi(I a, I b) { return mask(a == b); }
+				static inline I shl(I a, I32 n) { return (I32)((U32)a << n); }
+				static inline I sra(I a, I32 n) { return a >> n; }
+			};
+
+#if defined (CAT_SIMD_SSE2)
+			/**
+			 * @brief The same operations, on four Reals at a time.
+			 */
+			struct SseOps {
+				typedef __m128 V;
+				typedef __m128i I;
+				enum { kWidth = 4 };
+
+				static inline V load(const F32* p) { return _mm_loadu_ps(p); }
+				static inline void store(F32* p, V v) { _mm_storeu_ps(p, v); }
+				static inline V set(F32 f) { return _mm_set1_ps(f); }
+				static inline I seti(I32 i) { return _mm_set1_epi32(i); }
+
+				static inline V add(V a, V b) { return _mm_add_ps(a, b); }
+				static inline V sub(V a, V b) { return _mm_sub_ps(a, b); }
+				static inline V mul(V a, V b) { return _mm_mul_ps(a, b); }
+				static inline V div(V a, V b) { return _mm_div_ps(a, b); }
+				static inline V sqrt(V a) { return _mm_sqrt_ps(a); }
+				static inline V rsqrtEstimate(V a) { return _mm_rsqrt_ps(a); }
+
+				static inline I asInt(V a) { return _mm_castps_si128(a); }
+				static inline V asReal(I a) { return _mm_castsi128_ps(a); }
+
+				static inline V andv(V a, V b) { return _mm_and_ps(a, b); }
+				static inline V andnot(V a, V b) { return _mm_andnot_ps(a, b); }
+				static inline V orv(V a, V b) { return _mm_or_ps(a, b); }
+				static inline V xorv(V a, V b) { return _mm_xor_ps(a, b); }
+				static inline V select(V m, V a, V b) {
+					return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+				}
+				static inline Boolean any(V m) { return _mm_movemask_ps(m) != 0; }
+
+				static inline V cmplt(V a, V b) { return _mm_cmplt_ps(a, b); }
+				static inline V cmpgt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+				static inline V cmpeq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+				static inline V cmpneq(V a, V b) { return _mm_cmpneq_ps(a, b); }
+
+				static inline I toInt(V a) { return _mm_cvttps_epi32(a); }
+				static inline V toReal(I a) { return _mm_cvtepi32_ps(a); }
+				static inline I addi(I a, I b) { return _mm_add_epi32(a, b); }
+				static inline I subi(I a, I b) { return _mm_sub_epi32(a, b); }
+				static inline I andi(I a, I b) { return _mm_and_si128(a, b); }
+				static inline I ori(I a, I b) { return _mm_or_si128(a, b); }
+				static inline V cmpeqi(I a, I b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+				static inline I shl(I a, I32 n) { return _mm_slli_epi32(a, n); }
+				static inline I sra(I a, I32 n) { return _mm_srai_epi32(a, n); }
+			};
+			typedef SseOps VectorOps;
+#else
+			typedef ScalarOps VectorOps;
+#endif
+
+			/**
+			 * @brief Round to the nearest integer (ties to even), for |x| < 2^22.
+			 */
+			template <class O>
+			inline typename O::V roundNearest(typename O::V x) {
+				return O::sub(O::add(x, O::set(kRoundMagic)), O::set(kRoundMagic));
+			}
+
+			/**
+			 * @brief Recompute the masked lanes with the scalar libm function.
+			 */
+			template <class O>
+			inline typename O::V fixLanes(typename O::V mask, typename O::V x,
+													typename O::V result, F32 (*func)(F32)) {
+				if (!O::any(mask)) {
+					return result;
+				}
+				F32 m[O::kWidth], in[O::kWidth], out[O::kWidth];
+				O::store(m, mask);
+				O::store(in, x);
+				O::store(out, result);
+				for (U32 i = 0; i < (U32)O::kWidth; ++i) {
+					if (ScalarOps::asInt(m[i])) {
+						out[i] = func(in[i]);
+					}
+				}
+				return O::load(out);
+			}
+
+			/**
+			 * @brief sin(x) for quadrant 0, cos(x) for quadrant 1, reducing x
+			 * by pi/2 (Cody-Waite) and evaluating minimax polynomials on
+			 * [-pi/4, pi/4] (the precise ones from Cephes).
+			 */
+			template <class O, Boolean FAST>
+			inline typename O::V sinCos(typename O::V x, I32 quadrant) {
+				typedef typename O::V V;
+				typedef typename O::I I;
+				V inRange = O::cmplt(O::andnot(O::set(-0.0f), x), O::set(kSinCosMaxArg));
+				V xr = O::andv(inRange, x);
+
+				V j = roundNearest<O>(O::mul(xr, O::set(0.636619772f)));
+				V r = O::sub(O::sub(O::sub(xr, O::mul(j, O::set(1.5703125f))),
+										  O::mul(j, O::set(4.837512969970703125e-4f))),
+								 O::mul(j, O::set(7.54978995489188216e-8f)));
+				I q = O::addi(O::toInt(j), O::seti(quadrant));
+
+				V z = O::mul(r, r);
+				V s, c;
+				if (FAST) {
+					s = O::add(O::mul(O::set(8.16230331e-3f), z), O::set(-1.66633375e-1f));
+					c = O::add(O::mul(O::set(-1.36504759e-3f), z), O::set(4.16611671e-2f));
+				} else {
+					s = O::add(O::mul(O::set(-1.9515295891e-4f), z), O::set(8.3321608736e-3f));
+					s = O::add(O::mul(s, z), O::set(-1.6666654611e-1f));
+					c = O::add(O::mul(O::set(2.443315711809948e-5f), z), O::set(-1.388731625493765e-3f));
+					c = O::add(O::mul(c, z), O::set(4.166664568298827e-2f));
+				}
+				s = O::add(r, O::mul(O::mul(s, z), r));
+				c = O::add(O::sub(O::set(1.0f), O::mul(z, O::set(0.5f))), O::mul(O::mul(c, z), z));
+
+				/* Odd quadrants use the cosine, quadrants 2 and 3 are negated */
+				V useCos = O::cmpeqi(O::andi(q, O::seti(1)), O::seti(1));
+				V sign = O::asReal(O::shl(O::andi(q, O::seti(2)), 30));
+				V result = O::xorv(O::select(useCos, c, s), sign);
+				if (quadrant == 0) {
+					/* Keep the sign of zero, sin(-0) = -0 */
+					result = O::select(O::cmpeq(x, O::set(0.0f)), x, result);
+				}
+				return fixLanes<O>(O::andnot(inRange, O::asReal(O::seti(-1))), x, result,
+										 quadrant ? ::cosf : ::sinf);
+			}
+
+			/**
+			 * @brief e^x, as 2^n * e^r with |r| <= ln(2)/2.  The scale is
+			 * applied as two powers of two, so results near the overflow
+			 * threshold and denormal results are still rounded correctly.
+			 */
+			template <class O, Boolean FAST>
+			inline typename O::V exp(typename O::V x) {
+				typedef typename O::V V;
+				typedef typename O::I I;
+				V over = O::cmpgt(x, O::set(kExpMaxArg));
+				V under = O::cmplt(x, O::set(kExpMinArg));
+				V nan = O::cmpneq(x, x);
+				V xc = O::andnot(O::orv(O::orv(over, under), nan), x);
+
+				V n = roundNearest<O>(O::mul(xc, O::set(1.44269504088896341f)));
+				V r, p;
+				if (FAST) {
+					r = O::sub(xc, O::mul(n, O::set(0.693147181f)));
+					p = O::add(O::mul(O::set(4.09174029e-2f), r), O::set(1.67539760e-1f));
+					p = O::add(O::mul(p, r), O::set(5.00089310e-1f));
+				} else {
+					r = O::sub(O::sub(xc, O::mul(n, O::set(0.693359375f))),
+								  O::mul(n, O::set(-2.12194440e-4f)));
+					p = O::add(O::mul(O::set(1.9875691500e-4f), r), O::set(1.3981999507e-3f));
+					p = O::add(O::mul(p, r), O::set(8.3334519073e-3f));
+					p = O::add(O::mul(p, r), O::set(4.1665795894e-2f));
+					p = O::add(O::mul(p, r), O::set(1.6666665459e-1f));
+					p = O::add(O::mul(p, r), O::set(5.0000001201e-1f));
+				}
+				p = O::add(O::add(O::mul(O::mul(p, r), r), r), O::set(1.0f));
+
+				I ni = O::toInt(n);
+				I half = O::sra(ni, 1);
+				V a = O::asReal(O::shl(O::addi(half, O::seti(127)), 23));
+				V b = O::asReal(O::shl(O::addi(O::subi(ni, half), O::seti(127)), 23));
+				V result = O::mul(O::mul(p, a), b);
+
+				result = O::select(over, O::asReal(O::seti(0x7F800000)), result);
+				result = O::andnot(under, result);
+				return O::select(nan, x, result);
+			}
+
+			/**
+			 * @brief ln(x), as e*ln(2) + ln(1 + r) with r in [sqrt(1/2) - 1,
+			 * sqrt(2) - 1].  Denormals are scaled up first, zero gives -inf and
+			 * negative numbers give NaN.
+			 */
+			template <class O, Boolean FAST>
+			inline typename O::V log(typename O::V x) {
+				typedef typename O::V V;
+				typedef typename O::I I;
+				V invalid = O::orv(O::cmplt(x, O::set(0.0f)), O::cmpneq(x, x));
+				V zero = O::cmpeq(x, O::set(0.0f));
+				V inf = O::cmpeq(x, O::asReal(O::seti(0x7F800000)));
+
+				V denormal = O::cmplt(x, O::set(1.17549435e-38f));
+				V xs = O::select(denormal, O::mul(x, O::set(8388608.0f)), x);
+				I bits = O::asInt(xs);
+				I e = O::subi(O::sra(bits, 23), O::seti(126));
+				e = O::subi(e, O::andi(O::asInt(denormal), O::seti(23)));
+				V m = O::asReal(O::ori(O::andi(bits, O::seti(0x007FFFFF)), O::seti(0x3F000000)));
+
+				/* Keep the mantissa in [sqrt(1/2), sqrt(2)) */
+				V small = O::cmplt(m, O::set(0.707106781186547524f));
+				e = O::subi(e, O::andi(O::asInt(small), O::seti(1)));
+				V r = O::sub(O::add(m, O::andv(small, m)), O::set(1.0f));
+				V ef = O::toReal(e);
+
+				V z = O::mul(r, r);
+				V p;
+				if (FAST) {
+					p = O::add(O::mul(O::set(-1.47769956e-1f), r), O::set(2.18916673e-1f));
+					p = O::add(O::mul(p, r), O::set(-2.52352715e-1f));
+					p = O::add(O::mul(p, r), O::set(3.32753038e-1f));
+				} else {
+					p = O::add(O::mul(O::set(7.0376836292e-2f), r), O::set(-1.1514610310e-1f));
+					p = O::add(O::mul(p, r), O::set(1.1676998740e-1f));
+					p = O::add(O::mul(p, r), O::set(-1.2420140846e-1f));
+					p = O::add(O::mul(p, r), O::set(1.4249322787e-1f));
+					p = O::add(O::mul(p, r), O::set(-1.6668057665e-1f));
+					p = O::add(O::mul(p, r), O::set(2.0000714765e-1f));
+					p = O::add(O::mul(p, r), O::set(-2.4999993993e-1f));
+					p = O::add(O::mul(p, r), O::set(3.3333331174e-1f));
+				}
+				V y = O::mul(O::mul(p, r), z);
+				V result;
+				if (FAST) {
+					y = O::sub(y, O::mul(z, O::set(0.5f)));
+					result = O::add(O::add(r, y), O::mul(ef, O::set(0.693147181f)));
+				} else {
+					y = O::add(y, O::mul(ef, O::set(-2.12194440e-4f)));
+					y = O::sub(y, O::mul(z, O::set(0.5f)));
+					result = O::add(O::add(r, y), O::mul(ef, O::set(0.693359375f)));
+				}
+
+				result = O::select(zero, O::asReal(O::seti((I32)0xFF800000)), result);
+				result = O::select(inf, x, result);
+				return O::select(invalid, O::asReal(O::seti(0x7FC00000)), result);
+			}
+
+			/**
+			 * @brief x^y, as e^(y*ln|x|), with the signs and special cases of
+			 * the C pow() function.
+			 */
+			template <class O, Boolean FAST>
+			inline typename O::V pow(typename O::V x, typename O::V y) {
+				typedef typename O::V V;
+				V signBit = O::set(-0.0f);
+				V result = exp<O, FAST>(O::mul(y, log<O, FAST>(O::andnot(signBit, x))));
+
+				/* A negative x only has a real power if y is an integer */
+				V negative = O::cmpeqi(O::asInt(O::andv(x, signBit)), O::asInt(signBit));
+				V absY = O::andnot(signBit, y);
+				if (O::any(negative)) {
+					/* Every float from 2^24 up is an even integer, below it truncation is exact */
+					V yi = O::andv(O::cmplt(absY, O::set(16777216.0f)), y);
+					typename O::I yt = O::toInt(yi);
+					V isInt = O::cmpeq(O::toReal(yt), yi);
+					V odd = O::cmpeqi(O::andi(yt, O::seti(1)), O::seti(1));
+					result = O::xorv(result, O::andv(O::andv(negative, odd), signBit));
+					result = O::select(O::andnot(isInt, negative), O::asReal(O::seti(0x7FC00000)), result);
+				}
+				/* As in C, 1^y, x^0 and (-1)^(+-inf) are all 1, even for a NaN */
+				V one = O::orv(O::cmpeq(y, O::set(0.0f)), O::cmpeq(x, O::set(1.0f)));
+				one = O::orv(one, O::andv(O::cmpeq(x, O::set(-1.0f)),
+												  O::cmpeq(absY, O::asReal(O::seti(0x7F800000)))));
+				return O::select(one, O::set(1.0f), result);
+			}
+
+			/**
+			 * @brief 1/sqrt(x), the fast version refines the hardware estimate
+			 * with one Newton-Raphson step.
+			 */
+			template <class O, Boolean FAST>
+			inline typename O::V inversesqrt(typename O::V x) {
+				typedef typename O::V V;
+				if (!FAST) {
+					return O::div(O::set(1.0f), O::sqrt(x));
+				}
+				V e = O::rsqrtEstimate(x);
+				V nr = O::mul(O::mul(O::set(0.5f), e),
+								  O::sub(O::set(3.0f), O::mul(O::mul(x, e), e)));
+				/* The step gives NaN for 0 and inf, where the estimate is exact */
+				V exact = O::orv(O::cmpeq(x, O::set(0.0f)),
+									  O::cmpeq(x, O::asReal(O::seti(0x7F800000))));
+				return O::select(exact, e, nr);
+			}
+
+			template <class O, Boolean FAST> struct SinFunc {
+				static inline typename O::V eval(typename O::V x, typename O::V) {
+					return sinCos<O, FAST>(x, 0);
+				}
+			};
+			template <class O, Boolean FAST> struct CosFunc {
+				static inline typename O::V eval(typename O::V x, typename O::V) {
+					return sinCos<O, FAST>(x, 1);
+				}
+			};
+			template <class O, Boolean FAST> struct ExpFunc {
+				static inline typename O::V eval(typename O::V x, typename O::V) {
+					return exp<O, FAST>(x);
+				}
+			};
+			template <class O, Boolean FAST> struct LogFunc {
+				static inline typename O::V eval(typename O::V x, typename O::V) {
+					return log<O, FAST>(x);
+				}
+			};
+			template <class O, Boolean FAST> struct PowFunc {
+				static inline typename O::V eval(typename O::V x, typename O::V y) {
+					return pow<O, FAST>(x, y);
+				}
+			};
+			template <class O, Boolean FAST> struct InverseSqrtFunc {
+				static inline typename O::V eval(typename O::V x, typename O::V) {
+					return inversesqrt<O, FAST>(x);
+				}
+			};
+
+			/**
+			 * @brief Evaluate a function over the arrays, a whole vector at a
+			 * time.  The second argument is p_y[i], or p_yValue if p_y is NIL.
+			 */
+			template <class O, class F>
+			void applySpan(const Real* p_x, const Real* p_y, Real p_yValue,
+								Real* p_result, Size p_count) {
+				typename O::V yValue = O::set(p_yValue);
+				Size i = 0;
+				for (; i + O::kWidth <= p_count; i += O::kWidth) {
+					O::store(p_result + i, F::eval(O::load(p_x + i),
+															 p_y ? O::load(p_y + i) : yValue));
+				}
+				if (i < p_count) {
+					/* Pad the last vector with ones, valid for every function */
+					F32 x[O::kWidth], y[O::kWidth];
+					for (U32 k = 0; k < (U32)O::kWidth; ++k) {
+						x[k] = 1.0f;
+						y[k] = p_yValue;
+					}
+					for (Size k = i; k < p_count; ++k) {
+						x[k - i] = p_x[k];
+						y[k - i] = p_y ? p_y[k] : p_yValue;
+					}
+					O::store(x, F::eval(O::load(x), O::load(y)));
+					for (Size k = i; k < p_count; ++k) {
+						p_result[k] = x[k - i];
+					}
+				}
+			}
+
+			template <template <class, Boolean> class F>
+			inline void apply(const Real* p_x, const Real* p_y, Real p_yValue,
+									Real* p_result, Size p_count, Precision p_precision) {
+				if (p_precision == kFast) {
+					applySpan<VectorOps, F<VectorOps, true> >(p_x, p_y, p_yValue, p_result, p_count);
+				} else {
+					applySpan<VectorOps, F<VectorOps, false> >(p_x, p_y, p_yValue, p_result, p_count);
+				}
+			}
+
+		} // namespace
+
+		void cos(const Real* p_angles, Real* p_result, Size p_count, Precision p_precision) {
+			apply<CosFunc>(p_angles, NIL, 0, p_result, p_count, p_precision);
+		}
+
+		void exp(const Real* p_x, Real* p_result, Size p_count, Precision p_precision) {
+			apply<ExpFunc>(p_x, NIL, 0, p_result, p_count, p_precision);
+		}
+
+		void inversesqrt(const Real* p_x, Real* p_result, Size p_count, Precision p_precision) {
+			apply<InverseSqrtFunc>(p_x, NIL, 0, p_result, p_count, p_precision);
+		}
+
+		void log(const Real* p_x, Real* p_result, Size p_count, Precision p_precision) {
+			apply<LogFunc>(p_x, NIL, 0, p_result, p_count, p_precision);
+		}
+
+		void pow(const Real* p_x, Real p_exp, Real* p_result, Size p_count,
+					Precision p_precision) {
+			apply<PowFunc>(p_x, NIL, p_exp, p_result, p_count, p_precision);
+		}
+
+		void pow(const Real* p_x, const Real* p_exp, Real* p_result, Size p_count,
+					Precision p_precision) {
+			apply<PowFunc>(p_x, p_exp, 0, p_result, p_count, p_precision);
+		}
+
+		void sin(const Real* p_angles, Real* p_result, Size p_count, Precision p_precision) {
+			apply<SinFunc>(p_angles, NIL, 0, p_result, p_count, p_precision);
+		}
+
 	} // namespace math
 } // namespace Cat
@@ -0,0 +1,508 @@
+#include "core/math/mathkernels.h"
+#include "core/math/mathcore.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	/*************************************************************
+	 * Scalar kernels
+	 *************************************************************/
+
+	static void scalarTransformVec3(const Mat4& m, const Vec3* src, Vec3* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = m * src[i];
+		}
+	}
+
+	static void scalarTransformSoA(const Mat4& m, const Vec3SoA& src, const Vec3SoA& dst,
+											 Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Vec3 v = m * Vec3(src.x[i], src.y[i], src.z[i]);
+			dst.x[i] = v.x;
+			dst.y[i] = v.y;
+			dst.z[i] = v.z;
+		}
+	}
+
+	static void scalarTransformVec4(const Mat4& m, const Vec4* src, Vec4* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = m * src[i];
+		}
+	}
+
+	static void scalarMultiplyMat4(const Mat4* lhs, const Mat4* rhs, Mat4* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = lhs[i] * rhs[i];
+		}
+	}
+
+	static void scalarNormaliseVec3(const Vec3* src, Vec3* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = Math::normalised(src[i]);
+		}
+	}
+
+	static void scalarNormaliseSoA(const Vec3SoA& src, const Vec3SoA& dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Vec3 v = Math::normalised(Vec3(src.x[i], src.y[i], src.z[i]));
+			dst.x[i] = v.x;
+			dst.y[i] = v.y;
+			dst.z[i] = v.z;
+		}
+	}
+
+	static void scalarCrossVec3(const Vec3* lhs, const Vec3* rhs, Vec3* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = Math::cross(lhs[i], rhs[i]);
+		}
+	}
+
+	static void scalarCrossSoA(const Vec3SoA& lhs, const Vec3SoA& rhs, const Vec3SoA& dst,
+										Size count) {
+		for (Size i = 0; i < count; ++i) {
+			Vec3 v = Math::cross(Vec3(lhs.x[i], lhs.y[i], lhs.z[i]),
+										Vec3(rhs.x[i], rhs.y[i], rhs.z[i]));
+			dst.x[i] = v.x;
+			dst.y[i] = v.y;
+			dst.z[i] = v.z;
+		}
+	}
+
+	static const MathKernels::Table s_scalarTable = {
+		scalarTransformVec3,
+		scalarTransformSoA,
+		scalarTransformVec4,
+		scalarMultiplyMat4,
+		scalarNormaliseVec3,
+		scalarNormaliseSoA,
+		scalarCrossVec3,
+		scalarCrossSoA,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/*************************************************************
+	 * SSE2 kernels
+	 *************************************************************/
+
+	static inline const Real* matrixData(const Mat4& m) {
+		return m.getMatrixDataConst().m;
+	}
+
+	/**
+	 * @brief The matrix, with each of the 12 components used to transform
+	 * a point broadcast to a whole vector.
+	 */
+	struct Sse2PointMatrix {
+		__m128 m[12];
+
+		explicit Sse2PointMatrix(const Mat4& mat) {
+			const Real* d = matrixData(mat);
+			for (U32 row = 0; row < 3; ++row) {
+				for (U32 col = 0; col < 4; ++col) {
+					m[row*4 + col] = _mm_set1_ps(d[col*4 + row]);
+				}
+			}
+		}
+	};
+
+	/* Same order of operations as Mat4 * Vec3 */
+	static inline void sse2TransformPoints(const Sse2PointMatrix& pm, __m128& x, __m128& y,
+														__m128& z) {
+		const __m128* m = pm.m;
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[1], y)),
+													 _mm_mul_ps(m[2], z)), m[3]);
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[4], x), _mm_mul_ps(m[5], y)),
+													 _mm_mul_ps(m[6], z)), m[7]);
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[8], x), _mm_mul_ps(m[9], y)),
+													 _mm_mul_ps(m[10], z)), m[11]);
+		x = rx;
+		y = ry;
+		z = rz;
+	}
+
+	/* Math::inversesqrt() is computed in double precision, so this is too */
+	static inline __m128 sse2InverseSqrt(__m128 l) {
+		__m128d one = _mm_set1_pd(1.0);
+		__m128 lo = _mm_cvtpd_ps(_mm_div_pd(one, _mm_sqrt_pd(_mm_cvtps_pd(l))));
+		__m128 hi = _mm_cvtpd_ps(_mm_div_pd(one, _mm_sqrt_pd(_mm_cvtps_pd(_mm_movehl_ps(l, l)))));
+		return _mm_movelh_ps(lo, hi);
+	}
+
+	/* Same order of operations as Math::normalised() */
+	static inline void sse2Normalise(__m128& x, __m128& y, __m128& z) {
+		__m128 l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		__m128 nonZero = _mm_cmpneq_ps(l, _mm_setzero_ps());
+		__m128 inv = _mm_and_ps(nonZero, sse2InverseSqrt(l));
+		x = _mm_mul_ps(x, inv);
+		y = _mm_mul_ps(y, inv);
+		z = _mm_mul_ps(z, inv);
+	}
+
+	static inline void sse2Cross(__m128 x1, __m128 y1, __m128 z1,
+										  __m128 x2, __m128 y2, __m128 z2,
+										  __m128& x, __m128& y, __m128& z) {
+		x = _mm_sub_ps(_mm_mul_ps(y1, z2), _mm_mul_ps(z1, y2));
+		y = _mm_sub_ps(_mm_mul_ps(z1, x2), _mm_mul_ps(x1, z2));
+		z = _mm_sub_ps(_mm_mul_ps(x1, y2), _mm_mul_ps(y1, x2));
+	}
+
+	/**
+	 * @brief Load 4 packed Vec3s (12 Reals) and transpose them into x, y, z vectors.
+	 */
+	static inline void sse2LoadVec3x4(const Vec3* src, __m128& x, __m128& y, __m128& z) {
+		const Real* p = &(src->x);
+		__m128 a = _mm_loadu_ps(p);      /* x0 y0 z0 x1 */
+		__m128 b = _mm_loadu_ps(p + 4);  /* y1 z1 x2 y2 */
+		__m128 c = _mm_loadu_ps(p + 8);  /* z2 x3 y3 z3 */
+		__m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+		x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+								 _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+								 _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+								 _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+								 _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	/**
+	 * @brief Transpose x, y, z vectors back into 4 packed Vec3s and store them.
+	 */
+	static inline void sse2StoreVec3x4(Vec3* dst, __m128 x, __m128 y, __m128 z) {
+		Real* p = &(dst->x);
+		_mm_storeu_ps(p, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+												  _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+												  _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+														_mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+														_MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+														_mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+														_MM_SHUFFLE(2, 0, 2, 0)));
+	}
+
+	static void sse2TransformVec3(const Mat4& m, const Vec3* src, Vec3* dst, Size count) {
+		Sse2PointMatrix pm(m);
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x, y, z;
+			sse2LoadVec3x4(src + i, x, y, z);
+			sse2TransformPoints(pm, x, y, z);
+			sse2StoreVec3x4(dst + i, x, y, z);
+		}
+		scalarTransformVec3(m, src + i, dst + i, count - i);
+	}
+
+	static void sse2TransformSoA(const Mat4& m, const Vec3SoA& src, const Vec3SoA& dst,
+										  Size count) {
+		Sse2PointMatrix pm(m);
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(src.x + i);
+			__m128 y = _mm_loadu_ps(src.y + i);
+			__m128 z = _mm_loadu_ps(src.z + i);
+			sse2TransformPoints(pm, x, y, z);
+			_mm_storeu_ps(dst.x + i, x);
+			_mm_storeu_ps(dst.y + i, y);
+			_mm_storeu_ps(dst.z + i, z);
+		}
+		Vec3SoA srcTail(src.x + i, src.y + i, src.z + i);
+		Vec3SoA dstTail(dst.x + i, dst.y + i, dst.z + i);
+		scalarTransformSoA(m, srcTail, dstTail, count - i);
+	}
+
+	static void sse2TransformVec4(const Mat4& m, const Vec4* src, Vec4* dst, Size count) {
+		const Real* d = matrixData(m);
+		__m128 c0 = _mm_loadu_ps(d);
+		__m128 c1 = _mm_loadu_ps(d + 4);
+		__m128 c2 = _mm_loadu_ps(d + 8);
+		__m128 c3 = _mm_loadu_ps(d + 12);
+		for (Size i = 0; i < count; ++i) {
+			__m128 v = _mm_loadu_ps(&(src[i].x));
+			__m128 r = _mm_add_ps(
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00)),
+											 _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55))),
+							  _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA))),
+				_mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xFF)));
+			_mm_storeu_ps(&(dst[i].x), r);
+		}
+	}
+
+	static void sse2MultiplyMat4(const Mat4* lhs, const Mat4* rhs, Mat4* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			const Real* a = matrixData(lhs[i]);
+			const Real* b = matrixData(rhs[i]);
+			__m128 c0 = _mm_loadu_ps(a);
+			__m128 c1 = _mm_loadu_ps(a + 4);
+			__m128 c2 = _mm_loadu_ps(a + 8);
+			__m128 c3 = _mm_loadu_ps(a + 12);
+			__m128 r[4];
+			for (U32 col = 0; col < 4; ++col) {
+				__m128 v = _mm_loadu_ps(b + col*4);
+				r[col] = _mm_add_ps(
+					_mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00)),
+												 _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55))),
+								  _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA))),
+					_mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xFF)));
+			}
+			Real* out = dst[i].getMatrixData().m;
+			_mm_storeu_ps(out, r[0]);
+			_mm_storeu_ps(out + 4, r[1]);
+			_mm_storeu_ps(out + 8, r[2]);
+			_mm_storeu_ps(out + 12, r[3]);
+		}
+	}
+
+	static void sse2NormaliseVec3(const Vec3* src, Vec3* dst, Size count) {
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x, y, z;
+			sse2LoadVec3x4(src + i, x, y, z);
+			sse2Normalise(x, y, z);
+			sse2StoreVec3x4(dst + i, x, y, z);
+		}
+		scalarNormaliseVec3(src + i, dst + i, count - i);
+	}
+
+	static void sse2NormaliseSoA(const Vec3SoA& src, const Vec3SoA& dst, Size count) {
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(src.x + i);
+			__m128 y = _mm_loadu_ps(src.y + i);
+			__m128 z = _mm_loadu_ps(src.z + i);
+			sse2Normalise(x, y, z);
+			_mm_storeu_ps(dst.x + i, x);
+			_mm_storeu_ps(dst.y + i, y);
+			_mm_storeu_ps(dst.z + i, z);
+		}
+		Vec3SoA srcTail(src.x + i, src.y + i, src.z + i);
+		Vec3SoA dstTail(dst.x + i, dst.y + i, dst.z + i);
+		scalarNormaliseSoA(srcTail, dstTail, count - i);
+	}
+
+	static void sse2CrossVec3(const Vec3* lhs, const Vec3* rhs, Vec3* dst, Size count) {
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x1, y1, z1, x2, y2, z2, x, y, z;
+			sse2LoadVec3x4(lhs + i, x1, y1, z1);
+			sse2LoadVec3x4(rhs + i, x2, y2, z2);
+			sse2Cross(x1, y1, z1, x2, y2, z2, x, y, z);
+			sse2StoreVec3x4(dst + i, x, y, z);
+		}
+		scalarCrossVec3(lhs + i, rhs + i, dst + i, count - i);
+	}
+
+	static void sse2CrossSoA(const Vec3SoA& lhs, const Vec3SoA& rhs, const Vec3SoA& dst,
+									 Size count) {
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x, y, z;
+			sse2Cross(_mm_loadu_ps(lhs.x + i), _mm_loadu_ps(lhs.y + i), _mm_loadu_ps(lhs.z + i),
+						 _mm_loadu_ps(rhs.x + i), _mm_loadu_ps(rhs.y + i), _mm_loadu_ps(rhs.z + i),
+						 x, y, z);
+			_mm_storeu_ps(dst.x + i, x);
+			_mm_storeu_ps(dst.y + i, y);
+			_mm_storeu_ps(dst.z + i, z);
+		}
+		Vec3SoA lhsTail(lhs.x + i, lhs.y + i, lhs.z + i);
+		Vec3SoA rhsTail(rhs.x + i, rhs.y + i, rhs.z + i);
+		Vec3SoA dstTail(dst.x + i, dst.y + i, dst.z + i);
+		scalarCrossSoA(lhsTail, rhsTail, dstTail, count - i);
+	}
+
+	static const MathKernels::Table s_sse2Table = {
+		sse2TransformVec3,
+		sse2TransformSoA,
+		sse2TransformVec4,
+		sse2MultiplyMat4,
+		sse2NormaliseVec3,
+		sse2NormaliseSoA,
+		sse2CrossVec3,
+		sse2CrossSoA,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * AVX2 kernels
+	 *
+	 * The packed Vec3 kernels use the SSE2 versions, since 12 byte
+	 * vectors do not split evenly into 8 lanes.
+	 *************************************************************/
+
+	CAT_TARGET_AVX2_NO_FMA static inline __m256 avx2Column(const Real* col) {
+		return _mm256_broadcast_ps((const __m128*)col);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static inline __m256 avx2Combine(__m256 c0, __m256 c1, __m256 c2, __m256 c3,
+																	 __m256 v) {
+		return _mm256_add_ps(
+			_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, _mm256_permute_ps(v, 0x00)),
+												 _mm256_mul_ps(c1, _mm256_permute_ps(v, 0x55))),
+							  _mm256_mul_ps(c2, _mm256_permute_ps(v, 0xAA))),
+			_mm256_mul_ps(c3, _mm256_permute_ps(v, 0xFF)));
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static inline void avx2Normalise(__m256& x, __m256& y, __m256& z) {
+		__m256 l = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+										 _mm256_mul_ps(z, z));
+		__m256 nonZero = _mm256_cmp_ps(l, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+		__m256d one = _mm256_set1_pd(1.0);
+		__m128 lo = _mm256_cvtpd_ps(_mm256_div_pd(one, _mm256_sqrt_pd(
+																	_mm256_cvtps_pd(_mm256_castps256_ps128(l)))));
+		__m128 hi = _mm256_cvtpd_ps(_mm256_div_pd(one, _mm256_sqrt_pd(
+																	_mm256_cvtps_pd(_mm256_extractf128_ps(l, 1)))));
+		__m256 inv = _mm256_and_ps(nonZero, _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+		x = _mm256_mul_ps(x, inv);
+		y = _mm256_mul_ps(y, inv);
+		z = _mm256_mul_ps(z, inv);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2TransformSoA(const Mat4& m, const Vec3SoA& src,
+																const Vec3SoA& dst, Size count) {
+		const Real* d = matrixData(m);
+		__m256 mm[12];
+		for (U32 row = 0; row < 3; ++row) {
+			for (U32 col = 0; col < 4; ++col) {
+				mm[row*4 + col] = _mm256_set1_ps(d[col*4 + row]);
+			}
+		}
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 x = _mm256_loadu_ps(src.x + i);
+			__m256 y = _mm256_loadu_ps(src.y + i);
+			__m256 z = _mm256_loadu_ps(src.z + i);
+			__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(mm[0], x),
+																					_mm256_mul_ps(mm[1], y)),
+																	  _mm256_mul_ps(mm[2], z)), mm[3]);
+			__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(mm[4], x),
+																					_mm256_mul_ps(mm[5], y)),
+																	  _mm256_mul_ps(mm[6], z)), mm[7]);
+			__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(mm[8], x),
+																					_mm256_mul_ps(mm[9], y)),
+																	  _mm256_mul_ps(mm[10], z)), mm[11]);
+			_mm256_storeu_ps(dst.x + i, rx);
+			_mm256_storeu_ps(dst.y + i, ry);
+			_mm256_storeu_ps(dst.z + i, rz);
+		}
+		Vec3SoA srcTail(src.x + i, src.y + i, src.z + i);
+		Vec3SoA dstTail(dst.x + i, dst.y + i, dst.z + i);
+		sse2TransformSoA(m, srcTail, dstTail, count - i);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2TransformVec4(const Mat4& m, const Vec4* src, Vec4* dst,
+																 Size count) {
+		const Real* d = matrixData(m);
+		__m256 c0 = avx2Column(d);
+		__m256 c1 = avx2Column(d + 4);
+		__m256 c2 = avx2Column(d + 8);
+		__m256 c3 = avx2Column(d + 12);
+		Size i = 0;
+		for (; i + 2 <= count; i += 2) {
+			__m256 v = _mm256_loadu_ps(&(src[i].x));
+			_mm256_storeu_ps(&(dst[i].x), avx2Combine(c0, c1, c2, c3, v));
+		}
+		sse2TransformVec4(m, src + i, dst + i, count - i);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2MultiplyMat4(const Mat4* lhs, const Mat4* rhs, Mat4* dst,
+																Size count) {
+		for (Size i = 0; i < count; ++i) {
+			const Real* a = matrixData(lhs[i]);
+			const Real* b = matrixData(rhs[i]);
+			__m256 c0 = avx2Column(a);
+			__m256 c1 = avx2Column(a + 4);
+			__m256 c2 = avx2Column(a + 8);
+			__m256 c3 = avx2Column(a + 12);
+			/* Two columns of the product at a time */
+			__m256 r01 = avx2Combine(c0, c1, c2, c3, _mm256_loadu_ps(b));
+			__m256 r23 = avx2Combine(c0, c1, c2, c3, _mm256_loadu_ps(b + 8));
+			Real* out = dst[i].getMatrixData().m;
+			_mm256_storeu_ps(out, r01);
+			_mm256_storeu_ps(out + 8, r23);
+		}
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2NormaliseSoA(const Vec3SoA& src, const Vec3SoA& dst,
+																Size count) {
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 x = _mm256_loadu_ps(src.x + i);
+			__m256 y = _mm256_loadu_ps(src.y + i);
+			__m256 z = _mm256_loadu_ps(src.z + i);
+			avx2Normalise(x, y, z);
+			_mm256_storeu_ps(dst.x + i, x);
+			_mm256_storeu_ps(dst.y + i, y);
+			_mm256_storeu_ps(dst.z + i, z);
+		}
+		Vec3SoA srcTail(src.x + i, src.y + i, src.z + i);
+		Vec3SoA dstTail(dst.x + i, dst.y + i, dst.z + i);
+		sse2NormaliseSoA(srcTail, dstTail, count - i);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2CrossSoA(const Vec3SoA& lhs, const Vec3SoA& rhs,
+														  const Vec3SoA& dst, Size count) {
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 x1 = _mm256_loadu_ps(lhs.x + i);
+			__m256 y1 = _mm256_loadu_ps(lhs.y + i);
+			__m256 z1 = _mm256_loadu_ps(lhs.z + i);
+			__m256 x2 = _mm256_loadu_ps(rhs.x + i);
+			__m256 y2 = _mm256_loadu_ps(rhs.y + i);
+			__m256 z2 = _mm256_loadu_ps(rhs.z + i);
+			_mm256_storeu_ps(dst.x + i, _mm256_sub_ps(_mm256_mul_ps(y1, z2), _mm256_mul_ps(z1, y2)));
+			_mm256_storeu_ps(dst.y + i, _mm256_sub_ps(_mm256_mul_ps(z1, x2), _mm256_mul_ps(x1, z2)));
+			_mm256_storeu_ps(dst.z + i, _mm256_sub_ps(_mm256_mul_ps(x1, y2), _mm256_mul_ps(y1, x2)));
+		}
+		Vec3SoA lhsTail(lhs.x + i, lhs.y + i, lhs.z + i);
+		Vec3SoA rhsTail(rhs.x + i, rhs.y + i, rhs.z + i);
+		Vec3SoA dstTail(dst.x + i, dst.y + i, dst.z + i);
+		sse2CrossSoA(lhsTail, rhsTail, dstTail, count - i);
+	}
+
+	static const MathKernels::Table s_avx2Table = {
+		sse2TransformVec3,
+		avx2TransformSoA,
+		avx2TransformVec4,
+		avx2MultiplyMat4,
+		sse2NormaliseVec3,
+		avx2NormaliseSoA,
+		sse2CrossVec3,
+		avx2CrossSoA,
+		"avx2"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const MathKernels::Table& MathKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const MathKernels::Table& MathKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size MathKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasAVX2()) {
+			tables[count++] = &s_avx2Table;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const MathKernels::Table* MathKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
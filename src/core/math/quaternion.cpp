@@ -8,15 +8,45 @@ namespace Cat {
 	const Quaternion Quaternion::kIdentity =
 		Quaternion(REAL(0.0), REAL(0.0), REAL(0.0), REAL(1.0));
 	
+#if defined (CAT_MATH_SSE)
+	/**
+	 * The product, with the same order of operations as the scalar version.
+	 * The w lane subtracts each product, which is done by flipping its sign.
+	 */
+	static inline __m128 sseProduct(__m128 q, __m128 r) {
+		const __m128 negW = _mm_castsi128_ps(_mm_set_epi32((I32)0x80000000, 0, 0, 0));
+		/* w*rx, w*ry, w*rz, w*rw */
+		__m128 a = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		/* x*rw, y*rw, z*rw, -(x*rx) */
+		__m128 b = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 2, 1, 0)),
+													_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 3, 3, 3))), negW);
+		/* y*rz, z*rx, x*ry, -(y*ry) */
+		__m128 c = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 0, 2, 1)),
+													_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 0, 2))), negW);
+		/* z*ry, x*rz, y*rx, z*rz */
+		__m128 d = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 1, 0, 2)),
+									 _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 0, 2, 1)));
+		return _mm_sub_ps(_mm_add_ps(_mm_add_ps(a, b), c), d);
+	}
+#endif
+
 	Quaternion Quaternion::operator*(const Quaternion& rhs) const {
+#if defined (CAT_MATH_SSE)
+		return Quaternion(sseProduct(v, rhs.v));
+#else
 		return Quaternion(
 			(w * rhs.x) + (x * rhs.w) + (y * rhs.z) - (z * rhs.y),
 			(w * rhs.y) + (y * rhs.w) + (z * rhs.x) - (x * rhs.z),
 			(w * rhs.z) + (z * rhs.w) + (x * rhs.y) - (y * rhs.x),
 			(w * rhs.w) - (x * rhs.x) - (y * rhs.y) - (z * rhs.z));
+#endif
 	}
 
 	Quaternion& Quaternion::operator*=(const Quaternion& rhs) {
+#if defined (CAT_MATH_SSE)
+		v = sseProduct(v, rhs.v);
+		return *this;
+#else
 	   Real qx = (w * rhs.x) + (x * rhs.w) + (y * rhs.z) - (z * rhs.y);
 		Real qy = (w * rhs.y) + (y * rhs.w) + (z * rhs.x) - (x * rhs.z);
 		Real qz = (w * rhs.z) + (z * rhs.w) + (x * rhs.y) - (y * rhs.x);
@@ -25,6 +55,7 @@ namespace Cat {
 		y = qy;
 		z = qz;
 		return *this;
+#endif
 	}
 
 	/**
@@ -321,10 +352,16 @@ namespace Cat {
 		}
 
 		Real angle = acosf(q1_dot_q2);
+#if defined (CAT_MATH_SSE)
+		__m128 r = _mm_mul_ps(p_q1.v, _mm_set1_ps(sinf(angle * (1.0f - p_t))));
+		r = _mm_add_ps(r, _mm_mul_ps(q2.v, _mm_set1_ps(sinf(angle*p_t))));
+		return Quaternion(_mm_mul_ps(r, _mm_set1_ps(1.0f/sinf(angle))));
+#else
 		Quaternion r = p_q1 * sinf(angle * (1.0f - p_t));
 		r += q2 * sinf(angle*p_t);
 		r *= 1.0f/sinf(angle);
 		return r;
+#endif
 	}
 	
 
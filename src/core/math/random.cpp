@@ -0,0 +1,111 @@
+#include "core/math/random.h"
+#include "core/math/mathcore.h"
+
+namespace Cat {
+
+	static const Real kTwoPi = REAL(6.28318530717958647692);
+
+	/* The jump polynomials of xoshiro128**, for 2^64 and 2^96 steps */
+	static const U32 s_jump[4] = { 0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B };
+	static const U32 s_longJump[4] = { 0xB523952E, 0x0B6F099F, 0xCCF5A0EF, 0x1C580662 };
+
+	static inline U64 splitMix64(U64& x) {
+		U64 z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	Random Random::forStream(U64 seed, U32 stream) {
+		Random random(seed);
+		for (U32 i = 0; i < stream; ++i) {
+			random.longJump();
+		}
+		return random;
+	}
+
+	void Random::setSeed(U64 seed) {
+		U64 a = splitMix64(seed);
+		U64 b = splitMix64(seed);
+		m_state[0] = (U32)a;
+		m_state[1] = (U32)(a >> 32);
+		m_state[2] = (U32)b;
+		m_state[3] = (U32)(b >> 32);
+		/* The only state the generator cannot leave */
+		if ((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0) {
+			m_state[0] = 1;
+		}
+	}
+
+	void Random::jump() {
+		jump(s_jump);
+	}
+
+	void Random::longJump() {
+		jump(s_longJump);
+	}
+
+	void Random::jump(const U32* polynomial) {
+		U32 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		for (I32 i = 0; i < 4; ++i) {
+			for (I32 b = 0; b < 32; ++b) {
+				if (polynomial[i] & (1U << b)) {
+					s0 ^= m_state[0];
+					s1 ^= m_state[1];
+					s2 ^= m_state[2];
+					s3 ^= m_state[3];
+				}
+				nextU32();
+			}
+		}
+		m_state[0] = s0;
+		m_state[1] = s1;
+		m_state[2] = s2;
+		m_state[3] = s3;
+	}
+
+	U32 Random::nextU32(U32 bound) {
+		/* Lemire's multiply and shift, rejecting the few biased products */
+		U64 m = (U64)nextU32() * bound;
+		U32 low = (U32)m;
+		if (low < bound) {
+			U32 threshold = (0U - bound) % bound;
+			while (low < threshold) {
+				m = (U64)nextU32() * bound;
+				low = (U32)m;
+			}
+		}
+		return (U32)(m >> 32);
+	}
+
+	Real Random::nextNormal(Real mean, Real stddev) {
+		/* Box-Muller, with 1 - u in (0, 1] so the log is finite */
+		Real u1 = REAL(1.0) - nextReal();
+		Real u2 = nextReal();
+		return mean + stddev*Math::sqrt(REAL(-2.0)*Math::log(u1))*Math::cos(kTwoPi*u2);
+	}
+
+	Vec2 Random::nextUnitVec2() {
+		Real angle = kTwoPi*nextReal();
+		return Vec2(Math::cos(angle), Math::sin(angle));
+	}
+
+	Vec3 Random::nextUnitVec3() {
+		Real z = REAL(1.0) - REAL(2.0)*nextReal();
+		Real angle = kTwoPi*nextReal();
+		Real r = REAL(1.0) - z*z;
+		r = r > REAL(0.0) ? Math::sqrt(r) : REAL(0.0);
+		return Vec3(r*Math::cos(angle), r*Math::sin(angle), z);
+	}
+
+	Quaternion Random::nextQuaternion() {
+		/* Shoemake's uniform random rotation */
+		Real u1 = nextReal();
+		Real a1 = kTwoPi*nextReal();
+		Real a2 = kTwoPi*nextReal();
+		Real r1 = Math::sqrt(REAL(1.0) - u1);
+		Real r2 = Math::sqrt(u1);
+		return Quaternion(r1*Math::sin(a1), r1*Math::cos(a1), r2*Math::sin(a2), r2*Math::cos(a2));
+	}
+
+} // namespace Cat
@@ -0,0 +1,198 @@
+#include <cstring>
+#include "core/math/randomkernels.h"
+#include "core/math/random.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	static const Size kNumLanes = RandomLanes::kNumLanes;
+
+	/*************************************************************
+	 * Scalar kernels
+	 *************************************************************/
+
+	static inline U32 rotl(U32 x, I32 k) {
+		return (x << k) | (x >> (32 - k));
+	}
+
+	static void scalarBits(RandomLanes& lanes, U32* dst, Size blocks) {
+		for (Size i = 0; i < blocks; ++i) {
+			for (Size j = 0; j < kNumLanes; ++j) {
+				U32 s0 = lanes.s[0][j], s1 = lanes.s[1][j], s2 = lanes.s[2][j], s3 = lanes.s[3][j];
+				dst[i*kNumLanes + j] = rotl(s1 * 5, 7) * 9;
+				U32 t = s1 << 9;
+				s2 ^= s0;
+				s3 ^= s1;
+				s1 ^= s2;
+				s0 ^= s3;
+				s2 ^= t;
+				s3 = rotl(s3, 11);
+				lanes.s[0][j] = s0;
+				lanes.s[1][j] = s1;
+				lanes.s[2][j] = s2;
+				lanes.s[3][j] = s3;
+			}
+		}
+	}
+
+	static void scalarUniform(const U32* src, Real* dst, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			/* Copied, as the source may be the destination */
+			U32 bits;
+			memcpy(&bits, src + i, sizeof(U32));
+			dst[i] = Random::toUniform(bits);
+		}
+	}
+
+	static const RandomKernels::Table s_scalarTable = {
+		scalarBits,
+		scalarUniform,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/*************************************************************
+	 * SSE2 kernels
+	 *************************************************************/
+
+	static inline __m128i sse2Rotl(__m128i x, I32 k) {
+		return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+	}
+
+	/* One step of four lanes, returning their outputs */
+	static inline __m128i sse2Step(__m128i& s0, __m128i& s1, __m128i& s2, __m128i& s3) {
+		__m128i x5 = _mm_add_epi32(_mm_slli_epi32(s1, 2), s1);
+		__m128i r = sse2Rotl(x5, 7);
+		r = _mm_add_epi32(_mm_slli_epi32(r, 3), r);
+		__m128i t = _mm_slli_epi32(s1, 9);
+		s2 = _mm_xor_si128(s2, s0);
+		s3 = _mm_xor_si128(s3, s1);
+		s1 = _mm_xor_si128(s1, s2);
+		s0 = _mm_xor_si128(s0, s3);
+		s2 = _mm_xor_si128(s2, t);
+		s3 = sse2Rotl(s3, 11);
+		return r;
+	}
+
+	static void sse2Bits(RandomLanes& lanes, U32* dst, Size blocks) {
+		__m128i a0 = _mm_loadu_si128((const __m128i*)lanes.s[0]);
+		__m128i a1 = _mm_loadu_si128((const __m128i*)lanes.s[1]);
+		__m128i a2 = _mm_loadu_si128((const __m128i*)lanes.s[2]);
+		__m128i a3 = _mm_loadu_si128((const __m128i*)lanes.s[3]);
+		__m128i b0 = _mm_loadu_si128((const __m128i*)(lanes.s[0] + 4));
+		__m128i b1 = _mm_loadu_si128((const __m128i*)(lanes.s[1] + 4));
+		__m128i b2 = _mm_loadu_si128((const __m128i*)(lanes.s[2] + 4));
+		__m128i b3 = _mm_loadu_si128((const __m128i*)(lanes.s[3] + 4));
+		for (Size i = 0; i < blocks; ++i) {
+			_mm_storeu_si128((__m128i*)(dst + i*kNumLanes), sse2Step(a0, a1, a2, a3));
+			_mm_storeu_si128((__m128i*)(dst + i*kNumLanes + 4), sse2Step(b0, b1, b2, b3));
+		}
+		_mm_storeu_si128((__m128i*)lanes.s[0], a0);
+		_mm_storeu_si128((__m128i*)lanes.s[1], a1);
+		_mm_storeu_si128((__m128i*)lanes.s[2], a2);
+		_mm_storeu_si128((__m128i*)lanes.s[3], a3);
+		_mm_storeu_si128((__m128i*)(lanes.s[0] + 4), b0);
+		_mm_storeu_si128((__m128i*)(lanes.s[1] + 4), b1);
+		_mm_storeu_si128((__m128i*)(lanes.s[2] + 4), b2);
+		_mm_storeu_si128((__m128i*)(lanes.s[3] + 4), b3);
+	}
+
+	static void sse2Uniform(const U32* src, Real* dst, Size count) {
+		__m128 scale = _mm_set1_ps(REAL(1.0) / REAL(16777216.0));
+		Size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i bits = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(src + i)), 8);
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(bits), scale));
+		}
+		scalarUniform(src + i, dst + i, count - i);
+	}
+
+	static const RandomKernels::Table s_sse2Table = {
+		sse2Bits,
+		sse2Uniform,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * AVX2 kernels
+	 *************************************************************/
+
+	CAT_TARGET_AVX2_NO_FMA static inline __m256i avx2Rotl(__m256i x, I32 k) {
+		return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2Bits(RandomLanes& lanes, U32* dst, Size blocks) {
+		__m256i s0 = _mm256_loadu_si256((const __m256i*)lanes.s[0]);
+		__m256i s1 = _mm256_loadu_si256((const __m256i*)lanes.s[1]);
+		__m256i s2 = _mm256_loadu_si256((const __m256i*)lanes.s[2]);
+		__m256i s3 = _mm256_loadu_si256((const __m256i*)lanes.s[3]);
+		for (Size i = 0; i < blocks; ++i) {
+			__m256i x5 = _mm256_add_epi32(_mm256_slli_epi32(s1, 2), s1);
+			__m256i r = avx2Rotl(x5, 7);
+			r = _mm256_add_epi32(_mm256_slli_epi32(r, 3), r);
+			_mm256_storeu_si256((__m256i*)(dst + i*kNumLanes), r);
+			__m256i t = _mm256_slli_epi32(s1, 9);
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = avx2Rotl(s3, 11);
+		}
+		_mm256_storeu_si256((__m256i*)lanes.s[0], s0);
+		_mm256_storeu_si256((__m256i*)lanes.s[1], s1);
+		_mm256_storeu_si256((__m256i*)lanes.s[2], s2);
+		_mm256_storeu_si256((__m256i*)lanes.s[3], s3);
+	}
+
+	CAT_TARGET_AVX2_NO_FMA static void avx2Uniform(const U32* src, Real* dst, Size count) {
+		__m256 scale = _mm256_set1_ps(REAL(1.0) / REAL(16777216.0));
+		Size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256i bits = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i*)(src + i)), 8);
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(bits), scale));
+		}
+		sse2Uniform(src + i, dst + i, count - i);
+	}
+
+	static const RandomKernels::Table s_avx2Table = {
+		avx2Bits,
+		avx2Uniform,
+		"avx2"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const RandomKernels::Table& RandomKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const RandomKernels::Table& RandomKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size RandomKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasAVX2()) {
+			tables[count++] = &s_avx2Table;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const RandomKernels::Table* RandomKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
@@ -0,0 +1,164 @@
+#include "core/math/randomstream.h"
+#include "core/math/mathcore.h"
+
+namespace Cat {
+
+	static const Real kTwoPi = REAL(6.28318530717958647692);
+	static const Size kNumLanes = RandomLanes::kNumLanes;
+
+	RandomStream::RandomStream(U64 seed) {
+		init(Random(seed));
+	}
+
+	RandomStream::RandomStream(const Random& random) {
+		init(random);
+	}
+
+	void RandomStream::init(const Random& random) {
+		Random lane = random;
+		for (Size j = 0; j < kNumLanes; ++j) {
+			const U32* state = lane.state();
+			for (Size k = 0; k < 4; ++k) {
+				m_lanes.s[k][j] = state[k];
+			}
+			lane.jump();
+		}
+		m_numBuffered = 0;
+		m_spareNormal = REAL(0.0);
+		m_hasSpareNormal = false;
+	}
+
+	void RandomStream::bits(U32* dst, Size count) {
+		const RandomKernels::Table& kernels = RandomKernels::table();
+		Size i = 0;
+		/* Use up the values left over from the last call first */
+		while (m_numBuffered && i < count) {
+			dst[i++] = m_buffer[kNumLanes - m_numBuffered--];
+		}
+		Size blocks = (count - i) / kNumLanes;
+		if (blocks) {
+			kernels.bits(m_lanes, dst + i, blocks);
+			i += blocks*kNumLanes;
+		}
+		if (i < count) {
+			kernels.bits(m_lanes, m_buffer, 1);
+			m_numBuffered = kNumLanes;
+			while (i < count) {
+				dst[i++] = m_buffer[kNumLanes - m_numBuffered--];
+			}
+		}
+	}
+
+	void RandomStream::uniform(Real* dst, Size count) {
+		/* The bits are converted in place */
+		bits((U32*)dst, count);
+		RandomKernels::table().uniform((const U32*)dst, dst, count);
+	}
+
+	void RandomStream::uniform(Real* dst, Size count, Real min, Real max) {
+		uniform(dst, count);
+		Real range = max - min;
+		for (Size i = 0; i < count; ++i) {
+			dst[i] = min + range*dst[i];
+		}
+	}
+
+	void RandomStream::normal(Real* dst, Size count, Real mean, Real stddev) {
+		Real u[kChunkSize*2];
+		Real radii[kChunkSize];
+		Real angles[kChunkSize];
+		Real sines[kChunkSize];
+		Real cosines[kChunkSize];
+		Size i = 0;
+		if (m_hasSpareNormal && count) {
+			dst[i++] = mean + stddev*m_spareNormal;
+			m_hasSpareNormal = false;
+		}
+		while (i < count) {
+			/* Box-Muller, each pair of uniforms giving a pair of normals */
+			Size pairs = (count - i + 1) / 2;
+			pairs = pairs < kChunkSize ? pairs : kChunkSize;
+			uniform(u, pairs*2);
+			for (Size j = 0; j < pairs; ++j) {
+				radii[j] = REAL(1.0) - u[j*2];
+				angles[j] = kTwoPi*u[j*2 + 1];
+			}
+			Math::log(radii, radii, pairs, Math::kPrecise);
+			Math::sin(angles, sines, pairs, Math::kPrecise);
+			Math::cos(angles, cosines, pairs, Math::kPrecise);
+			for (Size j = 0; j < pairs; ++j) {
+				Real r = Math::sqrt(REAL(-2.0)*radii[j]);
+				dst[i++] = mean + stddev*r*cosines[j];
+				if (i < count) {
+					dst[i++] = mean + stddev*r*sines[j];
+				} else {
+					m_spareNormal = r*sines[j];
+					m_hasSpareNormal = true;
+				}
+			}
+		}
+	}
+
+	void RandomStream::unitVec2(Vec2* dst, Size count) {
+		Real angles[kChunkSize];
+		Real sines[kChunkSize];
+		Real cosines[kChunkSize];
+		for (Size i = 0; i < count; i += kChunkSize) {
+			Size n = count - i < kChunkSize ? count - i : kChunkSize;
+			uniform(angles, n, REAL(0.0), kTwoPi);
+			Math::sin(angles, sines, n, Math::kPrecise);
+			Math::cos(angles, cosines, n, Math::kPrecise);
+			for (Size j = 0; j < n; ++j) {
+				dst[i + j] = Vec2(cosines[j], sines[j]);
+			}
+		}
+	}
+
+	void RandomStream::unitVec3(Vec3* dst, Size count) {
+		Real u[kChunkSize*2];
+		Real angles[kChunkSize];
+		Real sines[kChunkSize];
+		Real cosines[kChunkSize];
+		for (Size i = 0; i < count; i += kChunkSize) {
+			Size n = count - i < kChunkSize ? count - i : kChunkSize;
+			uniform(u, n*2);
+			for (Size j = 0; j < n; ++j) {
+				angles[j] = kTwoPi*u[j*2 + 1];
+			}
+			Math::sin(angles, sines, n, Math::kPrecise);
+			Math::cos(angles, cosines, n, Math::kPrecise);
+			for (Size j = 0; j < n; ++j) {
+				/* A uniform height on the sphere gives a uniform area */
+				Real z = REAL(1.0) - REAL(2.0)*u[j*2];
+				Real r = REAL(1.0) - z*z;
+				r = r > REAL(0.0) ? Math::sqrt(r) : REAL(0.0);
+				dst[i + j] = Vec3(r*cosines[j], r*sines[j], z);
+			}
+		}
+	}
+
+	void RandomStream::quaternions(Quaternion* dst, Size count) {
+		Real u[kChunkSize*3];
+		Real angles[kChunkSize*2];
+		Real sines[kChunkSize*2];
+		Real cosines[kChunkSize*2];
+		for (Size i = 0; i < count; i += kChunkSize) {
+			Size n = count - i < kChunkSize ? count - i : kChunkSize;
+			uniform(u, n*3);
+			for (Size j = 0; j < n; ++j) {
+				angles[j*2] = kTwoPi*u[j*3 + 1];
+				angles[j*2 + 1] = kTwoPi*u[j*3 + 2];
+			}
+			Math::sin(angles, sines, n*2, Math::kPrecise);
+			Math::cos(angles, cosines, n*2, Math::kPrecise);
+			for (Size j = 0; j < n; ++j) {
+				/* Shoemake's uniform random rotation */
+				Real r1 = Math::sqrt(REAL(1.0) - u[j*3]);
+				Real r2 = Math::sqrt(u[j*3]);
+				dst[i + j] = Quaternion(r1*sines[j*2], r1*cosines[j*2],
+												r2*sines[j*2 + 1], r2*cosines[j*2 + 1]);
+			}
+		}
+	}
+
+} // namespace Cat
@@ -0,0 +1,446 @@
+#include "core/math/transformhierarchy.h"
+#include "core/math/mathcore.h"
+#include "core/sys/cpu.h"
+#include "core/threading/asynctask.h"
+#include "core/threading/asynctaskrunner.h"
+#include "core/threading/taskbarrier.h"
+
+namespace Cat {
+
+	namespace {
+
+		/* The number of quaternions slerped at a time, with the angles on the stack */
+		const Size kSlerpChunk = 64;
+
+		/**
+		 * @brief A task to update the world matrices of a run of subtrees.
+		 */
+		class UpdateRangeTask : public AsyncTask {
+		  public:
+			UpdateRangeTask(TransformHierarchy* hierarchy, Size begin, Size end,
+								 TaskBarrier* barrier)
+				: m_pHierarchy(hierarchy), m_begin(begin), m_end(end), m_pBarrier(barrier) {
+				setDestroyable(true);
+			}
+
+			I32 run() {
+				m_pHierarchy->updateRange(m_begin, m_end);
+				m_pBarrier->arrive();
+				return 0;
+			}
+
+		  private:
+			TransformHierarchy*	m_pHierarchy;
+			Size						m_begin;
+			Size						m_end;
+			TaskBarrier*			m_pBarrier;
+		};
+
+		/**
+		 * @brief Write the local matrix of a node, scale, then rotate, then translate.
+		 */
+		inline void localMatrix(const Vec3SoA& t, const QuaternionSoA& q, const Vec3SoA& s,
+										Size i, Real* m) {
+			Real x = q.x[i], y = q.y[i], z = q.z[i], w = q.w[i];
+			Real x2 = x*x, y2 = y*y, z2 = z*z;
+			Real xy = x*y, xz = x*z, yz = y*z;
+			Real wx = w*x, wy = w*y, wz = w*z;
+
+			m[0] = (REAL(1.0) - REAL(2.0)*(y2 + z2))*s.x[i];
+			m[1] = (REAL(2.0)*(xy + wz))*s.x[i];
+			m[2] = (REAL(2.0)*(xz - wy))*s.x[i];
+			m[3] = REAL(0.0);
+			m[4] = (REAL(2.0)*(xy - wz))*s.y[i];
+			m[5] = (REAL(1.0) - REAL(2.0)*(x2 + z2))*s.y[i];
+			m[6] = (REAL(2.0)*(yz + wx))*s.y[i];
+			m[7] = REAL(0.0);
+			m[8] = (REAL(2.0)*(xz + wy))*s.z[i];
+			m[9] = (REAL(2.0)*(yz - wx))*s.z[i];
+			m[10] = (REAL(1.0) - REAL(2.0)*(x2 + y2))*s.z[i];
+			m[11] = REAL(0.0);
+			m[12] = t.x[i];
+			m[13] = t.y[i];
+			m[14] = t.z[i];
+			m[15] = REAL(1.0);
+		}
+
+		/**
+		 * @brief The weighted sum, from*w0 + to*w1, normalised.
+		 */
+		inline void combine(const QuaternionSoA& from, const QuaternionSoA& to,
+								  Real w0, Real w1, const QuaternionSoA& dst, Size i) {
+			Real x = from.x[i]*w0 + to.x[i]*w1;
+			Real y = from.y[i]*w0 + to.y[i]*w1;
+			Real z = from.z[i]*w0 + to.z[i]*w1;
+			Real w = from.w[i]*w0 + to.w[i]*w1;
+			Real rLen = REAL(1.0) / ::sqrt(x*x + y*y + z*z + w*w);
+			dst.x[i] = x*rLen;
+			dst.y[i] = y*rLen;
+			dst.z[i] = z*rLen;
+			dst.w[i] = w*rLen;
+		}
+
+#if defined (CAT_SIMD_SSE2)
+		/**
+		 * @brief Write the local matrices of four nodes, the same as localMatrix().
+		 */
+		inline void localMatrices(const Vec3SoA& t, const QuaternionSoA& q, const Vec3SoA& s,
+										  Size i, Mat4* world) {
+			const __m128 one = _mm_set1_ps(REAL(1.0));
+			const __m128 two = _mm_set1_ps(REAL(2.0));
+			__m128 x = _mm_loadu_ps(q.x + i), y = _mm_loadu_ps(q.y + i);
+			__m128 z = _mm_loadu_ps(q.z + i), w = _mm_loadu_ps(q.w + i);
+			__m128 x2 = _mm_mul_ps(x, x), y2 = _mm_mul_ps(y, y), z2 = _mm_mul_ps(z, z);
+			__m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+			__m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+			__m128 sx = _mm_loadu_ps(s.x + i), sy = _mm_loadu_ps(s.y + i), sz = _mm_loadu_ps(s.z + i);
+
+			__m128 c0x = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(y2, z2))), sx);
+			__m128 c0y = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+			__m128 c0z = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+			__m128 c0w = _mm_setzero_ps();
+			__m128 c1x = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+			__m128 c1y = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(x2, z2))), sy);
+			__m128 c1z = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+			__m128 c1w = _mm_setzero_ps();
+			__m128 c2x = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+			__m128 c2y = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+			__m128 c2z = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(x2, y2))), sz);
+			__m128 c2w = _mm_setzero_ps();
+			__m128 c3x = _mm_loadu_ps(t.x + i), c3y = _mm_loadu_ps(t.y + i), c3z = _mm_loadu_ps(t.z + i);
+			__m128 c3w = one;
+
+			/* Each lane is a node, transposing gives one column of each node */
+			_MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+			_MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+			_MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+			_MM_TRANSPOSE4_PS(c3x, c3y, c3z, c3w);
+			Real* m0 = world[i].getMatrixData().m;
+			Real* m1 = world[i + 1].getMatrixData().m;
+			Real* m2 = world[i + 2].getMatrixData().m;
+			Real* m3 = world[i + 3].getMatrixData().m;
+			_mm_storeu_ps(m0, c0x); _mm_storeu_ps(m0 + 4, c1x); _mm_storeu_ps(m0 + 8, c2x); _mm_storeu_ps(m0 + 12, c3x);
+			_mm_storeu_ps(m1, c0y); _mm_storeu_ps(m1 + 4, c1y); _mm_storeu_ps(m1 + 8, c2y); _mm_storeu_ps(m1 + 12, c3y);
+			_mm_storeu_ps(m2, c0z); _mm_storeu_ps(m2 + 4, c1z); _mm_storeu_ps(m2 + 8, c2z); _mm_storeu_ps(m2 + 12, c3z);
+			_mm_storeu_ps(m3, c0w); _mm_storeu_ps(m3 + 4, c1w); _mm_storeu_ps(m3 + 8, c2w); _mm_storeu_ps(m3 + 12, c3w);
+		}
+
+		/**
+		 * @brief One column of the product of an affine parent and a local
+		 * matrix, in the same order as Mat4::composeAffine().
+		 */
+		inline __m128 composeColumn(const __m128* p, const Real* col) {
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p[0], _mm_set1_ps(col[0])),
+												  _mm_mul_ps(p[1], _mm_set1_ps(col[1]))),
+									_mm_mul_ps(p[2], _mm_set1_ps(col[2])));
+		}
+
+		/**
+		 * @brief The weighted sums of four quaternions, from*w0 + to*w1, normalised.
+		 */
+		inline void combine4(const QuaternionSoA& from, const QuaternionSoA& to,
+									__m128 w0, __m128 w1, const QuaternionSoA& dst, Size i) {
+			__m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from.x + i), w0),
+										 _mm_mul_ps(_mm_loadu_ps(to.x + i), w1));
+			__m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from.y + i), w0),
+										 _mm_mul_ps(_mm_loadu_ps(to.y + i), w1));
+			__m128 z = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from.z + i), w0),
+										 _mm_mul_ps(_mm_loadu_ps(to.z + i), w1));
+			__m128 w = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from.w + i), w0),
+										 _mm_mul_ps(_mm_loadu_ps(to.w + i), w1));
+			__m128 len2 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+															_mm_mul_ps(z, z)), _mm_mul_ps(w, w));
+			__m128 rLen = _mm_div_ps(_mm_set1_ps(REAL(1.0)), _mm_sqrt_ps(len2));
+			_mm_storeu_ps(dst.x + i, _mm_mul_ps(x, rLen));
+			_mm_storeu_ps(dst.y + i, _mm_mul_ps(y, rLen));
+			_mm_storeu_ps(dst.z + i, _mm_mul_ps(z, rLen));
+			_mm_storeu_ps(dst.w + i, _mm_mul_ps(w, rLen));
+		}
+
+		/**
+		 * @brief The dot products of four pairs of quaternions.
+		 */
+		inline __m128 dot4(const QuaternionSoA& a, const QuaternionSoA& b, Size i) {
+			return _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_loadu_ps(a.x + i), _mm_loadu_ps(b.x + i)),
+				_mm_mul_ps(_mm_loadu_ps(a.y + i), _mm_loadu_ps(b.y + i))),
+				_mm_mul_ps(_mm_loadu_ps(a.z + i), _mm_loadu_ps(b.z + i))),
+				_mm_mul_ps(_mm_loadu_ps(a.w + i), _mm_loadu_ps(b.w + i)));
+		}
+#endif
+
+		inline Real dot(const QuaternionSoA& a, const QuaternionSoA& b, Size i) {
+			return a.x[i]*b.x[i] + a.y[i]*b.y[i] + a.z[i]*b.z[i] + a.w[i]*b.w[i];
+		}
+
+	} // namespace
+
+	TransformHierarchy::TransformHierarchy(Size capacity)
+		: m_pData(NIL), m_pParents(NIL), m_pWorld(NIL), m_pSubtrees(NIL),
+		  m_numSubtrees(0), m_size(0), m_capacity(capacity) {
+		m_pData = new Real[capacity*10];
+		Real* p = m_pData;
+		m_translations = Vec3SoA(p, p + capacity, p + capacity*2);
+		m_rotations = QuaternionSoA(p + capacity*3, p + capacity*4, p + capacity*5, p + capacity*6);
+		m_scales = Vec3SoA(p + capacity*7, p + capacity*8, p + capacity*9);
+		m_pParents = new U32[capacity];
+		m_pWorld = new Mat4[capacity];
+		m_pSubtrees = new Size[capacity + 1];
+	}
+
+	TransformHierarchy::~TransformHierarchy() {
+		delete[] m_pData;
+		delete[] m_pParents;
+		delete[] m_pWorld;
+		delete[] m_pSubtrees;
+	}
+
+	U32 TransformHierarchy::addNode(U32 parent, const Vec3& translation,
+											  const Quaternion& rotation, const Vec3& scale) {
+		if (m_size >= m_capacity) {
+			DWARN("Cannot add a node to a full TransformHierarchy!");
+			return kNoParent;
+		}
+		if (parent != kNoParent && parent >= m_size) {
+			DWARN("The parent of a node must be added before it: " << parent << "!");
+			return kNoParent;
+		}
+		U32 node = (U32)m_size++;
+		m_pParents[node] = parent;
+		m_numSubtrees = 0;
+		setLocal(node, translation, rotation, scale);
+		return node;
+	}
+
+	void TransformHierarchy::setLocal(U32 node, const Vec3& translation,
+												 const Quaternion& rotation, const Vec3& scale) {
+		m_translations.x[node] = translation.x;
+		m_translations.y[node] = translation.y;
+		m_translations.z[node] = translation.z;
+		m_rotations.x[node] = rotation.x;
+		m_rotations.y[node] = rotation.y;
+		m_rotations.z[node] = rotation.z;
+		m_rotations.w[node] = rotation.w;
+		m_scales.x[node] = scale.x;
+		m_scales.y[node] = scale.y;
+		m_scales.z[node] = scale.z;
+	}
+
+	void TransformHierarchy::interpolate(const TransformHierarchy& from,
+													 const TransformHierarchy& to,
+													 Real t, Interpolation mode) {
+		if (from.m_size != m_size || to.m_size != m_size) {
+			DWARN("Cannot interpolate between hierarchies of different sizes!");
+			return;
+		}
+		Real s = REAL(1.0) - t;
+		const Real* fromData = from.m_pData;
+		const Real* toData = to.m_pData;
+		/* The translations and scales are lerped with plain loops, which
+		 * the compiler vectorises */
+		const Size offsets[6] = { 0, 1, 2, 7, 8, 9 };
+		for (Size a = 0; a < 6; ++a) {
+			const Real* f = fromData + from.m_capacity*offsets[a];
+			const Real* g = toData + to.m_capacity*offsets[a];
+			Real* d = m_pData + m_capacity*offsets[a];
+			for (Size i = 0; i < m_size; ++i) {
+				d[i] = f[i]*s + g[i]*t;
+			}
+		}
+		if (mode == kSlerp) {
+			slerp(from.m_rotations, to.m_rotations, t, m_rotations, m_size);
+		} else {
+			nlerp(from.m_rotations, to.m_rotations, t, m_rotations, m_size);
+		}
+	}
+
+	void TransformHierarchy::updateRange(Size begin, Size end) {
+		Mat4* world = m_pWorld;
+		Size i = begin;
+#if defined (CAT_SIMD_SSE2)
+		for (; i + 4 <= end; i += 4) {
+			localMatrices(m_translations, m_rotations, m_scales, i, world);
+			for (Size j = i; j < i + 4; ++j) {
+				U32 parent = m_pParents[j];
+				if (parent == kNoParent) {
+					continue;
+				}
+				const Real* p = world[parent].getMatrixDataConst().m;
+				Real* m = world[j].getMatrixData().m;
+				__m128 pc[3] = { _mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8) };
+				__m128 c0 = composeColumn(pc, m);
+				__m128 c1 = composeColumn(pc, m + 4);
+				__m128 c2 = composeColumn(pc, m + 8);
+				__m128 c3 = _mm_add_ps(composeColumn(pc, m + 12), _mm_loadu_ps(p + 12));
+				_mm_storeu_ps(m, c0);
+				_mm_storeu_ps(m + 4, c1);
+				_mm_storeu_ps(m + 8, c2);
+				_mm_storeu_ps(m + 12, c3);
+			}
+		}
+#endif
+		for (; i < end; ++i) {
+			localMatrix(m_translations, m_rotations, m_scales, i, world[i].getMatrixData().m);
+			U32 parent = m_pParents[i];
+			if (parent != kNoParent) {
+				world[i] = world[parent].composeAffine(world[i]);
+			}
+		}
+	}
+
+	void TransformHierarchy::updateWorld() {
+		updateRange(0, m_size);
+	}
+
+	void TransformHierarchy::updateWorld(AsyncTaskRunner* runner) {
+		Size numTasks = runner ? runner->getNumberOfThreads() + 1 : 1;
+		if (numTasks < 2 || getNumSubtrees() < 2) {
+			updateRange(0, m_size);
+			return;
+		}
+
+		/* Split the subtrees into runs of about the same number of nodes,
+		 * the ends of the runs are stored in ends */
+		if (numTasks > m_numSubtrees) {
+			numTasks = m_numSubtrees;
+		}
+		Size* ends = new Size[numTasks];
+		Size numRuns = 0;
+		Size target = (m_size + numTasks - 1) / numTasks;
+		for (Size s = 1; s <= m_numSubtrees; ++s) {
+			Size start = numRuns ? ends[numRuns - 1] : 0;
+			if (m_pSubtrees[s] - start >= target || s == m_numSubtrees) {
+				ends[numRuns++] = m_pSubtrees[s];
+				if (numRuns == numTasks - 1 && s < m_numSubtrees) {
+					ends[numRuns++] = m_size;
+					break;
+				}
+			}
+		}
+
+		TaskBarrier barrier(numRuns - 1);
+		for (Size r = 1; r < numRuns; ++r) {
+			UpdateRangeTask* task = new UpdateRangeTask(this, ends[r - 1], ends[r], &barrier);
+			/* A stopped runner does not take the task, so update the run here */
+			if (!runner->queue(task)) {
+				delete task;
+				updateRange(ends[r - 1], ends[r]);
+				barrier.arrive();
+			}
+		}
+		updateRange(0, ends[0]);
+		delete[] ends;
+
+		barrier.wait();
+	}
+
+	Size TransformHierarchy::getNumSubtrees() {
+		findSubtrees();
+		return m_numSubtrees;
+	}
+
+	void TransformHierarchy::findSubtrees() {
+		if (m_numSubtrees || !m_size) {
+			return;
+		}
+		/* A root starts a subtree if no node after it has a parent before
+		 * it.  The starts are found backwards, then put in order, with the
+		 * size of the hierarchy at the end. */
+		Size lowest = kNoParent;
+		Size count = 0;
+		for (Size i = m_size; i-- > 0; ) {
+			U32 parent = m_pParents[i];
+			if (parent == kNoParent) {
+				if (lowest >= i) {
+					m_pSubtrees[count++] = i;
+				}
+			} else if (parent < lowest) {
+				lowest = parent;
+			}
+		}
+		for (Size i = 0; i < count / 2; ++i) {
+			Size tmp = m_pSubtrees[i];
+			m_pSubtrees[i] = m_pSubtrees[count - 1 - i];
+			m_pSubtrees[count - 1 - i] = tmp;
+		}
+		m_pSubtrees[count] = m_size;
+		m_numSubtrees = count;
+	}
+
+	void TransformHierarchy::nlerp(const QuaternionSoA& from, const QuaternionSoA& to, Real t,
+											 const QuaternionSoA& dst, Size count) {
+		Real s = REAL(1.0) - t;
+		Size i = 0;
+#if defined (CAT_SIMD_SSE2)
+		/* The sign of t is flipped where the dot product is negative, to
+		 * interpolate the shorter way around */
+		const __m128 signBit = _mm_set1_ps(REAL(-0.0));
+		const __m128 w0 = _mm_set1_ps(s);
+		const __m128 vt = _mm_set1_ps(t);
+		for (; i + 4 <= count; i += 4) {
+			__m128 negative = _mm_cmplt_ps(dot4(from, to, i), _mm_setzero_ps());
+			__m128 w1 = _mm_xor_ps(vt, _mm_and_ps(negative, signBit));
+			combine4(from, to, w0, w1, dst, i);
+		}
+#endif
+		for (; i < count; ++i) {
+			combine(from, to, s, dot(from, to, i) < 0 ? -t : t, dst, i);
+		}
+	}
+
+	void TransformHierarchy::slerp(const QuaternionSoA& from, const QuaternionSoA& to, Real t,
+											 const QuaternionSoA& dst, Size count) {
+		/* The angles are found with acos one at a time, but the sines of
+		 * each chunk are done together with the vectorised Math::sin() */
+		Real cosines[kSlerpChunk];
+		Real angles[kSlerpChunk*3];
+		Real sines[kSlerpChunk*3];
+		Real w0[kSlerpChunk];
+		Real w1[kSlerpChunk];
+		for (Size begin = 0; begin < count; begin += kSlerpChunk) {
+			Size n = count - begin < kSlerpChunk ? count - begin : kSlerpChunk;
+			Size i = 0;
+#if defined (CAT_SIMD_SSE2)
+			for (; i + 4 <= n; i += 4) {
+				_mm_storeu_ps(cosines + i, dot4(from, to, begin + i));
+			}
+#endif
+			for (; i < n; ++i) {
+				cosines[i] = dot(from, to, begin + i);
+			}
+			/* The angles are stored as (1 - t)*angle, then t*angle, then angle */
+			for (i = 0; i < n; ++i) {
+				Real c = cosines[i] < 0 ? -cosines[i] : cosines[i];
+				Real angle = c > REAL(0.99) ? REAL(0.0) : acosf(c);
+				angles[i] = angle*(REAL(1.0) - t);
+				angles[n + i] = angle*t;
+				angles[n*2 + i] = angle;
+			}
+			Math::sin(angles, sines, n*3);
+			for (i = 0; i < n; ++i) {
+				if (angles[n*2 + i] == REAL(0.0)) {
+					w0[i] = REAL(1.0) - t;
+					w1[i] = t;
+				} else {
+					Real rSin = REAL(1.0) / sines[n*2 + i];
+					w0[i] = sines[i]*rSin;
+					w1[i] = sines[n + i]*rSin;
+				}
+				if (cosines[i] < 0) {
+					w1[i] = -w1[i];
+				}
+			}
+
+			i = 0;
+#if defined (CAT_SIMD_SSE2)
+			for (; i + 4 <= n; i += 4) {
+				combine4(from, to, _mm_loadu_ps(w0 + i), _mm_loadu_ps(w1 + i), dst, begin + i);
+			}
+#endif
+			for (; i < n; ++i) {
+				combine(from, to, w0[i], w1[i], dst, begin + i);
+			}
+		}
+	}
+
+} // namespace Cat
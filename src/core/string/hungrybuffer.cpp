@@ -0,0 +1,155 @@
+#include <cstring>
+#include "core/string/hungrybuffer.h"
+
+namespace Cat {
+
+	HungryBuffer::HungryBuffer(const HungryTemplate* pTemplate, Size maxLength)
+		: m_pTemplate(pTemplate), m_pBuiltString(NIL), m_maxLength(maxLength),
+		  m_remainingFeeds(0), m_currentSegment(0),
+		  m_currentBuildIdx(0), m_finished(false) {
+		if (m_maxLength > 0) {
+			m_pBuiltString = new Char[m_maxLength];
+		}
+		reset();
+	}
+
+	HungryBuffer::HungryBuffer(const HungryBuffer& src)
+		: m_pTemplate(src.m_pTemplate), m_pBuiltString(NIL),
+		  m_maxLength(src.m_maxLength), m_remainingFeeds(src.m_remainingFeeds),
+		  m_currentSegment(src.m_currentSegment),
+		  m_currentBuildIdx(src.m_currentBuildIdx), m_finished(src.m_finished) {
+		if (src.m_pBuiltString) {
+			m_pBuiltString = new Char[m_maxLength];
+			memcpy(m_pBuiltString, src.m_pBuiltString, sizeof(Char)*m_maxLength);
+		}
+	}
+
+	HungryBuffer::~HungryBuffer() {
+		if (m_pBuiltString) {
+			delete[] m_pBuiltString;
+			m_pBuiltString = NIL;
+		}
+		m_maxLength = m_remainingFeeds = 0;
+	}
+
+	HungryBuffer& HungryBuffer::operator=(const HungryBuffer& src) {
+		if (this == &src) {
+			return *this;
+		}
+		/* Only reallocate if the buffer sizes differ */
+		if (m_maxLength != src.m_maxLength) {
+			if (m_pBuiltString) {
+				delete[] m_pBuiltString;
+				m_pBuiltString = NIL;
+			}
+			if (src.m_pBuiltString) {
+				m_pBuiltString = new Char[src.m_maxLength];
+			}
+		}
+		if (src.m_pBuiltString) {
+			memcpy(m_pBuiltString, src.m_pBuiltString, sizeof(Char)*src.m_maxLength);
+		}
+		m_pTemplate = src.m_pTemplate;
+		m_maxLength = src.m_maxLength;
+		m_remainingFeeds = src.m_remainingFeeds;
+		m_currentSegment = src.m_currentSegment;
+		m_currentBuildIdx = src.m_currentBuildIdx;
+		m_finished = src.m_finished;
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::feed(const Char* str, Size length) {
+		if (!m_finished && m_pTemplate) {
+			writeParam(str, length);
+		}
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::feed(I32 value) {
+		if (!m_finished && m_pTemplate) {
+			Char digits[CAT_MAX_I64_STRING_LENGTH];
+			writeParam(digits, StringUtils::formatI32(digits, value));
+		}
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::feed(U32 value) {
+		if (!m_finished && m_pTemplate) {
+			Char digits[CAT_MAX_U64_STRING_LENGTH];
+			writeParam(digits, StringUtils::formatU64(digits, (U64)value));
+		}
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::feed(I64 value) {
+		if (!m_finished && m_pTemplate) {
+			Char digits[CAT_MAX_I64_STRING_LENGTH];
+			writeParam(digits, StringUtils::formatI64(digits, value));
+		}
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::feed(U64 value) {
+		if (!m_finished && m_pTemplate) {
+			Char digits[CAT_MAX_U64_STRING_LENGTH];
+			writeParam(digits, StringUtils::formatU64(digits, value));
+		}
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::feed(F64 value, U32 precision) {
+		if (!m_finished && m_pTemplate) {
+			Char digits[CAT_MAX_F64_STRING_LENGTH];
+			writeParam(digits, StringUtils::formatF64(digits, value, precision));
+		}
+		return *this;
+	}
+
+	HungryBuffer& HungryBuffer::reset() {
+		m_currentSegment = 0;
+		m_currentBuildIdx = 0;
+		m_remainingFeeds = 0;
+		m_finished = false;
+		if (m_pTemplate && !m_pTemplate->isEmpty() && m_pBuiltString) {
+			m_remainingFeeds = m_pTemplate->numParams();
+			append(m_pTemplate->segmentText(0), m_pTemplate->segmentLength(0));
+			if (m_remainingFeeds == 0) {
+				m_pBuiltString[m_currentBuildIdx] = '\0';
+				m_finished = true;
+			}
+		}
+		return *this;
+	}
+
+	void HungryBuffer::append(const Char* str, Size length) {
+		/* No room even for the terminator, so nothing can be built */
+		if (m_maxLength == 0) {
+			return;
+		}
+		Size available = (m_maxLength - 1) - m_currentBuildIdx;
+		if (length > available) {
+			DWARN("HungryBuffer truncated to max length " << m_maxLength << ".");
+			length = available;
+		}
+		if (length > 0) {
+			memcpy(&(m_pBuiltString[m_currentBuildIdx]), str, sizeof(Char)*length);
+			m_currentBuildIdx += length;
+		}
+	}
+
+	void HungryBuffer::writeParam(const Char* str, Size length) {
+		if (!m_pBuiltString || m_remainingFeeds == 0) {
+			return;
+		}
+		append(str, length);
+		--m_remainingFeeds;
+		++m_currentSegment;
+		append(m_pTemplate->segmentText(m_currentSegment),
+				 m_pTemplate->segmentLength(m_currentSegment));
+		if (m_remainingFeeds == 0) {
+			m_pBuiltString[m_currentBuildIdx] = '\0';
+			m_finished = true;
+		}
+	}
+
+} // namespace Cat
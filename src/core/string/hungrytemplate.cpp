@@ -0,0 +1,101 @@
+#include <cstring>
+#include "core/string/hungrytemplate.h"
+#include "core/string/stringutils.h"
+
+namespace Cat {
+
+	HungryTemplate::HungryTemplate(const Char* string)
+		: m_pString(NIL), m_pText(NIL), m_pSegments(NIL),
+		  m_numParams(0), m_literalLength(0) {
+		if (string) {
+			m_pString = StringUtils::copy(string);
+			compile();
+		}
+	}
+
+	HungryTemplate::HungryTemplate(const HungryTemplate& src)
+		: m_pString(NIL), m_pText(NIL), m_pSegments(NIL),
+		  m_numParams(0), m_literalLength(0) {
+		if (src.m_pString) {
+			m_pString = StringUtils::copy(src.m_pString);
+			compile();
+		}
+	}
+
+	HungryTemplate::~HungryTemplate() {
+		clear();
+	}
+
+	HungryTemplate& HungryTemplate::operator=(const HungryTemplate& src) {
+		if (this != &src) {
+			clear();
+			if (src.m_pString) {
+				m_pString = StringUtils::copy(src.m_pString);
+				compile();
+			}
+		}
+		return *this;
+	}
+
+	void HungryTemplate::clear() {
+		m_pString = StringUtils::free(m_pString);
+		m_pText = StringUtils::free(m_pText);
+		if (m_pSegments) {
+			delete[] m_pSegments;
+			m_pSegments = NIL;
+		}
+		m_numParams = m_literalLength = 0;
+	}
+
+	void HungryTemplate::compile() {
+		Size len = StringUtils::length(m_pString);
+
+		/* First pass, count the parameters so we can size the segment table */
+		Size idx = 0;
+		while (idx < len) {
+			if (m_pString[idx] == '%') {
+				/* Treat %% as literal % */
+				if (m_pString[idx+1] == '%') {
+					idx += 2;
+				}
+				else {
+					++m_numParams;
+					++idx;
+				}
+			}
+			else {
+				++idx;
+			}
+		}
+
+		m_pSegments = new Segment[m_numParams + 1];
+		m_pText = StringUtils::create(len);
+
+		/* Second pass, copy the unescaped literal text and mark the segments */
+		Size seg = 0;
+		Size textIdx = 0;
+		m_pSegments[0].offset = 0;
+		idx = 0;
+		while (idx < len) {
+			if (m_pString[idx] == '%') {
+				if (m_pString[idx+1] == '%') {
+					m_pText[textIdx++] = '%';
+					idx += 2;
+				}
+				else {
+					m_pSegments[seg].length = textIdx - m_pSegments[seg].offset;
+					++seg;
+					m_pSegments[seg].offset = textIdx;
+					++idx;
+				}
+			}
+			else {
+				m_pText[textIdx++] = m_pString[idx++];
+			}
+		}
+		m_pSegments[seg].length = textIdx - m_pSegments[seg].offset;
+		m_pText[textIdx] = '\0';
+		m_literalLength = textIdx;
+	}
+
+} // namespace Cat
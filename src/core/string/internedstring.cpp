@@ -0,0 +1,228 @@
+#include <cstring>
+#include <cstdlib>
+#include <cstddef>
+#include "core/string/internedstring.h"
+#include "core/threading/atomic.h"
+#include "core/threading/mutex.h"
+
+/* The size of each arena chunk, strings larger than this get their own */
+#define CAT_INTERN_CHUNK_SIZE 16384
+/* The initial number of slots in the hash table, must be a power of 2 */
+#define CAT_INTERN_INITIAL_CAPACITY 256
+
+namespace Cat {
+
+	namespace {
+
+		/**
+		 * @brief An open addressing hash table of interned entries.
+		 * Once published, a table only ever has empty slots filled in.
+		 */
+		struct InternTable {
+			Size capacity;
+			Size count;
+			AtomicPtr<const InternEntry>* slots;
+			InternTable* pRetired;			
+		};
+
+		/**
+		 * @brief A chunk of the arena the strings are stored in.
+		 */
+		struct InternChunk {
+			InternChunk* pNext;
+			Size used;
+			Size size;
+		};
+
+		struct InternState {
+			InternState()
+				: pChunks(NIL), arenaSize(0) {
+				table.set(createTable(CAT_INTERN_INITIAL_CAPACITY));
+			}
+
+			static InternTable* createTable(Size capacity) {
+				InternTable* t = new InternTable();
+				t->capacity = capacity;
+				t->count = 0;
+				t->slots = new AtomicPtr<const InternEntry>[capacity];
+				t->pRetired = NIL;
+				return t;
+			}
+
+			AtomicPtr<InternTable> table;
+			Mutex                  lock;
+			InternChunk*           pChunks;
+			Size                   arenaSize;
+		};
+
+		InternState& state() {
+			/* Function static, so initialised exactly once, on first use */
+			static InternState s_state;
+			return s_state;
+		}
+
+		inline Boolean entryMatches(const InternEntry* entry, OID oid,
+											 const Char* str, Size length) {
+			return (entry->oid == oid && entry->length == length &&
+					  memcmp(entry->text, str, length) == 0);
+		}
+
+		/**
+		 * @brief Probe the table for the string, without locking.
+		 * @return The entry, or NIL if the string is not in the table.
+		 */
+		const InternEntry* probe(const InternTable* table, OID oid,
+										 const Char* str, Size length) {
+			Size mask = table->capacity - 1;
+			Size idx = oid & mask;
+			const InternEntry* entry = table->slots[idx].get();
+			while (entry) {
+				if (entryMatches(entry, oid, str, length)) {
+					return entry;
+				}
+				idx = (idx + 1) & mask;
+				entry = table->slots[idx].get();
+			}
+			return NIL;
+		}
+
+		/**
+		 * @brief Put the entry in the first empty slot, caller holds the lock.
+		 */
+		void place(InternTable* table, const InternEntry* entry) {
+			Size mask = table->capacity - 1;
+			Size idx = entry->oid & mask;
+			while (table->slots[idx].get()) {
+				idx = (idx + 1) & mask;
+			}
+			table->slots[idx].set(entry);
+			table->count++;
+		}
+
+		/**
+		 * @brief Copy the string into the arena, caller holds the lock.
+		 */
+		InternEntry* allocateEntry(InternState& s, OID oid,
+											const Char* str, Size length) {
+			Size bytes = offsetof(InternEntry, text) + length + 1;
+			bytes = (bytes + sizeof(Size) - 1) & ~(sizeof(Size) - 1);
+
+			InternChunk* chunk = s.pChunks;
+			if (!chunk || chunk->size - chunk->used < bytes) {
+				Size dataSize = bytes > CAT_INTERN_CHUNK_SIZE ? bytes : CAT_INTERN_CHUNK_SIZE;
+				chunk = (InternChunk*)malloc(sizeof(InternChunk) + dataSize);
+				if (!chunk) {
+					DERR("Failed to allocate interned string arena chunk!");
+					return NIL;					
+				}
+				chunk->used = 0;
+				chunk->size = dataSize;
+				/* Keep a large, single string chunk from wasting the current one */
+				if (s.pChunks && dataSize > CAT_INTERN_CHUNK_SIZE) {
+					chunk->pNext = s.pChunks->pNext;
+					s.pChunks->pNext = chunk;
+				} else {
+					chunk->pNext = s.pChunks;
+					s.pChunks = chunk;
+				}
+				s.arenaSize += dataSize;
+			}
+
+			InternEntry* entry = (InternEntry*)((U8*)(chunk + 1) + chunk->used);
+			chunk->used += bytes;
+			entry->oid = oid;
+			entry->length = length;
+			memcpy(entry->text, str, length);
+			entry->text[length] = '\0';
+			return entry;			
+		}
+
+		/**
+		 * @brief Publish a table twice the size, caller holds the lock.
+		 * The old table is retired but never freed, since readers may
+		 * still be probing it.
+		 */
+		InternTable* grow(InternState& s, InternTable* old) {
+			InternTable* table = InternState::createTable(old->capacity << 1);
+			for (Size i = 0; i < old->capacity; ++i) {
+				const InternEntry* entry = old->slots[i].get();
+				if (entry) {
+					place(table, entry);
+				}
+			}
+			table->pRetired = old;
+			s.table.set(table);
+			return table;
+		}
+		
+	} // namespace
+
+	InternedString StringInterner::intern(const Char* str) {
+		if (!str) {
+			return InternedString();
+		}
+		return intern(str, strlen(str));
+	}
+
+	InternedString StringInterner::intern(const Char* str, Size length) {
+		if (!str) {
+			return InternedString();
+		}
+
+		OID oid = crc32(str, length);
+		InternState& s = state();
+		const InternEntry* entry = probe(s.table.get(), oid, str, length);
+		if (entry) {
+			return InternedString(entry);
+		}
+
+		s.lock.lock();
+		/* Only the lock holder changes the table, so this is current */
+		InternTable* table = s.table.get();
+		entry = probe(table, oid, str, length);
+		if (!entry) {
+			InternEntry* newEntry = allocateEntry(s, oid, str, length);
+			if (newEntry) {
+				if ((table->count + 1) * 2 > table->capacity) {
+					table = grow(s, table);
+				}
+				place(table, newEntry);
+			}
+			entry = newEntry;
+		}
+		s.lock.unlock();
+		return InternedString(entry);
+	}
+
+	InternedString StringInterner::find(const Char* str) {
+		if (!str) {
+			return InternedString();
+		}
+		return find(str, strlen(str));
+	}
+
+	InternedString StringInterner::find(const Char* str, Size length) {
+		if (!str) {
+			return InternedString();
+		}
+		return InternedString(probe(state().table.get(), crc32(str, length),
+											 str, length));
+	}
+
+	Size StringInterner::numStrings() {
+		InternState& s = state();
+		s.lock.lock();
+		Size count = s.table.get()->count;
+		s.lock.unlock();
+		return count;
+	}
+
+	Size StringInterner::arenaSize() {
+		InternState& s = state();
+		s.lock.lock();
+		Size size = s.arenaSize;
+		s.lock.unlock();
+		return size;
+	}
+
+} // namespace Cat
@@ -0,0 +1,273 @@
+#include "core/string/rope.h"
+#include "core/string/stringutils.h"
+#include "core/io/outputstream.h"
+
+namespace Cat {
+
+	RopeNode::RopeNode(const Char* text, Size length)
+		: m_pText(NIL), m_length(length), m_depth(0) {
+		m_pText = new Char[length ? length : 1];
+		memcpy(m_pText, text, sizeof(Char)*length);
+	}
+
+	RopeNode::RopeNode(const StringView& first, const StringView& second)
+		: m_pText(NIL), m_length(first.length() + second.length()), m_depth(0) {
+		m_pText = new Char[m_length ? m_length : 1];
+		memcpy(m_pText, first.data(), sizeof(Char)*first.length());
+		memcpy(m_pText + first.length(), second.data(), sizeof(Char)*second.length());
+	}
+
+	RopeNode::RopeNode(const RopeNodePtr& left, const RopeNodePtr& right)
+		: m_pText(NIL), m_length(left->length() + right->length()),
+		  m_pLeft(left), m_pRight(right) {
+		m_depth = 1 + (left->depth() > right->depth() ? left->depth() : right->depth());
+	}
+
+	RopeNode::~RopeNode() {
+		if (m_pText) {
+			delete[] m_pText;
+			m_pText = NIL;
+		}
+	}
+
+	namespace {
+
+		/**
+		 * @brief Build a balanced tree of leaves holding a copy of the text.
+		 */
+		RopeNodePtr createNodes(const Char* text, Size length) {
+			if (length == 0) {
+				return RopeNodePtr();
+			}
+			else if (length <= CAT_ROPE_LEAF_SIZE) {
+				return RopeNodePtr(new RopeNode(text, length));
+			}
+			/* Split on a leaf boundary, so all but the last leaf are full */
+			Size numLeaves = (length + CAT_ROPE_LEAF_SIZE - 1) / CAT_ROPE_LEAF_SIZE;
+			Size half = (numLeaves / 2) * CAT_ROPE_LEAF_SIZE;
+			return RopeNodePtr(new RopeNode(createNodes(text, half),
+													  createNodes(text + half, length - half)));
+		}
+
+		Size countLeaves(const RopeNodePtr& node) {
+			if (node->isLeaf()) {
+				return 1;
+			}
+			return countLeaves(node->left()) + countLeaves(node->right());
+		}
+
+		void collectLeaves(const RopeNodePtr& node, RopeNodePtr* leaves, Size& idx) {
+			if (node->isLeaf()) {
+				leaves[idx++] = node;
+			} else {
+				collectLeaves(node->left(), leaves, idx);
+				collectLeaves(node->right(), leaves, idx);
+			}
+		}
+
+		RopeNodePtr buildBalanced(const RopeNodePtr* leaves, Size start, Size end) {
+			if (end - start == 1) {
+				return leaves[start];
+			}
+			Size mid = start + (end - start) / 2;
+			return RopeNodePtr(new RopeNode(buildBalanced(leaves, start, mid),
+													  buildBalanced(leaves, mid, end)));
+		}
+
+		RopeNodePtr balance(const RopeNodePtr& node) {
+			if (node.isNull() || node->isLeaf()) {
+				return node;
+			}
+			Size numLeaves = countLeaves(node);
+			RopeNodePtr* leaves = new RopeNodePtr[numLeaves];
+			Size idx = 0;
+			collectLeaves(node, leaves, idx);
+			RopeNodePtr root = buildBalanced(leaves, 0, numLeaves);
+			delete[] leaves;
+			return root;
+		}
+
+		/**
+		 * @brief Join two nodes, merging small leaves, and rebalancing if too deep.
+		 */
+		RopeNodePtr join(const RopeNodePtr& left, const RopeNodePtr& right) {
+			if (left.isNull()) {
+				return right;
+			}
+			else if (right.isNull()) {
+				return left;
+			}
+
+			if (right->isLeaf()) {
+				if (left->isLeaf() &&
+					 left->length() + right->length() <= CAT_ROPE_LEAF_SIZE) {
+					return RopeNodePtr(new RopeNode(left->text(), right->text()));
+				}
+				/* Appending a little text to the end, merge into the last leaf */
+				if (!left->isLeaf() && left->right()->isLeaf() &&
+					 left->right()->length() + right->length() <= CAT_ROPE_LEAF_SIZE) {
+					RopeNodePtr merged(new RopeNode(left->right()->text(), right->text()));
+					return RopeNodePtr(new RopeNode(left->left(), merged));
+				}
+			}
+
+			RopeNodePtr node(new RopeNode(left, right));
+			if (node->depth() > CAT_ROPE_MAX_DEPTH) {
+				return balance(node);
+			}
+			return node;
+		}
+
+		/**
+		 * @brief Split the node into the text before, and from pos onwards.
+		 */
+		void split(const RopeNodePtr& node, Size pos, RopeNodePtr& before, RopeNodePtr& after) {
+			if (node.isNull() || pos == 0) {
+				before.setNull();
+				after = node;
+				return;
+			}
+			else if (pos >= node->length()) {
+				before = node;
+				after.setNull();
+				return;
+			}
+
+			if (node->isLeaf()) {
+				StringView text = node->text();
+				before = RopeNodePtr(new RopeNode(text.data(), pos));
+				after = RopeNodePtr(new RopeNode(text.data() + pos, text.length() - pos));
+				return;
+			}
+
+			/* Copy the children first, before or after may alias node */
+			RopeNodePtr left = node->left();
+			RopeNodePtr right = node->right();
+			Size leftLength = left->length();
+			RopeNodePtr a, b;
+			if (pos < leftLength) {
+				split(left, pos, a, b);
+				before = a;
+				after = join(b, right);
+			}
+			else if (pos == leftLength) {
+				before = left;
+				after = right;
+			}
+			else {
+				split(right, pos - leftLength, a, b);
+				before = join(left, a);
+				after = b;
+			}
+		}
+
+		Char* copyNode(const RopeNodePtr& node, Char* dest) {
+			if (node->isLeaf()) {
+				StringView text = node->text();
+				memcpy(dest, text.data(), sizeof(Char)*text.length());
+				return dest + text.length();
+			}
+			dest = copyNode(node->left(), dest);
+			return copyNode(node->right(), dest);
+		}
+
+		Boolean writeNode(const RopeNodePtr& node, OutputStream& out, Size& written) {
+			if (node->isLeaf()) {
+				StringView text = node->text();
+				Size wrote = out.write(text.data(), text.length());
+				written += wrote;
+				if (wrote < text.length()) {
+					DWARN("Only wrote " << wrote << " of " << text.length() << " characters!");
+					return false;
+				}
+				return true;
+			}
+			return (writeNode(node->left(), out, written) &&
+					  writeNode(node->right(), out, written));
+		}
+
+	} // namespace
+
+	Rope::Rope(const StringView& text)
+		: m_pRoot(createNodes(text.data(), text.length())) {}
+
+	Rope& Rope::append(const StringView& text) {
+		if (text.length() <= CAT_ROPE_LEAF_SIZE) {
+			RopeNodePtr leaf;
+			if (!text.isEmpty()) {
+				leaf = RopeNodePtr(new RopeNode(text.data(), text.length()));
+			}
+			m_pRoot = join(m_pRoot, leaf);
+			return *this;
+		}
+		return append(Rope(text));
+	}
+
+	Rope& Rope::append(const Rope& rope) {
+		m_pRoot = join(m_pRoot, rope.m_pRoot);
+		return *this;
+	}
+
+	Char Rope::charAt(Size idx) const {
+		D_CONDERR((idx >= length()), "Index " << idx << " out of range!");
+		const RopeNode* node = m_pRoot.ptr();
+		while (!node->isLeaf()) {
+			Size leftLength = node->left()->length();
+			if (idx < leftLength) {
+				node = node->left().ptr();
+			} else {
+				idx -= leftLength;
+				node = node->right().ptr();
+			}
+		}
+		return node->text()[idx];
+	}
+
+	void Rope::copyTo(Char* dest) const {
+		if (m_pRoot.notNull()) {
+			dest = copyNode(m_pRoot, dest);
+		}
+		*dest = '\0';
+	}
+
+	Rope& Rope::erase(Size pos, Size length) {
+		RopeNodePtr before, rest, removed, after;
+		split(m_pRoot, pos, before, rest);
+		split(rest, length, removed, after);
+		m_pRoot = join(before, after);
+		return *this;
+	}
+
+	Rope& Rope::insert(Size pos, const Rope& rope) {
+		RopeNodePtr before, after;
+		split(m_pRoot, pos, before, after);
+		m_pRoot = join(join(before, rope.m_pRoot), after);
+		return *this;
+	}
+
+	void Rope::rebalance() {
+		m_pRoot = balance(m_pRoot);
+	}
+
+	Rope Rope::sub(Size pos, Size length) const {
+		RopeNodePtr before, rest, middle, after;
+		split(m_pRoot, pos, before, rest);
+		split(rest, length, middle, after);
+		return Rope(middle);
+	}
+
+	Char* Rope::toCString() const {
+		Char* str = StringUtils::create(length());
+		copyTo(str);
+		return str;
+	}
+
+	Size Rope::writeTo(OutputStream& out) const {
+		Size written = 0;
+		if (m_pRoot.notNull()) {
+			writeNode(m_pRoot, out, written);
+		}
+		return written;
+	}
+
+} // namespace Cat
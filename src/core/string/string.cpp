@@ -37,12 +37,7 @@ namespace Cat {
 			return true;
 		}
 		else if (m_length == other.m_length) {
-			for (Size idx = 0; idx < m_length; idx++) {
-				if (tolower(m_pString[idx]) != tolower(other.m_pString[idx])) {
-					return false;
-				}
-			}
-			return true;			
+			return StringUtils::equalsIgnoreCase(m_pString, other.m_pString, m_length);
 		}
 		else {
 			return false;
@@ -58,12 +53,7 @@ namespace Cat {
 		}		
 		Size len = StringUtils::length(other);
 	   if (m_length == len) {
-			for (Size idx = 0; idx < m_length; idx++) {
-				if (tolower(m_pString[idx]) != tolower(other[idx])) {
-					return false;
-				}
-			}
-			return true;			
+			return StringUtils::equalsIgnoreCase(m_pString, other, m_length);
 		}
 		else {
 			return false;
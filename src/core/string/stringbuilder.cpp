@@ -0,0 +1,157 @@
+#include "core/string/stringbuilder.h"
+#include "core/string/stringutils.h"
+#include "core/io/outputstream.h"
+
+namespace Cat {
+
+	StringBuilder::StringBuilder(Size initialCapacity)
+		: m_pFirst(NIL), m_pLast(NIL), m_length(0), m_numChunks(0),
+		  m_nextCapacity(initialCapacity ? initialCapacity : 1) {}
+
+	StringBuilder::~StringBuilder() {
+		Chunk* chunk = m_pFirst;
+		while (chunk) {
+			Chunk* next = chunk->pNext;
+			delete[] (U8*)chunk;
+			chunk = next;
+		}
+		m_pFirst = m_pLast = NIL;
+	}
+
+	StringBuilder& StringBuilder::append(const StringView& str) {
+		const Char* src = str.data();
+		Size remaining = str.length();
+		while (remaining > 0) {
+			if (!m_pLast || m_pLast->used == m_pLast->capacity) {
+				nextChunk(1);
+			}
+			Size space = m_pLast->capacity - m_pLast->used;
+			Size toCopy = remaining < space ? remaining : space;
+			memcpy(m_pLast->text() + m_pLast->used, src, sizeof(Char)*toCopy);
+			m_pLast->used += toCopy;
+			m_length += toCopy;
+			src += toCopy;
+			remaining -= toCopy;
+		}
+		return *this;
+	}
+
+	StringBuilder& StringBuilder::append(Char chr, Size count) {
+		while (count > 0) {
+			if (!m_pLast || m_pLast->used == m_pLast->capacity) {
+				nextChunk(1);
+			}
+			Size space = m_pLast->capacity - m_pLast->used;
+			Size toSet = count < space ? count : space;
+			memset(m_pLast->text() + m_pLast->used, chr, toSet);
+			m_pLast->used += toSet;
+			m_length += toSet;
+			count -= toSet;
+		}
+		return *this;
+	}
+
+	StringBuilder& StringBuilder::append(I64 value) {
+		Size written = StringUtils::formatI64(reserve(CAT_MAX_I64_STRING_LENGTH), value);
+		m_pLast->used += written;
+		m_length += written;
+		return *this;
+	}
+
+	StringBuilder& StringBuilder::append(U64 value) {
+		Size written = StringUtils::formatU64(reserve(CAT_MAX_U64_STRING_LENGTH), value);
+		m_pLast->used += written;
+		m_length += written;
+		return *this;
+	}
+
+	StringBuilder& StringBuilder::append(F64 value, U32 precision) {
+		Size written = StringUtils::formatF64(reserve(CAT_MAX_F64_STRING_LENGTH),
+														  value, precision);
+		m_pLast->used += written;
+		m_length += written;
+		return *this;
+	}
+
+	void StringBuilder::clear() {
+		for (Chunk* chunk = m_pFirst; chunk; chunk = chunk->pNext) {
+			chunk->used = 0;
+		}
+		m_pLast = m_pFirst;
+		m_length = 0;
+	}
+
+	void StringBuilder::copyTo(Char* dest) const {
+		for (const Chunk* chunk = m_pFirst; chunk; chunk = chunk->pNext) {
+			memcpy(dest, chunk->text(), sizeof(Char)*chunk->used);
+			dest += chunk->used;
+			if (chunk == m_pLast) {
+				break;
+			}
+		}
+		*dest = '\0';
+	}
+
+	Char* StringBuilder::toCString() const {
+		Char* str = StringUtils::create(m_length);
+		copyTo(str);
+		return str;
+	}
+
+	void StringBuilder::toString(String& dest) const {
+		dest.store(toCString(), (I32)m_length);
+	}
+
+	Size StringBuilder::writeTo(OutputStream& out) const {
+		Size written = 0;
+		for (const Chunk* chunk = m_pFirst; chunk; chunk = chunk->pNext) {
+			if (chunk->used > 0) {
+				Size wrote = out.write(chunk->text(), chunk->used);
+				written += wrote;
+				if (wrote < chunk->used) {
+					DWARN("Only wrote " << wrote << " of " << chunk->used << " characters!");
+					break;
+				}
+			}
+			if (chunk == m_pLast) {
+				break;
+			}
+		}
+		return written;
+	}
+
+	void StringBuilder::nextChunk(Size count) {
+		/* Chunks after the last one were emptied by clear(), so reuse them */
+		Chunk* prev = m_pLast;
+		Chunk* next = m_pLast ? m_pLast->pNext : m_pFirst;
+		while (next && next->capacity < count) {
+			prev = next;
+			next = next->pNext;
+		}
+		if (next) {
+			m_pLast = next;
+			return;
+		}
+
+		Size capacity = m_nextCapacity > count ? m_nextCapacity : count;
+		Chunk* chunk = (Chunk*)(new U8[sizeof(Chunk) + sizeof(Char)*capacity]);
+		chunk->pNext = NIL;
+		chunk->used = 0;
+		chunk->capacity = capacity;
+		if (prev) {
+			prev->pNext = chunk;
+		} else {
+			m_pFirst = chunk;
+		}
+		m_pLast = chunk;
+		++m_numChunks;
+
+		if (m_nextCapacity < CAT_STRING_BUILDER_MAX_CHUNK_CAPACITY) {
+			m_nextCapacity <<= 1;
+			if (m_nextCapacity > CAT_STRING_BUILDER_MAX_CHUNK_CAPACITY) {
+				m_nextCapacity = CAT_STRING_BUILDER_MAX_CHUNK_CAPACITY;
+			}
+		}
+	}
+
+} // namespace Cat
@@ -0,0 +1,399 @@
+#include <cstring>
+#include "core/string/stringkernels.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	/*************************************************************
+	 * Scalar kernels
+	 *************************************************************/
+
+	static inline Char foldAscii(Char c) {
+		return (c >= 'A' && c <= 'Z') ? (Char)(c + ('a' - 'A')) : c;
+	}
+
+	static Size scalarLength16(const U16* str) {
+		const U16* p = str;
+		while (*p != 0) {
+			++p;
+		}
+		return (Size)(p - str);
+	}
+
+	static const U16* scalarFind16(const U16* str, U16 ch) {
+		for (;; ++str) {
+			if (*str == ch) {
+				return str;
+			}
+			if (*str == 0) {
+				return NIL;
+			}
+		}
+	}
+
+	static const U16* scalarFindLast16(const U16* str, Size length, U16 ch) {
+		while (length > 0) {
+			--length;
+			if (str[length] == ch) {
+				return &(str[length]);
+			}
+		}
+		return NIL;
+	}
+
+	static const U16* scalarFindSub16(const U16* haystack, Size haystackLength,
+												 const U16* needle, Size needleLength) {
+		if (needleLength == 0) {
+			return haystack;
+		}
+		if (needleLength > haystackLength) {
+			return NIL;
+		}
+		Size last = haystackLength - needleLength;
+		for (Size i = 0; i <= last; ++i) {
+			if (haystack[i] == needle[0] &&
+				 memcmp(&(haystack[i]), needle, sizeof(U16)*needleLength) == 0) {
+				return &(haystack[i]);
+			}
+		}
+		return NIL;
+	}
+
+	static Size scalarMismatch16(const U16* str1, const U16* str2, Size length) {
+		Size i = 0;
+		while (i < length && str1[i] == str2[i]) {
+			++i;
+		}
+		return i;
+	}
+
+	static Boolean scalarEqualsIgnoreCase(const Char* str1, const Char* str2, Size length) {
+		for (Size i = 0; i < length; ++i) {
+			if (foldAscii(str1[i]) != foldAscii(str2[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static const StringKernels::Table s_scalarTable = {
+		scalarLength16,
+		scalarFind16,
+		scalarFindLast16,
+		scalarFindSub16,
+		scalarMismatch16,
+		scalarEqualsIgnoreCase,
+		"scalar"
+	};
+
+#if defined (CAT_SIMD_SSE2)
+	/* Index of the lowest / highest set bit in a non-zero mask */
+	static inline U32 lowBit(U32 mask) { return (U32)__builtin_ctz(mask); }
+	static inline U32 highBit(U32 mask) { return 31 - (U32)__builtin_clz(mask); }
+
+	/*************************************************************
+	 * SSE2 kernels (8 x U16 or 16 x Char per vector)
+	 *************************************************************/
+
+	CAT_NO_SANITIZE_ADDRESS static Size sse2Length16(const U16* str) {
+		if (((Addr)str & 1) != 0) {
+			return scalarLength16(str);
+		}
+		/* Align down, and ignore any matches before the start of the string */
+		U32 misalign = (U32)((Addr)str & 15);
+		const __m128i* block = (const __m128i*)((Addr)str - misalign);
+		const __m128i zero = _mm_setzero_si128();
+		U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(block), zero));
+		mask &= (0xFFFFu << misalign);
+		while (mask == 0) {
+			++block;
+			mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(block), zero));
+		}
+		const Char* end = (const Char*)block + lowBit(mask);
+		return (Size)(end - (const Char*)str) / sizeof(U16);
+	}
+
+	CAT_NO_SANITIZE_ADDRESS static const U16* sse2Find16(const U16* str, U16 ch) {
+		if (((Addr)str & 1) != 0) {
+			return scalarFind16(str, ch);
+		}
+		U32 misalign = (U32)((Addr)str & 15);
+		const __m128i* block = (const __m128i*)((Addr)str - misalign);
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i needle = _mm_set1_epi16((I16)ch);
+		__m128i v = _mm_load_si128(block);
+		U32 mask = (U32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(v, zero),
+																	  _mm_cmpeq_epi16(v, needle)));
+		mask &= (0xFFFFu << misalign);
+		while (mask == 0) {
+			++block;
+			v = _mm_load_si128(block);
+			mask = (U32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(v, zero),
+																	 _mm_cmpeq_epi16(v, needle)));
+		}
+		const U16* found = (const U16*)((const Char*)block + lowBit(mask));
+		return (*found == ch) ? found : NIL;
+	}
+
+	static const U16* sse2FindLast16(const U16* str, Size length, U16 ch) {
+		const __m128i needle = _mm_set1_epi16((I16)ch);
+		while (length >= 8) {
+			length -= 8;
+			__m128i v = _mm_loadu_si128((const __m128i*)&(str[length]));
+			U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi16(v, needle));
+			if (mask != 0) {
+				return &(str[length + (highBit(mask) >> 1)]);
+			}
+		}
+		return scalarFindLast16(str, length, ch);
+	}
+
+	static const U16* sse2FindSub16(const U16* haystack, Size haystackLength,
+											  const U16* needle, Size needleLength) {
+		if (needleLength == 0) {
+			return haystack;
+		}
+		if (needleLength > haystackLength) {
+			return NIL;
+		}
+		/* Filter candidates on the first AND last needle char, then verify */
+		const __m128i first = _mm_set1_epi16((I16)needle[0]);
+		const __m128i last = _mm_set1_epi16((I16)needle[needleLength - 1]);
+		Size numPositions = haystackLength - needleLength + 1;
+		Size i = 0;
+		while (i + 8 <= numPositions) {
+			__m128i vFirst = _mm_loadu_si128((const __m128i*)&(haystack[i]));
+			__m128i vLast = _mm_loadu_si128((const __m128i*)&(haystack[i + needleLength - 1]));
+			U32 mask = (U32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(vFirst, first),
+																			_mm_cmpeq_epi16(vLast, last)));
+			mask &= 0x5555u;
+			while (mask != 0) {
+				Size pos = i + (lowBit(mask) >> 1);
+				if (needleLength <= 2 ||
+					 memcmp(&(haystack[pos + 1]), &(needle[1]),
+							  sizeof(U16)*(needleLength - 2)) == 0) {
+					return &(haystack[pos]);
+				}
+				mask &= (mask - 1);
+			}
+			i += 8;
+		}
+		const U16* found = scalarFindSub16(&(haystack[i]), haystackLength - i,
+													  needle, needleLength);
+		return found;
+	}
+
+	static Size sse2Mismatch16(const U16* str1, const U16* str2, Size length) {
+		Size i = 0;
+		while (i + 8 <= length) {
+			__m128i v1 = _mm_loadu_si128((const __m128i*)&(str1[i]));
+			__m128i v2 = _mm_loadu_si128((const __m128i*)&(str2[i]));
+			U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi16(v1, v2));
+			if (mask != 0xFFFFu) {
+				return i + (lowBit(~mask & 0xFFFFu) >> 1);
+			}
+			i += 8;
+		}
+		return i + scalarMismatch16(&(str1[i]), &(str2[i]), length - i);
+	}
+
+	/* Lowercase the ascii letters in a vector of 16 chars */
+	static inline __m128i sse2FoldAscii(__m128i v) {
+		/* (c - 'A') < 26 as an unsigned compare, using a signed compare + bias */
+		const __m128i bias = _mm_set1_epi8((Char)(0x80 - 'A'));
+		const __m128i limit = _mm_set1_epi8((Char)(0x80 + 26));
+		__m128i isUpper = _mm_cmplt_epi8(_mm_add_epi8(v, bias), limit);
+		return _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+	}
+
+	static Boolean sse2EqualsIgnoreCase(const Char* str1, const Char* str2, Size length) {
+		Size i = 0;
+		while (i + 16 <= length) {
+			__m128i v1 = sse2FoldAscii(_mm_loadu_si128((const __m128i*)&(str1[i])));
+			__m128i v2 = sse2FoldAscii(_mm_loadu_si128((const __m128i*)&(str2[i])));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) != 0xFFFF) {
+				return false;
+			}
+			i += 16;
+		}
+		return scalarEqualsIgnoreCase(&(str1[i]), &(str2[i]), length - i);
+	}
+
+	static const StringKernels::Table s_sse2Table = {
+		sse2Length16,
+		sse2Find16,
+		sse2FindLast16,
+		sse2FindSub16,
+		sse2Mismatch16,
+		sse2EqualsIgnoreCase,
+		"sse2"
+	};
+
+#if defined (CAT_SIMD_AVX2)
+	/*************************************************************
+	 * AVX2 kernels (16 x U16 or 32 x Char per vector)
+	 *************************************************************/
+
+	CAT_NO_SANITIZE_ADDRESS CAT_TARGET_AVX2 static Size avx2Length16(const U16* str) {
+		if (((Addr)str & 1) != 0) {
+			return scalarLength16(str);
+		}
+		U32 misalign = (U32)((Addr)str & 31);
+		const __m256i* block = (const __m256i*)((Addr)str - misalign);
+		const __m256i zero = _mm256_setzero_si256();
+		U32 mask = (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_load_si256(block), zero));
+		mask &= (0xFFFFFFFFu << misalign);
+		while (mask == 0) {
+			++block;
+			mask = (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_load_si256(block), zero));
+		}
+		const Char* end = (const Char*)block + lowBit(mask);
+		return (Size)(end - (const Char*)str) / sizeof(U16);
+	}
+
+	CAT_NO_SANITIZE_ADDRESS CAT_TARGET_AVX2 static const U16* avx2Find16(const U16* str, U16 ch) {
+		if (((Addr)str & 1) != 0) {
+			return scalarFind16(str, ch);
+		}
+		U32 misalign = (U32)((Addr)str & 31);
+		const __m256i* block = (const __m256i*)((Addr)str - misalign);
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i needle = _mm256_set1_epi16((I16)ch);
+		__m256i v = _mm256_load_si256(block);
+		U32 mask = (U32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi16(v, zero),
+																			  _mm256_cmpeq_epi16(v, needle)));
+		mask &= (0xFFFFFFFFu << misalign);
+		while (mask == 0) {
+			++block;
+			v = _mm256_load_si256(block);
+			mask = (U32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi16(v, zero),
+																			 _mm256_cmpeq_epi16(v, needle)));
+		}
+		const U16* found = (const U16*)((const Char*)block + lowBit(mask));
+		return (*found == ch) ? found : NIL;
+	}
+
+	CAT_TARGET_AVX2 static const U16* avx2FindLast16(const U16* str, Size length, U16 ch) {
+		const __m256i needle = _mm256_set1_epi16((I16)ch);
+		while (length >= 16) {
+			length -= 16;
+			__m256i v = _mm256_loadu_si256((const __m256i*)&(str[length]));
+			U32 mask = (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, needle));
+			if (mask != 0) {
+				return &(str[length + (highBit(mask) >> 1)]);
+			}
+		}
+		return sse2FindLast16(str, length, ch);
+	}
+
+	CAT_TARGET_AVX2 static const U16* avx2FindSub16(const U16* haystack, Size haystackLength,
+																	const U16* needle, Size needleLength) {
+		if (needleLength == 0) {
+			return haystack;
+		}
+		if (needleLength > haystackLength) {
+			return NIL;
+		}
+		const __m256i first = _mm256_set1_epi16((I16)needle[0]);
+		const __m256i last = _mm256_set1_epi16((I16)needle[needleLength - 1]);
+		Size numPositions = haystackLength - needleLength + 1;
+		Size i = 0;
+		while (i + 16 <= numPositions) {
+			__m256i vFirst = _mm256_loadu_si256((const __m256i*)&(haystack[i]));
+			__m256i vLast = _mm256_loadu_si256((const __m256i*)&(haystack[i + needleLength - 1]));
+			U32 mask = (U32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi16(vFirst, first),
+																					_mm256_cmpeq_epi16(vLast, last)));
+			mask &= 0x55555555u;
+			while (mask != 0) {
+				Size pos = i + (lowBit(mask) >> 1);
+				if (needleLength <= 2 ||
+					 memcmp(&(haystack[pos + 1]), &(needle[1]),
+							  sizeof(U16)*(needleLength - 2)) == 0) {
+					return &(haystack[pos]);
+				}
+				mask &= (mask - 1);
+			}
+			i += 16;
+		}
+		return sse2FindSub16(&(haystack[i]), haystackLength - i, needle, needleLength);
+	}
+
+	CAT_TARGET_AVX2 static Size avx2Mismatch16(const U16* str1, const U16* str2, Size length) {
+		Size i = 0;
+		while (i + 16 <= length) {
+			__m256i v1 = _mm256_loadu_si256((const __m256i*)&(str1[i]));
+			__m256i v2 = _mm256_loadu_si256((const __m256i*)&(str2[i]));
+			U32 mask = (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi16(v1, v2));
+			if (mask != 0xFFFFFFFFu) {
+				return i + (lowBit(~mask) >> 1);
+			}
+			i += 16;
+		}
+		return i + sse2Mismatch16(&(str1[i]), &(str2[i]), length - i);
+	}
+
+	CAT_TARGET_AVX2 static inline __m256i avx2FoldAscii(__m256i v) {
+		const __m256i bias = _mm256_set1_epi8((Char)(0x80 - 'A'));
+		const __m256i limit = _mm256_set1_epi8((Char)(0x80 + 26));
+		__m256i isUpper = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, bias));
+		return _mm256_or_si256(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+	}
+
+	CAT_TARGET_AVX2 static Boolean avx2EqualsIgnoreCase(const Char* str1, const Char* str2,
+																		 Size length) {
+		Size i = 0;
+		while (i + 32 <= length) {
+			__m256i v1 = avx2FoldAscii(_mm256_loadu_si256((const __m256i*)&(str1[i])));
+			__m256i v2 = avx2FoldAscii(_mm256_loadu_si256((const __m256i*)&(str2[i])));
+			if ((U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2)) != 0xFFFFFFFFu) {
+				return false;
+			}
+			i += 32;
+		}
+		return sse2EqualsIgnoreCase(&(str1[i]), &(str2[i]), length - i);
+	}
+
+	static const StringKernels::Table s_avx2Table = {
+		avx2Length16,
+		avx2Find16,
+		avx2FindLast16,
+		avx2FindSub16,
+		avx2Mismatch16,
+		avx2EqualsIgnoreCase,
+		"avx2"
+	};
+#endif /* CAT_SIMD_AVX2 */
+#endif /* CAT_SIMD_SSE2 */
+
+	const StringKernels::Table& StringKernels::table() {
+		static const Table* s_pTable = selectTable();
+		return *s_pTable;
+	}
+
+	const StringKernels::Table& StringKernels::scalarTable() {
+		return s_scalarTable;
+	}
+
+	Size StringKernels::supportedTables(const Table** tables) {
+		Size count = 0;
+#if defined (CAT_SIMD_AVX2)
+		if (Cpu::hasAVX2()) {
+			tables[count++] = &s_avx2Table;
+		}
+#endif
+#if defined (CAT_SIMD_SSE2)
+		if (Cpu::hasSSE2()) {
+			tables[count++] = &s_sse2Table;
+		}
+#endif
+		tables[count++] = &s_scalarTable;
+		return count;
+	}
+
+	const StringKernels::Table* StringKernels::selectTable() {
+		const Table* tables[kMaxTables];
+		supportedTables(tables);
+		return tables[0];
+	}
+
+} // namespace Cat
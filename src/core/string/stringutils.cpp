@@ -1,8 +1,58 @@
+#include <cstdio>
 #include "core/string/stringutils.h"
 
 
 namespace Cat {
 
+	/* Pairs of decimal digits "00" to "99", so we emit two digits per division */
+	static const Char s_digitPairs[201] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	static const U64 s_powersOf10[10] = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+		10000000ULL, 100000000ULL, 1000000000ULL
+	};
+
+	/**
+	 * @brief Count the number of decimal digits needed for value.
+	 */
+	static inline Size countDigits(U64 value) {
+		Size digits = 1;
+		for (;;) {
+			if (value < 10ULL) { return digits; }
+			if (value < 100ULL) { return digits + 1; }
+			if (value < 1000ULL) { return digits + 2; }
+			if (value < 10000ULL) { return digits + 3; }
+			value /= 10000ULL;
+			digits += 4;
+		}
+	}
+
+	/**
+	 * @brief Write exactly numDigits digits of value (zero padded) into dest.
+	 */
+	static inline void writeDigits(Char* dest, U64 value, Size numDigits) {
+		Size idx = numDigits;
+		while (idx >= 2) {
+			Size pair = (Size)(value % 100ULL) * 2;
+			value /= 100ULL;
+			dest[--idx] = s_digitPairs[pair + 1];
+			dest[--idx] = s_digitPairs[pair];
+		}
+		if (idx == 1) {
+			dest[0] = (Char)('0' + (value % 10ULL));
+		}
+	}
+
 	Char* StringUtils::concat(const Char* p_str1, const Char* p_str2) {
 		I32 len1 = StringUtils::length(p_str1);
 		I32 len2 = StringUtils::length(p_str2);
@@ -61,31 +111,108 @@ namespace Cat {
 
 	Boolean StringUtils::equals(const U16* str1, const U16* str2) {
 		if (str1 != NIL && str2 != NIL) {
-			while (((*str1) & (*str2)) != 0) {
-				if ((*str1) != (*str2)) {
-					return false;
-				}
-				++str1;
-				++str2;
-			}
 			if (str1 == str2) {
 				return true;
 			}
-			else {
-				return false;
-			}
+			Size len = StringUtils::length(str1);
+			return (len == StringUtils::length(str2)) &&
+				StringKernels::table().mismatch16(str1, str2, len) == len;
 		}
 		else {
 			return false;
 		}
 	}
 
-	Size StringUtils::length(const U16* str) {
-	   Size len = 0;
-		if (str) {
-			while (str[len] != 0) {
-				++len;
+	I32 StringUtils::compare(const U16* str1, const U16* str2) {
+		if (str1 == str2) {
+			return 0;
+		}
+		else if (str1 == NIL) {
+			return -1;
+		}
+		else if (str2 == NIL) {
+			return 1;
+		}
+		Size len1 = StringUtils::length(str1);
+		Size len2 = StringUtils::length(str2);
+		/* Both strings are readable up to and including the shorter's null */
+		Size len = ((len1 < len2) ? len1 : len2) + 1;
+		Size idx = StringKernels::table().mismatch16(str1, str2, len);
+		if (idx == len) {
+			return 0;
+		}
+		return (I32)str1[idx] - (I32)str2[idx];
+	}
+
+	Boolean StringUtils::equalsIgnoreCase(const Char* str1, const Char* str2) {
+		if (str1 == NIL || str2 == NIL) {
+			return false;
+		}
+		Size len = StringUtils::length(str1);
+		return (len == StringUtils::length(str2)) &&
+			StringKernels::table().equalsIgnoreCase(str1, str2, len);
+	}
+
+	const U16* StringUtils::find(const U16* haystack, const U16* needle) {
+		if (!haystack || !needle) {
+			return NIL;
+		}
+		return StringKernels::table().findSub16(haystack, StringUtils::length(haystack),
+															 needle, StringUtils::length(needle));
+	}
+
+	Size StringUtils::formatU64(Char* dest, U64 value) {
+		Size numDigits = countDigits(value);
+		writeDigits(dest, value, numDigits);
+		return numDigits;
+	}
+
+	Size StringUtils::formatI64(Char* dest, I64 value) {
+		if (value < 0) {
+			dest[0] = '-';
+			/* Negate as unsigned so that I64 min does not overflow */
+			return formatU64(&(dest[1]), (U64)0 - (U64)value) + 1;
+		}
+		return formatU64(dest, (U64)value);
+	}
+
+	Size StringUtils::formatF64(Char* dest, F64 value, U32 precision) {
+		if (precision > 9) {
+			precision = 9;
+		}
+		/* NaN, infinite or too large to scale into a U64, let libc handle it */
+		if (value != value || value >= 1.0e18 || value <= -1.0e18) {
+			I32 written = snprintf(dest, CAT_MAX_F64_STRING_LENGTH, "%.*g",
+										  (I32)precision + 1, value);
+			return (written > 0) ? (Size)written : 0;
+		}
+
+		Boolean negative = value < 0.0;
+		if (negative) {
+			value = -value;
+		}
+		U64 scale = s_powersOf10[precision];
+		U64 intPart = (U64)value;
+		U64 fracPart = (U64)(((value - (F64)intPart) * (F64)scale) + 0.5);
+		if (fracPart >= scale) {
+			++intPart;
+			fracPart -= scale;
+		}
+
+		Size len = 0;
+		if (negative && (intPart != 0 || fracPart != 0)) {
+			dest[len++] = '-';
+		}
+		len += formatU64(&(dest[len]), intPart);
+		if (fracPart != 0) {
+			Size fracDigits = precision;
+			while ((fracPart % 10ULL) == 0) {
+				fracPart /= 10ULL;
+				--fracDigits;
 			}
+			dest[len++] = '.';
+			writeDigits(&(dest[len]), fracPart, fracDigits);
+			len += fracDigits;
 		}
 		return len;
 	}
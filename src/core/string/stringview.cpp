@@ -0,0 +1,108 @@
+#include "core/string/stringview.h"
+
+namespace Cat {
+
+	namespace {
+		inline Boolean isSpace(Char chr) {
+			return (chr == ' ' || (chr >= '\t' && chr <= '\r'));
+		}
+	} // namespace
+
+	I32 StringView::compare(const StringView& other) const {
+		Size len = m_length < other.m_length ? m_length : other.m_length;
+		if (len) {
+			I32 cmp = memcmp(m_pData, other.m_pData, len);
+			if (cmp != 0) {
+				return cmp;
+			}
+		}
+		if (m_length == other.m_length) { return 0; }
+		return (m_length < other.m_length) ? -1 : 1;
+	}
+
+	Char* StringView::copy() const {
+		Char* str = new Char[m_length + 1];
+		copyTo(str);
+		return str;
+	}
+
+	I32 StringView::indexOf(const StringView& needle, Size start) const {
+		if (start > m_length || needle.m_length > m_length - start) {
+			return -1;
+		}
+		if (needle.m_length == 0) {
+			return (I32)start;
+		}
+
+		/* memchr for the first character, then compare the rest */
+		const Char first = needle.m_pData[0];
+		const Char* pos = m_pData + start;
+		const Char* last = m_pData + m_length - needle.m_length;
+		while (pos <= last) {
+			pos = (const Char*)memchr(pos, first, (last - pos) + 1);
+			if (!pos) {
+				return -1;
+			}
+			if (memcmp(pos + 1, needle.m_pData + 1, needle.m_length - 1) == 0) {
+				return (I32)(pos - m_pData);
+			}
+			++pos;
+		}
+		return -1;
+	}
+
+	I32 StringView::lastIndexOf(Char chr) const {
+		Size idx = m_length;
+		while (idx > 0) {
+			--idx;
+			if (m_pData[idx] == chr) {
+				return (I32)idx;
+			}
+		}
+		return -1;
+	}
+
+	Boolean StringView::nextToken(Char separator, StringView& token) {
+		if (!m_pData) {
+			return false;
+		}
+		if (split(separator, token, *this)) {
+			return true;
+		}
+		/* No more separators, the remainder is the last token */
+		m_pData = NIL;
+		m_length = 0;
+		return true;
+	}
+
+	Boolean StringView::split(Char separator, StringView& head, StringView& tail) const {
+		I32 idx = indexOf(separator);
+		if (idx < 0) {
+			head = *this;
+			tail = StringView(m_pData + m_length, 0);
+			return false;
+		}
+		/* Copy first, head or tail may alias this view */
+		StringView self = *this;
+		head = StringView(self.m_pData, (Size)idx);
+		tail = StringView(self.m_pData + idx + 1, self.m_length - idx - 1);
+		return true;
+	}
+
+	StringView StringView::trimLeft() const {
+		Size start = 0;
+		while (start < m_length && isSpace(m_pData[start])) {
+			++start;
+		}
+		return StringView(m_pData + start, m_length - start);
+	}
+
+	StringView StringView::trimRight() const {
+		Size end = m_length;
+		while (end > 0 && isSpace(m_pData[end - 1])) {
+			--end;
+		}
+		return StringView(m_pData, end);
+	}
+
+} // namespace Cat
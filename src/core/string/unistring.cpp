@@ -1,15 +1,17 @@
 #include "core/string/unistring.h"
 #include "core/string/stringutils.h"
+#include "core/string/utf8.h"
 
 namespace Cat {
 
 	UniString::UniString(const Char* str)
 		: m_pString(NIL), m_length(0) {
-		m_length = StringUtils::length(str);
-		m_pString = new U16[m_length+1];
-		for (Size i = 0; i <= m_length; ++i) {
-			m_pString[i] = (U16)str[i];
-		}		
+		assignUTF8(str, StringUtils::length(str));
+	}
+
+	UniString::UniString(const Char* str, Size length)
+		: m_pString(NIL), m_length(0) {
+		assignUTF8(str, length);
 	}
 
 	UniString::UniString(const U16* str)
@@ -42,17 +44,7 @@ namespace Cat {
 
 	UniString& UniString::operator=(const Char* str) {
 		if (str) {
-			Size len = StringUtils::length(str);			
-			U16* newData = new U16[len+1];
-			for (Size i = 0; i <= m_length; ++i) {
-				m_pString[i] = (U16)str[i];
-			}	
-			U16* tmp = m_pString;
-			m_pString = newData;
-			m_length = len;			
-			if (tmp) {
-				delete[] tmp;
-			}
+			assignUTF8(str, StringUtils::length(str));
 		}
 		else {
 			m_length = 0;			
@@ -89,7 +81,8 @@ namespace Cat {
 	Boolean UniString::operator==(const UniString& other) const {
 		return (m_pString == other.m_pString ||
 				  (m_pString != NIL && other.m_pString != NIL &&
-					StringUtils::equals(m_pString, other.m_pString)));		
+					m_length == other.m_length &&
+					StringUtils::equals(m_pString, other.m_pString, m_length)));
 	}
 
 	Boolean UniString::equals(const Char* str) const {
@@ -107,6 +100,41 @@ namespace Cat {
 		return true;
 	}
 
+	Char* UniString::toUTF8() const {
+		Char* str = StringUtils::create(m_length * 3);
+		Size len = Utf8::fromUtf16(m_pString, m_length, str);
+		if (len == CAT_UTF_INVALID) {
+			return StringUtils::free(str);
+		}
+		str[len] = '\0';
+		return str;
+	}
+
+	Size UniString::utf8Length() const {
+		return Utf8::utf8Length(m_pString, m_length);
+	}
+
+	UniString& UniString::assignUTF8(const Char* str, Size length) {
+		/* A UTF-8 string never decodes to more U16s than it has bytes */
+		U16* newData = new U16[length+1];
+		Size len = Utf8::toUtf16(str, length, newData);
+		if (len == CAT_UTF_INVALID) {
+			DWARN("Invalid UTF-8 string, widening as Latin-1.");
+			for (Size i = 0; i < length; ++i) {
+				newData[i] = (U16)(U8)str[i];
+			}
+			len = length;
+		}
+		newData[len] = 0;
+		U16* tmp = m_pString;
+		m_pString = newData;
+		m_length = len;
+		if (tmp) {
+			delete[] tmp;
+		}
+		return *this;
+	}
+
 #if defined (DEBUG)
 	std::ostream& operator<<(std::ostream& out, const UniString& str) {
 		if (str.isEmpty()) {
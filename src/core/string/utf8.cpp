@@ -0,0 +1,274 @@
+#include <cstring>
+#include "core/string/utf8.h"
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	static inline Boolean isContinuation(U8 byte) {
+		return (byte & 0xC0) == 0x80;
+	}
+
+	/**
+	 * @brief Decode a single, complete, sequence of need bytes into dest.
+	 * @return The number of U16s written (1 or 2) or 0 if invalid.
+	 */
+	static inline U32 decodeSequence(const U8* s, U32 need, U16* dest) {
+		U32 cp;
+		switch (need) {
+		case 2:
+			if (!isContinuation(s[1])) { return 0; }
+			dest[0] = (U16)(((s[0] & 0x1F) << 6) | (s[1] & 0x3F));
+			return 1;
+		case 3:
+			/* Reject overlongs (E0 80..9F) and surrogates (ED A0..BF) */
+			if (!isContinuation(s[1]) || !isContinuation(s[2]) ||
+				 (s[0] == 0xE0 && s[1] < 0xA0) || (s[0] == 0xED && s[1] > 0x9F)) {
+				return 0;
+			}
+			dest[0] = (U16)(((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F));
+			return 1;
+		case 4:
+			/* Reject overlongs (F0 80..8F) and > U+10FFFF (F4 90..BF) */
+			if (!isContinuation(s[1]) || !isContinuation(s[2]) || !isContinuation(s[3]) ||
+				 (s[0] == 0xF0 && s[1] < 0x90) || (s[0] == 0xF4 && s[1] > 0x8F)) {
+				return 0;
+			}
+			cp = ((U32)(s[0] & 0x07) << 18) | ((U32)(s[1] & 0x3F) << 12) |
+				((U32)(s[2] & 0x3F) << 6) | (U32)(s[3] & 0x3F);
+			cp -= 0x10000;
+			dest[0] = (U16)(0xD800 + (cp >> 10));
+			dest[1] = (U16)(0xDC00 + (cp & 0x3FF));
+			return 2;
+		default:
+			return 0;
+		}
+	}
+
+	Size Utf8::decode(const Char* src, Size length, U16* dest, Size* pConsumed) {
+		const U8* s = (const U8*)src;
+		Size i = 0;
+		Size written = 0;
+		while (i < length) {
+#if defined (CAT_SIMD_SSE2)
+			if (i + 16 <= length) {
+				__m128i v = _mm_loadu_si128((const __m128i*)&(s[i]));
+				U32 mask = (U32)_mm_movemask_epi8(v);
+				if (mask == 0) {
+					/* 16 ASCII chars, widen straight into the output */
+					const __m128i zero = _mm_setzero_si128();
+					_mm_storeu_si128((__m128i*)&(dest[written]), _mm_unpacklo_epi8(v, zero));
+					_mm_storeu_si128((__m128i*)&(dest[written + 8]), _mm_unpackhi_epi8(v, zero));
+					i += 16;
+					written += 16;
+					continue;
+				}
+				/* Copy the ASCII prefix before the first non-ASCII byte */
+				U32 ascii = (U32)__builtin_ctz(mask);
+				for (U32 k = 0; k < ascii; ++k) {
+					dest[written++] = (U16)s[i++];
+				}
+			}
+#endif /* CAT_SIMD_SSE2 */
+			U8 lead = s[i];
+			if (lead < 0x80) {
+				dest[written++] = (U16)lead;
+				++i;
+				continue;
+			}
+			U32 need = Utf8::sequenceLength(lead);
+			if (need == 0) {
+				return CAT_UTF_INVALID;
+			}
+			if (i + need > length) {
+				break; /* Incomplete sequence, leave it for the caller */
+			}
+			U32 units = decodeSequence(&(s[i]), need, &(dest[written]));
+			if (units == 0) {
+				return CAT_UTF_INVALID;
+			}
+			written += units;
+			i += need;
+		}
+		if (pConsumed) {
+			*pConsumed = i;
+		}
+		return written;
+	}
+
+	Boolean Utf8::validate(const Char* str, Size length) {
+		const U8* s = (const U8*)str;
+		U16 scratch[2];
+		Size i = 0;
+		while (i < length) {
+#if defined (CAT_SIMD_SSE2)
+			if (i + 16 <= length) {
+				U32 mask = (U32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)&(s[i])));
+				if (mask == 0) {
+					i += 16;
+					continue;
+				}
+				i += (U32)__builtin_ctz(mask);
+			}
+#endif /* CAT_SIMD_SSE2 */
+			U8 lead = s[i];
+			if (lead < 0x80) {
+				++i;
+				continue;
+			}
+			U32 need = Utf8::sequenceLength(lead);
+			if (need == 0 || i + need > length ||
+				 decodeSequence(&(s[i]), need, scratch) == 0) {
+				return false;
+			}
+			i += need;
+		}
+		return true;
+	}
+
+	Size Utf8::utf16Length(const Char* str, Size length) {
+		/* Every byte that is not a continuation byte starts a code point, and 
+			every 4 byte lead (F0..FF) needs a second (surrogate) code unit. */
+		const U8* s = (const U8*)str;
+		Size count = 0;
+		Size i = 0;
+#if defined (CAT_SIMD_SSE2)
+		/* Signed compares: continuation bytes are -128..-65, 4 byte leads -16..-1 */
+		const __m128i contLimit = _mm_set1_epi8(-64);
+		const __m128i leadLimit = _mm_set1_epi8(-17);
+		const __m128i zero = _mm_setzero_si128();
+		while (i + 16 <= length) {
+			__m128i v = _mm_loadu_si128((const __m128i*)&(s[i]));
+			U32 cont = (U32)_mm_movemask_epi8(_mm_cmplt_epi8(v, contLimit));
+			U32 lead4 = (U32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, leadLimit),
+																			 _mm_cmplt_epi8(v, zero)));
+			count += 16 - (Size)__builtin_popcount(cont) + (Size)__builtin_popcount(lead4);
+			i += 16;
+		}
+#endif /* CAT_SIMD_SSE2 */
+		for (; i < length; ++i) {
+			if (!isContinuation(s[i])) {
+				++count;
+			}
+			if (s[i] >= 0xF0) {
+				++count;
+			}
+		}
+		return count;
+	}
+
+	Size Utf8::utf8Length(const U16* str, Size length) {
+		Size count = 0;
+		for (Size i = 0; i < length; ++i) {
+			U16 c = str[i];
+			if (c < 0x80) {
+				++count;
+			}
+			else if (c < 0x800) {
+				count += 2;
+			}
+			else if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length &&
+						str[i+1] >= 0xDC00 && str[i+1] <= 0xDFFF) {
+				count += 4;
+				++i;
+			}
+			else {
+				count += 3;
+			}
+		}
+		return count;
+	}
+
+	Size Utf8::toUtf16(const Char* src, Size length, U16* dest) {
+		Size consumed = 0;
+		Size written = Utf8::decode(src, length, dest, &consumed);
+		if (written == CAT_UTF_INVALID || consumed != length) {
+			return CAT_UTF_INVALID;
+		}
+		return written;
+	}
+
+	Size Utf8::fromUtf16(const U16* src, Size length, Char* dest) {
+		U8* d = (U8*)dest;
+		Size written = 0;
+		Size i = 0;
+		while (i < length) {
+#if defined (CAT_SIMD_SSE2)
+			if (i + 8 <= length) {
+				__m128i v = _mm_loadu_si128((const __m128i*)&(src[i]));
+				__m128i high = _mm_and_si128(v, _mm_set1_epi16((I16)0xFF80));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+					/* 8 ASCII chars, narrow straight into the output */
+					_mm_storel_epi64((__m128i*)&(d[written]), _mm_packus_epi16(v, v));
+					i += 8;
+					written += 8;
+					continue;
+				}
+			}
+#endif /* CAT_SIMD_SSE2 */
+			U32 c = src[i++];
+			if (c < 0x80) {
+				d[written++] = (U8)c;
+			}
+			else if (c < 0x800) {
+				d[written++] = (U8)(0xC0 | (c >> 6));
+				d[written++] = (U8)(0x80 | (c & 0x3F));
+			}
+			else if (c >= 0xD800 && c <= 0xDFFF) {
+				/* Must be a high surrogate followed by a low surrogate */
+				if (c > 0xDBFF || i >= length || src[i] < 0xDC00 || src[i] > 0xDFFF) {
+					return CAT_UTF_INVALID;
+				}
+				U32 cp = 0x10000 + ((c - 0xD800) << 10) + ((U32)src[i++] - 0xDC00);
+				d[written++] = (U8)(0xF0 | (cp >> 18));
+				d[written++] = (U8)(0x80 | ((cp >> 12) & 0x3F));
+				d[written++] = (U8)(0x80 | ((cp >> 6) & 0x3F));
+				d[written++] = (U8)(0x80 | (cp & 0x3F));
+			}
+			else {
+				d[written++] = (U8)(0xE0 | (c >> 12));
+				d[written++] = (U8)(0x80 | ((c >> 6) & 0x3F));
+				d[written++] = (U8)(0x80 | (c & 0x3F));
+			}
+		}
+		return written;
+	}
+
+	Size Utf8Decoder::decode(const Char* src, Size length, U16* dest) {
+		if (m_failed) {
+			return CAT_UTF_INVALID;
+		}
+		Size written = 0;
+		/* First finish off any sequence split across the previous chunk */
+		if (m_numPending > 0) {
+			U32 need = Utf8::sequenceLength((U8)m_pending[0]);
+			while (m_numPending < need && length > 0) {
+				m_pending[m_numPending++] = *src++;
+				--length;
+			}
+			if (m_numPending < need) {
+				return 0;
+			}
+			Size consumed = 0;
+			written = Utf8::decode(m_pending, need, dest, &consumed);
+			if (written == CAT_UTF_INVALID || consumed != need) {
+				m_failed = true;
+				return CAT_UTF_INVALID;
+			}
+			m_numPending = 0;
+		}
+
+		Size consumed = 0;
+		Size decoded = Utf8::decode(src, length, &(dest[written]), &consumed);
+		if (decoded == CAT_UTF_INVALID) {
+			m_failed = true;
+			return CAT_UTF_INVALID;
+		}
+		/* Keep the incomplete tail (at most 3 bytes) for the next chunk */
+		m_numPending = (U32)(length - consumed);
+		if (m_numPending > 0) {
+			memcpy(m_pending, &(src[consumed]), m_numPending);
+		}
+		return written + decoded;
+	}
+
+} // namespace Cat
@@ -0,0 +1,38 @@
+#include "core/sys/cpu.h"
+
+namespace Cat {
+
+	BitField32 Cpu::features() {
+		/* Function static, so initialised exactly once, on first use */
+		static const BitField32 s_features = detectFeatures();
+		return s_features;
+	}
+
+	BitField32 Cpu::detectFeatures() {
+		BitField32 flags = 0;
+#if defined (CAT_SIMD_SSE2)
+		flags |= kSSE2;
+#if defined (__GNUC__)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("sse4.1")) {
+			flags |= kSSE41;
+		}
+		if (__builtin_cpu_supports("avx2")) {
+			flags |= kAVX2;
+		}
+		if (__builtin_cpu_supports("fma")) {
+			flags |= kFMA;
+		}
+		if (__builtin_cpu_supports("f16c")) {
+			flags |= kF16C;
+		}
+#endif
+#endif /* CAT_SIMD_SSE2 */
+#if defined (CAT_SIMD_NEON)
+		flags |= kNEON;
+#endif
+		DMSG("Detected CPU features: 0x" << std::hex << flags << std::dec);
+		return flags;
+	}
+
+} // namespace Cat
@@ -32,8 +32,9 @@ namespace Cat {
 		AsyncTaskQueuedItem* task = first_;
 		while(task) {
 			first_ = first_->next;
+			Boolean destroyable = task->task->isDestroyable();
 			task->task->onCompletion();
-			if (task->task->isDestroyable()) {
+			if (destroyable) {
 				task->task->destroy();
 				delete task->task;
 			}
@@ -76,6 +77,14 @@ namespace Cat {
 	 * @return The AsyncResult associated with the AsyncTask we're running.
 	 */
 	AsyncResult* AsyncTaskRunner::run(AsyncTask* task) {
+		/* A destroyable task may be run and deleted as soon as it is queued */
+		AsyncResult* result = task->getResult();
+		queue(task);
+		return result;
+	}
+
+	Boolean AsyncTaskRunner::queue(AsyncTask* task) {
+		Boolean queued = false;
 		sync_controller_->lock();
 		if (state_ == RUNNER_STARTED) {
 			if (!last_) {
@@ -86,9 +95,10 @@ namespace Cat {
 			}
 			// Signal a thread to wakeup if there is one to wakeup.
 			sync_controller_->signal();
+			queued = true;
 		}
 		sync_controller_->unlock();
-		return task->getResult();
+		return queued;
 	}
 
 	/**
@@ -138,6 +148,7 @@ namespace Cat {
 	I32 AsyncTaskRunnerThread::run() {
 		AsyncTask* task = NIL;
 		I32 retVal = 0;
+		Boolean destroyable = false;
 
 		D(std::cout << "AsyncTaskRunner[" << id_ << "] STARTED..." << std::endl << std::flush);
 
@@ -159,8 +170,10 @@ namespace Cat {
 #if defined (DEBUG)
 			DMSG("Async Task finished with return value: " << retVal << ".");
 #endif
+			/* The task may be freed by its owner once onCompletion() is called, so do not touch it after */
+			destroyable = task->isDestroyable();
 			task->onCompletion();
-			if (task->isDestroyable()) {
+			if (destroyable) {
 				task->destroy();
 				delete task;
 			}
@@ -168,8 +181,9 @@ namespace Cat {
 			D(std::cout << "AsyncTask[" << id_ << "] now FINISHED task." << std::endl << std::flush);
 		}
 		if (task) {
+			destroyable = task->isDestroyable();
 			task->onCompletion();
-			if (task->isDestroyable()) {
+			if (destroyable) {
 				task->destroy();
 				delete task;
 			}
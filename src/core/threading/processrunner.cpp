@@ -8,8 +8,8 @@ namespace Cat {
 
 	ProcessRunner::ProcessRunner(const Char* name, Size queueSize) {
 		m_state = kPMSNotStarted;		
-		m_pName = copy(name);
-		m_oid = crc32(name);		
+		m_name = InternedString(name);
+		m_oid = m_name.oID();		
 		m_inputQueue.initWithCapacity(queueSize, ProcessPtr::nullPtr());
 		m_messageQueue.initWithCapacity((U32)(queueSize * 1.5), PMMessage());
 
@@ -29,7 +29,7 @@ namespace Cat {
 	}
 
 	ProcessRunner::~ProcessRunner() {
-		if (m_pName) { /* Must have been initialzed */			
+		if (!m_name.isNull()) { /* Must have been initialzed */			
 			terminateProcessRunner();
 			waitForTermination();
 			m_index.clear();
@@ -45,11 +45,8 @@ namespace Cat {
 				delete[] m_pNodeStorage;
 				m_pNodeStorage = NIL;
 			}
-			
-			if (m_pName) {
-				free(m_pName);
-				m_pName = NIL;
-			}
+
+			m_name = InternedString();
 		}			
 	}
 
@@ -8,8 +8,8 @@ namespace Cat {
 
 	TaskRunner::TaskRunner(const Char* name, Size queueSize) {
 		m_state = kTRSNotStarted;		
-		m_pName = copy(name);
-		m_oid = crc32(name);		
+		m_name = InternedString(name);
+		m_oid = m_name.oID();		
 		m_inputQueue.initWithCapacity(queueSize, TaskPtr::nullPtr());
 		m_messageQueue.initWithCapacity((U32)(queueSize), TRMessage());
 
@@ -25,7 +25,7 @@ namespace Cat {
 	}
 
 	TaskRunner::~TaskRunner() {
-		if (m_pName) { /* Must have been initialzed */			
+		if (!m_name.isNull()) { /* Must have been initialzed */			
 			terminateTaskRunner();
 			waitForTermination();
 			m_messageQueue.clear();
@@ -40,11 +40,8 @@ namespace Cat {
 				delete[] m_pNodeStorage;
 				m_pNodeStorage = NIL;
 			}
-			
-			if (m_pName) {
-				free(m_pName);
-				m_pName = NIL;
-			}
+
+			m_name = InternedString();
 		}			
 	}
 
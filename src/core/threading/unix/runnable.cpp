@@ -61,7 +61,7 @@ namespace Cat {
 }
 
 #ifdef DEBUG
-std::ostream& operator<<(std::ostream& out, cc::Runnable* runnable) {
+std::ostream& operator<<(std::ostream& out, Cat::Runnable* runnable) {
 	char* str = runnable->getInfo();
 	out << "IRunnable[" << str << "]";
 	free(str);
@@ -16,19 +16,21 @@ namespace Cat {
 		'u', 'v', 'w', 'x', 'y', 'z', 
 	};
 
-	NameGenerator::NameGenerator(const NameGenerator& src) {
-		m_pPrefix = StringUtils::copy(src.m_pPrefix);
+	NameGenerator::NameGenerator(const NameGenerator& src)
+		: m_count(src.m_count.val()) {
+		m_pPrefix = src.m_pPrefix ? StringUtils::copy(src.m_pPrefix) : NIL;
 		m_prefixLength = src.m_prefixLength;
 		m_maxLength = src.m_maxLength;
-		m_count = src.m_count;
+		m_prefixOID = src.m_prefixOID;
 	}
 
 	NameGenerator& NameGenerator::operator=(const NameGenerator& src) {
 		m_pPrefix = StringUtils::free(m_pPrefix);
-		m_pPrefix = StringUtils::copy(src.m_pPrefix);		
+		m_pPrefix = src.m_pPrefix ? StringUtils::copy(src.m_pPrefix) : NIL;		
 		m_prefixLength = src.m_prefixLength;
 		m_maxLength = src.m_maxLength;
-		m_count = src.m_count;
+		m_prefixOID = src.m_prefixOID;
+		m_count = AtomicU64(src.m_count.val());
 		return *this;		
 	}		
 
@@ -40,8 +42,10 @@ namespace Cat {
 		if (!m_pPrefix) {
 			m_pPrefix = StringUtils::copy(prefix);
 			m_prefixLength = StringUtils::length(prefix);	
-			m_maxLength = m_prefixLength + CC_MAX_GENERATED_NAME_NUMBER_LENGTH + 2;
-			m_count = 0;
+			m_maxLength = m_prefixLength + CAT_MAX_GENERATED_NAME_NUMBER_LENGTH + 2;
+			/* The '=' is part of every name, so is part of the cached hash */
+			m_prefixOID = crc32(crc32(prefix, m_prefixLength), "=", 1);
+			m_count = AtomicU64(0);
 		}
 		else {
 			DWARN("Cannot initialize NameGenerator already initialized w/ prefix: "
@@ -51,34 +55,32 @@ namespace Cat {
 
 	Char* NameGenerator::generate() {
 		Char* str = new Char[m_maxLength];
-		memcpy(str, m_pPrefix, sizeof(Char)*m_prefixLength);
-
-		U64 val;		
-		m_lock.lock();
-		val = ++m_count;
-		m_lock.unlock();
-
-		str[m_prefixLength] = '=';		
-		str[m_prefixLength+1] = encodingTable[(val & 0x3F)];
-		str[m_prefixLength+2] = encodingTable[((val >> 6) & 0x3F)];
-		str[m_prefixLength+3] = encodingTable[((val >> 12) & 0x3F)];
-		str[m_prefixLength+4] = encodingTable[((val >> 18) & 0x3F)];
-		str[m_prefixLength+5] = encodingTable[((val >> 24) & 0x3F)];
-		str[m_prefixLength+6] = encodingTable[((val >> 30) & 0x3F)];
-		str[m_prefixLength+7] = encodingTable[((val >> 36) & 0x3F)];
-		str[m_prefixLength+8] = encodingTable[((val >> 42) & 0x3F)];
-		str[m_prefixLength+9] = encodingTable[((val >> 48) & 0x3F)];
-		str[m_prefixLength+10] = encodingTable[((val >> 54) & 0x3F)];
-		str[m_prefixLength+11] = encodingTable[((val >> 60) & 0x3F)];
-		str[m_prefixLength+12] = '\0';
-
+		generate(str);
 		return str;				
    }
-	
-	
-		
-	
-		
-		
+
+	InternedString NameGenerator::generateInterned() {
+		Char buffer[256];
+		if (m_maxLength <= 256) {
+			Size length = generate(buffer);
+			return StringInterner::intern(buffer, length);
+		}
+		Char* str = generate();
+		InternedString name = StringInterner::intern(str);
+		delete[] str;
+		return name;
+	}
+
+	Size NameGenerator::encode(Char* str, U64 val) const {
+		memcpy(str, m_pPrefix, sizeof(Char)*m_prefixLength);
+		str += m_prefixLength;
+		str[0] = '=';		
+		for (U32 i = 1; i <= CAT_MAX_GENERATED_NAME_NUMBER_LENGTH; ++i) {
+			str[i] = encodingTable[val & 0x3F];
+			val >>= 6;
+		}
+		str[CAT_MAX_GENERATED_NAME_NUMBER_LENGTH + 1] = '\0';
+		return m_prefixLength + CAT_MAX_GENERATED_NAME_NUMBER_LENGTH + 1;
+	}
 
 } // namespace Cat
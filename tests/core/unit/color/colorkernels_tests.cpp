@@ -0,0 +1,257 @@
+#include <cstring>
+#include "core/testcore.h"
+#include "core/color/colorkernels.h"
+
+namespace cc {
+
+	static U32 s_seed = 2468;
+
+	static U32 nextRandom() {
+		s_seed = s_seed*1103515245 + 12345;
+		return s_seed >> 8;
+	}
+
+	static void randomBytes(Color4b* colors, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			U32 r = nextRandom();
+			colors[i].set((UByte)r, (UByte)(r >> 8), (UByte)(r >> 16), (UByte)nextRandom());
+		}
+	}
+
+	/* Mostly in [0 - 1], with some values outside to test the clamping */
+	static Real randomReal() {
+		return (Real)((I32)(nextRandom() % 12000) - 1000) / REAL(10000.0);
+	}
+
+	static void randomFloats(Color4f* colors, Size count) {
+		for (Size i = 0; i < count; ++i) {
+			colors[i].set(randomReal(), randomReal(), randomReal(), randomReal());
+		}
+		/* And some alphas of exactly 0 and 1 */
+		colors[0].a = REAL(0.0);
+		colors[count/2].a = REAL(1.0);
+	}
+
+	static Boolean sameColor(const Color4b& a, const Color4b& b) {
+		return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+	}
+
+	static Boolean sameColor(const Color4f& a, const Color4f& b) {
+		return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+	}
+
+	static const Size kCount = 103;
+
+	/* Every table the CPU runs gives the same results as the scalar one */
+	static void checkPackUnpack(const ColorKernels::Table& fast) {
+		const ColorKernels::Table& scalar = ColorKernels::scalarTable();
+		Color4b bytes[kCount];
+		Color4b fastBytes[kCount];
+		Color4b scalarBytes[kCount];
+		Color4f floats[kCount];
+		Color4f fastFloats[kCount];
+		Color4f scalarFloats[kCount];
+
+		DMSG("Checking the " << fast.name << " kernels.");
+		randomBytes(bytes, kCount);
+		fast.unpack(bytes, fastFloats, kCount);
+		scalar.unpack(bytes, scalarFloats, kCount);
+		ass_true(memcmp(fastFloats, scalarFloats, sizeof(fastFloats)) == 0);
+		fast.pack(fastFloats, fastBytes, kCount);
+		ass_true(memcmp(fastBytes, bytes, sizeof(bytes)) == 0);
+
+		randomFloats(floats, kCount);
+		fast.pack(floats, fastBytes, kCount);
+		scalar.pack(floats, scalarBytes, kCount);
+		ass_true(memcmp(fastBytes, scalarBytes, sizeof(fastBytes)) == 0);
+	}
+
+	static void checkSrgb(const ColorKernels::Table& fast) {
+		const ColorKernels::Table& scalar = ColorKernels::scalarTable();
+
+		/* Every 8 bit value survives a round trip */
+		DMSG("Checking the " << fast.name << " kernels.");
+		Color4b all[256];
+		for (I32 i = 0; i < 256; ++i) {
+			all[i].set((UByte)i, (UByte)(255 - i), (UByte)i, (UByte)i);
+		}
+		Color4f linear[256];
+		Color4f scalarLinear[256];
+		fast.srgbToLinear(all, linear, 256);
+		scalar.srgbToLinear(all, scalarLinear, 256);
+		ass_true(memcmp(linear, scalarLinear, sizeof(linear)) == 0);
+		ass_eq(linear[0].r, REAL(0.0));
+		ass_eq(linear[255].r, REAL(1.0));
+		ass_true(linear[128].r > REAL(0.21) && linear[128].r < REAL(0.22));
+		ass_eq(linear[128].a, REAL(128.0) / REAL(255.0));
+
+		Color4b back[256];
+		fast.linearToSrgb(linear, back, 256);
+		ass_true(memcmp(back, all, sizeof(all)) == 0);
+
+		Color4f floats[kCount];
+		Color4b fastBytes[kCount];
+		Color4b scalarBytes[kCount];
+		randomFloats(floats, kCount);
+		fast.linearToSrgb(floats, fastBytes, kCount);
+		scalar.linearToSrgb(floats, scalarBytes, kCount);
+		ass_true(memcmp(fastBytes, scalarBytes, sizeof(fastBytes)) == 0);
+	}
+
+	static void checkPremultiply(const ColorKernels::Table& fast) {
+		const ColorKernels::Table& scalar = ColorKernels::scalarTable();
+		Color4f floats[kCount];
+		Color4f fastFloats[kCount];
+		Color4f scalarFloats[kCount];
+		DMSG("Checking the " << fast.name << " kernels.");
+		randomFloats(floats, kCount);
+
+		fast.premultiply(floats, fastFloats, kCount);
+		scalar.premultiply(floats, scalarFloats, kCount);
+		ass_true(memcmp(fastFloats, scalarFloats, sizeof(fastFloats)) == 0);
+		ass_eq(fastFloats[0].r, REAL(0.0));
+		ass_eq(fastFloats[kCount/2].g, floats[kCount/2].g);
+
+		fast.unpremultiply(fastFloats, fastFloats, kCount);
+		scalar.unpremultiply(scalarFloats, scalarFloats, kCount);
+		ass_true(memcmp(fastFloats, scalarFloats, sizeof(fastFloats)) == 0);
+		ass_eq(fastFloats[0].g, REAL(0.0));
+
+		Color4b bytes[kCount];
+		Color4b fastBytes[kCount];
+		Color4b scalarBytes[kCount];
+		randomBytes(bytes, kCount);
+		fast.premultiplyBytes(bytes, fastBytes, kCount);
+		scalar.premultiplyBytes(bytes, scalarBytes, kCount);
+		ass_true(memcmp(fastBytes, scalarBytes, sizeof(fastBytes)) == 0);
+		for (Size i = 0; i < kCount; ++i) {
+			ass_eq(fastBytes[i].r, (bytes[i].r*bytes[i].a + 127) / 255);
+			ass_eq(fastBytes[i].a, bytes[i].a);
+		}
+	}
+
+	static void checkBlend(const ColorKernels::Table& fast) {
+		const ColorKernels::Table& scalar = ColorKernels::scalarTable();
+		Color4f src[kCount];
+		Color4f dst[kCount];
+		Color4f fastDst[kCount];
+		Color4f scalarDst[kCount];
+		DMSG("Checking the " << fast.name << " kernels.");
+		randomFloats(src, kCount);
+		randomFloats(dst, kCount);
+
+		for (I32 mode = 0; mode < ColorKernels::kNumBlendModes; ++mode) {
+			memcpy(fastDst, dst, sizeof(dst));
+			memcpy(scalarDst, dst, sizeof(dst));
+			fast.blend(src, fastDst, kCount, (ColorKernels::BlendMode)mode);
+			scalar.blend(src, scalarDst, kCount, (ColorKernels::BlendMode)mode);
+			ass_true(memcmp(fastDst, scalarDst, sizeof(fastDst)) == 0);
+		}
+
+		Color4b bsrc[kCount];
+		Color4b bdst[kCount];
+		Color4b fastBytes[kCount];
+		Color4b scalarBytes[kCount];
+		randomBytes(bsrc, kCount);
+		randomBytes(bdst, kCount);
+		scalar.premultiplyBytes(bsrc, bsrc, kCount);
+		memcpy(fastBytes, bdst, sizeof(bdst));
+		memcpy(scalarBytes, bdst, sizeof(bdst));
+		fast.blendOverBytes(bsrc, fastBytes, kCount);
+		scalar.blendOverBytes(bsrc, scalarBytes, kCount);
+		ass_true(memcmp(fastBytes, scalarBytes, sizeof(fastBytes)) == 0);
+	}
+
+	void testColorKernelsPackUnpack() {
+		BEGIN_TEST;
+
+		const ColorKernels::Table* tables[ColorKernels::kMaxTables];
+		Size numTables = ColorKernels::supportedTables(tables);
+		ass_true(tables[0] == &ColorKernels::table());
+		ass_true(tables[numTables - 1] == &ColorKernels::scalarTable());
+		for (Size t = 0; t < numTables; ++t) {
+			checkPackUnpack(*tables[t]);
+		}
+
+		Color4f known[2];
+		known[0].set(REAL(1.0), REAL(0.0), REAL(-0.5), REAL(1.5));
+		known[1].set(REAL(0.5), REAL(0.2), REAL(0.998), REAL(0.001));
+		Color4b packed[2];
+		ColorKernels::pack(known, packed, 2);
+		ass_true(sameColor(packed[0], Color4b(255, 0, 0, 255)));
+		ass_true(sameColor(packed[1], Color4b(128, 51, 254, 0)));
+
+		PackedColorVal val = PackedColor::fromRGBA((UByte)255, (UByte)0, (UByte)51, (UByte)128);
+		Color4f unpacked;
+		ColorKernels::unpack(&val, &unpacked, 1);
+		ass_eq(unpacked.r, REAL(1.0));
+		ass_eq(unpacked.g, REAL(0.0));
+		ass_eq(unpacked.b, REAL(0.2));
+		ass_eq(unpacked.a, REAL(128.0) / REAL(255.0));
+
+		FINISH_TEST;
+	}
+
+	void testColorKernelsSrgb() {
+		BEGIN_TEST;
+
+		const ColorKernels::Table* tables[ColorKernels::kMaxTables];
+		Size numTables = ColorKernels::supportedTables(tables);
+		for (Size t = 0; t < numTables; ++t) {
+			checkSrgb(*tables[t]);
+		}
+
+		FINISH_TEST;
+	}
+
+	void testColorKernelsPremultiply() {
+		BEGIN_TEST;
+
+		const ColorKernels::Table* tables[ColorKernels::kMaxTables];
+		Size numTables = ColorKernels::supportedTables(tables);
+		for (Size t = 0; t < numTables; ++t) {
+			checkPremultiply(*tables[t]);
+		}
+
+		FINISH_TEST;
+	}
+
+	void testColorKernelsBlend() {
+		BEGIN_TEST;
+
+		const ColorKernels::Table* tables[ColorKernels::kMaxTables];
+		Size numTables = ColorKernels::supportedTables(tables);
+		for (Size t = 0; t < numTables; ++t) {
+			checkBlend(*tables[t]);
+		}
+
+		Color4f s(REAL(0.5), REAL(0.0), REAL(0.0), REAL(0.5));
+		Color4f d(REAL(0.0), REAL(0.0), REAL(1.0), REAL(1.0));
+		ColorKernels::blend(&s, &d, 1);
+		ass_true(sameColor(d, Color4f(REAL(0.5), REAL(0.0), REAL(0.5), REAL(1.0))));
+		d.set(REAL(0.0), REAL(0.0), REAL(1.0), REAL(1.0));
+		ColorKernels::blend(&s, &d, 1, ColorKernels::kSrcIn);
+		ass_true(sameColor(d, s));
+		ColorKernels::blend(&s, &d, 1, ColorKernels::kClear);
+		ass_true(sameColor(d, Color4f(0, 0, 0, 0)));
+
+		Color4b opaque(10, 20, 30, 255);
+		Color4b under(200, 100, 50, 255);
+		ColorKernels::blendOver(&opaque, &under, 1);
+		ass_true(sameColor(under, opaque));
+		Color4b clear(0, 0, 0, 0);
+		ColorKernels::blendOver(&clear, &under, 1);
+		ass_true(sameColor(under, opaque));
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testColorKernelsPackUnpack();
+	cc::testColorKernelsSrgb();
+	cc::testColorKernelsPremultiply();
+	cc::testColorKernelsBlend();
+	return 0;
+}
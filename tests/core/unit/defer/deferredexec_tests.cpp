@@ -0,0 +1,187 @@
+#include "core/testcore.h"
+#include "core/defer/deferredexec.h"
+#include "core/defer/messagehandler.h"
+#include "core/threading/thread.h"
+#include "core/threading/asynctaskrunner.h"
+
+namespace cc {
+
+	class CallRecorder {
+	  public:
+		CallRecorder() : m_count(0), m_inOrder(true), m_onCaller(true) {
+			m_caller = Thread::self();
+		}
+
+		static void record(void* obj, IntegralType data) {
+			CallRecorder* recorder = reinterpret_cast<CallRecorder*>(obj);
+			if (recorder->m_count > 0 && data.i32 < recorder->m_last) {
+				recorder->m_inOrder = false;
+			}
+			if (!equals(recorder->m_caller, Thread::self())) {
+				recorder->m_onCaller = false;
+			}
+			recorder->m_last = data.i32;
+			recorder->m_count++;
+		}
+
+		U32 m_count;
+		I32 m_last;
+		Boolean m_inOrder;
+		Boolean m_onCaller;
+		ThreadHandle m_caller;
+	};
+
+	DeferredExecCall makeCall(CallRecorder* recorder, I32 val, U32 group = 0) {
+		IntegralType data;
+		data.i64 = 0;
+		data.i32 = val;
+		return DeferredExecCall(&CallRecorder::record, recorder, data, group);
+	}
+
+	void testDeferredExecExecuteCalls() {
+		BEGIN_TEST;
+
+		DeferredExec* exec = new DeferredExec(16);
+		CallRecorder recorder;
+		Boolean posted;
+		for (I32 i = 0; i < 16; ++i) {
+			posted = exec->postCall(makeCall(&recorder, i));
+			ass_true(posted);
+		}
+		posted = exec->postCall(makeCall(&recorder, 16));
+		ass_false(posted);
+		ass_eq(recorder.m_count, 0);
+
+		exec->executeCalls();
+		ass_eq(recorder.m_count, 16);
+		ass_eq(recorder.m_last, 15);
+		ass_true(recorder.m_inOrder);
+		exec->executeCalls();
+		ass_eq(recorder.m_count, 16);
+
+		delete exec;
+		FINISH_TEST;
+	}
+
+	void testDeferredExecGroupOutOfRange() {
+		BEGIN_TEST;
+
+		CallRecorder recorder;
+		DeferredExecCall call = makeCall(&recorder, 0, HandlerGroups::kMaxGroups - 1);
+		ass_eq(call.group(), HandlerGroups::kMaxGroups - 1);
+		call = makeCall(&recorder, 0, HandlerGroups::kMaxGroups);
+		ass_eq(call.group(), 0);
+		call = makeCall(&recorder, 0, 100);
+		ass_eq(call.group(), 0);
+
+		MessageHandler handler;
+		handler.setGroup(HandlerGroups::kMaxGroups - 1);
+		ass_eq(handler.group(), HandlerGroups::kMaxGroups - 1);
+		handler.setGroup(HandlerGroups::kMaxGroups);
+		ass_eq(handler.group(), 0);
+
+		FINISH_TEST;
+	}
+
+	void testDeferredExecParallelDispatch() {
+		BEGIN_TEST;
+
+		AsyncTaskRunner* runner = new AsyncTaskRunner(2);
+		DeferredExec* exec = new DeferredExec(128);
+		exec->setParallelDispatch(runner);
+		exec->handlerGroups().declareIndependentGroup(1);
+		exec->handlerGroups().declareIndependentGroup(2);
+		ass_eq(exec->handlerGroups().numLanes(), 3);
+
+		CallRecorder caller;
+		CallRecorder one;
+		CallRecorder two;
+
+		/* Every lane is done when executeCalls() returns, each in posting order */
+		for (U32 run = 0; run < 10; ++run) {
+			for (U32 i = 0; i < 10; ++i) {
+				exec->postCall(makeCall(&one, run*10 + i, 1));
+				exec->postCall(makeCall(&two, run*10 + i, 2));
+				exec->postCall(makeCall(&caller, run*10 + i));
+				exec->postCall(makeCall(&caller, run*10 + i, 7));
+			}
+			exec->executeCalls();
+			ass_eq(one.m_count, (run + 1)*10);
+			ass_eq(two.m_count, (run + 1)*10);
+			ass_eq(caller.m_count, (run + 1)*20);
+		}
+		ass_true(one.m_inOrder);
+		ass_true(two.m_inOrder);
+		ass_true(caller.m_inOrder);
+		/* Group 0 and the undeclared groups always run on the executing thread */
+		ass_true(caller.m_onCaller);
+
+		delete runner;
+		delete exec;
+		FINISH_TEST;
+	}
+
+	void testDeferredExecDestroyAfterExecute() {
+		BEGIN_TEST;
+
+		/* The runner is finished with the lane tasks once executeCalls() returns */
+		AsyncTaskRunner* runner = new AsyncTaskRunner(2);
+		CallRecorder one;
+		CallRecorder two;
+		for (I32 run = 0; run < 50; ++run) {
+			DeferredExec* exec = new DeferredExec(16);
+			exec->setParallelDispatch(runner);
+			exec->handlerGroups().declareIndependentGroup(1);
+			exec->handlerGroups().declareIndependentGroup(2);
+			exec->postCall(makeCall(&one, run, 1));
+			exec->postCall(makeCall(&two, run, 2));
+			exec->executeCalls();
+			delete exec;
+		}
+		ass_eq(one.m_count, 50);
+		ass_eq(two.m_count, 50);
+
+		delete runner;
+		FINISH_TEST;
+	}
+
+	void testDeferredExecDispatchAfterStop() {
+		BEGIN_TEST;
+
+		/* A stopped runner takes no lanes, so they all run on the executing thread */
+		AsyncTaskRunner* runner = new AsyncTaskRunner(2);
+		DeferredExec* exec = new DeferredExec(16);
+		exec->setParallelDispatch(runner);
+		exec->handlerGroups().declareIndependentGroup(1);
+		exec->handlerGroups().declareIndependentGroup(2);
+		runner->stop();
+
+		CallRecorder one;
+		CallRecorder two;
+		for (I32 i = 0; i < 4; ++i) {
+			exec->postCall(makeCall(&one, i, 1));
+			exec->postCall(makeCall(&two, i, 2));
+		}
+		exec->executeCalls();
+		ass_eq(one.m_count, 4);
+		ass_eq(two.m_count, 4);
+		ass_true(one.m_inOrder);
+		ass_true(two.m_inOrder);
+		ass_true(one.m_onCaller);
+		ass_true(two.m_onCaller);
+
+		delete exec;
+		delete runner;
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testDeferredExecExecuteCalls();
+	cc::testDeferredExecGroupOutOfRange();
+	cc::testDeferredExecParallelDispatch();
+	cc::testDeferredExecDestroyAfterExecute();
+	cc::testDeferredExecDispatchAfterStop();
+	return 0;
+}
@@ -1,5 +1,7 @@
 #include "core/testcore.h"
 #include "core/defer/messagequeue.h"
+#include "core/threading/thread.h"
+#include "core/threading/asynctaskrunner.h"
 
 namespace cc {
 
@@ -60,7 +62,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 		
 		delete queue;		
@@ -78,7 +80,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 
 		queue->postMessage(Message(1));		
@@ -135,7 +137,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 
 		TestHandlerOne t1(3);		
@@ -255,7 +257,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 
 		TestHandlerOne t1(3);		
@@ -327,7 +329,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 
 		TestHandlerOne t1(3);		
@@ -481,7 +483,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 
 		TestHandlerOne t1(3);		
@@ -700,7 +702,7 @@ namespace cc {
 		ass_true(queue->messagesOne()->isEmpty());
 		ass_true(queue->messagesTwo()->isEmpty());
 		ass_eq(queue->messages(), queue->messagesOne());
-		ass_eq(queue->processing(), NIL);
+		ass_eq(queue->processing(), queue->messagesTwo());
 		ass_neq(queue->handlers(), NIL);
 
 		TestHandlerOne t1(3);
@@ -780,6 +782,715 @@ namespace cc {
 		FINISH_TEST;
 	}	
 
+	class SequenceChecker {
+	  public:
+		SequenceChecker() : m_numReceived(0), m_numOutOfOrder(0) {
+			for (U32 i = 0; i < 8; ++i) {
+				m_nextSeq[i] = 0;
+			}
+		}
+
+		static void check(VPtr obj, Byte* data) {
+			SequenceChecker* checker = reinterpret_cast<SequenceChecker*>(obj);
+			I32 producer = reinterpret_cast<I32*>(data)[0];
+			I32 seq = reinterpret_cast<I32*>(data)[1];
+			if (seq != checker->m_nextSeq[producer]) {
+				checker->m_numOutOfOrder++;
+			}
+			checker->m_nextSeq[producer] = seq + 1;
+			checker->m_order[checker->m_numReceived % 8] = producer;
+			checker->m_numReceived++;
+		}
+
+		I32 m_nextSeq[8];
+		I32 m_order[8];
+		U32 m_numReceived;
+		U32 m_numOutOfOrder;
+	};
+
+	struct ProducerArgs {
+		MessageQueue* queue;
+		I32 producer;
+		I32 numMessages;
+	};
+
+	I32 produceMessages(VPtr data) {
+		ProducerArgs* args = reinterpret_cast<ProducerArgs*>(data);
+		Byte msgData[16];
+		reinterpret_cast<I32*>(msgData)[0] = args->producer;
+		for (I32 seq = 0; seq < args->numMessages; ++seq) {
+			reinterpret_cast<I32*>(msgData)[1] = seq;
+			Message message(3, msgData);
+			/* The ring is full until the consumer catches up */
+			while (!args->queue->postMessage(message)) {
+				usleep(10);
+			}
+		}
+		args->queue->releaseProducer();
+		return 0;
+	}
+
+	void testMessageQueuePerThreadRings() {
+		BEGIN_TEST;
+
+		MessageQueue* queue = new MessageQueue(32, 10, MessageQueue::kMQFPerThreadRings, 4);
+		ass_eq(queue->flags(), MessageQueue::kMQFPerThreadRings);
+		ass_eq(queue->messages(), NIL);
+		ass_eq(queue->messagesOne()->capacity(), 0);
+		ass_eq(queue->numRings(), 0);
+
+		TestHandlerOne t1(3);
+		queue->registerMessageHandler(1, MessageHandler(&t1, &TestHandlerOne::setVal));
+		TestHandlerTwo t2(5, -903.4);
+		queue->registerMessageHandler(2, MessageHandler(&t2, &TestHandlerTwo::setVals));
+
+		Byte data1[16];
+		reinterpret_cast<I32*>(data1)[0] = 34;
+		Byte data2[16];
+		reinterpret_cast<I32*>(data2)[0] = 12;
+		reinterpret_cast<F64*>(&data2[sizeof(I32)])[0] = 66.77;
+		Boolean posted = queue->postMessage(Message(1, data1));
+		ass_true(posted);
+		posted = queue->postMessage(Message(2, data2));
+		ass_true(posted);
+		ass_eq(queue->numRings(), 1);
+		ass_eq(queue->ring(0)->available(), 2);
+		ass_eq(t1.val(), 3);
+		queue->processMessages();
+		ass_eq(queue->ring(0)->available(), 0);
+		ass_eq(t1.val(), 34);
+		ass_eq(t2.val1(), 12);
+		ass_eq(t2.val2(), 66.77);
+
+		/* The same thread keeps its ring, until it runs out of room */
+		for (U32 i = 0; i < 32; ++i) {
+			posted = queue->postMessage(Message(1, data1));
+			ass_true(posted);
+		}
+		posted = queue->postMessage(Message(1, data1));
+		ass_false(posted);
+		ass_eq(queue->numRings(), 1);
+		queue->processMessages();
+		posted = queue->postMessage(Message(1, data1));
+		ass_true(posted);
+		queue->processMessages();
+
+		/* Many producers at once, each drained in the order it posted */
+		SequenceChecker checker;
+		queue->registerMessageHandler(3, MessageHandler(&checker, &SequenceChecker::check));
+		const I32 kNumProducers = 4;
+		const I32 kNumMessages = 5000;
+		ProducerArgs args[kNumProducers];
+		RunnableFunc* producers[kNumProducers];
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			args[i].queue = queue;
+			args[i].producer = i;
+			args[i].numMessages = kNumMessages;
+			producers[i] = new RunnableFunc(produceMessages, &args[i]);
+		}
+		/* Hand the main thread's ring over to the producers */
+		queue->releaseProducer();
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			Thread::run(producers[i]);
+		}
+		while (checker.m_numReceived < (U32)(kNumProducers*kNumMessages)) {
+			queue->processMessages();
+		}
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			Thread::join(producers[i]->getThread());
+			delete producers[i];
+		}
+		ass_eq(checker.m_numReceived, kNumProducers*kNumMessages);
+		ass_eq(checker.m_numOutOfOrder, 0);
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			ass_eq(checker.m_nextSeq[i], kNumMessages);
+		}
+		ass_le(queue->numRings(), 4);
+
+		delete queue;
+		FINISH_TEST;
+	}
+
+	I32 postOneMessage(VPtr data) {
+		ProducerArgs* args = reinterpret_cast<ProducerArgs*>(data);
+		Byte msgData[16];
+		reinterpret_cast<I32*>(msgData)[0] = args->producer;
+		reinterpret_cast<I32*>(msgData)[1] = 0;
+		args->queue->postMessage(Message(3, msgData));
+		args->queue->releaseProducer();
+		return 0;
+	}
+
+	void postFromThread(MessageQueue* queue, I32 producer) {
+		ProducerArgs args;
+		args.queue = queue;
+		args.producer = producer;
+		args.numMessages = 1;
+		RunnableFunc runnable(postOneMessage, &args);
+		Thread::run(&runnable);
+		Thread::join(runnable.getThread());
+	}
+
+	void postOrdered(MessageQueue* queue) {
+		Byte msgData[16];
+		reinterpret_cast<I32*>(msgData)[0] = 0;
+		reinterpret_cast<I32*>(msgData)[1] = 0;
+		queue->postMessage(Message(3, msgData));
+		usleep(1000);
+		postFromThread(queue, 1);
+		usleep(1000);
+		reinterpret_cast<I32*>(msgData)[1] = 1;
+		queue->postMessage(Message(3, msgData));
+	}
+
+	void testMessageQueuePerThreadRingsOrderByTime() {
+		BEGIN_TEST;
+
+		/* Without ordering, each ring is drained in turn */
+		MessageQueue* queue = new MessageQueue(32, 10, MessageQueue::kMQFPerThreadRings, 4);
+		SequenceChecker unordered;
+		queue->registerMessageHandler(3, MessageHandler(&unordered, &SequenceChecker::check));
+		postOrdered(queue);
+		ass_eq(queue->numRings(), 2);
+		queue->processMessages();
+		ass_eq(unordered.m_numReceived, 3);
+		ass_eq(unordered.m_order[0], 0);
+		ass_eq(unordered.m_order[1], 0);
+		ass_eq(unordered.m_order[2], 1);
+		delete queue;
+
+		/* With ordering, the rings are merged by the time of their messages */
+		queue = new MessageQueue(32, 10,
+										 MessageQueue::kMQFPerThreadRings | MessageQueue::kMQFOrderByTime, 4);
+		SequenceChecker ordered;
+		queue->registerMessageHandler(3, MessageHandler(&ordered, &SequenceChecker::check));
+		postOrdered(queue);
+		queue->processMessages();
+		ass_eq(ordered.m_numReceived, 3);
+		ass_eq(ordered.m_numOutOfOrder, 0);
+		ass_eq(ordered.m_order[0], 0);
+		ass_eq(ordered.m_order[1], 1);
+		ass_eq(ordered.m_order[2], 0);
+
+		/* A released ring is claimed by the next thread to post */
+		postFromThread(queue, 2);
+		ass_eq(queue->numRings(), 2);
+		queue->processMessages();
+		ass_eq(ordered.m_numReceived, 4);
+		ass_eq(ordered.m_order[3], 2);
+
+		delete queue;
+		FINISH_TEST;
+	}
+
+	U32 num_producers_done = 0;
+
+	I32 produceMessagesAndCount(VPtr data) {
+		produceMessages(data);
+		__atomic_add_fetch(&num_producers_done, 1, __ATOMIC_RELEASE);
+		return 0;
+	}
+
+	void testMessageQueuePerThreadRingsHandoff() {
+		BEGIN_TEST;
+
+		/* Three waves of two producers share two rings, so each ring changes hands twice */
+		MessageQueue* queue = new MessageQueue(32, 10, MessageQueue::kMQFPerThreadRings, 2);
+		SequenceChecker checker;
+		queue->registerMessageHandler(3, MessageHandler(&checker, &SequenceChecker::check));
+		const I32 kNumWaves = 3;
+		const I32 kNumPerWave = 2;
+		const I32 kNumMessages = 2000;
+		ProducerArgs args[kNumWaves*kNumPerWave];
+		RunnableFunc* producers[kNumWaves*kNumPerWave];
+		for (I32 i = 0; i < kNumWaves*kNumPerWave; ++i) {
+			args[i].queue = queue;
+			args[i].producer = i;
+			args[i].numMessages = kNumMessages;
+			producers[i] = new RunnableFunc(produceMessagesAndCount, &args[i]);
+		}
+
+		/* The next wave claims the rings while the last one's messages are still in them */
+		I32 wave = 0;
+		for (I32 i = 0; i < kNumPerWave; ++i) {
+			Thread::run(producers[i]);
+		}
+		while (checker.m_numReceived < (U32)(kNumWaves*kNumPerWave*kNumMessages)) {
+			if (wave + 1 < kNumWaves &&
+				 __atomic_load_n(&num_producers_done, __ATOMIC_ACQUIRE) == (U32)((wave + 1)*kNumPerWave)) {
+				++wave;
+				for (I32 i = 0; i < kNumPerWave; ++i) {
+					Thread::run(producers[wave*kNumPerWave + i]);
+				}
+			}
+			queue->processMessages();
+		}
+		for (I32 i = 0; i < kNumWaves*kNumPerWave; ++i) {
+			Thread::join(producers[i]->getThread());
+			delete producers[i];
+		}
+		ass_eq(wave, kNumWaves - 1);
+		ass_eq(checker.m_numReceived, kNumWaves*kNumPerWave*kNumMessages);
+		ass_eq(checker.m_numOutOfOrder, 0);
+		for (I32 i = 0; i < kNumWaves*kNumPerWave; ++i) {
+			ass_eq(checker.m_nextSeq[i], kNumMessages);
+		}
+		ass_eq(queue->numRings(), 2);
+
+		delete queue;
+		FINISH_TEST;
+	}
+
+	struct BigPayload {
+		I32 producer;
+		I32 seq;
+		F64 values[12];
+
+		BigPayload(I32 p_producer, I32 p_seq) : producer(p_producer), seq(p_seq) {
+			for (U32 i = 0; i < 12; ++i) {
+				values[i] = p_seq*0.5 + i;
+			}
+		}
+	};
+
+	struct SmallPayload {
+		I32 producer;
+		I32 seq;
+		I32 check[2];
+
+		SmallPayload(I32 p_producer, I32 p_seq) : producer(p_producer), seq(p_seq) {
+			check[0] = ~p_seq;
+			check[1] = p_producer*7;
+		}
+	};
+
+	class PayloadChecker {
+	  public:
+		PayloadChecker() : m_numReceived(0), m_numCorrupt(0), m_numOutOfOrder(0) {
+			for (U32 i = 0; i < 8; ++i) {
+				m_nextSeq[i] = 0;
+			}
+		}
+
+		static void check(VPtr obj, Byte* data) {
+			PayloadChecker* checker = reinterpret_cast<PayloadChecker*>(obj);
+			BigPayload* payload = reinterpret_cast<BigPayload*>(data);
+			for (U32 i = 0; i < 12; ++i) {
+				if (payload->values[i] != payload->seq*0.5 + i) {
+					checker->m_numCorrupt++;
+					break;
+				}
+			}
+			if (payload->seq != checker->m_nextSeq[payload->producer]) {
+				checker->m_numOutOfOrder++;
+			}
+			checker->m_nextSeq[payload->producer] = payload->seq + 1;
+			checker->m_numReceived++;
+		}
+
+		static void checkSmall(VPtr obj, Byte* data) {
+			PayloadChecker* checker = reinterpret_cast<PayloadChecker*>(obj);
+			SmallPayload* payload = reinterpret_cast<SmallPayload*>(data);
+			if (payload->check[0] != ~payload->seq || payload->check[1] != payload->producer*7) {
+				checker->m_numCorrupt++;
+			}
+			if (payload->seq != checker->m_nextSeq[payload->producer]) {
+				checker->m_numOutOfOrder++;
+			}
+			checker->m_nextSeq[payload->producer] = payload->seq + 1;
+			checker->m_numReceived++;
+		}
+
+		I32 m_nextSeq[8];
+		U32 m_numReceived;
+		U32 m_numCorrupt;
+		U32 m_numOutOfOrder;
+	};
+
+	I32 producePayloads(VPtr data) {
+		ProducerArgs* args = reinterpret_cast<ProducerArgs*>(data);
+		for (I32 seq = 0; seq < args->numMessages; ++seq) {
+			/* The ring is full until the consumer catches up */
+			while (!args->queue->post<BigPayload>(5, NIL, args->producer, seq)) {
+				usleep(10);
+			}
+		}
+		args->queue->releaseProducer();
+		return 0;
+	}
+
+	void testMessageQueuePostPayload() {
+		BEGIN_TEST;
+
+		/* Without an arena, there is nowhere to put a payload */
+		MessageQueue* queue = new MessageQueue(32, 10);
+		ass_eq(queue->arena(0)->capacity(), 0);
+		Boolean posted = queue->post<BigPayload>(5, NIL, 0, 0);
+		ass_false(posted);
+		ass_true(queue->messagesOne()->isEmpty());
+		delete queue;
+
+		queue = new MessageQueue(32, 10, MessageQueue::kMQFNone, 16, 1024);
+		ass_eq(queue->arena(0)->capacity(), 1024);
+		ass_eq(queue->arena(1)->capacity(), 1024);
+		PayloadChecker checker;
+		queue->registerMessageHandler(5, MessageHandler(&checker, &PayloadChecker::check));
+
+		posted = queue->post<BigPayload>(5, NIL, 0, 0);
+		ass_true(posted);
+		ass_eq(queue->arena(0)->used(), 112);
+		ass_eq(queue->messagesOne()->peek().dataSize(), sizeof(BigPayload));
+		ass_true(queue->messagesOne()->peek().hasPayload());
+		queue->processMessages();
+		ass_eq(checker.m_numReceived, 1);
+		ass_eq(checker.m_numCorrupt, 0);
+		ass_eq(queue->arena(0)->used(), 0);
+		ass_eq(queue->currentArena(), 1);
+
+		/* Each arena holds nine payloads, and is reset once they are handled */
+		for (I32 seq = 1; seq < 10; ++seq) {
+			posted = queue->post<BigPayload>(5, NIL, 0, seq);
+			ass_true(posted);
+		}
+		posted = queue->post<BigPayload>(5, NIL, 0, 10);
+		ass_false(posted);
+		ass_eq(queue->arena(1)->used(), 1008);
+
+		/* Small messages are still copied, and mix with payloads */
+		Byte data[16];
+		reinterpret_cast<I32*>(data)[0] = 44;
+		TestHandlerOne t1(3);
+		queue->registerMessageHandler(1, MessageHandler(&t1, &TestHandlerOne::setVal));
+		queue->postMessage(Message(1, data));
+		queue->processMessages();
+		ass_eq(checker.m_numReceived, 10);
+		ass_eq(checker.m_numCorrupt, 0);
+		ass_eq(checker.m_numOutOfOrder, 0);
+		ass_eq(t1.val(), 44);
+		ass_eq(queue->arena(1)->used(), 0);
+		ass_eq(queue->currentArena(), 0);
+		delete queue;
+
+		/* Payloads posted from many threads at once survive until they are handled */
+		queue = new MessageQueue(256, 10, MessageQueue::kMQFPerThreadRings, 4, 256*1024);
+		PayloadChecker threaded;
+		queue->registerMessageHandler(5, MessageHandler(&threaded, &PayloadChecker::check));
+		const I32 kNumProducers = 4;
+		const I32 kNumMessages = 5000;
+		ProducerArgs args[kNumProducers];
+		RunnableFunc* producers[kNumProducers];
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			args[i].queue = queue;
+			args[i].producer = i;
+			args[i].numMessages = kNumMessages;
+			producers[i] = new RunnableFunc(producePayloads, &args[i]);
+			Thread::run(producers[i]);
+		}
+		while (threaded.m_numReceived < (U32)(kNumProducers*kNumMessages)) {
+			queue->processMessages();
+		}
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			Thread::join(producers[i]->getThread());
+			delete producers[i];
+		}
+		ass_eq(threaded.m_numReceived, kNumProducers*kNumMessages);
+		ass_eq(threaded.m_numCorrupt, 0);
+		ass_eq(threaded.m_numOutOfOrder, 0);
+		queue->processMessages();
+		ass_eq(queue->arena(0)->used(), 0);
+		ass_eq(queue->arena(1)->used(), 0);
+
+		delete queue;
+		FINISH_TEST;
+	}
+
+	I32 produceMixedPayloads(VPtr data) {
+		ProducerArgs* args = reinterpret_cast<ProducerArgs*>(data);
+		for (I32 seq = 0; seq < args->numMessages; ++seq) {
+			/* The arena is full until the consumer swaps it out */
+			if (seq % 3 == 0) {
+				while (!args->queue->post<BigPayload>(5, NIL, args->producer, seq)) {
+					usleep(10);
+				}
+			} else {
+				while (!args->queue->post<SmallPayload>(6, NIL, args->producer, seq)) {
+					usleep(10);
+				}
+			}
+		}
+		args->queue->releaseProducer();
+		return 0;
+	}
+
+	void testMessageQueuePostPayloadNearFull() {
+		BEGIN_TEST;
+
+		/* An arena holds under ten big payloads, so posts of both sizes keep failing and succeeding at once */
+		MessageQueue* queue = new MessageQueue(256, 10, MessageQueue::kMQFPerThreadRings, 4, 1024);
+		PayloadChecker checker;
+		queue->registerMessageHandler(5, MessageHandler(&checker, &PayloadChecker::check));
+		queue->registerMessageHandler(6, MessageHandler(&checker, &PayloadChecker::checkSmall));
+		const I32 kNumProducers = 4;
+		const I32 kNumMessages = 3000;
+		ProducerArgs args[kNumProducers];
+		RunnableFunc* producers[kNumProducers];
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			args[i].queue = queue;
+			args[i].producer = i;
+			args[i].numMessages = kNumMessages;
+			producers[i] = new RunnableFunc(produceMixedPayloads, &args[i]);
+			Thread::run(producers[i]);
+		}
+		while (checker.m_numReceived < (U32)(kNumProducers*kNumMessages)) {
+			queue->processMessages();
+			ass_le(queue->arena(0)->used(), queue->arena(0)->capacity());
+			ass_le(queue->arena(1)->used(), queue->arena(1)->capacity());
+			usleep(50);
+		}
+		for (I32 i = 0; i < kNumProducers; ++i) {
+			Thread::join(producers[i]->getThread());
+			delete producers[i];
+		}
+
+		/* Overlapping blocks would have been overwritten by another producer before being handled */
+		ass_eq(checker.m_numReceived, kNumProducers*kNumMessages);
+		ass_eq(checker.m_numCorrupt, 0);
+		ass_eq(checker.m_numOutOfOrder, 0);
+
+		delete queue;
+		FINISH_TEST;
+	}
+
+	class BatchCounter {
+	  public:
+		BatchCounter() : m_numCalls(0), m_numMessages(0), m_lastCount(0), m_sum(0), m_inOrder(true) {}
+
+		static void handle(VPtr obj, Message* messages, Size count) {
+			BatchCounter* counter = reinterpret_cast<BatchCounter*>(obj);
+			counter->m_numCalls++;
+			counter->m_lastCount = count;
+			for (Size i = 0; i < count; ++i) {
+				I32 val = reinterpret_cast<I32*>(messages[i].readData())[0];
+				if (i > 0 && val < reinterpret_cast<I32*>(messages[i - 1].readData())[0]) {
+					counter->m_inOrder = false;
+				}
+				counter->m_sum += val;
+				counter->m_numMessages++;
+			}
+		}
+
+		U32 m_numCalls;
+		U32 m_numMessages;
+		Size m_lastCount;
+		I32 m_sum;
+		Boolean m_inOrder;
+	};
+
+	void testMessageQueueBatchHandlers() {
+		BEGIN_TEST;
+
+		MessageQueue* queue = new MessageQueue(32, 10);
+		BatchCounter batch;
+		TestHandlerOne t1(0);
+		TestHandlerOne fromT2(0);
+		TestHandlerTwo t2(0, 0.0);
+		queue->registerMessageHandler(3, MessageHandler(&batch, &BatchCounter::handle));
+		queue->registerMessageHandler(3, MessageHandler(&t1, &TestHandlerOne::setVal));
+		queue->registerMessageHandler(3, MessageHandler(&fromT2, &t2, &TestHandlerOne::setVal));
+		queue->registerMessageHandler(1, MessageHandler(&t2, &TestHandlerTwo::setVals));
+		ass_eq(queue->handlers()[3].size(), 3);
+		ass_true(queue->handlers()[3].hasBatchHandlers());
+		ass_false(queue->handlers()[1].hasBatchHandlers());
+
+		/* All the messages of a type reach the batch handler at once, in order */
+		Byte data[16];
+		for (I32 i = 1; i <= 5; ++i) {
+			reinterpret_cast<I32*>(data)[0] = i;
+			queue->postMessage(Message(3, (i == 4) ? &t2 : NIL, data));
+			queue->postMessage(Message(1, data));
+		}
+		queue->processMessages();
+		ass_eq(batch.m_numCalls, 1);
+		ass_eq(batch.m_lastCount, 5);
+		ass_eq(batch.m_sum, 15);
+		ass_true(batch.m_inOrder);
+		ass_eq(t1.val(), 5);
+		ass_eq(fromT2.val(), 4);
+		ass_eq(t2.val1(), 5);
+		ass_eq(queue->handlers()[3].numCollected(), 0);
+
+		/* Nothing posted, no batch */
+		queue->processMessages();
+		ass_eq(batch.m_numCalls, 1);
+
+		/* Triggering hands over a batch of one */
+		reinterpret_cast<I32*>(data)[0] = 10;
+		queue->triggerMessage(Message(3, data));
+		ass_eq(batch.m_numCalls, 2);
+		ass_eq(batch.m_lastCount, 1);
+		ass_eq(batch.m_sum, 25);
+		ass_eq(t1.val(), 10);
+
+		/* A removed batch handler gets nothing, even before the removal is processed */
+		queue->removeMessageHandler(3, MessageHandler(&batch, &BatchCounter::handle));
+		queue->postMessage(Message(3, data));
+		queue->processMessages();
+		ass_eq(batch.m_numCalls, 2);
+		ass_eq(queue->handlers()[3].size(), 2);
+		ass_false(queue->handlers()[3].hasBatchHandlers());
+
+		delete queue;
+		FINISH_TEST;
+	}
+
+
+	class GroupRecorder {
+	  public:
+		GroupRecorder() : m_count(0), m_inOrder(true), m_onCaller(true) {
+			m_caller = Thread::self();
+		}
+
+		static void record(VPtr obj, Byte* data) {
+			GroupRecorder* recorder = reinterpret_cast<GroupRecorder*>(obj);
+			recorder->add(reinterpret_cast<I32*>(data)[0]);
+		}
+
+		static void recordBatch(VPtr obj, Message* messages, Size count) {
+			GroupRecorder* recorder = reinterpret_cast<GroupRecorder*>(obj);
+			for (Size i = 0; i < count; ++i) {
+				recorder->add(reinterpret_cast<I32*>(messages[i].readData())[0]);
+			}
+		}
+
+		void add(I32 val) {
+			if (m_count > 0 && val < m_last) {
+				m_inOrder = false;
+			}
+			if (!equals(m_caller, Thread::self())) {
+				m_onCaller = false;
+			}
+			m_last = val;
+			m_count++;
+		}
+
+		U32 m_count;
+		I32 m_last;
+		Boolean m_inOrder;
+		Boolean m_onCaller;
+		ThreadHandle m_caller;
+	};
+
+	void testMessageQueueParallelDispatch() {
+		BEGIN_TEST;
+
+		/* Conflicting groups share a lane, independent ones get their own,
+		 * undeclared ones run with group 0 */
+		HandlerGroups groups;
+		ass_eq(groups.numLanes(), 1);
+		ass_eq(groups.laneMask(0), HandlerGroups::kAllGroups);
+		groups.declareGroup(1, 0x1, 0x2);
+		groups.declareGroup(2, 0x2, 0x0);
+		groups.declareGroup(3, 0x8, 0x0);
+		groups.declareGroup(4, 0x0, 0x8);
+		groups.declareIndependentGroup(5);
+		ass_eq(groups.numLanes(), 4);
+		U32 mask = groups.laneMask(1);
+		ass_eq(mask, 0x6U);
+		mask = groups.laneMask(2);
+		ass_eq(mask, 0x18U);
+		mask = groups.laneMask(3);
+		ass_eq(mask, 0x20U);
+		mask = groups.laneMask(0);
+		ass_eq(mask, ~0x3EU);
+		groups.reset();
+		ass_eq(groups.numLanes(), 1);
+
+		AsyncTaskRunner* runner = new AsyncTaskRunner(2);
+		MessageQueue* queue = new MessageQueue(128, 10);
+		queue->setParallelDispatch(runner);
+		queue->handlerGroups().declareIndependentGroup(1);
+		queue->handlerGroups().declareIndependentGroup(2);
+
+		GroupRecorder caller;
+		GroupRecorder one;
+		GroupRecorder two;
+		GroupRecorder twoBatch;
+		MessageHandler handler(&one, &GroupRecorder::record);
+		handler.setGroup(1);
+		queue->registerMessageHandler(3, handler);
+		handler = MessageHandler(&two, &GroupRecorder::record);
+		handler.setGroup(2);
+		queue->registerMessageHandler(4, handler);
+		handler = MessageHandler(&twoBatch, &GroupRecorder::recordBatch);
+		handler.setGroup(2);
+		queue->registerMessageHandler(4, handler);
+		queue->registerMessageHandler(3, MessageHandler(&caller, &GroupRecorder::record));
+		queue->registerMessageHandler(5, MessageHandler(&caller, &GroupRecorder::record));
+		ass_eq(queue->handlerGroups().numLanes(), 3);
+
+		/* Every lane is done when processMessages() returns, each in posting order */
+		Byte data[16];
+		for (U32 run = 0; run < 10; ++run) {
+			for (I32 i = 0; i < 10; ++i) {
+				reinterpret_cast<I32*>(data)[0] = run*10 + i;
+				queue->postMessage(Message(3, data));
+				queue->postMessage(Message(4, data));
+				queue->postMessage(Message(5, data));
+			}
+			queue->processMessages();
+			ass_eq(one.m_count, (run + 1)*10);
+			ass_eq(two.m_count, (run + 1)*10);
+			ass_eq(twoBatch.m_count, (run + 1)*10);
+			ass_eq(caller.m_count, (run + 1)*20);
+		}
+		ass_true(one.m_inOrder);
+		ass_true(two.m_inOrder);
+		ass_true(twoBatch.m_inOrder);
+		ass_true(caller.m_inOrder);
+		/* Group 0 always runs on the processing thread */
+		ass_true(caller.m_onCaller);
+
+		delete runner;
+		delete queue;
+		FINISH_TEST;
+	}
+
+	I32 handler_order[8];
+	U32 num_handlers_called = 0;
+
+	void recordHandlerOrder(VPtr obj, Byte* data) {
+		handler_order[num_handlers_called++ % 8] = *reinterpret_cast<I32*>(obj);
+	}
+
+	void testMessageQueueAnySenderHandlersFirst() {
+		BEGIN_TEST;
+
+		MessageQueue* queue = new MessageQueue(32, 10);
+		I32 sender = 0;
+		I32 ids[4] = { 0, 1, 2, 3 };
+		queue->registerMessageHandler(1, MessageHandler(&ids[0], &sender, recordHandlerOrder));
+		queue->registerMessageHandler(1, MessageHandler(&ids[1], recordHandlerOrder));
+		queue->registerMessageHandler(1, MessageHandler(&ids[2], &sender, recordHandlerOrder));
+		queue->registerMessageHandler(1, MessageHandler(&ids[3], recordHandlerOrder));
+
+		/* Whatever the registration order, the handlers for any sender come first */
+		queue->triggerMessage(Message(1, &sender));
+		ass_eq(num_handlers_called, 4);
+		ass_eq(handler_order[0], 1);
+		ass_eq(handler_order[1], 3);
+		ass_eq(handler_order[2], 0);
+		ass_eq(handler_order[3], 2);
+
+		queue->postMessage(Message(1));
+		queue->processMessages();
+		ass_eq(num_handlers_called, 6);
+		ass_eq(handler_order[4], 1);
+		ass_eq(handler_order[5], 3);
+
+		delete queue;
+		FINISH_TEST;
+	}
+
 } // namespace cc
 
 int main(int argc, char** argv) {
@@ -790,6 +1501,14 @@ int main(int argc, char** argv) {
 	cc::testMessageQueuePostAndProcessMessages();
 	cc::testMessageQueuePostAndProcessMessagesWithSender();
 	cc::testMessageQueuePostAndProcessMessagesWithSenderMultiple();	
+	cc::testMessageQueuePerThreadRings();
+	cc::testMessageQueuePerThreadRingsOrderByTime();
+	cc::testMessageQueuePerThreadRingsHandoff();
+	cc::testMessageQueuePostPayload();
+	cc::testMessageQueuePostPayloadNearFull();
+	cc::testMessageQueueBatchHandlers();
+	cc::testMessageQueueParallelDispatch();
+	cc::testMessageQueueAnySenderHandlersFirst();
 			
 	return 0;
 }
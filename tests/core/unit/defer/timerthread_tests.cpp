@@ -0,0 +1,252 @@
+#include "core/testcore.h"
+#include "core/defer/timerthread.h"
+#include "core/threading/asynctaskrunner.h"
+
+namespace cc {
+
+	U32 fired_count = 0;
+	RawTimeVal last_fired_time = 0;
+
+	class CountingAction : public TimedAction {
+	  public:
+		CountingAction(const Char* name, const TimeVal& timeToWait, U32 repeats = 1)
+			: TimedAction(name, timeToWait), m_repeats(repeats) {}
+
+		Boolean fire() {
+			__atomic_add_fetch(&fired_count, 1, __ATOMIC_RELAXED);
+			__atomic_store_n(&last_fired_time, Time::currentTimeRaw(), __ATOMIC_RELAXED);
+			DMSG("Action " << name() << " fired!");
+			return (--m_repeats > 0);
+		}
+
+		inline static TimedActionPtr create(const Char* name, const TimeVal& timeToWait, U32 repeats = 1) {
+			return TimedActionPtr(new CountingAction(name, timeToWait, repeats));
+		}
+
+	  private:
+		U32 m_repeats;
+	};
+
+	U32 firedCount() {
+		return __atomic_load_n(&fired_count, __ATOMIC_RELAXED);
+	}
+
+	U32 num_running = 0;
+	U32 max_running = 0;
+
+	class SlowAction : public TimedAction {
+	  public:
+		SlowAction(const Char* name, const TimeVal& timeToWait)
+			: TimedAction(name, timeToWait) {}
+
+		Boolean fire() {
+			U32 running = __atomic_add_fetch(&num_running, 1, __ATOMIC_ACQ_REL);
+			U32 seen = __atomic_load_n(&max_running, __ATOMIC_RELAXED);
+			while (running > seen &&
+					 !__atomic_compare_exchange_n(&max_running, &seen, running, false,
+															__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+			__atomic_add_fetch(&fired_count, 1, __ATOMIC_RELAXED);
+			usleep(30000);
+			__atomic_sub_fetch(&num_running, 1, __ATOMIC_ACQ_REL);
+			return true;
+		}
+	};
+
+	class LastSlowAction : public TimedAction {
+	  public:
+		LastSlowAction(const Char* name, const TimeVal& timeToWait)
+			: TimedAction(name, timeToWait) {}
+
+		Boolean fire() {
+			usleep(30000);
+			__atomic_add_fetch(&fired_count, 1, __ATOMIC_RELAXED);
+			return false;
+		}
+	};
+
+	void testTimerThreadFiresOnTime() {
+		BEGIN_TEST;
+
+		fired_count = 0;
+		TimerThread* t = new TimerThread(16);
+		ass_true(t->start());
+		ass_true(t->isRunning());
+
+		/* With nothing registered the thread does not wake up */
+		usleep(20000);
+		U64 wakeups = t->numWakeups();
+		usleep(50000);
+		ass_eq(t->numWakeups(), wakeups);
+
+		TimedActionPtr action = CountingAction::create("S1", TimeVal(Time::secondsToRaw(0.03)));
+		RawTimeVal registered = Time::currentTimeRaw();
+		U64 a1 = t->registerSingular(action);
+		ass_neq(a1, 0);
+		usleep(15000);
+		ass_eq(firedCount(), 0);
+		usleep(60000);
+		ass_eq(firedCount(), 1);
+		RawTimeVal fired = __atomic_load_n(&last_fired_time, __ATOMIC_RELAXED);
+		ass_true(Time::compareRaw(fired, registered + Time::secondsToRaw(0.03)) >= 0);
+		ass_true(Time::compareRaw(fired, registered + Time::secondsToRaw(0.05)) < 0);
+
+		/* A repeated action fires until it returns false */
+		action = CountingAction::create("R1", TimeVal(Time::secondsToRaw(0.01)), 3);
+		t->registerRepeated(action);
+		usleep(100000);
+		ass_eq(firedCount(), 4);
+
+		/* An unregistered action never fires */
+		action = CountingAction::create("S2", TimeVal(Time::secondsToRaw(0.03)));
+		U64 a2 = t->registerSingular(action);
+		t->unregisterSingular(a2);
+		usleep(60000);
+		ass_eq(firedCount(), 4);
+
+		action.setNull();
+		t->stop();
+		ass_false(t->isRunning());
+		delete t;
+		FINISH_TEST;
+	}
+
+	void testTimerThreadCoalescesWakeups() {
+		BEGIN_TEST;
+
+		fired_count = 0;
+		TimerThread* t = new TimerThread(64, TimeVal(Time::secondsToRaw(0.05)));
+		ass_true(t->start());
+		usleep(10000);
+
+		/* Actions due within the same slack window share one wake-up */
+		for (U32 i = 0; i < 32; ++i) {
+			TimedActionPtr action = CountingAction::create("S", TimeVal(Time::secondsToRaw(0.02 + 0.0005*i)));
+			t->registerSingular(action);
+		}
+		usleep(2000);
+		U64 wakeups = t->numWakeups();
+		usleep(150000);
+		ass_eq(firedCount(), 32);
+		/* At most two windows, since the spread is less than the slack */
+		ass_le(t->numWakeups() - wakeups, 2);
+
+		wakeups = t->numWakeups();
+		usleep(60000);
+		ass_eq(t->numWakeups(), wakeups);
+
+		delete t;
+		FINISH_TEST;
+	}
+
+	void testTimerThreadDispatchesToAsyncTaskRunner() {
+		BEGIN_TEST;
+
+		fired_count = 0;
+		AsyncTaskRunner* runner = new AsyncTaskRunner(2);
+		TimerThread* t = new TimerThread(16);
+		t->dispatchTo(runner);
+		ass_true(t->start());
+
+		TimedActionPtr action = CountingAction::create("S1", TimeVal(Time::secondsToRaw(0.01)));
+		t->registerSingular(action);
+		action = CountingAction::create("R1", TimeVal(Time::secondsToRaw(0.01)), 3);
+		t->registerRepeated(action);
+		action.setNull();
+		usleep(120000);
+		/* The repeated action is unregistered once its fire() returns false */
+		ass_eq(firedCount(), 4);
+		usleep(50000);
+		ass_eq(firedCount(), 4);
+
+		delete t;
+		runner->stop();
+		delete runner;
+		FINISH_TEST;
+	}
+
+	void testTimerThreadSkipsPeriodsWhileRunning() {
+		BEGIN_TEST;
+
+		fired_count = 0;
+		AsyncTaskRunner* runner = new AsyncTaskRunner(4);
+		TimerThread* t = new TimerThread(16);
+		t->dispatchTo(runner);
+		ass_true(t->start());
+
+		/* Each fire() takes six periods, with workers free to start it again */
+		TimedActionPtr action(new SlowAction("Slow", TimeVal(Time::secondsToRaw(0.005))));
+		U64 actionID = t->registerRepeated(action);
+		usleep(200000);
+		t->unregisterRepeated(actionID);
+		usleep(60000);
+
+		ass_eq(__atomic_load_n(&max_running, __ATOMIC_RELAXED), 1);
+		ass_gt(firedCount(), 2);
+		ass_lt(firedCount(), 10);
+
+		action.setNull();
+		delete t;
+		runner->stop();
+		delete runner;
+		FINISH_TEST;
+	}
+
+	void testTimerThreadDeletedWhileDispatched() {
+		BEGIN_TEST;
+
+		fired_count = 0;
+		AsyncTaskRunner* runner = new AsyncTaskRunner(1);
+		TimerThread* t = new TimerThread(16);
+		t->dispatchTo(runner);
+		ass_true(t->start());
+
+		/* The run ends after the TimerThread is gone, and must not touch it */
+		TimedActionPtr action(new LastSlowAction("Last", TimeVal(Time::secondsToRaw(0.005))));
+		t->registerRepeated(action);
+		usleep(15000);
+		delete t;
+		ass_eq(firedCount(), 0);
+		runner->stop();
+		delete runner;
+		ass_eq(firedCount(), 1);
+		ass_true(action->wasRemoved());
+
+		action.setNull();
+		FINISH_TEST;
+	}
+
+	void testTimerThreadDispatchAfterRunnerStopped() {
+		BEGIN_TEST;
+
+		fired_count = 0;
+		AsyncTaskRunner* runner = new AsyncTaskRunner(1);
+		runner->stop();
+		TimerThread* t = new TimerThread(16);
+		t->dispatchTo(runner);
+		ass_true(t->start());
+
+		/* The runner refuses the runs, which must not be left in flight */
+		TimedActionPtr action = CountingAction::create("R1", TimeVal(Time::secondsToRaw(0.005)), 3);
+		t->registerRepeated(action);
+		usleep(30000);
+		delete t;
+		ass_eq(firedCount(), 0);
+		Boolean dispatchable = action->beginDispatch();
+		ass_true(dispatchable);
+
+		action.setNull();
+		delete runner;
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testTimerThreadFiresOnTime();
+	cc::testTimerThreadCoalescesWakeups();
+	cc::testTimerThreadDispatchesToAsyncTaskRunner();
+	cc::testTimerThreadSkipsPeriodsWhileRunning();
+	cc::testTimerThreadDeletedWhileDispatched();
+	cc::testTimerThreadDispatchAfterRunnerStopped();
+	return 0;
+}
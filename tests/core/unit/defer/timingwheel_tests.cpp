@@ -0,0 +1,155 @@
+#include "core/testcore.h"
+#include "core/defer/timingwheel.h"
+
+namespace cc {
+
+	struct TestEntry : public TimingWheel::Entry {
+		U32 id;
+	};
+
+	U64 rand64() {
+		return ((U64)(rand() & 0xFFFF) << 32) | ((U64)(rand() & 0xFFFF) << 16) | (U64)(rand() & 0xFFFF);
+	}
+
+	void testTimingWheelInsertAndAdvance() {
+		BEGIN_TEST;
+
+		TimingWheel wheel;
+		ass_true(wheel.isEmpty());
+		ass_eq(wheel.nextDeadline(), ~0ULL);
+
+		TestEntry entries[6];
+		U64 deadlines[6] = { 5, 5, 63, 64, 5000, 300000 };
+		for (U32 i = 0; i < 6; ++i) {
+			entries[i].id = i;
+			wheel.insert(&entries[i], deadlines[i]);
+		}
+		ass_eq(wheel.size(), 6);
+		ass_eq(wheel.nextDeadline(), 5);
+
+		TimingWheel::Entry expired;
+		expired.initAsRoot();
+		Size numExpired = wheel.advance(4, &expired);
+		ass_eq(numExpired, 0);
+		ass_true(expired.isEmptyRoot());
+		ass_eq(wheel.currentTick(), 4);
+
+		/* Both entries due at 5 come out, in the order they went in */
+		numExpired = wheel.advance(10, &expired);
+		ass_eq(numExpired, 2);
+		ass_eq(static_cast<TestEntry*>(expired.next)->id, 0);
+		ass_eq(static_cast<TestEntry*>(expired.next->next)->id, 1);
+		expired.initAsRoot();
+
+		/* Removing is O(1), and a removed entry never expires */
+		wheel.remove(&entries[3]);
+		ass_eq(wheel.size(), 3);
+		numExpired = wheel.advance(4999, &expired);
+		ass_eq(numExpired, 1);
+		ass_eq(static_cast<TestEntry*>(expired.next)->id, 2);
+		expired.initAsRoot();
+		numExpired = wheel.advance(5000, &expired);
+		ass_eq(numExpired, 1);
+		ass_eq(static_cast<TestEntry*>(expired.next)->id, 4);
+		expired.initAsRoot();
+		numExpired = wheel.advance(299999, &expired);
+		ass_eq(numExpired, 0);
+		numExpired = wheel.advance(300000, &expired);
+		ass_eq(numExpired, 1);
+		ass_eq(static_cast<TestEntry*>(expired.next)->id, 5);
+		ass_true(wheel.isEmpty());
+		expired.initAsRoot();
+
+		/* Passed deadlines are due on the next tick */
+		wheel.insert(&entries[0], 3);
+		ass_eq(entries[0].deadline, 300001);
+		numExpired = wheel.advance(300001, &expired);
+		ass_eq(numExpired, 1);
+		expired.initAsRoot();
+
+		/* Deadlines out of the range of the wheel still expire on time */
+		wheel.insert(&entries[1], wheel.currentTick() + TimingWheel::kMaxTicksAhead*3 + 17);
+		U64 due = entries[1].deadline;
+		numExpired = wheel.advance(due - 1, &expired);
+		ass_eq(numExpired, 0);
+		numExpired = wheel.advance(due, &expired);
+		ass_eq(numExpired, 1);
+		ass_eq(wheel.currentTick(), due);
+
+		FINISH_TEST;
+	}
+
+	void testTimingWheelRandomDeadlines() {
+		BEGIN_TEST;
+
+		const U32 numEntries = 5000;
+		TestEntry* entries = new TestEntry[numEntries];
+		Boolean* removed = new Boolean[numEntries];
+		Boolean* fired = new Boolean[numEntries];
+		TimingWheel wheel;
+		wheel.reset(1000);
+		for (U32 i = 0; i < numEntries; ++i) {
+			entries[i].id = i;
+			removed[i] = fired[i] = false;
+			U64 range = (i % 3 == 0) ? 100 : ((i % 3 == 1) ? 100000 : 30000000);
+			wheel.insert(&entries[i], 1001 + rand64() % range);
+		}
+		for (U32 i = 0; i < numEntries; i += 7) {
+			wheel.remove(&entries[i]);
+			removed[i] = true;
+		}
+
+		/* Advance by uneven steps; every entry expires exactly once, at its deadline */
+		TimingWheel::Entry expired;
+		expired.initAsRoot();
+		U64 tick = 1000;
+		U32 numFired = 0;
+		while (!wheel.isEmpty()) {
+			/* Nothing expires before the next deadline the wheel reports */
+			U64 bound = wheel.nextDeadline();
+			ass_lt(tick, bound);
+			tick += 1 + rand64() % 20000;
+			U64 last = bound;
+			wheel.advance(tick, &expired);
+			while (!expired.isEmptyRoot()) {
+				TestEntry* entry = static_cast<TestEntry*>(expired.next);
+				entry->detach();
+				ass_false(removed[entry->id]);
+				ass_false(fired[entry->id]);
+				ass_le(entry->deadline, tick);
+				ass_ge(entry->deadline, last);
+				last = entry->deadline;
+				fired[entry->id] = true;
+				++numFired;
+			}
+		}
+		ass_eq(numFired, numEntries - (numEntries + 6)/7);
+
+		/* Stepping one tick at a time never reports an entry late */
+		wheel.reset(0);
+		for (U32 i = 0; i < 1000; ++i) {
+			wheel.insert(&entries[i], 1 + rand64() % 10000);
+		}
+		for (tick = 1; !wheel.isEmpty(); ++tick) {
+			wheel.advance(tick, &expired);
+			while (!expired.isEmptyRoot()) {
+				TestEntry* entry = static_cast<TestEntry*>(expired.next);
+				entry->detach();
+				ass_eq(entry->deadline, tick);
+			}
+			ass_gt(wheel.nextDeadline(), tick);
+		}
+
+		delete[] entries;
+		delete[] removed;
+		delete[] fired;
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testTimingWheelInsertAndAdvance();
+	cc::testTimingWheelRandomDeadlines();
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include "core/testcore.h"
+#include "core/event/eventpool.h"
+
+namespace cc {
+
+	void testEventPoolCreateAndDestroy() {
+		BEGIN_TEST;
+
+		EventPool pool;
+		ass_eq(pool.slotSize(), 0);
+		ass_eq(pool.numSlots(), 0);
+		ass_eq(pool.numUsed(), 0);
+		ass_eq(pool.head(), 0);
+		Byte* slot = pool.alloc(1);
+		ass_eq(slot, NIL);
+
+		pool.initWithSlots(40, 4);
+		ass_eq(pool.slotSize(), 48);
+		ass_eq(pool.numSlots(), 4);
+		ass_eq(pool.numUsed(), 0);
+
+		FINISH_TEST;
+	}
+
+	void testEventPoolAllocAndUnalloc() {
+		BEGIN_TEST;
+
+		EventPool pool;
+		pool.initWithSlots(40, 4);
+
+		/* Too big for a slot */
+		Byte* slot = pool.alloc(49);
+		ass_eq(slot, NIL);
+		ass_eq(pool.numUsed(), 0);
+
+		Byte* slots[4];
+		for (U32 i = 0; i < 4; ++i) {
+			slots[i] = pool.alloc(48);
+			ass_neq(slots[i], NIL);
+			ass_eq((Size)slots[i] & (EventPool::kAlignment - 1), 0);
+			ass_eq(pool.numUsed(), i + 1);
+		}
+		ass_eq(slots[1], slots[0] + 48);
+		ass_eq(slots[3], slots[0] + 3*48);
+
+		/* Full */
+		slot = pool.alloc(8);
+		ass_eq(slot, NIL);
+		ass_eq(pool.numUsed(), 4);
+		ass_eq(pool.head(), 4);
+
+		/* The last slot can be handed back and taken again */
+		pool.unalloc();
+		ass_eq(pool.numUsed(), 3);
+		ass_eq(pool.head(), 3);
+		slot = pool.alloc(8);
+		ass_eq(slot, slots[3]);
+		ass_eq(pool.numUsed(), 4);
+
+		pool.recycleTo(pool.head());
+		ass_eq(pool.numUsed(), 0);
+
+		FINISH_TEST;
+	}
+
+	void testEventPoolRecycleWraparound() {
+		BEGIN_TEST;
+
+		EventPool pool;
+		pool.initWithSlots(16, 4);
+		Byte* base = pool.alloc(16);
+		pool.recycleTo(pool.head());
+
+		/* Three slots a run, so the head runs past the end of the ring every run */
+		for (U32 run = 0; run < 10; ++run) {
+			U64 mark = pool.head();
+			for (U32 i = 0; i < 3; ++i) {
+				U64 head = pool.head();
+				Byte* slot = pool.alloc(16);
+				ass_eq(slot, base + (Size)(head % 4)*16);
+			}
+			ass_eq(pool.numUsed(), 3);
+			ass_eq(pool.head(), mark + 3);
+			pool.recycleTo(pool.head());
+			ass_eq(pool.numUsed(), 0);
+		}
+		ass_eq(pool.head(), 31);
+
+		/* Only the slots before the mark are recycled */
+		pool.alloc(16);
+		pool.alloc(16);
+		U64 mark = pool.head();
+		pool.alloc(16);
+		pool.recycleTo(mark);
+		ass_eq(pool.numUsed(), 1);
+		for (U32 i = 0; i < 3; ++i) {
+			Byte* slot = pool.alloc(16);
+			ass_neq(slot, NIL);
+		}
+		Byte* slot = pool.alloc(16);
+		ass_eq(slot, NIL);
+		ass_eq(pool.numUsed(), 4);
+
+		pool.recycleTo(pool.head());
+		ass_eq(pool.numUsed(), 0);
+
+		FINISH_TEST;
+	}
+
+	void testEventPoolOwns() {
+		BEGIN_TEST;
+
+		EventPool pool;
+		pool.initWithSlots(sizeof(Event), 2);
+
+		Event* pooled = new (pool.alloc(sizeof(Event))) Event(Event::kEKeyDown);
+		Event* other = new Event(Event::kEKeyDown);
+		Event onStack(Event::kEKeyUp);
+		ass_true(pool.owns(pooled));
+		ass_false(pool.owns(other));
+		ass_false(pool.owns(&onStack));
+
+		pooled->~Event();
+		delete other;
+		pool.recycleTo(pool.head());
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testEventPoolCreateAndDestroy();
+	cc::testEventPoolAllocAndUnalloc();
+	cc::testEventPoolRecycleWraparound();
+	cc::testEventPoolOwns();
+	return 0;
+}
@@ -0,0 +1,165 @@
+#include "core/testcore.h"
+#include "core/event/eventqueue.h"
+
+namespace cc {
+
+	/* Neither keyboard, mouse nor UI events, so they are pooled in kEQGOther */
+	static const Event::Type kTestSingleEvent = (Event::Type)0x20;
+	static const Event::Type kTestCombinedEvent = (Event::Type)0x40;
+
+	static I32 s_numLive = 0;
+
+	class SingleEvent : public Event {
+	  public:
+		SingleEvent(Type type, I32 value)
+			: Event(type), m_value(value) { ++s_numLive; }
+		~SingleEvent() { --s_numLive; }
+
+		I32 m_value;
+	};
+
+	class CombinedEvent : public Event {
+	  public:
+		CombinedEvent(Type type, I32 delta)
+			: Event(type, true), m_delta(delta) { ++s_numLive; }
+		~CombinedEvent() { --s_numLive; }
+
+		void combine(Event* event) {
+			m_delta += static_cast<CombinedEvent*>(event)->m_delta;
+		}
+
+		I32 m_delta;
+		Byte m_padding[40];
+	};
+
+	static const Size kTestSlotSize = (sizeof(SingleEvent) > sizeof(CombinedEvent)) ?
+		sizeof(SingleEvent) : sizeof(CombinedEvent);
+
+	void testEventQueuePostInPool() {
+		BEGIN_TEST;
+
+		Boolean posted;
+		EventQueue* queue = new EventQueue(16);
+		queue->initEventPool(EventQueue::kEQGOther, kTestSlotSize, 4);
+		EventPool* pool = queue->eventPool(EventQueue::kEQGOther);
+		ass_eq(EventQueue::groupOfType(kTestSingleEvent), EventQueue::kEQGOther);
+
+		for (I32 i = 0; i < 4; ++i) {
+			posted = queue->post<SingleEvent>(kTestSingleEvent, i);
+			ass_true(posted);
+			ass_true(pool->owns(queue->events()->peekLast()));
+		}
+		ass_eq(pool->numUsed(), 4);
+		ass_eq(s_numLive, 4);
+
+		/* The pool is full, and the event is never constructed */
+		posted = queue->post<SingleEvent>(kTestSingleEvent, 4);
+		ass_false(posted);
+		ass_eq(pool->numUsed(), 4);
+		ass_eq(s_numLive, 4);
+
+		/* Unprocessed events are destroyed with the queue */
+		delete queue;
+		ass_eq(s_numLive, 0);
+
+		FINISH_TEST;
+	}
+
+	void testEventQueuePostCombines() {
+		BEGIN_TEST;
+
+		Boolean posted;
+		EventQueue* queue = new EventQueue(16);
+		queue->initEventPool(EventQueue::kEQGOther, kTestSlotSize, 4);
+		EventPool* pool = queue->eventPool(EventQueue::kEQGOther);
+
+		posted = queue->post<SingleEvent>(kTestSingleEvent, 1);
+		ass_true(posted);
+		posted = queue->post<CombinedEvent>(kTestCombinedEvent, 1);
+		ass_true(posted);
+		CombinedEvent* first = static_cast<CombinedEvent*>(queue->events()->peekLast());
+
+		/* Each combined event hands its slot straight back */
+		for (I32 i = 0; i < 10; ++i) {
+			posted = queue->post<CombinedEvent>(kTestCombinedEvent, 2);
+			ass_true(posted);
+			ass_eq(pool->numUsed(), 2);
+			ass_eq(s_numLive, 2);
+		}
+		ass_eq(first->m_delta, 21);
+		ass_eq(queue->events()->peekLast(), first);
+
+		/* Another type in between starts a new combined event */
+		posted = queue->post<SingleEvent>(kTestSingleEvent, 2);
+		ass_true(posted);
+		posted = queue->post<CombinedEvent>(kTestCombinedEvent, 5);
+		ass_true(posted);
+		ass_eq(pool->numUsed(), 4);
+		ass_eq(s_numLive, 4);
+		ass_eq(first->m_delta, 21);
+		ass_eq(static_cast<CombinedEvent*>(queue->events()->peekLast())->m_delta, 5);
+
+		/* The slot is taken before combining, so a full pool turns away even these */
+		posted = queue->post<CombinedEvent>(kTestCombinedEvent, 5);
+		ass_false(posted);
+		ass_eq(pool->numUsed(), 4);
+		ass_eq(s_numLive, 4);
+		ass_eq(static_cast<CombinedEvent*>(queue->events()->peekLast())->m_delta, 5);
+
+		delete queue;
+		ass_eq(s_numLive, 0);
+
+		FINISH_TEST;
+	}
+
+	void testEventQueueSlotReuse() {
+		BEGIN_TEST;
+
+		Boolean posted;
+		EventQueue* queue = new EventQueue(16);
+		queue->initEventPool(EventQueue::kEQGOther, kTestSlotSize, 4);
+		EventPool* pool = queue->eventPool(EventQueue::kEQGOther);
+
+		/* Three slots a run, so the slots wrap around the ring */
+		for (I32 run = 0; run < 6; ++run) {
+			posted = queue->post<SingleEvent>(kTestSingleEvent, run);
+			ass_true(posted);
+			posted = queue->post<CombinedEvent>(kTestCombinedEvent, run);
+			ass_true(posted);
+			posted = queue->post<CombinedEvent>(kTestCombinedEvent, run);
+			ass_true(posted);
+			posted = queue->post<SingleEvent>(kTestSingleEvent, run);
+			ass_true(posted);
+			posted = queue->postEvent(new SingleEvent(kTestSingleEvent, run));
+			ass_true(posted);
+			ass_eq(pool->numUsed(), 3);
+			ass_eq(s_numLive, 4);
+
+			queue->processEvents();
+			ass_eq(pool->numUsed(), 0);
+			ass_eq(s_numLive, 0);
+			ass_eq(pool->head(), (U64)(run + 1)*3);
+		}
+
+		/* Every slot can be taken again */
+		for (I32 i = 0; i < 4; ++i) {
+			posted = queue->post<SingleEvent>(kTestSingleEvent, i);
+			ass_true(posted);
+		}
+		posted = queue->post<SingleEvent>(kTestSingleEvent, 4);
+		ass_false(posted);
+
+		delete queue;
+		ass_eq(s_numLive, 0);
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testEventQueuePostInPool();
+	cc::testEventQueuePostCombines();
+	cc::testEventQueueSlotReuse();
+	return 0;
+}
@@ -0,0 +1,234 @@
+#include "core/testcore.h"
+#include "core/geometry/aabbtree2.h"
+#include "core/geometry/uniformgrid2.h"
+#include "core/geometry/convexpoly2index.h"
+#include "core/geometry/convexpoly2f.h"
+
+namespace cc {
+
+	static U32 s_seed = 12345;
+
+	static I32 nextRandom(I32 range) {
+		s_seed = s_seed*1103515245 + 12345;
+		return (I32)((s_seed >> 16) % (U32)range);
+	}
+
+	static Rectf randomRect() {
+		return Rectf((Real)nextRandom(1000), (Real)nextRandom(1000),
+						 (Real)(nextRandom(40) + 1), (Real)(nextRandom(40) + 1));
+	}
+
+	static Boolean touches(const Rectf& a, const Rectf& b) {
+		return a.left() <= b.right() && b.left() <= a.right() &&
+			a.bottom() <= b.top() && b.bottom() <= a.top();
+	}
+
+	static Boolean sameIds(Vector<I32>& found, const Vector<I32>& expected) {
+		if (found.size() != expected.size()) {
+			return false;
+		}
+		for (Size i = 0; i < expected.size(); ++i) {
+			if (!found.contains(expected.get(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename Index>
+	static void checkQueries(const Index& index, const Vector<Rectf>& rects,
+									 const Vector<I32>& proxies, const Vector<Boolean>& alive) {
+		Vector<I32> found(16);
+		Vector<I32> expected(16);
+		for (I32 q = 0; q < 50; ++q) {
+			Rectf region = randomRect();
+			found.clear();
+			expected.clear();
+			index.query(region, found);
+			for (Size i = 0; i < rects.size(); ++i) {
+				if (alive.get(i) && touches(rects.get(i), region)) {
+					expected.append(proxies.get(i));
+				}
+			}
+			ass_true(sameIds(found, expected));
+
+			Point2f point((Real)nextRandom(1000), (Real)nextRandom(1000));
+			found.clear();
+			expected.clear();
+			index.query(point, found);
+			for (Size i = 0; i < rects.size(); ++i) {
+				if (alive.get(i) && touches(rects.get(i), Rectf(point.x, point.y, 0, 0))) {
+					expected.append(proxies.get(i));
+				}
+			}
+			ass_true(sameIds(found, expected));
+		}
+
+		Vector<typename Index::Pair> pairs(16);
+		index.queryPairs(pairs);
+		Size count = 0;
+		for (Size i = 0; i < rects.size(); ++i) {
+			for (Size j = i + 1; j < rects.size(); ++j) {
+				if (alive.get(i) && alive.get(j) && touches(rects.get(i), rects.get(j))) {
+					++count;
+				}
+			}
+		}
+		ass_eq(pairs.size(), count);
+		for (Size p = 0; p < pairs.size(); ++p) {
+			ass_true(pairs.get(p).first < pairs.get(p).second);
+			ass_true(touches(index.getRect(pairs.get(p).first), index.getRect(pairs.get(p).second)));
+		}
+	}
+
+	void testAabbTree2Queries() {
+		BEGIN_TEST;
+
+		AabbTree2<Real> tree(REAL(4.0));
+		ass_eq(tree.size(), 0);
+		ass_eq(tree.height(), 0);
+
+		Vector<Rectf> rects(512);
+		Vector<I32> proxies(512);
+		Vector<Boolean> alive(512);
+		for (I32 i = 0; i < 500; ++i) {
+			rects.append(randomRect());
+			proxies.append(tree.insert(rects.last(), (VPtr)(Size)(i + 1)));
+			alive.append(true);
+		}
+		ass_eq(tree.size(), 500);
+		ass_true(tree.validate());
+		ass_true(tree.height() < 20);
+		ass_true(tree.getData(proxies.get(7)) == (VPtr)(Size)8);
+		ass_eq(tree.getRect(proxies.get(7)), rects.get(7));
+		checkQueries(tree, rects, proxies, alive);
+
+		/* Small moves stay in the fat bounds, big ones do not */
+		Rectf moved = rects.get(3);
+		moved.moveTo(moved.left() + 1, moved.top() - 1);
+		Boolean changed = tree.update(proxies.get(3), moved);
+		ass_false(changed);
+		rects.set(3, moved);
+		moved.moveTo(moved.left() + 100, moved.top());
+		changed = tree.update(proxies.get(3), moved);
+		ass_true(changed);
+		rects.set(3, moved);
+
+		for (I32 i = 0; i < 500; i += 3) {
+			rects.set(i, randomRect());
+			tree.update(proxies.get(i), rects.get(i));
+		}
+		for (I32 i = 1; i < 500; i += 4) {
+			tree.remove(proxies.get(i));
+			alive.set(i, false);
+		}
+		ass_eq(tree.size(), 375);
+		ass_true(tree.validate());
+		checkQueries(tree, rects, proxies, alive);
+
+		tree.clear();
+		ass_eq(tree.size(), 0);
+		Vector<I32> found(16);
+		Size count = tree.query(Rectf(0, 1000, 1000, 1000), found);
+		ass_eq(count, 0);
+
+		FINISH_TEST;
+	}
+
+	void testUniformGrid2Queries() {
+		BEGIN_TEST;
+
+		UniformGrid2<Real> grid(Rectf(0, 1000, 1000, 1000), REAL(50.0));
+		ass_eq(grid.columns(), 20);
+		ass_eq(grid.rows(), 20);
+
+		Vector<Rectf> rects(512);
+		Vector<I32> proxies(512);
+		Vector<Boolean> alive(512);
+		for (I32 i = 0; i < 500; ++i) {
+			rects.append(randomRect());
+			proxies.append(grid.insert(rects.last()));
+			alive.append(true);
+		}
+		/* Outside the grid is kept in the edge cells */
+		rects.append(Rectf(-200, 1200, 300, 300));
+		proxies.append(grid.insert(rects.last()));
+		alive.append(true);
+		ass_eq(grid.size(), 501);
+		checkQueries(grid, rects, proxies, alive);
+
+		for (I32 i = 0; i < 500; i += 3) {
+			rects.set(i, randomRect());
+			grid.update(proxies.get(i), rects.get(i));
+		}
+		for (I32 i = 1; i < 500; i += 4) {
+			grid.remove(proxies.get(i));
+			alive.set(i, false);
+		}
+		ass_eq(grid.size(), 376);
+		checkQueries(grid, rects, proxies, alive);
+
+		FINISH_TEST;
+	}
+
+	void testConvexPoly2IndexPick() {
+		BEGIN_TEST;
+
+		/* A diamond, whose bounding box corners are outside it */
+		Vector<Point2f> points(4);
+		points.append(Point2f(0, 10));
+		points.append(Point2f(10, 0));
+		points.append(Point2f(0, -10));
+		points.append(Point2f(-10, 0));
+		ConvexPoly2f diamond(points);
+		ConvexPoly2f square(Rectf(5, 5, 10, 10));
+
+		ConvexPoly2Index<Real> index(REAL(1.0));
+		I32 d = index.add(&diamond);
+		I32 s = index.add(&square);
+		ass_eq(index.size(), 2);
+		ass_true(index.get(d) == &diamond);
+
+		Vector<I32> found(16);
+		Size count = index.pick(Point2f(0, 0), found);
+		ass_eq(count, 1);
+		ass_eq(found.get(0), d);
+
+		/* Inside the bounds of the diamond, but not the diamond itself */
+		found.clear();
+		count = index.pick(Point2f(9, -9), found);
+		ass_eq(count, 0);
+		ass_eq(found.size(), 0);
+		count = index.query(Rectf(8, -8, 1, 1), found);
+		ass_eq(count, 1);
+
+		found.clear();
+		count = index.pick(Point2f(6, 4), found);
+		ass_eq(count, 2);
+
+		square.moveTo(100, 100);
+		Boolean changed = index.update(s);
+		ass_true(changed);
+		found.clear();
+		count = index.pick(Point2f(6, 4), found);
+		ass_eq(count, 1);
+		count = index.pick(Point2f(105, 95), found);
+		ass_eq(count, 1);
+		ass_eq(found.get(1), s);
+
+		index.remove(d);
+		found.clear();
+		count = index.pick(Point2f(0, 0), found);
+		ass_eq(count, 0);
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testAabbTree2Queries();
+	cc::testUniformGrid2Queries();
+	cc::testConvexPoly2IndexPick();
+	return 0;
+}
@@ -1,8 +1,9 @@
+#include <cmath>
 #include "core/testcore.h"
 #include "core/geometry/convexpoly2.h"
 #include "core/geometry/convexpoly2f.h"
 #include "core/geometry/convexpoly2i.h"
-#include "core/math/vec2f.h"
+#include "core/math/vec2.h"
 
 namespace cc {
 
@@ -363,6 +364,142 @@ namespace cc {
 		FINISH_TEST;
 	}
 
+	void testConvexPolyContainsPoints() {
+		BEGIN_TEST;
+
+		/* A ten sided polygon, so the edges do not split evenly into lanes */
+		Vector<Point2f> vf(16);
+		for (I32 i = 0; i < 10; ++i) {
+			Real angle = (Real)i * REAL(0.6283185);
+			vf.append(Point2f(REAL(3.0) + REAL(7.5)*::cos(angle), REAL(-2.0) + REAL(7.5)*::sin(angle)));
+		}
+		ConvexPoly2<Real> pr(vf);
+		ass_eq(pr.count(), 10);
+
+		Point2f points[203];
+		Boolean results[203];
+		Boolean scalarResults[203];
+		U32 seed = 7;
+		for (I32 i = 0; i < 200; ++i) {
+			seed = seed*1103515245 + 12345;
+			points[i].x = REAL(-6.0) + (Real)((seed >> 8) % 18000) / REAL(1000.0);
+			seed = seed*1103515245 + 12345;
+			points[i].y = REAL(-11.0) + (Real)((seed >> 8) % 18000) / REAL(1000.0);
+		}
+		/* The corners are on the edges, so are in the polygon */
+		points[200] = pr.pointAt(0);
+		points[201] = pr.pointAt(5);
+		points[202] = Point2f(3, -2);
+
+		Size found = pr.contains(points, 203, results);
+		Size scalarFound = ConvexPolyKernels::scalarTable().containsPoints(
+			&pr.pointAt(0), pr.count(), points, 203, scalarResults);
+		ass_eq(found, scalarFound);
+		ass_true(found > 50 && found < 200);
+		for (I32 i = 0; i < 203; ++i) {
+			ass_eq(results[i], pr.contains(points[i]));
+			ass_eq(results[i], scalarResults[i]);
+		}
+		ass_true(results[200] && results[201] && results[202]);
+
+		/* Every table the CPU runs gives the same results as the scalar one */
+		const ConvexPolyKernels::Table* tables[ConvexPolyKernels::kMaxTables];
+		Size numTables = ConvexPolyKernels::supportedTables(tables);
+		ass_true(tables[0] == &ConvexPolyKernels::table());
+		ass_true(tables[numTables - 1] == &ConvexPolyKernels::scalarTable());
+		for (Size t = 0; t < numTables; ++t) {
+			DMSG("Checking the " << tables[t]->name << " kernels.");
+			found = tables[t]->containsPoints(&pr.pointAt(0), pr.count(), points, 203, results);
+			ass_eq(found, scalarFound);
+			for (I32 i = 0; i < 203; ++i) {
+				ass_eq(results[i], scalarResults[i]);
+				ass_eq(tables[t]->containsPoint(&pr.pointAt(0), pr.count(), points[i]), scalarResults[i]);
+			}
+		}
+
+		/* The same tests with integer polygons */
+		ConvexPoly2<I32> pi(Recti(-10, 10, 20, 20));
+		Point2i ipoints[5] = { Point2i(0, 0), Point2i(-10, 10), Point2i(11, 0),
+									  Point2i(10, -10), Point2i(0, -11) };
+		Boolean iresults[5];
+		found = pi.contains(ipoints, 5, iresults);
+		ass_eq(found, 3);
+		ass_true(iresults[0] && iresults[1] && !iresults[2] && iresults[3] && !iresults[4]);
+
+		FINISH_TEST;
+	}
+
+	void testConvexPolyFindContaining() {
+		BEGIN_TEST;
+
+		ConvexPoly2<Real> square(Rectf(0, 10, 10, 10));
+		Vector<Point2f> vf(4);
+		vf.append(Point2f(0, 10));
+		vf.append(Point2f(10, 0));
+		vf.append(Point2f(0, -10));
+		vf.append(Point2f(-10, 0));
+		ConvexPoly2<Real> diamond(vf);
+		ConvexPoly2<Real> far(Rectf(100, 100, 10, 10));
+
+		const ConvexPoly2<Real>* polys[3] = { &square, &diamond, &far };
+		Boolean results[3];
+		Size found = ConvexPoly2<Real>::findContaining(polys, 3, Point2f(2, 2), results);
+		ass_eq(found, 2);
+		ass_true(results[0] && results[1] && !results[2]);
+
+		found = ConvexPoly2<Real>::findContaining(polys, 3, Point2f(8, 8), results);
+		ass_eq(found, 1);
+		ass_true(results[0] && !results[1] && !results[2]);
+
+		found = ConvexPoly2<Real>::findContaining(polys, 3, Point2f(-9, -9), results);
+		ass_eq(found, 0);
+
+		FINISH_TEST;
+	}
+
+	void testConvexPolyOverlaps() {
+		BEGIN_TEST;
+
+		Vector<Point2f> vf(4);
+		vf.append(Point2f(0, 10));
+		vf.append(Point2f(10, 0));
+		vf.append(Point2f(0, -10));
+		vf.append(Point2f(-10, 0));
+		ConvexPoly2<Real> diamond(vf);
+
+		/* Overlapping bounds, but separated by the edge of the diamond */
+		ConvexPoly2<Real> corner(Rectf(6, 9, 3, 3));
+		ass_false(diamond.overlaps(corner));
+		ass_false(corner.overlaps(diamond));
+
+		/* Touching counts as overlapping, like contains() */
+		ConvexPoly2<Real> touching(Rectf(5, 8, 3, 3));
+		ass_true(diamond.overlaps(touching));
+		ass_true(touching.overlaps(diamond));
+
+		ConvexPoly2<Real> inside(Rectf(-1, 1, 2, 2));
+		ass_true(diamond.overlaps(inside));
+		ass_true(inside.overlaps(diamond));
+
+		ConvexPoly2<Real> around(Rectf(-20, 20, 40, 40));
+		ass_true(diamond.overlaps(around));
+		ass_true(around.overlaps(diamond));
+
+		ConvexPoly2<Real> far(Rectf(30, 0, 3, 3));
+		ass_false(diamond.overlaps(far));
+
+		ConvexPoly2<Real> empty;
+		ass_false(diamond.overlaps(empty));
+
+		ConvexPoly2<I32> a(Recti(0, 10, 10, 10));
+		ConvexPoly2<I32> b(Recti(10, 0, 5, 5));
+		ConvexPoly2<I32> c(Recti(11, 0, 5, 5));
+		ass_true(a.overlaps(b));
+		ass_false(a.overlaps(c));
+
+		FINISH_TEST;
+	}
+
 	void testConvexPolyMoveBottomTo() {
 		BEGIN_TEST;
 
@@ -1487,7 +1624,7 @@ namespace cc {
 		ass_true(approx(original.width(), 8.875) && approx(original.height(), 6.937));
 
 		ConvexPoly2<Real> pr = original;
-		pr.translate(Vec2f(10, -4.5));
+		pr.translate(Vec2(10, -4.5));
 		DMSG("pr = " << pr << ".");		
 		ass_true(approx(pr.top(), 7.663) && approx(pr.bottom(), 0.726) &&
 					approx(pr.left(), 8.198) && approx(pr.right(), 17.073));
@@ -1682,6 +1819,9 @@ int main(int argc, char** argv) {
 	cc::testConvexPolyEquality();
 	cc::testConvexPolyContainsPoint();
 	cc::testConvexPolyContainsPolygon();
+	cc::testConvexPolyContainsPoints();
+	cc::testConvexPolyFindContaining();
+	cc::testConvexPolyOverlaps();
 	cc::testConvexPolyMoveBottomTo();
 	cc::testConvexPolyMoveBottomLeftTo();
 	cc::testConvexPolyMoveBottomRightTo();
@@ -0,0 +1,215 @@
+#include <cstring>
+#include "core/testcore.h"
+#include "core/geometry/rectarray.h"
+#include "core/geometry/rectf.h"
+#include "core/geometry/recti.h"
+
+namespace cc {
+
+	static U32 s_seed = 4321;
+
+	static I32 nextRandom(I32 range) {
+		s_seed = s_seed*1103515245 + 12345;
+		return (I32)((s_seed >> 16) % (U32)range);
+	}
+
+	static Rectf randomRect() {
+		return Rectf((Real)nextRandom(2000) / REAL(4.0), (Real)nextRandom(2000) / REAL(4.0),
+						 (Real)nextRandom(200) / REAL(4.0), (Real)nextRandom(200) / REAL(4.0));
+	}
+
+	void testRectArrayCreateAndAppend() {
+		BEGIN_TEST;
+
+		RectArray<Real> rects;
+		ass_eq(rects.size(), 0);
+		ass_eq(rects.capacity(), 0);
+		ass_true(rects.unionAll().isEmpty());
+
+		for (I32 i = 0; i < 100; ++i) {
+			rects.append(Rectf((Real)i, (Real)i, 10, 20));
+		}
+		ass_eq(rects.size(), 100);
+		ass_true(rects.capacity() >= 100);
+		ass_eq(rects.get(42), Rectf(42, 42, 10, 20));
+		ass_eq(rects.columns().h[99], 20);
+
+		rects.set(42, Rectf(1, 2, 3, 4));
+		ass_eq(rects.get(42), Rectf(1, 2, 3, 4));
+
+		rects.clear();
+		ass_eq(rects.size(), 0);
+
+		FINISH_TEST;
+	}
+
+	void testRectArrayIntersectsAndContains() {
+		BEGIN_TEST;
+
+		RectArray<Real> rects(16);
+		for (I32 i = 0; i < 203; ++i) {
+			rects.append(randomRect());
+		}
+		U32 mask[7];
+		U32 scalarMask[7];
+		ass_eq(RectKernels::maskWords(203), 7);
+
+		for (I32 q = 0; q < 20; ++q) {
+			Rectf query = randomRect();
+			query.setSize(query.width()*4, query.height()*4);
+			Size found = rects.intersects(query, mask);
+			Size scalarFound = RectKernels::scalarTable().intersects(rects.columns(), rects.size(),
+																						query, scalarMask);
+			ass_eq(found, scalarFound);
+			Size count = 0;
+			for (Size i = 0; i < rects.size(); ++i) {
+				ass_eq(RectKernels::isSet(mask, i), rects.get(i).intersects(query));
+				ass_eq(RectKernels::isSet(mask, i), RectKernels::isSet(scalarMask, i));
+				count += rects.get(i).intersects(query) ? 1 : 0;
+			}
+			ass_eq(found, count);
+
+			Point2f point((Real)nextRandom(2000) / REAL(4.0), (Real)nextRandom(2000) / REAL(4.0));
+			found = rects.contains(point, mask);
+			count = 0;
+			for (Size i = 0; i < rects.size(); ++i) {
+				ass_eq(RectKernels::isSet(mask, i), rects.get(i).contains(point));
+				count += rects.get(i).contains(point) ? 1 : 0;
+			}
+			ass_eq(found, count);
+		}
+
+		/* Only touching is not intersecting, as with Rect */
+		RectArray<I32> irects;
+		irects.append(Recti(0, 10, 10, 10));
+		irects.append(Recti(10, 10, 10, 10));
+		irects.append(Recti(5, 5, 10, 10));
+		Size found = irects.intersects(Recti(-10, 10, 20, 20), mask);
+		ass_eq(found, 2);
+		ass_true(RectKernels::isSet(mask, 0) && !RectKernels::isSet(mask, 1) &&
+					RectKernels::isSet(mask, 2));
+
+		FINISH_TEST;
+	}
+
+	void testRectArrayUnionClipTranslate() {
+		BEGIN_TEST;
+
+		RectArray<Real> rects;
+		Rectf expected;
+		for (I32 i = 0; i < 37; ++i) {
+			Rectf r = randomRect();
+			rects.append(r);
+			if (i == 0) {
+				expected = r;
+			} else {
+				expected = Rectf(Point2f(r.left() < expected.left() ? r.left() : expected.left(),
+												 r.top() > expected.top() ? r.top() : expected.top()),
+									  Point2f(r.right() > expected.right() ? r.right() : expected.right(),
+												 r.bottom() < expected.bottom() ? r.bottom() : expected.bottom()));
+			}
+		}
+		ass_eq(rects.unionAll(), expected);
+
+		Rectf clip(100, 400, 300, 250);
+		Rectf original[37];
+		for (Size i = 0; i < rects.size(); ++i) {
+			original[i] = rects.get(i);
+		}
+		rects.clip(clip);
+		for (Size i = 0; i < rects.size(); ++i) {
+			Rectf r = original[i];
+			r.intersect(clip);
+			ass_eq(rects.get(i), r);
+		}
+
+		rects.translate(REAL(1.5), REAL(-2.0));
+		for (Size i = 0; i < rects.size(); ++i) {
+			Rectf r = original[i];
+			r.intersect(clip);
+			ass_eq(rects.get(i), Rectf(r.x() + REAL(1.5), r.y() - REAL(2.0), r.width(), r.height()));
+		}
+
+		RectArray<I32> irects;
+		irects.append(Recti(0, 10, 10, 10));
+		irects.append(Recti(20, 30, 5, 5));
+		ass_eq(irects.unionAll(), Recti(0, 30, 25, 30));
+		irects.clip(Recti(5, 5, 20, 20));
+		ass_eq(irects.get(0), Recti(5, 5, 5, 5));
+		ass_eq(irects.get(1), Recti(0, 0, 0, 0));
+
+		FINISH_TEST;
+	}
+
+	void testRectArrayEveryTable() {
+		BEGIN_TEST;
+
+		/* Every table the CPU runs gives the same results as the scalar one */
+		const RectKernels::Table* tables[RectKernels::kMaxTables];
+		Size numTables = RectKernels::supportedTables(tables);
+		const RectKernels::Table& scalar = RectKernels::scalarTable();
+		ass_true(tables[0] == &RectKernels::table());
+		ass_true(tables[numTables - 1] == &scalar);
+
+		RectArray<Real> original(16);
+		for (I32 i = 0; i < 103; ++i) {
+			original.append(randomRect());
+		}
+		Rectf query = randomRect();
+		query.setSize(query.width()*4, query.height()*4);
+		Rectf clip(100, 400, 300, 250);
+		U32 mask[4];
+		U32 scalarMask[4];
+		F32 ltrb[4];
+		F32 scalarLtrb[4];
+
+		for (Size t = 0; t < numTables; ++t) {
+			const RectKernels::Table& fast = *tables[t];
+			DMSG("Checking the " << fast.name << " kernels.");
+			RectArray<Real> rects(16);
+			RectArray<Real> expected(16);
+			for (Size i = 0; i < original.size(); ++i) {
+				rects.append(original.get(i));
+				expected.append(original.get(i));
+			}
+
+			/* Every count, so each tail length is run */
+			for (Size count = 0; count <= rects.size(); ++count) {
+				ass_eq(fast.intersects(rects.columns(), count, query, mask),
+						 scalar.intersects(expected.columns(), count, query, scalarMask));
+				for (Size i = 0; i < count; ++i) {
+					ass_eq(RectKernels::isSet(mask, i), RectKernels::isSet(scalarMask, i));
+				}
+				ass_eq(fast.contains(rects.columns(), count, query.x(), query.y(), mask),
+						 scalar.contains(expected.columns(), count, query.x(), query.y(), scalarMask));
+				for (Size i = 0; i < count; ++i) {
+					ass_eq(RectKernels::isSet(mask, i), RectKernels::isSet(scalarMask, i));
+				}
+				if (count > 0) {
+					fast.unionAll(rects.columns(), count, ltrb);
+					scalar.unionAll(expected.columns(), count, scalarLtrb);
+					ass_true(memcmp(ltrb, scalarLtrb, sizeof(ltrb)) == 0);
+				}
+			}
+
+			fast.clip(rects.columns(), rects.size(), clip);
+			scalar.clip(expected.columns(), expected.size(), clip);
+			fast.translate(rects.columns(), rects.size(), REAL(1.5), REAL(-2.0));
+			scalar.translate(expected.columns(), expected.size(), REAL(1.5), REAL(-2.0));
+			for (Size i = 0; i < rects.size(); ++i) {
+				ass_eq(rects.get(i), expected.get(i));
+			}
+		}
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testRectArrayCreateAndAppend();
+	cc::testRectArrayIntersectsAndContains();
+	cc::testRectArrayUnionClipTranslate();
+	cc::testRectArrayEveryTable();
+	return 0;
+}
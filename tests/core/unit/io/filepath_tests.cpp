@@ -0,0 +1,72 @@
+#include "core/testcore.h"
+#include <cstdio>
+#include "core/io/filepath.h"
+
+namespace cc {
+
+	void testFilePathAbsolute() {
+		BEGIN_TEST;
+
+		Char cwd[CAT_MAX_CWD_LENGTH];
+		Char expected[CAT_MAX_CWD_LENGTH + 64];
+		getcwd(cwd, CAT_MAX_CWD_LENGTH);
+
+		Char* abs = FilePath::createAbsolutePath("/usr/lib/", NIL);
+		ass_eq(strcmp(abs, "/usr/lib/"), 0);
+		StringUtils::free(abs);
+
+		abs = FilePath::createAbsolutePath("//file.txt", "/usr//");
+		ass_eq(strcmp(abs, "/usr/file.txt"), 0);
+		StringUtils::free(abs);
+
+		abs = FilePath::createAbsolutePath("file.txt", NIL);
+		sprintf(expected, "%s/file.txt", cwd);
+		ass_eq(strcmp(abs, expected), 0);
+		StringUtils::free(abs);
+
+		abs = FilePath::createAbsolutePath("file.txt", "sub/dir/");
+		sprintf(expected, "%s/sub/dir/file.txt", cwd);
+		ass_eq(strcmp(abs, expected), 0);
+		StringUtils::free(abs);
+
+		/* The views do not need to be null terminated */
+		StringView line("data/levels/one.lvl trailing text");
+		StringView parent, name;
+		line.sub(0, 19).split('/', parent, name);
+		abs = FilePath::createAbsolutePath(name, StringView("/root/data"));
+		ass_eq(strcmp(abs, "/root/data/levels/one.lvl"), 0);
+		StringUtils::free(abs);
+
+		FINISH_TEST;
+	}
+
+	void testFilePathViews() {
+		BEGIN_TEST;
+
+		FilePath path(StringView("/home/user/docs/"), StringView("notes.txt plus junk", 9));
+		ass_eq(strcmp(path.absolutePath(), "/home/user/docs/notes.txt"), 0);
+		ass_eq(strcmp(path.path(), "notes.txt"), 0);
+		ass_true(path.nameView() == "notes.txt");
+		ass_true(path.parentPathView() == "/home/user/docs/");
+		ass_eq(strcmp(path.getParentPath(), "/home/user/docs/"), 0);
+
+		path.set(StringView("/tmp"), StringView("dir/"));
+		ass_eq(strcmp(path.absolutePath(), "/tmp/dir/"), 0);
+		ass_true(path.nameView() == "dir/");
+		ass_true(path.parentPathView() == "/tmp/");
+
+		ass_true(FilePath::isAbsolutePath("/a"));
+		ass_true(FilePath::isAbsolutePath(StringView("/a")));
+		ass_false(FilePath::isAbsolutePath("a/b"));
+		ass_false(FilePath::isAbsolutePath(StringView()));
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testFilePathAbsolute();
+	cc::testFilePathViews();
+	return 0;
+}
@@ -0,0 +1,130 @@
+#include <assert.h>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/affinetransform.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+/* The affine paths are checked against the general 4x4 products and inverse */
+
+namespace cc {
+
+	const U32 kNumRuns = 200;
+
+	Real randomReal() {
+		return (Real)(rand() % 20001 - 10000) / REAL(1000.0);
+	}
+
+	Vec3 randomVec3() {
+		return Vec3(randomReal(), randomReal(), randomReal());
+	}
+
+	Quaternion randomRotation() {
+		Quaternion q(randomReal(), randomReal(), randomReal(), randomReal() + REAL(0.1));
+		q.normalise();
+		return q;
+	}
+
+	AffineTransform randomTransform() {
+		Vec3 scale(REAL(0.5) + fabs(randomReal()) / REAL(5.0),
+					  REAL(0.5) + fabs(randomReal()) / REAL(5.0),
+					  REAL(0.5) + fabs(randomReal()) / REAL(5.0));
+		return AffineTransform(randomVec3(), randomRotation(), scale);
+	}
+
+	Boolean near(const Mat4& a, const Mat4& b, Real tolerance) {
+		const Real* ra = a.getMatrixDataConst().m;
+		const Real* rb = b.getMatrixDataConst().m;
+		for (U32 i = 0; i < 16; ++i) {
+			if (fabs(ra[i] - rb[i]) > tolerance*(REAL(1.0) + fabs(rb[i]))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Boolean near(const Vec3& a, const Vec3& b, Real tolerance) {
+		return fabs(a.x - b.x) <= tolerance*(REAL(1.0) + fabs(b.x)) &&
+			fabs(a.y - b.y) <= tolerance*(REAL(1.0) + fabs(b.y)) &&
+			fabs(a.z - b.z) <= tolerance*(REAL(1.0) + fabs(b.z));
+	}
+
+	void testAffineTransformCompose() {
+		BEGIN_TEST;
+
+		for (U32 run = 0; run < kNumRuns; ++run) {
+			AffineTransform a = randomTransform();
+			AffineTransform b = randomTransform();
+			Mat4 ma = a.toMat4();
+			Mat4 mb = b.toMat4();
+			assert(ma.isAffine() && mb.isAffine());
+			assert(AffineTransform(ma) == a);
+
+			Mat4 general = ma*mb;
+			assert(near((a*b).toMat4(), general, REAL(1e-5)));
+			assert(near(ma.composeAffine(mb), general, REAL(1e-5)));
+			assert(ma.composeAffine(mb).isAffine());
+			AffineTransform c(a);
+			c *= b;
+			assert(c == a*b);
+
+			Vec3 p = randomVec3();
+			assert(near(a*p, ma*p, REAL(1e-5)));
+			assert(near(a.rotate(p), ma.rotate(p), REAL(1e-5)));
+			assert(Math::approx(a.determinant(), ma.get3x3Matrix().determinant()));
+		}
+		assert(!Mat4(REAL(1.0)).isAffine());
+
+		FINISH_TEST;
+	}
+
+	void testAffineTransformInverse() {
+		BEGIN_TEST;
+
+		for (U32 run = 0; run < kNumRuns; ++run) {
+			AffineTransform a = randomTransform();
+			Mat4 ma = a.toMat4();
+			Mat4 inv = ma.inverse();
+			assert(inv.isAffine());
+			assert(near(inv.composeAffine(ma), Mat4::kIdentity, REAL(1e-4)));
+			assert(near(a.inverse().toMat4(), inv, REAL(1e-4)));
+			assert(near((a*a.inverse()).toMat4(), Mat4::kIdentity, REAL(1e-4)));
+			assert(Math::approx(ma.determinant(), a.determinant()));
+
+			/* Without a scale the transpose is the inverse */
+			AffineTransform rigid(randomRotation(), randomVec3());
+			Vec3 p = randomVec3();
+			assert(near(rigid.inverseRigid()*(rigid*p), p, REAL(1e-4)));
+			assert(near(rigid.inverseRigid().toMat4(), rigid.inverse().toMat4(), REAL(1e-4)));
+		}
+
+		/* A projection is not affine, and still takes the general path */
+		Mat4 proj(Mat4::kIdentity);
+		proj.getMatrixData().m34 = REAL(-1.0);
+		proj.getMatrixData().m43 = REAL(-2.0);
+		proj.getMatrixData().m44 = REAL(0.0);
+		assert(!proj.isAffine());
+		assert(near(proj*proj.inverse(), Mat4::kIdentity, REAL(1e-5)));
+
+		/* Singular transforms are returned as is */
+		AffineTransform flat(Mat3(REAL(0.0)), Vec3(REAL(1.0), REAL(2.0), REAL(3.0)));
+		assert(flat.inverse() == flat);
+		assert(flat.toMat4().inverse() == flat.toMat4());
+		assert(AffineTransform::kIdentity.toMat4() == Mat4::kIdentity);
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	srand(7);
+	cc::testAffineTransformCompose();
+	cc::testAffineTransformInverse();
+	return 0;
+}
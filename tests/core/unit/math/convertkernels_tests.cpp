@@ -0,0 +1,229 @@
+#include <assert.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/convertkernels.h"
+#include "core/math/vec3h.h"
+#include "core/color/color4h.h"
+#include "core/geometry/rectx.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+
+namespace cc {
+
+	/* Odd count so that every kernel runs its tail loop too */
+	const Size kNumValues = 1003;
+
+	U32 randomBits() {
+		return ((U32)(rand() & 0xFFFF) << 16) | (U32)(rand() & 0xFFFF);
+	}
+
+	Real realFromBits(U32 bits) {
+		Real r;
+		memcpy(&r, &bits, sizeof(Real));
+		return r;
+	}
+
+	Real randomReal() {
+		return (Real)(rand() % 200001 - 100000) / REAL(100.0);
+	}
+
+	void testHalfConversions() {
+		BEGIN_TEST;
+
+		/* Every table the CPU runs gives the same results as the scalar one */
+		const ConvertKernels::Table* tables[ConvertKernels::kMaxTables];
+		Size numTables = ConvertKernels::supportedTables(tables);
+		const ConvertKernels::Table& scalar = ConvertKernels::scalarTable();
+		std::cout << "Using the " << ConvertKernels::table().name << " kernels." << std::endl;
+		assert(tables[0] == &ConvertKernels::table());
+		assert(tables[numTables - 1] == &scalar);
+
+		/* Every half float converts the same way, and survives a round trip */
+		Half* halves = new Half[65536];
+		Real* reals = new Real[65536];
+		Real* expected = new Real[65536];
+		Half* back = new Half[65536];
+		for (U32 i = 0; i < 65536; ++i) {
+			halves[i] = (Half)i;
+		}
+		scalar.halfToReal(halves, expected, 65536);
+		for (Size t = 0; t < numTables; ++t) {
+			const ConvertKernels::Table& fast = *tables[t];
+			std::cout << "Checking the " << fast.name << " kernels." << std::endl;
+			fast.halfToReal(halves, reals, 65536);
+			assert(memcmp(reals, expected, sizeof(Real)*65536) == 0);
+			fast.realToHalf(reals, back, 65536);
+			for (U32 i = 0; i < 65536; ++i) {
+				Boolean isNan = (i & 0x7C00) == 0x7C00 && (i & 0x3FF) != 0;
+				/* NaNs come back quiet */
+				assert(back[i] == (isNan ? (halves[i] | 0x200) : halves[i]));
+				assert(HalfFloat::fromReal(reals[i]) == back[i]);
+			}
+		}
+
+		assert(HalfFloat::fromReal(REAL(1.0)) == HalfFloat::kOne);
+		assert(HalfFloat::fromReal(REAL(65504.0)) == HalfFloat::kMax);
+		assert(HalfFloat::fromReal(REAL(65519.0)) == HalfFloat::kMax);
+		assert(HalfFloat::fromReal(REAL(65520.0)) == 0x7C00);
+		assert(HalfFloat::fromReal(REAL(-1.0e10)) == 0xFC00);
+		assert(HalfFloat::fromReal(REAL(1.0e-8)) == 0);
+		assert(HalfFloat::fromReal(REAL(6.0e-8)) == 1);
+		assert(HalfFloat::toReal(0x3555) == REAL(0.333251953125));
+		/* Ties go to even */
+		assert(HalfFloat::fromReal(REAL(1.0) + REAL(1.0) / 2048) == 0x3C00);
+		assert(HalfFloat::fromReal(REAL(1.0) + REAL(3.0) / 2048) == 0x3C02);
+
+		/* Random bit patterns, which include NaNs, infinities and denormals */
+		Real* src = new Real[kNumValues];
+		Half* fastHalves = new Half[kNumValues];
+		Half* scalarHalves = new Half[kNumValues];
+		for (U32 pass = 0; pass < 2; ++pass) {
+			for (Size i = 0; i < kNumValues; ++i) {
+				src[i] = pass == 0 ? realFromBits(randomBits()) : randomReal() / REAL(1000.0);
+			}
+			scalar.realToHalf(src, scalarHalves, kNumValues);
+			for (Size t = 0; t < numTables; ++t) {
+				tables[t]->realToHalf(src, fastHalves, kNumValues);
+				assert(memcmp(fastHalves, scalarHalves, sizeof(Half)*kNumValues) == 0);
+			}
+		}
+
+		delete[] halves;
+		delete[] reals;
+		delete[] expected;
+		delete[] back;
+		delete[] src;
+		delete[] fastHalves;
+		delete[] scalarHalves;
+		FINISH_TEST;
+	}
+
+	void testFixedConversions() {
+		BEGIN_TEST;
+
+		const ConvertKernels::Table* tables[ConvertKernels::kMaxTables];
+		Size numTables = ConvertKernels::supportedTables(tables);
+		const ConvertKernels::Table& scalar = ConvertKernels::scalarTable();
+
+		Fixed* fixed = new Fixed[kNumValues];
+		Real* reals = new Real[kNumValues];
+		Real* expected = new Real[kNumValues];
+		Fixed* fastFixed = new Fixed[kNumValues];
+		Fixed* scalarFixed = new Fixed[kNumValues];
+		for (Size i = 0; i < kNumValues; ++i) {
+			fixed[i] = (Fixed)randomBits();
+		}
+		scalar.fixedToReal(fixed, expected, kNumValues);
+		for (Size t = 0; t < numTables; ++t) {
+			tables[t]->fixedToReal(fixed, reals, kNumValues);
+			assert(memcmp(reals, expected, sizeof(Real)*kNumValues) == 0);
+		}
+
+		for (U32 pass = 0; pass < 2; ++pass) {
+			for (Size i = 0; i < kNumValues; ++i) {
+				reals[i] = pass == 0 ? randomReal() : realFromBits(randomBits());
+			}
+			scalar.realToFixed(reals, scalarFixed, kNumValues);
+			for (Size t = 0; t < numTables; ++t) {
+				tables[t]->realToFixed(reals, fastFixed, kNumValues);
+				assert(memcmp(fastFixed, scalarFixed, sizeof(Fixed)*kNumValues) == 0);
+			}
+		}
+
+		/* Small values survive a round trip exactly */
+		for (Size i = 0; i < kNumValues; ++i) {
+			fixed[i] = (Fixed)(randomBits() & 0x00FFFFFF) - 0x00800000;
+		}
+		for (Size t = 0; t < numTables; ++t) {
+			tables[t]->fixedToReal(fixed, reals, kNumValues);
+			tables[t]->realToFixed(reals, fastFixed, kNumValues);
+			assert(memcmp(fixed, fastFixed, sizeof(Fixed)*kNumValues) == 0);
+		}
+
+		assert(FixedPoint::fromReal(REAL(1.5)) == 0x18000);
+		assert(FixedPoint::fromReal(REAL(-0.5)) == -0x8000);
+		assert(FixedPoint::fromReal(REAL(0.5) / 65536) == 0);
+		assert(FixedPoint::fromReal(REAL(1.5) / 65536) == 2);
+		assert(FixedPoint::fromReal(REAL(1.0e10)) == 0x7FFFFF80);
+		assert(FixedPoint::fromReal(REAL(-1.0e10)) == (Fixed)0x80000000);
+		assert(FixedPoint::toReal(FixedPoint::fromInt(-3)) == REAL(-3.0));
+		assert(FixedPoint::toInt(FixedPoint::fromReal(REAL(-2.25))) == -3);
+		assert(FixedPoint::mul(FixedPoint::fromReal(REAL(1.5)), FixedPoint::fromReal(REAL(-2.0))) ==
+				 FixedPoint::fromReal(REAL(-3.0)));
+		assert(FixedPoint::div(FixedPoint::fromInt(3), FixedPoint::fromInt(4)) ==
+				 FixedPoint::fromReal(REAL(0.75)));
+
+		delete[] fixed;
+		delete[] reals;
+		delete[] expected;
+		delete[] fastFixed;
+		delete[] scalarFixed;
+		FINISH_TEST;
+	}
+
+	void testCompactTypes() {
+		BEGIN_TEST;
+
+		const Size count = 37;
+		Vec3 vecs[count];
+		Vec3h vecsh[count];
+		Vec3 vecsBack[count];
+		Color4f colors[count];
+		Color4h colorsh[count];
+		Color4f colorsBack[count];
+		Rectf rects[count];
+		Rectx rectsx[count];
+		Rectf rectsBack[count];
+		Point2f points[count];
+		Point2x pointsx[count];
+		Point2f pointsBack[count];
+		for (Size i = 0; i < count; ++i) {
+			vecs[i] = Vec3(randomReal(), randomReal(), randomReal());
+			colors[i] = Color4f(randomReal() / 1000, randomReal() / 1000, randomReal() / 1000, REAL(0.5));
+			rects[i] = Rectf(randomReal(), randomReal(), randomReal(), randomReal());
+			points[i] = Point2f(randomReal(), randomReal());
+		}
+
+		Vec3h::pack(vecs, vecsh, count);
+		Vec3h::unpack(vecsh, vecsBack, count);
+		Color4h::pack(colors, colorsh, count);
+		Color4h::unpack(colorsh, colorsBack, count);
+		Rectx::pack(rects, rectsx, count);
+		Rectx::unpack(rectsx, rectsBack, count);
+		Point2x::pack(points, pointsx, count);
+		Point2x::unpack(pointsx, pointsBack, count);
+		for (Size i = 0; i < count; ++i) {
+			Vec3 v = Vec3h(vecs[i]).toVec3();
+			assert(memcmp(&v, &vecsBack[i], sizeof(Vec3)) == 0);
+			assert(vecsBack[i].x - vecs[i].x < REAL(0.5) && vecs[i].x - vecsBack[i].x < REAL(0.5));
+
+			Color4f c = Color4h(colors[i]).toColor4f();
+			assert(memcmp(&c, &colorsBack[i], sizeof(Color4f)) == 0);
+			assert(colorsBack[i].a == REAL(0.5));
+
+			assert(Rectx(rects[i]) == rectsx[i]);
+			assert(rectsx[i].toRectf() == rectsBack[i]);
+			assert(Point2x(points[i]) == pointsx[i]);
+			assert(pointsx[i].toPoint2f() == pointsBack[i]);
+			/* Hundredths are exact to well within 1/65536 */
+			assert(rectsBack[i].width() - rects[i].width() < REAL(0.0001) &&
+					 rects[i].width() - rectsBack[i].width() < REAL(0.0001));
+		}
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testHalfConversions();
+	cc::testFixedConversions();
+	cc::testCompactTypes();
+	return 0;
+}
@@ -0,0 +1,253 @@
+#include <assert.h>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/mathcore.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+
+namespace cc {
+
+	/* Odd count so that the padded last vector is used too */
+	const Size kNumValues = 100003;
+
+	typedef void (*SpanFunc)(const Real*, Real*, Size, Math::Precision);
+
+	I32 orderedBits(F32 f) {
+		I32 i;
+		memcpy(&i, &f, sizeof(i));
+		return i < 0 ? (I32)0x80000000 - i : i;
+	}
+
+	/* The distance in ulps from the correctly rounded result */
+	F64 ulps(F32 value, F64 expected) {
+		F32 rounded = (F32)expected;
+		if (value == rounded) {
+			return 0.0;
+		}
+		return fabs((F64)orderedBits(value) - (F64)orderedBits(rounded));
+	}
+
+	void fillRange(Real* values, Size count, F32 lo, F32 hi) {
+		for (Size i = 0; i < count; ++i) {
+			values[i] = lo + (hi - lo)*((F32)i / (F32)(count - 1));
+		}
+	}
+
+	F64 maxUlps(SpanFunc func, F64 (*ref)(F64), Math::Precision precision,
+					const Real* values, Real* results) {
+		func(values, results, kNumValues, precision);
+		F64 worst = 0.0;
+		for (Size i = 0; i < kNumValues; ++i) {
+			F64 u = ulps(results[i], ref(values[i]));
+			worst = u > worst ? u : worst;
+		}
+		return worst;
+	}
+
+	F64 maxAbsError(SpanFunc func, F64 (*ref)(F64), Math::Precision precision,
+						 const Real* values, Real* results) {
+		func(values, results, kNumValues, precision);
+		F64 worst = 0.0;
+		for (Size i = 0; i < kNumValues; ++i) {
+			F64 err = fabs(results[i] - ref(values[i]));
+			worst = err > worst ? err : worst;
+		}
+		return worst;
+	}
+
+	F64 refInverseSqrt(F64 x) {
+		return 1.0 / ::sqrt(x);
+	}
+
+	void testMathSinCos() {
+		BEGIN_TEST;
+
+		Real* values = new Real[kNumValues];
+		Real* results = new Real[kNumValues];
+		fillRange(values, kNumValues, REAL(-8000.0), REAL(8000.0));
+		assert(maxAbsError(Math::sin, ::sin, Math::kPrecise, values, results) < 1e-7);
+		assert(maxAbsError(Math::cos, ::cos, Math::kPrecise, values, results) < 1e-7);
+		assert(maxAbsError(Math::sin, ::sin, Math::kFast, values, results) < 1.5e-6);
+		assert(maxAbsError(Math::cos, ::cos, Math::kFast, values, results) < 1.5e-6);
+
+		/* Small angles are not reduced, so are accurate to a couple of ulps */
+		fillRange(values, kNumValues, REAL(-0.78), REAL(0.78));
+		assert(maxUlps(Math::sin, ::sin, Math::kPrecise, values, results) <= 2.0);
+		assert(maxUlps(Math::cos, ::cos, Math::kPrecise, values, results) <= 2.0);
+
+		/* Large angles and non finite values are passed on to libm */
+		Real special[5] = { REAL(1e6), REAL(-3e7), INFINITY, NAN, REAL(-0.0) };
+		Math::sin(special, results, 5);
+		assert(results[0] == ::sinf(special[0]));
+		assert(results[1] == ::sinf(special[1]));
+		assert(results[2] != results[2]);
+		assert(results[3] != results[3]);
+		assert(results[4] == 0 && std::signbit(results[4]));
+
+		delete[] values;
+		delete[] results;
+
+		FINISH_TEST;
+	}
+
+	void testMathExpLog() {
+		BEGIN_TEST;
+
+		Real* values = new Real[kNumValues];
+		Real* results = new Real[kNumValues];
+		fillRange(values, kNumValues, REAL(-103.0), REAL(88.7));
+		assert(maxUlps(Math::exp, ::exp, Math::kPrecise, values, results) <= 1.0);
+		assert(maxUlps(Math::exp, ::exp, Math::kFast, values, results) <= 120.0);
+
+		fillRange(values, kNumValues, REAL(0.001), REAL(1000.0));
+		assert(maxUlps(Math::log, ::log, Math::kPrecise, values, results) <= 1.0);
+		assert(maxUlps(Math::log, ::log, Math::kFast, values, results) <= 190.0);
+		fillRange(values, kNumValues, REAL(0.5), REAL(2.0));
+		assert(maxUlps(Math::log, ::log, Math::kPrecise, values, results) <= 1.0);
+
+		/* Special values follow the C functions */
+		Real special[7] = { REAL(0.0), REAL(-1.0), INFINITY, -INFINITY, NAN, REAL(100.0), REAL(1e-40) };
+		Math::exp(special, results, 7);
+		assert(results[0] == REAL(1.0));
+		assert(results[2] == INFINITY);
+		assert(results[3] == REAL(0.0));
+		assert(results[4] != results[4]);
+		assert(results[5] == INFINITY);
+		Math::log(special, results, 7);
+		assert(results[0] == -INFINITY);
+		assert(results[1] != results[1]);
+		assert(results[2] == INFINITY);
+		assert(results[4] != results[4]);
+		assert(ulps(results[6], ::log(1e-40)) <= 1.0);
+
+		delete[] values;
+		delete[] results;
+
+		FINISH_TEST;
+	}
+
+	void testMathPowInverseSqrt() {
+		BEGIN_TEST;
+
+		Real* values = new Real[kNumValues];
+		Real* exps = new Real[kNumValues];
+		Real* results = new Real[kNumValues];
+		fillRange(values, kNumValues, REAL(0.01), REAL(100.0));
+		for (Size i = 0; i < kNumValues; ++i) {
+			exps[i] = (Real)((I32)(i % 2001) - 1000) / REAL(200.0);
+		}
+		Math::pow(values, exps, results, kNumValues);
+		for (Size i = 0; i < kNumValues; ++i) {
+			F64 expected = ::pow((F64)values[i], (F64)exps[i]);
+			F64 bound = 1.0 + 3.0*fabs(exps[i]*::log(values[i]));
+			assert(ulps(results[i], expected) <= bound);
+		}
+		Math::pow(values, REAL(2.2), results, kNumValues);
+		for (Size i = 0; i < kNumValues; ++i) {
+			assert(ulps(results[i], ::pow((F64)values[i], 2.2)) <=
+					 1.0 + 6.6*fabs(::log(values[i])));
+		}
+
+		/* Negative numbers have real integer powers only */
+		Real x[6] = { REAL(-2.0), REAL(-2.0), REAL(-2.0), REAL(0.0), REAL(0.0), NAN };
+		Real y[6] = { REAL(3.0), REAL(2.0), REAL(0.5), REAL(-1.0), REAL(0.0), REAL(0.0) };
+		Math::pow(x, y, results, 6);
+		assert(Math::approx(results[0], REAL(-8.0)));
+		assert(Math::approx(results[1], REAL(4.0)));
+		assert(results[2] != results[2]);
+		assert(results[3] == INFINITY);
+		assert(results[4] == REAL(1.0));
+		assert(results[5] == REAL(1.0));
+
+		/* Odd and even integer powers past 2^22, up to the last odd float at 2^24 */
+		Real bigX[10] = { REAL(-1.0), REAL(-0.999999), REAL(-1.0), REAL(-1.0), REAL(-1.0),
+								REAL(-1.0), REAL(-1.0), REAL(-1.0), REAL(-1.0), REAL(-1.0) };
+		Real bigY[10] = { REAL(5000001.0), REAL(6000001.0), REAL(8388609.0), INFINITY, -INFINITY,
+								REAL(16777216.0), REAL(4194305.0), REAL(6000000.0), REAL(5000000.5),
+								REAL(16777215.0) };
+		for (U32 p = 0; p < 2; ++p) {
+			Math::Precision precision = p ? Math::kFast : Math::kPrecise;
+			Math::pow(bigX, bigY, results, 10, precision);
+			assert(results[0] == REAL(-1.0));
+			F64 expected = ::pow((F64)bigX[1], (F64)bigY[1]);
+			assert(expected < 0.0);
+			assert(ulps(results[1], expected) <=
+					 (p ? 150.0 : 3.0)*(1.0 + fabs(bigY[1]*::log(-(F64)bigX[1]))));
+			assert(results[2] == REAL(-1.0));
+			assert(results[3] == REAL(1.0));
+			assert(results[4] == REAL(1.0));
+			assert(results[5] == REAL(1.0));
+			assert(results[6] == REAL(-1.0));
+			assert(results[7] == REAL(1.0));
+			assert(results[8] != results[8]);
+			assert(results[9] == REAL(-1.0));
+		}
+
+		fillRange(values, kNumValues, REAL(1e-30), REAL(1e30));
+		assert(maxUlps(Math::inversesqrt, refInverseSqrt, Math::kPrecise, values, results) <= 1.0);
+		assert(maxUlps(Math::inversesqrt, refInverseSqrt, Math::kFast, values, results) <= 4.0);
+		Real special[2] = { REAL(0.0), INFINITY };
+		Math::inversesqrt(special, results, 2, Math::kFast);
+		assert(results[0] == INFINITY && results[1] == REAL(0.0));
+
+		delete[] values;
+		delete[] exps;
+		delete[] results;
+
+		FINISH_TEST;
+	}
+
+	void testMathVectorOverloads() {
+		BEGIN_TEST;
+
+		/* The vector versions give the same results as the arrays, and
+		 * the results do not depend on where a value is in the array */
+		Real values[7] = { REAL(0.1), REAL(0.7), REAL(1.3), REAL(2.9), REAL(5.5), REAL(11.0), REAL(40.0) };
+		Real results[7];
+		Math::sin(values, results, 7);
+		for (Size i = 0; i < 7; ++i) {
+			Real one;
+			Math::sin(values + i, &one, 1);
+			assert(one == results[i]);
+		}
+
+		Vec4 v4(values[0], values[1], values[2], values[3]);
+		Vec4 s4 = Math::sin(v4);
+		assert(s4.x == results[0] && s4.y == results[1] && s4.z == results[2] && s4.w == results[3]);
+		Vec3 s3 = Math::sin(Vec3(values[4], values[5], values[6]));
+		assert(s3.x == results[4] && s3.y == results[5] && s3.z == results[6]);
+		Vec2 s2 = Math::sin(Vec2(values[0], values[1]), Math::kFast);
+		assert(fabs(s2.x - ::sin(values[0])) < 1.5e-6 && fabs(s2.y - ::sin(values[1])) < 1.5e-6);
+
+		Math::exp(values, results, 7);
+		Vec3 e3 = Math::exp(Vec3(values[0], values[1], values[2]));
+		assert(e3.x == results[0] && e3.y == results[1] && e3.z == results[2]);
+		Vec4 p4 = Math::pow(v4, REAL(2.0));
+		assert(ulps(p4.w, (F64)values[3]*values[3]) <= 4.0);
+		Vec3 l3 = Math::log(Vec3(REAL(1.0), REAL(2.0), REAL(4.0)));
+		assert(l3.x == REAL(0.0) && Math::approx(l3.z, REAL(2.0)*l3.y));
+		Vec2 c2 = Math::cos(Vec2(REAL(0.0), REAL(3.14159265)));
+		assert(c2.x == REAL(1.0) && Math::approx(c2.y, REAL(-1.0)));
+		Vec4 r4 = Math::inversesqrt(Vec4(REAL(1.0), REAL(4.0), REAL(16.0), REAL(64.0)));
+		assert(r4 == Vec4(REAL(1.0), REAL(0.5), REAL(0.25), REAL(0.125)));
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testMathSinCos();
+	cc::testMathExpLog();
+	cc::testMathPowInverseSqrt();
+	cc::testMathVectorOverloads();
+	return 0;
+}
@@ -0,0 +1,204 @@
+#include <assert.h>
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/mathkernels.h"
+#include "core/math/mathcore.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+
+namespace cc {
+
+	/* Odd count so that every kernel runs its tail loop too */
+	const Size kNumVectors = 1003;
+	const Size kNumMatrices = 37;
+
+	Real randomReal() {
+		return (Real)(rand() % 20001 - 10000) / REAL(100.0);
+	}
+
+	Vec3 randomVec3() {
+		return Vec3(randomReal(), randomReal(), randomReal());
+	}
+
+	Mat4 randomMat4() {
+		Real m[16];
+		for (U32 i = 0; i < 16; ++i) {
+			m[i] = randomReal();
+		}
+		return Mat4(m);
+	}
+
+	Boolean sameVec3(const Vec3& a, const Vec3& b) {
+		return memcmp(&a, &b, sizeof(Vec3)) == 0;
+	}
+
+	void testMathKernelsTransform() {
+		BEGIN_TEST;
+
+		/* Every table the CPU runs gives the same results as the scalar one */
+		const MathKernels::Table* tables[MathKernels::kMaxTables];
+		Size numTables = MathKernels::supportedTables(tables);
+		const MathKernels::Table& scalar = MathKernels::scalarTable();
+		std::cout << "Using the " << MathKernels::table().name << " kernels." << std::endl;
+		assert(tables[0] == &MathKernels::table());
+		assert(tables[numTables - 1] == &scalar);
+
+		Mat4 m = randomMat4();
+		Vec3* points = new Vec3[kNumVectors];
+		Vec3* expected = new Vec3[kNumVectors];
+		Vec3* result = new Vec3[kNumVectors];
+		Vec4* vecs = new Vec4[kNumVectors];
+		Vec4* expected4 = new Vec4[kNumVectors];
+		Vec4* result4 = new Vec4[kNumVectors];
+		for (Size i = 0; i < kNumVectors; ++i) {
+			points[i] = randomVec3();
+			vecs[i] = Vec4(randomReal(), randomReal(), randomReal(), randomReal());
+		}
+
+		/* Same results as Mat4 * Vec3, bit for bit */
+		scalar.transformVec3(m, points, expected, kNumVectors);
+		for (Size i = 0; i < kNumVectors; ++i) {
+			assert(sameVec3(expected[i], m * points[i]));
+		}
+		scalar.transformVec4(m, vecs, expected4, kNumVectors);
+
+		Real* xs = new Real[kNumVectors*3];
+		Vec3SoA soa(xs, xs + kNumVectors, xs + kNumVectors*2);
+		for (Size t = 0; t < numTables; ++t) {
+			const MathKernels::Table& fast = *tables[t];
+			std::cout << "Checking the " << fast.name << " kernels." << std::endl;
+			fast.transformVec3(m, points, result, kNumVectors);
+			assert(memcmp(result, expected, sizeof(Vec3)*kNumVectors) == 0);
+			fast.transformVec4(m, vecs, result4, kNumVectors);
+			assert(memcmp(result4, expected4, sizeof(Vec4)*kNumVectors) == 0);
+
+			/* Structure of arrays gives the same results as the packed vectors */
+			for (Size i = 0; i < kNumVectors; ++i) {
+				soa.x[i] = points[i].x;
+				soa.y[i] = points[i].y;
+				soa.z[i] = points[i].z;
+			}
+			fast.transformSoA(m, soa, soa, kNumVectors);
+			for (Size i = 0; i < kNumVectors; ++i) {
+				assert(sameVec3(Vec3(soa.x[i], soa.y[i], soa.z[i]), expected[i]));
+			}
+		}
+
+		/* In place */
+		MathKernels::transform(m, points, points, kNumVectors);
+		assert(memcmp(points, expected, sizeof(Vec3)*kNumVectors) == 0);
+
+		delete[] xs;
+		delete[] points;
+		delete[] expected;
+		delete[] result;
+		delete[] vecs;
+		delete[] expected4;
+		delete[] result4;
+
+		FINISH_TEST;
+	}
+
+	void testMathKernelsMultiply() {
+		BEGIN_TEST;
+
+		const MathKernels::Table* tables[MathKernels::kMaxTables];
+		Size numTables = MathKernels::supportedTables(tables);
+		Mat4* lhs = new Mat4[kNumMatrices];
+		Mat4* rhs = new Mat4[kNumMatrices];
+		Mat4* result = new Mat4[kNumMatrices];
+		for (Size i = 0; i < kNumMatrices; ++i) {
+			lhs[i] = randomMat4();
+			rhs[i] = randomMat4();
+		}
+
+		for (Size t = 0; t < numTables; ++t) {
+			tables[t]->multiplyMat4(lhs, rhs, result, kNumMatrices);
+			for (Size i = 0; i < kNumMatrices; ++i) {
+				Mat4 expected = lhs[i] * rhs[i];
+				assert(memcmp(&(result[i]), &expected, sizeof(Mat4)) == 0);
+			}
+		}
+
+		/* In place, on either side */
+		MathKernels::multiply(lhs, rhs, lhs, kNumMatrices);
+		assert(memcmp(lhs, result, sizeof(Mat4)*kNumMatrices) == 0);
+
+		delete[] lhs;
+		delete[] rhs;
+		delete[] result;
+
+		FINISH_TEST;
+	}
+
+	void testMathKernelsNormaliseAndCross() {
+		BEGIN_TEST;
+
+		const MathKernels::Table* tables[MathKernels::kMaxTables];
+		Size numTables = MathKernels::supportedTables(tables);
+		Vec3* a = new Vec3[kNumVectors];
+		Vec3* b = new Vec3[kNumVectors];
+		Vec3* result = new Vec3[kNumVectors];
+		for (Size i = 0; i < kNumVectors; ++i) {
+			a[i] = randomVec3();
+			b[i] = randomVec3();
+		}
+		/* Zero vectors stay zero */
+		a[5] = Vec3::kZero;
+		a[kNumVectors - 1] = Vec3::kZero;
+
+		Real* data = new Real[kNumVectors*6];
+		Vec3SoA sa(data, data + kNumVectors, data + kNumVectors*2);
+		Vec3SoA sb(data + kNumVectors*3, data + kNumVectors*4, data + kNumVectors*5);
+		for (Size t = 0; t < numTables; ++t) {
+			const MathKernels::Table& fast = *tables[t];
+			fast.normaliseVec3(a, result, kNumVectors);
+			for (Size i = 0; i < kNumVectors; ++i) {
+				assert(sameVec3(result[i], Math::normalised(a[i])));
+			}
+			assert(result[5] == Vec3::kZero);
+			assert(Math::approx(Math::length(result[0]), REAL(1.0)));
+
+			fast.crossVec3(a, b, result, kNumVectors);
+			for (Size i = 0; i < kNumVectors; ++i) {
+				assert(sameVec3(result[i], Math::cross(a[i], b[i])));
+			}
+
+			for (Size i = 0; i < kNumVectors; ++i) {
+				sa.x[i] = a[i].x; sa.y[i] = a[i].y; sa.z[i] = a[i].z;
+				sb.x[i] = b[i].x; sb.y[i] = b[i].y; sb.z[i] = b[i].z;
+			}
+			fast.crossSoA(sa, sb, sb, kNumVectors);
+			for (Size i = 0; i < kNumVectors; ++i) {
+				assert(sameVec3(Vec3(sb.x[i], sb.y[i], sb.z[i]), result[i]));
+			}
+			fast.normaliseSoA(sa, sa, kNumVectors);
+			for (Size i = 0; i < kNumVectors; ++i) {
+				assert(sameVec3(Vec3(sa.x[i], sa.y[i], sa.z[i]), Math::normalised(a[i])));
+			}
+		}
+
+		delete[] data;
+		delete[] a;
+		delete[] b;
+		delete[] result;
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	srand(42);
+	cc::testMathKernelsTransform();
+	cc::testMathKernelsMultiply();
+	cc::testMathKernelsNormaliseAndCross();
+	return 0;
+}
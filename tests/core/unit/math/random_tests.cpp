@@ -0,0 +1,287 @@
+#include <assert.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/randomstream.h"
+#include "core/math/mathcore.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+
+namespace cc {
+
+	const Size kNumValues = 100003;
+
+	void testRandomDeterminism() {
+		BEGIN_TEST;
+
+		Random a(42);
+		Random b(42);
+		Random c(43);
+		Boolean differs = false;
+		for (U32 i = 0; i < 1000; ++i) {
+			U32 va = a.nextU32();
+			assert(va == b.nextU32());
+			differs = differs || va != c.nextU32();
+		}
+		assert(differs);
+
+		/* The streams are jumps apart, so start differently */
+		Random s0 = Random::forStream(42, 0);
+		Random s1 = Random::forStream(42, 1);
+		Random s2 = Random::forStream(42, 2);
+		Random expected(42);
+		assert(s0.nextU32() == expected.nextU32());
+		expected = Random(42);
+		expected.longJump();
+		expected.longJump();
+		U32 v1 = s1.nextU32();
+		U32 v2 = s2.nextU32();
+		assert(v1 != v2);
+		assert(v2 == expected.nextU32());
+
+		a.setSeed(42);
+		b = Random(42);
+		assert(a.nextU32() == b.nextU32());
+
+		FINISH_TEST;
+	}
+
+	void assertState(const Random& random, U32 s0, U32 s1, U32 s2, U32 s3) {
+		assert(random.state()[0] == s0);
+		assert(random.state()[1] == s1);
+		assert(random.state()[2] == s2);
+		assert(random.state()[3] == s3);
+	}
+
+	void testRandomKnownAnswers() {
+		BEGIN_TEST;
+
+		/* From the reference xoshiro128starstar.c and splitmix64.c of Blackman and Vigna */
+		const U32 kState[4] = { 1, 2, 3, 4 };
+		const U32 kFirst[8] = { 0x00002D00, 0x00000000, 0x005A7080, 0x04389D80,
+										0x79199D9B, 0x61963B24, 0x4CB9B57A, 0xDE9D7431 };
+		Random random;
+		random.setState(kState);
+		for (U32 i = 0; i < 8; ++i) {
+			assert(random.nextU32() == kFirst[i]);
+		}
+		assertState(random, 0x3320A290, 0xEBDC5E1D, 0x90C43618, 0xE4B42F08);
+
+		random.setState(kState);
+		random.jump();
+		assertState(random, 0xA9765206, 0x797AA168, 0x5B62E331, 0x02ABD971);
+		assert(random.nextU32() == 0x472FA5A7);
+
+		random.setState(kState);
+		random.longJump();
+		assertState(random, 0x6014AF26, 0x7EB5A852, 0x399FBBA1, 0xBE5EBFCE);
+		assert(random.nextU32() == 0xF74B371C);
+
+		/* The seed is expanded by two steps of SplitMix64, low word first */
+		random.setSeed(42);
+		assertState(random, 0x2FEB6E95, 0xBDD73226, 0xB266F103, 0x28EFE333);
+
+		FINISH_TEST;
+	}
+
+	void testRandomRanges() {
+		BEGIN_TEST;
+
+		Random random(7);
+		U32 counts[10];
+		memset(counts, 0, sizeof(counts));
+		Boolean sawMin = false, sawMax = false;
+		for (U32 i = 0; i < 10000; ++i) {
+			U32 v = random.nextU32(10);
+			assert(v < 10);
+			counts[v]++;
+			I32 r = random.nextI32(-3, 3);
+			assert(r >= -3 && r <= 3);
+			sawMin = sawMin || r == -3;
+			sawMax = sawMax || r == 3;
+			Real f = random.nextReal();
+			assert(f >= REAL(0.0) && f < REAL(1.0));
+			f = random.nextReal(REAL(-2.0), REAL(-1.0));
+			assert(f >= REAL(-2.0) && f < REAL(-1.0));
+			random.nextI32((I32)0x80000000, 0x7FFFFFFF);
+		}
+		assert(sawMin && sawMax);
+		for (U32 i = 0; i < 10; ++i) {
+			assert(counts[i] > 900 && counts[i] < 1100);
+		}
+		assert(Random::toUniform(0xFFFFFFFF) < REAL(1.0));
+		assert(Random::toUniform(0) == REAL(0.0));
+
+		Real sum = 0;
+		Real sumSq = 0;
+		for (U32 i = 0; i < 10000; ++i) {
+			Real n = random.nextNormal(REAL(1.0), REAL(2.0));
+			sum += n;
+			sumSq += (n - REAL(1.0))*(n - REAL(1.0));
+			assert(Math::abs(Math::length(random.nextUnitVec2()) - REAL(1.0)) < REAL(0.0001));
+			assert(Math::abs(Math::length(random.nextUnitVec3()) - REAL(1.0)) < REAL(0.0001));
+			Quaternion q = random.nextQuaternion();
+			assert(Math::abs(q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w - REAL(1.0)) < REAL(0.0001));
+		}
+		assert(Math::abs(sum / 10000 - REAL(1.0)) < REAL(0.1));
+		assert(Math::abs(sumSq / 10000 - REAL(4.0)) < REAL(0.3));
+
+		FINISH_TEST;
+	}
+
+	void testRandomStreamKernels() {
+		BEGIN_TEST;
+
+		/* Every table the CPU runs gives the same results as the scalar one */
+		const RandomKernels::Table* tables[RandomKernels::kMaxTables];
+		Size numTables = RandomKernels::supportedTables(tables);
+		const RandomKernels::Table& scalar = RandomKernels::scalarTable();
+		std::cout << "Using the " << RandomKernels::table().name << " kernels." << std::endl;
+		assert(tables[0] == &RandomKernels::table());
+		assert(tables[numTables - 1] == &scalar);
+
+		/* Lane j of a stream is the generator jumped j times */
+		const Size blocks = 101;
+		U32* values = new U32[blocks*8];
+		U32* scalarValues = new U32[blocks*8];
+		RandomStream stream(99);
+		stream.bits(values, blocks*8);
+		Random lane(99);
+		for (Size j = 0; j < 8; ++j) {
+			Random r = lane;
+			for (Size i = 0; i < blocks; ++i) {
+				assert(values[i*8 + j] == r.nextU32());
+			}
+			lane.jump();
+		}
+
+		RandomLanes lanes;
+		for (Size k = 0; k < 4; ++k) {
+			for (Size j = 0; j < 8; ++j) {
+				lanes.s[k][j] = values[k*8 + j] | 1;
+			}
+		}
+		RandomLanes scalarLanes = lanes;
+		scalar.bits(scalarLanes, scalarValues, blocks);
+		Real* reals = new Real[blocks*8];
+		Real* scalarReals = new Real[blocks*8];
+		scalar.uniform(scalarValues, scalarReals, blocks*8 - 3);
+		for (Size t = 0; t < numTables; ++t) {
+			const RandomKernels::Table& fast = *tables[t];
+			std::cout << "Checking the " << fast.name << " kernels." << std::endl;
+			RandomLanes fastLanes = lanes;
+			fast.bits(fastLanes, values, blocks);
+			assert(memcmp(values, scalarValues, sizeof(U32)*blocks*8) == 0);
+			assert(memcmp(&fastLanes, &scalarLanes, sizeof(RandomLanes)) == 0);
+
+			fast.uniform(scalarValues, reals, blocks*8 - 3);
+			assert(memcmp(reals, scalarReals, sizeof(Real)*(blocks*8 - 3)) == 0);
+		}
+
+		delete[] values;
+		delete[] scalarValues;
+		delete[] reals;
+		delete[] scalarReals;
+		FINISH_TEST;
+	}
+
+	void testRandomStreamChunking() {
+		BEGIN_TEST;
+
+		/* The values do not depend on how the calls are split up */
+		Real* whole = new Real[kNumValues];
+		Real* pieces = new Real[kNumValues];
+		RandomStream a(1234);
+		RandomStream b(1234);
+		a.uniform(whole, kNumValues);
+		for (Size i = 0, n = 1; i < kNumValues; i += n, n = n*3 % 301 + 1) {
+			b.uniform(pieces + i, i + n < kNumValues ? n : kNumValues - i);
+		}
+		assert(memcmp(whole, pieces, sizeof(Real)*kNumValues) == 0);
+
+		a.normal(whole, kNumValues, REAL(2.0), REAL(0.5));
+		for (Size i = 0, n = 1; i < kNumValues; i += n, n = n*5 % 511 + 1) {
+			b.normal(pieces + i, i + n < kNumValues ? n : kNumValues - i, REAL(2.0), REAL(0.5));
+		}
+		assert(memcmp(whole, pieces, sizeof(Real)*kNumValues) == 0);
+
+		Real sum = 0;
+		Real sumSq = 0;
+		for (Size i = 0; i < kNumValues; ++i) {
+			sum += whole[i];
+			sumSq += (whole[i] - REAL(2.0))*(whole[i] - REAL(2.0));
+		}
+		assert(Math::abs(sum / kNumValues - REAL(2.0)) < REAL(0.01));
+		assert(Math::abs(sumSq / kNumValues - REAL(0.25)) < REAL(0.01));
+
+		a.uniform(whole, kNumValues, REAL(-1.0), REAL(3.0));
+		sum = 0;
+		for (Size i = 0; i < kNumValues; ++i) {
+			assert(whole[i] >= REAL(-1.0) && whole[i] < REAL(3.0));
+			sum += whole[i];
+		}
+		assert(Math::abs(sum / kNumValues - REAL(1.0)) < REAL(0.02));
+
+		delete[] whole;
+		delete[] pieces;
+		FINISH_TEST;
+	}
+
+	void testRandomStreamSamples() {
+		BEGIN_TEST;
+
+		const Size count = 1001;
+		Vec2* vec2s = new Vec2[count];
+		Vec3* vec3s = new Vec3[count];
+		Quaternion* quats = new Quaternion[count];
+		RandomStream stream(5);
+		stream.unitVec2(vec2s, count);
+		stream.unitVec3(vec3s, count);
+		stream.quaternions(quats, count);
+
+		Vec3 mean;
+		for (Size i = 0; i < count; ++i) {
+			assert(Math::abs(Math::length(vec2s[i]) - REAL(1.0)) < REAL(0.0001));
+			assert(Math::abs(Math::length(vec3s[i]) - REAL(1.0)) < REAL(0.0001));
+			const Quaternion& q = quats[i];
+			assert(Math::abs(q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w - REAL(1.0)) < REAL(0.0001));
+			mean += vec3s[i];
+		}
+		mean /= (Real)count;
+		assert(Math::length(mean) < REAL(0.1));
+
+		/* The samples use the uniforms in order, whatever the chunk size */
+		RandomStream again(5);
+		Vec2* vec2sAgain = new Vec2[count];
+		Vec3* vec3sAgain = new Vec3[count];
+		again.unitVec2(vec2sAgain, 1);
+		again.unitVec2(vec2sAgain + 1, count - 1);
+		again.unitVec3(vec3sAgain, 300);
+		again.unitVec3(vec3sAgain + 300, count - 300);
+		assert(memcmp(vec2s, vec2sAgain, sizeof(Vec2)*count) == 0);
+		assert(memcmp(vec3s, vec3sAgain, sizeof(Vec3)*count) == 0);
+
+		delete[] vec2s;
+		delete[] vec3s;
+		delete[] quats;
+		delete[] vec2sAgain;
+		delete[] vec3sAgain;
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testRandomDeterminism();
+	cc::testRandomKnownAnswers();
+	cc::testRandomRanges();
+	cc::testRandomStreamKernels();
+	cc::testRandomStreamChunking();
+	cc::testRandomStreamSamples();
+	return 0;
+}
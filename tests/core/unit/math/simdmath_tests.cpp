@@ -0,0 +1,221 @@
+#include <assert.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/mat4.h"
+#include "core/math/quaternion.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+/* The same tests are run with and without CAT_SIMD_MATH, the products
+ * must match the scalar formulas exactly, the inverse within a tolerance */
+
+namespace cc {
+
+	const U32 kNumRuns = 200;
+
+	Real randomReal() {
+		return (Real)(rand() % 20001 - 10000) / REAL(1000.0);
+	}
+
+	Mat4 randomMat4() {
+		Real m[16];
+		for (U32 i = 0; i < 16; ++i) {
+			m[i] = randomReal();
+		}
+		return Mat4(m);
+	}
+
+	void toReals(const Mat4& m, Real* out) {
+		memcpy(out, &m, sizeof(Real)*16);
+	}
+
+	/* Invert in double by Gauss-Jordan elimination, false if singular */
+	Boolean referenceInverse(const Mat4& m, F64* inv) {
+		Real src[16];
+		F64 a[16];
+		toReals(m, src);
+		for (U32 i = 0; i < 16; ++i) {
+			a[i] = src[i];
+			inv[i] = (i % 5 == 0) ? 1.0 : 0.0;
+		}
+		/* Element (row r, column c) is at c*4 + r */
+		for (U32 c = 0; c < 4; ++c) {
+			U32 pivot = c;
+			for (U32 r = c + 1; r < 4; ++r) {
+				if (fabs(a[c*4 + r]) > fabs(a[c*4 + pivot])) {
+					pivot = r;
+				}
+			}
+			if (fabs(a[c*4 + pivot]) < 1e-9) {
+				return false;
+			}
+			for (U32 k = 0; k < 4; ++k) {
+				F64 t = a[k*4 + c]; a[k*4 + c] = a[k*4 + pivot]; a[k*4 + pivot] = t;
+				t = inv[k*4 + c]; inv[k*4 + c] = inv[k*4 + pivot]; inv[k*4 + pivot] = t;
+			}
+			F64 p = a[c*4 + c];
+			for (U32 k = 0; k < 4; ++k) {
+				a[k*4 + c] /= p;
+				inv[k*4 + c] /= p;
+			}
+			for (U32 r = 0; r < 4; ++r) {
+				if (r != c) {
+					F64 f = a[c*4 + r];
+					for (U32 k = 0; k < 4; ++k) {
+						a[k*4 + r] -= f*a[k*4 + c];
+						inv[k*4 + r] -= f*inv[k*4 + c];
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	void testSimdMathAlignment() {
+		BEGIN_TEST;
+
+		assert(sizeof(Vec4) == 16);
+		assert(sizeof(Quaternion) == 16);
+		assert(sizeof(Mat4) == 64);
+#if defined (CAT_MATH_SSE)
+		std::cout << "Using the SSE storage." << std::endl;
+		Mat4* mats = new Mat4[3];
+		assert(((Size)mats % 16) == 0);
+		assert(((Size)(mats + 1) % 16) == 0);
+		delete[] mats;
+#endif
+
+		FINISH_TEST;
+	}
+
+	void testSimdMathProducts() {
+		BEGIN_TEST;
+
+		for (U32 run = 0; run < kNumRuns; ++run) {
+			Mat4 a = randomMat4();
+			Mat4 b = randomMat4();
+			Real ra[16], rb[16], rr[16];
+			toReals(a, ra);
+			toReals(b, rb);
+
+			/* Column j of a*b is a times column j of b, summed in order */
+			Real expected[16];
+			for (U32 j = 0; j < 4; ++j) {
+				for (U32 i = 0; i < 4; ++i) {
+					expected[j*4 + i] = (ra[i]*rb[j*4]) + (ra[4 + i]*rb[j*4 + 1]) +
+						(ra[8 + i]*rb[j*4 + 2]) + (ra[12 + i]*rb[j*4 + 3]);
+				}
+			}
+			toReals(a*b, rr);
+			assert(memcmp(rr, expected, sizeof(rr)) == 0);
+			Mat4 c(a);
+			c *= b;
+			toReals(c, rr);
+			assert(memcmp(rr, expected, sizeof(rr)) == 0);
+
+			Vec4 v(randomReal(), randomReal(), randomReal(), randomReal());
+			Vec4 r = a*v;
+			Real ev[4];
+			for (U32 i = 0; i < 4; ++i) {
+				ev[i] = (ra[i]*v.x) + (ra[4 + i]*v.y) + (ra[8 + i]*v.z) + (ra[12 + i]*v.w);
+			}
+			assert(r.x == ev[0] && r.y == ev[1] && r.z == ev[2] && r.w == ev[3]);
+
+			/* Transpose */
+			toReals(a.transposed(), rr);
+			for (U32 i = 0; i < 4; ++i) {
+				for (U32 j = 0; j < 4; ++j) {
+					assert(rr[j*4 + i] == ra[i*4 + j]);
+				}
+			}
+			Mat4 t(a);
+			assert(t.transpose().transpose() == a);
+		}
+
+		FINISH_TEST;
+	}
+
+	void testSimdMathInverse() {
+		BEGIN_TEST;
+
+		/* The error allowed grows with the condition number of the matrix */
+		F64 maxError = 0.0;
+		for (U32 run = 0; run < kNumRuns; ++run) {
+			Mat4 m = randomMat4();
+			F64 expected[16];
+			if (!referenceInverse(m, expected)) {
+				continue;
+			}
+			Real src[16], result[16];
+			toReals(m, src);
+			toReals(m.inverse(), result);
+			F64 normM = 0.0, normInv = 0.0;
+			for (U32 i = 0; i < 16; ++i) {
+				normM = fabs(src[i]) > normM ? fabs(src[i]) : normM;
+				normInv = fabs(expected[i]) > normInv ? fabs(expected[i]) : normInv;
+			}
+			F64 cond = 16.0*normM*normInv;
+			for (U32 i = 0; i < 16; ++i) {
+				F64 err = fabs(result[i] - expected[i]) / (normInv*cond);
+				maxError = err > maxError ? err : maxError;
+			}
+		}
+		std::cout << "Max error of inverse / condition number: " << maxError << std::endl;
+		assert(maxError < 1e-6);
+
+		/* A singular matrix is returned as is */
+		Mat4 singular(REAL(1.0));
+		assert(singular.inverse() == singular);
+
+		/* A simple transform inverts exactly enough to get back the identity */
+		Mat4 tr(Mat4::kIdentity);
+		tr *= REAL(2.0);
+		assert((tr * tr.inverse()).approx(Mat4::kIdentity));
+
+		FINISH_TEST;
+	}
+
+	void testSimdMathQuaternion() {
+		BEGIN_TEST;
+
+		for (U32 run = 0; run < kNumRuns; ++run) {
+			Quaternion q(randomReal(), randomReal(), randomReal(), randomReal());
+			Quaternion r(randomReal(), randomReal(), randomReal(), randomReal());
+			Quaternion p = q*r;
+			/* The Hamilton product, in the order of the scalar code */
+			assert(p.x == (q.w*r.x) + (q.x*r.w) + (q.y*r.z) - (q.z*r.y));
+			assert(p.y == (q.w*r.y) + (q.y*r.w) + (q.z*r.x) - (q.x*r.z));
+			assert(p.z == (q.w*r.z) + (q.z*r.w) + (q.x*r.y) - (q.y*r.x));
+			assert(p.w == (q.w*r.w) - (q.x*r.x) - (q.y*r.y) - (q.z*r.z));
+			Quaternion s(q);
+			s *= r;
+			assert(s == p);
+
+			q.normalise();
+			r.normalise();
+			Quaternion mid = Quaternion::slerp(q, r, REAL(0.5));
+			assert(mid.isUnitLength());
+			assert(Quaternion::slerp(q, r, REAL(0.0)).approx(q));
+			assert(Quaternion::slerp(q, r, REAL(1.0)).approx(r) ||
+					 Quaternion::slerp(q, r, REAL(1.0)).approx(-r));
+		}
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	srand(42);
+	cc::testSimdMathAlignment();
+	cc::testSimdMathProducts();
+	cc::testSimdMathInverse();
+	cc::testSimdMathQuaternion();
+	return 0;
+}
@@ -0,0 +1,252 @@
+#include <assert.h>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#ifndef DEBUG
+#define DEBUG 1
+#endif
+#include "core/math/affinetransform.h"
+#include "core/math/transformhierarchy.h"
+#include "core/threading/asynctaskrunner.h"
+
+#define BEGIN_TEST (std::cout << ">>> BEGINNING " << __FUNCTION__ << std::endl)
+#define FINISH_TEST (std::cout << ">>> FINISHED " << __FUNCTION__ << std::endl << std::endl)
+
+/* The batched updates are checked against one node at a time with Mat4 */
+
+namespace cc {
+
+	/* Not a multiple of four, so the scalar tails are used too */
+	const U32 kNumNodes = 103;
+
+	Real randomReal() {
+		return (Real)(rand() % 20001 - 10000) / REAL(1000.0);
+	}
+
+	Vec3 randomVec3() {
+		return Vec3(randomReal(), randomReal(), randomReal());
+	}
+
+	Quaternion randomRotation() {
+		Quaternion q(randomReal(), randomReal(), randomReal(), randomReal() + REAL(0.1));
+		q.normalise();
+		return q;
+	}
+
+	Vec3 randomScale() {
+		return Vec3(REAL(0.5) + fabs(randomReal()) / REAL(20.0),
+						REAL(0.5) + fabs(randomReal()) / REAL(20.0),
+						REAL(0.5) + fabs(randomReal()) / REAL(20.0));
+	}
+
+	Boolean near(const Mat4& a, const Mat4& b, Real tolerance) {
+		const Real* ra = a.getMatrixDataConst().m;
+		const Real* rb = b.getMatrixDataConst().m;
+		for (U32 i = 0; i < 16; ++i) {
+			if (fabs(ra[i] - rb[i]) > tolerance*(REAL(1.0) + fabs(rb[i]))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Boolean near(const Quaternion& a, const Quaternion& b, Real tolerance) {
+		return fabs(a.x - b.x) <= tolerance && fabs(a.y - b.y) <= tolerance &&
+			fabs(a.z - b.z) <= tolerance && fabs(a.w - b.w) <= tolerance;
+	}
+
+	/* Three subtrees, added depth first, with a random parent in the subtree */
+	void buildHierarchy(TransformHierarchy& h) {
+		U32 root = 0;
+		for (U32 i = 0; i < kNumNodes; ++i) {
+			U32 parent = TransformHierarchy::kNoParent;
+			if (i == 0 || i == 40 || i == 77) {
+				root = i;
+			} else {
+				parent = root + (U32)(rand() % (i - root));
+			}
+			assert(h.addNode(parent, randomVec3(), randomRotation(), randomScale()) == i);
+		}
+	}
+
+	void testTransformHierarchyUpdate() {
+		BEGIN_TEST;
+
+		TransformHierarchy h(kNumNodes);
+		buildHierarchy(h);
+		assert(h.size() == kNumNodes);
+		h.updateWorld();
+
+		Mat4* expected = new Mat4[kNumNodes];
+		for (U32 i = 0; i < kNumNodes; ++i) {
+			Mat4 local = AffineTransform(h.getTranslation(i), h.getRotation(i),
+												  h.getScale(i)).toMat4();
+			U32 parent = h.getParent(i);
+			expected[i] = (parent == TransformHierarchy::kNoParent) ? local : expected[parent]*local;
+			assert(near(h.getWorld(i), expected[i], REAL(1e-4)));
+			assert(h.getWorld(i).isAffine());
+		}
+		assert(h.getNumSubtrees() == 3);
+		/* Updating again after changing a root moves its whole subtree */
+		h.setLocal(40, Vec3(REAL(1.0), REAL(2.0), REAL(3.0)), Quaternion::kIdentity,
+					  Vec3(REAL(1.0), REAL(1.0), REAL(1.0)));
+		h.updateWorld(NIL);
+		Mat4 moved(Mat4::kIdentity);
+		moved.getMatrixData().m41 = REAL(1.0);
+		moved.getMatrixData().m42 = REAL(2.0);
+		moved.getMatrixData().m43 = REAL(3.0);
+		assert(h.getWorld(40) == moved);
+		assert(near(h.getWorld(0), expected[0], REAL(1e-4)));
+		delete[] expected;
+
+		FINISH_TEST;
+	}
+
+	void testTransformHierarchySubtrees() {
+		BEGIN_TEST;
+
+		/* A node that reaches back past a root joins the two subtrees */
+		TransformHierarchy h(8);
+		assert(h.addNode(TransformHierarchy::kNoParent) == 0);
+		assert(h.addNode(0) == 1);
+		assert(h.addNode(TransformHierarchy::kNoParent) == 2);
+		assert(h.addNode(2) == 3);
+		assert(h.addNode(TransformHierarchy::kNoParent) == 4);
+		assert(h.getNumSubtrees() == 3);
+		assert(h.addNode(1) == 5);
+		assert(h.getNumSubtrees() == 1);
+		assert(h.addNode(TransformHierarchy::kNoParent) == 6);
+		assert(h.getNumSubtrees() == 2);
+
+		/* Parents must come first, and the capacity is fixed */
+		assert(h.addNode(9) == TransformHierarchy::kNoParent);
+		assert(h.addNode(7) == TransformHierarchy::kNoParent);
+		assert(h.addNode(6) == 7);
+		assert(h.addNode(0) == TransformHierarchy::kNoParent);
+		assert(h.size() == 8);
+		h.clear();
+		assert(h.size() == 0 && h.getNumSubtrees() == 0);
+
+		FINISH_TEST;
+	}
+
+	void testTransformHierarchyInterpolate() {
+		BEGIN_TEST;
+
+		TransformHierarchy from(kNumNodes);
+		TransformHierarchy to(kNumNodes);
+		TransformHierarchy pose(kNumNodes);
+		buildHierarchy(from);
+		for (U32 i = 0; i < kNumNodes; ++i) {
+			to.addNode(from.getParent(i), randomVec3(), randomRotation(), randomScale());
+			pose.addNode(from.getParent(i));
+		}
+		/* Some rotations close together, and some the long way around */
+		to.setLocal(5, to.getTranslation(5), from.getRotation(5), to.getScale(5));
+		to.setLocal(6, to.getTranslation(6), -from.getRotation(6), to.getScale(6));
+
+		Real ts[3] = { REAL(0.0), REAL(0.3), REAL(1.0) };
+		for (U32 k = 0; k < 3; ++k) {
+			Real t = ts[k];
+			pose.interpolate(from, to, t, TransformHierarchy::kSlerp);
+			for (U32 i = 0; i < kNumNodes; ++i) {
+				Quaternion expected = Quaternion::slerp(from.getRotation(i), to.getRotation(i), t);
+				expected.normalise();
+				assert(near(pose.getRotation(i), expected, REAL(1e-5)));
+				assert(Math::approx(pose.getTranslation(i),
+										  from.getTranslation(i)*(REAL(1.0) - t) + to.getTranslation(i)*t));
+			}
+
+			pose.interpolate(from, to, t);
+			for (U32 i = 0; i < kNumNodes; ++i) {
+				Quaternion a = from.getRotation(i);
+				Quaternion b = to.getRotation(i);
+				if (a.dotProduct(b) < 0) {
+					b = -b;
+				}
+				Quaternion expected = Quaternion::lerp(a, b, t);
+				expected.normalise();
+				assert(near(pose.getRotation(i), expected, REAL(1e-5)));
+				assert(pose.getRotation(i).isUnitLength());
+			}
+		}
+		pose.updateWorld();
+
+		/* Hierarchies of different sizes are not blended */
+		TransformHierarchy small(1);
+		small.addNode(TransformHierarchy::kNoParent);
+		small.interpolate(from, to, REAL(0.5));
+		assert(small.getRotation(0) == Quaternion::kIdentity);
+
+		FINISH_TEST;
+	}
+
+
+	void testTransformHierarchyUpdateParallel() {
+		BEGIN_TEST;
+
+		/* Many subtrees, each a long chain with a bushy tail */
+		const U32 kNumSubtrees = 64;
+		const U32 kSubtreeSize = 50;
+		const U32 kChainLength = 30;
+		const U32 kTotal = kNumSubtrees*kSubtreeSize;
+		TransformHierarchy parallel(kTotal);
+		TransformHierarchy serial(kTotal);
+		for (U32 s = 0; s < kNumSubtrees; ++s) {
+			U32 root = s*kSubtreeSize;
+			for (U32 i = 0; i < kSubtreeSize; ++i) {
+				U32 parent = TransformHierarchy::kNoParent;
+				if (i > 0 && i < kChainLength) {
+					parent = root + i - 1;
+				} else if (i > 0) {
+					parent = root + (U32)(rand() % i);
+				}
+				Vec3 translation = randomVec3();
+				Quaternion rotation = randomRotation();
+				Vec3 scale = randomScale();
+				assert(parallel.addNode(parent, translation, rotation, scale) == root + i);
+				assert(serial.addNode(parent, translation, rotation, scale) == root + i);
+			}
+		}
+		assert(parallel.getNumSubtrees() == kNumSubtrees);
+
+		AsyncTaskRunner* runner = new AsyncTaskRunner(4);
+		for (U32 run = 0; run < 4; ++run) {
+			parallel.updateWorld(runner);
+			serial.updateWorld();
+			/* The same arithmetic on each node, so the results are identical */
+			for (U32 i = 0; i < kTotal; ++i) {
+				assert(parallel.getWorld(i) == serial.getWorld(i));
+			}
+			/* Move a few roots and chain nodes before the next update */
+			for (U32 k = 0; k < 8; ++k) {
+				U32 node = (U32)(rand() % kTotal);
+				Vec3 translation = randomVec3();
+				Quaternion rotation = randomRotation();
+				parallel.setLocal(node, translation, rotation, parallel.getScale(node));
+				serial.setLocal(node, translation, rotation, serial.getScale(node));
+			}
+		}
+
+		/* A stopped runner takes no subtrees, so the caller updates them all */
+		runner->stop();
+		parallel.updateWorld(runner);
+		serial.updateWorld();
+		for (U32 i = 0; i < kTotal; ++i) {
+			assert(parallel.getWorld(i) == serial.getWorld(i));
+		}
+		delete runner;
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	srand(11);
+	cc::testTransformHierarchyUpdate();
+	cc::testTransformHierarchySubtrees();
+	cc::testTransformHierarchyInterpolate();
+	cc::testTransformHierarchyUpdateParallel();
+	return 0;
+}
@@ -0,0 +1,129 @@
+#include "core/testcore.h"
+#include "core/string/hungrybuffer.h"
+
+namespace cc {
+
+	void testHungryTemplateCreateAndDestroy() {
+		BEGIN_TEST;
+
+		HungryTemplate t;
+		ass_eq(t.baseString(), NIL);
+		ass_true(t.isEmpty());
+		ass_eq(t.numParams(), 0);
+		ass_eq(t.numSegments(), 0);
+		ass_eq(t.literalLength(), 0);
+
+		t = HungryTemplate("/user/%/dir/%/config.conf");
+		ass_eq(strcmp(t.baseString(), "/user/%/dir/%/config.conf"), 0);
+		ass_false(t.isEmpty());
+		ass_eq(t.numParams(), 2);
+		ass_eq(t.numSegments(), 3);
+		ass_eq(t.literalLength(), 23);
+		ass_eq(t.segmentLength(0), 6);
+		ass_eq(strncmp(t.segmentText(0), "/user/", 6), 0);
+		ass_eq(t.segmentLength(1), 5);
+		ass_eq(strncmp(t.segmentText(1), "/dir/", 5), 0);
+		ass_eq(t.segmentLength(2), 12);
+		ass_eq(strncmp(t.segmentText(2), "/config.conf", 12), 0);
+
+		HungryTemplate t2("%%%/dir/file.file%%%");
+		ass_eq(t2.numParams(), 2);
+		ass_eq(t2.segmentLength(0), 1);
+		ass_eq(strncmp(t2.segmentText(0), "%", 1), 0);
+		ass_eq(t2.segmentLength(1), 15);
+		ass_eq(strncmp(t2.segmentText(1), "/dir/file.file%", 15), 0);
+		ass_eq(t2.segmentLength(2), 0);
+
+		HungryTemplate t3 = t2;
+		ass_eq(strcmp(t3.baseString(), "%%%/dir/file.file%%%"), 0);
+		ass_eq(t3.numParams(), 2);
+		ass_eq(t3.literalLength(), 16);
+
+		FINISH_TEST;
+	}
+
+	void testHungryBufferFeedStrings() {
+		BEGIN_TEST;
+
+		HungryTemplate t("/user/%/dir/%/config.conf");
+		HungryBuffer b(&t, 256);
+		ass_eq(b.getTemplate(), &t);
+		ass_false(b.isFull());
+		ass_eq(b.maxLength(), 256);
+		ass_eq(b.remainingFeeds(), 2);
+		ass_eq(b.cStr(), NIL);
+
+		b.feed("Meow1");
+		ass_false(b.isFull());
+		ass_eq(b.remainingFeeds(), 1);
+		ass_eq(b.cStr(), NIL);
+
+		b.feed(String("moooo"));
+		ass_true(b.isFull());
+		ass_eq(b.remainingFeeds(), 0);
+		ass_eq(strcmp(b.cStr(), "/user/Meow1/dir/moooo/config.conf"), 0);
+		ass_eq(b.length(), 33);
+
+		b.feed("Moasasdasd");
+		ass_eq(strcmp(b.cStr(), "/user/Meow1/dir/moooo/config.conf"), 0);
+
+		/* Same buffer and template, fed again */
+		b.reset().feed("%Cat%").feed("%Dog%");
+		ass_eq(strcmp(b.cStr(), "/user/%Cat%/dir/%Dog%/config.conf"), 0);
+
+		HungryBuffer b2 = b;
+		b.reset();
+		ass_eq(b.cStr(), NIL);
+		ass_eq(strcmp(b2.cStr(), "/user/%Cat%/dir/%Dog%/config.conf"), 0);
+
+		HungryTemplate none("/user/dir/config.conf");
+		HungryBuffer b3(&none, 64);
+		ass_true(b3.isFull());
+		ass_eq(strcmp(b3.cStr(), "/user/dir/config.conf"), 0);
+
+		HungryTemplate usr("/usr/%%%/meow");
+		HungryBuffer b4(&usr, 8);
+		b4.feed("Mooooo%");
+		ass_true(b4.isFull());
+		ass_eq(strcmp(b4.cStr(), "/usr/%M"), 0);
+		ass_eq(b4.length(), 7);
+
+		/* No storage at all, feeding writes nothing */
+		HungryBuffer b5(&t, 0);
+		b5.feed("Meow1").feed("moooo");
+		ass_false(b5.isFull());
+		ass_eq(b5.cStr(), NIL);
+		ass_eq(b5.length(), 0);
+
+		FINISH_TEST;
+	}
+
+	void testHungryBufferFeedNumbers() {
+		BEGIN_TEST;
+
+		HungryTemplate t("%,%,%,%,%");
+		HungryBuffer b(&t, 256);
+
+		b.feed(0).feed(-42).feed((U64)18446744073709551615ULL)
+			.feed((I64)(-9223372036854775807LL - 1)).feed(1234567890U);
+		ass_eq(strcmp(b.cStr(),
+						  "0,-42,18446744073709551615,-9223372036854775808,1234567890"), 0);
+
+		b.reset().feed(1.5).feed(-0.25).feed(100.0).feed(3.14159265, 3).feed(-0.0000001);
+		ass_eq(strcmp(b.cStr(), "1.5,-0.25,100,3.142,0"), 0);
+
+		b.reset().feed(0.999999999).feed(2.0f).feed(1.0e20, 2).feed(99).feed(7);
+		ass_eq(strcmp(b.cStr(), "1,2,1e+20,99,7"), 0);
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testHungryTemplateCreateAndDestroy();
+	cc::testHungryBufferFeedStrings();
+	cc::testHungryBufferFeedNumbers();
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include "core/testcore.h"
+#include "core/string/internedstring.h"
+#include <cstdio>
+
+namespace cc {
+
+	void testInternedStringIdentity() {
+		BEGIN_TEST;
+
+		Char buffer[32];
+		strcpy(buffer, "taskRunnerOne");
+		InternedString a("taskRunnerOne");
+		InternedString b(buffer);
+		InternedString c("taskRunnerTwo");
+		ass_true(a == b);
+		ass_true(a != c);
+		ass_eq(a.cStr(), b.cStr());
+		ass_neq((const Char*)buffer, b.cStr());
+		ass_eq(strcmp(a.cStr(), "taskRunnerOne"), 0);
+		ass_eq(a.length(), 13);
+		ass_eq(a.oID(), crc32("taskRunnerOne"));
+		ass_eq(c.oID(), crc32("taskRunnerTwo"));
+
+		InternedString sub("taskRunnerOneAndMore", 13);
+		ass_true(sub == a);
+
+		InternedString nothing;
+		ass_true(nothing.isNull());
+		ass_eq(nothing.oID(), 0);
+		ass_eq(nothing.length(), 0);
+		ass_true(nothing.cStr() == NIL);
+
+		InternedString empty("");
+		ass_false(empty.isNull());
+		ass_eq(empty.length(), 0);
+		ass_eq(empty.oID(), crc32(""));
+
+		FINISH_TEST;
+	}
+
+	void testInternedStringFind() {
+		BEGIN_TEST;
+
+		InternedString missing = StringInterner::find("neverInternedName");
+		ass_true(missing.isNull());
+		InternedString added = StringInterner::intern("neverInternedName");
+		InternedString found = StringInterner::find("neverInternedName");
+		ass_false(found.isNull());
+		ass_true(found == added);
+
+		FINISH_TEST;
+	}
+
+	void testInternedStringGrowth() {
+		BEGIN_TEST;
+
+		Size before = StringInterner::numStrings();
+		InternedString handles[2000];
+		Char name[32];
+		for (I32 i = 0; i < 2000; ++i) {
+			sprintf(name, "process_%d", i);
+			handles[i] = StringInterner::intern(name);
+		}
+		Size after = StringInterner::numStrings();
+		ass_eq(after - before, 2000);
+		
+		/* Handles taken before the table grew must still match */
+		for (I32 i = 0; i < 2000; ++i) {
+			sprintf(name, "process_%d", i);
+			InternedString again(name);
+			ass_true(again == handles[i]);
+			ass_eq(again.oID(), crc32(name));
+		}
+		ass_eq(StringInterner::numStrings(), after);
+
+		/* A string larger than a chunk gets its own allocation */
+		Char* big = new Char[40000];
+		memset(big, 'x', 39999);
+		big[39999] = '\0';
+		InternedString bigOne(big);
+		ass_eq(bigOne.length(), 39999);
+		ass_true(bigOne == StringInterner::find(big));
+		ass_true(handles[0] == StringInterner::find("process_0"));
+		delete[] big;		
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testInternedStringIdentity();
+	cc::testInternedStringFind();
+	cc::testInternedStringGrowth();
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include "core/testcore.h"
+#include "core/string/rope.h"
+#include "core/string/stringutils.h"
+#include "core/io/outputstream.h"
+
+namespace cc {
+
+	/* An OutputStream that writes into a fixed buffer */
+	class BufferOutputStream : public OutputStream {
+	  public:
+		BufferOutputStream() : m_length(0) {}
+		virtual Size write(const void* buffer, Size toWrite) {
+			memcpy(m_buffer + m_length, buffer, toWrite);
+			m_length += toWrite;
+			return toWrite;
+		}
+		virtual Size write(const void* buffer, Size count, Size size) {
+			return write(buffer, count * size);
+		}
+		virtual void flush() {}
+		virtual void close() {}
+		virtual StreamDescriptor* getStreamDescriptor() { return NIL; }
+		virtual Boolean canWrite() { return true; }
+
+		Char m_buffer[16384];
+		Size m_length;
+	};
+
+	static Boolean ropeEquals(const Rope& rope, const Char* expected) {
+		Char* str = rope.toCString();
+		Boolean equal = (strcmp(str, expected) == 0 && rope.length() == strlen(expected));
+		StringUtils::free(str);
+		return equal;
+	}
+
+	void testRopeEdits() {
+		BEGIN_TEST;
+
+		Rope empty;
+		ass_true(empty.isEmpty());
+		ass_true(ropeEquals(empty, ""));
+
+		Rope rope(StringView("Hello world"));
+		rope.insert(5, StringView(","));
+		ass_true(ropeEquals(rope, "Hello, world"));
+		rope.append(StringView("!"));
+		ass_true(ropeEquals(rope, "Hello, world!"));
+		rope.insert(0, StringView(">> "));
+		ass_true(ropeEquals(rope, ">> Hello, world!"));
+		ass_eq(rope.charAt(3), 'H');
+
+		Rope copy = rope;
+		rope.erase(2, 8);
+		ass_true(ropeEquals(rope, ">>world!"));
+		ass_true(ropeEquals(copy, ">> Hello, world!"));
+		ass_true(ropeEquals(copy.sub(3, 5), "Hello"));
+		ass_true(ropeEquals(copy.sub(9, 100), " world!"));
+		ass_true(copy.sub(100, 1).isEmpty());
+
+		rope.erase(0, 100);
+		ass_true(rope.isEmpty());
+
+		FINISH_TEST;
+	}
+
+	void testRopeLarge() {
+		BEGIN_TEST;
+
+		/* Mirror every edit on a flat buffer */
+		const Size maxLength = 16000;
+		Char* flat = new Char[maxLength + 1];
+		Size length = 0;
+		flat[0] = '\0';
+		Rope rope;
+		U32 seed = 12345;
+		Char text[64];
+
+		for (I32 i = 0; i < 2000; ++i) {
+			seed = seed * 1103515245 + 12345;
+			Size pos = length ? (seed >> 8) % (length + 1) : 0;
+			if ((seed & 3) != 0 && length + 40 < maxLength) {
+				Size n = 1 + (seed >> 4) % 40;
+				for (Size j = 0; j < n; ++j) {
+					text[j] = (Char)('a' + (i + j) % 26);
+				}
+				rope.insert(pos, StringView(text, n));
+				memmove(flat + pos + n, flat + pos, length - pos + 1);
+				memcpy(flat + pos, text, n);
+				length += n;
+			} else {
+				Size n = (seed >> 12) % 30;
+				if (n > length - pos) { n = length - pos; }
+				rope.erase(pos, n);
+				memmove(flat + pos, flat + pos + n, length - pos - n + 1);
+				length -= n;
+			}
+		}
+		ass_eq(rope.length(), length);
+		ass_true(ropeEquals(rope, flat));
+		ass_lt(rope.depth(), CAT_ROPE_MAX_DEPTH + 1);
+		for (Size i = 0; i < length; i += 97) {
+			ass_eq(rope.charAt(i), flat[i]);
+		}
+
+		rope.rebalance();
+		ass_true(ropeEquals(rope, flat));
+
+		BufferOutputStream stream;
+		Size written = rope.writeTo(stream);
+		ass_eq(written, length);
+		ass_eq(memcmp(stream.m_buffer, flat, length), 0);
+
+		/* A large block is split into full leaves */
+		Rope big(StringView(flat, length));
+		ass_true(ropeEquals(big, flat));
+		ass_gt(big.depth(), 0);
+		delete[] flat;
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testRopeEdits();
+	cc::testRopeLarge();
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "core/testcore.h"
+#include "core/string/stringbuilder.h"
+#include "core/string/stringutils.h"
+#include "core/io/outputstream.h"
+
+namespace cc {
+
+	/* An OutputStream that writes into a fixed buffer */
+	class BufferOutputStream : public OutputStream {
+	  public:
+		BufferOutputStream() : m_length(0), m_numWrites(0) {}
+		virtual Size write(const void* buffer, Size toWrite) {
+			memcpy(m_buffer + m_length, buffer, toWrite);
+			m_length += toWrite;
+			++m_numWrites;
+			return toWrite;
+		}
+		virtual Size write(const void* buffer, Size count, Size size) {
+			return write(buffer, count * size);
+		}
+		virtual void flush() {}
+		virtual void close() {}
+		virtual StreamDescriptor* getStreamDescriptor() { return NIL; }
+		virtual Boolean canWrite() { return true; }
+
+		Char m_buffer[65536];
+		Size m_length;
+		Size m_numWrites;
+	};
+
+	void testStringBuilderAppend() {
+		BEGIN_TEST;
+
+		StringBuilder builder(8);
+		ass_true(builder.isEmpty());
+		builder << "Frame " << (I32)-12 << ": " << (U64)18446744073709551615ULL
+				  << ' ' << 3.25 << ", " << String("done");
+		builder.append('.', 3);
+		builder.append(StringView("xyz--", 3));
+		
+		const Char* expected = "Frame -12: 18446744073709551615 3.25, done...xyz";
+		ass_eq(builder.length(), strlen(expected));
+		ass_gt(builder.numChunks(), 1);
+
+		Char* str = builder.toCString();
+		ass_eq(strcmp(str, expected), 0);
+		StringUtils::free(str);
+
+		String out;
+		builder.toString(out);
+		ass_true(out == expected);
+		ass_eq(out.length(), strlen(expected));
+
+		StringPtr ptr = builder.toString();
+		ass_true(*ptr == expected);
+
+		FINISH_TEST;
+	}
+
+	void testStringBuilderLarge() {
+		BEGIN_TEST;
+
+		StringBuilder builder;
+		for (I32 i = 0; i < 5000; ++i) {
+			builder << "line " << i << '\n';
+		}
+		Size length = builder.length();
+		Char* str = builder.toCString();
+		ass_eq(strlen(str), length);
+		ass_true(StringUtils::startsWith(str, "line 0\nline 1\nline 2\n"));
+		ass_eq(strcmp(str + length - 10, "line 4999\n"), 0);
+
+		BufferOutputStream stream;
+		Size written = builder.writeTo(stream);
+		ass_eq(written, length);
+		ass_eq(stream.m_numWrites, builder.numChunks());
+		ass_eq(memcmp(stream.m_buffer, str, length), 0);
+		StringUtils::free(str);
+
+		/* Clearing keeps the chunks to reuse */
+		Size numChunks = builder.numChunks();
+		builder.clear();
+		ass_true(builder.isEmpty());
+		for (I32 i = 0; i < 5000; ++i) {
+			builder << "line " << i << '\n';
+		}
+		ass_eq(builder.length(), length);
+		ass_eq(builder.numChunks(), numChunks);
+		str = builder.toCString();
+		ass_eq(strcmp(str + length - 10, "line 4999\n"), 0);
+		StringUtils::free(str);
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testStringBuilderAppend();
+	cc::testStringBuilderLarge();
+	return 0;
+}
@@ -0,0 +1,147 @@
+#include "core/testcore.h"
+#include "core/string/stringutils.h"
+
+namespace cc {
+
+	/* Every table the CPU runs is checked against the scalar one */
+	static const StringKernels::Table& scalar = StringKernels::scalarTable();
+	static const StringKernels::Table* tables[StringKernels::kMaxTables];
+	static const Size numTables = StringKernels::supportedTables(tables);
+
+	void testStringUtilsUnicodeLengthAndFind() {
+		BEGIN_TEST;
+
+		std::cout << "Using string kernels: " << StringKernels::table().name << std::endl;
+		ass_true(tables[0] == &StringKernels::table());
+		ass_true(tables[numTables - 1] == &scalar);
+
+		U16 buffer[300];
+		for (Size t = 0; t < numTables; ++t) {
+			const StringKernels::Table& fast = *tables[t];
+			DMSG("Checking the " << fast.name << " kernels.");
+			/* Every alignment and length, including across vector boundaries */
+			for (Size start = 0; start < 20; ++start) {
+				for (Size len = 0; len < 100; ++len) {
+					U16* str = &(buffer[start]);
+					for (Size i = 0; i < len; ++i) {
+						str[i] = (U16)(0x100 + (i % 7));
+					}
+					str[len] = 0;
+					ass_eq(StringUtils::length(str), len);
+					ass_eq(fast.length16(str), scalar.length16(str));
+					ass_eq(fast.find16(str, 0x106), scalar.find16(str, 0x106));
+					ass_eq(fast.find16(str, 0x107), NIL);
+					ass_eq(fast.find16(str, 0), &(str[len]));
+					ass_eq(fast.findLast16(str, len, 0x100), scalar.findLast16(str, len, 0x100));
+					ass_eq(StringUtils::lastIndexOf(str, (U16)0x101),
+							 (len > 1) ? (I32)(((len - 2) / 7) * 7 + 1) : -1);
+				}
+			}
+		}
+		ass_eq(StringUtils::length((const U16*)NIL), 0);
+		ass_eq(StringUtils::find((const U16*)NIL, (U16)'a'), NIL);
+
+		FINISH_TEST;
+	}
+
+	void testStringUtilsUnicodeCompare() {
+		BEGIN_TEST;
+
+		U16* a = StringUtils::asciiToUnicode("/home/catlin/projects/catztoy/tests/core/unit");
+		U16* b = StringUtils::asciiToUnicode("/home/catlin/projects/catztoy/tests/core/unit");
+		U16* c = StringUtils::asciiToUnicode("/home/catlin/projects/catztoy/tests/core/unix");
+		U16* d = StringUtils::asciiToUnicode("/home/catlin/projects/catztoy/tests/core/uni");
+
+		ass_true(StringUtils::equals(a, b));
+		ass_false(StringUtils::equals(a, c));
+		ass_false(StringUtils::equals(a, d));
+		ass_false(StringUtils::equals(d, a));
+		ass_false(StringUtils::equals(a, (const U16*)NIL));
+		ass_eq(StringUtils::compare(a, b), 0);
+		ass_lt(StringUtils::compare(a, c), 0);
+		ass_gt(StringUtils::compare(c, a), 0);
+		ass_gt(StringUtils::compare(a, d), 0);
+		ass_lt(StringUtils::compare(d, a), 0);
+		ass_lt(StringUtils::compare((const U16*)NIL, a), 0);
+
+		for (Size t = 0; t < numTables; ++t) {
+			for (Size len = 0; len < 48; ++len) {
+				ass_eq(tables[t]->mismatch16(a, c, len), scalar.mismatch16(a, c, len));
+			}
+		}
+
+		StringUtils::free(a);
+		StringUtils::free(b);
+		StringUtils::free(c);
+		StringUtils::free(d);
+
+		FINISH_TEST;
+	}
+
+	void testStringUtilsUnicodeFindSubstring() {
+		BEGIN_TEST;
+
+		U16* hay = StringUtils::asciiToUnicode("abababababababababababababababababcabababababcd");
+		const Char* needles[] = { "abc", "abcd", "d", "c", "ab", "ba", "abababababababababc", "x", "" };
+		for (Size i = 0; i < 9; ++i) {
+			U16* needle = StringUtils::asciiToUnicode(needles[i]);
+			Size hayLen = StringUtils::length(hay);
+			Size needleLen = StringUtils::length(needle);
+			const U16* expected = scalar.findSub16(hay, hayLen, needle, needleLen);
+			for (Size t = 0; t < numTables; ++t) {
+				ass_eq(tables[t]->findSub16(hay, hayLen, needle, needleLen), expected);
+			}
+			ass_eq(StringUtils::find(hay, needle), expected);
+			I32 expectedIdx = expected ? (I32)(expected - hay) : -1;
+			ass_eq(StringUtils::indexOf(hay, needle), expectedIdx);
+			ass_eq(StringUtils::indexOf(hay, needle), StringUtils::indexOf(
+						 "abababababababababababababababababcabababababcd", needles[i]));
+			StringUtils::free(needle);
+		}
+		StringUtils::free(hay);
+
+		FINISH_TEST;
+	}
+
+	void testStringUtilsEqualsIgnoreCase() {
+		BEGIN_TEST;
+
+		ass_true(StringUtils::equalsIgnoreCase("Hello World, MEOW meow @[`{", "hELLO wORLD, meow MEOW @[`{"));
+		ass_false(StringUtils::equalsIgnoreCase("Hello World, MEOW meow @[`{", "hELLO wORLD, meow MEOW `{@["));
+		ass_false(StringUtils::equalsIgnoreCase("@", "`"));
+		ass_false(StringUtils::equalsIgnoreCase("[", "{"));
+		ass_false(StringUtils::equalsIgnoreCase("meow", "meo"));
+		ass_false(StringUtils::equalsIgnoreCase("meow", NIL));
+
+		Char str1[128];
+		Char str2[128];
+		for (Size i = 0; i < 128; ++i) {
+			str1[i] = (Char)i;
+			str2[i] = (Char)((i >= 'a' && i <= 'z') ? i - 32 : i);
+		}
+		for (Size t = 0; t < numTables; ++t) {
+			const StringKernels::Table& fast = *tables[t];
+			for (Size len = 0; len < 128; ++len) {
+				ass_true(fast.equalsIgnoreCase(str1, str2, len));
+				ass_eq(fast.equalsIgnoreCase(&(str1[1]), str2, len),
+						 scalar.equalsIgnoreCase(&(str1[1]), str2, len));
+			}
+		}
+
+		ass_true(StringUtils::startsWith("/usr/lib", "/"));
+		ass_false(StringUtils::startsWith("usr/lib", "/"));
+		ass_false(StringUtils::startsWith("/", "/usr"));
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testStringUtilsUnicodeLengthAndFind();
+	cc::testStringUtilsUnicodeCompare();
+	cc::testStringUtilsUnicodeFindSubstring();
+	cc::testStringUtilsEqualsIgnoreCase();
+
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include "core/testcore.h"
+#include "core/string/stringview.h"
+#include "core/string/stringutils.h"
+#include "core/string/string.h"
+#include "core/util/staticmap.h"
+
+namespace cc {
+
+	void testStringViewBasics() {
+		BEGIN_TEST;
+
+		StringView empty;
+		ass_true(empty.isEmpty());
+		ass_eq(empty.length(), 0);
+		ass_true(empty == StringView(""));
+
+		const Char* text = "parent/child/name.txt";
+		StringView view(text);
+		ass_eq(view.length(), 21);
+		ass_true(view.data() == text);
+		ass_true(view.startsWith("parent/"));
+		ass_false(view.startsWith("child"));
+		ass_true(view.endsWith(".txt"));
+		ass_false(view.endsWith("name"));
+		ass_eq(view.indexOf('/'), 6);
+		ass_eq(view.indexOf('/', 7), 12);
+		ass_eq(view.lastIndexOf('/'), 12);
+		ass_eq(view.indexOf('#'), -1);
+		ass_eq(view.indexOf(StringView("child")), 7);
+		ass_eq(view.indexOf(StringView("name.txt")), 13);
+		ass_eq(view.indexOf(StringView("name.txtx")), -1);
+		ass_eq(view.indexOf(StringView("")), 0);
+
+		StringView child = view.sub(7, 5);
+		ass_true(child == "child");
+		ass_true(child.data() == text + 7);
+		ass_true(view.sub(13) == "name.txt");
+		ass_true(view.sub(100).isEmpty());
+		ass_true(view.sub(20, 100) == "t");
+
+		ass_true(StringView("Child").equalsIgnoreCase(child));
+		ass_false(StringView("Childe").equalsIgnoreCase(child));
+		ass_lt(StringView("abc").compare("abd"), 0);
+		ass_gt(StringView("abcd").compare("abc"), 0);
+		ass_eq(StringView("abc").compare("abc"), 0);
+
+		ass_true(StringView("  \t padded \n").trim() == "padded");
+		ass_true(StringView("  left").trimLeft() == "left");
+		ass_true(StringView("right \r\n").trimRight() == "right");
+		ass_true(StringView("   ").trim().isEmpty());
+
+		FINISH_TEST;
+	}
+
+	void testStringViewSplit() {
+		BEGIN_TEST;
+
+		StringView head, tail;
+		ass_true(StringView("key=value").split('=', head, tail));
+		ass_true(head == "key");
+		ass_true(tail == "value");
+		ass_false(StringView("novalue").split('=', head, tail));
+		ass_true(head == "novalue");
+		ass_true(tail.isEmpty());
+
+		StringView list("a,,bc,");
+		StringView token;
+		const Char* expected[] = { "a", "", "bc", "" };
+		I32 count = 0;
+		while (list.nextToken(',', token)) {
+			ass_true(token == expected[count]);
+			++count;
+		}
+		ass_eq(count, 4);
+
+		StringView single("one");
+		count = 0;
+		while (single.nextToken(',', token)) {
+			ass_true(token == "one");
+			++count;
+		}
+		ass_eq(count, 1);
+
+		FINISH_TEST;
+	}
+
+	void testStringViewHashing() {
+		BEGIN_TEST;
+
+		StringView name = StringView("signalName(I32) and more").sub(0, 15);
+		ass_eq(name.oID(), crc32("signalName(I32)"));
+		ass_eq(StringView().oID(), crc32(""));
+
+		InternedString interned = name.intern();
+		ass_true(interned == InternedString("signalName(I32)"));
+		ass_true(StringView(interned) == name);
+
+		StaticMap<I32> map(8, -1);
+		map.insert(name, 42);
+		ass_true(map.contains("signalName(I32)"));
+		ass_eq(map.at(StringView("signalName(I32)")), 42);
+		ass_eq(map.at(crc32("signalName(I32)")), 42);
+
+		FINISH_TEST;
+	}
+
+	void testStringViewOverloads() {
+		BEGIN_TEST;
+
+		StringView view = StringView("copy me please").sub(0, 7);
+		Char* copy = StringUtils::copy(view);
+		ass_eq(strcmp(copy, "copy me"), 0);
+		StringUtils::free(copy);
+
+		ass_true(StringUtils::equals(view, StringView("copy me")));
+		ass_true(StringUtils::startsWith(view, StringView("copy")));
+		ass_true(StringUtils::view("0123456789", 3, 4) == "3456");
+
+		String str(view);
+		ass_eq(str.length(), 7);
+		ass_true(str == "copy me");
+		ass_true(str == view);
+		ass_true(str.view() == view);
+		ass_eq(str.oID(), crc32("copy me"));
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testStringViewBasics();
+	cc::testStringViewSplit();
+	cc::testStringViewHashing();
+	cc::testStringViewOverloads();
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include "core/testcore.h"
+#include "core/string/utf8.h"
+#include "core/string/unistring.h"
+#include "core/string/stringutils.h"
+
+namespace cc {
+
+	/* "héllo wörld €100 😺" followed by ascii padding to hit the vector paths */
+	static const Char* s_mixed = "h\xC3\xA9llo w\xC3\xB6rld \xE2\x82\xAC" "100 \xF0\x9F\x98\xBA"
+		" and some plain ascii text to fill a vector or two";
+
+	void testUtf8Validate() {
+		BEGIN_TEST;
+
+		ass_true(Utf8::validate("", 0));
+		ass_true(Utf8::validate("plain ascii text that is longer than sixteen", 44));
+		ass_true(Utf8::validate(s_mixed, strlen(s_mixed)));
+		ass_true(Utf8::validate("\xF4\x8F\xBF\xBF", 4)); /* U+10FFFF */
+
+		ass_false(Utf8::validate("\xC0\xAF", 2)); /* Overlong '/' */
+		ass_false(Utf8::validate("\xE0\x80\xAF", 3)); /* Overlong '/' */
+		ass_false(Utf8::validate("\xED\xA0\x80", 3)); /* Surrogate U+D800 */
+		ass_false(Utf8::validate("\xF4\x90\x80\x80", 4)); /* > U+10FFFF */
+		ass_false(Utf8::validate("\xF8\x88\x80\x80\x80", 5));
+		ass_false(Utf8::validate("abc\xE2\x82", 5)); /* Truncated */
+		ass_false(Utf8::validate("0123456789abcdef\x80", 17)); /* Lone continuation */
+		ass_false(Utf8::validate("0123456789abcde\xC3" "A", 17));
+
+		FINISH_TEST;
+	}
+
+	void testUtf8RoundTrip() {
+		BEGIN_TEST;
+
+		Size len = strlen(s_mixed);
+		U16* utf16 = new U16[len];
+		Size units = Utf8::toUtf16(s_mixed, len, utf16);
+		ass_eq(units, Utf8::utf16Length(s_mixed, len));
+		ass_eq(units, len - 1 - 1 - 2 - 2); /* 2 + 2 + 3 + 4 byte sequences */
+		ass_eq(utf16[0], 'h');
+		ass_eq(utf16[1], 0xE9);
+		ass_eq(utf16[7], 0xF6);
+		ass_eq(utf16[12], 0x20AC);
+		ass_eq(utf16[17], 0xD83D);
+		ass_eq(utf16[18], 0xDE3A);
+
+		ass_eq(Utf8::utf8Length(utf16, units), len);
+		Char* utf8 = new Char[units*3];
+		ass_eq(Utf8::fromUtf16(utf16, units, utf8), len);
+		ass_eq(memcmp(utf8, s_mixed, len), 0);
+
+		/* Unpaired surrogates cannot be encoded */
+		U16 lone[2] = { 0xDC00, 'a' };
+		ass_eq(Utf8::fromUtf16(lone, 2, utf8), CAT_UTF_INVALID);
+		ass_eq(Utf8::toUtf16("\xC0\xAF", 2, utf16), CAT_UTF_INVALID);
+
+		delete[] utf8;
+		delete[] utf16;
+
+		FINISH_TEST;
+	}
+
+	void testUtf8Decoder() {
+		BEGIN_TEST;
+
+		Size len = strlen(s_mixed);
+		U16* expected = new U16[len];
+		Size expectedUnits = Utf8::toUtf16(s_mixed, len, expected);
+
+		/* Feed the text in every chunk size, splitting every sequence */
+		U16* decoded = new U16[len + 1];
+		for (Size chunkSize = 1; chunkSize <= len; ++chunkSize) {
+			Utf8Decoder decoder;
+			Size units = 0;
+			for (Size i = 0; i < len; i += chunkSize) {
+				Size n = (i + chunkSize <= len) ? chunkSize : len - i;
+				Size out = decoder.decode(&(s_mixed[i]), n, &(decoded[units]));
+				ass_neq(out, CAT_UTF_INVALID);
+				units += out;
+			}
+			ass_true(decoder.isComplete());
+			ass_false(decoder.hasFailed());
+			ass_eq(units, expectedUnits);
+			ass_eq(memcmp(decoded, expected, sizeof(U16)*units), 0);
+		}
+
+		Utf8Decoder decoder;
+		Size out = decoder.decode("ab\xE2\x82", 4, decoded);
+		ass_eq(out, 2);
+		ass_false(decoder.isComplete());
+		out = decoder.decode("A", 1, decoded);
+		ass_eq(out, CAT_UTF_INVALID);
+		ass_true(decoder.hasFailed());
+
+		delete[] decoded;
+		delete[] expected;
+
+		FINISH_TEST;
+	}
+
+	void testUniStringUTF8() {
+		BEGIN_TEST;
+
+		UniString str(s_mixed);
+		ass_eq(str.length(), strlen(s_mixed) - 6);
+		ass_eq(str[1], 0xE9);
+		ass_eq(str.utf8Length(), strlen(s_mixed));
+		Char* utf8 = str.toUTF8();
+		ass_eq(strcmp(utf8, s_mixed), 0);
+		StringUtils::free(utf8);
+
+		UniString ascii("meow");
+		ass_true(ascii.equals("meow"));
+
+		/* Invalid UTF-8 is widened byte by byte */
+		UniString latin("caf\xE9");
+		ass_eq(latin.length(), 4);
+		ass_eq(latin[3], 0xE9);
+
+		latin = "w\xC3\xB6rld";
+		ass_eq(latin.length(), 5);
+		ass_eq(latin[1], 0xF6);
+
+		FINISH_TEST;
+	}
+
+} // namespace cc
+
+int main(int argc, char** argv) {
+	cc::testUtf8Validate();
+	cc::testUtf8RoundTrip();
+	cc::testUtf8Decoder();
+	cc::testUniStringUTF8();
+
+	return 0;
+}
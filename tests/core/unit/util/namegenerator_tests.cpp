@@ -158,12 +158,64 @@ namespace cc {
 		FINISH_TEST;
 	}
 
+	void testNameGeneratorNoAlloc() {
+		BEGIN_TEST;
+
+		NameGenerator g("Task");
+		Char buffer[64];
+		Size length = g.generate(buffer);
+		ass_eq(length, 16);
+		ass_eq(strcmp(buffer, "Task=/++++++++++"), 0);
+		ass_eq(g.count(), 1);
+
+		OID oid = 0;
+		length = g.generate(buffer, oid);
+		ass_eq(strcmp(buffer, "Task=0++++++++++"), 0);
+		ass_eq(oid, crc32(buffer));
+		for (I32 i = 0; i < 1000; i++) {
+			g.generate(buffer, oid);
+			ass_eq(oid, crc32(buffer));
+		}
+
+		InternedString name = g.generateInterned();
+		ass_eq(strcmp(name.cStr(), "Task=fD+++++++++"), 0);
+		ass_true(name == InternedString("Task=fD+++++++++"));
+		ass_eq(g.count(), 1003);
+
+		FINISH_TEST;
+	}
+
+	void testNameGeneratorGenerateOID() {
+		BEGIN_TEST;
+
+		NameGenerator g("Anon");
+		const I32 num = 4096;
+		OID* oids = new OID[num];
+		for (I32 i = 0; i < num; i++) {
+			oids[i] = g.generateOID();
+		}
+		ass_eq(g.count(), num);
+
+		I32 duplicates = 0;
+		for (I32 i = 0; i < num; i++) {
+			for (I32 j = i + 1; j < num; j++) {
+				if (oids[i] == oids[j]) { ++duplicates; }
+			}
+		}
+		ass_eq(duplicates, 0);
+		delete[] oids;
+
+		FINISH_TEST;
+	}
+
 } // namespace cc
 
 int main(int argc, char** argv) {
 	cc::testNameGeneratorCreateAndDestroy();
 	cc::testNameGeneratorInitWithPrefix();
 	cc::testNameGeneratorGenerate();	
+	cc::testNameGeneratorNoAlloc();
+	cc::testNameGeneratorGenerateOID();
 	return 0;
 }
 